@@ -0,0 +1,238 @@
+/************************************************************************************
+* This module contains the implementation of the coordinator device table.
+*
+* Entries live in a static array of mwMaxDevices_c elements. The device of entry i
+* owns the short address mDeviceTableFirstShortAddr_c + i.
+*
+* Free entries are tracked by a two level bitmap: one bit per entry in
+* mFreeMap[], and one bit per word of mFreeMap[] in mFreeSummary, set while that
+* word has a free entry. Finding a free entry is two count-trailing-zeros
+* operations.
+*
+* The extended addresses are indexed by a linear probing hash table of
+* mwDeviceHashSize_c slots holding entry index + 1 (0 is an empty slot). It is
+* kept at most half full, so a lookup inspects about two slots on average.
+* Removal shifts the following slots back instead of leaving tombstones, so the
+* probe sequences never grow with the number of add/remove cycles.
+*
+************************************************************************************/
+#include "DeviceTable.h"
+#include "FunctionLib.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mDeviceTableWords_c     ((mwMaxDevices_c + 31) / 32)
+#define mDeviceHashMask_c       (mwDeviceHashSize_c - 1)
+
+#if (mwMaxDevices_c < 1) || (mwMaxDevices_c > 1024)
+#error "mwMaxDevices_c must be within 1..1024"
+#endif
+
+#if (mwDeviceHashSize_c & mDeviceHashMask_c) || (mwDeviceHashSize_c < 2 * mwMaxDevices_c)
+#error "mwDeviceHashSize_c must be a power of two, at least twice mwMaxDevices_c"
+#endif
+
+/* Index of the lowest bit set (x != 0). A RBIT/CLZ pair on Cortex-M4. */
+#define DeviceTable_Ctz(x)      ((uint32_t)__builtin_ctz(x))
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static uint32_t DeviceTable_Hash(uint64_t extAddress);
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static deviceTableEntry_t mDevices[mwMaxDevices_c];
+static uint32_t mFreeMap[mDeviceTableWords_c];
+static uint32_t mFreeSummary;
+static uint16_t mHash[mwDeviceHashSize_c];
+static uint16_t mDeviceCount;
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* This is the initialization function for the module. It empties the table.
+******************************************************************************/
+void DeviceTable_Init(void)
+{
+	uint16_t i;
+
+	FLib_MemSet(mDevices, 0, sizeof(mDevices));
+	FLib_MemSet(mHash, 0, sizeof(mHash));
+	FLib_MemSet(mFreeMap, 0, sizeof(mFreeMap));
+	mFreeSummary = 0;
+	mDeviceCount = 0;
+
+	for(i = 0; i < mwMaxDevices_c; i++)
+	{
+		mDevices[i].shortAddress = mDeviceTableFirstShortAddr_c + i;
+		mFreeMap[i / 32] |= 1UL << (i % 32);
+		mFreeSummary |= 1UL << (i / 32);
+	}
+}
+
+/******************************************************************************
+* This function returns the entry of a device, creating it in the
+* mDeviceReserved_c state if the device is not in the table yet. A device
+* that associates again keeps its entry, and so its short address. NULL is
+* returned when the table is full.
+******************************************************************************/
+deviceTableEntry_t* DeviceTable_Add(uint64_t extAddress)
+{
+	deviceTableEntry_t* pEntry = DeviceTable_FindByExtAddr(extAddress);
+	uint32_t word;
+	uint32_t index;
+	uint32_t slot;
+
+	if((pEntry != NULL) || (mFreeSummary == 0))
+	{
+		return pEntry;
+	}
+
+	/* First free entry */
+	word = DeviceTable_Ctz(mFreeSummary);
+	index = word * 32 + DeviceTable_Ctz(mFreeMap[word]);
+	mFreeMap[word] &= ~(1UL << (index % 32));
+	if(mFreeMap[word] == 0)
+	{
+		mFreeSummary &= ~(1UL << word);
+	}
+
+	/* First empty hash slot of the probe sequence */
+	slot = DeviceTable_Hash(extAddress);
+	while(mHash[slot] != 0)
+	{
+		slot = (slot + 1) & mDeviceHashMask_c;
+	}
+	mHash[slot] = (uint16_t)(index + 1);
+
+	pEntry = &mDevices[index];
+	pEntry->extAddress = extAddress;
+	pEntry->lastSeen = 0;
+	pEntry->linkQuality = 0;
+	pEntry->state = mDeviceReserved_c;
+	mDeviceCount++;
+
+	return pEntry;
+}
+
+/******************************************************************************
+* This function frees the entry of a device. Its short address may be given
+* to another device afterwards.
+******************************************************************************/
+void DeviceTable_Remove(deviceTableEntry_t* pEntry)
+{
+	uint32_t index = (uint32_t)(pEntry - mDevices);
+	uint32_t slot;
+	uint32_t next;
+	uint32_t home;
+
+	if((index >= mwMaxDevices_c) || (pEntry->state == mDeviceFree_c))
+	{
+		return;
+	}
+
+	slot = DeviceTable_Hash(pEntry->extAddress);
+	while(mHash[slot] != index + 1)
+	{
+		slot = (slot + 1) & mDeviceHashMask_c;
+	}
+
+	/* Backward shift: move up every following slot whose home position is
+	   not between the hole and itself, so no probe sequence gets broken. */
+	next = slot;
+	for(;;)
+	{
+		next = (next + 1) & mDeviceHashMask_c;
+		if(mHash[next] == 0)
+		{
+			break;
+		}
+
+		home = DeviceTable_Hash(mDevices[mHash[next] - 1].extAddress);
+		if(((next - home) & mDeviceHashMask_c) >= ((next - slot) & mDeviceHashMask_c))
+		{
+			mHash[slot] = mHash[next];
+			slot = next;
+		}
+	}
+	mHash[slot] = 0;
+
+	pEntry->state = mDeviceFree_c;
+	mFreeMap[index / 32] |= 1UL << (index % 32);
+	mFreeSummary |= 1UL << (index / 32);
+	mDeviceCount--;
+}
+
+/******************************************************************************
+* This function returns the entry of a device from its extended address, or
+* NULL if the device is not in the table.
+******************************************************************************/
+deviceTableEntry_t* DeviceTable_FindByExtAddr(uint64_t extAddress)
+{
+	uint32_t slot = DeviceTable_Hash(extAddress);
+
+	while(mHash[slot] != 0)
+	{
+		if(mDevices[mHash[slot] - 1].extAddress == extAddress)
+		{
+			return &mDevices[mHash[slot] - 1];
+		}
+		slot = (slot + 1) & mDeviceHashMask_c;
+	}
+
+	return NULL;
+}
+
+/******************************************************************************
+* This function returns the entry of a device from its short address, or NULL
+* if no device uses it.
+******************************************************************************/
+deviceTableEntry_t* DeviceTable_FindByShortAddr(uint16_t shortAddress)
+{
+	uint16_t index = shortAddress - mDeviceTableFirstShortAddr_c;
+
+	if((index >= mwMaxDevices_c) || (mDevices[index].state == mDeviceFree_c))
+	{
+		return NULL;
+	}
+
+	return &mDevices[index];
+}
+
+/******************************************************************************
+* This function returns the number of entries in use.
+******************************************************************************/
+uint16_t DeviceTable_Count(void)
+{
+	return mDeviceCount;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* The DeviceTable_Hash() function returns the home slot of an extended
+* address. Extended addresses of one vendor only differ in their low bytes, so
+* the address is multiplied by 2^64/phi and the high bits, which depend on all
+* the input bits, are used.
+******************************************************************************/
+static uint32_t DeviceTable_Hash(uint64_t extAddress)
+{
+	return (uint32_t)((extAddress * 0x9E3779B97F4A7C15ULL) >> 32) & mDeviceHashMask_c;
+}
@@ -0,0 +1,55 @@
+/************************************************************************************
+* This module contains the interface of the coordinator device table.
+*
+* The table holds one entry per end device associated (or associating) to the
+* coordinator. The short address of a device is derived from the index of its
+* entry, so looking a device up by short address is a plain array access, and the
+* extended address is hashed into an open addressing index. Free entries are found
+* through a two level bitmap. All the operations take constant time, whatever the
+* number of devices.
+*
+************************************************************************************/
+#ifndef _DEVICE_TABLE_H
+#define _DEVICE_TABLE_H
+
+#include "EmbeddedTypes.h"
+#include "ieee802p15p4_wrapper_cfg.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* Short address given to the device of the first entry, the next ones follow */
+#define mDeviceTableFirstShortAddr_c    0x0001
+
+/* State of an entry */
+enum
+{
+	mDeviceFree_c,
+	mDeviceReserved_c,      /* Association response sent, waiting for its status */
+	mDeviceAssociated_c
+};
+
+/* Type: deviceTableEntry_t */
+typedef struct deviceTableEntry_tag
+{
+	uint64_t extAddress;
+	uint32_t lastSeen;      /* Time [ms] of the last frame received from the device */
+	uint16_t shortAddress;
+	uint8_t  state;
+	uint8_t  linkQuality;   /* LQI of the last frame received from the device */
+} deviceTableEntry_t;
+
+/* Declarations of the device table functions */
+void                DeviceTable_Init(void);
+deviceTableEntry_t* DeviceTable_Add(uint64_t extAddress);
+void                DeviceTable_Remove(deviceTableEntry_t* pEntry);
+deviceTableEntry_t* DeviceTable_FindByExtAddr(uint64_t extAddress);
+deviceTableEntry_t* DeviceTable_FindByShortAddr(uint16_t shortAddress);
+uint16_t            DeviceTable_Count(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //_DEVICE_TABLE_H
@@ -0,0 +1,120 @@
+/************************************************************************************
+* This module contains the implementation of the receive duplicate filter.
+*
+* The sources are cached in a set associative table of mwDupFilterSize_c entries:
+* the address of a source selects a set of mDupFilterWays_c entries, and only
+* that set is searched, so a frame costs the same whatever the number of
+* sources. When a new source finds its set full, it takes the entry of the
+* source heard least recently.
+*
+* An entry older than mwDupFilterAgeOut_c ms no longer filters anything: the
+* MAC retries a frame within a few tens of milliseconds, while a source that
+* restarted may send its first frame with the DSN of its last one.
+*
+************************************************************************************/
+#include "DupFilter.h"
+#include "FunctionLib.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mDupFilterSets_c        (mwDupFilterSize_c / mDupFilterWays_c)
+#define mDupFilterSetMask_c     (mDupFilterSets_c - 1)
+
+#if (mwDupFilterSize_c < mDupFilterWays_c) || (mwDupFilterSize_c & (mwDupFilterSize_c - 1))
+#error "mwDupFilterSize_c must be a power of two, at least 2"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static uint32_t DupFilter_Hash(uint64_t src, uint8_t srcAddrMode);
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static dupFilterEntry_t mDupFilter[mDupFilterSets_c][mDupFilterWays_c];
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* This is the initialization function for the module. It forgets every
+* source.
+******************************************************************************/
+void DupFilter_Init(void)
+{
+	FLib_MemSet(mDupFilter, 0, sizeof(mDupFilter));
+}
+
+/******************************************************************************
+* This function records a frame received from a source at time now [ms]. It
+* returns TRUE if the frame has the DSN of the previous frame of the source,
+* received less than mwDupFilterAgeOut_c ms before: it is a copy to drop.
+* Frames without a source address are never duplicates.
+******************************************************************************/
+bool_t DupFilter_IsDuplicate(uint64_t src, addrModeType_t srcAddrMode, uint8_t dsn, uint32_t now)
+{
+	dupFilterEntry_t* pSet;
+	dupFilterEntry_t* pEntry;
+	bool_t duplicate;
+	uint32_t way;
+
+	if(srcAddrMode == gAddrModeNoAddress_c)
+	{
+		return FALSE;
+	}
+
+	pSet = mDupFilter[DupFilter_Hash(src, srcAddrMode)];
+	pEntry = &pSet[0];
+	for(way = 0; way < mDupFilterWays_c; way++)
+	{
+		if((pSet[way].srcAddrMode == srcAddrMode) && (pSet[way].src == src))
+		{
+			pEntry = &pSet[way];
+			duplicate = (pEntry->dsn == dsn) && ((now - pEntry->lastSeen) < mwDupFilterAgeOut_c);
+			pEntry->dsn = dsn;
+			pEntry->lastSeen = now;
+			return duplicate;
+		}
+
+		/* Replacement candidate: a free entry, else the oldest one */
+		if((pEntry->srcAddrMode != gAddrModeNoAddress_c) &&
+		   ((pSet[way].srcAddrMode == gAddrModeNoAddress_c) ||
+		    ((now - pSet[way].lastSeen) > (now - pEntry->lastSeen))))
+		{
+			pEntry = &pSet[way];
+		}
+	}
+
+	pEntry->src = src;
+	pEntry->srcAddrMode = srcAddrMode;
+	pEntry->dsn = dsn;
+	pEntry->lastSeen = now;
+	return FALSE;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* The DupFilter_Hash() function returns the set of a source. The address is
+* multiplied by 2^64/phi and the high bits are used, as DeviceTable.c does
+* for the extended addresses.
+******************************************************************************/
+static uint32_t DupFilter_Hash(uint64_t src, uint8_t srcAddrMode)
+{
+	return (uint32_t)(((src ^ srcAddrMode) * 0x9E3779B97F4A7C15ULL) >> 32) & mDupFilterSetMask_c;
+}
@@ -0,0 +1,42 @@
+/************************************************************************************
+* This module contains the interface of the receive duplicate filter.
+*
+* When the acknowledgement of a frame is lost, the sender MAC sends the frame
+* again with the same data sequence number (DSN), and the receiver MAC indicates
+* it twice. The filter remembers the DSN of the last frame received from each
+* source, so the copies can be dropped. A source sends its frames one at a time,
+* retries included, so a copy always follows the frame it repeats.
+*
+************************************************************************************/
+#ifndef _DUP_FILTER_H
+#define _DUP_FILTER_H
+
+#include "EmbeddedTypes.h"
+#include "MacInterface.h"
+#include "ieee802p15p4_wrapper_cfg.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* Entries of a set of the cache */
+#define mDupFilterWays_c        2
+
+/* Type: dupFilterEntry_t, the last frame received from a source */
+typedef struct dupFilterEntry_tag
+{
+	uint64_t src;
+	uint32_t lastSeen;      /* Time [ms] the frame was received */
+	uint8_t  srcAddrMode;   /* gAddrModeNoAddress_c: the entry is free */
+	uint8_t  dsn;
+} dupFilterEntry_t;
+
+/* Declarations of the duplicate filter functions */
+void   DupFilter_Init(void);
+bool_t DupFilter_IsDuplicate(uint64_t src, addrModeType_t srcAddrMode, uint8_t dsn, uint32_t now);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //_DUP_FILTER_H
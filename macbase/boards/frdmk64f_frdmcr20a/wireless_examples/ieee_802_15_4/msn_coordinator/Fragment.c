@@ -0,0 +1,574 @@
+/************************************************************************************
+* This module contains the implementation of the fragmentation layer.
+*
+* Fragment frame:  dispatch | tag | index | flags | total length (2, LE) | payload
+* Ack frame:       dispatch | tag | upTo | base | bitmap (4, LE)
+*
+* The tag tells the transfers of a sender apart. Every fragment carries the total
+* length, so the receiver can start the reassembly from any of them. A fragment
+* with mFragFlagAckRequest_c asks for an acknowledgement: the receiver answers with
+* the index of that fragment (upTo), the first fragment it is missing (base) and
+* one bit for each of the 32 fragments after base. It also answers when the
+* payload is complete, and keeps answering for a while after that, in case the
+* last acknowledgement got lost.
+*
+* The sender keeps one acknowledgement request outstanding. An answer to it tells
+* which of the fragments sent before the request are missing, and only those are
+* sent again: the fragments sent after the request may still be on their way.
+* The sender asks for an acknowledgement every half window, so the train does not
+* stop while the answer comes back. The last fragment before the window closes
+* asks again in any case, so a lost answer costs one round trip and not a
+* timeout. If no answer comes within mwFragAckTimeout_c, the next fragment asks
+* again, up to mwFragMaxRetries_c times.
+*
+************************************************************************************/
+#include "Fragment.h"
+#include "FunctionLib.h"
+#include "MemManager.h"
+#include "fsl_os_abstraction.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mFragFlagAckRequest_c   (1 << 0)
+
+#define mFragAckLen_c           8
+
+/* Number of fragments of a payload */
+#define mFragCount(length)      ((uint8_t)(((length) + mwFragPayloadLen_c - 1) / mwFragPayloadLen_c))
+
+#define mFragBitTest(map, i)    (((map)[(i) >> 5] >> ((i) & 31)) & 1)
+#define mFragBitSet(map, i)     ((map)[(i) >> 5] |= (uint32_t)1 << ((i) & 31))
+#define mFragBitClear(map, i)   ((map)[(i) >> 5] &= ~((uint32_t)1 << ((i) & 31)))
+
+/* Time a is at or after time b [ms] */
+#define mFragTimeReached(a, b)  ((int32_t)((a) - (b)) >= 0)
+
+/* State of a reassembly slot */
+enum
+{
+	mFragRxFree_c,
+	mFragRxActive_c,
+	mFragRxDone_c       /* Delivered, still acknowledged when asked */
+};
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static bool_t Frag_SendFragment(fragInstance_t* pInst, uint8_t index, bool_t ackRequest);
+static void   Frag_TxProcess(fragInstance_t* pInst);
+static void   Frag_TxFinish(fragInstance_t* pInst, resultType_t status);
+static void   Frag_HandleAck(fragInstance_t* pInst, uint8_t* pFrame, uint8_t length);
+static void   Frag_HandleFragment(fragInstance_t* pInst, uint16_t src, uint8_t* pFrame, uint8_t length);
+static fragRxSlot_t* Frag_RxSlot(fragInstance_t* pInst, uint16_t src, uint8_t tag, uint16_t length);
+static void   Frag_SendAck(fragInstance_t* pInst, fragRxSlot_t* pSlot);
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* This is the initialization function for the module. It clears the instance,
+* window is the number of fragments sent ahead (1 to 32, normally
+* mwFragWindow_c).
+******************************************************************************/
+void Frag_Init(fragInstance_t* pInst, uint8_t window, pfFragSend_t pfSend, pfFragDeliver_t pfDeliver)
+{
+	FLib_MemSet(pInst, 0, sizeof(fragInstance_t));
+	pInst->pfSend = pfSend;
+	pInst->pfDeliver = pfDeliver;
+	pInst->window = ((window == 0) || (window > mFragMaxWindow_c)) ? mwFragWindow_c : window;
+}
+
+/******************************************************************************
+* Starts sending a payload, the first fragments go out on the next
+* Frag_Process(). pData is not copied: it shall stay valid until pfDone is
+* called. Returns FALSE if a transfer is in progress or the length is invalid.
+******************************************************************************/
+bool_t Frag_Send(fragInstance_t* pInst, uint16_t dest, const uint8_t* pData, uint16_t length,
+                 pfFragTxDone_t pfDone, void* pContext)
+{
+	if(pInst->txBusy || (pData == NULL) || (length == 0) || (length > mwFragMaxLength_c))
+	{
+		return FALSE;
+	}
+
+	FLib_MemSet(pInst->txAcked, 0, sizeof(pInst->txAcked));
+	FLib_MemSet(pInst->txMissing, 0, sizeof(pInst->txMissing));
+	FLib_MemSet(pInst->txAfterReq, 0, sizeof(pInst->txAfterReq));
+	pInst->pTxData = pData;
+	pInst->pfTxDone = pfDone;
+	pInst->pTxContext = pContext;
+	pInst->txDest = dest;
+	pInst->txLength = length;
+	pInst->txTag++;
+	pInst->txCount = mFragCount(length);
+	pInst->txBase = 0;
+	pInst->txNext = 0;
+	pInst->txSinceReq = 0;
+	pInst->txRetries = 0;
+	pInst->txAckOutstanding = FALSE;
+	pInst->txPoll = FALSE;
+	pInst->txBusy = TRUE;
+
+	return TRUE;
+}
+
+/******************************************************************************
+* Handles a frame received with a fragmentation dispatch byte.
+******************************************************************************/
+void Frag_Receive(fragInstance_t* pInst, uint16_t src, uint8_t* pFrame, uint8_t length)
+{
+	if(length == 0)
+	{
+		return;
+	}
+
+	switch(pFrame[0])
+	{
+	case mFragDispatchFragment_c:
+		Frag_HandleFragment(pInst, src, pFrame, length);
+		break;
+
+	case mFragDispatchAck_c:
+		Frag_HandleAck(pInst, pFrame, length);
+		break;
+
+	default:
+		pInst->stats.rxDropped++;
+		break;
+	}
+}
+
+/******************************************************************************
+* Sends the fragments and acknowledgements the window and the timers allow,
+* and drops the reassemblies that timed out. It shall be called when a frame
+* may be sent again (a transmit confirm) and periodically while it returns
+* TRUE, which it does while a transfer or a reassembly is in progress.
+******************************************************************************/
+bool_t Frag_Process(fragInstance_t* pInst)
+{
+	uint32_t now = OSA_TimeGetMsec();
+	bool_t busy;
+	uint8_t i;
+
+	Frag_TxProcess(pInst);
+	busy = pInst->txBusy;
+
+	for(i = 0; i < mwFragMaxReassembly_c; i++)
+	{
+		fragRxSlot_t *pSlot = &pInst->rx[i];
+
+		if(pSlot->state == mFragRxFree_c)
+		{
+			continue;
+		}
+
+		if(mFragTimeReached(now, pSlot->lastHeard + mwFragReassemblyTimeout_c))
+		{
+			if(pSlot->pBuffer != NULL)
+			{
+				(void)MEM_BufferFree(pSlot->pBuffer);
+				pSlot->pBuffer = NULL;
+				pInst->stats.rxDropped++;
+			}
+			pSlot->state = mFragRxFree_c;
+			continue;
+		}
+
+		if(pSlot->ackPending)
+		{
+			Frag_SendAck(pInst, pSlot);
+		}
+		busy = TRUE;
+	}
+
+	return busy;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* Sends fragment 'index' of the payload being sent.
+******************************************************************************/
+static bool_t Frag_SendFragment(fragInstance_t* pInst, uint8_t index, bool_t ackRequest)
+{
+	uint8_t frame[mFragMaxFrameLen_c];
+	uint16_t offset = (uint16_t)index * mwFragPayloadLen_c;
+	uint16_t size = pInst->txLength - offset;
+
+	if(size > mwFragPayloadLen_c)
+	{
+		size = mwFragPayloadLen_c;
+	}
+
+	frame[0] = mFragDispatchFragment_c;
+	frame[1] = pInst->txTag;
+	frame[2] = index;
+	frame[3] = ackRequest ? mFragFlagAckRequest_c : 0;
+	frame[4] = (uint8_t)pInst->txLength;
+	frame[5] = (uint8_t)(pInst->txLength >> 8);
+	FLib_MemCpy(&frame[mFragHeaderLen_c], (void*)&pInst->pTxData[offset], size);
+
+	return pInst->pfSend(pInst, pInst->txDest, frame, (uint8_t)(mFragHeaderLen_c + size));
+}
+
+/******************************************************************************
+* Sends as many fragments of the payload being sent as the window allows. The
+* missing ones go first, then the ones never sent.
+******************************************************************************/
+static void Frag_TxProcess(fragInstance_t* pInst)
+{
+	uint32_t now = OSA_TimeGetMsec();
+	uint8_t halfWindow = (pInst->window > 1) ? (pInst->window / 2) : 1;
+	uint8_t index;
+	uint8_t i;
+	bool_t retransmit;
+	bool_t last;
+	bool_t ackRequest;
+
+	while(pInst->txBusy)
+	{
+		if(pInst->txAckOutstanding && mFragTimeReached(now, pInst->ackDeadline))
+		{
+			pInst->stats.txTimeouts++;
+			if(++pInst->txRetries > mwFragMaxRetries_c)
+			{
+				Frag_TxFinish(pInst, gNoAck_c);
+				break;
+			}
+			pInst->txAckOutstanding = FALSE;
+			pInst->txPoll = TRUE;
+		}
+
+		/* First missing fragment, if any */
+		for(i = pInst->txBase; i < pInst->txNext; i++)
+		{
+			if(mFragBitTest(pInst->txMissing, i))
+			{
+				break;
+			}
+		}
+
+		retransmit = (i < pInst->txNext);
+		if(retransmit)
+		{
+			index = i;
+		}
+		else if((pInst->txNext < pInst->txCount) && (pInst->txNext < pInst->txBase + pInst->window))
+		{
+			index = pInst->txNext;
+		}
+		else if(!pInst->txAckOutstanding && (pInst->txNext > pInst->txBase))
+		{
+			/* Nothing to send and no answer to wait for: ask again with the
+			 * last fragment not acknowledged */
+			for(index = pInst->txNext - 1; (index > pInst->txBase) && mFragBitTest(pInst->txAcked, index); index--)
+			{
+			}
+			retransmit = TRUE;
+			pInst->txPoll = TRUE;
+		}
+		else
+		{
+			break;
+		}
+
+		/* Is anything left to send after this one? */
+		for(i = index + 1; (i < pInst->txNext) && !mFragBitTest(pInst->txMissing, i); i++)
+		{
+		}
+		last = (i >= pInst->txNext) &&
+		       ((pInst->txNext + (retransmit ? 0 : 1) >= pInst->txCount) ||
+		        (pInst->txNext + (retransmit ? 0 : 1) >= pInst->txBase + pInst->window));
+
+		/* The last fragment before the window closes always asks, in place of
+		 * an outstanding request whose answer may be lost */
+		ackRequest = last ||
+		             (!pInst->txAckOutstanding && (pInst->txPoll || (pInst->txSinceReq + 1 >= halfWindow)));
+
+		if(!Frag_SendFragment(pInst, index, ackRequest))
+		{
+			break;
+		}
+
+		pInst->stats.txFragments++;
+		mFragBitClear(pInst->txMissing, index);
+		if(retransmit)
+		{
+			pInst->stats.txRetransmissions++;
+		}
+		else
+		{
+			pInst->txNext++;
+		}
+
+		if(ackRequest)
+		{
+			pInst->stats.txAckRequests++;
+			FLib_MemSet(pInst->txAfterReq, 0, sizeof(pInst->txAfterReq));
+			pInst->txAckOutstanding = TRUE;
+			pInst->txPoll = FALSE;
+			pInst->txReqIndex = index;
+			pInst->txSinceReq = 0;
+			pInst->ackDeadline = now + mwFragAckTimeout_c;
+		}
+		else
+		{
+			if(pInst->txAckOutstanding)
+			{
+				mFragBitSet(pInst->txAfterReq, index);
+			}
+			pInst->txSinceReq++;
+		}
+	}
+}
+
+/******************************************************************************
+* Ends the transfer in progress and calls its completion function, which may
+* start the next one.
+******************************************************************************/
+static void Frag_TxFinish(fragInstance_t* pInst, resultType_t status)
+{
+	pfFragTxDone_t pfDone = pInst->pfTxDone;
+
+	pInst->txBusy = FALSE;
+	pInst->pTxData = NULL;
+	pInst->pfTxDone = NULL;
+
+	if(pfDone != NULL)
+	{
+		pfDone(status, pInst->pTxContext);
+	}
+}
+
+/******************************************************************************
+* Handles an acknowledgement of the payload being sent. The fragments the
+* receiver holds are never sent again. When it answers the outstanding
+* request, the fragments sent before the request and still not received are
+* the missing ones.
+******************************************************************************/
+static void Frag_HandleAck(fragInstance_t* pInst, uint8_t* pFrame, uint8_t length)
+{
+	uint32_t bitmap;
+	uint8_t upTo;
+	uint8_t base;
+	uint8_t i;
+	bool_t answer;
+
+	if((length < mFragAckLen_c) || !pInst->txBusy || (pFrame[1] != pInst->txTag))
+	{
+		return;
+	}
+
+	upTo = pFrame[2];
+	base = pFrame[3];
+	bitmap = (uint32_t)pFrame[4] | ((uint32_t)pFrame[5] << 8) | ((uint32_t)pFrame[6] << 16) | ((uint32_t)pFrame[7] << 24);
+
+	if(base >= pInst->txCount)
+	{
+		Frag_TxFinish(pInst, gSuccess_c);
+		return;
+	}
+
+	answer = pInst->txAckOutstanding && (upTo == pInst->txReqIndex);
+	if(answer)
+	{
+		pInst->txAckOutstanding = FALSE;
+		pInst->txRetries = 0;
+	}
+
+	if(base > pInst->txBase)
+	{
+		pInst->txBase = base;
+	}
+
+	for(i = pInst->txBase; i < pInst->txNext; i++)
+	{
+		if((i > base) && (i - base <= 32) && ((bitmap >> (i - base - 1)) & 1))
+		{
+			mFragBitSet(pInst->txAcked, i);
+			mFragBitClear(pInst->txMissing, i);
+		}
+		else if(answer && !mFragBitTest(pInst->txAcked, i) && !mFragBitTest(pInst->txAfterReq, i))
+		{
+			mFragBitSet(pInst->txMissing, i);
+		}
+	}
+}
+
+/******************************************************************************
+* Stores a received fragment, acknowledges it when asked, and hands over the
+* payload once it is complete.
+******************************************************************************/
+static void Frag_HandleFragment(fragInstance_t* pInst, uint16_t src, uint8_t* pFrame, uint8_t length)
+{
+	fragRxSlot_t *pSlot;
+	uint16_t total;
+	uint16_t offset;
+	uint16_t size;
+	uint8_t count;
+	uint8_t index;
+
+	if(length <= mFragHeaderLen_c)
+	{
+		pInst->stats.rxDropped++;
+		return;
+	}
+
+	index = pFrame[2];
+	total = (uint16_t)pFrame[4] | ((uint16_t)pFrame[5] << 8);
+	count = mFragCount(total);
+	offset = (uint16_t)index * mwFragPayloadLen_c;
+	size = (index == count - 1) ? (total - offset) : mwFragPayloadLen_c;
+
+	if((total == 0) || (total > mwFragMaxLength_c) || (index >= count) ||
+	   (length - mFragHeaderLen_c != size))
+	{
+		pInst->stats.rxDropped++;
+		return;
+	}
+
+	pSlot = Frag_RxSlot(pInst, src, pFrame[1], total);
+	if(pSlot == NULL)
+	{
+		pInst->stats.rxDropped++;
+		return;
+	}
+
+	pInst->stats.rxFragments++;
+	pSlot->lastHeard = OSA_TimeGetMsec();
+
+	if((pSlot->state == mFragRxDone_c) || mFragBitTest(pSlot->received, index))
+	{
+		pInst->stats.rxDuplicates++;
+	}
+	else
+	{
+		FLib_MemCpy(&pSlot->pBuffer[offset], &pFrame[mFragHeaderLen_c], size);
+		mFragBitSet(pSlot->received, index);
+		while((pSlot->base < pSlot->count) && mFragBitTest(pSlot->received, pSlot->base))
+		{
+			pSlot->base++;
+		}
+
+		if(pSlot->base == pSlot->count)
+		{
+			uint8_t *pData = pSlot->pBuffer;
+
+			/* Keep the slot to answer the retransmissions of the sender */
+			pSlot->pBuffer = NULL;
+			pSlot->state = mFragRxDone_c;
+			pSlot->ackPending = TRUE;
+			pSlot->ackUpTo = index;
+			pInst->stats.rxDelivered++;
+			pInst->pfDeliver(pInst, src, pData, total);
+		}
+	}
+
+	if(pFrame[3] & mFragFlagAckRequest_c)
+	{
+		pSlot->ackPending = TRUE;
+		pSlot->ackUpTo = index;
+	}
+
+	if(pSlot->ackPending)
+	{
+		Frag_SendAck(pInst, pSlot);
+	}
+}
+
+/******************************************************************************
+* Returns the reassembly slot of a transfer, starting a new reassembly if it
+* is not known yet. A new one takes a free slot, or the one of the oldest
+* transfer already delivered. Returns NULL if there is no slot or no buffer.
+******************************************************************************/
+static fragRxSlot_t* Frag_RxSlot(fragInstance_t* pInst, uint16_t src, uint8_t tag, uint16_t length)
+{
+	fragRxSlot_t *pSlot = NULL;
+	uint8_t i;
+
+	for(i = 0; i < mwFragMaxReassembly_c; i++)
+	{
+		fragRxSlot_t *pRx = &pInst->rx[i];
+
+		if((pRx->state != mFragRxFree_c) && (pRx->src == src) && (pRx->tag == tag))
+		{
+			return (pRx->length == length) ? pRx : NULL;
+		}
+
+		if(pRx->state == mFragRxFree_c)
+		{
+			if((pSlot == NULL) || (pSlot->state != mFragRxFree_c))
+			{
+				pSlot = pRx;
+			}
+		}
+		else if((pRx->state == mFragRxDone_c) && ((pSlot == NULL) ||
+		        ((pSlot->state == mFragRxDone_c) && mFragTimeReached(pSlot->lastHeard, pRx->lastHeard))))
+		{
+			pSlot = pRx;
+		}
+	}
+
+	if(pSlot == NULL)
+	{
+		return NULL;
+	}
+
+	pSlot->pBuffer = MEM_BufferAlloc(length);
+	if(pSlot->pBuffer == NULL)
+	{
+		return NULL;
+	}
+
+	FLib_MemSet(pSlot->received, 0, sizeof(pSlot->received));
+	pSlot->src = src;
+	pSlot->tag = tag;
+	pSlot->length = length;
+	pSlot->count = mFragCount(length);
+	pSlot->base = 0;
+	pSlot->ackPending = FALSE;
+	pSlot->state = mFragRxActive_c;
+	return pSlot;
+}
+
+/******************************************************************************
+* Sends the acknowledgement of a reassembly. If it cannot be queued now,
+* Frag_Process() tries again.
+******************************************************************************/
+static void Frag_SendAck(fragInstance_t* pInst, fragRxSlot_t* pSlot)
+{
+	uint8_t frame[mFragAckLen_c];
+	uint32_t bitmap = 0;
+	uint8_t i;
+
+	for(i = 0; (i < 32) && (pSlot->base + 1 + i < pSlot->count); i++)
+	{
+		if(mFragBitTest(pSlot->received, pSlot->base + 1 + i))
+		{
+			bitmap |= (uint32_t)1 << i;
+		}
+	}
+
+	frame[0] = mFragDispatchAck_c;
+	frame[1] = pSlot->tag;
+	frame[2] = pSlot->ackUpTo;
+	frame[3] = pSlot->base;
+	frame[4] = (uint8_t)bitmap;
+	frame[5] = (uint8_t)(bitmap >> 8);
+	frame[6] = (uint8_t)(bitmap >> 16);
+	frame[7] = (uint8_t)(bitmap >> 24);
+
+	pSlot->ackPending = !pInst->pfSend(pInst, pSlot->src, frame, sizeof(frame));
+}
@@ -0,0 +1,134 @@
+/************************************************************************************
+* This module contains the interface of the fragmentation layer.
+*
+* A payload of up to mwFragMaxLength_c bytes is sent as a train of fragments of
+* mwFragPayloadLen_c bytes. Up to a window of fragments is sent ahead of the first
+* one the receiver has not acknowledged, and the receiver answers with the list of
+* the fragments it holds, so only the missing ones are sent again. The receiver
+* reassembles the payload in one MemManager buffer.
+*
+* The module knows nothing about the MAC: an instance sends its frames and hands
+* over the payloads it reassembles through the functions given to Frag_Init().
+* The wrapper has one instance, and a host peer can run another one.
+*
+************************************************************************************/
+#ifndef _FRAGMENT_H
+#define _FRAGMENT_H
+
+#include "EmbeddedTypes.h"
+#include "MacInterface.h"
+#include "ieee802p15p4_wrapper_cfg.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* First byte of every data frame, when fragmentation is enabled. The wrapper
+ * uses 0xF3 for its packed frames (mwCoalescing_d). */
+#define mFragDispatchData_c         0x00    /* A plain frame, the payload follows */
+#define mFragDispatchFragment_c     0xF1
+#define mFragDispatchAck_c          0xF2
+
+/* Header of a fragment: dispatch, tag, index, flags, total length (LE) */
+#define mFragHeaderLen_c            6
+/* Longest frame the module sends */
+#define mFragMaxFrameLen_c          (mFragHeaderLen_c + mwFragPayloadLen_c)
+
+#define mFragBitmapWords_c          (256 / 32)
+
+/* Largest window, the acknowledgement bitmap has 32 bits */
+#define mFragMaxWindow_c            32
+
+#if (mwFragWindow_c < 1) || (mwFragWindow_c > mFragMaxWindow_c)
+#error "mwFragWindow_c must be within 1..32"
+#endif
+
+#if (mwFragMaxLength_c > 255 * mwFragPayloadLen_c) || (mwFragMaxLength_c > 0xFFFF)
+#error "mwFragMaxLength_c needs more than 255 fragments"
+#endif
+
+typedef struct fragInstance_tag fragInstance_t;
+
+/* Sends one frame. Returns FALSE if it cannot be queued now, the module tries
+ * again on a later Frag_Process(). */
+typedef bool_t (*pfFragSend_t)(fragInstance_t* pInst, uint16_t dest, uint8_t* pFrame, uint8_t length);
+/* Hands over a reassembled payload. pData is a MemManager buffer that belongs
+ * to the callee. */
+typedef void (*pfFragDeliver_t)(fragInstance_t* pInst, uint16_t src, uint8_t* pData, uint16_t length);
+/* End of a transfer started by Frag_Send(): gSuccess_c once every fragment is
+ * acknowledged, gNoAck_c if the receiver stopped answering. */
+typedef void (*pfFragTxDone_t)(resultType_t status, void* pContext);
+
+/* Type: fragRxSlot_t, a payload being reassembled */
+typedef struct fragRxSlot_tag
+{
+	uint8_t* pBuffer;
+	uint32_t lastHeard;                     /* Time [ms] of the last fragment */
+	uint32_t received[mFragBitmapWords_c];  /* Bit i: fragment i is in pBuffer */
+	uint16_t src;
+	uint16_t length;
+	uint8_t  tag;
+	uint8_t  count;                         /* Fragments of the payload */
+	uint8_t  base;                          /* First fragment not received */
+	uint8_t  ackUpTo;                       /* Fragment that asked for the last ack */
+	uint8_t  state;
+	bool_t   ackPending;                    /* An acknowledgement could not be sent yet */
+} fragRxSlot_t;
+
+/* Type: fragStats_t */
+typedef struct fragStats_tag
+{
+	uint32_t txFragments;       /* Fragments sent, retransmissions included */
+	uint32_t txRetransmissions;
+	uint32_t txAckRequests;
+	uint32_t txTimeouts;
+	uint32_t rxFragments;
+	uint32_t rxDuplicates;
+	uint32_t rxDropped;         /* Invalid, or no room to reassemble them */
+	uint32_t rxDelivered;
+} fragStats_t;
+
+/* Type: fragInstance_t. Its members are private to Fragment.c. */
+struct fragInstance_tag
+{
+	pfFragSend_t    pfSend;
+	pfFragDeliver_t pfDeliver;
+	uint8_t         window;
+
+	/* Payload being sent */
+	const uint8_t*  pTxData;
+	pfFragTxDone_t  pfTxDone;
+	void*           pTxContext;
+	uint32_t        txAcked[mFragBitmapWords_c];    /* The receiver holds them */
+	uint32_t        txMissing[mFragBitmapWords_c];  /* To be sent again */
+	uint32_t        txAfterReq[mFragBitmapWords_c]; /* Sent after the last ack request */
+	uint32_t        ackDeadline;
+	uint16_t        txDest;
+	uint16_t        txLength;
+	uint8_t         txTag;
+	uint8_t         txCount;
+	uint8_t         txBase;                         /* First fragment not acknowledged */
+	uint8_t         txNext;                         /* First fragment never sent */
+	uint8_t         txSinceReq;
+	uint8_t         txReqIndex;                     /* Fragment that asked for an ack */
+	uint8_t         txRetries;
+	bool_t          txBusy;
+	bool_t          txAckOutstanding;
+	bool_t          txPoll;                         /* The next fragment asks for an ack */
+
+	fragRxSlot_t    rx[mwFragMaxReassembly_c];
+	fragStats_t     stats;
+};
+
+/* Declarations of the fragmentation functions */
+void   Frag_Init(fragInstance_t* pInst, uint8_t window, pfFragSend_t pfSend, pfFragDeliver_t pfDeliver);
+bool_t Frag_Send(fragInstance_t* pInst, uint16_t dest, const uint8_t* pData, uint16_t length,
+                 pfFragTxDone_t pfDone, void* pContext);
+void   Frag_Receive(fragInstance_t* pInst, uint16_t src, uint8_t* pFrame, uint8_t length);
+bool_t Frag_Process(fragInstance_t* pInst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //_FRAGMENT_H
@@ -0,0 +1,135 @@
+/************************************************************************************
+* This module contains the implementation of the transmit latency statistics.
+*
+* Each stage keeps fixed counters, a sample costs a few additions and the
+* search of its bucket, one shift per power of two. Nothing is kept per
+* sample, so the statistics cover any run length: the totals are 64 bits, the
+* other counters wrap after 2^32 samples.
+*
+* The callers serialize the calls, the wrapper disables the interrupts around
+* them.
+*
+************************************************************************************/
+#include "LatencyStats.h"
+#include "TimersManager.h"
+#include "FunctionLib.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#if (mwLatencyBuckets_c < 2) || (mwLatencyBuckets_c > 32)
+#error "mwLatencyBuckets_c must be within 2..32"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static uint32_t LatencyStats_Bucket(uint32_t latency);
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static latencyStats_t mLatency[gLatencyStages_c];
+/* NULL: TMR_GetTimestamp() */
+static latencyClock_t mpfClock = NULL;
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* This is the initialization function for the module. It clears the
+* statistics of every stage, the clock is kept.
+******************************************************************************/
+void LatencyStats_Init(void)
+{
+	uint32_t stage;
+
+	FLib_MemSet(mLatency, 0, sizeof(mLatency));
+	for(stage = 0; stage < gLatencyStages_c; stage++)
+	{
+		mLatency[stage].min = 0xFFFFFFFF;
+	}
+}
+
+/******************************************************************************
+* This function sets the clock of the stamps, NULL for TMR_GetTimestamp().
+* A host build gives its virtual time, or a test clock.
+******************************************************************************/
+void LatencyStats_SetClock(latencyClock_t pfClock)
+{
+	mpfClock = pfClock;
+}
+
+/******************************************************************************
+* This function returns a stamp [us]. Only the differences of two stamps are
+* used, so it may wrap.
+******************************************************************************/
+uint32_t LatencyStats_Now(void)
+{
+	return (uint32_t)((mpfClock != NULL) ? mpfClock() : TMR_GetTimestamp());
+}
+
+/******************************************************************************
+* This function adds a sample of latency [us] to the statistics of a stage.
+******************************************************************************/
+void LatencyStats_Record(latencyStage_t stage, uint32_t latency)
+{
+	latencyStats_t* pStats = &mLatency[stage];
+
+	pStats->count++;
+	pStats->total += latency;
+	if(latency < pStats->min)
+	{
+		pStats->min = latency;
+	}
+	if(latency > pStats->max)
+	{
+		pStats->max = latency;
+	}
+	pStats->buckets[LatencyStats_Bucket(latency)]++;
+}
+
+/******************************************************************************
+* This function copies the statistics of a stage, and clears them if reset
+* is TRUE.
+******************************************************************************/
+void LatencyStats_Get(latencyStage_t stage, latencyStats_t* pStats, bool_t reset)
+{
+	FLib_MemCpy(pStats, &mLatency[stage], sizeof(latencyStats_t));
+	if(reset)
+	{
+		FLib_MemSet(&mLatency[stage], 0, sizeof(latencyStats_t));
+		mLatency[stage].min = 0xFFFFFFFF;
+	}
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* The LatencyStats_Bucket() function returns the histogram bucket of a
+* latency: the position of its highest bit set, limited to the last bucket.
+******************************************************************************/
+static uint32_t LatencyStats_Bucket(uint32_t latency)
+{
+	uint32_t bucket = 0;
+
+	while((latency >= 2) && (bucket < mwLatencyBuckets_c - 1))
+	{
+		latency >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
@@ -0,0 +1,63 @@
+/************************************************************************************
+* This module contains the interface of the transmit latency statistics.
+*
+* The wrapper stamps every data request when it is queued, handed to the MAC,
+* started and completed by the PHY, confirmed by the MAC and given back to the
+* caller, and records the time between two stamps in the statistics of that
+* stage: the number of samples, the shortest, longest and total time and a
+* histogram with one bucket per power of two microseconds.
+*
+* The stamps are read from TMR_GetTimestamp(), or from the clock set with
+* LatencyStats_SetClock(), which must count the same microseconds as the
+* stamps of the PHY (PhyGetTxTimestamps()).
+*
+************************************************************************************/
+#ifndef _LATENCY_STATS_H
+#define _LATENCY_STATS_H
+
+#include "EmbeddedTypes.h"
+#include "ieee802p15p4_wrapper_cfg.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* Stages of a data request, from one stamp to the next */
+typedef enum
+{
+	gLatencyQueue_c,        /* Queued in the wrapper, until handed to the MAC */
+	gLatencyMac_c,          /* Handed to the MAC, until the PHY starts the last attempt */
+	gLatencyPhy_c,          /* Last attempt: CCA, frame and ACK */
+	gLatencyConfirm_c,      /* End of the sequence, until the MAC confirms it */
+	gLatencyDelivery_c,     /* Confirmed, until the mac task gives it back */
+	gLatencyTotal_c,        /* Queued, until given back */
+	gLatencyStages_c
+} latencyStage_t;
+
+/* Type: latencyStats_t, the samples of one stage. Bucket 0 counts the times
+ * below 2 us, bucket n the times from 2^n us, below 2^(n+1) us, and the last
+ * one every longer time. */
+typedef struct latencyStats_tag
+{
+	uint32_t count;
+	uint32_t min;           /* [us], 0xFFFFFFFF without samples */
+	uint32_t max;           /* [us] */
+	uint64_t total;         /* [us] */
+	uint32_t buckets[mwLatencyBuckets_c];
+} latencyStats_t;
+
+/* Clock of the stamps [us] */
+typedef uint64_t (*latencyClock_t)(void);
+
+/* Declarations of the latency statistics functions */
+void     LatencyStats_Init(void);
+void     LatencyStats_SetClock(latencyClock_t pfClock);
+uint32_t LatencyStats_Now(void);
+void     LatencyStats_Record(latencyStage_t stage, uint32_t latency);
+void     LatencyStats_Get(latencyStage_t stage, latencyStats_t* pStats, bool_t reset);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //_LATENCY_STATS_H
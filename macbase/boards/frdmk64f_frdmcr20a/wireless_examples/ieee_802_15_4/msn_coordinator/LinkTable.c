@@ -0,0 +1,178 @@
+/************************************************************************************
+* This module contains the implementation of the neighbor link table.
+*
+* Records live in a static array of mwLinkTableSize_c elements per wrapper
+* instance, the one of the neighbor with short address a in the PAN of instance
+* i is mLinks[i][a]. Frames from or to addresses out of that range (broadcasts
+* included) are not recorded.
+*
+* The averages are exponentially weighted: each new sample moves them by
+* 1/2^mwLinkEwmaShift_c of the difference, so they follow the recent frames
+* without keeping any history. The first sample sets them.
+*
+* Only the LQI is averaged: the PHY derives the RSSI from it linearly
+* (PhyConvertLQIToRSSI()), so the RSSI of the average LQI is the average RSSI.
+*
+************************************************************************************/
+#include "LinkTable.h"
+#include "FunctionLib.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#if (mwLinkTableSize_c < 1) || (mwLinkTableSize_c > 0xFFFE)
+#error "mwLinkTableSize_c must be within 1..65534"
+#endif
+
+#if (mwLinkEwmaShift_c < 0) || (mwLinkEwmaShift_c > 8)
+#error "mwLinkEwmaShift_c must be within 0..8"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static linkTableEntry_t* LinkTable_Get(uint8_t instance, uint16_t shortAddress);
+static uint32_t LinkTable_Average(uint32_t average, uint32_t sample, bool_t first);
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static linkTableEntry_t mLinks[mwMaxInstances_c][mwLinkTableSize_c];
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* This is the initialization function for the module. It empties the table.
+******************************************************************************/
+void LinkTable_Init(void)
+{
+	FLib_MemSet(mLinks, 0, sizeof(mLinks));
+}
+
+/******************************************************************************
+* This function forgets a neighbor, before its short address is given to
+* another node.
+******************************************************************************/
+void LinkTable_Clear(uint8_t instance, uint16_t shortAddress)
+{
+	linkTableEntry_t* pLink = LinkTable_Get(instance, shortAddress);
+
+	if(pLink != NULL)
+	{
+		FLib_MemSet(pLink, 0, sizeof(linkTableEntry_t));
+	}
+}
+
+/******************************************************************************
+* This function records a frame received from a neighbor with the given LQI,
+* at time now [ms].
+******************************************************************************/
+void LinkTable_Heard(uint8_t instance, uint16_t shortAddress, uint8_t lqi, uint32_t now)
+{
+	linkTableEntry_t* pLink = LinkTable_Get(instance, shortAddress);
+
+	if(pLink == NULL)
+	{
+		return;
+	}
+
+	pLink->lqi = (uint16_t)LinkTable_Average(pLink->lqi, (uint32_t)lqi << mLinkAvgShift_c,
+	                                         (pLink->flags & mLinkHeard_c) == 0);
+	pLink->lastLqi = lqi;
+	pLink->lastHeard = now;
+	pLink->rxFrames++;
+	pLink->flags |= mLinkHeard_c;
+}
+
+/******************************************************************************
+* This function records the confirm of a frame sent to a neighbor, latency
+* [us] after it was handed to the MAC, at time now [ms]. A successful confirm
+* means the neighbor acknowledged the frame, so it was heard too.
+******************************************************************************/
+void LinkTable_TxConfirm(uint8_t instance, uint16_t shortAddress, resultType_t status, uint32_t latency,
+                         uint32_t now)
+{
+	linkTableEntry_t* pLink = LinkTable_Get(instance, shortAddress);
+
+	if(pLink == NULL)
+	{
+		return;
+	}
+
+	pLink->cnfLatency = LinkTable_Average(pLink->cnfLatency, latency, (pLink->flags & mLinkTx_c) == 0);
+	pLink->txAttempts++;
+	pLink->flags |= mLinkTx_c;
+
+	if(status == gSuccess_c)
+	{
+		pLink->lastHeard = now;
+	}
+	else if(status == gNoAck_c)
+	{
+		pLink->txNoAck++;
+	}
+	else
+	{
+		pLink->txFailures++;
+	}
+}
+
+/******************************************************************************
+* This function returns the record of a neighbor, or NULL if nothing was
+* received from it nor sent to it yet.
+******************************************************************************/
+const linkTableEntry_t* LinkTable_Find(uint8_t instance, uint16_t shortAddress)
+{
+	linkTableEntry_t* pLink = LinkTable_Get(instance, shortAddress);
+
+	if((pLink == NULL) || (pLink->flags == 0))
+	{
+		return NULL;
+	}
+
+	return pLink;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* The LinkTable_Get() function returns the record of a short address in the PAN
+* of a wrapper instance, or NULL if the address is out of the table.
+******************************************************************************/
+static linkTableEntry_t* LinkTable_Get(uint8_t instance, uint16_t shortAddress)
+{
+	if((instance >= mwMaxInstances_c) || (shortAddress >= mwLinkTableSize_c))
+	{
+		return NULL;
+	}
+
+	return &mLinks[instance][shortAddress];
+}
+
+/******************************************************************************
+* The LinkTable_Average() function returns an average updated with a new
+* sample, or the sample itself if it is the first one.
+******************************************************************************/
+static uint32_t LinkTable_Average(uint32_t average, uint32_t sample, bool_t first)
+{
+	if(first)
+	{
+		return sample;
+	}
+
+	return (uint32_t)((int32_t)average + ((int32_t)sample - (int32_t)average) / (1 << mwLinkEwmaShift_c));
+}
@@ -0,0 +1,56 @@
+/************************************************************************************
+* This module contains the interface of the neighbor link table.
+*
+* The table keeps one record per neighbor of each wrapper instance (PAN): the
+* quality of the frames received from it and the results of the frames sent to
+* it. A short address is only unique in its PAN, so the records are kept by
+* instance and short address. Short addresses are given out by the coordinator
+* from a contiguous range (DeviceTable.c), so the record of a neighbor is at the
+* index of its short address and every operation is a plain array access.
+*
+************************************************************************************/
+#ifndef _LINK_TABLE_H
+#define _LINK_TABLE_H
+
+#include "EmbeddedTypes.h"
+#include "MacInterface.h"
+#include "ieee802p15p4_wrapper_cfg.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* Fixed point of the averages: 1/16 units */
+#define mLinkAvgShift_c         4
+
+/* Flags of a record: the averages hold at least one sample */
+#define mLinkHeard_c            0x01    /* A frame was received */
+#define mLinkTx_c               0x02    /* A frame was confirmed */
+
+/* Type: linkTableEntry_t */
+typedef struct linkTableEntry_tag
+{
+	uint32_t lastHeard;     /* Time [ms] of the last frame or acknowledgement received */
+	uint32_t rxFrames;
+	uint32_t txAttempts;    /* Data requests confirmed, whatever their status */
+	uint32_t txNoAck;
+	uint32_t txFailures;    /* Other unsuccessful confirms: channel access... */
+	uint32_t cnfLatency;    /* Average from the hand-off to the MAC to the confirm [us] */
+	uint16_t lqi;           /* Average LQI of the frames received, 1/16 units */
+	uint8_t  lastLqi;
+	uint8_t  flags;
+} linkTableEntry_t;
+
+/* Declarations of the link table functions */
+void                    LinkTable_Init(void);
+void                    LinkTable_Clear(uint8_t instance, uint16_t shortAddress);
+void                    LinkTable_Heard(uint8_t instance, uint16_t shortAddress, uint8_t lqi, uint32_t now);
+void                    LinkTable_TxConfirm(uint8_t instance, uint16_t shortAddress, resultType_t status,
+                                            uint32_t latency, uint32_t now);
+const linkTableEntry_t* LinkTable_Find(uint8_t instance, uint16_t shortAddress);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //_LINK_TABLE_H
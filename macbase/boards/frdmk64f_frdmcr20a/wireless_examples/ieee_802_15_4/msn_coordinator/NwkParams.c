@@ -0,0 +1,256 @@
+/************************************************************************************
+* This module contains the implementation of the persistent network parameters.
+*
+* The two reserved sectors are used as an append only log of fixed size slots,
+* each one a multiple of the flash program unit. Saving writes the parameters with
+* a CRC and a sequence number in the first blank slot of the sector holding the
+* last record. Once that sector is full the record goes to the first slot of the
+* other one, erased first, so each sector is erased once every
+* mNwkParamsSlots_c saves at most. The sector holding the last record is never
+* erased: loading takes the valid record with the highest sequence number, and a
+* save cut by a reset, before or after an erase, leaves the previous parameters.
+*
+************************************************************************************/
+#include "NwkParams.h"
+#include "Flash_Adapter.h"
+#include "FunctionLib.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mNwkParamsSectorSize_c  (FSL_FEATURE_FLASH_PFLASH_BLOCK_SECTOR_SIZE)
+#define mNwkParamsSectors_c     (2)
+#define mNwkParamsTag_c         (0x504B574EUL)   /* "NWKP" */
+#define mNwkParamsCrcPoly_c     (0x1021)
+
+/* Slot size: the record rounded up to the flash program unit */
+#define mNwkParamsSlotSize_c    ((sizeof(nwkParamsRecord_t) + PGM_SIZE_BYTE - 1) & ~(PGM_SIZE_BYTE - 1))
+#define mNwkParamsSlots_c       (mNwkParamsSectorSize_c / mNwkParamsSlotSize_c)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct nwkParamsRecord_tag
+{
+	uint32_t    tag;
+	uint32_t    sequence;           /* One more than the record saved before */
+	nwkParams_t params;
+	uint16_t    crc;                /* CRC16-CCITT over tag, sequence and params */
+} nwkParamsRecord_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static uint8_t* NwkParams_Slot(uint32_t sector, uint32_t slot);
+static uint32_t NwkParams_FindLast(uint32_t sector, nwkParamsRecord_t** ppLast);
+static nwkParamsRecord_t* NwkParams_FindNewest(uint32_t* pSector, uint32_t* pSlot);
+static uint32_t NwkParams_EraseSector(uint32_t sector);
+static uint16_t NwkParams_Crc(uint8_t* pData, uint32_t length);
+
+/************************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Start of the sectors, defined by the linker */
+extern uint32_t NWK_PARAMS_BASE_ADDR[];
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* This function copies the last saved parameters. It returns FALSE if none
+* were saved or if the sectors do not hold a valid record.
+******************************************************************************/
+bool_t NwkParams_Load(nwkParams_t* pParams)
+{
+	nwkParamsRecord_t* pLast;
+	uint32_t sector;
+	uint32_t slot;
+
+	pLast = NwkParams_FindNewest(&sector, &slot);
+	if(pLast == NULL)
+	{
+		return FALSE;
+	}
+
+	FLib_MemCpy(pParams, &pLast->params, sizeof(nwkParams_t));
+	return TRUE;
+}
+
+/******************************************************************************
+* This function saves the parameters, unless they are the ones already saved.
+* The caller clears the structure before filling it, so the padding bytes
+* compare equal. It returns the status of the flash driver, 0 on success.
+******************************************************************************/
+uint32_t NwkParams_Save(nwkParams_t* pParams)
+{
+	nwkParamsRecord_t* pLast;
+	uint8_t  buffer[mNwkParamsSlotSize_c];
+	nwkParamsRecord_t* pRecord = (nwkParamsRecord_t*)buffer;
+	uint32_t sector;
+	uint32_t slot;
+	uint32_t status;
+
+	pLast = NwkParams_FindNewest(&sector, &slot);
+	if((pLast != NULL) && FLib_MemCmp(&pLast->params, pParams, sizeof(nwkParams_t)))
+	{
+		return 0;
+	}
+
+	NV_Init();
+
+	/* Sector full: start over from the first slot of the other one. The last
+	   record stays where it is until the new one is programmed. */
+	if(slot == mNwkParamsSlots_c)
+	{
+		sector ^= 1;
+		status = NwkParams_EraseSector(sector);
+		if(status != 0)
+		{
+			return status;
+		}
+		slot = 0;
+	}
+
+	FLib_MemSet(buffer, 0xFF, sizeof(buffer));
+	pRecord->tag = mNwkParamsTag_c;
+	pRecord->sequence = (pLast != NULL) ? (pLast->sequence + 1) : 0;
+	FLib_MemCpy(&pRecord->params, pParams, sizeof(nwkParams_t));
+	pRecord->crc = NwkParams_Crc(buffer, (uint32_t)((uint8_t*)&pRecord->crc - buffer));
+
+	return NV_FlashProgram((uint32_t)(uintptr_t)NwkParams_Slot(sector, slot), sizeof(buffer), buffer);
+}
+
+/******************************************************************************
+* This function forgets the saved parameters, so the next connection scans for
+* its network. It returns the status of the flash driver, 0 on success.
+******************************************************************************/
+uint32_t NwkParams_Erase(void)
+{
+	uint32_t status;
+
+	NV_Init();
+	status = NwkParams_EraseSector(0);
+	if(status == 0)
+	{
+		status = NwkParams_EraseSector(1);
+	}
+	return status;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+* The NwkParams_Slot() function returns the flash address of a slot.
+******************************************************************************/
+static uint8_t* NwkParams_Slot(uint32_t sector, uint32_t slot)
+{
+	return (uint8_t*)NWK_PARAMS_BASE_ADDR + sector * mNwkParamsSectorSize_c + slot * mNwkParamsSlotSize_c;
+}
+
+/******************************************************************************
+* The NwkParams_FindLast() function walks the slots of a sector up to the
+* first blank one. It sets *ppLast to the last record with a valid CRC, or
+* NULL, and returns the index of the first blank slot, mNwkParamsSlots_c if
+* the sector is full.
+******************************************************************************/
+static uint32_t NwkParams_FindLast(uint32_t sector, nwkParamsRecord_t** ppLast)
+{
+	nwkParamsRecord_t* pRecord;
+	uint32_t slot;
+	uint32_t i;
+
+	*ppLast = NULL;
+
+	for(slot = 0; slot < mNwkParamsSlots_c; slot++)
+	{
+		pRecord = (nwkParamsRecord_t*)NwkParams_Slot(sector, slot);
+
+		for(i = 0; i < mNwkParamsSlotSize_c; i++)
+		{
+			if(((uint8_t*)pRecord)[i] != 0xFF)
+			{
+				break;
+			}
+		}
+		if(i == mNwkParamsSlotSize_c)
+		{
+			break;
+		}
+
+		if((pRecord->tag == mNwkParamsTag_c) &&
+		   (pRecord->crc == NwkParams_Crc((uint8_t*)pRecord, (uint32_t)((uint8_t*)&pRecord->crc - (uint8_t*)pRecord))))
+		{
+			*ppLast = pRecord;
+		}
+	}
+
+	return slot;
+}
+
+/******************************************************************************
+* The NwkParams_FindNewest() function returns the valid record with the
+* highest sequence number of both sectors, or NULL. It sets *pSector to the
+* sector of that record, the first one if there is none, and *pSlot to the
+* first blank slot of that sector.
+******************************************************************************/
+static nwkParamsRecord_t* NwkParams_FindNewest(uint32_t* pSector, uint32_t* pSlot)
+{
+	nwkParamsRecord_t* pLast[mNwkParamsSectors_c];
+	uint32_t blank[mNwkParamsSectors_c];
+	uint32_t sector;
+
+	for(sector = 0; sector < mNwkParamsSectors_c; sector++)
+	{
+		blank[sector] = NwkParams_FindLast(sector, &pLast[sector]);
+	}
+
+	sector = ((pLast[1] != NULL) && ((pLast[0] == NULL) || (pLast[1]->sequence > pLast[0]->sequence))) ? 1 : 0;
+	*pSector = sector;
+	*pSlot = blank[sector];
+	return pLast[sector];
+}
+
+/******************************************************************************
+* The NwkParams_EraseSector() function erases one of the sectors. It returns
+* the status of the flash driver, 0 on success.
+******************************************************************************/
+static uint32_t NwkParams_EraseSector(uint32_t sector)
+{
+	return NV_FlashEraseSector((uint32_t)(uintptr_t)NwkParams_Slot(sector, 0), mNwkParamsSectorSize_c);
+}
+
+/******************************************************************************
+* The NwkParams_Crc() function computes the CRC16-CCITT of a buffer, the same
+* as the one of the hardware parameters.
+******************************************************************************/
+static uint16_t NwkParams_Crc(uint8_t* pData, uint32_t length)
+{
+	uint16_t crc = 0;
+	uint8_t  bit;
+
+	while(length--)
+	{
+		crc ^= (uint16_t)(*pData++) << 8;
+		for(bit = 0; bit < 8; bit++)
+		{
+			crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ mNwkParamsCrcPoly_c) : (uint16_t)(crc << 1);
+		}
+	}
+
+	return crc;
+}
@@ -0,0 +1,46 @@
+/************************************************************************************
+* This module contains the interface of the persistent network parameters.
+*
+* The parameters of the last successful connection (role, PAN Id, channel, short
+* address and coordinator descriptor) are kept in the two flash sectors reserved by
+* the linker at NWK_PARAMS_BASE_ADDR (gUseNwkParamsLink_d), so the wrapper can
+* rejoin its network after a reset without scanning for it.
+*
+************************************************************************************/
+#ifndef _NWK_PARAMS_H
+#define _NWK_PARAMS_H
+
+#include "EmbeddedTypes.h"
+#include "MacInterface.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* Role of the node in the saved network */
+enum
+{
+	mNwkParamsCoordinator_c,
+	mNwkParamsDevice_c
+};
+
+/* Type: nwkParams_t */
+typedef struct nwkParams_tag
+{
+	panDescriptor_t coordInfo;      /* Coordinator the device associated to */
+	uint16_t        panId;
+	uint16_t        shortAddress;
+	uint8_t         channel;
+	uint8_t         role;
+} nwkParams_t;
+
+/* Declarations of the network parameters functions */
+bool_t   NwkParams_Load(nwkParams_t* pParams);
+uint32_t NwkParams_Save(nwkParams_t* pParams);
+uint32_t NwkParams_Erase(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //_NWK_PARAMS_H
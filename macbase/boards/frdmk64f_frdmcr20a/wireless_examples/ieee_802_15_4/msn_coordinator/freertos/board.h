@@ -1,118 +1,118 @@
-/*
-* Copyright (c) 2015, Freescale Semiconductor, Inc.
-* All rights reserved.
-*
-* Redistribution and use in source and binary forms, with or without modification,
-* are permitted provided that the following conditions are met:
-*
-* o Redistributions of source code must retain the above copyright notice, this list
-*   of conditions and the following disclaimer.
-*
-* o Redistributions in binary form must reproduce the above copyright notice, this
-*   list of conditions and the following disclaimer in the documentation and/or
-*   other materials provided with the distribution.
-*
-* o Neither the name of Freescale Semiconductor, Inc. nor the names of its
-*   contributors may be used to endorse or promote products derived from this
-*   software without specific prior written permission.
-*
-* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
-* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
-* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
-* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
-* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
-* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
-* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
-* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
-* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
-* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
-*/
-
-#ifndef _BOARD_H_
-#define _BOARD_H_
-
-#include "fsl_gpio.h"
-
-/*******************************************************************************
- * Definitions
- ******************************************************************************/
-
-/* The board name */
-#define BOARD_NAME                      "FRDM-K64F_FRDM-MCR20A"
-
-#define CLOCK_VLPR 1U
-#define CLOCK_RUN  2U
-
-#ifndef CLOCK_INIT_CONFIG
-#define CLOCK_INIT_CONFIG CLOCK_RUN
-#endif
-
-/* OSC0 configuration. */
-#define BOARD_XTAL0_CLK_HZ 50000000U
-/* RTC external clock configuration. */
-#define BOARD_XTAL32K_CLK_HZ 32768U
-
-/* Connectivity */
-#define gXcvrSpiInstance_c      0
-
-#ifndef APP_SERIAL_INTERFACE_TYPE
-#define APP_SERIAL_INTERFACE_TYPE (gSerialMgrUart_c)
-#endif
-
-#ifndef APP_SERIAL_INTERFACE_INSTANCE
-#define APP_SERIAL_INTERFACE_INSTANCE (0)
-#endif
-
-#ifndef APP_SERIAL_INTERFACE_SPEED
-#define APP_SERIAL_INTERFACE_SPEED gUARTBaudRate115200_c
-#endif
-
-/* EEPROM type used */
-#ifndef gEepromType_d
-#define gEepromType_d gEepromDevice_InternalFlash_c
-#endif
-
-/* 1<<x to enable PINx as wakup source in LLWU */
-#define BOARD_LLWU_PIN_ENABLE_BITMAP ( 1<<3 | 1<<10 )
-
-/* The PWM channels used for RGB LED */
-#define BOARD_USE_PWM_FOR_RGB_LED       0
-
-/* Index into the ledPins[] array */
-#ifndef gRedLedIdx_c
-#define gRedLedIdx_c                    0
-#endif
-#ifndef gGreenLedIdx_c
-#define gGreenLedIdx_c                  1
-#endif
-#ifndef gBlueLedIdx_c
-#define gBlueLedIdx_c                   2
-#endif
-
-
-/*******************************************************************************
- * Definitions
- ******************************************************************************/  
-#if defined(__cplusplus)
-extern "C" {
-#endif /* __cplusplus */
-
-/*******************************************************************************
- * API
- ******************************************************************************/
-void hardware_init(void);
-void BOARD_InitDebugConsole(void);
-
-void BOARD_EnterLowPowerCb(void);
-void BOARD_ExitLowPowerCb(void);
-
-/* Functions used to determine the frequency of a module's input clock. */
-uint32_t BOARD_GetUartClock(uint32_t instance);
-uint32_t BOARD_GetFtmClock(uint32_t instance);
-uint32_t BOARD_GetSpiClock(uint32_t instance);
-uint32_t BOARD_GetI2cClock(uint32_t instance);
-#if defined(__cplusplus)
-}
-#endif /* __cplusplus */
-
-#endif /* _BOARD_H_ */
+/*
+* Copyright (c) 2015, Freescale Semiconductor, Inc.
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without modification,
+* are permitted provided that the following conditions are met:
+*
+* o Redistributions of source code must retain the above copyright notice, this list
+*   of conditions and the following disclaimer.
+*
+* o Redistributions in binary form must reproduce the above copyright notice, this
+*   list of conditions and the following disclaimer in the documentation and/or
+*   other materials provided with the distribution.
+*
+* o Neither the name of Freescale Semiconductor, Inc. nor the names of its
+*   contributors may be used to endorse or promote products derived from this
+*   software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+* ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+* WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+* ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+* (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+* LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+* ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+* (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+* SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef _BOARD_H_
+#define _BOARD_H_
+
+#include "fsl_gpio.h"
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/* The board name */
+#define BOARD_NAME                      "FRDM-K64F_FRDM-MCR20A"
+
+#define CLOCK_VLPR 1U
+#define CLOCK_RUN  2U
+
+#ifndef CLOCK_INIT_CONFIG
+#define CLOCK_INIT_CONFIG CLOCK_RUN
+#endif
+
+/* OSC0 configuration. */
+#define BOARD_XTAL0_CLK_HZ 50000000U
+/* RTC external clock configuration. */
+#define BOARD_XTAL32K_CLK_HZ 32768U
+
+/* Connectivity */
+#define gXcvrSpiInstance_c      0
+
+#ifndef APP_SERIAL_INTERFACE_TYPE
+#define APP_SERIAL_INTERFACE_TYPE (gSerialMgrUart_c)
+#endif
+
+#ifndef APP_SERIAL_INTERFACE_INSTANCE
+#define APP_SERIAL_INTERFACE_INSTANCE (0)
+#endif
+
+#ifndef APP_SERIAL_INTERFACE_SPEED
+#define APP_SERIAL_INTERFACE_SPEED gUARTBaudRate115200_c
+#endif
+
+/* EEPROM type used */
+#ifndef gEepromType_d
+#define gEepromType_d gEepromDevice_InternalFlash_c
+#endif
+
+/* 1<<x to enable PINx as wakup source in LLWU */
+#define BOARD_LLWU_PIN_ENABLE_BITMAP ( 1<<3 | 1<<10 )
+
+/* The PWM channels used for RGB LED */
+#define BOARD_USE_PWM_FOR_RGB_LED       0
+
+/* Index into the ledPins[] array */
+#ifndef gRedLedIdx_c
+#define gRedLedIdx_c                    0
+#endif
+#ifndef gGreenLedIdx_c
+#define gGreenLedIdx_c                  1
+#endif
+#ifndef gBlueLedIdx_c
+#define gBlueLedIdx_c                   2
+#endif
+
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/  
+#if defined(__cplusplus)
+extern "C" {
+#endif /* __cplusplus */
+
+/*******************************************************************************
+ * API
+ ******************************************************************************/
+void hardware_init(void);
+void BOARD_InitDebugConsole(void);
+
+void BOARD_EnterLowPowerCb(void);
+void BOARD_ExitLowPowerCb(void);
+
+/* Functions used to determine the frequency of a module's input clock. */
+uint32_t BOARD_GetUartClock(uint32_t instance);
+uint32_t BOARD_GetFtmClock(uint32_t instance);
+uint32_t BOARD_GetSpiClock(uint32_t instance);
+uint32_t BOARD_GetI2cClock(uint32_t instance);
+#if defined(__cplusplus)
+}
+#endif /* __cplusplus */
+
+#endif /* _BOARD_H_ */
@@ -1,135 +1,135 @@
-/*
- * Copyright (c) 2013-2015, Freescale Semiconductor, Inc.
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without modification,
- * are permitted provided that the following conditions are met:
- *
- * o Redistributions of source code must retain the above copyright notice, this list
- *   of conditions and the following disclaimer.
- *
- * o Redistributions in binary form must reproduce the above copyright notice, this
- *   list of conditions and the following disclaimer in the documentation and/or
- *   other materials provided with the distribution.
- *
- * o Neither the name of Freescale Semiconductor, Inc. nor the names of its
- *   contributors may be used to endorse or promote products derived from this
- *   software without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
- * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
- * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
- * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
- * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
- * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
- * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
- * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
- * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
- * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- */
-
-#include "GPIO_Adapter.h"
-#include "gpio_pins.h"
-
-gpioInputPinConfig_t switchPins[] = {
-    /* FRDM-K64F switches */
-    {
-        .gpioPort = gpioPort_A_c,
-        .gpioPin = 4,
-        .pullSelect = pinPull_Up_c,
-        .interruptSelect = pinInt_FallingEdge_c
-    },
-    {
-        .gpioPort = gpioPort_C_c,
-        .gpioPin = 6,
-        .pullSelect = pinPull_Up_c,
-        .interruptSelect = pinInt_FallingEdge_c
-    },
-    /* FRDM-MCRR20A switches */
-    {
-        .gpioPort = gpioPort_A_c,
-        .gpioPin = 1,
-        .pullSelect = pinPull_Up_c,
-        .interruptSelect = pinInt_FallingEdge_c
-    },
-    {
-        .gpioPort = gpioPort_B_c,
-        .gpioPin = 23,
-        .pullSelect = pinPull_Up_c,
-        .interruptSelect = pinInt_FallingEdge_c
-    }
-};
-
-
-/* Declare Output GPIO pins */
-gpioOutputPinConfig_t ledPins[] = {
-    /* FRDM-MCR20A LEDs */
-    {
-        .gpioPort = gpioPort_C_c,
-        .gpioPin = 10,
-        .outputLogic = 1,
-        .slewRate = pinSlewRate_Slow_c,
-        .driveStrength = pinDriveStrength_Low_c
-    },
-    {
-        .gpioPort = gpioPort_C_c,
-        .gpioPin = 11,
-        .outputLogic = 1,
-        .slewRate = pinSlewRate_Slow_c,
-        .driveStrength = pinDriveStrength_Low_c
-    },
-    {
-        .gpioPort = gpioPort_B_c,
-        .gpioPin = 11,
-        .outputLogic = 1,
-        .slewRate = pinSlewRate_Slow_c,
-        .driveStrength = pinDriveStrength_Low_c
-    },
-    /* FRDM-MK64F LEDs */
-#if 0   
-    {
-        .gpioPort = gpioPort_E_c,
-        .gpioPin = 26,
-        .outputLogic = 1,
-        .slewRate = pinSlewRate_Slow_c,
-        .driveStrength = pinDriveStrength_Low_c      
-    },
-    {
-        .gpioPort = gpioPort_B_c,
-        .gpioPin = 22,
-        .outputLogic = 1,
-        .slewRate = pinSlewRate_Slow_c,
-        .driveStrength = pinDriveStrength_Low_c      
-    },
-#endif
-    {
-        .gpioPort = gpioPort_B_c,
-        .gpioPin = 21,
-        .outputLogic = 1,
-        .slewRate = pinSlewRate_Slow_c,
-        .driveStrength = pinDriveStrength_Low_c      
-    }
-};
-
-const gpioOutputPinConfig_t mXcvrSpiCsCfg = {
-    .gpioPort = gpioPort_D_c,
-    .gpioPin = 0,
-    .outputLogic = 1,
-    .slewRate = pinSlewRate_Fast_c,
-    .driveStrength = pinDriveStrength_Low_c
-};
-
-const gpioOutputPinConfig_t mXcvrResetPinCfg = {
-    .gpioPort = gpioPort_A_c,
-    .gpioPin = 2,
-    .outputLogic = 1,
-    .slewRate = pinSlewRate_Fast_c,
-    .driveStrength = pinDriveStrength_Low_c
-};
-
-const gpioInputPinConfig_t mXcvrIrqPinCfg = {
-    .gpioPort = gpioPort_B_c,
-    .gpioPin = 9,
-    .pullSelect = pinPull_Disabled_c,
-    .interruptSelect = pinInt_Disabled_c
-};
+/*
+ * Copyright (c) 2013-2015, Freescale Semiconductor, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of Freescale Semiconductor, Inc. nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "GPIO_Adapter.h"
+#include "gpio_pins.h"
+
+gpioInputPinConfig_t switchPins[] = {
+    /* FRDM-K64F switches */
+    {
+        .gpioPort = gpioPort_A_c,
+        .gpioPin = 4,
+        .pullSelect = pinPull_Up_c,
+        .interruptSelect = pinInt_FallingEdge_c
+    },
+    {
+        .gpioPort = gpioPort_C_c,
+        .gpioPin = 6,
+        .pullSelect = pinPull_Up_c,
+        .interruptSelect = pinInt_FallingEdge_c
+    },
+    /* FRDM-MCRR20A switches */
+    {
+        .gpioPort = gpioPort_A_c,
+        .gpioPin = 1,
+        .pullSelect = pinPull_Up_c,
+        .interruptSelect = pinInt_FallingEdge_c
+    },
+    {
+        .gpioPort = gpioPort_B_c,
+        .gpioPin = 23,
+        .pullSelect = pinPull_Up_c,
+        .interruptSelect = pinInt_FallingEdge_c
+    }
+};
+
+
+/* Declare Output GPIO pins */
+gpioOutputPinConfig_t ledPins[] = {
+    /* FRDM-MCR20A LEDs */
+    {
+        .gpioPort = gpioPort_C_c,
+        .gpioPin = 10,
+        .outputLogic = 1,
+        .slewRate = pinSlewRate_Slow_c,
+        .driveStrength = pinDriveStrength_Low_c
+    },
+    {
+        .gpioPort = gpioPort_C_c,
+        .gpioPin = 11,
+        .outputLogic = 1,
+        .slewRate = pinSlewRate_Slow_c,
+        .driveStrength = pinDriveStrength_Low_c
+    },
+    {
+        .gpioPort = gpioPort_B_c,
+        .gpioPin = 11,
+        .outputLogic = 1,
+        .slewRate = pinSlewRate_Slow_c,
+        .driveStrength = pinDriveStrength_Low_c
+    },
+    /* FRDM-MK64F LEDs */
+#if 0   
+    {
+        .gpioPort = gpioPort_E_c,
+        .gpioPin = 26,
+        .outputLogic = 1,
+        .slewRate = pinSlewRate_Slow_c,
+        .driveStrength = pinDriveStrength_Low_c      
+    },
+    {
+        .gpioPort = gpioPort_B_c,
+        .gpioPin = 22,
+        .outputLogic = 1,
+        .slewRate = pinSlewRate_Slow_c,
+        .driveStrength = pinDriveStrength_Low_c      
+    },
+#endif
+    {
+        .gpioPort = gpioPort_B_c,
+        .gpioPin = 21,
+        .outputLogic = 1,
+        .slewRate = pinSlewRate_Slow_c,
+        .driveStrength = pinDriveStrength_Low_c      
+    }
+};
+
+const gpioOutputPinConfig_t mXcvrSpiCsCfg = {
+    .gpioPort = gpioPort_D_c,
+    .gpioPin = 0,
+    .outputLogic = 1,
+    .slewRate = pinSlewRate_Fast_c,
+    .driveStrength = pinDriveStrength_Low_c
+};
+
+const gpioOutputPinConfig_t mXcvrResetPinCfg = {
+    .gpioPort = gpioPort_A_c,
+    .gpioPin = 2,
+    .outputLogic = 1,
+    .slewRate = pinSlewRate_Fast_c,
+    .driveStrength = pinDriveStrength_Low_c
+};
+
+const gpioInputPinConfig_t mXcvrIrqPinCfg = {
+    .gpioPort = gpioPort_B_c,
+    .gpioPin = 9,
+    .pullSelect = pinPull_Disabled_c,
+    .interruptSelect = pinInt_Disabled_c
+};
@@ -1,86 +1,86 @@
-/*
- * Copyright (c) 2013-2014, Freescale Semiconductor, Inc.
- * All rights reserved.
- *
- * Redistribution and use in source and binary forms, with or without modification,
- * are permitted provided that the following conditions are met:
- *
- * o Redistributions of source code must retain the above copyright notice, this list
- *   of conditions and the following disclaimer.
- *
- * o Redistributions in binary form must reproduce the above copyright notice, this
- *   list of conditions and the following disclaimer in the documentation and/or
- *   other materials provided with the distribution.
- *
- * o Neither the name of Freescale Semiconductor, Inc. nor the names of its
- *   contributors may be used to endorse or promote products derived from this
- *   software without specific prior written permission.
- *
- * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
- * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
- * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
- * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
- * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
- * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
- * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
- * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
- * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
- * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
- */
-
-#include "board.h"
-#include "pin_mux.h"
-#include "fsl_clock.h"
-#include "fsl_debug_console.h"
-#include "clock_config.h"
-#include "GPIO_Adapter.h"
-
-void hardware_init(void) 
-{
-    static uint8_t initialized = 0;
-    
-    if( !initialized )
-    {
-        if(SMC->PMPROT == 0x00)
-        {
-          SMC->PMPROT = SYSTEM_SMC_PMPROT_VALUE;
-        }
-        /* VLLSx recovery */
-        if((PMC->REGSC & PMC_REGSC_ACKISO_MASK) != 0x00U)
-        {
-            PMC->REGSC |= PMC_REGSC_ACKISO_MASK; /* Release hold with ACKISO:  Only has an effect if recovering from VLLSx.*/
-        }
-        /* enable clock for PORTs */
-        CLOCK_EnableClock(kCLOCK_PortA);
-        CLOCK_EnableClock(kCLOCK_PortB);
-        CLOCK_EnableClock(kCLOCK_PortC);
-        CLOCK_EnableClock(kCLOCK_PortD);
-        CLOCK_EnableClock(kCLOCK_PortE);
-
-        /* Enable USB Master Flash Read Access */
-        FMC->PFAPR |= FMC_PFAPR_M4AP_MASK;
-
-        /* Init board clock */
-        BOARD_BootClockRUN();
-        initialized = 1;
-    }
-}
-
-void NMI_Handler(void)
-{
-    /* Disable NMI pin */
-    CLOCK_EnableClock(kCLOCK_PortA);
-    GpioSetPinMux(gpioPort_A_c, 4u, pinMux_Gpio_c);
-}
-
-/*!
-** @}
-*/
-/*
-** ###################################################################
-**
-**     This file was created by Processor Expert 10.4 [05.10]
-**     for the Freescale Kinetis series of microcontrollers.
-**
-** ###################################################################
-*/
+/*
+ * Copyright (c) 2013-2014, Freescale Semiconductor, Inc.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without modification,
+ * are permitted provided that the following conditions are met:
+ *
+ * o Redistributions of source code must retain the above copyright notice, this list
+ *   of conditions and the following disclaimer.
+ *
+ * o Redistributions in binary form must reproduce the above copyright notice, this
+ *   list of conditions and the following disclaimer in the documentation and/or
+ *   other materials provided with the distribution.
+ *
+ * o Neither the name of Freescale Semiconductor, Inc. nor the names of its
+ *   contributors may be used to endorse or promote products derived from this
+ *   software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ * ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ * ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "board.h"
+#include "pin_mux.h"
+#include "fsl_clock.h"
+#include "fsl_debug_console.h"
+#include "clock_config.h"
+#include "GPIO_Adapter.h"
+
+void hardware_init(void) 
+{
+    static uint8_t initialized = 0;
+    
+    if( !initialized )
+    {
+        if(SMC->PMPROT == 0x00)
+        {
+          SMC->PMPROT = SYSTEM_SMC_PMPROT_VALUE;
+        }
+        /* VLLSx recovery */
+        if((PMC->REGSC & PMC_REGSC_ACKISO_MASK) != 0x00U)
+        {
+            PMC->REGSC |= PMC_REGSC_ACKISO_MASK; /* Release hold with ACKISO:  Only has an effect if recovering from VLLSx.*/
+        }
+        /* enable clock for PORTs */
+        CLOCK_EnableClock(kCLOCK_PortA);
+        CLOCK_EnableClock(kCLOCK_PortB);
+        CLOCK_EnableClock(kCLOCK_PortC);
+        CLOCK_EnableClock(kCLOCK_PortD);
+        CLOCK_EnableClock(kCLOCK_PortE);
+
+        /* Enable USB Master Flash Read Access */
+        FMC->PFAPR |= FMC_PFAPR_M4AP_MASK;
+
+        /* Init board clock */
+        BOARD_BootClockRUN();
+        initialized = 1;
+    }
+}
+
+void NMI_Handler(void)
+{
+    /* Disable NMI pin */
+    CLOCK_EnableClock(kCLOCK_PortA);
+    GpioSetPinMux(gpioPort_A_c, 4u, pinMux_Gpio_c);
+}
+
+/*!
+** @}
+*/
+/*
+** ###################################################################
+**
+**     This file was created by Processor Expert 10.4 [05.10]
+**     for the Freescale Kinetis series of microcontrollers.
+**
+** ###################################################################
+*/
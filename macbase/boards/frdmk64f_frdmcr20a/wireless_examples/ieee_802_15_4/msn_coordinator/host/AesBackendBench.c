@@ -0,0 +1,376 @@
+/************************************************************************************
+* This module contains a benchmark of the AES backends of the SafeSecure library
+* (aes_backend.h).
+*
+* Every backend built in is checked against the known answers of FIPS-197,
+* SP 800-38A (CTR) and RFC 3610 (CCM, packet vector #1), then against the C
+* backend on random keys and data. It is then measured: the key setup [cycles]
+* and the cycles/byte of ECB encryption and decryption, and of CTR and CCM over
+* 116 byte frames. The fastest one in CCM, the mode of SafeSecure_TransmitCcm(),
+* is the one to #define AES_BACKEND_DEFAULT to once it has passed here on the
+* target; until then the default is the C backend.
+*
+* The cycles are the time stamp counter on x86, the cycle counter of the core
+* on a Cortex-M4, the ns elsewhere. On the host only the C backend is built, run
+* it with AES_TTABLES 0, 1 and 4 to compare those. The SecLib and MMCAU
+* backends are in the table of a target build with AES_BACKEND_SECLIB and
+* AES_BACKEND_MMCAU.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make -B build/aes_backend_bench AES_TTABLES=<0|1|4>
+*
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "aes_backend.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mBenchBlocks_c          (200000)
+#define mBenchKeys_c            (20000)
+#define mBenchFrame_c           (116)
+#define mBenchMic_c             (4)
+#define mCheckRounds_c          (2000)
+
+#if defined(__x86_64__) || defined(__i386__) || defined(__ARM_ARCH_7EM__)
+#define mBenchUnit_c            "cycles"
+#else
+#define mBenchUnit_c            "ns"
+#endif
+
+#if defined(__ARM_ARCH_7EM__)
+/* Cycle counter of the Cortex-M4 (DWT), enabled by main() */
+#define mDemcr_c                (*(volatile uint32_t*)0xE000EDFCu)
+#define mDwtCtrl_c              (*(volatile uint32_t*)0xE0001000u)
+#define mDwtCyccnt_c            (*(volatile uint32_t*)0xE0001004u)
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/* Timings of one backend */
+typedef struct benchResult_tag
+{
+    double keySetup;            /* cycles */
+    double ecbEncrypt;          /* cycles/byte */
+    double ecbDecrypt;
+    double ctr;
+    double ccm;
+} benchResult_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* FIPS-197, appendix C.1 */
+static const uint8_t mFipsKey[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                      0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+static const uint8_t mFipsPlain[16] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                                        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+static const uint8_t mFipsCipher[16] = { 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+                                         0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+
+/* SP 800-38A, F.5.1 (CTR) */
+static const uint8_t mSpKey[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+static const uint8_t mSpPlain[64] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+static const uint8_t mSpCtrIv[16] = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+                                      0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff };
+static const uint8_t mSpCtrIvNext[16] = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+                                          0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xff, 0x03 };
+static const uint8_t mSpCtr[64] = {
+    0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+    0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+    0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e, 0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+    0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1, 0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee };
+
+/* RFC 3610, packet vector #1: 8 bytes of header (00..07) authenticated, 23
+ * bytes of payload (08..1e) encrypted, 8 bytes of MIC */
+static const uint8_t mCcmKey[16] = { 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+                                     0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf };
+static const uint8_t mCcmNonce[AES_CCM_NONCE_LEN] = { 0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00,
+                                                      0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5 };
+static const uint8_t mCcmCipher[31] = {
+    0x58, 0x8c, 0x97, 0x9a, 0x61, 0xc6, 0x63, 0xd2, 0xf0, 0x66, 0xd0, 0xc2, 0xc0, 0xf9, 0x89, 0x80,
+    0x6d, 0x5f, 0x6b, 0x61, 0xda, 0xc3, 0x84, 0x17, 0xe8, 0xd1, 0x2c, 0xfd, 0xf9, 0x26, 0xe0 };
+
+static volatile uint8_t mSink;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The Cycles() function returns the cycle counter, or the ns where there is
+ * none. Only differences are used, modulo 2^32.
+ ******************************************************************************/
+static uint32_t Cycles( void )
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#elif defined(__ARM_ARCH_7EM__)
+    return mDwtCyccnt_c;
+#else
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+/******************************************************************************
+ * The Check() function prints a failed comparison.
+ ******************************************************************************/
+static int Check( const struct AES_backend* pBackend, const char* pName, const uint8_t* pGot,
+                  const uint8_t* pExpected, uint32_t length )
+{
+    if( memcmp( pGot, pExpected, length ) )
+    {
+        printf( "%s: %s: wrong result\n", pBackend->name, pName );
+        return 0;
+    }
+    return 1;
+}
+
+/******************************************************************************
+ * The KnownAnswers() function runs a backend on the vectors of FIPS-197,
+ * SP 800-38A and RFC 3610.
+ ******************************************************************************/
+static int KnownAnswers( const struct AES_backend* pBackend )
+{
+    struct AES_key key;
+    uint8_t buf[64];
+    uint8_t counter[AES_BLOCKLEN];
+    uint8_t header[8];
+    uint32_t i;
+    int pass = 1;
+
+    AES_key_init( &key, pBackend, mFipsKey );
+    memcpy( buf, mFipsPlain, 16 );
+    AES_key_encrypt( &key, buf );
+    pass &= Check( pBackend, "FIPS-197 C.1 encrypt", buf, mFipsCipher, 16 );
+    AES_key_decrypt( &key, buf );
+    pass &= Check( pBackend, "FIPS-197 C.1 decrypt", buf, mFipsPlain, 16 );
+
+    /* In one call, then in two: the counter goes on from the first */
+    AES_key_init( &key, pBackend, mSpKey );
+    memcpy( buf, mSpPlain, 64 );
+    memcpy( counter, mSpCtrIv, AES_BLOCKLEN );
+    AES_key_ctr( &key, counter, buf, 64 );
+    pass &= Check( pBackend, "SP 800-38A F.5.1 CTR encrypt", buf, mSpCtr, 64 );
+    pass &= Check( pBackend, "SP 800-38A F.5.1 CTR counter", counter, mSpCtrIvNext, AES_BLOCKLEN );
+    memcpy( counter, mSpCtrIv, AES_BLOCKLEN );
+    AES_key_ctr( &key, counter, buf, 32 );
+    AES_key_ctr( &key, counter, &buf[32], 32 );
+    pass &= Check( pBackend, "SP 800-38A F.5.2 CTR decrypt", buf, mSpPlain, 64 );
+
+    for( i = 0; i < sizeof(header); i++ )
+    {
+        header[i] = (uint8_t)i;
+    }
+    for( i = 0; i < 23; i++ )
+    {
+        buf[i] = (uint8_t)(8 + i);
+    }
+    AES_key_init( &key, pBackend, mCcmKey );
+    AES_key_ccm( &key, mCcmNonce, header, sizeof(header), buf, 23, &buf[23], 8, 1 );
+    pass &= Check( pBackend, "RFC 3610 #1 CCM encrypt", buf, mCcmCipher, sizeof(mCcmCipher) );
+    if( !AES_key_ccm( &key, mCcmNonce, header, sizeof(header), buf, 23, &buf[23], 8, 0 ) ||
+        (buf[0] != 8) || (buf[22] != 30) )
+    {
+        printf( "%s: RFC 3610 #1 CCM decrypt: wrong result\n", pBackend->name );
+        pass = 0;
+    }
+    header[7] ^= 1;
+    if( AES_key_ccm( &key, mCcmNonce, header, sizeof(header), buf, 23, &buf[23], 8, 0 ) )
+    {
+        printf( "%s: RFC 3610 #1 CCM: changed header not caught\n", pBackend->name );
+        pass = 0;
+    }
+
+    return pass;
+}
+
+/******************************************************************************
+ * The AgainstC() function compares a backend with the C one on random keys,
+ * counters and data, in every mode.
+ ******************************************************************************/
+static int AgainstC( const struct AES_backend* pBackend )
+{
+    struct AES_key key, ref;
+    uint8_t raw[AES_KEYLEN];
+    uint8_t counter[AES_BLOCKLEN], refCounter[AES_BLOCKLEN];
+    uint8_t aad[24];
+    uint8_t buf[64], refBuf[64];
+    uint8_t mic[16], refMic[16];
+    uint32_t n, i, len;
+
+    srand( 1 );
+
+    for( n = 0; n < mCheckRounds_c; n++ )
+    {
+        for( i = 0; i < sizeof(raw); i++ )
+        {
+            raw[i] = (uint8_t)rand();
+        }
+        for( i = 0; i < sizeof(counter); i++ )
+        {
+            counter[i] = (uint8_t)rand();
+        }
+        for( i = 0; i < sizeof(aad); i++ )
+        {
+            aad[i] = (uint8_t)rand();
+        }
+        for( i = 0; i < sizeof(buf); i++ )
+        {
+            buf[i] = (uint8_t)rand();
+        }
+        memcpy( refCounter, counter, sizeof(counter) );
+        memcpy( refBuf, buf, sizeof(buf) );
+        len = n % sizeof(buf);
+
+        AES_key_init( &key, pBackend, raw );
+        AES_key_init( &ref, &AES_backend_c, raw );
+
+        AES_key_encrypt( &key, buf );
+        AES_key_encrypt( &ref, refBuf );
+        AES_key_decrypt( &key, &buf[16] );
+        AES_key_decrypt( &ref, &refBuf[16] );
+        AES_key_ctr( &key, counter, buf, len );
+        AES_key_ctr( &ref, refCounter, refBuf, len );
+        AES_key_ccm( &key, &counter[1], aad, n % sizeof(aad), buf, len, mic, 4 + 2 * (n % 7), 1 );
+        AES_key_ccm( &ref, &refCounter[1], aad, n % sizeof(aad), refBuf, len, refMic, 4 + 2 * (n % 7), 1 );
+
+        if( memcmp( buf, refBuf, sizeof(buf) ) || memcmp( counter, refCounter, sizeof(counter) ) ||
+            memcmp( mic, refMic, 4 + 2 * (n % 7) ) )
+        {
+            printf( "%s: round %u differs from the C backend\n", pBackend->name, (unsigned)n );
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/******************************************************************************
+ * The Bench() function times a backend.
+ ******************************************************************************/
+static void Bench( const struct AES_backend* pBackend, benchResult_t* pResult )
+{
+    struct AES_key key;
+    uint8_t buf[mBenchFrame_c + mBenchMic_c] = { 0 };
+    uint8_t counter[AES_BLOCKLEN] = { 0 };
+    uint32_t t0;
+    uint32_t i;
+
+    t0 = Cycles();
+    for( i = 0; i < mBenchKeys_c; i++ )
+    {
+        buf[0] = (uint8_t)i;
+        AES_key_init( &key, pBackend, buf );
+    }
+    pResult->keySetup = (double)(uint32_t)(Cycles() - t0) / mBenchKeys_c;
+
+    t0 = Cycles();
+    for( i = 0; i < mBenchBlocks_c; i++ )
+    {
+        AES_key_encrypt( &key, buf );
+    }
+    pResult->ecbEncrypt = (double)(uint32_t)(Cycles() - t0) / (mBenchBlocks_c * 16.0);
+
+    t0 = Cycles();
+    for( i = 0; i < mBenchBlocks_c; i++ )
+    {
+        AES_key_decrypt( &key, buf );
+    }
+    pResult->ecbDecrypt = (double)(uint32_t)(Cycles() - t0) / (mBenchBlocks_c * 16.0);
+
+    t0 = Cycles();
+    for( i = 0; i < mBenchBlocks_c / 8; i++ )
+    {
+        AES_key_ctr( &key, counter, buf, mBenchFrame_c );
+    }
+    pResult->ctr = (double)(uint32_t)(Cycles() - t0) / ((mBenchBlocks_c / 8) * (double)mBenchFrame_c);
+
+    t0 = Cycles();
+    for( i = 0; i < mBenchBlocks_c / 16; i++ )
+    {
+        counter[0] = (uint8_t)i;
+        AES_key_ccm( &key, counter, 0, 0, buf, mBenchFrame_c, &buf[mBenchFrame_c], mBenchMic_c, 1 );
+    }
+    pResult->ccm = (double)(uint32_t)(Cycles() - t0) / ((mBenchBlocks_c / 16) * (double)mBenchFrame_c);
+
+    mSink = buf[0];
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    benchResult_t result;
+    const struct AES_backend* pFastest = 0;
+    double fastest = 0;
+    uint8_t b;
+    int pass = 1;
+
+#if defined(__ARM_ARCH_7EM__)
+    mDemcr_c |= (1u << 24);     /* TRCENA */
+    mDwtCyccnt_c = 0;
+    mDwtCtrl_c |= 1u;           /* CYCCNTENA */
+#endif
+
+    printf( "              %13s  %14s  %14s  %9s  %9s\n", "key setup", "ecb encrypt", "ecb decrypt",
+            "ctr 116 B", "ccm 116 B" );
+    printf( "              %13s  %12s/B  %12s/B  %7s/B  %7s/B\n", mBenchUnit_c, mBenchUnit_c,
+            mBenchUnit_c, mBenchUnit_c, mBenchUnit_c );
+
+    for( b = 0; b < AES_backend_count; b++ )
+    {
+        const struct AES_backend* pBackend = AES_backends[b];
+
+        if( !KnownAnswers( pBackend ) || !AgainstC( pBackend ) )
+        {
+            pass = 0;
+            continue;
+        }
+
+        Bench( pBackend, &result );
+        printf( "%-12s  %13.0f  %14.1f  %14.1f  %9.1f  %9.1f\n", pBackend->name, result.keySetup,
+                result.ecbEncrypt, result.ecbDecrypt, result.ctr, result.ccm );
+
+        if( (0 == pFastest) || (result.ccm < fastest) )
+        {
+            pFastest = pBackend;
+            fastest = result.ccm;
+        }
+    }
+
+    if( pFastest )
+    {
+        printf( "fastest in ccm: %s, AES_BACKEND_DEFAULT: %s\n", pFastest->name, AES_BACKEND_DEFAULT->name );
+    }
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,342 @@
+/************************************************************************************
+* This module contains a host benchmark of the AES of the SafeSecure library.
+*
+* It checks the implementation selected by AES_TTABLES against the known
+* answers of FIPS-197 and SP 800-38A (ECB, CBC and CTR, both directions), then
+* against the byte oriented implementation (AesRef.c) on random keys and data.
+* It then measures both: the key setup [cycles] and the cycles/byte of ECB
+* encryption and decryption and of CTR over 116 byte frames. The cycles are the
+* time stamp counter on x86, the ns elsewhere.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make -B build/aes_bench AES_TTABLES=<1|4>
+*
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "aes.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mBenchBlocks_c          (200000)
+#define mBenchKeys_c            (20000)
+#define mBenchFrame_c           (116)
+#define mCheckRounds_c          (10000)
+
+#if defined(__x86_64__) || defined(__i386__)
+#define mBenchUnit_c            "cycles"
+#else
+#define mBenchUnit_c            "ns"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/* AesRef.c: the byte oriented implementation, with its context */
+struct Ref_AES_ctx
+{
+    uint8_t RoundKey[AES_keyExpSize];
+    uint8_t Iv[AES_BLOCKLEN];
+};
+
+void Ref_AES_init_ctx( struct Ref_AES_ctx* ctx, const uint8_t* key );
+void Ref_AES_init_ctx_iv( struct Ref_AES_ctx* ctx, const uint8_t* key, const uint8_t* iv );
+void Ref_AES_ECB_encrypt( const struct Ref_AES_ctx* ctx, uint8_t* buf );
+void Ref_AES_ECB_decrypt( const struct Ref_AES_ctx* ctx, uint8_t* buf );
+void Ref_AES_CBC_encrypt_buffer( struct Ref_AES_ctx* ctx, uint8_t* buf, uint32_t length );
+void Ref_AES_CBC_decrypt_buffer( struct Ref_AES_ctx* ctx, uint8_t* buf, uint32_t length );
+void Ref_AES_CTR_xcrypt_buffer( struct Ref_AES_ctx* ctx, uint8_t* buf, uint32_t length );
+
+/* Timings of one implementation */
+typedef struct benchResult_tag
+{
+    double keySetup;            /* cycles */
+    double ecbEncrypt;          /* cycles/byte */
+    double ecbDecrypt;
+    double ctr;
+} benchResult_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* FIPS-197, appendix C.1 */
+static const uint8_t mFipsKey[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                      0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+static const uint8_t mFipsPlain[16] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                                        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+static const uint8_t mFipsCipher[16] = { 0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30,
+                                         0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+
+/* SP 800-38A, F.1.1 (ECB), F.2.1 (CBC) and F.5.1 (CTR) */
+static const uint8_t mSpKey[16] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6,
+                                    0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+static const uint8_t mSpPlain[64] = {
+    0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+    0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+    0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+    0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+static const uint8_t mSpEcb[64] = {
+    0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60, 0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97,
+    0xf5, 0xd3, 0xd5, 0x85, 0x03, 0xb9, 0x69, 0x9d, 0xe7, 0x85, 0x89, 0x5a, 0x96, 0xfd, 0xba, 0xaf,
+    0x43, 0xb1, 0xcd, 0x7f, 0x59, 0x8e, 0xce, 0x23, 0x88, 0x1b, 0x00, 0xe3, 0xed, 0x03, 0x06, 0x88,
+    0x7b, 0x0c, 0x78, 0x5e, 0x27, 0xe8, 0xad, 0x3f, 0x82, 0x23, 0x20, 0x71, 0x04, 0x72, 0x5d, 0xd4 };
+static const uint8_t mSpCbcIv[16] = { 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                      0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+static const uint8_t mSpCbc[64] = {
+    0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+    0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+    0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+    0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09, 0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7 };
+static const uint8_t mSpCtrIv[16] = { 0xf0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7,
+                                      0xf8, 0xf9, 0xfa, 0xfb, 0xfc, 0xfd, 0xfe, 0xff };
+static const uint8_t mSpCtr[64] = {
+    0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce,
+    0x98, 0x06, 0xf6, 0x6b, 0x79, 0x70, 0xfd, 0xff, 0x86, 0x17, 0x18, 0x7b, 0xb9, 0xff, 0xfd, 0xff,
+    0x5a, 0xe4, 0xdf, 0x3e, 0xdb, 0xd5, 0xd3, 0x5e, 0x5b, 0x4f, 0x09, 0x02, 0x0d, 0xb0, 0x3e, 0xab,
+    0x1e, 0x03, 0x1d, 0xda, 0x2f, 0xbe, 0x03, 0xd1, 0x79, 0x21, 0x70, 0xa0, 0xf3, 0x00, 0x9c, 0xee };
+
+static volatile uint8_t mSink;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The Cycles() function returns the time stamp counter, or the ns where there
+ * is none.
+ ******************************************************************************/
+static uint64_t Cycles( void )
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+/******************************************************************************
+ * The Check() function prints a failed comparison.
+ ******************************************************************************/
+static int Check( const char* pName, const uint8_t* pGot, const uint8_t* pExpected, uint32_t length )
+{
+    if( memcmp( pGot, pExpected, length ) )
+    {
+        printf( "%s: wrong result\n", pName );
+        return 0;
+    }
+    return 1;
+}
+
+/******************************************************************************
+ * The KnownAnswers() function runs the implementation under test on the
+ * vectors of FIPS-197 and SP 800-38A.
+ ******************************************************************************/
+static int KnownAnswers( void )
+{
+    struct AES_ctx ctx;
+    uint8_t buf[64];
+    uint32_t i;
+    int pass = 1;
+
+    AES_init_ctx( &ctx, mFipsKey );
+    memcpy( buf, mFipsPlain, 16 );
+    AES_ECB_encrypt( &ctx, buf );
+    pass &= Check( "FIPS-197 C.1 encrypt", buf, mFipsCipher, 16 );
+    AES_ECB_decrypt( &ctx, buf );
+    pass &= Check( "FIPS-197 C.1 decrypt", buf, mFipsPlain, 16 );
+
+    AES_init_ctx( &ctx, mSpKey );
+    memcpy( buf, mSpPlain, 64 );
+    for( i = 0; i < 64; i += AES_BLOCKLEN )
+    {
+        AES_ECB_encrypt( &ctx, &buf[i] );
+    }
+    pass &= Check( "SP 800-38A F.1.1 ECB encrypt", buf, mSpEcb, 64 );
+    for( i = 0; i < 64; i += AES_BLOCKLEN )
+    {
+        AES_ECB_decrypt( &ctx, &buf[i] );
+    }
+    pass &= Check( "SP 800-38A F.1.2 ECB decrypt", buf, mSpPlain, 64 );
+
+    AES_init_ctx_iv( &ctx, mSpKey, mSpCbcIv );
+    memcpy( buf, mSpPlain, 64 );
+    AES_CBC_encrypt_buffer( &ctx, buf, 64 );
+    pass &= Check( "SP 800-38A F.2.1 CBC encrypt", buf, mSpCbc, 64 );
+    AES_ctx_set_iv( &ctx, mSpCbcIv );
+    AES_CBC_decrypt_buffer( &ctx, buf, 64 );
+    pass &= Check( "SP 800-38A F.2.2 CBC decrypt", buf, mSpPlain, 64 );
+
+    AES_init_ctx_iv( &ctx, mSpKey, mSpCtrIv );
+    memcpy( buf, mSpPlain, 64 );
+    AES_CTR_xcrypt_buffer( &ctx, buf, 64 );
+    pass &= Check( "SP 800-38A F.5.1 CTR encrypt", buf, mSpCtr, 64 );
+    AES_ctx_set_iv( &ctx, mSpCtrIv );
+    AES_CTR_xcrypt_buffer( &ctx, buf, 64 );
+    pass &= Check( "SP 800-38A F.5.2 CTR decrypt", buf, mSpPlain, 64 );
+
+    return pass;
+}
+
+/******************************************************************************
+ * The AgainstReference() function compares the implementation under test with
+ * the byte oriented one on random keys, IVs and data, in every mode.
+ ******************************************************************************/
+static int AgainstReference( void )
+{
+    struct AES_ctx ctx;
+    struct Ref_AES_ctx ref;
+    uint8_t key[AES_KEYLEN];
+    uint8_t iv[AES_BLOCKLEN];
+    uint8_t buf[64], refBuf[64];
+    uint32_t n, i;
+
+    srand( 1 );
+
+    for( n = 0; n < mCheckRounds_c; n++ )
+    {
+        for( i = 0; i < sizeof(key); i++ )
+        {
+            key[i] = (uint8_t)rand();
+        }
+        for( i = 0; i < sizeof(iv); i++ )
+        {
+            iv[i] = (uint8_t)rand();
+        }
+        for( i = 0; i < sizeof(buf); i++ )
+        {
+            buf[i] = (uint8_t)rand();
+        }
+        memcpy( refBuf, buf, sizeof(buf) );
+
+        AES_init_ctx_iv( &ctx, key, iv );
+        Ref_AES_init_ctx_iv( &ref, key, iv );
+        if( memcmp( ctx.RoundKey, ref.RoundKey, sizeof(ref.RoundKey) ) )
+        {
+            printf( "key schedule differs from the reference\n" );
+            return 0;
+        }
+
+        AES_ECB_encrypt( &ctx, buf );
+        Ref_AES_ECB_encrypt( &ref, refBuf );
+        AES_ECB_decrypt( &ctx, &buf[16] );
+        Ref_AES_ECB_decrypt( &ref, &refBuf[16] );
+        AES_CBC_encrypt_buffer( &ctx, buf, 64 );
+        Ref_AES_CBC_encrypt_buffer( &ref, refBuf, 64 );
+        AES_CBC_decrypt_buffer( &ctx, buf, 48 );
+        Ref_AES_CBC_decrypt_buffer( &ref, refBuf, 48 );
+        AES_CTR_xcrypt_buffer( &ctx, buf, 61 );
+        Ref_AES_CTR_xcrypt_buffer( &ref, refBuf, 61 );
+
+        if( memcmp( buf, refBuf, sizeof(buf) ) || memcmp( ctx.Iv, ref.Iv, sizeof(ref.Iv) ) )
+        {
+            printf( "round %u differs from the reference\n", n );
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+/******************************************************************************
+ * The BenchTest() and BenchRef() functions time the implementation under test
+ * and the reference.
+ ******************************************************************************/
+#define mBenchBody_m(ctxType, init, initIv, ecbEnc, ecbDec, xcrypt)               \
+{                                                                                 \
+    ctxType ctx;                                                                  \
+    uint8_t buf[mBenchFrame_c] = { 0 };                                           \
+    uint64_t t0;                                                                  \
+    uint32_t i;                                                                   \
+                                                                                  \
+    t0 = Cycles();                                                                \
+    for( i = 0; i < mBenchKeys_c; i++ )                                           \
+    {                                                                             \
+        buf[0] = (uint8_t)i;                                                      \
+        init( &ctx, buf );                                                        \
+    }                                                                             \
+    pResult->keySetup = (double)(Cycles() - t0) / mBenchKeys_c;                   \
+                                                                                  \
+    t0 = Cycles();                                                                \
+    for( i = 0; i < mBenchBlocks_c; i++ )                                         \
+    {                                                                             \
+        ecbEnc( &ctx, buf );                                                      \
+    }                                                                             \
+    pResult->ecbEncrypt = (double)(Cycles() - t0) / (mBenchBlocks_c * 16.0);      \
+                                                                                  \
+    t0 = Cycles();                                                                \
+    for( i = 0; i < mBenchBlocks_c; i++ )                                         \
+    {                                                                             \
+        ecbDec( &ctx, buf );                                                      \
+    }                                                                             \
+    pResult->ecbDecrypt = (double)(Cycles() - t0) / (mBenchBlocks_c * 16.0);      \
+                                                                                  \
+    initIv( &ctx, buf, buf );                                                     \
+    t0 = Cycles();                                                                \
+    for( i = 0; i < mBenchBlocks_c / 8; i++ )                                     \
+    {                                                                             \
+        xcrypt( &ctx, buf, mBenchFrame_c );                                       \
+    }                                                                             \
+    pResult->ctr = (double)(Cycles() - t0) / ((mBenchBlocks_c / 8) * (double)mBenchFrame_c); \
+    mSink = buf[0];                                                               \
+}
+
+static void BenchTest( benchResult_t* pResult )
+mBenchBody_m( struct AES_ctx, AES_init_ctx, AES_init_ctx_iv, AES_ECB_encrypt,
+              AES_ECB_decrypt, AES_CTR_xcrypt_buffer )
+
+static void BenchRef( benchResult_t* pResult )
+mBenchBody_m( struct Ref_AES_ctx, Ref_AES_init_ctx, Ref_AES_init_ctx_iv, Ref_AES_ECB_encrypt,
+              Ref_AES_ECB_decrypt, Ref_AES_CTR_xcrypt_buffer )
+
+/******************************************************************************
+ * The PrintResult() function prints a line of the table.
+ ******************************************************************************/
+static void PrintResult( const char* pName, const benchResult_t* pResult )
+{
+    printf( "%-12s  %13.0f  %14.1f  %14.1f  %9.1f\n", pName, pResult->keySetup,
+            pResult->ecbEncrypt, pResult->ecbDecrypt, pResult->ctr );
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    benchResult_t ref, test;
+    char name[16];
+    int pass = KnownAnswers() && AgainstReference();
+
+    BenchRef( &ref );
+    BenchTest( &test );
+
+    printf( "              %13s  %14s  %14s  %9s\n", "key setup", "ecb encrypt", "ecb decrypt", "ctr 116 B" );
+    printf( "              %13s  %12s/B  %12s/B  %7s/B\n", mBenchUnit_c, mBenchUnit_c, mBenchUnit_c, mBenchUnit_c );
+    PrintResult( "bytes", &ref );
+    snprintf( name, sizeof(name), "ttables %u", AES_TTABLES );
+    PrintResult( name, &test );
+    printf( "speedup       %13.2f  %14.2f  %14.2f  %9.2f\n", ref.keySetup / test.keySetup,
+            ref.ecbEncrypt / test.ecbEncrypt, ref.ecbDecrypt / test.ecbDecrypt, ref.ctr / test.ctr );
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,20 @@
+/************************************************************************************
+* This module contains the reference of the AES host benchmark (AesBench.c): the
+* byte oriented AES of the SafeSecure library, built next to the one under test
+* with its functions and context renamed Ref_.
+*
+************************************************************************************/
+#undef AES_TTABLES
+#define AES_TTABLES                 0
+
+#define AES_ctx                     Ref_AES_ctx
+#define AES_init_ctx                Ref_AES_init_ctx
+#define AES_init_ctx_iv             Ref_AES_init_ctx_iv
+#define AES_ctx_set_iv              Ref_AES_ctx_set_iv
+#define AES_ECB_encrypt             Ref_AES_ECB_encrypt
+#define AES_ECB_decrypt             Ref_AES_ECB_decrypt
+#define AES_CBC_encrypt_buffer      Ref_AES_CBC_encrypt_buffer
+#define AES_CBC_decrypt_buffer      Ref_AES_CBC_decrypt_buffer
+#define AES_CTR_xcrypt_buffer       Ref_AES_CTR_xcrypt_buffer
+
+#include "aes.c"
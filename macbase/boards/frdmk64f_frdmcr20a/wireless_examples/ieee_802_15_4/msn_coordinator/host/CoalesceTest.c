@@ -0,0 +1,299 @@
+/************************************************************************************
+* This module contains a host test of the coalescing of small writes.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator. A timer offers a
+* short telemetry message every millisecond, more than the radio can carry one
+* frame each. The test runs the same load twice:
+*   - with mac_transmit(), one frame per message;
+*   - with mac_transmit_coalesced(), several messages per frame.
+* The coordinator unpacks the frames it receives and checks every message. Then
+* it sends packed frames to the wrapper, the last one with a broken length, and
+* the test checks that the event handler gets one indication per message.
+* It prints the messages delivered per second and per frame of each run.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/coalesce_test
+*
+************************************************************************************/
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "FunctionLib.h"
+#include "TimersManager.h"
+#include "ieee802p15p4_wrapper.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+#if !mwCoalescing_d || !mwStatistics_d
+#error "Build the coalescing test with -DmwCoalescing_d=1 -DmwStatistics_d=1"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Load: one message every mTestInterval_c ms during mTestDuration_c ms */
+#define mTestDuration_c         (5000)
+#define mTestInterval_c         (1)
+#define mTestMsgLength_c        (16)
+
+/* Dispatch bytes of the wrapper frames */
+#define mTestDispatchData_c     (0x00)
+#define mTestDispatchPacked_c   (0xF3)
+
+/* Messages in the packed frames sent to the wrapper */
+#define mTestRxMsgs_c           (3)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint8_t  mCoordNode;
+static bool_t   mCoalesce;
+
+/* Wrapper side */
+static uint32_t mOffered;
+static uint32_t mRefused;
+
+/* Coordinator side */
+static uint32_t mRxMsgs;
+static uint32_t mRxFrames;
+static uint32_t mNextSeq;
+static uint32_t mOutOfOrder;
+static uint32_t mErrors;
+
+/* Indications received by the wrapper */
+static uint32_t mIndications;
+static uint32_t mIndErrors;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The CheckMessage() function checks one message received by the
+ * coordinator: a sequence number, then the same byte repeated.
+ ******************************************************************************/
+static void CheckMessage( const uint8_t *pMsg, uint8_t length )
+{
+    uint32_t seq;
+    uint8_t i;
+
+    if( length != mTestMsgLength_c )
+    {
+        mErrors++;
+        return;
+    }
+
+    FLib_MemCpy( &seq, (void*)pMsg, sizeof(seq) );
+    for( i = sizeof(seq); i < length; i++ )
+    {
+        if( pMsg[i] != (uint8_t)seq )
+        {
+            mErrors++;
+            return;
+        }
+    }
+
+    /* Messages may be lost, never reordered */
+    if( seq < mNextSeq )
+    {
+        mOutOfOrder++;
+    }
+    mNextSeq = seq + 1;
+    mRxMsgs++;
+}
+
+/******************************************************************************
+ * The DataHook() function unpacks the frames received by the coordinator.
+ ******************************************************************************/
+static void DataHook( uint8_t node, mcpsDataInd_t *pInd )
+{
+    uint8_t *pEntry = pInd->pMsdu + 1;
+    uint8_t *pEnd = pInd->pMsdu + pInd->msduLength;
+
+    if( (node != mCoordNode) || (0 == pInd->msduLength) )
+    {
+        return;
+    }
+
+    mRxFrames++;
+    if( mTestDispatchData_c == pInd->pMsdu[0] )
+    {
+        CheckMessage( pEntry, (uint8_t)(pEnd - pEntry) );
+        return;
+    }
+
+    if( mTestDispatchPacked_c != pInd->pMsdu[0] )
+    {
+        mErrors++;
+        return;
+    }
+
+    while( pEntry < pEnd )
+    {
+        if( (0 == pEntry[0]) || (pEntry[0] >= pEnd - pEntry) )
+        {
+            mErrors++;
+            return;
+        }
+        CheckMessage( &pEntry[1], pEntry[0] );
+        pEntry += 1 + pEntry[0];
+    }
+}
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the test.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+    mcpsDataInd_t *pInd;
+
+    if( mac_management_event_c == pEvent->mac_event_type )
+    {
+        return;
+    }
+
+    if( (mac_data_event_c != pEvent->mac_event_type) ||
+        (gMcpsDataInd_c != pEvent->evt_data.data_event_data->msgType) )
+    {
+        return;
+    }
+
+    /* Message i is i + 1 bytes of value i */
+    pInd = &pEvent->evt_data.data_event_data->msgData.dataInd;
+    if( (mIndications >= mTestRxMsgs_c) || (pInd->msduLength != mIndications + 1) ||
+        (pInd->pMsdu[0] != mIndications) || pEvent->can_retain )
+    {
+        mIndErrors++;
+    }
+    mIndications++;
+}
+
+/******************************************************************************
+ * The LoadCallback() function is the load timer callback.
+ ******************************************************************************/
+static void LoadCallback( void *param )
+{
+    uint8_t msg[mTestMsgLength_c];
+    int rc;
+
+    (void)param;
+
+    FLib_MemCpy( msg, &mOffered, sizeof(mOffered) );
+    FLib_MemSet( &msg[sizeof(mOffered)], (uint8_t)mOffered, sizeof(msg) - sizeof(mOffered) );
+    mOffered++;
+
+    if( mCoalesce )
+    {
+        rc = mac_transmit_coalesced( 0x0000, msg, sizeof(msg) );
+    }
+    else
+    {
+        rc = mac_transmit( 0x0000, msg, sizeof(msg) );
+    }
+
+    if( mwErrorNoError != rc )
+    {
+        mRefused++;
+    }
+}
+
+/******************************************************************************
+ * The RunLoad() function offers the load for mTestDuration_c ms and prints
+ * the results. It returns the messages delivered.
+ ******************************************************************************/
+static uint32_t RunLoad( const char *pName, bool_t coalesce, tmrTimerID_t timer )
+{
+    mac_wrapper_stats_t stats;
+
+    mCoalesce = coalesce;
+    mOffered = 0;
+    mRefused = 0;
+    mRxMsgs = 0;
+    mRxFrames = 0;
+    mNextSeq = 0;
+    (void)mac_get_stats( &stats, TRUE );
+
+    (void)TMR_StartIntervalTimer( timer, mTestInterval_c, LoadCallback, NULL );
+    NetSim_Run( mTestDuration_c );
+    (void)TMR_StopTimer( timer );
+
+    /* Let the queue drain */
+    NetSim_Run( 1000 );
+    (void)mac_get_stats( &stats, FALSE );
+
+    printf( "%-10s %7u  %7u  %9u  %7u  %8.0f  %8.2f\n", pName, mOffered, mRefused, mRxMsgs,
+            mRxFrames, mRxMsgs * 1000.0 / mTestDuration_c, mRxFrames ? (double)mRxMsgs / mRxFrames : 0.0 );
+    if( coalesce )
+    {
+        printf( "           wrapper: %u messages packed, %u frames confirmed\n",
+                stats.packed_msgs, stats.packed_frames );
+    }
+    return mRxMsgs;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    uint8_t frame[1 + mTestRxMsgs_c * (1 + mTestRxMsgs_c) + 2];
+    tmrTimerID_t timer;
+    uint32_t plain;
+    uint32_t packed;
+    uint8_t length;
+    uint8_t i;
+    bool_t pass;
+
+    mCoordNode = WrapperHost_Connect( mTestPanId_c, mTestChannel_c, EventHandler );
+    if( gNetSimInvalidNode_c == mCoordNode )
+    {
+        return 1;
+    }
+    NetSim_SetDataHook( DataHook );
+
+    printf( "%u byte messages every %u ms for %u ms, packed up to %u bytes or %u ms\n\n",
+            mTestMsgLength_c, mTestInterval_c, mTestDuration_c, mwCoalesceMtu_c, mwCoalesceFlushTime_c );
+    printf( "mode       offered  refused  delivered   frames     msg/s  msg/frame\n" );
+
+    timer = TMR_AllocateTimer();
+    plain = RunLoad( "plain", FALSE, timer );
+    packed = RunLoad( "coalesced", TRUE, timer );
+
+    /* Packed frames to the wrapper: message i is i + 1 bytes of value i, then
+     * an entry longer than what is left of the frame */
+    frame[0] = mTestDispatchPacked_c;
+    length = 1;
+    for( i = 0; i < mTestRxMsgs_c; i++ )
+    {
+        frame[length++] = i + 1;
+        FLib_MemSet( &frame[length], i, i + 1 );
+        length += i + 1;
+    }
+    frame[length++] = 5;
+    frame[length++] = 0xEE;
+    (void)NetSim_SendData( mCoordNode, WrapperHost_GetShortAddress(), frame, length );
+    NetSim_Run( 100 );
+
+    printf( "\ncoordinator: %u payload errors, %u out of order\n", mErrors, mOutOfOrder );
+    printf( "wrapper: %u indications from one packed frame, %u errors\n", mIndications, mIndErrors );
+
+    pass = (0 == mErrors) && (0 == mOutOfOrder) && (packed > 2 * plain) &&
+           (mTestRxMsgs_c == mIndications) && (0 == mIndErrors);
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
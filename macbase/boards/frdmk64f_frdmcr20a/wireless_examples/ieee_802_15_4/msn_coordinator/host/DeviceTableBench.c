@@ -0,0 +1,123 @@
+/************************************************************************************
+* This module contains a host benchmark of the coordinator device table.
+*
+* It fills the table step by step up to mwMaxDevices_c devices and, at every step,
+* measures the average time of the lookups by extended and by short address, of a
+* miss, and of an add/remove pair. The times should stay flat as the table grows.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/devtable_bench
+*
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "EmbeddedTypes.h"
+#include "DeviceTable.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mBenchLoops_c           (1000000)
+
+/* Extended addresses as a vendor hands them out: one OUI, consecutive serials */
+#define mBenchOui_c             (0x0004250000000000ULL)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint64_t mAddresses[mwMaxDevices_c + 1];
+static volatile uint32_t mSink;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The Now() function returns a monotonic time in ns.
+ ******************************************************************************/
+static uint64_t Now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    uint32_t count = 0;
+    uint32_t step = 16;
+    uint32_t i;
+    uint64_t t0;
+    double ext, shrt, miss, addRemove;
+
+    for( i = 0; i <= mwMaxDevices_c; i++ )
+    {
+        mAddresses[i] = mBenchOui_c | (0x100000 + i);
+    }
+
+    DeviceTable_Init();
+
+    printf( "devices  ext_lookup[ns]  short_lookup[ns]  miss[ns]  add+remove[ns]\n" );
+
+    while( count < mwMaxDevices_c )
+    {
+        /* Grow the table to the next size; the last entry stays free */
+        for( ; (count < step) && (count < mwMaxDevices_c - 1); count++ )
+        {
+            DeviceTable_Add( mAddresses[count] )->state = mDeviceAssociated_c;
+        }
+
+        t0 = Now();
+        for( i = 0; i < mBenchLoops_c; i++ )
+        {
+            mSink += DeviceTable_FindByExtAddr( mAddresses[i % count] )->shortAddress;
+        }
+        ext = (double)(Now() - t0) / mBenchLoops_c;
+
+        t0 = Now();
+        for( i = 0; i < mBenchLoops_c; i++ )
+        {
+            mSink += DeviceTable_FindByShortAddr( (uint16_t)(mDeviceTableFirstShortAddr_c + i % count) )->linkQuality;
+        }
+        shrt = (double)(Now() - t0) / mBenchLoops_c;
+
+        t0 = Now();
+        for( i = 0; i < mBenchLoops_c; i++ )
+        {
+            mSink += (DeviceTable_FindByExtAddr( mBenchOui_c | (0x200000 + i) ) == NULL);
+        }
+        miss = (double)(Now() - t0) / mBenchLoops_c;
+
+        /* Association and loss of a device while the others stay */
+        t0 = Now();
+        for( i = 0; i < mBenchLoops_c; i++ )
+        {
+            DeviceTable_Remove( DeviceTable_Add( mAddresses[mwMaxDevices_c] ) );
+        }
+        addRemove = (double)(Now() - t0) / mBenchLoops_c;
+
+        printf( "%7u %15.1f %17.1f %9.1f %15.1f\n", count, ext, shrt, miss, addRemove );
+
+        if( count == mwMaxDevices_c - 1 )
+        {
+            break;
+        }
+        step *= 2;
+    }
+
+    return (mSink == 0xFFFFFFFF);
+}
@@ -0,0 +1,381 @@
+/************************************************************************************
+* This module contains a host test of the dual-PAN operation of the wrapper.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, with two instances sharing one transceiver (see MacHost.c). Each
+* one starts a PAN, and simulated end devices join both of them and keep
+* sending reports to their coordinator. The PANs are on different channels, so
+* the receiver listens to one of them at a time: the test runs the same
+* traffic for a range of dwell times set with mac_set_dual_pan_dwell(), and
+* prints for each one the share of the reports delivered, the MAC attempts per
+* report and the frames missed because the receiver was on the other PAN.
+* It checks that every report reaches the instance of its PAN, and that the
+* best dwell time delivers most of them: the MAC retries a frame within a few
+* ms, so with a long dwell time all the attempts miss the receiver.
+* Each instance shall only know the neighbors of its own PAN (mac_get_links_on()),
+* and a transmit buffer shall only be committed on the instance it came from.
+* With the channel of the second PAN as argument, both PANs share the channel:
+* the dwell time then does not matter, and only collisions lose reports.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/dual_pan_test
+*
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "TimersManager.h"
+#include "ieee802p15p4_wrapper.h"
+#include "MacHost.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+#include "FlashHost.h"
+
+#if mwMaxInstances_c != 2
+#error "Build the dual-PAN test with -DmwMaxInstances_c=2 -DgMacInstancesCnt_c=2 -DgMpmMaxPANs_c=2"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPans_c             (2)
+#define mTestPanIdA_c           (0x1234)
+#define mTestPanIdB_c           (0x5678)
+#define mTestChannelA_c         (15)
+#define mTestChannelB_c         (20)
+
+/* Time [ms] after which the start or an association is reported as failed */
+#define mTestTimeout_c          (60000)
+#define mTestStep_c             (10)
+
+/* End devices of each PAN, and their reports */
+#define mTestDevicesPerPan_c    (4)
+#define mTestReportInterval_c   (50)
+#define mTestPayload_c          (40)
+
+/* Time [ms] the traffic runs for each dwell time */
+#define mTestDuration_c         (10000)
+
+/* Share of the reports the best dwell time shall deliver with the PANs on
+ * different channels, and every dwell time on the same channel */
+#define mTestMinDelivery_c      (0.90)
+#define mTestMinSameChannel_c   (0.98)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static const uint16_t mPanIds[mTestPans_c] = { mTestPanIdA_c, mTestPanIdB_c };
+/* Dwell times [ms] measured */
+static const uint16_t mDwellTimes[] = { 1, 2, 4, 8, 16, 32, 64, 128 };
+
+static bool_t   mStarted[mTestPans_c];
+static uint32_t mReceived[mTestPans_c];
+static uint32_t mWrongPan;
+static uint8_t  mDevices[mTestPans_c][mTestDevicesPerPan_c];
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of both
+ * instances.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+    mcpsToNwkMessage_t *pMsg;
+
+    if( pEvent->instance >= mTestPans_c )
+    {
+        mWrongPan++;
+        return;
+    }
+
+    if( mac_management_event_c == pEvent->mac_event_type )
+    {
+        if( gMlmeStartCnf_c == pEvent->evt_data.management_event_data->msgType )
+        {
+            mStarted[pEvent->instance] = TRUE;
+        }
+        return;
+    }
+
+    pMsg = pEvent->evt_data.data_event_data;
+    if( gMcpsDataInd_c == pMsg->msgType )
+    {
+        if( pMsg->msgData.dataInd.srcPanId != mPanIds[pEvent->instance] )
+        {
+            mWrongPan++;
+        }
+        mReceived[pEvent->instance]++;
+    }
+}
+
+/******************************************************************************
+ * The AllAssociated() function returns TRUE once every end device joined its
+ * PAN.
+ ******************************************************************************/
+static bool_t AllAssociated( void )
+{
+    netSimNodeStats_t stats;
+    uint32_t pan;
+    uint32_t i;
+
+    for( pan = 0; pan < mTestPans_c; pan++ )
+    {
+        for( i = 0; i < mTestDevicesPerPan_c; i++ )
+        {
+            NetSim_GetNodeStats( mDevices[pan][i], &stats );
+            if( 0xFFFFFFFF == stats.associated )
+            {
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
+/******************************************************************************
+ * The SumDevices() function adds up the counters of the end devices of a PAN.
+ ******************************************************************************/
+static void SumDevices( uint32_t pan, uint32_t *pRequests, uint32_t *pSuccess, uint32_t *pAttempts )
+{
+    netSimNodeStats_t stats;
+    uint32_t i;
+
+    *pRequests = 0;
+    *pSuccess = 0;
+    *pAttempts = 0;
+    for( i = 0; i < mTestDevicesPerPan_c; i++ )
+    {
+        NetSim_GetNodeStats( mDevices[pan][i], &stats );
+        *pRequests += stats.txRequests;
+        *pSuccess += stats.txSuccess;
+        *pAttempts += stats.radio.txFrames;
+    }
+}
+
+/******************************************************************************
+ * The CheckInstances() function checks that each instance knows the end
+ * devices of its PAN, and only them, and that a transmit buffer belongs to the
+ * instance that gave it. It prints the neighbors of each instance.
+ ******************************************************************************/
+static bool_t CheckInstances( void )
+{
+    mac_link_info_t links[mTestPans_c][mTestDevicesPerPan_c + 1];
+    mac_link_info_t info;
+    uint16_t count[mTestPans_c];
+    uint8_t *pBuffer;
+    bool_t ok = TRUE;
+    uint32_t pan;
+    uint32_t i;
+
+    for( pan = 0; pan < mTestPans_c; pan++ )
+    {
+        count[pan] = mac_get_links_on( (uint8_t)pan, links[pan], mTestDevicesPerPan_c + 1 );
+        ok = ok && (mTestDevicesPerPan_c == count[pan]);
+
+        printf( "PAN 0x%04X neighbors:", mPanIds[pan] );
+        for( i = 0; i < count[pan]; i++ )
+        {
+            printf( " 0x%04X", links[pan][i].short_address );
+            /* Not a neighbor of the other instance */
+            ok = ok && (mwErrorInvalidParameter ==
+                        mac_get_link_on( (uint8_t)(mTestPans_c - 1 - pan), links[pan][i].short_address, &info ));
+        }
+        printf( "\n" );
+    }
+
+    /* A buffer of the second instance, committed on the first one and then on its own */
+    pBuffer = mac_tx_buffer_get_on( 1, links[1][0].short_address, mTestPayload_c );
+    ok = ok && (NULL != pBuffer);
+    if( NULL != pBuffer )
+    {
+        ok = ok && (mwErrorInvalidParameter == mac_tx_buffer_commit_on( 0, pBuffer, mTestPayload_c ));
+        ok = ok && (mwErrorNoError == mac_tx_buffer_commit_on( 1, pBuffer, mTestPayload_c ));
+    }
+
+    return ok;
+}
+
+/******************************************************************************
+ * The MeasureDwell() function runs the traffic for mTestDuration_c ms with
+ * the given dwell time, 0 for the MPM default, and prints one line of
+ * results. It returns the share of the reports delivered.
+ ******************************************************************************/
+static double MeasureDwell( uint16_t dwell )
+{
+    macHostNodeStats_t radio[mTestPans_c];
+    uint32_t requests[mTestPans_c], success[mTestPans_c], attempts[mTestPans_c];
+    uint32_t r, s, a;
+    uint32_t received = 0;
+    uint32_t missed = 0;
+    uint32_t totalRequests = 0;
+    uint32_t totalSuccess = 0;
+    uint32_t totalAttempts = 0;
+    uint32_t pan;
+
+    if( dwell )
+    {
+        (void)mac_set_dual_pan_dwell( dwell );
+    }
+
+    for( pan = 0; pan < mTestPans_c; pan++ )
+    {
+        SumDevices( pan, &requests[pan], &success[pan], &attempts[pan] );
+        MacHost_GetNodeStats( (instanceId_t)pan, &radio[pan], TRUE );
+        mReceived[pan] = 0;
+    }
+
+    NetSim_Run( mTestDuration_c );
+
+    for( pan = 0; pan < mTestPans_c; pan++ )
+    {
+        SumDevices( pan, &r, &s, &a );
+        MacHost_GetNodeStats( (instanceId_t)pan, &radio[pan], FALSE );
+        totalRequests += r - requests[pan];
+        totalSuccess += s - success[pan];
+        totalAttempts += a - attempts[pan];
+        received += mReceived[pan];
+        missed += radio[pan].rxOtherPan;
+    }
+
+    if( dwell )
+    {
+        printf( "%8u", dwell );
+    }
+    else
+    {
+        printf( " default" );
+    }
+    printf( "  %8u  %8u  %8u  %7.1f%%  %8.2f  %7.1f%%  %7.0f\n", totalRequests, totalSuccess, received,
+            totalRequests ? 100.0 * totalSuccess / totalRequests : 0.0,
+            totalSuccess ? (double)totalAttempts / totalSuccess : 0.0,
+            totalAttempts ? 100.0 * missed / totalAttempts : 0.0,
+            8.0 * mTestPayload_c * received / (mTestDuration_c / 1000.0) );
+
+    return totalRequests ? (double)totalSuccess / totalRequests : 0.0;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( int argc, char *argv[] )
+{
+    uint8_t extAddress[8] = { 0x10, 0x00, 0x00, 0x00, 0x00, 0x25, 0x04, 0x00 };
+    uint8_t channels[mTestPans_c] = { mTestChannelA_c, mTestChannelB_c };
+    netSimNodeCfg_t cfg = { 0 };
+    double delivery;
+    double best = 0.0;
+    double worst;
+    uint16_t bestDwell = 0;
+    uint32_t pan;
+    uint32_t i;
+    bool_t instancesOk;
+    bool_t pass;
+
+    if( argc > 1 )
+    {
+        channels[1] = (uint8_t)atoi( argv[1] );
+    }
+
+    FlashHost_Init();
+    NetSim_Init( 1, NULL );
+    NetSim_SetIdleHook( WrapperHost_RunTasks );
+
+    /* The two wrapper instances are the first MAC instances, the end devices follow */
+    (void)mac_init( extAddress );
+    for( pan = 0; pan < mTestPans_c; pan++ )
+    {
+        (void)mac_connect_on( (uint8_t)pan, channels[pan], mPanIds[pan], EventHandler );
+    }
+    while( !(mStarted[0] && mStarted[1]) && (OSA_TimeGetMsec() < mTestTimeout_c) )
+    {
+        NetSim_Run( mTestStep_c );
+    }
+    if( !(mStarted[0] && mStarted[1]) )
+    {
+        printf( "start FAILED\n" );
+        return 1;
+    }
+
+    cfg.role = gNetSimEndDevice_c;
+    cfg.reportInterval = mTestReportInterval_c;
+    cfg.payloadLength = mTestPayload_c;
+    for( pan = 0; pan < mTestPans_c; pan++ )
+    {
+        cfg.panId = mPanIds[pan];
+        cfg.channel = channels[pan];
+        for( i = 0; i < mTestDevicesPerPan_c; i++ )
+        {
+            cfg.x = 3.0f + i;
+            cfg.y = pan ? 2.0f : -2.0f;
+            cfg.startDelay = OSA_TimeGetMsec() + 100 * (i * mTestPans_c + pan);
+            mDevices[pan][i] = NetSim_AddNode( &cfg );
+        }
+    }
+    while( !AllAssociated() && (OSA_TimeGetMsec() < mTestTimeout_c) )
+    {
+        NetSim_Run( mTestStep_c );
+    }
+    if( !AllAssociated() )
+    {
+        printf( "association FAILED\n" );
+        return 1;
+    }
+
+    printf( "PAN 0x%04X on channel %u, PAN 0x%04X on channel %u, %u devices each, a %u byte report every %u ms\n",
+            mPanIds[0], channels[0], mPanIds[1], channels[1], mTestDevicesPerPan_c, mTestPayload_c,
+            mTestReportInterval_c );
+    printf( "dwell[ms]  reports  acked     received  delivered  attempts  other PAN  bit/s\n" );
+
+    best = MeasureDwell( 0 );
+    worst = best;
+    for( i = 0; i < sizeof(mDwellTimes) / sizeof(mDwellTimes[0]); i++ )
+    {
+        delivery = MeasureDwell( mDwellTimes[i] );
+        if( delivery > best )
+        {
+            best = delivery;
+            bestDwell = mDwellTimes[i];
+        }
+        if( delivery < worst )
+        {
+            worst = delivery;
+        }
+    }
+
+    printf( "best dwell time: " );
+    if( bestDwell )
+    {
+        printf( "%u ms", bestDwell );
+    }
+    else
+    {
+        printf( "default" );
+    }
+    printf( ", %.1f%% delivered; %u indications on the wrong instance\n\n", 100.0 * best, mWrongPan );
+
+    instancesOk = CheckInstances();
+    NetSim_Run( mTestStep_c );
+
+    pass = (best >= mTestMinDelivery_c) && (0 == mWrongPan) && instancesOk;
+    if( channels[0] == channels[1] )
+    {
+        pass = pass && (worst >= mTestMinSameChannel_c);
+    }
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
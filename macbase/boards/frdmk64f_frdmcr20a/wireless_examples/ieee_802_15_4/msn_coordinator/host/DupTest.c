@@ -0,0 +1,238 @@
+/************************************************************************************
+* This module contains a host test of the receive duplicate filter.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator placed where about half
+* of the frames are lost. The radio model loses the acknowledgements too, so the
+* coordinator MAC sends again frames the wrapper already received. The
+* coordinator sends numbered frames, and the test checks that the event handler
+* gets each number at most once while the wrapper reports dropped copies.
+* Then it measures the cost of DupFilter_IsDuplicate() for a growing number of
+* sources, each frame followed by its copy after the frame of another source.
+* The time should stay flat, and every copy be caught.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/dup_test
+*
+************************************************************************************/
+#include <stdio.h>
+#include <time.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "FunctionLib.h"
+#include "TimersManager.h"
+#include "ieee802p15p4_wrapper.h"
+#include "DupFilter.h"
+#include "MacHost.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+#if !mwDupFilter_d || !mwStatistics_d
+#error "Build the duplicate test with mwDupFilter_d enabled and -DmwStatistics_d=1"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Numbered frames sent by the coordinator, one every mTestInterval_c ms */
+#define mTestFrames_c           (1000)
+#define mTestInterval_c         (20)
+#define mTestPayload_c          (60)
+
+/* MAC instances: the wrapper is bound first */
+#define mTestWrapperInstance_c  (0)
+#define mTestCoordInstance_c    (1)
+
+/* Packet error rate of a single attempt sought for the coordinator position */
+#define mTestPer_c              (0.5f)
+
+/* Cost measurement */
+#define mTestMaxSources_c       (2048)
+#define mTestRounds_c           (200)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint8_t  mCoordNode;
+static uint32_t mSent;
+static uint32_t mDelivered;
+static uint32_t mDeliveredTwice;
+static uint8_t  mSeen[mTestFrames_c];
+static uint8_t  mDsn[mTestMaxSources_c];
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The Now() function returns a monotonic time in ns.
+ ******************************************************************************/
+static uint64_t Now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the test.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+    mcpsDataInd_t *pInd;
+    uint32_t seq;
+
+    if( mac_management_event_c == pEvent->mac_event_type )
+    {
+        return;
+    }
+
+    if( gMcpsDataInd_c != pEvent->evt_data.data_event_data->msgType )
+    {
+        return;
+    }
+
+    pInd = &pEvent->evt_data.data_event_data->msgData.dataInd;
+    FLib_MemCpy( &seq, pInd->pMsdu, sizeof(seq) );
+    if( seq < mTestFrames_c )
+    {
+        if( mSeen[seq] )
+        {
+            mDeliveredTwice++;
+        }
+        mSeen[seq] = 1;
+        mDelivered++;
+    }
+}
+
+/******************************************************************************
+ * The SendCallback() function is the timer callback of the coordinator
+ * frames.
+ ******************************************************************************/
+static void SendCallback( void *param )
+{
+    uint8_t payload[mTestPayload_c] = { 0 };
+
+    (void)param;
+
+    if( mSent < mTestFrames_c )
+    {
+        FLib_MemCpy( payload, &mSent, sizeof(mSent) );
+        if( NetSim_SendData( mCoordNode, WrapperHost_GetShortAddress(), payload, sizeof(payload) ) )
+        {
+            mSent++;
+        }
+    }
+}
+
+/******************************************************************************
+ * The MeasureCost() function measures the duplicate filter alone with the
+ * given number of sources. It returns the copies missed.
+ ******************************************************************************/
+static uint32_t MeasureCost( uint32_t sources )
+{
+    uint32_t missed = 0;
+    uint32_t frames = 0;
+    uint32_t now = 0;
+    uint32_t round;
+    uint32_t i;
+    uint64_t t0;
+    uint64_t src;
+    uint64_t prev;
+
+    DupFilter_Init();
+    FLib_MemSet( mDsn, 0, sizeof(mDsn) );
+
+    t0 = Now();
+    for( round = 0; round < mTestRounds_c; round++ )
+    {
+        for( i = 0; i < sources; i++ )
+        {
+            /* A new frame of source i, then the copy of the frame of source i - 1 */
+            src = 0x0001 + i;
+            prev = 0x0001 + (i + sources - 1) % sources;
+            mDsn[i]++;
+            missed += DupFilter_IsDuplicate( src, gAddrModeShortAddress_c, mDsn[i], now++ ) ? 1 : 0;
+            if( (round > 0) || (i > 0) )
+            {
+                missed += DupFilter_IsDuplicate( prev, gAddrModeShortAddress_c, mDsn[prev - 1], now++ ) ? 0 : 1;
+            }
+            frames += 2;
+        }
+    }
+
+    printf( "%7u  %9.1f  %6u\n", sources, (double)(Now() - t0) / frames, missed );
+    return missed;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    macHostNodeStats_t radio;
+    mac_wrapper_stats_t stats;
+    tmrTimerID_t timer;
+    uint32_t missed = 0;
+    uint32_t sources;
+    float x;
+    bool_t pass;
+
+    mCoordNode = WrapperHost_Connect( mTestPanId_c, mTestChannel_c, EventHandler );
+    if( gNetSimInvalidNode_c == mCoordNode )
+    {
+        return 1;
+    }
+
+    /* Move the coordinator where the frames and acknowledgements get lost */
+    for( x = 5.0f; x < 1000.0f; x += 1.0f )
+    {
+        MacHost_SetPosition( mTestCoordInstance_c, x, 0.0f );
+        if( MacHost_GetLinkPer( mTestCoordInstance_c, mTestWrapperInstance_c, mTestPayload_c + 11 ) >= mTestPer_c )
+        {
+            break;
+        }
+    }
+
+    (void)mac_get_stats( &stats, TRUE );
+    MacHost_GetNodeStats( mTestWrapperInstance_c, &radio, TRUE );
+
+    timer = TMR_AllocateTimer();
+    (void)TMR_StartIntervalTimer( timer, mTestInterval_c, SendCallback, NULL );
+    NetSim_Run( mTestFrames_c * mTestInterval_c + 1000 );
+    (void)TMR_StopTimer( timer );
+
+    (void)mac_get_stats( &stats, FALSE );
+    MacHost_GetNodeStats( mTestWrapperInstance_c, &radio, FALSE );
+
+    printf( "coordinator %.0f m away, PER %.2f per attempt\n", x,
+            MacHost_GetLinkPer( mTestCoordInstance_c, mTestWrapperInstance_c, mTestPayload_c + 11 ) );
+    printf( "frames sent %u, received by the MAC %u, copies dropped %u, delivered %u, delivered twice %u\n\n",
+            mSent, radio.rxFrames, stats.rx_duplicates, mDelivered, mDeliveredTwice );
+
+    printf( "sources  ns/frame  missed   (%u entries, %u way)\n", mwDupFilterSize_c, mDupFilterWays_c );
+    for( sources = 16; sources <= mTestMaxSources_c; sources *= 4 )
+    {
+        missed += MeasureCost( sources );
+    }
+
+    pass = (mSent == mTestFrames_c) && (0 == mDeliveredTwice) && (stats.rx_duplicates > 0) &&
+           (mDelivered + stats.rx_duplicates == radio.rxFrames) && (0 == missed);
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
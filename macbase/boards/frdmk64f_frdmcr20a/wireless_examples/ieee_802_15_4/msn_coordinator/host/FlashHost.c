@@ -0,0 +1,207 @@
+/************************************************************************************
+* This module contains a host stand-in of the flash adapter for NwkParams.c.
+*
+* The sectors the linker reserves on the target (NWK_PARAMS_BASE_ADDR) are a plain
+* array here. NV_FlashProgram() behaves as NOR flash, it can only clear bits and
+* takes whole program units, and NV_FlashEraseSector() sets a sector to 0xFF.
+* The flash addresses are 32 bit, as on the target: the host ones are truncated
+* and only their offset from the array is used. The image can be saved and
+* restored to carry it over a simulated reset, and FlashHost_CutPower() stops
+* the flash between two operations, as a reset would.
+*
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "Flash_Adapter.h"
+#include "FunctionLib.h"
+
+#include "FlashHost.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mFlashHostStatusError_c     (1)
+
+/************************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+************************************************************************************/
+/* The reserved sectors, normally placed by the linker */
+uint32_t NWK_PARAMS_BASE_ADDR[gFlashHostImageSize_c / sizeof(uint32_t)];
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint32_t mEraseCount;
+static uint32_t mProgramCount;
+/* Programs and erases done before the power is cut */
+static uint32_t mPowerLeft = gFlashHostNoPowerCut_c;
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static uint8_t* Address( uint32_t dest, uint32_t size );
+static bool_t PowerOn( void );
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/*! *********************************************************************************
+* \brief  Erases the sectors, clears the counters and keeps the power on.
+********************************************************************************** */
+void FlashHost_Init( void )
+{
+    FLib_MemSet( NWK_PARAMS_BASE_ADDR, 0xFF, sizeof(NWK_PARAMS_BASE_ADDR) );
+    mEraseCount = 0;
+    mProgramCount = 0;
+    mPowerLeft = gFlashHostNoPowerCut_c;
+}
+
+/*! *********************************************************************************
+* \brief  Copies the sectors to pImage (gFlashHostImageSize_c bytes).
+********************************************************************************** */
+void FlashHost_Save( uint8_t *pImage )
+{
+    FLib_MemCpy( pImage, NWK_PARAMS_BASE_ADDR, sizeof(NWK_PARAMS_BASE_ADDR) );
+}
+
+/*! *********************************************************************************
+* \brief  Restores the sectors from pImage (gFlashHostImageSize_c bytes).
+********************************************************************************** */
+void FlashHost_Restore( const uint8_t *pImage )
+{
+    FLib_MemCpy( NWK_PARAMS_BASE_ADDR, (void*)pImage, sizeof(NWK_PARAMS_BASE_ADDR) );
+}
+
+uint32_t FlashHost_GetEraseCount( void )
+{
+    return mEraseCount;
+}
+
+uint32_t FlashHost_GetProgramCount( void )
+{
+    return mProgramCount;
+}
+
+/*! *********************************************************************************
+* \brief  Cuts the power after the given number of programs and erases: the
+*         operations after them fail and leave the flash unchanged.
+*         gFlashHostNoPowerCut_c restores it.
+********************************************************************************** */
+void FlashHost_CutPower( uint32_t operations )
+{
+    mPowerLeft = operations;
+}
+
+void NV_Init( void )
+{
+}
+
+/*! *********************************************************************************
+* \brief  Programs whole program units, clearing bits only.
+********************************************************************************** */
+uint32_t NV_FlashProgram( uint32_t dest, uint32_t size, uint8_t* pData )
+{
+    uint8_t *pFlash = Address( dest, size );
+
+    if( (NULL == pFlash) || (dest % PGM_SIZE_BYTE) || (size % PGM_SIZE_BYTE) || !PowerOn() )
+    {
+        return mFlashHostStatusError_c;
+    }
+
+    while( size-- )
+    {
+        *pFlash++ &= *pData++;
+    }
+
+    mProgramCount++;
+    return 0;
+}
+
+/*! *********************************************************************************
+* \brief  Programs any range, the bytes around it in the same units are kept.
+********************************************************************************** */
+uint32_t NV_FlashProgramUnaligned( uint32_t dest, uint32_t size, uint8_t* pData )
+{
+    uint8_t *pFlash = Address( dest, size );
+
+    if( (NULL == pFlash) || !PowerOn() )
+    {
+        return mFlashHostStatusError_c;
+    }
+
+    while( size-- )
+    {
+        *pFlash++ &= *pData++;
+    }
+
+    mProgramCount++;
+    return 0;
+}
+
+/*! *********************************************************************************
+* \brief  Erases one whole sector.
+********************************************************************************** */
+uint32_t NV_FlashEraseSector( uint32_t dest, uint32_t size )
+{
+    uint8_t *pFlash = Address( dest, size );
+
+    if( (NULL == pFlash) || ((pFlash - (uint8_t*)NWK_PARAMS_BASE_ADDR) % gFlashHostSectorSize_c) ||
+        (size != gFlashHostSectorSize_c) || !PowerOn() )
+    {
+        return mFlashHostStatusError_c;
+    }
+
+    FLib_MemSet( pFlash, 0xFF, gFlashHostSectorSize_c );
+    mEraseCount++;
+    return 0;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The Address() function returns the host address of a flash range, or NULL
+ * if it does not lie inside the sectors.
+ ******************************************************************************/
+static uint8_t* Address( uint32_t dest, uint32_t size )
+{
+    uint32_t offset = dest - (uint32_t)(uintptr_t)NWK_PARAMS_BASE_ADDR;
+
+    if( (offset >= gFlashHostImageSize_c) || (size > gFlashHostImageSize_c - offset) )
+    {
+        return NULL;
+    }
+
+    return (uint8_t*)NWK_PARAMS_BASE_ADDR + offset;
+}
+
+/******************************************************************************
+ * The PowerOn() function accounts for one program or erase and returns FALSE
+ * if the power was cut before it.
+ ******************************************************************************/
+static bool_t PowerOn( void )
+{
+    if( 0 == mPowerLeft )
+    {
+        return FALSE;
+    }
+    if( gFlashHostNoPowerCut_c != mPowerLeft )
+    {
+        mPowerLeft--;
+    }
+
+    return TRUE;
+}
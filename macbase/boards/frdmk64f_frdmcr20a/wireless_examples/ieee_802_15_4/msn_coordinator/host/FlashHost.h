@@ -0,0 +1,38 @@
+/************************************************************************************
+* This module contains the interface of the host stand-in of the flash adapter.
+*
+* FlashHost.c provides NV_Init(), NV_FlashProgram(), NV_FlashProgramUnaligned(),
+* NV_FlashEraseSector() and the NWK_PARAMS_BASE_ADDR sectors, so NwkParams.c runs
+* unchanged on a workstation.
+*
+************************************************************************************/
+#ifndef _FLASH_HOST_H
+#define _FLASH_HOST_H
+
+#include "EmbeddedTypes.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/* Sectors reserved for the network parameters, and their size */
+#define gFlashHostSectors_c             (2)
+#define gFlashHostSectorSize_c          (4096)
+#define gFlashHostImageSize_c           (gFlashHostSectors_c * gFlashHostSectorSize_c)
+
+/* FlashHost_CutPower() value that keeps the power on */
+#define gFlashHostNoPowerCut_c          (0xFFFFFFFF)
+
+/* Declarations of the host flash functions */
+void     FlashHost_Init( void );
+void     FlashHost_Save( uint8_t *pImage );
+void     FlashHost_Restore( const uint8_t *pImage );
+uint32_t FlashHost_GetEraseCount( void );
+uint32_t FlashHost_GetProgramCount( void );
+void     FlashHost_CutPower( uint32_t operations );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //_FLASH_HOST_H
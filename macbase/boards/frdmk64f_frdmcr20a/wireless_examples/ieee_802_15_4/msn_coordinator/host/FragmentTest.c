@@ -0,0 +1,477 @@
+/************************************************************************************
+* This module contains a host test of the fragmentation layer.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator. The coordinator runs a
+* second fragmentation instance on top of the NetSim data hooks, and drops a share
+* of the frames it receives or sends, so both ends have to retransmit. The test
+* sends a payload of mwFragMaxLength_c bytes:
+*   - from the wrapper with mac_transmit_large(), without and with losses;
+*   - to the wrapper, which reassembles it, with a window of 1 and of
+*     mwFragWindow_c fragments;
+*   - from the wrapper again as plain frames, one mac_transmit_async() at a
+*     time, for comparison.
+* The plain frames and the transfer from the wrapper run again with the mac
+* task woken up mTestWakeupLatency_c late, as it would behind the other tasks
+* of the target.
+* It checks that every payload arrives intact, and prints the time and the
+* throughput of each transfer. When the mac task runs at once, the fragments
+* are slower than the plain frames: the MAC never waits for either, and the
+* fragment headers and the acknowledgements take air time. When it wakes up
+* late, the fragments are faster: the MAC holds the next fragment when one is
+* confirmed (mwFragMaxQueuedTx_c), and waits for the mac task after each plain
+* frame.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/fragment_test
+*
+************************************************************************************/
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "FunctionLib.h"
+#include "TimersManager.h"
+#include "MemManager.h"
+#include "ieee802p15p4_wrapper.h"
+#include "Fragment.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+#if !mwFragmentation_d
+#error "Build the fragmentation test with -DmwFragmentation_d=1"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Time [ms] after which a transfer is reported as failed */
+#define mTestTimeout_c          (30000)
+#define mTestStep_c             (10)
+
+#define mTestLength_c           (mwFragMaxLength_c)
+/* Frames dropped by the coordinator, in percent */
+#define mTestLoss_c             (10)
+/* Largest payload of a plain frame, the dispatch byte takes one byte */
+#define mTestPlainLength_c      (116 - 1)
+
+/* Frames of the coordinator instance waiting for the MAC */
+#define mTestPeerQueue_c        (8)
+#define mTestPeerTick_c         (1)
+
+/* Time [ms] the mac task takes to run once an event is set, second runs */
+#define mTestWakeupLatency_c    (2)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct testFrame_tag
+{
+    uint16_t dest;
+    uint8_t  length;
+    uint8_t  data[mFragMaxFrameLen_c];
+} testFrame_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static void PlainDone( resultType_t status, void *context );
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint8_t  mCoordNode;
+
+static uint8_t  mPayload[mTestLength_c];
+
+/* Coordinator side */
+static fragInstance_t mPeer;
+static testFrame_t    mPeerQueue[mTestPeerQueue_c];
+static uint8_t        mPeerHead;
+static uint8_t        mPeerCount;
+static uint8_t        mLoss;            /* Percent of the frames dropped */
+static uint32_t       mDropped;
+static uint32_t       mRandom = 1;
+static uint32_t       mPeerDelivered;
+static uint32_t       mPlainBytes;
+
+/* Result of the transfer in progress */
+static bool_t         mDone;
+static resultType_t   mStatus;
+static uint32_t       mDelivered;
+static uint32_t       mErrors;
+
+static uint32_t       mElapsed;         /* Time [ms] of the last transfer */
+
+/* Plain frames */
+static uint16_t       mPlainSent;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The Lose() function tells whether the coordinator drops the next frame.
+ ******************************************************************************/
+static bool_t Lose( void )
+{
+    mRandom = mRandom * 1103515245 + 12345;
+    if( ((mRandom >> 16) % 100) < mLoss )
+    {
+        mDropped++;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/******************************************************************************
+ * The CheckPayload() function compares a received payload to the one sent.
+ ******************************************************************************/
+static void CheckPayload( const uint8_t *pData, uint16_t length )
+{
+    uint16_t i;
+
+    if( length != mTestLength_c )
+    {
+        mErrors++;
+        return;
+    }
+
+    for( i = 0; i < length; i++ )
+    {
+        if( pData[i] != mPayload[i] )
+        {
+            mErrors++;
+            return;
+        }
+    }
+}
+
+/******************************************************************************
+ * The PeerSend() function queues a frame of the coordinator instance. The
+ * frames are given to the MAC from the timer: the data hook runs inside the
+ * MAC.
+ ******************************************************************************/
+static bool_t PeerSend( fragInstance_t *pInst, uint16_t dest, uint8_t *pFrame, uint8_t length )
+{
+    testFrame_t *pEntry;
+
+    (void)pInst;
+
+    if( mPeerCount >= mTestPeerQueue_c )
+    {
+        return FALSE;
+    }
+
+    if( Lose() )
+    {
+        return TRUE;
+    }
+
+    pEntry = &mPeerQueue[(mPeerHead + mPeerCount) % mTestPeerQueue_c];
+    pEntry->dest = dest;
+    pEntry->length = length;
+    FLib_MemCpy( pEntry->data, pFrame, length );
+    mPeerCount++;
+    return TRUE;
+}
+
+/******************************************************************************
+ * The PeerDeliver() function receives the payloads of the coordinator.
+ ******************************************************************************/
+static void PeerDeliver( fragInstance_t *pInst, uint16_t src, uint8_t *pData, uint16_t length )
+{
+    (void)pInst;
+    (void)src;
+
+    CheckPayload( pData, length );
+    mPeerDelivered++;
+    (void)MEM_BufferFree( pData );
+}
+
+/******************************************************************************
+ * The PeerTimerCallback() function runs the coordinator instance.
+ ******************************************************************************/
+static void PeerTimerCallback( void *param )
+{
+    testFrame_t *pEntry;
+
+    (void)param;
+
+    (void)Frag_Process( &mPeer );
+    while( mPeerCount )
+    {
+        pEntry = &mPeerQueue[mPeerHead];
+        if( !NetSim_SendData( mCoordNode, pEntry->dest, pEntry->data, pEntry->length ) )
+        {
+            break;
+        }
+        mPeerHead = (mPeerHead + 1) % mTestPeerQueue_c;
+        mPeerCount--;
+    }
+}
+
+/******************************************************************************
+ * The DataHook() function receives the frames of the simulated nodes.
+ ******************************************************************************/
+static void DataHook( uint8_t node, mcpsDataInd_t *pInd )
+{
+    if( (node != mCoordNode) || (0 == pInd->msduLength) )
+    {
+        return;
+    }
+
+    if( mFragDispatchData_c == pInd->pMsdu[0] )
+    {
+        mPlainBytes += pInd->msduLength - 1;
+        return;
+    }
+
+    if( !Lose() )
+    {
+        Frag_Receive( &mPeer, (uint16_t)pInd->srcAddr, pInd->pMsdu, pInd->msduLength );
+    }
+}
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the test.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+
+    if( mac_large_data_event_c == pEvent->mac_event_type )
+    {
+        /* Not retained: the wrapper frees the buffer */
+        CheckPayload( pEvent->evt_data.large_data_event_data->pData,
+                      pEvent->evt_data.large_data_event_data->length );
+        mDelivered++;
+    }
+}
+
+/******************************************************************************
+ * The TxDone() function is the completion callback of mac_transmit_large().
+ ******************************************************************************/
+static void TxDone( resultType_t status, void *context )
+{
+    (void)context;
+
+    mStatus = status;
+    mDone = TRUE;
+}
+
+/******************************************************************************
+ * The PeerTxDone() function is the completion callback of the coordinator.
+ ******************************************************************************/
+static void PeerTxDone( resultType_t status, void *pContext )
+{
+    (void)pContext;
+
+    mStatus = status;
+    mDone = TRUE;
+}
+
+/******************************************************************************
+ * The SendPlain() function sends the next plain frame of the payload.
+ ******************************************************************************/
+static void SendPlain( void )
+{
+    uint16_t length = mTestLength_c - mPlainSent;
+
+    if( length > mTestPlainLength_c )
+    {
+        length = mTestPlainLength_c;
+    }
+
+    if( mwErrorNoError != mac_transmit_async( 0x0000, &mPayload[mPlainSent], (uint8_t)length, PlainDone, NULL ) )
+    {
+        mErrors++;
+        mDone = TRUE;
+        return;
+    }
+    mPlainSent += length;
+}
+
+/******************************************************************************
+ * The PlainDone() function sends the frame after the one confirmed.
+ ******************************************************************************/
+static void PlainDone( resultType_t status, void *context )
+{
+    (void)context;
+
+    if( gSuccess_c != status )
+    {
+        mErrors++;
+    }
+
+    if( mPlainSent < mTestLength_c )
+    {
+        SendPlain();
+    }
+    else
+    {
+        mStatus = status;
+        mDone = TRUE;
+    }
+}
+
+/******************************************************************************
+ * The Wait() function runs the network until the transfer is over, and
+ * prints its results. It returns TRUE if it succeeded.
+ ******************************************************************************/
+static bool_t Wait( const char *pName, uint32_t start, const uint32_t *pDelivered, uint32_t delivered )
+{
+    uint32_t elapsed;
+    bool_t ok;
+
+    while( !mDone && (OSA_TimeGetMsec() - start < mTestTimeout_c) )
+    {
+        NetSim_Run( 1 );
+    }
+    elapsed = OSA_TimeGetMsec() - start;
+    mElapsed = elapsed;
+
+    /* Let the last acknowledgement go through */
+    NetSim_Run( 100 );
+
+    ok = mDone && (gSuccess_c == mStatus) && (*pDelivered == delivered) && (0 == mErrors);
+    printf( "%-32s %6u ms  %6.1f kbit/s  %s\n", pName, elapsed,
+            elapsed ? mTestLength_c * 8.0 / elapsed : 0.0, ok ? "ok" : "FAILED" );
+    return ok;
+}
+
+/******************************************************************************
+ * The RunPlain() function sends the payload as plain frames, each one once
+ * the one before is confirmed.
+ ******************************************************************************/
+static bool_t RunPlain( const char *pName )
+{
+    mDone = FALSE;
+    mPlainSent = 0;
+    mPlainBytes = 0;
+    SendPlain();
+    return Wait( pName, OSA_TimeGetMsec(), &mPlainBytes, mTestLength_c );
+}
+
+/******************************************************************************
+ * The SendLarge() function sends the payload from the wrapper.
+ ******************************************************************************/
+static bool_t SendLarge( const char *pName, uint8_t loss )
+{
+    uint32_t expected = mPeerDelivered + 1;
+
+    mLoss = loss;
+    mDone = FALSE;
+    if( mwErrorNoError != mac_transmit_large( 0x0000, mPayload, mTestLength_c, TxDone, NULL ) )
+    {
+        return FALSE;
+    }
+    return Wait( pName, OSA_TimeGetMsec(), &mPeerDelivered, expected );
+}
+
+/******************************************************************************
+ * The ReceiveLarge() function sends the payload to the wrapper.
+ ******************************************************************************/
+static bool_t ReceiveLarge( const char *pName, uint8_t window, uint8_t loss )
+{
+    uint32_t expected = mDelivered + 1;
+
+    /* The tags start over: let the wrapper forget the previous transfer */
+    NetSim_Run( mwFragReassemblyTimeout_c + mTestStep_c );
+
+    mLoss = loss;
+    mDone = FALSE;
+    Frag_Init( &mPeer, window, PeerSend, PeerDeliver );
+    if( !Frag_Send( &mPeer, WrapperHost_GetShortAddress(), mPayload, mTestLength_c, PeerTxDone, NULL ) )
+    {
+        return FALSE;
+    }
+    return Wait( pName, OSA_TimeGetMsec(), &mDelivered, expected );
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    tmrTimerID_t peerTimer;
+    uint32_t plainTime;
+    uint32_t windowOneTime;
+    bool_t pass = TRUE;
+    bool_t ok;
+    uint32_t i;
+
+    for( i = 0; i < mTestLength_c; i++ )
+    {
+        mPayload[i] = (uint8_t)(i * 7 + (i >> 8));
+    }
+
+    mCoordNode = WrapperHost_Connect( mTestPanId_c, mTestChannel_c, EventHandler );
+    if( gNetSimInvalidNode_c == mCoordNode )
+    {
+        return 1;
+    }
+    NetSim_SetDataHook( DataHook );
+
+    Frag_Init( &mPeer, mwFragWindow_c, PeerSend, PeerDeliver );
+    peerTimer = TMR_AllocateTimer();
+    (void)TMR_StartIntervalTimer( peerTimer, mTestPeerTick_c, PeerTimerCallback, NULL );
+
+    printf( "%u bytes, %u byte fragments, window %u, %u%% loss\n\n", mTestLength_c,
+            mwFragPayloadLen_c, mwFragWindow_c, mTestLoss_c );
+
+    /* Plain frames, stop-and-wait */
+    ok = RunPlain( "plain frames, one at a time" );
+    pass = pass && ok;
+    plainTime = mElapsed;
+
+    /* The fragment headers and the acknowledgements cost less than a quarter */
+    ok = SendLarge( "wrapper -> coordinator", 0 );
+    pass = pass && ok && (4 * mElapsed <= 5 * plainTime);
+
+    /* The MAC waits for the mac task after each plain frame, not after each
+     fragment */
+    WrapperHost_SetWakeupLatency( mTestWakeupLatency_c );
+    ok = RunPlain( "plain frames, mac task late" );
+    pass = pass && ok;
+    plainTime = mElapsed;
+
+    ok = SendLarge( "wrapper -> coordinator, late", 0 );
+    pass = pass && ok && (mElapsed < plainTime);
+    WrapperHost_SetWakeupLatency( 0 );
+
+    ok = SendLarge( "wrapper -> coordinator, losses", mTestLoss_c );
+    pass = pass && ok;
+
+    ok = ReceiveLarge( "coordinator -> wrapper, window 1", 1, 0 );
+    pass = pass && ok;
+    windowOneTime = mElapsed;
+
+    ok = ReceiveLarge( "coordinator -> wrapper", mwFragWindow_c, 0 );
+    pass = pass && ok && (mElapsed < windowOneTime);
+
+    ok = ReceiveLarge( "coordinator -> wrapper, losses", mwFragWindow_c, mTestLoss_c );
+    pass = pass && ok && (mPeer.stats.txRetransmissions > 0);
+
+    printf( "\ncoordinator: %u frames dropped, %u fragments sent again by it in the last transfer\n",
+            mDropped, mPeer.stats.txRetransmissions );
+    printf( "payload errors: %u\n", mErrors );
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,334 @@
+/************************************************************************************
+* This module contains a host test of the transmit latency statistics.
+*
+* First the statistics module alone gets known samples from a test clock, and
+* the test checks the counts, limits and histogram buckets. Then the wrapper
+* runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator, with the virtual time
+* as the clock of the stamps: the host MAC stamps the PHY sequences in the same
+* microseconds. The wrapper sends bursts of frames to the coordinator:
+*   - near: close to it, where nothing is lost;
+*   - far: where about half of the attempts are lost;
+*   - delayed: close to it again, with the confirms of the MAC delayed by
+*     mTestConfirmDelay_c and the tasks woken up mTestWakeupLatency_c late.
+* After each step the test prints the latency of every stage returned by
+* mac_get_latency() and checks that every confirm was counted, that only the
+* successful ones have the MAC and PHY stages, that the stages add up to the
+* total and that an attempt lasts at least the air time of the frame. Then it
+* checks that each cause shows in its own stage: the losses in the MAC stage
+* (backoffs and retries) and not in the PHY one (the last attempt), the delay of
+* the confirms in the confirm stage only, and the wakeup latency in the
+* delivery stage. The PHY only keeps the stamps of its last attempt, so the
+* test is built with one frame in the MAC at a time (mwMaxInFlightNormalTx_c):
+* the next one would start before a delayed confirm and take its PHY stage.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/latency_test
+*
+************************************************************************************/
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "TimersManager.h"
+#include "ieee802p15p4_wrapper.h"
+#include "LatencyStats.h"
+#include "MacHost.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+#if !mwLatencyStats_d || !gPhyTxTimestamps_d
+#error "Build the latency test with -DmwLatencyStats_d=1 -DgPhyTxTimestamps_d=1"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Traffic of each step: mTestBurst_c frames every mTestInterval_c ms */
+#define mTestBursts_c           (200)
+#define mTestBurst_c            (6)
+#define mTestInterval_c         (50)
+#define mTestPayload_c          (60)
+
+/* MAC instances: the wrapper is bound first */
+#define mTestWrapperInstance_c  (0)
+#define mTestCoordInstance_c    (1)
+
+/* Packet error rate of a single attempt sought for the far step */
+#define mTestFarPer_c           (0.5f)
+
+/* Delayed step: time [us] from the end of a sequence to the confirm reaching
+ * the wrapper, and time [ms] a task takes to run once its event is set */
+#define mTestConfirmDelay_c     (1500)
+#define mTestWakeupLatency_c    (2)
+
+/* Shortest attempt [us]: 2 symbols of 16 us per byte of the PPDU, the MHR and
+ * FCS of a frame with short addresses (11 bytes) and the 6 bytes of SHR and
+ * PHR */
+#define mTestMinAirTime_c       ((mTestPayload_c + 11 + 6) * 2 * 16)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static const char * const mStageNames[mac_latency_stages_c] =
+{
+    "queue", "mac", "phy", "confirm", "delivery", "total"
+};
+
+static uint32_t mBursts;
+static uint32_t mRefused;
+static uint32_t mConfirms;
+static uint32_t mSuccess;
+static uint64_t mTestClock;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The TestClock() function is the clock of the module test [us].
+ ******************************************************************************/
+static uint64_t TestClock( void )
+{
+    return mTestClock;
+}
+
+/******************************************************************************
+ * The CheckModule() function checks the statistics module alone. It returns
+ * TRUE if it passed.
+ ******************************************************************************/
+static bool_t CheckModule( void )
+{
+    /* Samples [us] and the buckets they fall in */
+    static const uint32_t samples[] = { 0, 1, 2, 3, 4, 7, 8, 1000, 1023, 1024, 0x80000, 0xFFFFFFFF };
+    static const uint8_t buckets[] = { 0, 0, 1, 1, 2, 2, 3, 9, 9, 10, mwLatencyBuckets_c - 1, mwLatencyBuckets_c - 1 };
+    uint32_t expected[mwLatencyBuckets_c] = { 0 };
+    latencyStats_t stats;
+    uint64_t total = 0;
+    uint32_t start;
+    uint32_t i;
+    bool_t pass;
+
+    LatencyStats_Init();
+    LatencyStats_SetClock( TestClock );
+
+    /* The stamps follow the clock through its 32 bit wrap */
+    mTestClock = 0x1FFFFFF00ULL;
+    start = LatencyStats_Now();
+    mTestClock += 0x200;
+    pass = (LatencyStats_Now() - start == 0x200);
+
+    for( i = 0; i < sizeof(samples) / sizeof(samples[0]); i++ )
+    {
+        LatencyStats_Record( gLatencyPhy_c, samples[i] );
+        expected[buckets[i]]++;
+        total += samples[i];
+    }
+
+    LatencyStats_Get( gLatencyPhy_c, &stats, TRUE );
+    pass = pass && (stats.count == i) && (0 == stats.min) && (0xFFFFFFFF == stats.max) && (stats.total == total);
+    for( i = 0; i < mwLatencyBuckets_c; i++ )
+    {
+        pass = pass && (stats.buckets[i] == expected[i]);
+    }
+
+    /* Reset, and the other stages untouched */
+    LatencyStats_Get( gLatencyPhy_c, &stats, FALSE );
+    pass = pass && (0 == stats.count) && (0xFFFFFFFF == stats.min) && (0 == stats.buckets[0]);
+    LatencyStats_Get( gLatencyQueue_c, &stats, FALSE );
+    pass = pass && (0 == stats.count);
+
+    printf( "statistics module: %s\n", pass ? "ok" : "FAILED" );
+    return pass;
+}
+
+/******************************************************************************
+ * The TxConfirm() function is the completion callback of the frames.
+ ******************************************************************************/
+static void TxConfirm( resultType_t status, void *context )
+{
+    (void)context;
+
+    mConfirms++;
+    if( gSuccess_c == status )
+    {
+        mSuccess++;
+    }
+}
+
+/******************************************************************************
+ * The TrafficCallback() function is the traffic timer callback: it queues a
+ * burst of frames to the coordinator.
+ ******************************************************************************/
+static void TrafficCallback( void *param )
+{
+    uint8_t payload[mTestPayload_c] = { 0 };
+    uint32_t i;
+
+    (void)param;
+
+    if( mBursts >= mTestBursts_c )
+    {
+        return;
+    }
+
+    mBursts++;
+    for( i = 0; i < mTestBurst_c; i++ )
+    {
+        if( mwErrorNoError != mac_transmit_async( 0x0000, payload, sizeof(payload), TxConfirm, NULL ) )
+        {
+            mRefused++;
+        }
+    }
+}
+
+/******************************************************************************
+ * The RunStep() function places the coordinator x meters away, runs the
+ * traffic, prints the latency of every stage into stats and checks it. It
+ * returns TRUE if the step passed.
+ ******************************************************************************/
+static bool_t RunStep( const char *pName, float x, tmrTimerID_t timer, mac_latency_stats_t *stats )
+{
+    uint32_t stageSum = 0;
+    uint32_t stage;
+    uint32_t bucket;
+    uint32_t last;
+    bool_t pass;
+
+    MacHost_SetPosition( mTestCoordInstance_c, x, 0.0f );
+    mBursts = 0;
+    mRefused = 0;
+    mConfirms = 0;
+    mSuccess = 0;
+
+    (void)TMR_StartIntervalTimer( timer, mTestInterval_c, TrafficCallback, NULL );
+    NetSim_Run( mTestBursts_c * mTestInterval_c + 1000 );
+    (void)TMR_StopTimer( timer );
+
+    printf( "\n%s: coordinator %.0f m away, PER %.2f per attempt, %u confirms, %u successful, %u refused\n",
+            pName, x, MacHost_GetLinkPer( mTestWrapperInstance_c, mTestCoordInstance_c, mTestPayload_c + 11 ),
+            mConfirms, mSuccess, mRefused );
+    printf( "stage     count   min [us]   avg [us]   max [us]  histogram [from us: count]\n" );
+
+    for( stage = 0; stage < mac_latency_stages_c; stage++ )
+    {
+        (void)mac_get_latency( (mac_latency_stage_t)stage, &stats[stage], TRUE );
+        printf( "%-8s %6u %10u %10u %10u ", mStageNames[stage], stats[stage].count, stats[stage].min_us,
+                stats[stage].avg_us, stats[stage].max_us );
+
+        /* The buckets from the first to the last one used */
+        for( bucket = 0; (bucket < mwLatencyBuckets_c) && !stats[stage].buckets[bucket]; bucket++ )
+        {
+        }
+        for( last = mwLatencyBuckets_c; (last > bucket) && !stats[stage].buckets[last - 1]; last-- )
+        {
+        }
+        for( ; bucket < last; bucket++ )
+        {
+            printf( " %u:%u", bucket ? 1U << bucket : 0, stats[stage].buckets[bucket] );
+        }
+        printf( "\n" );
+
+        if( stage < mac_latency_total_c )
+        {
+            stageSum += stats[stage].avg_us;
+        }
+    }
+
+    /* Every request handed to the MAC was confirmed, the successful ones
+     * have every stage. The averages are rounded down. */
+    pass = (mConfirms == mTestBursts_c * mTestBurst_c - mRefused) && (mSuccess > 0) &&
+           (stats[mac_latency_total_c].count == mConfirms) &&
+           (stats[mac_latency_queue_c].count == mConfirms) &&
+           (stats[mac_latency_delivery_c].count == mConfirms) &&
+           (stats[mac_latency_mac_c].count == mSuccess) &&
+           (stats[mac_latency_phy_c].count == mSuccess) &&
+           (stats[mac_latency_confirm_c].count == mSuccess) &&
+           (stats[mac_latency_phy_c].min_us >= mTestMinAirTime_c) &&
+           (stats[mac_latency_total_c].max_us >= stats[mac_latency_queue_c].max_us);
+    if( mSuccess == mConfirms )
+    {
+        pass = pass && (stageSum <= stats[mac_latency_total_c].avg_us) &&
+               (stageSum + mac_latency_total_c >= stats[mac_latency_total_c].avg_us);
+    }
+
+    printf( "%s: %s\n", pName, pass ? "ok" : "FAILED" );
+    return pass;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    mac_latency_stats_t near[mac_latency_stages_c];
+    mac_latency_stats_t far[mac_latency_stages_c];
+    mac_latency_stats_t delayed[mac_latency_stages_c];
+    tmrTimerID_t timer;
+    float farX;
+    bool_t stagesOk;
+    bool_t pass;
+
+    pass = CheckModule();
+
+    if( gNetSimInvalidNode_c == WrapperHost_Connect( mTestPanId_c, mTestChannel_c, NULL ) )
+    {
+        return 1;
+    }
+    LatencyStats_SetClock( MacHost_GetTimeUs );
+
+    /* Distance of the far step */
+    for( farX = 5.0f; farX < 1000.0f; farX += 1.0f )
+    {
+        MacHost_SetPosition( mTestCoordInstance_c, farX, 0.0f );
+        if( MacHost_GetLinkPer( mTestWrapperInstance_c, mTestCoordInstance_c, mTestPayload_c + 11 ) >= mTestFarPer_c )
+        {
+            break;
+        }
+    }
+
+    printf( "%u bursts of %u frames of %u bytes every %u ms per step, %u in the MAC at a time\n",
+            mTestBursts_c, mTestBurst_c, mTestPayload_c, mTestInterval_c, mwMaxInFlightNormalTx_c );
+
+    timer = TMR_AllocateTimer();
+    pass = RunStep( "near", 5.0f, timer, near ) && pass;
+    pass = RunStep( "far", farX, timer, far ) && pass;
+
+    MacHost_SetConfirmDelay( mTestConfirmDelay_c );
+    WrapperHost_SetWakeupLatency( mTestWakeupLatency_c );
+    pass = RunStep( "delayed", 5.0f, timer, delayed ) && pass;
+    MacHost_SetConfirmDelay( 0 );
+    WrapperHost_SetWakeupLatency( 0 );
+
+    /* Nothing between the MAC and the upper layer takes time on its own */
+    stagesOk = (0 == near[mac_latency_confirm_c].max_us) && (0 == near[mac_latency_delivery_c].max_us);
+    /* The losses: more backoffs and retries, the same last attempt */
+    stagesOk = stagesOk && (far[mac_latency_mac_c].avg_us > 2 * near[mac_latency_mac_c].avg_us) &&
+               (far[mac_latency_phy_c].avg_us == near[mac_latency_phy_c].avg_us) &&
+               (far[mac_latency_confirm_c].max_us == 0);
+    /* The delayed confirms, each one by the same time, and the late mac task */
+    stagesOk = stagesOk && (delayed[mac_latency_confirm_c].min_us == mTestConfirmDelay_c) &&
+               (delayed[mac_latency_confirm_c].max_us == mTestConfirmDelay_c) &&
+               (delayed[mac_latency_phy_c].avg_us == near[mac_latency_phy_c].avg_us) &&
+               (delayed[mac_latency_delivery_c].max_us <= mTestWakeupLatency_c * 1000) &&
+               (delayed[mac_latency_delivery_c].avg_us >= mTestWakeupLatency_c * 1000 / 2);
+
+    printf( "\nstages: mac %u -> %u us with the losses, confirm %u us and delivery %u us when delayed: %s\n",
+            near[mac_latency_mac_c].avg_us, far[mac_latency_mac_c].avg_us, delayed[mac_latency_confirm_c].avg_us,
+            delayed[mac_latency_delivery_c].avg_us, stagesOk ? "ok" : "FAILED" );
+    pass = pass && stagesOk;
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,172 @@
+/************************************************************************************
+* This module contains a host test of the neighbor link table.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator. Both keep sending
+* frames to each other while the coordinator is moved away in three steps:
+*   - near: every frame gets through;
+*   - far: a good share of the frames is lost and retried;
+*   - gone: out of range, nothing gets through.
+* After each step the test prints the record of the coordinator returned by
+* mac_get_link(), and checks that the average LQI drops, the NoAck count
+* and the confirm latency grow, and the time since the coordinator was last
+* heard covers the last step.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/link_test
+*
+************************************************************************************/
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "TimersManager.h"
+#include "ieee802p15p4_wrapper.h"
+#include "MacHost.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+#if !mwLinkTable_d
+#error "Build the link test with mwLinkTable_d enabled"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Traffic of each step, a frame each way every 2 intervals */
+#define mTestDuration_c         (5000)
+#define mTestInterval_c         (25)
+#define mTestPayload_c          (60)
+
+/* MAC instances: the wrapper is bound first */
+#define mTestCoordInstance_c    (1)
+
+/* Packet error rate of a single attempt sought for the far step */
+#define mTestFarPer_c           (0.5f)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint8_t  mCoordNode;
+static uint32_t mRefused;
+static uint32_t mTicks;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The TrafficCallback() function is the traffic timer callback. The wrapper
+ * and the coordinator take turns, so their frames do not collide.
+ ******************************************************************************/
+static void TrafficCallback( void *param )
+{
+    uint8_t payload[mTestPayload_c] = { 0 };
+
+    (void)param;
+
+    mTicks++;
+    if( mTicks & 1 )
+    {
+        (void)NetSim_SendData( mCoordNode, WrapperHost_GetShortAddress(), payload, sizeof(payload) );
+    }
+    else if( mwErrorNoError != mac_transmit( 0x0000, payload, sizeof(payload) ) )
+    {
+        mRefused++;
+    }
+}
+
+/******************************************************************************
+ * The RunStep() function places the coordinator x meters away, runs the
+ * traffic for mTestDuration_c ms and prints the link to the coordinator.
+ ******************************************************************************/
+static void RunStep( const char *pName, float x, tmrTimerID_t timer, mac_link_info_t *pLink )
+{
+    MacHost_SetPosition( mTestCoordInstance_c, x, 0.0f );
+
+    (void)TMR_StartIntervalTimer( timer, mTestInterval_c, TrafficCallback, NULL );
+    NetSim_Run( mTestDuration_c );
+    (void)TMR_StopTimer( timer );
+
+    /* Let the last requests complete */
+    NetSim_Run( 500 );
+
+    if( mwErrorNoError != mac_get_link( 0x0000, pLink ) )
+    {
+        printf( "%-5s no link\n", pName );
+        return;
+    }
+
+    printf( "%-5s %6.1f  %5.2f  %3u  %4d  %6u  %6u  %6u  %5u  %8.2f  %9u\n", pName, x,
+            MacHost_GetLinkPer( 0, mTestCoordInstance_c, mTestPayload_c + 11 ), pLink->lqi,
+            pLink->rssi, pLink->rx_frames, pLink->tx_attempts, pLink->tx_no_ack, pLink->tx_failures,
+            pLink->cnf_latency_us / 1e3, pLink->last_heard_ms );
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    mac_link_info_t near;
+    mac_link_info_t far;
+    mac_link_info_t gone;
+    mac_link_info_t all[4];
+    mac_link_info_t none;
+    tmrTimerID_t timer;
+    uint16_t count;
+    float farX;
+    bool_t pass;
+
+    mCoordNode = WrapperHost_Connect( mTestPanId_c, mTestChannel_c, NULL );
+    if( gNetSimInvalidNode_c == mCoordNode )
+    {
+        return 1;
+    }
+
+    /* Distance of the far step */
+    for( farX = 5.0f; farX < 1000.0f; farX += 1.0f )
+    {
+        MacHost_SetPosition( mTestCoordInstance_c, farX, 0.0f );
+        if( MacHost_GetLinkPer( 0, mTestCoordInstance_c, mTestPayload_c + 11 ) >= mTestFarPer_c )
+        {
+            break;
+        }
+    }
+
+    printf( "%u byte frames each way every %u ms, %u ms per step, EWMA weight 1/%u\n\n", mTestPayload_c,
+            2 * mTestInterval_c, mTestDuration_c, 1 << mwLinkEwmaShift_c );
+    printf( "step  dist m    PER  LQI  RSSI  rx frm  tx att  no ack  other  cnf [ms]  heard [ms]\n" );
+
+    timer = TMR_AllocateTimer();
+    RunStep( "near", 5.0f, timer, &near );
+    RunStep( "far", farX, timer, &far );
+    RunStep( "gone", 1000.0f, timer, &gone );
+
+    count = mac_get_links( all, 4 );
+    printf( "\n%u link(s) known, first 0x%04X; mac_get_link(0x0005): %s; %u refused\n", count,
+            count ? all[0].short_address : 0xFFFF,
+            (mwErrorNoError == mac_get_link( 0x0005, &none )) ? "found" : "none", mRefused );
+
+    pass = (0 == near.tx_no_ack) && (near.rx_frames > 0) &&
+           (far.lqi < near.lqi) && (far.cnf_latency_us > near.cnf_latency_us) &&
+           (far.rx_frames > near.rx_frames) &&
+           (gone.tx_no_ack > far.tx_no_ack) && (gone.rx_frames == far.rx_frames) &&
+           (gone.last_heard_ms >= mTestDuration_c) &&
+           (1 == count) && (0x0000 == all[0].short_address) &&
+           (mwErrorNoError != mac_get_link( 0x0005, &none ));
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,297 @@
+/************************************************************************************
+* This module contains a host test of the associations on the coordinator.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, and starts a PAN. mTestDevices_c simulated end devices then join it
+* at the same time, as after a power outage. The wrapper answers up to
+* mwMaxPendingAssoc_c of them at once and drops the other requests, whose
+* devices try again later. The responses are indirect: each one is resolved by
+* the MLME-COMM-STATUS.indication of its device, which comes when the device
+* polls it, so not in the order the responses were sent: half of the devices
+* are at the edge of the range of the coordinator, where the association frames
+* often need a retry.
+* The test follows the responses and the comm statuses from the event callback
+* and checks that:
+*   - at most mwMaxPendingAssoc_c responses wait for their comm status, and
+*     the table is full at some point;
+*   - the requests received while it is full are dropped (mac_get_stats());
+*   - the comm statuses come out of order and each one resolves its own
+*     response;
+*   - every device is associated in the end.
+* It prints the time until all of them are associated.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/mass_join_test
+*
+************************************************************************************/
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "FunctionLib.h"
+#include "ieee802p15p4_wrapper.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+#include "FlashHost.h"
+
+#if !mwStatistics_d
+#error "Build the mass join test with -DmwStatistics_d=1"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Time [ms] after which the start or the associations are reported as failed */
+#define mTestTimeout_c          (120000)
+#define mTestStep_c             (10)
+
+/* End devices joining at once, all the other MAC instances of the host MAC */
+#define mTestDevices_c          (gMacHostMaxNodes_c - 1)
+/* Distance [m] of the devices at the edge of the range, the others are
+ * within 3 to 3 + mTestDevices_c m */
+#define mTestEdgeDistance_c     (105.0f)
+
+/* Responses followed by the test, more than the wrapper may keep */
+#define mTestMaxPending_c       (2 * mwMaxPendingAssoc_c)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static bool_t   mStarted;
+static uint8_t  mDevices[mTestDevices_c];
+
+/* Responses waiting for their comm status, oldest first */
+static uint64_t mPending[mTestMaxPending_c];
+static uint8_t  mPendingCount;
+static uint8_t  mPendingMax;
+static uint32_t mResponses;
+
+static uint32_t mResolved;
+static uint32_t mResolvedOk;
+static uint32_t mOutOfOrder;
+static uint32_t mUnknown;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The AssociateInd() function notes the response the wrapper sent to an
+ * MLME-ASSOCIATE.indication, if it sent one.
+ ******************************************************************************/
+static void AssociateInd( mlmeAssociateInd_t *pInd )
+{
+    mac_wrapper_stats_t stats;
+
+    (void)mac_get_stats( &stats, FALSE );
+    if( stats.assoc_responses == mResponses )
+    {
+        return;
+    }
+    mResponses = stats.assoc_responses;
+
+    if( mPendingCount < mTestMaxPending_c )
+    {
+        FLib_MemCpy( &mPending[mPendingCount], &pInd->deviceAddress, sizeof(uint64_t) );
+    }
+    mPendingCount++;
+    if( mPendingCount > mPendingMax )
+    {
+        mPendingMax = mPendingCount;
+    }
+}
+
+/******************************************************************************
+ * The CommStatusInd() function resolves the response an
+ * MLME-COMM-STATUS.indication is about.
+ ******************************************************************************/
+static void CommStatusInd( mlmeCommStatusInd_t *pInd )
+{
+    uint64_t address;
+    uint8_t i;
+
+    FLib_MemCpy( &address, &pInd->destAddress, sizeof(uint64_t) );
+    for( i = 0; (i < mPendingCount) && (i < mTestMaxPending_c); i++ )
+    {
+        if( mPending[i] == address )
+        {
+            break;
+        }
+    }
+    if( (i == mPendingCount) || (i == mTestMaxPending_c) )
+    {
+        mUnknown++;
+        return;
+    }
+
+    /* Not the oldest response */
+    if( i > 0 )
+    {
+        mOutOfOrder++;
+    }
+    for( ; i + 1 < mPendingCount; i++ )
+    {
+        mPending[i] = mPending[i + 1];
+    }
+    mPendingCount--;
+
+    mResolved++;
+    if( gSuccess_c == pInd->status )
+    {
+        mResolvedOk++;
+    }
+}
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the test.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+    nwkMessage_t *pMsg;
+
+    if( mac_management_event_c != pEvent->mac_event_type )
+    {
+        return;
+    }
+
+    pMsg = pEvent->evt_data.management_event_data;
+    switch( pMsg->msgType )
+    {
+    case gMlmeStartCnf_c:
+        mStarted = TRUE;
+        break;
+
+    case gMlmeAssociateInd_c:
+        AssociateInd( &pMsg->msgData.associateInd );
+        break;
+
+    case gMlmeCommStatusInd_c:
+        CommStatusInd( &pMsg->msgData.commStatusInd );
+        break;
+
+    default:
+        break;
+    }
+}
+
+/******************************************************************************
+ * The LastAssociated() function returns the time [ms] the last end device
+ * associated, or 0xFFFFFFFF if one of them is not associated yet.
+ ******************************************************************************/
+static uint32_t LastAssociated( void )
+{
+    netSimNodeStats_t stats;
+    uint32_t last = 0;
+    uint32_t i;
+
+    for( i = 0; i < mTestDevices_c; i++ )
+    {
+        NetSim_GetNodeStats( mDevices[i], &stats );
+        if( 0xFFFFFFFF == stats.associated )
+        {
+            return 0xFFFFFFFF;
+        }
+        if( stats.associated > last )
+        {
+            last = stats.associated;
+        }
+    }
+
+    return last;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    uint8_t extAddress[8] = { 0x10, 0x00, 0x00, 0x00, 0x00, 0x25, 0x04, 0x00 };
+    netSimNodeCfg_t cfg = { 0 };
+    mac_wrapper_stats_t stats;
+    uint32_t start;
+    uint32_t last;
+    uint32_t i;
+    bool_t pass;
+
+    FlashHost_Init();
+    NetSim_Init( 1, NULL );
+    NetSim_SetIdleHook( WrapperHost_RunTasks );
+
+    /* The wrapper is the first MAC instance, the end devices follow */
+    (void)mac_init( extAddress );
+    (void)mac_connect( mTestChannel_c, mTestPanId_c, EventHandler );
+    while( !mStarted && (OSA_TimeGetMsec() < mTestTimeout_c) )
+    {
+        NetSim_Run( mTestStep_c );
+    }
+    if( !mStarted )
+    {
+        printf( "start FAILED\n" );
+        return 1;
+    }
+
+    /* All of them at once, without reports */
+    start = OSA_TimeGetMsec();
+    cfg.role = gNetSimEndDevice_c;
+    cfg.panId = mTestPanId_c;
+    cfg.channel = mTestChannel_c;
+    cfg.payloadLength = 9;
+    cfg.startDelay = 1;
+    for( i = 0; i < mTestDevices_c; i++ )
+    {
+        if( i & 1 )
+        {
+            cfg.x = mTestEdgeDistance_c + 0.3f * i;
+        }
+        else
+        {
+            cfg.x = 3.0f + i;
+        }
+        mDevices[i] = NetSim_AddNode( &cfg );
+    }
+
+    do
+    {
+        NetSim_Run( mTestStep_c );
+        last = LastAssociated();
+    } while( (0xFFFFFFFF == last) && (OSA_TimeGetMsec() - start < mTestTimeout_c) );
+    /* Let the last comm statuses through */
+    NetSim_Run( 1000 );
+    (void)mac_get_stats( &stats, FALSE );
+
+    printf( "%u end devices joining at once, %u association responses at a time\n\n",
+            mTestDevices_c, mwMaxPendingAssoc_c );
+    printf( "responses sent:            %u, at most %u waiting for their comm status\n",
+            stats.assoc_responses, mPendingMax );
+    printf( "requests dropped:          %u\n", stats.assoc_dropped );
+    printf( "comm statuses:             %u, %u successful, %u out of order, %u unknown\n",
+            mResolved, mResolvedOk, mOutOfOrder, mUnknown );
+    if( 0xFFFFFFFF == last )
+    {
+        printf( "all associated:            FAILED after %u ms\n", mTestTimeout_c );
+    }
+    else
+    {
+        printf( "all associated:            %u ms after the start\n", last - start );
+    }
+
+    pass = (0xFFFFFFFF != last) &&
+           (mPendingMax == mwMaxPendingAssoc_c) && (stats.assoc_dropped > 0) &&
+           (mResolved == stats.assoc_responses) && (0 == mPendingCount) && (0 == mUnknown) &&
+           (mResolvedOk == mTestDevices_c) && (mOutOfOrder > 0);
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
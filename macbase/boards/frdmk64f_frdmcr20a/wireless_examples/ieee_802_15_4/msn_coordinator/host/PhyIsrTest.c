@@ -0,0 +1,597 @@
+/************************************************************************************
+* This module contains a host test of the MCR20A PHY on the transceiver model.
+*
+* PhyISR.c, PhyStateMachine.c, PhyPlmeData.c, PhyTime.c and PhyPacketProcessor.c
+* run unmodified on MCR20Sim.c instead of MCR20Drv.c, in the virtual time of the
+* model. The PHY drives transceiver 0. Transceiver 1 is a peer the test programs
+* itself through the MCR20Drv_* registers, on the same channel and PAN. The test
+* takes the place of the MAC on the PD and PLME SAPs:
+*   - tx: PD-DATA.requests with CCA, each one acknowledged by the peer;
+*   - rx: the peer sends frames that ask for an ACK, the PHY listening with
+*     RxOnWhenIdle and acknowledging them;
+*   - ed: PLME-ED.requests on a quiet channel, then on a noisy one.
+* For each step it prints the ISR profile of the PHY given by the model: ISRs per
+* operation, their time and SPI transfers, and for tx the time from the request
+* to the confirm beyond the time the radio needs (warm up, CCA, turnaround, frame,
+* ACK): the latency of the PHY state machine and of its SPI accesses.
+* The test checks that every request is confirmed with success, that every frame
+* arrives intact and is acknowledged, that the ED sees the noise, that the ISRs
+* and the latency stay within bounds and that the PHY frees every buffer.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/phy_isr_test
+*
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "FunctionLib.h"
+#include "MemManager.h"
+#include "Messaging.h"
+#include "GPIO_Adapter.h"
+#include "gpio_pins.h"
+#include "PhyInterface.h"
+#include "Phy.h"
+#include "MCR20Reg.h"
+#include "MCR20Sim.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestChannel_c          (15)
+#define mTestPanId_c            (0x1234)
+#define mTestPhyAddress_c       (0x0001)
+#define mTestPeerAddress_c      (0x0002)
+#define mTestPeer_c             (1)
+
+/* Operations of each step, and the time [ns] each one gets */
+#define mTestFrames_c           (100)
+#define mTestEdRequests_c       (10)
+#define mTestPayload_c          (50)
+#define mTestTimeout_c          (20000000ULL)
+#define mTestSymbol_c           (16000)
+/* Symbols of a CCA */
+#define mTestCcaTime_c          (8)
+
+/* Background energy [-dBm] of the noisy channel of the ed step */
+#define mTestNoise_c            (50)
+
+/* Bounds of the profile: ISRs per operation, longest ISR [ns], SPI transfers
+ * in one ISR, and time [ns] of the PHY beyond the radio time of a tx */
+#define mTestMaxIsrs_c          (3)
+#define mTestMaxIsrTime_c       (120000)
+#define mTestMaxIsrSpi_c        (16)
+#define mTestMaxTxOverhead_c    (50000)
+
+/* Data frame, short addresses, PAN id compressed, ACK requested */
+#define mTestFcfLow_c           (0x61)
+#define mTestFcfHigh_c          (0x88)
+#define mTestHeader_c           (9)
+#define mTestFcs_c              (2)
+#define mTestAck_c              (5)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/* Results of a step */
+typedef struct testStep_tag
+{
+    uint32_t requests;
+    uint32_t confirms;
+    uint32_t failed;
+    uint32_t indications;
+    uint32_t corrupted;
+    uint32_t acked;
+    uint64_t latency;
+    uint32_t maxLatency;
+} testStep_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+const gpioInputPinConfig_t mXcvrIrqPinCfg = { 0 };
+
+/* Requests of the MAC, MemManager buffers as the PHY may queue them */
+static macToPdDataMessage_t *mpDataReq;
+static macToPlmeMessage_t   *mpPlmeReq;
+/* The PHY writes the length of the frame in the byte before the PSDU */
+static uint8_t  mFrame[1 + gMaxPHYPacketSize_c];
+static bool_t   mDone;
+static uint8_t  mSeq;
+static uint8_t  mEnergy;
+static uint32_t mBuffers;
+static uint32_t mInterruptsDisabled;
+static bool_t   mXcvrSleepAllowed = TRUE;
+static testStep_t *mpStep;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The PdSapHandler() function takes the place of the MAC on the PD SAP. It
+ * counts the confirms and checks the frames received.
+ ******************************************************************************/
+static phyStatus_t PdSapHandler( pdDataToMacMessage_t *pMsg, instanceId_t instanceId )
+{
+    pdDataInd_t *pInd = &pMsg->msgData.dataInd;
+    uint8_t i;
+
+    (void)instanceId;
+
+    if( gPdDataCnf_c == pMsg->msgType )
+    {
+        mpStep->confirms++;
+        if( gPhySuccess_c != pMsg->msgData.dataCnf.status )
+        {
+            mpStep->failed++;
+        }
+    }
+    else if( gPdDataInd_c == pMsg->msgType )
+    {
+        mpStep->indications++;
+        if( (pInd->psduLength != mTestHeader_c + mTestPayload_c) || (pInd->pPsdu[2] != mSeq) )
+        {
+            mpStep->corrupted++;
+        }
+        else
+        {
+            for( i = 0; i < mTestPayload_c; i++ )
+            {
+                if( pInd->pPsdu[mTestHeader_c + i] != (uint8_t)(mSeq + i) )
+                {
+                    mpStep->corrupted++;
+                    break;
+                }
+            }
+        }
+    }
+
+    mDone = TRUE;
+    (void)MEM_BufferFree( pMsg );
+    return gPhySuccess_c;
+}
+
+/******************************************************************************
+ * The PlmeSapHandler() function takes the place of the MAC on the PLME SAP.
+ * It keeps the energy of the ED confirms.
+ ******************************************************************************/
+static phyStatus_t PlmeSapHandler( plmeToMacMessage_t *pMsg, instanceId_t instanceId )
+{
+    (void)instanceId;
+
+    if( gPlmeEdCnf_c == pMsg->msgType )
+    {
+        mpStep->confirms++;
+        if( gPhySuccess_c != pMsg->msgData.edCnf.status )
+        {
+            mpStep->failed++;
+        }
+        mEnergy = pMsg->msgData.edCnf.energyLevel;
+        mDone = TRUE;
+    }
+
+    (void)MEM_BufferFree( pMsg );
+    return gPhySuccess_c;
+}
+
+/******************************************************************************
+ * The RunUntilDone() function advances the virtual time, event after event,
+ * until a SAP handler sets mDone or for mTestTimeout_c. It returns TRUE if
+ * the operation completed.
+ ******************************************************************************/
+static bool_t RunUntilDone( void )
+{
+    uint64_t deadline = MCR20Sim_GetTime() + mTestTimeout_c;
+    uint64_t next;
+
+    while( !mDone && (MCR20Sim_GetTime() < deadline) )
+    {
+        if( !MCR20Sim_GetNextEventTime( &next ) || (next > deadline) )
+        {
+            next = deadline;
+        }
+        MCR20Sim_Advance( (next > MCR20Sim_GetTime()) ? next - MCR20Sim_GetTime() : 0 );
+    }
+
+    return mDone;
+}
+
+/******************************************************************************
+ * The SetPib() function sets a PIB attribute of the PHY.
+ ******************************************************************************/
+static void SetPib( phyPibId_t attribute, uint64_t value )
+{
+    mpPlmeReq->msgType = gPlmeSetReq_c;
+    mpPlmeReq->macInstance = 0;
+    mpPlmeReq->msgData.setReq.PibAttribute = attribute;
+    mpPlmeReq->msgData.setReq.PibAttributeValue = value;
+    (void)MAC_PLME_SapHandler( mpPlmeReq, 0 );
+}
+
+/******************************************************************************
+ * The BuildFrame() function builds a numbered data frame to dst in pPsdu and
+ * returns its length, FCS excluded.
+ ******************************************************************************/
+static uint8_t BuildFrame( uint8_t *pPsdu, uint8_t seq, uint16_t dst, uint16_t src )
+{
+    uint8_t i;
+
+    pPsdu[0] = mTestFcfLow_c;
+    pPsdu[1] = mTestFcfHigh_c;
+    pPsdu[2] = seq;
+    pPsdu[3] = (uint8_t)mTestPanId_c;
+    pPsdu[4] = (uint8_t)(mTestPanId_c >> 8);
+    pPsdu[5] = (uint8_t)dst;
+    pPsdu[6] = (uint8_t)(dst >> 8);
+    pPsdu[7] = (uint8_t)src;
+    pPsdu[8] = (uint8_t)(src >> 8);
+    for( i = 0; i < mTestPayload_c; i++ )
+    {
+        pPsdu[mTestHeader_c + i] = (uint8_t)(seq + i);
+    }
+
+    return mTestHeader_c + mTestPayload_c;
+}
+
+/******************************************************************************
+ * The PeerInit() function programs the peer transceiver: the channel of the
+ * PHY, the PAN and the address of the peer, the frame filter and auto ACK.
+ ******************************************************************************/
+static void PeerInit( void )
+{
+    uint8_t pll[3];
+    uint8_t value[2];
+
+    /* The PLL settings of the channel the PHY is on */
+    (void)MCR20Drv_DirectAccessSPIMultiByteRead( PLL_INT0, pll, sizeof(pll) );
+
+    (void)MCR20Sim_SetActiveNode( mTestPeer_c );
+    MCR20Drv_DirectAccessSPIMultiByteWrite( PLL_INT0, pll, sizeof(pll) );
+    value[0] = (uint8_t)mTestPanId_c;
+    value[1] = (uint8_t)(mTestPanId_c >> 8);
+    MCR20Drv_IndirectAccessSPIMultiByteWrite( MACPANID0_LSB, value, sizeof(value) );
+    value[0] = (uint8_t)mTestPeerAddress_c;
+    value[1] = (uint8_t)(mTestPeerAddress_c >> 8);
+    MCR20Drv_IndirectAccessSPIMultiByteWrite( MACSHORTADDRS0_LSB, value, sizeof(value) );
+    MCR20Drv_IndirectAccessSPIWrite( RX_FRAME_FILTER, cRX_FRAME_FLT_FRM_VER | cRX_FRAME_FLT_DATA_FT );
+    (void)MCR20Sim_SetActiveNode( 0 );
+}
+
+/******************************************************************************
+ * The PeerStart() function starts a sequence of the peer, once the previous
+ * one is over. A TR sequence sends the frame of the packet buffer and waits
+ * for its ACK.
+ ******************************************************************************/
+static void PeerStart( uint8_t sequence )
+{
+    (void)MCR20Sim_SetActiveNode( mTestPeer_c );
+    MCR20Drv_DirectAccessSPIWrite( IRQSTS1, cIRQSTS1_SEQIRQ | cIRQSTS1_TXIRQ | cIRQSTS1_RXIRQ | cIRQSTS1_CCAIRQ );
+    MCR20Drv_DirectAccessSPIWrite( PHY_CTRL1, cPHY_CTRL1_AUTOACK | gIdle_c );
+    MCR20Drv_DirectAccessSPIWrite( PHY_CTRL1, cPHY_CTRL1_AUTOACK | cPHY_CTRL1_RXACKRQD | sequence );
+    (void)MCR20Sim_SetActiveNode( 0 );
+}
+
+/******************************************************************************
+ * The PeerAccepted() function returns the frames the peer accepted, ACKs
+ * included.
+ ******************************************************************************/
+static uint32_t PeerAccepted( void )
+{
+    mcr20SimStats_t stats;
+
+    MCR20Sim_GetStats( mTestPeer_c, &stats, FALSE );
+    return stats.rxFrames;
+}
+
+/******************************************************************************
+ * The AirTime() function returns the time [ns] of a frame on air, FCS
+ * excluded from length.
+ ******************************************************************************/
+static uint64_t AirTime( uint8_t length )
+{
+    return (uint64_t)(gPhySHRDuration_c + (length + mTestFcs_c + 1) * gPhySymbolsPerOctet_c) * mTestSymbol_c;
+}
+
+/******************************************************************************
+ * The PrintProfile() function prints the ISR profile of the PHY for a step
+ * and returns TRUE if it is within the bounds.
+ ******************************************************************************/
+static bool_t PrintProfile( const char *pName, uint32_t operations )
+{
+    mcr20SimStats_t stats;
+    bool_t ok;
+
+    MCR20Sim_GetStats( 0, &stats, TRUE );
+    ok = operations && (stats.isrCount >= operations) && (stats.isrCount <= mTestMaxIsrs_c * operations) &&
+         (stats.isrMaxTime <= mTestMaxIsrTime_c) && (stats.isrMaxSpiTransfers <= mTestMaxIsrSpi_c);
+
+    printf( "%-4s  %10u  %6u  %10.2f  %10.2f  %10.2f  %9.2f  %7u  %s\n", pName, operations, stats.isrCount,
+            operations ? (double)stats.isrCount / operations : 0.0,
+            stats.isrCount ? (double)stats.isrTime / stats.isrCount / 1000.0 : 0.0,
+            (double)stats.isrMaxTime / 1000.0,
+            stats.isrCount ? (double)stats.isrSpiTransfers / stats.isrCount : 0.0,
+            stats.isrMaxSpiTransfers, ok ? "ok" : "FAILED" );
+
+    return ok;
+}
+
+/******************************************************************************
+ * The RunTx() function sends mTestFrames_c frames to the peer, with CCA, and
+ * measures the time from each request to its confirm.
+ ******************************************************************************/
+static void RunTx( testStep_t *pStep )
+{
+    uint64_t start;
+    uint32_t latency;
+    uint32_t accepted;
+    uint32_t i;
+
+    mpStep = pStep;
+    for( i = 0; i < mTestFrames_c; i++ )
+    {
+        PeerStart( gRX_c );
+        accepted = PeerAccepted();
+
+        mpDataReq->msgType = gPdDataReq_c;
+        mpDataReq->macInstance = 0;
+        mpDataReq->msgData.dataReq.startTime = gPhySeqStartAsap_c;
+        mpDataReq->msgData.dataReq.txDuration = 0xFFFFFFFF;
+        mpDataReq->msgData.dataReq.slottedTx = gPhyUnslottedMode_c;
+        mpDataReq->msgData.dataReq.CCABeforeTx = gPhyCCAMode1_c;
+        mpDataReq->msgData.dataReq.ackRequired = gPhyRxAckRqd_c;
+        mpDataReq->msgData.dataReq.pPsdu = &mFrame[1];
+        mpDataReq->msgData.dataReq.psduLength = BuildFrame( &mFrame[1], (uint8_t)i, mTestPeerAddress_c, mTestPhyAddress_c );
+
+        mDone = FALSE;
+        start = MCR20Sim_GetTime();
+        pStep->requests++;
+        if( gPhySuccess_c != MAC_PD_SapHandler( mpDataReq, 0 ) )
+        {
+            pStep->failed++;
+            continue;
+        }
+        if( !RunUntilDone() )
+        {
+            continue;
+        }
+
+        /* The frame and the ACK of the peer */
+        if( PeerAccepted() == accepted + 1 )
+        {
+            pStep->acked++;
+        }
+        latency = (uint32_t)(MCR20Sim_GetTime() - start);
+        pStep->latency += latency;
+        if( latency > pStep->maxLatency )
+        {
+            pStep->maxLatency = latency;
+        }
+    }
+}
+
+/******************************************************************************
+ * The RunRx() function has the peer send mTestFrames_c frames to the PHY,
+ * which listens with RxOnWhenIdle.
+ ******************************************************************************/
+static void RunRx( testStep_t *pStep )
+{
+    uint8_t frame[1 + gMaxPHYPacketSize_c];
+    uint32_t accepted;
+    uint32_t i;
+
+    mpStep = pStep;
+    SetPib( gPhyPibRxOnWhenIdle, TRUE );
+
+    for( i = 0; i < mTestFrames_c; i++ )
+    {
+        mSeq = (uint8_t)i;
+        frame[0] = BuildFrame( &frame[1], mSeq, mTestPhyAddress_c, mTestPeerAddress_c ) + mTestFcs_c;
+        accepted = PeerAccepted();
+
+        (void)MCR20Sim_SetActiveNode( mTestPeer_c );
+        MCR20Drv_PB_SPIBurstWrite( frame, frame[0] - mTestFcs_c + 1 );
+        (void)MCR20Sim_SetActiveNode( 0 );
+
+        mDone = FALSE;
+        pStep->requests++;
+        PeerStart( gTR_c );
+        if( !RunUntilDone() )
+        {
+            continue;
+        }
+
+        /* The ACK of the PHY, after its turnaround */
+        MCR20Sim_Advance( (gPhyTurnaroundTime_c * mTestSymbol_c) + AirTime( mTestAck_c - mTestFcs_c ) );
+        if( PeerAccepted() == accepted + 1 )
+        {
+            pStep->acked++;
+        }
+    }
+
+    SetPib( gPhyPibRxOnWhenIdle, FALSE );
+}
+
+/******************************************************************************
+ * The RunEd() function runs mTestEdRequests_c PLME-ED.requests and returns
+ * the energy level of the last one.
+ ******************************************************************************/
+static uint8_t RunEd( testStep_t *pStep )
+{
+    uint32_t i;
+
+    mpStep = pStep;
+    for( i = 0; i < mTestEdRequests_c; i++ )
+    {
+        mpPlmeReq->msgType = gPlmeEdReq_c;
+        mpPlmeReq->macInstance = 0;
+
+        mDone = FALSE;
+        pStep->requests++;
+        if( gPhySuccess_c != MAC_PLME_SapHandler( mpPlmeReq, 0 ) )
+        {
+            pStep->failed++;
+            continue;
+        }
+        (void)RunUntilDone();
+    }
+
+    return mEnergy;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/*! *********************************************************************************
+* \brief  The heap of the host stands for the MemManager pools, the buffers in use
+*         are counted.
+********************************************************************************** */
+void* MEM_BufferAllocWithId( uint32_t numBytes, uint8_t poolId, void *pCaller )
+{
+    listHeader_t *pBuf = malloc( sizeof(listHeader_t) + numBytes );
+
+    (void)poolId;
+    (void)pCaller;
+
+    if( NULL == pBuf )
+    {
+        return NULL;
+    }
+
+    /* The messaging lists link the buffers through their header */
+    mBuffers++;
+    return pBuf + 1;
+}
+
+memStatus_t MEM_BufferFree( void* buffer )
+{
+    if( NULL == buffer )
+    {
+        return MEM_FREE_ERROR_c;
+    }
+
+    mBuffers--;
+    free( (listHeader_t *)buffer - 1 );
+    return MEM_SUCCESS_c;
+}
+
+/*! *********************************************************************************
+* \brief  The model calls the ISR itself, from MCR20Sim_Advance() only.
+********************************************************************************** */
+gpioStatus_t GpioInstallIsr( pfGpioIsrCb_t cb, uint8_t priority, uint8_t nvicPriority,
+                             const gpioInputPinConfig_t* pInputConfig )
+{
+    (void)cb;
+    (void)priority;
+    (void)nvicPriority;
+    (void)pInputConfig;
+    return gpio_success;
+}
+
+/*! *********************************************************************************
+* \brief  The low power module of the target: the PHY keeps the transceiver awake
+*         while a sequence is pending.
+********************************************************************************** */
+void PWR_DisallowXcvrToSleep( void )
+{
+    mXcvrSleepAllowed = FALSE;
+}
+
+void PWR_AllowXcvrToSleep( void )
+{
+    mXcvrSleepAllowed = TRUE;
+}
+
+void OSA_InterruptDisable( void )
+{
+    mInterruptsDisabled++;
+}
+
+void OSA_InterruptEnable( void )
+{
+    mInterruptsDisabled--;
+}
+
+int main( void )
+{
+    testStep_t tx = { 0 }, rx = { 0 }, quiet = { 0 }, noisy = { 0 };
+    uint8_t quietEnergy, noisyEnergy;
+    uint64_t radioTime;
+    uint32_t overhead;
+    bool_t pass;
+
+    mpDataReq = MSG_AllocType( macToPdDataMessage_t );
+    mpPlmeReq = MSG_AllocType( macToPlmeMessage_t );
+    if( (NULL == mpDataReq) || (NULL == mpPlmeReq) )
+    {
+        printf( "FAIL\n" );
+        return 1;
+    }
+
+    MCR20Sim_Init();
+    MCR20Sim_SetSeed( 1 );
+    Phy_Init();
+    Phy_RegisterSapHandlers( PdSapHandler, PlmeSapHandler, 0 );
+    SetPib( gPhyPibCurrentChannel_c, mTestChannel_c );
+    SetPib( gPhyPibPanId_c, mTestPanId_c );
+    SetPib( gPhyPibShortAddress_c, mTestPhyAddress_c );
+    PeerInit();
+    /* The wake up IRQ of the power up */
+    MCR20Sim_Advance( 1000000 );
+    MCR20Sim_GetStats( 0, NULL, TRUE );
+
+    printf( "PHY on the MCR20A model, channel %u, %u byte payloads\n\n", mTestChannel_c, mTestPayload_c );
+    printf( "step  operations    ISRs  ISRs / op  avg [us]    max [us]   SPI / ISR  max SPI\n" );
+
+    RunTx( &tx );
+    pass = PrintProfile( "tx", tx.confirms );
+    RunRx( &rx );
+    pass = PrintProfile( "rx", rx.indications ) && pass;
+    quietEnergy = RunEd( &quiet );
+    MCR20Sim_SetChannelEnergy( mTestChannel_c, mTestNoise_c );
+    noisyEnergy = RunEd( &noisy );
+    pass = PrintProfile( "ed", quiet.confirms + noisy.confirms ) && pass;
+
+    (void)MSG_Free( mpDataReq );
+    (void)MSG_Free( mpPlmeReq );
+
+    /* Warm up, CCA, turnaround, frame, turnaround and ACK */
+    radioTime = (gPhyWarmUpTime_c + mTestCcaTime_c + 2 * gPhyTurnaroundTime_c) * mTestSymbol_c +
+                AirTime( mTestHeader_c + mTestPayload_c ) + AirTime( mTestAck_c - mTestFcs_c );
+    overhead = tx.confirms ? (uint32_t)(tx.latency / tx.confirms - radioTime) : 0;
+
+    printf( "\ntx: %u/%u confirmed, %u failed, %u acknowledged; request to confirm %.1f us avg, %.1f us max, "
+            "%.1f us of them on air: %.1f us of PHY\n", tx.confirms, tx.requests, tx.failed, tx.acked,
+            tx.confirms ? (double)tx.latency / tx.confirms / 1000.0 : 0.0, (double)tx.maxLatency / 1000.0,
+            (double)radioTime / 1000.0, (double)overhead / 1000.0 );
+    printf( "rx: %u/%u received, %u corrupted, %u acknowledged\n", rx.indications, rx.requests, rx.corrupted,
+            rx.acked );
+    printf( "ed: %u/%u confirmed, energy level %u quiet, %u at -%u dBm\n", quiet.confirms + noisy.confirms,
+            quiet.requests + noisy.requests, quietEnergy, noisyEnergy, mTestNoise_c );
+    printf( "buffers left %u, interrupts disabled %u, transceiver sleep %s\n", mBuffers, mInterruptsDisabled,
+            mXcvrSleepAllowed ? "allowed" : "disallowed" );
+
+    pass = pass &&
+           (tx.confirms == mTestFrames_c) && (0 == tx.failed) && (tx.acked == mTestFrames_c) &&
+           (tx.latency >= radioTime * tx.confirms) && (overhead <= mTestMaxTxOverhead_c) &&
+           (rx.indications == mTestFrames_c) && (0 == rx.corrupted) && (rx.acked == mTestFrames_c) &&
+           (quiet.confirms == mTestEdRequests_c) && (noisy.confirms == mTestEdRequests_c) &&
+           (0 == quiet.failed + noisy.failed) && (noisyEnergy > quietEnergy) &&
+           (0 == mBuffers) && (0 == mInterruptsDisabled) && mXcvrSleepAllowed;
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
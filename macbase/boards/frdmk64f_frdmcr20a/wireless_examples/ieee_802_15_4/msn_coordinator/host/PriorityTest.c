@@ -0,0 +1,265 @@
+/************************************************************************************
+* This module contains a host test of the transmit priority classes.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator. Bulk telemetry keeps
+* the normal priority class full: every completed request is replaced at once
+* by a new one, from its mac_transmit_async() callback. Meanwhile a timer sends
+* a short high priority alarm with mac_transmit_priority() at a fixed interval.
+* The mac task takes mTestWakeupLatency_c to run once an event is set, as it
+* would behind the other tasks of the target.
+* The test checks that:
+*   - every alarm finds a slot in the queue, and is confirmed;
+*   - at most mwMaxInFlightNormalTx_c bulk requests are confirmed between the
+*     queueing of an alarm and its own confirm, that is, an alarm waits for at
+*     most that many bulk requests in the MAC.
+* It prints the queueing delay of each class from mac_get_stats(), and the bulk
+* frames per second. priority_test_1 is the same test with one bulk request in
+* the MAC at a time: the alarms wait less, and the bulk frames/s drop by the
+* time the MAC stays idle while the mac task wakes up.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/priority_test build/priority_test_1
+*
+************************************************************************************/
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "TimersManager.h"
+#include "ieee802p15p4_wrapper.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+#if !mwStatistics_d
+#error "Build the priority test with -DmwStatistics_d=1"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Traffic */
+#define mTestDuration_c         (20000)
+#define mTestBulkPayload_c      (100)
+#define mTestAlarmPayload_c     (16)
+#define mTestAlarmInterval_c    (47)
+
+/* Time [ms] from an event to the mac task running */
+#define mTestWakeupLatency_c    (2)
+
+/* Alarms that can be waiting for their confirm at the same time */
+#define mTestMaxAlarms_c        (mwTxHighReservedSlots_c + 1)
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static void BulkConfirm( resultType_t status, void *context );
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static bool_t   mBulkRunning;
+static uint32_t mBulkSent;
+static uint32_t mBulkConfirmed;
+static uint32_t mBulkFailed;
+
+/* Bulk confirms counted when each outstanding alarm was queued, oldest first */
+static uint32_t mAlarmMark[mTestMaxAlarms_c];
+static uint8_t  mAlarmHead;
+static uint8_t  mAlarmCount;
+static uint32_t mAlarmsSent;
+static uint32_t mAlarmsRefused;
+static uint32_t mAlarmsConfirmed;
+static uint32_t mAlarmsFailed;
+static uint32_t mAlarmMaxBulkAhead;
+static uint32_t mAlarmErrors;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The SendBulk() function queues a bulk telemetry frame.
+ ******************************************************************************/
+static bool_t SendBulk( void )
+{
+    uint8_t payload[mTestBulkPayload_c] = { 0 };
+
+    payload[0] = (uint8_t)mBulkSent;
+    if( mwErrorNoError != mac_transmit_async( 0x0000, payload, sizeof(payload), BulkConfirm, NULL ) )
+    {
+        return FALSE;
+    }
+
+    mBulkSent++;
+    return TRUE;
+}
+
+/******************************************************************************
+ * The BulkConfirm() function is the completion callback of the bulk frames:
+ * it replaces the frame, so the normal priority class stays full.
+ ******************************************************************************/
+static void BulkConfirm( resultType_t status, void *context )
+{
+    (void)context;
+
+    mBulkConfirmed++;
+    if( gSuccess_c != status )
+    {
+        mBulkFailed++;
+    }
+
+    if( mBulkRunning )
+    {
+        (void)SendBulk();
+    }
+}
+
+/******************************************************************************
+ * The AlarmCallback() function is the alarm timer callback.
+ ******************************************************************************/
+static void AlarmCallback( void *param )
+{
+    uint8_t payload[mTestAlarmPayload_c] = { 0xA1 };
+
+    (void)param;
+
+    if( mAlarmCount >= mTestMaxAlarms_c )
+    {
+        mAlarmErrors++;
+        return;
+    }
+
+    mAlarmMark[(mAlarmHead + mAlarmCount) % mTestMaxAlarms_c] = mBulkConfirmed;
+    if( mwErrorNoError == mac_transmit_priority( 0x0000, payload, sizeof(payload), mac_tx_priority_high_c ) )
+    {
+        mAlarmCount++;
+        mAlarmsSent++;
+    }
+    else
+    {
+        mAlarmsRefused++;
+    }
+}
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the test. The
+ * bulk confirms go to their own callback, so every MCPS-DATA.confirm here is
+ * the one of the oldest outstanding alarm.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+    mcpsToNwkMessage_t *pMsg;
+    uint32_t bulkAhead;
+
+    if( mac_management_event_c == pEvent->mac_event_type )
+    {
+        return;
+    }
+
+    pMsg = pEvent->evt_data.data_event_data;
+    if( gMcpsDataCnf_c != pMsg->msgType )
+    {
+        return;
+    }
+
+    if( 0 == mAlarmCount )
+    {
+        mAlarmErrors++;
+        return;
+    }
+
+    bulkAhead = mBulkConfirmed - mAlarmMark[mAlarmHead];
+    if( bulkAhead > mAlarmMaxBulkAhead )
+    {
+        mAlarmMaxBulkAhead = bulkAhead;
+    }
+    mAlarmHead = (mAlarmHead + 1) % mTestMaxAlarms_c;
+    mAlarmCount--;
+
+    mAlarmsConfirmed++;
+    if( gSuccess_c != pMsg->msgData.dataCnf.status )
+    {
+        mAlarmsFailed++;
+    }
+}
+
+/******************************************************************************
+ * The PrintDelay() function prints the queueing delay of a priority class.
+ ******************************************************************************/
+static void PrintDelay( const char *pName, const mac_tx_delay_stats_t *pDelay )
+{
+    uint32_t count = pDelay->count ? pDelay->count : 1;
+
+    printf( "%-6s %7u  %9.2f  %9.2f  %9.2f  %9.2f\n", pName, pDelay->count,
+            pDelay->queue_total_us / 1e3 / count, pDelay->queue_max_us / 1e3,
+            pDelay->cnf_total_us / 1e3 / count, pDelay->cnf_max_us / 1e3 );
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    mac_wrapper_stats_t stats;
+    tmrTimerID_t alarmTimer;
+    uint32_t bulkConfirmed;
+    bool_t pass;
+
+    if( gNetSimInvalidNode_c == WrapperHost_Connect( mTestPanId_c, mTestChannel_c, EventHandler ) )
+    {
+        return 1;
+    }
+
+    WrapperHost_SetWakeupLatency( mTestWakeupLatency_c );
+
+    /* Fill the normal priority class, then start the alarms */
+    mBulkRunning = TRUE;
+    while( SendBulk() )
+    {
+    }
+    (void)mac_get_stats( &stats, TRUE );
+
+    alarmTimer = TMR_AllocateTimer();
+    (void)TMR_StartIntervalTimer( alarmTimer, mTestAlarmInterval_c, AlarmCallback, NULL );
+    bulkConfirmed = mBulkConfirmed;
+    NetSim_Run( mTestDuration_c );
+    bulkConfirmed = mBulkConfirmed - bulkConfirmed;
+    (void)TMR_StopTimer( alarmTimer );
+
+    /* Let the outstanding requests complete */
+    mBulkRunning = FALSE;
+    NetSim_Run( 1000 );
+    (void)mac_get_stats( &stats, FALSE );
+
+    printf( "class    count  queue avg  queue max    cnf avg    cnf max  [ms]\n" );
+    PrintDelay( "high", &stats.tx_delay[mac_tx_priority_high_c] );
+    PrintDelay( "normal", &stats.tx_delay[mac_tx_priority_normal_c] );
+    printf( "\nbulk: %u sent, %u confirmed, %u failed\n", mBulkSent, mBulkConfirmed, mBulkFailed );
+    printf( "bulk with %u in the MAC: %.1f frames/s\n", mwMaxInFlightNormalTx_c,
+            bulkConfirmed * 1000.0 / mTestDuration_c );
+    printf( "alarms: %u sent, %u refused, %u confirmed, %u failed, %u errors\n", mAlarmsSent,
+            mAlarmsRefused, mAlarmsConfirmed, mAlarmsFailed, mAlarmErrors );
+    printf( "most bulk confirms between an alarm and its confirm: %u\n", mAlarmMaxBulkAhead );
+
+    pass = (mAlarmsSent > 0) && (0 == mAlarmsRefused) && (mAlarmsConfirmed == mAlarmsSent) &&
+           (0 == mAlarmErrors) && (mAlarmMaxBulkAhead <= mwMaxInFlightNormalTx_c) && (mBulkConfirmed == mBulkSent) &&
+           (stats.tx_delay[mac_tx_priority_high_c].count == mAlarmsSent);
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
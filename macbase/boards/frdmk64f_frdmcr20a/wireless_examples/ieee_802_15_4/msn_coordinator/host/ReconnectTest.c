@@ -0,0 +1,334 @@
+/************************************************************************************
+* This module contains a host test of the fast reconnect (mwFastReconnect_d).
+*
+* The mac wrapper runs unchanged on the host MAC, in the virtual time of the
+* network simulator, and every boot is a new process, so nothing but the flash
+* image (FlashHost.c) survives from one boot to the next. Each boot measures the
+* time from mac_connect() to the connection event:
+*   - end device, blank flash: active scan, then association;
+*   - end device, saved parameters: association to the saved coordinator;
+*   - end device, saved parameters but the PAN moved to another channel: the
+*     association times out, then active scan and association;
+*   - coordinator, blank flash: active scan, 7 s wait, ED scan, start;
+*   - coordinator, saved parameters: start on the saved channel.
+* The test checks that every boot connects with the expected short address, in
+* the expected time: a rejoin within mTestRejoinMax_c, a fallback within
+* mTestFallbackMax_c but not faster than a rejoin, since it scanned. It also
+* checks the outcome in the flash: the parameters are saved again after a scan
+* and a fallback, and reused as they are after a rejoin, so the boot after the
+* fallback rejoins the PAN on its new channel.
+* Before the boots, it cuts the power in the middle of mTestPowerCutSaves_c
+* saves of the parameters (NwkParams.c), before each of their flash operations:
+* the parameters loaded after a cut are the previous ones, or the new ones once
+* the save is complete, never none, including when the save moves to the other
+* sector and erases it.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/reconnect_test
+*
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "ieee802p15p4_wrapper.h"
+#include "NwkParams.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+#include "FlashHost.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+#define mTestOtherChannel_c     (20)
+
+/* Time [ms] the simulated coordinator gets to start before the wrapper connects */
+#define mTestCoordStartTime_c   (100)
+/* Time [ms] after which a boot is reported as failed */
+#define mTestTimeout_c          (30000)
+#define mTestStep_c             (10)
+
+/* Expected connection times [ms]:
+ *   - device rejoin: one association, answered within the response wait
+ *     time (~492 ms);
+ *   - device fallback: the association on the saved channel is not
+ *     acknowledged, then scan and association as with a blank flash;
+ *   - coordinator rejoin: the start on the saved channel, no scan;
+ *   - coordinator, blank flash: at least the 7 s wait after the active scan. */
+#define mTestRejoinMax_c        (600)
+#define mTestFallbackMax_c      (1200)
+#define mTestCoordRejoinMax_c   (100)
+#define mTestCoordScanMin_c     (7000)
+
+/* Saves cut by a power loss, enough to go through both sectors a few times,
+ * and flash operations of a save: a program, after an erase if it starts a
+ * sector */
+#define mTestPowerCutSaves_c    (400)
+#define mTestPowerCutOps_c      (2)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/* What survives a boot: the flash, and the results for the parent process */
+typedef struct testShared_tag
+{
+    uint8_t  flash[gFlashHostImageSize_c];
+    uint32_t connectTime;       /* ms from mac_connect() to the connection, 0 if it failed */
+    uint16_t shortAddress;
+    uint32_t erases;
+    uint32_t programs;
+} testShared_t;
+
+/* A boot */
+typedef struct testBoot_tag
+{
+    const char *pName;
+    bool_t      coordinator;    /* Role of the wrapper */
+    uint8_t     netChannel;     /* Channel of the simulated coordinator, 0 for none */
+    uint8_t     connectChannel; /* Channel given to mac_connect() */
+    uint32_t    minTime;        /* Expected connection time [ms] */
+    uint32_t    maxTime;
+    uint32_t    programs;       /* Flash writes: 1 if the parameters are saved, 0 if reused */
+} testBoot_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static const testBoot_t mBoots[] =
+{
+    { "device, blank flash",             FALSE, mTestChannel_c,      mTestChannel_c,
+      mTestRejoinMax_c,    mTestTimeout_c,        1 },
+    { "device, saved parameters",        FALSE, mTestChannel_c,      mTestChannel_c,
+      0,                   mTestRejoinMax_c,      0 },
+    { "device, PAN moved channel",       FALSE, mTestOtherChannel_c, mTestOtherChannel_c,
+      mTestRejoinMax_c,    mTestFallbackMax_c,    1 },
+    { "device, saved parameters",        FALSE, mTestOtherChannel_c, mTestOtherChannel_c,
+      0,                   mTestRejoinMax_c,      0 },
+    { "coordinator, blank flash",        TRUE,  0,                   mTestChannel_c,
+      mTestCoordScanMin_c, mTestTimeout_c,        1 },
+    { "coordinator, saved parameters",   TRUE,  0,                   mTestChannel_c,
+      0,                   mTestCoordRejoinMax_c, 0 },
+};
+
+static testShared_t *mpShared;
+static bool_t        mConnected;
+static uint16_t      mShortAddress;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the test.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+    nwkMessage_t *pMsg;
+
+    if( mac_management_event_c != pEvent->mac_event_type )
+    {
+        return;
+    }
+
+    pMsg = pEvent->evt_data.management_event_data;
+    if( gMlmeAssociateCnf_c == pMsg->msgType )
+    {
+        mShortAddress = pMsg->msgData.associateCnf.assocShortAddress;
+        mConnected = TRUE;
+    }
+    else if( gMlmeStartCnf_c == pMsg->msgType )
+    {
+        mShortAddress = 0x0000;
+        mConnected = TRUE;
+    }
+}
+
+/******************************************************************************
+ * The PowerCuts() function saves two sets of parameters in turn, and before
+ * each save restarts it from the same flash content with the power cut after
+ * 0 to mTestPowerCutOps_c - 1 flash operations. It returns TRUE if every
+ * load after a cut gives the parameters saved before, or the new ones if the
+ * cut came after the last operation of the save.
+ ******************************************************************************/
+static bool_t PowerCuts( void )
+{
+    static uint8_t before[gFlashHostImageSize_c];
+    static uint8_t after[gFlashHostImageSize_c];
+    nwkParams_t params[2];
+    nwkParams_t loaded;
+    uint32_t operations;
+    uint32_t switches = 0;
+    uint32_t cuts = 0;
+    uint32_t i;
+    uint32_t cut;
+    bool_t found;
+    bool_t ok = TRUE;
+
+    FLib_MemSet( params, 0, sizeof(params) );
+    for( i = 0; i < 2; i++ )
+    {
+        params[i].panId = mTestPanId_c;
+        params[i].shortAddress = 0x0001;
+        params[i].channel = i ? mTestOtherChannel_c : mTestChannel_c;
+        params[i].role = mNwkParamsDevice_c;
+    }
+
+    FlashHost_Init();
+    for( i = 0; (i < mTestPowerCutSaves_c) && ok; i++ )
+    {
+        FlashHost_Save( before );
+        operations = FlashHost_GetEraseCount() + FlashHost_GetProgramCount();
+        ok = (0 == NwkParams_Save( &params[i & 1] ));
+        operations = FlashHost_GetEraseCount() + FlashHost_GetProgramCount() - operations;
+        FlashHost_Save( after );
+        if( operations > 1 )
+        {
+            switches++;
+        }
+
+        for( cut = 0; (cut < operations) && ok; cut++ )
+        {
+            FlashHost_Restore( before );
+            FlashHost_CutPower( cut );
+            (void)NwkParams_Save( &params[i & 1] );
+            FlashHost_CutPower( gFlashHostNoPowerCut_c );
+            cuts++;
+
+            /* The first save has nothing to fall back to */
+            found = NwkParams_Load( &loaded );
+            ok = i ? (found && FLib_MemCmp( &loaded, &params[(i + 1) & 1], sizeof(nwkParams_t) )) : !found;
+        }
+        FlashHost_Restore( after );
+
+        ok = ok && (operations >= 1) && (operations <= mTestPowerCutOps_c) &&
+             NwkParams_Load( &loaded ) && FLib_MemCmp( &loaded, &params[i & 1], sizeof(nwkParams_t) );
+    }
+
+    printf( "power cuts: %u saves, %u of them to the other sector, %u cuts, %s\n\n",
+            i, switches, cuts, ok ? "previous parameters kept" : "parameters LOST" );
+    return ok && (switches > 1);
+}
+
+/******************************************************************************
+ * The Boot() function runs one boot in a child process.
+ ******************************************************************************/
+static void Boot( const testBoot_t *pBoot )
+{
+    uint8_t extAddress[8] = { 0x10, 0x00, 0x00, 0x00, 0x00, 0x25, 0x04, 0x00 };
+    netSimNodeCfg_t cfg = { 0 };
+    uint64_t start;
+
+    FlashHost_Init();
+    FlashHost_Restore( mpShared->flash );
+
+    NetSim_Init( 1, NULL );
+    NetSim_SetIdleHook( WrapperHost_RunTasks );
+
+    /* The wrapper node is the first MAC instance, the other nodes follow */
+    (void)mac_init( extAddress );
+
+    if( pBoot->netChannel )
+    {
+        cfg.role = gNetSimCoordinator_c;
+        cfg.x = 5.0f;
+        cfg.panId = mTestPanId_c;
+        cfg.channel = pBoot->netChannel;
+        (void)NetSim_AddNode( &cfg );
+    }
+    NetSim_Run( mTestCoordStartTime_c );
+
+    start = NetSim_GetTimeUs();
+    (void)mac_connect( pBoot->connectChannel, mTestPanId_c, EventHandler );
+    while( !mConnected && (NetSim_GetTimeUs() - start < mTestTimeout_c * 1000ULL) )
+    {
+        NetSim_Run( mTestStep_c );
+    }
+
+    mpShared->connectTime = mConnected ? (uint32_t)((NetSim_GetTimeUs() - start) / 1000) : 0;
+    mpShared->shortAddress = mShortAddress;
+    mpShared->erases = FlashHost_GetEraseCount();
+    mpShared->programs = FlashHost_GetProgramCount();
+    FlashHost_Save( mpShared->flash );
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    uint32_t i;
+    pid_t pid;
+    int status;
+    bool_t ok;
+    bool_t pass = TRUE;
+
+    mpShared = mmap( NULL, sizeof(testShared_t), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0 );
+    if( MAP_FAILED == mpShared )
+    {
+        return 1;
+    }
+    pass = PowerCuts();
+
+    FlashHost_Init();
+    FlashHost_Save( mpShared->flash );
+
+    printf( "boot                              connect[ms]  expected[ms]  short  erases  programs\n" );
+
+    for( i = 0; i < sizeof(mBoots) / sizeof(mBoots[0]); i++ )
+    {
+        /* The coordinator boots start from a blank flash */
+        if( mBoots[i].coordinator && !mBoots[i - 1].coordinator )
+        {
+            FlashHost_Init();
+            FlashHost_Save( mpShared->flash );
+        }
+
+        fflush( stdout );
+        pid = fork();
+        if( 0 == pid )
+        {
+            Boot( &mBoots[i] );
+            _exit( 0 );
+        }
+        if( (pid < 0) || (waitpid( pid, &status, 0 ) != pid) || !WIFEXITED( status ) )
+        {
+            mpShared->connectTime = 0;
+        }
+
+        if( mpShared->connectTime )
+        {
+            ok = (mpShared->connectTime >= mBoots[i].minTime) && (mpShared->connectTime <= mBoots[i].maxTime) &&
+                 (mpShared->shortAddress == (mBoots[i].coordinator ? 0x0000 : 0x0001)) &&
+                 (mpShared->programs == mBoots[i].programs);
+            printf( "%-33s %11u  %5u-%-6u  0x%04X  %6u  %8u  %s\n", mBoots[i].pName, mpShared->connectTime,
+                    mBoots[i].minTime, mBoots[i].maxTime, mpShared->shortAddress, mpShared->erases,
+                    mpShared->programs, ok ? "ok" : "FAILED" );
+        }
+        else
+        {
+            printf( "%-33s      FAILED\n", mBoots[i].pName );
+            ok = FALSE;
+        }
+        pass = pass && ok;
+    }
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
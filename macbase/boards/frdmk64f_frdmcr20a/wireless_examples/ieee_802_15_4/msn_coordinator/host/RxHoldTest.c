@@ -0,0 +1,351 @@
+/************************************************************************************
+* This module contains a host test of the receive ownership transfer
+* (mwRxZeroCopy_d) under pool pressure.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator that sends it numbered
+* frames. The buffers of the MAC and the wrapper are limited to what they use
+* once connected, plus mwRxMaxHeldMsgs_c and a few spare ones, as a MemManager
+* pool would be. The event handler keeps every data indication it is allowed to
+* and releases them with mac_rx_release() from a consumer much slower than the
+* frames:
+*   - slow: the consumer releases one indication every mTestConsumeInterval_c;
+*   - stalled: the consumer releases none.
+* In both the test checks that every frame is delivered once, that no more than
+* mwRxMaxHeldMsgs_c indications are kept at a time (the others are copied) and
+* that no allocation fails. Then it fills the spare buffers itself and checks
+* that frames are lost, so the pool is as small as it claims. Once everything is
+* released the buffers shall be back to where they started. mac_rx_release()
+* shall succeed for every indication kept, and refuse, without freeing it, an
+* indication released already and a buffer that never was one.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/rx_hold_test
+*
+************************************************************************************/
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "FunctionLib.h"
+#include "MemManager.h"
+#include "TimersManager.h"
+#include "ieee802p15p4_wrapper.h"
+#include "MacHost.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+#if !mwRxZeroCopy_d
+#error "Build the receive hold test with -DmwRxZeroCopy_d=1"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Numbered frames of each phase, one every mTestInterval_c ms, and the time
+ * [ms] the last one gets to arrive */
+#define mTestFrames_c           (200)
+#define mTestExhaustFrames_c    (20)
+#define mTestInterval_c         (20)
+#define mTestPayload_c          (60)
+#define mTestDrainTime_c        (1000)
+
+/* The consumer releases one indication every mTestConsumeInterval_c ms */
+#define mTestConsumeInterval_c  (100)
+
+/* Buffers of the pool above what the MAC and the wrapper use once connected
+ * and the indications that can be kept: frames on air and confirms */
+#define mTestPoolSpare_c        (4)
+
+/* The MEM_* buffers of the MAC and of the wrapper task */
+#define mTestMacBucket_c        (gNetSimMaxNodes_c)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/* Results of a phase */
+typedef struct testPhase_tag
+{
+    uint32_t sent;
+    uint32_t delivered;
+    uint32_t deliveredTwice;
+    uint32_t retained;
+    uint32_t copied;
+    uint32_t heldPeak;
+    uint32_t overCap;
+    uint32_t refused;
+} testPhase_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint8_t  mCoordNode;
+static uint32_t mSeq;
+static uint32_t mPhaseEnd;
+static uint8_t  mSeen[2 * mTestFrames_c + mTestExhaustFrames_c];
+static bool_t   mConsuming;
+static testPhase_t *mpPhase;
+
+/* Indications kept, oldest first. One more than allowed, to count overruns. */
+static mcpsToNwkMessage_t *mHeld[mwRxMaxHeldMsgs_c + 1];
+static uint32_t mHeldCount;
+/* Last indication released, and the releases refused */
+static mcpsToNwkMessage_t *mReleased;
+static uint32_t mReleaseErrors;
+static uint8_t  mCopy[mTestPayload_c];
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the test. It
+ * keeps every data indication it can.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+    mcpsDataInd_t *pInd;
+    uint32_t seq;
+
+    if( mac_management_event_c == pEvent->mac_event_type )
+    {
+        return;
+    }
+
+    if( (mac_data_event_c != pEvent->mac_event_type) ||
+        (gMcpsDataInd_c != pEvent->evt_data.data_event_data->msgType) || (NULL == mpPhase) )
+    {
+        return;
+    }
+
+    pInd = &pEvent->evt_data.data_event_data->msgData.dataInd;
+    FLib_MemCpy( &seq, pInd->pMsdu, sizeof(seq) );
+    if( seq < sizeof(mSeen) )
+    {
+        if( mSeen[seq] )
+        {
+            mpPhase->deliveredTwice++;
+        }
+        mSeen[seq] = 1;
+        mpPhase->delivered++;
+    }
+
+    if( pEvent->can_retain && (mHeldCount < mwRxMaxHeldMsgs_c + 1) )
+    {
+        if( mHeldCount == mwRxMaxHeldMsgs_c )
+        {
+            mpPhase->overCap++;
+        }
+        mHeld[mHeldCount++] = pEvent->evt_data.data_event_data;
+        pEvent->retained = TRUE;
+        mpPhase->retained++;
+        if( mHeldCount > mpPhase->heldPeak )
+        {
+            mpPhase->heldPeak = mHeldCount;
+        }
+    }
+    else
+    {
+        FLib_MemCpy( mCopy, pInd->pMsdu, (pInd->msduLength < sizeof(mCopy)) ? pInd->msduLength : sizeof(mCopy) );
+        mpPhase->copied++;
+    }
+}
+
+/******************************************************************************
+ * The ReleaseOldest() function gives the oldest indication kept back.
+ ******************************************************************************/
+static void ReleaseOldest( void )
+{
+    uint32_t i;
+
+    if( mHeldCount )
+    {
+        if( mwErrorNoError != mac_rx_release( mHeld[0] ) )
+        {
+            mReleaseErrors++;
+        }
+        mReleased = mHeld[0];
+        mHeldCount--;
+        for( i = 0; i < mHeldCount; i++ )
+        {
+            mHeld[i] = mHeld[i + 1];
+        }
+    }
+}
+
+/******************************************************************************
+ * The ConsumeCallback() function is the timer callback of the slow consumer.
+ ******************************************************************************/
+static void ConsumeCallback( void *param )
+{
+    (void)param;
+
+    if( mConsuming )
+    {
+        ReleaseOldest();
+    }
+}
+
+/******************************************************************************
+ * The SendCallback() function is the timer callback of the coordinator
+ * frames.
+ ******************************************************************************/
+static void SendCallback( void *param )
+{
+    uint8_t payload[mTestPayload_c] = { 0 };
+
+    (void)param;
+
+    if( mSeq < mPhaseEnd )
+    {
+        FLib_MemCpy( payload, &mSeq, sizeof(mSeq) );
+        if( NetSim_SendData( mCoordNode, WrapperHost_GetShortAddress(), payload, sizeof(payload) ) )
+        {
+            mSeq++;
+            mpPhase->sent++;
+        }
+    }
+}
+
+/******************************************************************************
+ * The RunPhase() function sends frames numbered up to end, or as many as it
+ * can in twice their time, and lets them arrive, then prints the results of the phase.
+ ******************************************************************************/
+static void RunPhase( const char *pName, testPhase_t *pPhase, uint32_t end, tmrTimerID_t timer )
+{
+    netSimNodeStats_t mem;
+    uint32_t refused;
+    uint32_t deadline;
+
+    NetSim_GetNodeStats( mTestMacBucket_c, &mem );
+    refused = mem.buffersRefused;
+
+    FLib_MemSet( pPhase, 0, sizeof(testPhase_t) );
+    pPhase->heldPeak = mHeldCount;
+    mpPhase = pPhase;
+    mPhaseEnd = end;
+
+    /* Twice the time the frames need: a node out of buffers may stop sending */
+    deadline = OSA_TimeGetMsec() + 2 * (end - mSeq) * mTestInterval_c;
+    (void)TMR_StartIntervalTimer( timer, mTestInterval_c, SendCallback, NULL );
+    while( (mSeq < mPhaseEnd) && (OSA_TimeGetMsec() < deadline) )
+    {
+        NetSim_Run( mTestInterval_c );
+    }
+    (void)TMR_StopTimer( timer );
+    NetSim_Run( mTestDrainTime_c );
+
+    NetSim_GetNodeStats( mTestMacBucket_c, &mem );
+    pPhase->refused = mem.buffersRefused - refused;
+
+    printf( "%-9s  %4u  %9u  %5u  %8u  %6u  %9u  %7u\n", pName, pPhase->sent, pPhase->delivered,
+            pPhase->deliveredTwice, pPhase->retained, pPhase->copied, pPhase->heldPeak, pPhase->refused );
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    netSimNodeStats_t mem;
+    testPhase_t slow, stalled, exhausted;
+    void *fill[mTestPoolSpare_c + mwRxMaxHeldMsgs_c];
+    uint32_t fillCount = 0;
+    uint16_t baseline;
+    void *pForeign;
+    int nullRc;
+    int foreignRc;
+    int twiceRc;
+    tmrTimerID_t sendTimer;
+    tmrTimerID_t consumeTimer;
+    bool_t pass;
+
+    mCoordNode = WrapperHost_Connect( mTestPanId_c, mTestChannel_c, EventHandler );
+    if( gNetSimInvalidNode_c == mCoordNode )
+    {
+        return 1;
+    }
+    NetSim_Run( mTestDrainTime_c );
+
+    /* The pool: what is in use now, the indications that can be kept and a
+     * few spare buffers */
+    NetSim_GetNodeStats( mTestMacBucket_c, &mem );
+    baseline = mem.buffersCurrent;
+    NetSim_SetMemLimit( mTestMacBucket_c, baseline + mwRxMaxHeldMsgs_c + mTestPoolSpare_c );
+
+    printf( "pool of %u buffers: %u in use, %u kept at most, %u spare; a frame every %u ms, "
+            "one release every %u ms\n\n", baseline + mwRxMaxHeldMsgs_c + mTestPoolSpare_c, baseline,
+            mwRxMaxHeldMsgs_c, mTestPoolSpare_c, mTestInterval_c, mTestConsumeInterval_c );
+    printf( "phase      sent  delivered  twice  retained  copied  held peak  refused\n" );
+
+    sendTimer = TMR_AllocateTimer();
+    consumeTimer = TMR_AllocateTimer();
+    (void)TMR_StartIntervalTimer( consumeTimer, mTestConsumeInterval_c, ConsumeCallback, NULL );
+
+    mConsuming = TRUE;
+    RunPhase( "slow", &slow, mTestFrames_c, sendTimer );
+
+    mConsuming = FALSE;
+    RunPhase( "stalled", &stalled, 2 * mTestFrames_c, sendTimer );
+
+    /* The spare buffers taken away: the frames have nowhere to go */
+    while( (fillCount < sizeof(fill) / sizeof(fill[0])) && (NULL != (fill[fillCount] = MEM_BufferAlloc( 1 ))) )
+    {
+        fillCount++;
+    }
+    RunPhase( "exhausted", &exhausted, 2 * mTestFrames_c + mTestExhaustFrames_c, sendTimer );
+
+    /* Everything given back */
+    (void)TMR_StopTimer( consumeTimer );
+    while( fillCount )
+    {
+        (void)MEM_BufferFree( fill[--fillCount] );
+    }
+    while( mHeldCount )
+    {
+        ReleaseOldest();
+    }
+
+    /* Nothing kept any more: each of these would free a buffer twice */
+    pForeign = MEM_BufferAlloc( sizeof(mcpsToNwkMessage_t) );
+    nullRc = mac_rx_release( NULL );
+    foreignRc = mac_rx_release( pForeign );
+    twiceRc = mac_rx_release( mReleased );
+    (void)MEM_BufferFree( pForeign );
+
+    NetSim_Run( mTestDrainTime_c );
+    NetSim_GetNodeStats( mTestMacBucket_c, &mem );
+
+    printf( "\nbuffers in use %u at the end, %u at the start; releases refused: %u\n",
+            mem.buffersCurrent, baseline, mReleaseErrors );
+    printf( "mac_rx_release() of NULL: %d, of a buffer never kept: %d, of an indication released: %d\n",
+            nullRc, foreignRc, twiceRc );
+
+    pass = (slow.sent == mTestFrames_c) && (slow.delivered == slow.sent) && (0 == slow.deliveredTwice) &&
+           (slow.retained > 0) && (slow.copied > 0) && (slow.heldPeak == mwRxMaxHeldMsgs_c) &&
+           (0 == slow.overCap) && (0 == slow.refused) &&
+           (stalled.sent == mTestFrames_c) && (stalled.delivered == stalled.sent) &&
+           (0 == stalled.deliveredTwice) && (stalled.copied > 0) && (stalled.heldPeak == mwRxMaxHeldMsgs_c) &&
+           (0 == stalled.overCap) && (0 == stalled.refused) &&
+           (exhausted.delivered < exhausted.sent) && (exhausted.refused > 0) &&
+           (mem.buffersCurrent == baseline) && (0 == mReleaseErrors) && (NULL != mReleased) &&
+           (mwErrorInvalidParameter == nullRc) && (mwErrorInvalidParameter == foreignRc) &&
+           (mwErrorInvalidParameter == twiceRc);
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
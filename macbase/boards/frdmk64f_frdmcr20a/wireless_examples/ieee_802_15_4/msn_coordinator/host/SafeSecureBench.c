@@ -0,0 +1,419 @@
+/************************************************************************************
+* This module contains a host benchmark of the SafeSecure transmit path.
+*
+* For a few frame lengths it measures the packets/s of the former transmit path,
+* which allocated the frame and expanded the AES key on every packet, and of
+* SafeSecure_Transmit(), which only runs the cipher and the CRC into the scratch
+* frame given to SafeSecure_Init(). Every frame sent is checked
+* against the FIPS-197 test vector and decrypted back by SafeSecure_Decrypt().
+*
+* The authenticated mode (AES-CCM) is checked against the packet vector #1 of
+* RFC 3610, its frames go back through SafeSecure_DecryptCcm() and every
+* change to them is caught. Its throughput is measured for frames of 16 to
+* 116 bytes, next to the one of the first block and CRC mode.
+*
+* Every rate is the median of mBenchRuns_c runs in CPU time, the runs of the two
+* paths compared taking turns. The +- is half the range from the slowest run
+* to the fastest one, in % of the median: two rates are only different when
+* their difference is larger than that.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/safesecure_bench
+*
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "safesecure.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mBenchLoops_c           (50000)
+#define mBenchRuns_c            (15)
+#define mBenchMaxFrame_c        (118)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/* Transmit paths measured */
+typedef enum
+{
+    mPathFormer_c,
+    mPathBlock_c,
+    mPathCcm_c
+} benchPath_t;
+
+/* Rate of mBenchRuns_c runs: median and half its range [%] */
+typedef struct
+{
+    double median;
+    double spread;
+} benchRate_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Key and cipher block of the FIPS-197 / SP 800-38A example, the key is the one
+ * of safesecure.c */
+static const uint8_t mPlainBlock[16] = { 0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96,
+                                         0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a };
+static const uint8_t mCipherBlock[16] = { 0x3a, 0xd7, 0x7b, 0xb4, 0x0d, 0x7a, 0x36, 0x60,
+                                          0xa8, 0x9e, 0xca, 0xf3, 0x24, 0x66, 0xef, 0x97 };
+extern uint8_t key[];
+
+static const uint8_t mLengths[] = { 16, 48, 116 };
+
+/* RFC 3610, packet vector #1: 8 bytes of header authenticated, 23 bytes of
+ * payload, 8 bytes of MIC */
+static const uint8_t mCcmKey[16] = { 0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+                                     0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf };
+static const uint8_t mCcmNonce[13] = { 0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00,
+                                       0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5 };
+static const uint8_t mCcmCipher[23 + 8] = { 0x58, 0x8c, 0x97, 0x9a, 0x61, 0xc6, 0x63, 0xd2,
+                                            0xf0, 0x66, 0xd0, 0xc2, 0xc0, 0xf9, 0x89, 0x80,
+                                            0x6d, 0x5f, 0x6b, 0x61, 0xda, 0xc3, 0x84,
+                                            0x17, 0xe8, 0xd1, 0x2c, 0xfd, 0xf9, 0x26, 0xe0 };
+
+static uint8_t mScratch[mBenchMaxFrame_c];
+static uint8_t mSent[mBenchMaxFrame_c];
+static uint8_t mSentLen;
+static volatile uint32_t mSink;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The Now() function returns the CPU time of the process in ns, which the
+ * other processes of the host do not add to.
+ ******************************************************************************/
+static uint64_t Now( void )
+{
+    struct timespec ts;
+
+    clock_gettime( CLOCK_PROCESS_CPUTIME_ID, &ts );
+    return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/******************************************************************************
+ * The CountTx() function is the transmit callback of the timed loops.
+ ******************************************************************************/
+static SafeSecureTransmitMsg_t CountTx( uint16_t dest, uint8_t* data, uint8_t len )
+{
+    (void)dest;
+    mSink += data[len - 1];
+    return SafeSecureTransmitMsg_Success;
+}
+
+/******************************************************************************
+ * The CaptureTx() function is the transmit callback of the checks, it keeps a
+ * copy of the frame.
+ ******************************************************************************/
+static SafeSecureTransmitMsg_t CaptureTx( uint16_t dest, uint8_t* data, uint8_t len )
+{
+    (void)dest;
+    memcpy( mSent, data, len );
+    mSentLen = len;
+    return SafeSecureTransmitMsg_Success;
+}
+
+/******************************************************************************
+ * The FormerTransmit() function does the work of the former transmit path per
+ * packet: allocation, key expansion, cipher and CRC, callback and release.
+ ******************************************************************************/
+static void FormerTransmit( uint16_t dest, uint8_t* data, uint8_t len )
+{
+    struct AES_ctx ctx;
+    uint8_t* pFrame = malloc( len + 2 );
+    uint16_t crc;
+
+    memcpy( pFrame, data, len );
+    AES_init_ctx( &ctx, key );
+    AES_ECB_encrypt( &ctx, pFrame );
+    crc = crc_16( pFrame, len );
+    pFrame[len] = (uint8_t)crc;
+    pFrame[len + 1] = (uint8_t)(crc >> 8);
+
+    CountTx( dest, pFrame, len + 2 );
+    free( pFrame );
+}
+
+/******************************************************************************
+ * The Run() function sends mBenchLoops_c frames of len bytes on a path and
+ * returns the packets/s.
+ ******************************************************************************/
+static double Run( benchPath_t path, uint8_t* data, uint8_t len )
+{
+    uint64_t t0 = Now();
+    uint32_t i;
+
+    for( i = 0; i < mBenchLoops_c; i++ )
+    {
+        switch( path )
+        {
+        case mPathFormer_c:
+            FormerTransmit( 0x0001, data, len );
+            break;
+        case mPathBlock_c:
+            SafeSecure_Transmit( 0x0001, data, len );
+            break;
+        default:
+            SafeSecure_TransmitCcm( 0x0001, data, len );
+            break;
+        }
+    }
+    return mBenchLoops_c * 1e9 / (Now() - t0);
+}
+
+/******************************************************************************
+ * The CompareDouble() function orders two doubles for qsort().
+ ******************************************************************************/
+static int CompareDouble( const void* pA, const void* pB )
+{
+    double a = *(const double*)pA;
+    double b = *(const double*)pB;
+
+    return (a > b) - (a < b);
+}
+
+/******************************************************************************
+ * The Summarize() function returns the median of mBenchRuns_c values and half
+ * their range, in % of the median. The values are sorted.
+ ******************************************************************************/
+static benchRate_t Summarize( double* pValues )
+{
+    benchRate_t rate;
+
+    qsort( pValues, mBenchRuns_c, sizeof(double), CompareDouble );
+    rate.median = pValues[mBenchRuns_c / 2];
+    rate.spread = 50 * (pValues[mBenchRuns_c - 1] - pValues[0]) / rate.median;
+    return rate;
+}
+
+/******************************************************************************
+ * The Compare() function measures two paths, lenA and lenB bytes long, taking
+ * turns, and gives their rates and the one of their ratio B/A run by run.
+ ******************************************************************************/
+static void Compare( benchPath_t pathA, uint8_t lenA, benchPath_t pathB, uint8_t lenB, uint8_t* data,
+                     benchRate_t* pA, benchRate_t* pB, benchRate_t* pRatio )
+{
+    double a[mBenchRuns_c], b[mBenchRuns_c], ratio[mBenchRuns_c];
+    uint32_t r;
+
+    for( r = 0; r < mBenchRuns_c; r++ )
+    {
+        a[r] = Run( pathA, data, lenA );
+        b[r] = Run( pathB, data, lenB );
+        ratio[r] = b[r] / a[r];
+    }
+
+    *pA = Summarize( a );
+    *pB = Summarize( b );
+    *pRatio = Summarize( ratio );
+}
+
+/******************************************************************************
+ * The CheckFrames() function sends one frame of every length and checks its
+ * cipher block, its length and its way back through SafeSecure_Decrypt().
+ ******************************************************************************/
+static int CheckFrames( void )
+{
+    uint8_t data[mBenchMaxFrame_c];
+    uint8_t len;
+    uint32_t i;
+
+    SafeSecure_Init( CaptureTx, (ptrFnc_Receive)0, sizeof(mScratch), mScratch );
+
+    for( len = 1; len <= mBenchMaxFrame_c - 2; len++ )
+    {
+        memcpy( data, mPlainBlock, sizeof(mPlainBlock) );
+        for( i = sizeof(mPlainBlock); i < len; i++ )
+        {
+            data[i] = (uint8_t)i;
+        }
+
+        if( SafeSecureTransmitMsg_Success != SafeSecure_Transmit( 0x0001, data, len ) )
+        {
+            printf( "length %u not sent\n", len );
+            return 0;
+        }
+
+        if( (mSentLen != ((len < 16) ? 16 : len) + 2) ||
+            ((len >= 16) && memcmp( mSent, mCipherBlock, 16 )) )
+        {
+            printf( "length %u: wrong frame\n", len );
+            return 0;
+        }
+
+        if( (SafeSecureReceiveMsg_Success != SafeSecure_Decrypt( mSent, mSentLen )) ||
+            memcmp( mSent, data, len ) )
+        {
+            printf( "length %u: not decrypted back\n", len );
+            return 0;
+        }
+
+        /* A bit flipped in the frame is caught by the CRC */
+        SafeSecure_Transmit( 0x0001, data, len );
+        mSent[len / 2] ^= 0x10;
+        if( SafeSecureReceiveMsg_CurruptData != SafeSecure_Decrypt( mSent, mSentLen ) )
+        {
+            printf( "length %u: corruption not detected\n", len );
+            return 0;
+        }
+    }
+
+    if( SafeSecureTransmitMsg_MaxSizeExceeded != SafeSecure_Transmit( 0x0001, data, mBenchMaxFrame_c - 1 ) )
+    {
+        printf( "oversized frame sent\n" );
+        return 0;
+    }
+
+    return 1;
+}
+
+/******************************************************************************
+ * The CheckCcm() function checks AES_key_ccm() against the RFC 3610 vector,
+ * then sends frames of every length in the authenticated mode and checks that
+ * they decrypt back and that a change to any of their bytes, or another
+ * source address, is caught.
+ ******************************************************************************/
+static int CheckCcm( void )
+{
+    struct AES_key aesKey;
+    uint8_t header[8];
+    uint8_t data[mBenchMaxFrame_c];
+    uint8_t frame[mBenchMaxFrame_c];
+    uint8_t len;
+    uint32_t i;
+
+    for( i = 0; i < sizeof(header); i++ )
+    {
+        header[i] = (uint8_t)i;
+    }
+    for( i = 0; i < 23; i++ )
+    {
+        data[i] = (uint8_t)(8 + i);
+    }
+
+    AES_key_init( &aesKey, AES_BACKEND_DEFAULT, mCcmKey );
+    AES_key_ccm( &aesKey, mCcmNonce, header, sizeof(header), data, 23, &data[23], 8, 1 );
+    if( memcmp( data, mCcmCipher, sizeof(mCcmCipher) ) )
+    {
+        printf( "CCM: RFC 3610 vector #1 not matched\n" );
+        return 0;
+    }
+    if( !AES_key_ccm( &aesKey, mCcmNonce, header, sizeof(header), data, 23, &data[23], 8, 0 ) ||
+        (data[0] != 8) || (data[22] != 30) )
+    {
+        printf( "CCM: RFC 3610 vector #1 not decrypted back\n" );
+        return 0;
+    }
+
+    SafeSecure_Init( CaptureTx, (ptrFnc_Receive)0, sizeof(mScratch), mScratch );
+    SafeSecure_SetSource( 0x0002, 0xFFFFFFF0 );
+
+    for( len = 0; len <= mBenchMaxFrame_c - SAFESECURE_CCM_OVERHEAD; len++ )
+    {
+        for( i = 0; i < len; i++ )
+        {
+            data[i] = (uint8_t)(i * 13 + len);
+        }
+
+        if( (SafeSecureTransmitMsg_Success != SafeSecure_TransmitCcm( 0x0001, data, len )) ||
+            (mSentLen != len + SAFESECURE_CCM_OVERHEAD) )
+        {
+            printf( "CCM: length %u not sent\n", len );
+            return 0;
+        }
+
+        /* Every byte of the frame changed in turn, then the source */
+        for( i = 0; i <= mSentLen; i++ )
+        {
+            memcpy( frame, mSent, mSentLen );
+            if( i < mSentLen )
+            {
+                frame[i] ^= 0x01;
+            }
+            if( SafeSecureReceiveMsg_CurruptData !=
+                SafeSecure_DecryptCcm( (i < mSentLen) ? 0x0002 : 0x0003, frame, mSentLen ) )
+            {
+                printf( "CCM: length %u, change at %u not detected\n", len, i );
+                return 0;
+            }
+        }
+
+        if( (SafeSecureReceiveMsg_Success != SafeSecure_DecryptCcm( 0x0002, mSent, mSentLen )) ||
+            memcmp( &mSent[SAFESECURE_CCM_HEADER_LEN], data, len ) )
+        {
+            printf( "CCM: length %u not decrypted back\n", len );
+            return 0;
+        }
+    }
+
+    if( SafeSecureTransmitMsg_MaxSizeExceeded !=
+        SafeSecure_TransmitCcm( 0x0001, data, mBenchMaxFrame_c - SAFESECURE_CCM_OVERHEAD + 1 ) )
+    {
+        printf( "CCM: oversized frame sent\n" );
+        return 0;
+    }
+
+    return 1;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    uint8_t data[mBenchMaxFrame_c];
+    uint32_t i, n;
+    uint32_t frame;
+    benchRate_t former, current, ratio;
+    int pass = CheckFrames() && CheckCcm();
+
+    for( i = 0; i < sizeof(data); i++ )
+    {
+        data[i] = (uint8_t)(i * 7);
+    }
+
+    SafeSecure_Init( CountTx, (ptrFnc_Receive)0, sizeof(mScratch), mScratch );
+    SafeSecure_SetSource( 0x0002, 0 );
+
+    printf( "median of %u runs of %u packets, +- half the range [%%]\n\n", mBenchRuns_c, mBenchLoops_c );
+    printf( "payload  former[pkt/s]    +-  current[pkt/s]    +-  speedup    +-\n" );
+
+    for( n = 0; n < sizeof(mLengths); n++ )
+    {
+        Compare( mPathFormer_c, mLengths[n], mPathBlock_c, mLengths[n], data, &former, &current, &ratio );
+        printf( "%7u  %13.0f  %4.1f  %14.0f  %4.1f  %6.2fx  %4.1f\n", mLengths[n], former.median,
+                former.spread, current.median, current.spread, ratio.median, ratio.spread );
+    }
+
+    /* Both modes for the same frame length on air */
+    printf( "\nframe  block+crc[pkt/s]    +-  [MB/s]  ccm(mic %u)[pkt/s]    +-  [MB/s]\n", SAFESECURE_MIC_LEN );
+
+    for( frame = 16; frame <= 116; frame += 20 )
+    {
+        Compare( mPathBlock_c, frame - SAFESECURE_CRC_LEN, mPathCcm_c, frame - SAFESECURE_CCM_OVERHEAD, data,
+                 &former, &current, &ratio );
+        printf( "%5u  %16.0f  %4.1f  %6.2f  %18.0f  %4.1f  %6.2f\n", frame,
+                former.median, former.spread, former.median * (frame - SAFESECURE_CRC_LEN) / 1e6,
+                current.median, current.spread, current.median * (frame - SAFESECURE_CCM_OVERHEAD) / 1e6 );
+    }
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
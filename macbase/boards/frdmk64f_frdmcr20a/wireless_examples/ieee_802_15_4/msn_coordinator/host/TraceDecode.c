@@ -0,0 +1,402 @@
+/************************************************************************************
+* This module contains the host decoder of the event trace (Trace.h).
+*
+* It reads a dump of the ring and prints its records as a timeline: the index
+* of each record, its time from the first one and from the previous one [us],
+* the name of the event and its arguments. The dump is either the raw RAM of
+* the ring, saved by the debugger from gTraceRing or as part of a larger RAM
+* image, or the serial log of the application (a long key press once
+* connected): the lines holding only hexadecimal bytes are taken, the others
+* are skipped. The ring is found by its magic word.
+*
+* The records are printed in the order of their index, from the oldest one
+* still in the ring. A record whose tag does not carry the sequence number of
+* its index was being written, or overwritten, when the ring was read, and is
+* skipped. The timestamps are unwrapped from one record to the next, so two
+* consecutive records must be less than 2^31 ticks apart.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/trace_decode
+*   trace_decode [-c <clock Hz>] [<dump file>]
+*
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "EmbeddedTypes.h"
+#include "Trace.h"
+#include "PhyInterface.h"
+#include "ieee802p15p4_wrapper.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mDecodeMaxInput_c       (16 * 1024 * 1024)
+#define mDecodeHeaderWords_c    (4)
+
+/* Arguments printed in hexadecimal */
+#define mArg0Hex_c              (1 << 0)
+#define mArg1Hex_c              (1 << 1)
+/* The first argument is a MAC message type */
+#define mArg0MsgType_c          (1 << 2)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct
+{
+    uint16_t id;
+    const char *pName;
+    const char *pArg0;          /* NULL if not used */
+    const char *pArg1;
+    uint8_t format;
+} eventInfo_t;
+
+typedef struct
+{
+    uint8_t type;
+    const char *pName;
+} msgInfo_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static const eventInfo_t mEvents[] =
+{
+    { gTracePhyIsr_c,         "PHY ISR",          "irqsts", "ctrl1",     mArg0Hex_c | mArg1Hex_c },
+    { gTracePhyDataReq_c,     "PHY data req",     "inst",   "len",       0 },
+    { gTracePhyDataCnf_c,     "PHY data cnf",     "inst",   "fp",        0 },
+    { gTracePhyDataInd_c,     "PHY data ind",     "inst",   "len",       0 },
+    { gTracePhyCcaCnf_c,      "PHY CCA cnf",      "inst",   "status",    mArg1Hex_c },
+    { gTracePhyRxTimeout_c,   "PHY RX timeout",   "inst",   "flags",     mArg1Hex_c },
+    { gTracePhySyncLoss_c,    "PHY sync loss",    "inst",   NULL,        0 },
+    { gTracePhyFilterFail_c,  "PHY filter fail",  "inst",   "flags",     mArg1Hex_c },
+    { gTracePhyXcvrReset_c,   "PHY xcvr reset",   "inst",   NULL,        0 },
+    { gTraceMacMlmeSap_c,     "MLME SAP",         "msg",    "inst",      mArg0MsgType_c },
+    { gTraceMacMcpsSap_c,     "MCPS SAP",         "msg",    "arg",       mArg0MsgType_c | mArg1Hex_c },
+    { gTraceMwTaskWakeup_c,   "mac task wakeup",  "events", "inst",      mArg0Hex_c },
+    { gTraceMwTxQueued_c,     "TX queued",        "handle", "len",       mArg0Hex_c },
+    { gTraceMwTxHandOver_c,   "TX hand-off",      "handle", "in MAC",    mArg0Hex_c },
+    { gTraceMwTxComplete_c,   "TX complete",      "handle", "status",    mArg0Hex_c | mArg1Hex_c },
+    { gTraceMwRxDeliver_c,    "RX deliver",       "src",    "len",       mArg0Hex_c },
+    { gTraceMwRxDuplicate_c,  "RX duplicate",     "src",    "dsn",       mArg0Hex_c },
+};
+
+static const msgInfo_t mMessages[] =
+{
+    { gMcpsDataCnf_c,         "DataCnf" },
+    { gMcpsDataInd_c,         "DataInd" },
+    { gMcpsPurgeCnf_c,        "PurgeCnf" },
+    { gMcpsPromInd_c,         "PromInd" },
+    { gMlmeAssociateInd_c,    "AssociateInd" },
+    { gMlmeAssociateCnf_c,    "AssociateCnf" },
+    { gMlmeDisassociateInd_c, "DisassociateInd" },
+    { gMlmeDisassociateCnf_c, "DisassociateCnf" },
+    { gMlmeBeaconNotifyInd_c, "BeaconNotifyInd" },
+    { gMlmeOrphanInd_c,       "OrphanInd" },
+    { gMlmeScanCnf_c,         "ScanCnf" },
+    { gMlmeCommStatusInd_c,   "CommStatusInd" },
+    { gMlmeStartCnf_c,        "StartCnf" },
+    { gMlmeSyncLossInd_c,     "SyncLossInd" },
+    { gMlmePollCnf_c,         "PollCnf" },
+    { gMlmePollNotifyInd_c,   "PollNotifyInd" },
+};
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The ReadInput() function reads the whole dump. It returns the number of
+ * bytes read into the buffer allocated for it, 0 on error.
+ ******************************************************************************/
+static size_t ReadInput( FILE *pFile, uint8_t **ppData )
+{
+    uint8_t *pData = malloc( mDecodeMaxInput_c );
+    size_t length;
+
+    if( NULL == pData )
+    {
+        return 0;
+    }
+    length = fread( pData, 1, mDecodeMaxInput_c, pFile );
+    *ppData = pData;
+    return length;
+}
+
+/******************************************************************************
+ * The IsText() function returns TRUE if the input is a serial log rather
+ * than a binary dump.
+ ******************************************************************************/
+static bool_t IsText( const uint8_t *pData, size_t length )
+{
+    size_t i;
+
+    for( i = 0; i < length; i++ )
+    {
+        if( !isprint( pData[i] ) && !isspace( pData[i] ) )
+        {
+            return FALSE;
+        }
+    }
+    return (length > 0);
+}
+
+/******************************************************************************
+ * The ParseText() function replaces a serial log, in place, by the bytes of
+ * its lines that hold nothing but hexadecimal bytes. It returns their number.
+ ******************************************************************************/
+static size_t ParseText( uint8_t *pData, size_t length )
+{
+    size_t out = 0;
+    size_t start = 0;
+    size_t end;
+    size_t i;
+    size_t digits;
+    bool_t hexLine;
+    unsigned int value;
+
+    while( start < length )
+    {
+        for( end = start; (end < length) && (pData[end] != '\n'); end++ )
+        {
+        }
+
+        hexLine = TRUE;
+        digits = 0;
+        for( i = start; i < end; i++ )
+        {
+            if( isxdigit( pData[i] ) )
+            {
+                digits++;
+            }
+            else if( !isspace( pData[i] ) )
+            {
+                hexLine = FALSE;
+                break;
+            }
+        }
+
+        if( hexLine && digits && !(digits & 1) )
+        {
+            for( i = start; i < end; )
+            {
+                if( isspace( pData[i] ) )
+                {
+                    i++;
+                    continue;
+                }
+                (void)sscanf( (const char *)&pData[i], "%2x", &value );
+                /* The output never overtakes the line being read */
+                pData[out++] = (uint8_t)value;
+                i += 2;
+            }
+        }
+        start = end + 1;
+    }
+    return out;
+}
+
+/******************************************************************************
+ * The ReadWord() function reads a little endian word of the dump.
+ ******************************************************************************/
+static uint32_t ReadWord( const uint8_t *pData )
+{
+    return pData[0] | (pData[1] << 8) | (pData[2] << 16) | ((uint32_t)pData[3] << 24);
+}
+
+/******************************************************************************
+ * The FindRing() function returns the offset of the first complete ring of
+ * the dump, or -1.
+ ******************************************************************************/
+static long FindRing( const uint8_t *pData, size_t length )
+{
+    size_t offset;
+    uint32_t size;
+
+    for( offset = 0; offset + mDecodeHeaderWords_c * 4 <= length; offset += 4 )
+    {
+        if( ReadWord( &pData[offset] ) != gTraceMagic_c )
+        {
+            continue;
+        }
+        size = ReadWord( &pData[offset + 4] );
+        if( (size >= 2) && (size <= 32768) && !(size & (size - 1)) &&
+            (offset + mDecodeHeaderWords_c * 4 + (size_t)size * sizeof(traceRecord_t) <= length) )
+        {
+            return (long)offset;
+        }
+    }
+    return -1;
+}
+
+/******************************************************************************
+ * The PrintArg() function prints one argument of an event.
+ ******************************************************************************/
+static void PrintArg( const char *pName, uint32_t value, bool_t hex, bool_t msgType )
+{
+    uint32_t i;
+
+    if( NULL == pName )
+    {
+        return;
+    }
+    if( msgType )
+    {
+        for( i = 0; i < sizeof(mMessages) / sizeof(mMessages[0]); i++ )
+        {
+            if( mMessages[i].type == value )
+            {
+                printf( "  %s=%s", pName, mMessages[i].pName );
+                return;
+            }
+        }
+    }
+    if( hex )
+    {
+        printf( "  %s=0x%X", pName, value );
+    }
+    else
+    {
+        printf( "  %s=%u", pName, value );
+    }
+}
+
+/******************************************************************************
+ * The PrintRecord() function prints one line of the timeline.
+ ******************************************************************************/
+static void PrintRecord( uint32_t index, double time, double delta, const traceRecord_t *pRecord )
+{
+    uint16_t id = gTraceTagId_c( pRecord->tag );
+    const eventInfo_t *pInfo = NULL;
+    uint32_t i;
+
+    for( i = 0; i < sizeof(mEvents) / sizeof(mEvents[0]); i++ )
+    {
+        if( mEvents[i].id == id )
+        {
+            pInfo = &mEvents[i];
+            break;
+        }
+    }
+
+    printf( "%8u %14.3f %12.3f  ", index, time, delta );
+    if( NULL == pInfo )
+    {
+        printf( "event 0x%04X       arg0=0x%X  arg1=0x%X\n", id, pRecord->arg0, pRecord->arg1 );
+        return;
+    }
+    printf( "%-18s", pInfo->pName );
+    PrintArg( pInfo->pArg0, pRecord->arg0, pInfo->format & mArg0Hex_c, pInfo->format & mArg0MsgType_c );
+    PrintArg( pInfo->pArg1, pRecord->arg1, pInfo->format & mArg1Hex_c, FALSE );
+    printf( "\n" );
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( int argc, char *argv[] )
+{
+    const uint8_t *pRing;
+    traceRecord_t record;
+    uint8_t *pData = NULL;
+    FILE *pFile = stdin;
+    size_t length;
+    long offset;
+    uint32_t clockHz = 0;
+    uint32_t size;
+    uint32_t head;
+    uint32_t first;
+    uint32_t index;
+    uint32_t decoded = 0;
+    uint32_t skipped = 0;
+    uint32_t lastStamp = 0;
+    int64_t ticks = 0;
+    double time;
+    double previous = 0.0;
+    int arg;
+
+    for( arg = 1; arg < argc; arg++ )
+    {
+        if( !strcmp( argv[arg], "-c" ) && (arg + 1 < argc) )
+        {
+            clockHz = (uint32_t)strtoul( argv[++arg], NULL, 0 );
+        }
+        else if( NULL == (pFile = fopen( argv[arg], "rb" )) )
+        {
+            printf( "cannot open %s\n", argv[arg] );
+            return 1;
+        }
+    }
+
+    length = ReadInput( pFile, &pData );
+    if( IsText( pData, length ) )
+    {
+        length = ParseText( pData, length );
+    }
+
+    offset = FindRing( pData, length );
+    if( offset < 0 )
+    {
+        printf( "no trace ring in the input\n" );
+        return 1;
+    }
+
+    pRing = &pData[offset];
+    size = ReadWord( &pRing[4] );
+    if( 0 == clockHz )
+    {
+        clockHz = ReadWord( &pRing[8] );
+    }
+    if( 0 == clockHz )
+    {
+        clockHz = 1000000;
+    }
+    head = ReadWord( &pRing[12] );
+    first = (head > size) ? head - size : 0;
+
+    printf( "ring at offset %ld: %u records, head %u, %u Hz, %u records lost before the first\n",
+            offset, size, head, clockHz, first );
+    printf( "   index      time [us]   delta [us]  event\n" );
+
+    for( index = first; index != head; index++ )
+    {
+        memcpy( &record, &pRing[mDecodeHeaderWords_c * 4 + (index & (size - 1)) * sizeof(traceRecord_t)],
+                sizeof(record) );
+
+        /* Incomplete: the tag is written last, with the sequence number */
+        if( (0 == gTraceTagId_c( record.tag )) || (gTraceTagSeq_c( record.tag ) != (uint16_t)index) )
+        {
+            skipped++;
+            continue;
+        }
+
+        /* A record stamped before the previous one, by an ISR that interrupted
+         * its writer, gives a small negative delta */
+        if( decoded )
+        {
+            ticks += (int32_t)(record.timestamp - lastStamp);
+        }
+        lastStamp = record.timestamp;
+        time = (double)ticks * 1000000.0 / clockHz;
+        PrintRecord( index, time, decoded ? time - previous : 0.0, &record );
+        previous = time;
+        decoded++;
+    }
+
+    printf( "%u records decoded, %u incomplete skipped\n", decoded, skipped );
+    free( pData );
+    return 0;
+}
@@ -0,0 +1,322 @@
+/************************************************************************************
+* This module contains a host test of the event trace.
+*
+* First the trace alone: several threads fill the ring at the same time, a
+* number of rounds, and the test checks that no index was given out twice or
+* lost, that every record is complete and that the records of each thread are
+* in the order they were written. It prints how often the threads took turns
+* in the ring, and the time of a write. Then the
+* wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator, and sends a few
+* bursts of frames. The test checks that the trace holds, for every frame,
+* the queueing, the hand-off to the MAC, the confirm at the MCPS SAP and the
+* completion, in that order, and writes the ring to a file (trace_dump.bin or
+* the file given) for TraceDecode.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/trace_test build/trace_decode
+*   cd build; ./trace_test; ./trace_decode trace_dump.bin
+*
+************************************************************************************/
+#include <stdio.h>
+#include <pthread.h>
+#include <time.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "TimersManager.h"
+#include "Trace.h"
+#include "ieee802p15p4_wrapper.h"
+#include "MacHost.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+#if !gTraceEnabled_d
+#error "Build the trace test with -DgTraceEnabled_d=1"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+/* Writers of the module test, and the records each one writes per round: the
+ * ring is full at the end of a round */
+#define mTestThreads_c          (4)
+#define mTestWrites_c           (gTraceSize_c / mTestThreads_c)
+#define mTestRounds_c           (100)
+#define mTestEvent_c            gTraceId_c(gTraceGroupApp_c, 0x01)
+
+/* Writes timed by a single thread */
+#define mTestTimedWrites_c      (10000000)
+
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Traffic: mTestBursts_c bursts of mTestBurst_c frames, mTestInterval_c ms apart.
+ * The ring keeps all of them. */
+#define mTestBursts_c           (4)
+#define mTestBurst_c            (3)
+#define mTestInterval_c         (50)
+#define mTestPayload_c          (20)
+
+/* Steps of a frame in the trace */
+#define mStepQueued_c           (1 << 0)
+#define mStepHandOver_c         (1 << 1)
+#define mStepConfirm_c          (1 << 2)
+#define mStepComplete_c         (1 << 3)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint32_t mConfirms;
+/* Steps of the frames with each MSDU handle, and of the handles out of order */
+static uint8_t  mSteps[256];
+static uint32_t mOutOfOrder;
+static FILE     *mpDumpFile;
+static pthread_barrier_t mStart;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The Writer() function is a thread of the module test: it writes its
+ * records, numbered from 0.
+ ******************************************************************************/
+static void *Writer( void *param )
+{
+    uint32_t thread = (uint32_t)(uintptr_t)param;
+    uint32_t i;
+
+    (void)pthread_barrier_wait( &mStart );
+    for( i = 0; i < mTestWrites_c; i++ )
+    {
+        Trace_Write( mTestEvent_c, thread, i );
+    }
+    return NULL;
+}
+
+/******************************************************************************
+ * The CheckModule() function checks the trace alone. It returns TRUE if it
+ * passed.
+ ******************************************************************************/
+static bool_t CheckModule( void )
+{
+    pthread_t threads[mTestThreads_c];
+    uint32_t last[mTestThreads_c];
+    uint32_t count[mTestThreads_c];
+    struct timespec start, end;
+    traceRecord_t *pRecord;
+    uint32_t previous;
+    uint32_t turns = 0;
+    uint32_t round;
+    uint32_t index;
+    uint32_t i;
+    double ns;
+    bool_t pass = TRUE;
+
+    (void)pthread_barrier_init( &mStart, NULL, mTestThreads_c );
+    for( round = 0; pass && (round < mTestRounds_c); round++ )
+    {
+        Trace_Init();
+        for( i = 0; i < mTestThreads_c; i++ )
+        {
+            last[i] = 0xFFFFFFFF;
+            count[i] = 0;
+            (void)pthread_create( &threads[i], NULL, Writer, (void *)(uintptr_t)i );
+        }
+        for( i = 0; i < mTestThreads_c; i++ )
+        {
+            (void)pthread_join( threads[i], NULL );
+        }
+
+        /* Every index given out once: the ring is full, every record is
+         * complete, and each thread has all of its records, in order */
+        pass = (gTraceRing.magic == gTraceMagic_c) && (gTraceRing.size == gTraceSize_c) &&
+               (gTraceRing.head == mTestThreads_c * mTestWrites_c);
+        previous = mTestThreads_c;
+        for( index = 0; pass && (index < gTraceRing.head); index++ )
+        {
+            pRecord = &gTraceRing.records[index];
+            pass = (gTraceTagSeq_c( pRecord->tag ) == (uint16_t)index) &&
+                   (gTraceTagId_c( pRecord->tag ) == mTestEvent_c) && (pRecord->arg0 < mTestThreads_c);
+            if( pass )
+            {
+                pass = (pRecord->arg1 == last[pRecord->arg0] + 1);
+                last[pRecord->arg0] = pRecord->arg1;
+                count[pRecord->arg0]++;
+                turns += (previous != pRecord->arg0);
+                previous = pRecord->arg0;
+            }
+        }
+        for( i = 0; pass && (i < mTestThreads_c); i++ )
+        {
+            pass = (count[i] == mTestWrites_c);
+        }
+    }
+    (void)pthread_barrier_destroy( &mStart );
+
+    /* Stopped, nothing is written */
+    index = gTraceRing.head;
+    Trace_Enable( FALSE );
+    Trace_Write( mTestEvent_c, 0, 0 );
+    pass = pass && (gTraceRing.head == index);
+    Trace_Enable( TRUE );
+
+    clock_gettime( CLOCK_MONOTONIC, &start );
+    for( i = 0; i < mTestTimedWrites_c; i++ )
+    {
+        Trace_Write( mTestEvent_c, i, 0 );
+    }
+    clock_gettime( CLOCK_MONOTONIC, &end );
+    ns = ((end.tv_sec - start.tv_sec) * 1e9 + (end.tv_nsec - start.tv_nsec)) / mTestTimedWrites_c;
+
+    printf( "trace: %u rounds of %u threads x %u writes, %u turns between the threads; %.1f ns per write\n",
+            round, mTestThreads_c, mTestWrites_c, turns, ns );
+    printf( "trace module: %s\n", pass ? "ok" : "FAILED" );
+    return pass;
+}
+
+/******************************************************************************
+ * The TxConfirm() function is the completion callback of the frames.
+ ******************************************************************************/
+static void TxConfirm( resultType_t status, void *context )
+{
+    (void)status;
+    (void)context;
+
+    mConfirms++;
+}
+
+/******************************************************************************
+ * The Step() function records a step of the frame of an MSDU handle, and
+ * counts it as out of order unless the steps before it were seen.
+ ******************************************************************************/
+static void Step( uint8_t handle, uint8_t step )
+{
+    if( mSteps[handle] != (uint8_t)(step - 1) )
+    {
+        mOutOfOrder++;
+    }
+    mSteps[handle] |= step;
+}
+
+/******************************************************************************
+ * The DumpWrite() function is the output of Trace_Dump().
+ ******************************************************************************/
+static void DumpWrite( const uint8_t *pData, uint32_t length )
+{
+    (void)fwrite( pData, 1, length, mpDumpFile );
+}
+
+/******************************************************************************
+ * The CheckWrapper() function sends the traffic and checks its trace. It
+ * returns TRUE if it passed.
+ ******************************************************************************/
+static bool_t CheckWrapper( const char *pDumpName )
+{
+    uint8_t payload[mTestPayload_c] = { 0 };
+    traceRecord_t *pRecord;
+    uint32_t first;
+    uint32_t index;
+    uint32_t frames = 0;
+    uint32_t wakeups = 0;
+    uint32_t sent = 0;
+    uint32_t i, j;
+    bool_t pass;
+
+    /* Only the traffic in the ring */
+    Trace_Init();
+    for( i = 0; i < mTestBursts_c; i++ )
+    {
+        for( j = 0; j < mTestBurst_c; j++ )
+        {
+            if( mwErrorNoError == mac_transmit_async( 0x0000, payload, sizeof(payload), TxConfirm, NULL ) )
+            {
+                sent++;
+            }
+        }
+        NetSim_Run( mTestInterval_c );
+    }
+    NetSim_Run( 1000 );
+
+    first = (gTraceRing.head > gTraceSize_c) ? gTraceRing.head - gTraceSize_c : 0;
+    for( index = first; index != gTraceRing.head; index++ )
+    {
+        pRecord = &gTraceRing.records[index & (gTraceSize_c - 1)];
+        switch( gTraceTagId_c( pRecord->tag ) )
+        {
+        case gTraceMwTxQueued_c:
+            mSteps[(uint8_t)pRecord->arg0] = 0;
+            Step( (uint8_t)pRecord->arg0, mStepQueued_c );
+            break;
+        case gTraceMwTxHandOver_c:
+            Step( (uint8_t)pRecord->arg0, mStepHandOver_c );
+            break;
+        case gTraceMacMcpsSap_c:
+            if( gMcpsDataCnf_c == pRecord->arg0 )
+            {
+                Step( (uint8_t)pRecord->arg1, mStepConfirm_c );
+            }
+            break;
+        case gTraceMwTxComplete_c:
+            Step( (uint8_t)pRecord->arg0, mStepComplete_c );
+            frames++;
+            break;
+        case gTraceMwTaskWakeup_c:
+            wakeups++;
+            break;
+        default:
+            break;
+        }
+    }
+
+    printf( "wrapper: %u frames sent, %u confirmed, %u completed in the trace, %u out of order, "
+            "%u mac task wakeups, %u records\n", sent, mConfirms, frames, mOutOfOrder, wakeups,
+            gTraceRing.head - first );
+
+    pass = (sent == mTestBursts_c * mTestBurst_c) && (mConfirms == sent) && (frames == sent) &&
+           (0 == mOutOfOrder) && (wakeups > 0) && (first == 0);
+
+    mpDumpFile = fopen( pDumpName, "wb" );
+    if( NULL != mpDumpFile )
+    {
+        (void)Trace_Dump( DumpWrite );
+        fclose( mpDumpFile );
+        printf( "ring written to %s\n", pDumpName );
+    }
+    else
+    {
+        pass = FALSE;
+    }
+
+    printf( "wrapper trace: %s\n", pass ? "ok" : "FAILED" );
+    return pass;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( int argc, char *argv[] )
+{
+    bool_t pass;
+
+    pass = CheckModule();
+
+    if( gNetSimInvalidNode_c == WrapperHost_Connect( mTestPanId_c, mTestChannel_c, NULL ) )
+    {
+        return 1;
+    }
+
+    pass = CheckWrapper( (argc > 1) ? argv[1] : "trace_dump.bin" ) && pass;
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
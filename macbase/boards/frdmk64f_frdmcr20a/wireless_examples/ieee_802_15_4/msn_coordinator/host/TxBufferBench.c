@@ -0,0 +1,224 @@
+/************************************************************************************
+* This module contains a host benchmark of the zero-copy transmit API.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator. Batches of frames that
+* fill the normal priority class of the transmit queue are queued in two ways:
+*   - mac_transmit(): the frame is built in a buffer of the caller, and the
+*     wrapper copies it into the MCPS-DATA.request;
+*   - mac_tx_buffer_get()/mac_tx_buffer_commit(): the frame is built in place,
+*     in the MCPS-DATA.request.
+* The two alternate batch by batch, and each batch is sent before the next one
+* is queued. The benchmark prints the cycles per frame of each way, from the
+* first byte of the frame written to the request queued for the mac task, for
+* a few payload lengths. The hand-off to the MAC by the mac task is the same for
+* both and is not measured.
+* The cycles are the time stamp counter on x86, the ns elsewhere.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/tx_buffer_bench
+*
+************************************************************************************/
+#include <stdio.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "ieee802p15p4_wrapper.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mBenchPanId_c           (0x1234)
+#define mBenchChannel_c         (15)
+
+/* Time [ms] after which a batch is reported as failed */
+#define mBenchTimeout_c         (30000)
+#define mBenchStep_c            (10)
+
+/* Batches of each way and payload length, each one of the normal priority
+ * slots of the queue */
+#define mBenchBatches_c         (200)
+#define mBenchBatch_c           (mwMaxPendingTx_c - mwTxHighReservedSlots_c)
+
+#if defined(__x86_64__) || defined(__i386__)
+#define mBenchUnit_c            "cycles"
+#else
+#define mBenchUnit_c            "ns"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint32_t mConfirms;
+
+/* Payload lengths measured */
+static const uint8_t mLengths[] = { 16, 64, mwMaxPayload_c };
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The Cycles() function returns the cycle counter, or the ns where there is
+ * none. Only differences are used, modulo 2^32.
+ ******************************************************************************/
+static uint32_t Cycles( void )
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return (uint32_t)__rdtsc();
+#else
+    struct timespec ts;
+
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (uint32_t)((uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec);
+#endif
+}
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the benchmark.
+ * It counts the confirms.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+
+    if( mac_management_event_c == pEvent->mac_event_type )
+    {
+        return;
+    }
+
+    if( gMcpsDataCnf_c == pEvent->evt_data.data_event_data->msgType )
+    {
+        mConfirms++;
+    }
+}
+
+/******************************************************************************
+ * The Build() function writes a frame of the benchmark, as an application
+ * would build it, into pFrame.
+ ******************************************************************************/
+static void Build( uint8_t *pFrame, uint8_t length, uint32_t seq )
+{
+    uint8_t i;
+
+    for( i = 0; i < length; i++ )
+    {
+        pFrame[i] = (uint8_t)(seq + i);
+    }
+}
+
+/******************************************************************************
+ * The QueueBatch() function queues a batch of frames, in place if zeroCopy is
+ * set, and returns the cycles it took, or 0 if a frame was refused.
+ ******************************************************************************/
+static uint32_t QueueBatch( uint8_t length, bool_t zeroCopy )
+{
+    uint8_t frame[mwMaxPayload_c];
+    uint8_t *pBuffer;
+    uint32_t start;
+    uint32_t cycles;
+    uint32_t i;
+    bool_t ok = TRUE;
+
+    start = Cycles();
+    for( i = 0; i < mBenchBatch_c; i++ )
+    {
+        if( zeroCopy )
+        {
+            pBuffer = mac_tx_buffer_get( 0x0000, length );
+            if( NULL == pBuffer )
+            {
+                ok = FALSE;
+                break;
+            }
+            Build( pBuffer, length, i );
+            ok = (mwErrorNoError == mac_tx_buffer_commit( pBuffer, length ));
+        }
+        else
+        {
+            Build( frame, length, i );
+            ok = (mwErrorNoError == mac_transmit( 0x0000, frame, length ));
+        }
+        if( !ok )
+        {
+            break;
+        }
+    }
+    cycles = Cycles() - start;
+
+    return ok ? cycles : 0;
+}
+
+/******************************************************************************
+ * The Send() function lets the queued frames go and returns TRUE once they
+ * are all confirmed.
+ ******************************************************************************/
+static bool_t Send( void )
+{
+    uint32_t start = OSA_TimeGetMsec();
+
+    while( (mConfirms < mBenchBatch_c) && (OSA_TimeGetMsec() - start < mBenchTimeout_c) )
+    {
+        NetSim_Run( mBenchStep_c );
+    }
+
+    return (mConfirms == mBenchBatch_c);
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    uint64_t total[2];
+    uint32_t cycles;
+    uint32_t batch;
+    uint32_t i;
+    uint8_t way;
+
+    if( gNetSimInvalidNode_c == WrapperHost_Connect( mBenchPanId_c, mBenchChannel_c, EventHandler ) )
+    {
+        return 1;
+    }
+
+    printf( "%u batches of %u frames each way, " mBenchUnit_c " per frame\n\n", mBenchBatches_c, mBenchBatch_c );
+    printf( "payload  mac_transmit  get/commit  saved\n" );
+
+    for( i = 0; i < sizeof(mLengths); i++ )
+    {
+        total[0] = 0;
+        total[1] = 0;
+        for( batch = 0; batch < 2 * mBenchBatches_c; batch++ )
+        {
+            way = (uint8_t)(batch & 1);
+            mConfirms = 0;
+            cycles = QueueBatch( mLengths[i], way );
+            if( (0 == cycles) || !Send() )
+            {
+                printf( "batch %u of %u bytes FAILED\n", batch, mLengths[i] );
+                return 1;
+            }
+            total[way] += cycles;
+        }
+        printf( "%7u  %12.1f  %10.1f  %4.1f%%\n", mLengths[i],
+                (double)total[0] / (mBenchBatches_c * mBenchBatch_c),
+                (double)total[1] / (mBenchBatches_c * mBenchBatch_c),
+                100.0 * ((double)total[0] - (double)total[1]) / (double)total[0] );
+    }
+
+    return 0;
+}
@@ -0,0 +1,415 @@
+/************************************************************************************
+* This module contains a host test of the transmit bursts.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator. Numbered frames are
+* queued with mac_transmit() and mac_transmit_priority() until the queue is full.
+*
+* tx_burst_test: the MAC has room for the mwMaxInFlightTx_c requests the wrapper
+* hands over (gMacHostMaxPendingTx_c), and the mac task takes
+* mTestWakeupLatency_c to run once an event is set, as it would behind the other
+* tasks of the target. The same frames are sent:
+*   - queued: mTestBursts_c bursts, each one as many frames as the queue takes,
+*     so the MAC holds the next request when one is confirmed;
+*   - one at a time: each frame queued from the completion callback of the one
+*     before, the single request path of the wrapper before the MAC kept
+*     several of them.
+* The test prints the frames per second of both and checks that the queued
+* bursts are faster.
+*
+* tx_burst_test_1: the MAC has room for a single data request, less than the
+* requests the wrapper hands over, so it rejects some of them:
+*   - burst: normal priority only, the MAC takes them one after the other;
+*   - rejected: both classes, the MAC refuses the second request in flight;
+*   - again: normal priority only, once the rejected requests are gone.
+* The test checks that the queue takes exactly the slots of each class before
+* it is full.
+*
+* Both check that every accepted request gets one MCPS-DATA.confirm, rejected
+* ones included, that the coordinator receives the frames confirmed successfully,
+* and that the frames of each class arrive in the order they were queued.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/tx_burst_test build/tx_burst_test_1
+*
+************************************************************************************/
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "FunctionLib.h"
+#include "ieee802p15p4_wrapper.h"
+#include "MacHost.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Time [ms] after which a burst is reported as failed */
+#define mTestTimeout_c          (30000)
+#define mTestStep_c             (10)
+
+#define mTestPayload_c          (20)
+
+/* The MAC rejects some of the requests handed to it */
+#define mTestMacFull_d          (gMacHostMaxPendingTx_c < mwMaxInFlightTx_c)
+
+/* Throughput: bursts of a full queue, and the wakeup latency [ms] of the tasks */
+#define mTestBursts_c           (20)
+#define mTestWakeupLatency_c    (2)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+/* Results of a burst */
+typedef struct testBurst_tag
+{
+    uint32_t accepted[mac_tx_priority_max_c];
+    uint32_t confirmed;
+    uint32_t success;
+    uint32_t rejected;
+    uint32_t failed;
+    uint32_t received;
+    uint32_t outOfOrder;
+} testBurst_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+#if !mTestMacFull_d
+static void SendNext( resultType_t status, void *context );
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint8_t  mCoordNode;
+static uint32_t mSeq;
+/* Last number received in each class, 0: none yet */
+static uint32_t mLastSeq[mac_tx_priority_max_c];
+static testBurst_t *mpBurst;
+#if !mTestMacFull_d
+/* Frames left to send one at a time */
+static uint32_t mOneLeft;
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The CountConfirm() function counts an MCPS-DATA.confirm of the burst by
+ * status.
+ ******************************************************************************/
+static void CountConfirm( resultType_t status )
+{
+    if( NULL == mpBurst )
+    {
+        return;
+    }
+
+    mpBurst->confirmed++;
+    if( gSuccess_c == status )
+    {
+        mpBurst->success++;
+    }
+    else if( gTransactionOverflow_c == status )
+    {
+        mpBurst->rejected++;
+    }
+    else
+    {
+        mpBurst->failed++;
+    }
+}
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the test. It
+ * gets the confirms of the frames queued with mac_transmit().
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+
+    if( (mac_data_event_c == pEvent->mac_event_type) &&
+        (gMcpsDataCnf_c == pEvent->evt_data.data_event_data->msgType) )
+    {
+        CountConfirm( pEvent->evt_data.data_event_data->msgData.dataCnf.status );
+    }
+}
+
+/******************************************************************************
+ * The DataHook() function checks the order of the frames the coordinator
+ * receives, class by class. The number and the class end the payload.
+ ******************************************************************************/
+static void DataHook( uint8_t node, mcpsDataInd_t *pInd )
+{
+    uint32_t seq;
+    uint8_t priority;
+
+    if( (node != mCoordNode) || (NULL == mpBurst) || (pInd->msduLength < sizeof(seq) + 1) )
+    {
+        return;
+    }
+
+    FLib_MemCpy( &seq, &pInd->pMsdu[pInd->msduLength - sizeof(seq) - 1], sizeof(seq) );
+    priority = pInd->pMsdu[pInd->msduLength - 1];
+    if( priority >= mac_tx_priority_max_c )
+    {
+        return;
+    }
+
+    if( seq <= mLastSeq[priority] )
+    {
+        mpBurst->outOfOrder++;
+    }
+    mLastSeq[priority] = seq;
+    mpBurst->received++;
+}
+
+/******************************************************************************
+ * The NextPayload() function numbers the next frame of a class.
+ ******************************************************************************/
+static void NextPayload( uint8_t *pPayload, uint8_t priority )
+{
+    mSeq++;
+    FLib_MemCpy( &pPayload[mTestPayload_c - sizeof(mSeq) - 1], &mSeq, sizeof(mSeq) );
+    pPayload[mTestPayload_c - 1] = priority;
+}
+
+/******************************************************************************
+ * The Queue() function queues numbered frames of a class until the queue is
+ * full.
+ ******************************************************************************/
+static void Queue( testBurst_t *pBurst, uint8_t priority )
+{
+    uint8_t payload[mTestPayload_c] = { 0 };
+    int rc;
+
+    for( ;; )
+    {
+        NextPayload( payload, priority );
+        if( mac_tx_priority_normal_c == priority )
+        {
+            rc = mac_transmit( 0x0000, payload, sizeof(payload) );
+        }
+        else
+        {
+            rc = mac_transmit_priority( 0x0000, payload, sizeof(payload), priority );
+        }
+        if( mwErrorNoError != rc )
+        {
+            mSeq--;
+            break;
+        }
+        pBurst->accepted[priority]++;
+    }
+}
+
+/******************************************************************************
+ * The Complete() function lets the accepted requests of a burst complete,
+ * including the ones accepted meanwhile.
+ ******************************************************************************/
+static void Complete( testBurst_t *pBurst )
+{
+    uint32_t start = OSA_TimeGetMsec();
+
+    while( (pBurst->confirmed < pBurst->accepted[mac_tx_priority_normal_c] + pBurst->accepted[mac_tx_priority_high_c]) &&
+           (OSA_TimeGetMsec() - start < mTestTimeout_c) )
+    {
+        NetSim_Run( 1 );
+    }
+}
+
+/******************************************************************************
+ * The PrintBurst() function prints the results of a burst.
+ ******************************************************************************/
+static void PrintBurst( const char *pName, const testBurst_t *pBurst )
+{
+    printf( "%-13s  %6u  %4u  %9u  %7u  %8u  %6u  %8u  %12u\n", pName, pBurst->accepted[mac_tx_priority_normal_c],
+            pBurst->accepted[mac_tx_priority_high_c], pBurst->confirmed, pBurst->success, pBurst->rejected,
+            pBurst->failed, pBurst->received, pBurst->outOfOrder );
+}
+
+/******************************************************************************
+ * The BurstDone() function returns TRUE if every accepted request of a burst
+ * was confirmed once, and the coordinator received in order the frames
+ * confirmed successfully.
+ ******************************************************************************/
+static bool_t BurstDone( const testBurst_t *pBurst )
+{
+    return (pBurst->confirmed == pBurst->accepted[mac_tx_priority_normal_c] + pBurst->accepted[mac_tx_priority_high_c]) &&
+           (pBurst->confirmed == pBurst->success + pBurst->rejected + pBurst->failed) &&
+           (pBurst->received == pBurst->success) && (0 == pBurst->outOfOrder);
+}
+
+#if mTestMacFull_d
+/******************************************************************************
+ * The RunBurst() function queues a burst, of the normal priority class and
+ * then of the high priority one if high is set, and lets it complete. It
+ * prints the results of the burst.
+ ******************************************************************************/
+static void RunBurst( const char *pName, testBurst_t *pBurst, bool_t high )
+{
+    FLib_MemSet( pBurst, 0, sizeof(testBurst_t) );
+    mpBurst = pBurst;
+
+    /* Queued at once: the mac task only runs once the clock advances */
+    Queue( pBurst, mac_tx_priority_normal_c );
+    if( high )
+    {
+        Queue( pBurst, mac_tx_priority_high_c );
+    }
+    Complete( pBurst );
+    NetSim_Run( mTestStep_c );
+
+    PrintBurst( pName, pBurst );
+}
+
+/******************************************************************************
+ * The RunTest() function runs the bursts of a MAC that rejects requests.
+ ******************************************************************************/
+static bool_t RunTest( void )
+{
+    testBurst_t burst, rejected, again;
+
+    printf( "queue of %u requests, %u kept for the high priority class; %u handed to a MAC with room for %u\n\n",
+            mwMaxPendingTx_c, mwTxHighReservedSlots_c, mwMaxInFlightTx_c, gMacHostMaxPendingTx_c );
+    printf( "burst          normal  high  confirmed  success  rejected  failed  received  out of order\n" );
+
+    RunBurst( "burst", &burst, FALSE );
+    RunBurst( "rejected", &rejected, TRUE );
+    RunBurst( "again", &again, FALSE );
+
+    return (burst.accepted[mac_tx_priority_normal_c] == mwMaxPendingTx_c - mwTxHighReservedSlots_c) &&
+           BurstDone( &burst ) && (burst.success == burst.confirmed) &&
+           (rejected.accepted[mac_tx_priority_normal_c] == mwMaxPendingTx_c - mwTxHighReservedSlots_c) &&
+           (rejected.accepted[mac_tx_priority_high_c] == mwTxHighReservedSlots_c) &&
+           BurstDone( &rejected ) && (rejected.rejected > 0) &&
+           (again.accepted[mac_tx_priority_normal_c] == mwMaxPendingTx_c - mwTxHighReservedSlots_c) &&
+           BurstDone( &again ) && (again.success == again.confirmed);
+}
+
+#else
+/******************************************************************************
+ * The SendNext() function sends the next frame sent one at a time. It is the
+ * completion callback of the one before.
+ ******************************************************************************/
+static void SendNext( resultType_t status, void *context )
+{
+    uint8_t payload[mTestPayload_c] = { 0 };
+
+    /* The first frame is sent without a confirm before it */
+    if( NULL != context )
+    {
+        CountConfirm( status );
+    }
+    if( 0 == mOneLeft )
+    {
+        return;
+    }
+
+    NextPayload( payload, mac_tx_priority_normal_c );
+    if( mwErrorNoError == mac_transmit_async( 0x0000, payload, sizeof(payload), SendNext, mpBurst ) )
+    {
+        mpBurst->accepted[mac_tx_priority_normal_c]++;
+        mOneLeft--;
+    }
+    else
+    {
+        mSeq--;
+        mOneLeft = 0;
+    }
+}
+
+/******************************************************************************
+ * The RunTest() function compares the queued bursts with the frames sent one
+ * at a time.
+ ******************************************************************************/
+static bool_t RunTest( void )
+{
+    testBurst_t queued = { { 0 } };
+    testBurst_t one = { { 0 } };
+    uint32_t queuedTime;
+    uint32_t oneTime;
+    uint32_t start;
+    uint32_t i;
+    bool_t pass;
+
+    WrapperHost_SetWakeupLatency( mTestWakeupLatency_c );
+
+    printf( "%u handed to a MAC with room for %u, mac task woken up %u ms late\n\n",
+            mwMaxInFlightTx_c, gMacHostMaxPendingTx_c, mTestWakeupLatency_c );
+    printf( "burst          normal  high  confirmed  success  rejected  failed  received  out of order\n" );
+
+    mpBurst = &queued;
+    start = OSA_TimeGetMsec();
+    for( i = 0; i < mTestBursts_c; i++ )
+    {
+        Queue( &queued, mac_tx_priority_normal_c );
+        Complete( &queued );
+    }
+    queuedTime = OSA_TimeGetMsec() - start;
+    NetSim_Run( mTestStep_c );
+    PrintBurst( "queued", &queued );
+
+    mpBurst = &one;
+    mOneLeft = queued.accepted[mac_tx_priority_normal_c];
+    start = OSA_TimeGetMsec();
+    SendNext( gSuccess_c, NULL );
+    Complete( &one );
+    oneTime = OSA_TimeGetMsec() - start;
+    NetSim_Run( mTestStep_c );
+    PrintBurst( "one at a time", &one );
+
+    queuedTime = queuedTime ? queuedTime : 1;
+    oneTime = oneTime ? oneTime : 1;
+    printf( "\nqueued: %u frames in %u ms, %.1f frames/s\n", queued.confirmed, queuedTime,
+            queued.confirmed * 1000.0 / queuedTime );
+    printf( "one at a time: %u frames in %u ms, %.1f frames/s\n", one.confirmed, oneTime,
+            one.confirmed * 1000.0 / oneTime );
+
+    pass = BurstDone( &queued ) && (queued.success == queued.confirmed) &&
+           (queued.accepted[mac_tx_priority_normal_c] == mTestBursts_c * (mwMaxPendingTx_c - mwTxHighReservedSlots_c)) &&
+           BurstDone( &one ) && (one.success == one.confirmed) &&
+           (one.accepted[mac_tx_priority_normal_c] == queued.accepted[mac_tx_priority_normal_c]) &&
+           (queuedTime < oneTime);
+    return pass;
+}
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    bool_t pass;
+
+    mCoordNode = WrapperHost_Connect( mTestPanId_c, mTestChannel_c, EventHandler );
+    if( gNetSimInvalidNode_c == mCoordNode )
+    {
+        return 1;
+    }
+    NetSim_SetDataHook( DataHook );
+
+    pass = RunTest();
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,282 @@
+/************************************************************************************
+* This module contains a host stress test of the transmit queue of the wrapper.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator. Producer tasks offer
+* far more frames than the radio can carry, each one with mac_transmit_wait():
+*   - the "forever" producers wait as long as needed for room in the queue;
+*   - the "timeout" producer gives up after a short time and tries again.
+* The test checks that:
+*   - no frame is lost: every accepted request is confirmed, and the
+*     coordinator receives as many frames as were confirmed successfully;
+*   - nobody spins: every call of a forever producer sends a frame, a timed out
+*     call waited the whole timeout, and the mac task wakes up a bounded number
+*     of times per frame;
+*   - the watermark callbacks alternate.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/tx_queue_stress
+*
+************************************************************************************/
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "ieee802p15p4_wrapper.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+#if !mwStatistics_d
+#error "Build the stress test with -DmwStatistics_d=1"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mTestPanId_c            (0x1234)
+#define mTestChannel_c          (15)
+
+/* Time [ms] after which the test is reported as failed */
+#define mTestTimeout_c          (120000)
+#define mTestStep_c             (10)
+
+/* Producers: all but the last one wait forever */
+#define mTestProducers_c        (3)
+#define mTestFramesPerTask_c    (300)
+#define mTestPayload_c          (60)
+#define mTestShortTimeout_c     (5)
+
+/* Watermarks of the transmit queue */
+#define mTestHighWatermark_c    (mwMaxPendingTx_c - 2)
+#define mTestLowWatermark_c     (mwMaxPendingTx_c / 4)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct testProducer_tag
+{
+    uint32_t timeout;           /* Given to mac_transmit_wait() */
+    uint32_t calls;
+    uint32_t sent;
+    uint32_t timeouts;
+    uint32_t shortWaits;        /* Timed out calls that returned before the timeout */
+    uint32_t errors;
+    bool_t   done;
+} testProducer_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static void Producer( osaTaskParam_t param );
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+OSA_TASK_DEFINE( Producer, OSA_PRIORITY_NORMAL, mTestProducers_c, 1024, 0 );
+
+static testProducer_t mProducers[mTestProducers_c];
+static uint32_t       mCnfSuccess;
+static uint32_t       mCnfFailed;
+static uint32_t       mOnHigh;
+static uint32_t       mOnLow;
+static bool_t         mAboveHigh;
+static uint32_t       mWatermarkErrors;
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the test.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+    mcpsToNwkMessage_t *pMsg;
+
+    if( mac_management_event_c == pEvent->mac_event_type )
+    {
+        return;
+    }
+
+    pMsg = pEvent->evt_data.data_event_data;
+    if( gMcpsDataCnf_c == pMsg->msgType )
+    {
+        if( gSuccess_c == pMsg->msgData.dataCnf.status )
+        {
+            mCnfSuccess++;
+        }
+        else
+        {
+            mCnfFailed++;
+        }
+    }
+}
+
+/******************************************************************************
+ * The OnHigh() and OnLow() functions are the watermark callbacks.
+ ******************************************************************************/
+static void OnHigh( uint8_t queued )
+{
+    if( mAboveHigh || (queued < mTestHighWatermark_c) )
+    {
+        mWatermarkErrors++;
+    }
+    mAboveHigh = TRUE;
+    mOnHigh++;
+}
+
+static void OnLow( uint8_t queued )
+{
+    if( !mAboveHigh || (queued > mTestLowWatermark_c) )
+    {
+        mWatermarkErrors++;
+    }
+    mAboveHigh = FALSE;
+    mOnLow++;
+}
+
+/******************************************************************************
+ * The Producer() function is a task that sends mTestFramesPerTask_c frames as
+ * fast as the queue lets it.
+ ******************************************************************************/
+static void Producer( osaTaskParam_t param )
+{
+    testProducer_t *pProducer = (testProducer_t*)param;
+    uint8_t payload[mTestPayload_c] = { 0 };
+    uint32_t start;
+    int rc;
+
+    while( pProducer->sent < mTestFramesPerTask_c )
+    {
+        payload[0] = (uint8_t)(pProducer - mProducers);
+        payload[1] = (uint8_t)pProducer->sent;
+
+        start = OSA_TimeGetMsec();
+        pProducer->calls++;
+        rc = mac_transmit_wait( 0x0000, payload, sizeof(payload), pProducer->timeout );
+        if( mwErrorNoError == rc )
+        {
+            pProducer->sent++;
+        }
+        else if( mwErrorTxQueueFull == rc )
+        {
+            pProducer->timeouts++;
+            if( OSA_TimeGetMsec() - start < pProducer->timeout )
+            {
+                pProducer->shortWaits++;
+            }
+        }
+        else
+        {
+            pProducer->errors++;
+            break;
+        }
+    }
+
+    pProducer->done = TRUE;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    netSimNodeStats_t coord;
+    mac_wrapper_stats_t stats;
+    uint32_t sent = 0;
+    uint32_t rxFrames;
+    uint32_t start;
+    uint8_t coordNode;
+    bool_t done = FALSE;
+    bool_t pass;
+    uint32_t i;
+
+    coordNode = WrapperHost_Connect( mTestPanId_c, mTestChannel_c, EventHandler );
+    if( gNetSimInvalidNode_c == coordNode )
+    {
+        return 1;
+    }
+
+    (void)mac_tx_set_watermarks( mTestHighWatermark_c, mTestLowWatermark_c, OnHigh, OnLow );
+    (void)mac_get_stats( &stats, TRUE );
+    NetSim_GetNodeStats( coordNode, &coord );
+    rxFrames = coord.rxFrames;
+
+    for( i = 0; i < mTestProducers_c; i++ )
+    {
+        mProducers[i].timeout = (i == mTestProducers_c - 1) ? mTestShortTimeout_c : osaWaitForever_c;
+        (void)OSA_TaskCreate( OSA_TASK( Producer ), (osaTaskParam_t)&mProducers[i] );
+    }
+
+    /* Run until every producer is done and every request is confirmed */
+    start = OSA_TimeGetMsec();
+    while( !done && (OSA_TimeGetMsec() < mTestTimeout_c) )
+    {
+        NetSim_Run( mTestStep_c );
+
+        done = TRUE;
+        sent = 0;
+        for( i = 0; i < mTestProducers_c; i++ )
+        {
+            done = done && mProducers[i].done;
+            sent += mProducers[i].sent;
+        }
+        done = done && (mCnfSuccess + mCnfFailed == sent);
+    }
+
+    NetSim_GetNodeStats( coordNode, &coord );
+    rxFrames = coord.rxFrames - rxFrames;
+    (void)mac_get_stats( &stats, FALSE );
+
+    printf( "producer  timeout[ms]  calls   sent  timeouts  short waits  errors\n" );
+    for( i = 0; i < mTestProducers_c; i++ )
+    {
+        if( osaWaitForever_c == mProducers[i].timeout )
+        {
+            printf( "%8u      forever", i );
+        }
+        else
+        {
+            printf( "%8u  %11u", i, mProducers[i].timeout );
+        }
+        printf( "  %5u  %5u  %8u  %11u  %6u\n", mProducers[i].calls, mProducers[i].sent,
+                mProducers[i].timeouts, mProducers[i].shortWaits, mProducers[i].errors );
+    }
+    printf( "\nqueue %u, in flight %u, %u frames in %u ms\n", mwMaxPendingTx_c, mwMaxInFlightTx_c,
+            sent, OSA_TimeGetMsec() - start );
+    printf( "confirmed: %u success, %u failed; coordinator received %u\n",
+            mCnfSuccess, mCnfFailed, rxFrames );
+    printf( "mac task wakeups: %u (%.2f per frame)\n", stats.wakeups,
+            sent ? (double)stats.wakeups / sent : 0.0 );
+    printf( "watermarks %u/%u: %u high, %u low, %u out of order\n", mTestHighWatermark_c,
+            mTestLowWatermark_c, mOnHigh, mOnLow, mWatermarkErrors );
+
+    pass = done && (sent == mTestProducers_c * mTestFramesPerTask_c) &&
+           (mCnfSuccess + mCnfFailed == sent) && (rxFrames == mCnfSuccess) &&
+           (mOnHigh > 0) && (mOnLow + 1 >= mOnHigh) && (0 == mWatermarkErrors) &&
+           (stats.wakeups <= 4 * sent);
+    for( i = 0; i < mTestProducers_c; i++ )
+    {
+        pass = pass && (0 == mProducers[i].errors) && (0 == mProducers[i].shortWaits);
+        if( osaWaitForever_c == mProducers[i].timeout )
+        {
+            pass = pass && (mProducers[i].calls == mProducers[i].sent);
+        }
+    }
+
+    printf( "%s\n", pass ? "PASS" : "FAIL" );
+    return pass ? 0 : 1;
+}
@@ -0,0 +1,157 @@
+/************************************************************************************
+* This module contains a host benchmark of the mac task wakeups per message.
+*
+* The wrapper runs unchanged on the host MAC, in the virtual time of the network
+* simulator, as an end device of a simulated coordinator. Every mBenchInterval_c
+* ms the coordinator sends a frame to the wrapper and the wrapper queues one for
+* the coordinator, so the mac task gets data indications and confirms. The run is
+* repeated with the task woken up later and later after its events are set
+* (WrapperHost_SetWakeupLatency()), as it would be behind busier tasks, so more
+* messages wait in the input queues at each wakeup. Every run prints the MLME and
+* MCPS messages processed and the wakeups of the mac task (mac_get_stats()).
+* The benchmark is built twice:
+*   - wakeup_bench_1: mwMaxMsgsPerWakeup_c of 1, one message per wakeup;
+*   - wakeup_bench: the default mwMaxMsgsPerWakeup_c.
+* Not part of the target build, see the Makefile of this directory:
+*
+*   make build/wakeup_bench build/wakeup_bench_1
+*
+************************************************************************************/
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "fsl_os_abstraction.h"
+#include "FunctionLib.h"
+#include "TimersManager.h"
+#include "ieee802p15p4_wrapper.h"
+#include "NetSim.h"
+#include "WrapperHost.h"
+
+#if !mwStatistics_d
+#error "Build the wakeup benchmark with -DmwStatistics_d=1"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mBenchPanId_c           (0x1234)
+#define mBenchChannel_c         (15)
+
+/* Traffic of a run: a frame each way every mBenchInterval_c ms for
+ * mBenchRunTime_c ms, then mBenchDrainTime_c ms for the last ones */
+#define mBenchInterval_c        (10)
+#define mBenchRunTime_c         (5000)
+#define mBenchDrainTime_c       (1000)
+#define mBenchPayload_c         (20)
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static uint8_t  mCoordNode;
+static uint32_t mIndications;
+static uint32_t mConfirms;
+
+/* Wakeup latencies [ms] of the runs */
+static const uint32_t mLatencies[] = { 0, 2, 5, 10, 20 };
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The EventHandler() function is the wrapper event callback of the benchmark.
+ * It counts the data indications and the confirms.
+ ******************************************************************************/
+static void EventHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+
+    if( mac_management_event_c == pEvent->mac_event_type )
+    {
+        return;
+    }
+
+    if( gMcpsDataInd_c == pEvent->evt_data.data_event_data->msgType )
+    {
+        mIndications++;
+    }
+    else if( gMcpsDataCnf_c == pEvent->evt_data.data_event_data->msgType )
+    {
+        mConfirms++;
+    }
+}
+
+/******************************************************************************
+ * The SendCallback() function is the timer callback of the traffic: a frame
+ * from the coordinator and one to it.
+ ******************************************************************************/
+static void SendCallback( void *param )
+{
+    uint8_t payload[mBenchPayload_c] = { 0 };
+
+    (void)param;
+
+    (void)NetSim_SendData( mCoordNode, WrapperHost_GetShortAddress(), payload, sizeof(payload) );
+    (void)mac_transmit( 0x0000, payload, sizeof(payload) );
+}
+
+/******************************************************************************
+ * The RunLatency() function runs the traffic with the given wakeup latency and
+ * prints the messages and the wakeups of the mac task.
+ ******************************************************************************/
+static void RunLatency( uint32_t latency, tmrTimerID_t timer )
+{
+    mac_wrapper_stats_t stats;
+    uint32_t msgs;
+
+    WrapperHost_SetWakeupLatency( latency );
+    (void)mac_get_stats( &stats, TRUE );
+    mIndications = 0;
+    mConfirms = 0;
+
+    (void)TMR_StartIntervalTimer( timer, mBenchInterval_c, SendCallback, NULL );
+    NetSim_Run( mBenchRunTime_c );
+    (void)TMR_StopTimer( timer );
+    NetSim_Run( mBenchDrainTime_c );
+
+    (void)mac_get_stats( &stats, FALSE );
+    msgs = stats.mlme_msgs + stats.mcps_msgs;
+    printf( "%12u  %11u  %8u  %8u  %7u  %17.3f\n", latency, mIndications, mConfirms, msgs,
+            stats.wakeups, msgs ? (double)stats.wakeups / msgs : 0.0 );
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( void )
+{
+    tmrTimerID_t timer;
+    uint32_t i;
+
+    mCoordNode = WrapperHost_Connect( mBenchPanId_c, mBenchChannel_c, EventHandler );
+    if( gNetSimInvalidNode_c == mCoordNode )
+    {
+        return 1;
+    }
+
+    printf( "mwMaxMsgsPerWakeup_c %u: a frame each way every %u ms for %u ms\n\n", mwMaxMsgsPerWakeup_c,
+            mBenchInterval_c, mBenchRunTime_c );
+    printf( "latency [ms]  indications  confirms  messages  wakeups  wakeups / message\n" );
+
+    timer = TMR_AllocateTimer();
+    for( i = 0; i < sizeof(mLatencies) / sizeof(mLatencies[0]); i++ )
+    {
+        RunLatency( mLatencies[i], timer );
+    }
+    WrapperHost_SetWakeupLatency( 0 );
+
+    return 0;
+}
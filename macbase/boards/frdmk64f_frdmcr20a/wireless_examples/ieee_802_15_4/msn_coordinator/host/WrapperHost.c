@@ -0,0 +1,593 @@
+/************************************************************************************
+* This module contains the host OS stand-in of the mac wrapper.
+*
+* One mutex is the CPU: the thread that holds it and whose index is in mRunning
+* is the one running, every other thread waits on its own condition variable. A
+* task gives the CPU back to the caller of WrapperHost_RunTasks() when it waits,
+* and WrapperHost_RunTasks() hands it to the next ready task, in creation order.
+* Waits with a timeout arm a TMR timer, so NetSim_Run() stops the clock at the
+* deadline and the task sees osaStatus_Timeout. The wakeup latency is armed the
+* same way: the task waiting for an event becomes ready when the timer expires.
+*
+************************************************************************************/
+#include <pthread.h>
+#include <stdio.h>
+
+#include "EmbeddedTypes.h"
+#include "TimersManager.h"
+#include "RNG_Interface.h"
+#include "PhyInterface.h"
+#include "fsl_os_abstraction.h"
+#include "ieee802p15p4_wrapper.h"
+#include "NetSim.h"
+#include "FlashHost.h"
+
+#include "WrapperHost.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+/* Value of mRunning while the main thread runs */
+#define mWrapperHostMain_c      (-1)
+
+/* Step [ms] of the simulation while WrapperHost_Connect() waits */
+#define mWrapperHostStep_c      (10)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef struct wrapperHostEvent_tag
+{
+    osaEventFlags_t flags;
+    bool_t          autoClear;
+    bool_t          used;
+} wrapperHostEvent_t;
+
+typedef struct wrapperHostSemaphore_tag
+{
+    uint32_t        count;
+    bool_t          used;
+} wrapperHostSemaphore_t;
+
+typedef struct wrapperHostTask_tag
+{
+    pthread_t               thread;
+    pthread_cond_t          cond;
+    osaTaskPtr_t            pFunc;
+    osaTaskParam_t          param;
+    /* What the task waits for: an event or a semaphore, or nothing before it starts */
+    wrapperHostEvent_t     *pEvent;
+    osaEventFlags_t         mask;
+    bool_t                  waitAll;
+    wrapperHostSemaphore_t *pSemaphore;
+    bool_t                  started;
+    bool_t                  hasDeadline;
+    uint32_t                deadline;
+    tmrTimerID_t            timer;
+    /* WrapperHost_SetWakeupLatency(): the event is set, the task runs at wakeAt */
+    bool_t                  wakePending;
+    uint32_t                wakeAt;
+    tmrTimerID_t            wakeTimer;
+} wrapperHostTask_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static void* TaskThread( void *param );
+static int32_t CurrentTask( void );
+static bool_t IsReady( wrapperHostTask_t *pTask );
+static bool_t EventReady( wrapperHostTask_t *pTask );
+static void Block( int32_t task, uint32_t millisec );
+static void DeadlineCallback( void *param );
+static void ConnectHandler( void *pData );
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static pthread_mutex_t          mCpu = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t           mMainCond = PTHREAD_COND_INITIALIZER;
+static volatile int32_t         mRunning = mWrapperHostMain_c;
+static bool_t                   mCpuTaken;
+
+static wrapperHostTask_t        mTasks[gWrapperHostMaxTasks_c];
+static uint8_t                  mTaskCount;
+static wrapperHostEvent_t       mEvents[gWrapperHostMaxEvents_c];
+static wrapperHostSemaphore_t   mSemaphores[gWrapperHostMaxSemaphores_c];
+static uint32_t                 mWakeupLatency;
+
+/* WrapperHost_Connect() */
+static void                   (*mpfConnectHandler)( void *pData );
+static bool_t                   mConnected;
+static uint16_t                 mShortAddress;
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/*! *********************************************************************************
+* \brief  Hands the CPU to every ready task until none is left.
+********************************************************************************** */
+void WrapperHost_RunTasks( void )
+{
+    bool_t ran;
+    uint8_t i;
+
+    if( !mCpuTaken )
+    {
+        pthread_mutex_lock( &mCpu );
+        mCpuTaken = TRUE;
+    }
+
+    do
+    {
+        ran = FALSE;
+        for( i = 0; i < mTaskCount; i++ )
+        {
+            if( IsReady( &mTasks[i] ) )
+            {
+                mRunning = i;
+                pthread_cond_signal( &mTasks[i].cond );
+                while( mWrapperHostMain_c != mRunning )
+                {
+                    pthread_cond_wait( &mMainCond, &mCpu );
+                }
+                ran = TRUE;
+            }
+        }
+    }
+    while( ran );
+}
+
+/*! *********************************************************************************
+* \brief  Sets the time from an OSA_EventSet() to the task waiting for it running.
+********************************************************************************** */
+void WrapperHost_SetWakeupLatency( uint32_t millisec )
+{
+    mWakeupLatency = millisec;
+}
+
+/*! *********************************************************************************
+* \brief  Starts the wrapper associated with a simulated coordinator.
+********************************************************************************** */
+uint8_t WrapperHost_Connect( uint16_t panId, uint8_t channel, void (*pfHandler)(void*) )
+{
+    uint8_t extAddress[8] = { 0x10, 0x00, 0x00, 0x00, 0x00, 0x25, 0x04, 0x00 };
+    netSimNodeCfg_t cfg = { 0 };
+    uint8_t coordNode;
+    uint32_t deadline;
+
+    FlashHost_Init();
+    NetSim_Init( 1, NULL );
+    NetSim_SetIdleHook( WrapperHost_RunTasks );
+
+    /* The wrapper node is the first MAC instance, the coordinator follows */
+    (void)mac_init( extAddress );
+
+    cfg.role = gNetSimCoordinator_c;
+    cfg.x = 5.0f;
+    cfg.panId = panId;
+    cfg.channel = channel;
+    coordNode = NetSim_AddNode( &cfg );
+    NetSim_Run( gWrapperHostCoordStartTime_c );
+
+    mpfConnectHandler = pfHandler;
+    mConnected = FALSE;
+    deadline = OSA_TimeGetMsec() + gWrapperHostConnectTimeout_c;
+    (void)mac_connect( channel, panId, ConnectHandler );
+    while( !mConnected && (OSA_TimeGetMsec() < deadline) )
+    {
+        NetSim_Run( mWrapperHostStep_c );
+    }
+    if( !mConnected )
+    {
+        printf( "association FAILED\n" );
+        return gNetSimInvalidNode_c;
+    }
+
+    return coordNode;
+}
+
+/*! *********************************************************************************
+* \brief  Returns the short address of the wrapper.
+********************************************************************************** */
+uint16_t WrapperHost_GetShortAddress( void )
+{
+    return mShortAddress;
+}
+
+/*! *********************************************************************************
+* \brief  Creates a task. It starts at the next WrapperHost_RunTasks().
+********************************************************************************** */
+osaTaskId_t OSA_TaskCreate( osaThreadDef_t *thread_def, osaTaskParam_t task_param )
+{
+    wrapperHostTask_t *pTask;
+
+    if( mTaskCount >= gWrapperHostMaxTasks_c )
+    {
+        return NULL;
+    }
+
+    if( !mCpuTaken )
+    {
+        pthread_mutex_lock( &mCpu );
+        mCpuTaken = TRUE;
+    }
+
+    pTask = &mTasks[mTaskCount];
+    pTask->pFunc = thread_def->pthread;
+    pTask->param = task_param;
+    pTask->timer = gTmrInvalidTimerID_c;
+    pTask->wakeTimer = gTmrInvalidTimerID_c;
+    pthread_cond_init( &pTask->cond, NULL );
+    if( 0 != pthread_create( &pTask->thread, NULL, TaskThread, (void*)(uintptr_t)mTaskCount ) )
+    {
+        return NULL;
+    }
+
+    mTaskCount++;
+    return (osaTaskId_t)pTask;
+}
+
+osaEventId_t OSA_EventCreate( bool_t autoClear )
+{
+    uint8_t i;
+
+    for( i = 0; i < gWrapperHostMaxEvents_c; i++ )
+    {
+        if( !mEvents[i].used )
+        {
+            mEvents[i].used = TRUE;
+            mEvents[i].flags = 0;
+            mEvents[i].autoClear = autoClear;
+            return (osaEventId_t)&mEvents[i];
+        }
+    }
+
+    return NULL;
+}
+
+osaStatus_t OSA_EventSet( osaEventId_t eventId, osaEventFlags_t flagsToSet )
+{
+    wrapperHostTask_t *pTask;
+    uint8_t i;
+
+    if( NULL == eventId )
+    {
+        return osaStatus_Error;
+    }
+
+    ((wrapperHostEvent_t*)eventId)->flags |= flagsToSet;
+
+    /* The tasks this wakes up run mWakeupLatency ms later */
+    for( i = 0; (i < mTaskCount) && mWakeupLatency; i++ )
+    {
+        pTask = &mTasks[i];
+        if( (pTask->pEvent == (wrapperHostEvent_t*)eventId) && !pTask->wakePending && EventReady( pTask ) )
+        {
+            if( gTmrInvalidTimerID_c == pTask->wakeTimer )
+            {
+                pTask->wakeTimer = TMR_AllocateTimer();
+            }
+            pTask->wakePending = TRUE;
+            pTask->wakeAt = OSA_TimeGetMsec() + mWakeupLatency;
+            (void)TMR_StartSingleShotTimer( pTask->wakeTimer, mWakeupLatency, DeadlineCallback, NULL );
+        }
+    }
+
+    return osaStatus_Success;
+}
+
+osaStatus_t OSA_EventClear( osaEventId_t eventId, osaEventFlags_t flagsToClear )
+{
+    if( NULL == eventId )
+    {
+        return osaStatus_Error;
+    }
+
+    ((wrapperHostEvent_t*)eventId)->flags &= ~flagsToClear;
+    return osaStatus_Success;
+}
+
+/*! *********************************************************************************
+* \brief  Waits for event flags. Outside of a task it never blocks.
+********************************************************************************** */
+osaStatus_t OSA_EventWait( osaEventId_t eventId, osaEventFlags_t flagsToWait, bool_t waitAll,
+                           uint32_t millisec, osaEventFlags_t *pSetFlags )
+{
+    wrapperHostEvent_t *pEvent = (wrapperHostEvent_t*)eventId;
+    int32_t task = CurrentTask();
+    osaEventFlags_t set;
+
+    if( NULL == pEvent )
+    {
+        return osaStatus_Error;
+    }
+
+    if( task >= 0 )
+    {
+        mTasks[task].pEvent = pEvent;
+        mTasks[task].mask = flagsToWait;
+        mTasks[task].waitAll = waitAll;
+        if( !IsReady( &mTasks[task] ) && (0 != millisec) )
+        {
+            Block( task, millisec );
+        }
+        mTasks[task].pEvent = NULL;
+    }
+
+    set = pEvent->flags & flagsToWait;
+    if( (0 == set) || (waitAll && (set != flagsToWait)) )
+    {
+        return osaStatus_Timeout;
+    }
+
+    if( pEvent->autoClear )
+    {
+        pEvent->flags &= ~set;
+    }
+    if( NULL != pSetFlags )
+    {
+        *pSetFlags = set;
+    }
+
+    return osaStatus_Success;
+}
+
+osaSemaphoreId_t OSA_SemaphoreCreate( uint32_t initValue )
+{
+    uint8_t i;
+
+    for( i = 0; i < gWrapperHostMaxSemaphores_c; i++ )
+    {
+        if( !mSemaphores[i].used )
+        {
+            mSemaphores[i].used = TRUE;
+            mSemaphores[i].count = initValue;
+            return (osaSemaphoreId_t)&mSemaphores[i];
+        }
+    }
+
+    return NULL;
+}
+
+/*! *********************************************************************************
+* \brief  Takes the semaphore. Outside of a task it never blocks.
+********************************************************************************** */
+osaStatus_t OSA_SemaphoreWait( osaSemaphoreId_t semId, uint32_t millisec )
+{
+    wrapperHostSemaphore_t *pSemaphore = (wrapperHostSemaphore_t*)semId;
+    int32_t task = CurrentTask();
+
+    if( NULL == pSemaphore )
+    {
+        return osaStatus_Error;
+    }
+
+    if( (task >= 0) && (0 == pSemaphore->count) && (0 != millisec) )
+    {
+        mTasks[task].pSemaphore = pSemaphore;
+        Block( task, millisec );
+        mTasks[task].pSemaphore = NULL;
+    }
+
+    if( 0 == pSemaphore->count )
+    {
+        return osaStatus_Timeout;
+    }
+
+    pSemaphore->count--;
+    return osaStatus_Success;
+}
+
+osaStatus_t OSA_SemaphorePost( osaSemaphoreId_t semId )
+{
+    if( NULL == semId )
+    {
+        return osaStatus_Error;
+    }
+
+    ((wrapperHostSemaphore_t*)semId)->count++;
+    return osaStatus_Success;
+}
+
+/* Only one thread runs at a time, there is nothing to mask */
+void OSA_InterruptDisable( void )
+{
+}
+
+void OSA_InterruptEnable( void )
+{
+}
+
+/* The host MAC needs neither the transceiver nor the random number generator */
+void Phy_Init( void )
+{
+}
+
+uint8_t RNG_Init( void )
+{
+    return 0;
+}
+
+/* The conversion of the MCR20A PHY (PhyISR.c), the host MAC maps the same
+ * dBm range to LQI */
+int8_t PhyConvertLQIToRSSI( uint8_t lqi )
+{
+    return (int8_t)((50 * (int32_t)lqi - 16820) / 163);
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The TaskThread() function waits for the CPU and runs the task function.
+ ******************************************************************************/
+static void* TaskThread( void *param )
+{
+    int32_t task = (int32_t)(uintptr_t)param;
+
+    pthread_mutex_lock( &mCpu );
+    while( mRunning != task )
+    {
+        pthread_cond_wait( &mTasks[task].cond, &mCpu );
+    }
+    mTasks[task].started = TRUE;
+
+    mTasks[task].pFunc( mTasks[task].param );
+
+    /* The task returned: it never runs again */
+    mTasks[task].pEvent = NULL;
+    mTasks[task].pSemaphore = NULL;
+    mTasks[task].hasDeadline = FALSE;
+    mRunning = mWrapperHostMain_c;
+    pthread_cond_signal( &mMainCond );
+    pthread_mutex_unlock( &mCpu );
+    return NULL;
+}
+
+/******************************************************************************
+ * The CurrentTask() function returns the index of the calling task, or -1 for
+ * any other thread.
+ ******************************************************************************/
+static int32_t CurrentTask( void )
+{
+    int32_t task = mRunning;
+
+    if( (task >= 0) && pthread_equal( pthread_self(), mTasks[task].thread ) )
+    {
+        return task;
+    }
+
+    return mWrapperHostMain_c;
+}
+
+/******************************************************************************
+ * The IsReady() function tells whether a task can run: it has not started yet,
+ * what it waits for is available (and its wakeup latency is over), or its
+ * deadline has passed.
+ ******************************************************************************/
+static bool_t IsReady( wrapperHostTask_t *pTask )
+{
+    if( !pTask->started )
+    {
+        return TRUE;
+    }
+
+    if( pTask->hasDeadline && ((int32_t)(OSA_TimeGetMsec() - pTask->deadline) >= 0) )
+    {
+        return TRUE;
+    }
+
+    if( NULL != pTask->pSemaphore )
+    {
+        return (pTask->pSemaphore->count > 0);
+    }
+
+    if( NULL != pTask->pEvent )
+    {
+        if( pTask->wakePending && ((int32_t)(OSA_TimeGetMsec() - pTask->wakeAt) < 0) )
+        {
+            return FALSE;
+        }
+        return EventReady( pTask );
+    }
+
+    return FALSE;
+}
+
+/******************************************************************************
+ * The EventReady() function tells whether the flags a task waits for are set.
+ ******************************************************************************/
+static bool_t EventReady( wrapperHostTask_t *pTask )
+{
+    osaEventFlags_t set = pTask->pEvent->flags & pTask->mask;
+
+    return pTask->waitAll ? (set == pTask->mask) : (0 != set);
+}
+
+/******************************************************************************
+ * The Block() function gives the CPU back to the main thread until the task
+ * is ready again.
+ ******************************************************************************/
+static void Block( int32_t task, uint32_t millisec )
+{
+    wrapperHostTask_t *pTask = &mTasks[task];
+
+    if( osaWaitForever_c != millisec )
+    {
+        if( gTmrInvalidTimerID_c == pTask->timer )
+        {
+            pTask->timer = TMR_AllocateTimer();
+        }
+        pTask->hasDeadline = TRUE;
+        pTask->deadline = OSA_TimeGetMsec() + millisec;
+        (void)TMR_StartSingleShotTimer( pTask->timer, millisec, DeadlineCallback, NULL );
+    }
+
+    do
+    {
+        mRunning = mWrapperHostMain_c;
+        pthread_cond_signal( &mMainCond );
+        while( mRunning != task )
+        {
+            pthread_cond_wait( &pTask->cond, &mCpu );
+        }
+    }
+    while( !IsReady( pTask ) );
+
+    pTask->wakePending = FALSE;
+    if( pTask->hasDeadline )
+    {
+        pTask->hasDeadline = FALSE;
+        (void)TMR_StopTimer( pTask->timer );
+    }
+}
+
+/******************************************************************************
+ * The DeadlineCallback() function only makes NetSim_Run() stop the clock at the
+ * deadline of a wait, WrapperHost_RunTasks() then wakes the task up.
+ ******************************************************************************/
+static void DeadlineCallback( void *param )
+{
+    (void)param;
+}
+
+/******************************************************************************
+ * The ConnectHandler() function is the event callback of the wrapper while
+ * WrapperHost_Connect() runs and after: it notes the association and hands
+ * every event to the callback of the test.
+ ******************************************************************************/
+static void ConnectHandler( void *pData )
+{
+    mac_event_data_t *pEvent = pData;
+    nwkMessage_t *pMsg;
+
+    if( mac_management_event_c == pEvent->mac_event_type )
+    {
+        pMsg = pEvent->evt_data.management_event_data;
+        if( (gMlmeAssociateCnf_c == pMsg->msgType) &&
+            (gSuccess_c == pMsg->msgData.associateCnf.status) )
+        {
+            mShortAddress = pMsg->msgData.associateCnf.assocShortAddress;
+            mConnected = TRUE;
+        }
+    }
+
+    if( NULL != mpfConnectHandler )
+    {
+        mpfConnectHandler( pData );
+    }
+}
@@ -0,0 +1,100 @@
+/************************************************************************************
+* This module contains the interface of the host OS stand-in of the mac wrapper.
+*
+* WrapperHost.c lets ieee802p15p4_wrapper.c run unchanged on a workstation, on top
+* of the host MAC and the network simulator (MacHost.c, NetSim.c). Every task
+* created with OSA_TaskCreate() is a thread, but only one thread runs at a time,
+* as on a single core: a task runs until it waits for an event that is not set,
+* and then the caller of WrapperHost_RunTasks() continues. The simulated time does
+* not advance while the tasks run, so the wrapper sees the MAC as infinitely fast
+* and the measured times only come from the MAC, the radio and the TMR timers.
+* WrapperHost_SetWakeupLatency() adds the time a task takes to run once the event
+* it waits for is set, as the scheduler and the higher priority tasks of the
+* target would.
+*
+* WrapperHost.c provides OSA_TaskCreate(), the OSA events and semaphores,
+* OSA_InterruptDisable/Enable(), Phy_Init() and RNG_Init(). NetSim.c provides the
+* timers, OSA_TimeGetMsec() and the memory manager.
+*
+* WrapperHost_Connect() is the common start of the tests: the wrapper associated
+* with a simulated coordinator.
+*
+************************************************************************************/
+#ifndef _WRAPPER_HOST_H
+#define _WRAPPER_HOST_H
+
+#include "EmbeddedTypes.h"
+
+#ifdef __cplusplus
+    extern "C" {
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/* Number of tasks, events and semaphores that can be created */
+#ifndef gWrapperHostMaxTasks_c
+#define gWrapperHostMaxTasks_c          (4)
+#endif
+
+#ifndef gWrapperHostMaxEvents_c
+#define gWrapperHostMaxEvents_c         (8)
+#endif
+
+#ifndef gWrapperHostMaxSemaphores_c
+#define gWrapperHostMaxSemaphores_c     (8)
+#endif
+
+/* WrapperHost_Connect(): time [ms] the simulated coordinator gets to start before
+ * the wrapper connects, and time [ms] after which the association has failed */
+#ifndef gWrapperHostCoordStartTime_c
+#define gWrapperHostCoordStartTime_c    (100)
+#endif
+
+#ifndef gWrapperHostConnectTimeout_c
+#define gWrapperHostConnectTimeout_c    (30000)
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+
+/*! *********************************************************************************
+* \brief  Runs the tasks that are ready (just created, or waiting for an event or a
+*         semaphore that is now available) until all of them wait again. It is
+*         meant to be the idle hook of NetSim_Run(), and has to be called from the
+*         thread that called mac_init().
+********************************************************************************** */
+void WrapperHost_RunTasks( void );
+
+/*! *********************************************************************************
+* \brief  Sets the time [ms] between an OSA_EventSet() and the task that waits for
+*         the event running. 0, the default, runs it at once.
+********************************************************************************** */
+void WrapperHost_SetWakeupLatency( uint32_t millisec );
+
+/*! *********************************************************************************
+* \brief  Initializes the flash, the network simulator and the wrapper (FlashHost_Init(),
+*         NetSim_Init(), mac_init()), adds a coordinator of the PAN 5 m away from the
+*         wrapper and associates with it (mac_connect()). pfHandler gets every event
+*         of the wrapper, the association confirm included.
+*
+* \return  the node index of the coordinator, or gNetSimInvalidNode_c if the
+*          association failed ("association FAILED" is printed)
+********************************************************************************** */
+uint8_t WrapperHost_Connect( uint16_t panId, uint8_t channel, void (*pfHandler)(void*) );
+
+/*! *********************************************************************************
+* \brief  Returns the short address the coordinator gave in WrapperHost_Connect().
+********************************************************************************** */
+uint16_t WrapperHost_GetShortAddress( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif //_WRAPPER_HOST_H
@@ -1,1204 +1,3593 @@
-/*
- * ieee802p15p4_wrapper.c
- *
- *  Created on: Sep 4, 2019
- *      Author: Nico
- */
-
-/*! *********************************************************************************
- *************************************************************************************
- * Include
- *************************************************************************************
- ********************************************************************************** */
-/* 802.15.4 */
-#include "EmbeddedTypes.h"
-#include "RNG_Interface.h"
-#include "TimersManager.h"
-#include "FunctionLib.h"
-
-#include "ieee802p15p4_wrapper.h"
-#include "ieee802p15p4_wrapper_cfg.h"
-
-#include "PhyInterface.h"
-#include "fsl_os_abstraction.h"
-
-/************************************************************************************
- *************************************************************************************
- * Private macros
- *************************************************************************************
- ************************************************************************************/
-/* The various states of the mac state machine. */
-enum
-{
-	macStateInit,
-	macStateScanActiveStart,
-	macStateScanActiveWaitConfirm,
-	macStateAssociate,
-	macStateAssociateWaitConfirm,
-	macStateWaitInterval,
-	macStateScanEdStart,
-	macStateScanEdWaitConfirm,
-	macStateStartCoordinator,
-	macStateStartCoordinatorWaitConfirm,
-	macStateListen
-};
-
-/* Events */
-#define gAppEvtDummyEvent_c            (1 << 0)
-#define gAppEvtStartCoordinator_c      (1 << 1)
-#define gAppEvtMessageFromMLME_c       (1 << 2)
-#define gAppEvtMessageFromMCPS_c       (1 << 3)
-#define mw_event_connect_request_c     (1 << 4)
-#define mw_event_transmit_request_c    (1 << 5)
-#define gAppEvtStartWait_c             (1 << 6)
-
-/************************************************************************************
- *************************************************************************************
- * Private data types
- *************************************************************************************
- ************************************************************************************/
-typedef struct _mw_connect_reqest_data{
-	uint8_t channel;
-	uint16_t pan_id;
-	void (*evt_hdlr)(void*);
-}mw_connect_request_data_t;
-
-typedef struct _mw_transmit_reqest_data{
-	uint16_t dest_address;
-	uint16_t data_len;
-	uint8_t  data[0];
-}mw_transmit_request_data_t;
-
-/************************************************************************************
- *************************************************************************************
- * Private prototypes
- *************************************************************************************
- ************************************************************************************/
-static void mac_task(void* argument);
-static uint8_t WaitMsg(nwkMessage_t *pMsg, uint8_t msgType);
-static uint8_t StartScan(macScanType_t scanType, uint8_t channel);
-static uint8_t HandleScanActiveConfirm( nwkMessage_t *pMsg, uint16_t pan_id );
-static void WaitIntervalTimeoutHandler(void *pData);
-static uint8_t SendAssociateRequest( void );
-static uint8_t HandleAssociateConfirm( nwkMessage_t *pMsg );
-static void HandleScanEdConfirm(nwkMessage_t *pMsg);
-static uint8_t StartCoordinator(void);
-static uint8_t TransmitData(uint16_t dest_address, uint8_t * pData, uint8_t length);
-static uint8_t HandleMlmeInput(nwkMessage_t *pMsg);
-static uint8_t SendAssociateResponse(nwkMessage_t *pMsgIn);
-static void HandleMcpsInput(mcpsToNwkMessage_t *pMsgIn);
-static resultType_t MLME_NWK_SapHandler (nwkMessage_t* pMsg, instanceId_t instanceId);
-static resultType_t MCPS_NWK_SapHandler (mcpsToNwkMessage_t* pMsg, instanceId_t instanceId);
-extern void Mac_SetExtendedAddress(uint8_t *pAddr, instanceId_t instanceId);
-static uint8_t HandleAssociateConfirm( nwkMessage_t *pMsg );
-
-/************************************************************************************
- *************************************************************************************
- * Private memory declarations
- *************************************************************************************
- ************************************************************************************/
-static uint8_t mac_initialized = FALSE;
-static uint8_t mac_connected = FALSE;
-static instanceId_t mMacInstance;
-static osaEventId_t mac_event;
-static uint8_t mac_state;
-static mw_connect_request_data_t* connect_request_data_p = NULL;
-static mw_transmit_request_data_t* transmit_request_data_p = NULL;
-
-/* Application input queues */
-static anchor_t mMlmeNwkInputQueue;
-static anchor_t mMcpsNwkInputQueue;
-
-OSA_TASK_DEFINE(mac_task, gMainThreadPriority_c-1, 1, gMainThreadStackSize_c, 0);
-
-static uint16_t mShortAddress = 0xFFFF;
-static uint16_t mPanId = 0xFFFF;
-static tmrTimerID_t mac_timer = gTmrInvalidTimerID_c;
-static void (*mwevt_hdlr)(void*);
-/* Data request packet for sending data to the coordinator */
-static nwkToMcpsMessage_t *mpPacket = NULL;
-/* The MSDU handle is a unique data packet identifier */
-static uint8_t mMsduHandle = 0;
-/* Information about the PAN we are part of */
-static panDescriptor_t mCoordInfo;
-/* This is a bit map having on the last 4 bits the OR-ed short addresses
-   assigned to end devices associated to the coordinator.
-   The addresses generated are: 1, 2, 4 and 8. When this value is 0x0F,
-   no more devices can associate. */
-static uint8_t mAddressesMap = 0x00;
-
-/* Reserved address for the device that is currently associating */
-static uint8_t mReservedAddress = 0x00;
-/************************************************************************************
- *************************************************************************************
- * Public memory declarations
- *************************************************************************************
- ************************************************************************************/
-
-/************************************************************************************
- *************************************************************************************
- * Public functions
- *************************************************************************************
- ************************************************************************************/
-/*FUNCTION**********************************************************************
- *
- * Function Name : mac_init
- * Description   : Initializes the ieee802.15.4 data link layer custom wrapper.
- *                 This is a blocking function.
- *
- * Params: mac_addr - Pointer to a 8 bytes array that contains the board's MAC
- *                    address.
- *
- * Return: int: 0 - success.
- *
- *END**************************************************************************/
-int mac_init(uint8_t* pAddr)
-{
-	/*****************************************/
-	/* Initialize the ieee802.15.4 MAC stack */
-	/*****************************************/
-	if(mac_initialized) {
-		return mwErrorAlreadyInitialized;
-	}
-
-	Phy_Init();
-	RNG_Init(); /* RNG must be initialized after the PHY is Initialized */
-	MAC_Init();
-
-	/* Bind to MAC layer */
-	mMacInstance = BindToMAC( (instanceId_t)0 );
-
-	Mac_RegisterSapHandlers( MCPS_NWK_SapHandler, MLME_NWK_SapHandler, mMacInstance );
-
-	/* Prepare input queues.*/
-	MSG_InitQueue(&mMlmeNwkInputQueue);
-	MSG_InitQueue(&mMcpsNwkInputQueue);
-	/* Initialize the MAC 802.15.4 extended address */
-	Mac_SetExtendedAddress( pAddr, mMacInstance );
-
-	/******************************/
-	/* Initialize the mac wrapper */
-	/******************************/
-	mac_event = OSA_EventCreate(TRUE);
-	mac_state = macStateInit;
-	/* Create the mac task */
-	OSA_TaskCreate(OSA_TASK(mac_task), NULL);
-	mac_timer = TMR_AllocateTimer();
-
-	/****************************/
-	/* Initialization completed */
-	/****************************/
-	mac_initialized = TRUE;
-	return 0;
-}
-
-/*FUNCTION**********************************************************************
- *
- * Function Name : mac_connect
- * Description   : Commands the node to connect to a ieee802.15.4 network, if
- *                 the network does not exists then the node starts it.
- *                 mac_init() has to be called first.
- *                 This is a non-blocking function. The result of the connection
- *                 request will be recibed in a call to the event handler
- *                 callback (evt_hdlr).
- *
- * Params: channel  - Channel to start the network (11-26).
- *         pan_id   - Id of the network
- *         evt_hdlr - Pointer to a callback function that will be called by the
- *                    mac wrapper to signal events on the MAC layer to the
- *                    calling layer. The events received by this callback are:
- *                    * Data reception.
- *                    * Data Transmission confirm.
- *                    * Network Connection.
- *                    * Network Disconnections
- *
- * Return: int: 0 - success.
- *
- *END**************************************************************************/
-int mac_connect(uint8_t channel, uint16_t pan_id, void (*evt_hdlr)(void*))
-{
-	/* The MAC shall not be connected yet and there should not be a connection
-	 * in progress */
-	if(mac_connected || (connect_request_data_p != NULL)) {
-		return mwErrorAlreadyConnected;
-	}
-
-	/* Allocate memory for the request */
-	connect_request_data_p = MSG_Alloc(sizeof(mw_connect_request_data_t));
-
-	/* Fill the message */
-	connect_request_data_p->channel = channel;
-	connect_request_data_p->pan_id = pan_id;
-	connect_request_data_p->evt_hdlr = evt_hdlr;
-
-	/* Signal the mac wrapper task */
-	OSA_EventSet(mac_event, mw_event_connect_request_c);
-
-	return mwErrorNoError;
-}
-
-/*FUNCTION**********************************************************************
- *
- * Function Name : mac_transmit
- * Description   : Commands the node to send data to another node over a
- *                 ieee802.15.4 network.
- *                 mac_connect() has to be called before hand.
- *                 This is a non-blocking function. The result of the
- *                 transmission request will be recibed in a call to the event
- *                 handler callback (evt_hdlr).
- *
- *
- * Params: dest_address  - Address of the data's destination node.
- *         data   - Pointer to the data array to transmit
- *         data_len - Size in bytes of the data array.
- *
- * Return: int: 0 - success.
- *
- *END**************************************************************************/
-int mac_transmit(uint16_t dest_address, uint8_t* data, uint8_t data_len)
-{
-	/* The MAC shall be connected yet and there should not be a transmission
-	 * in progress */
-	if(!mac_connected || (transmit_request_data_p != NULL)) {
-		return mwErrorAlreadyConnected;
-	}
-
-	/* Allocate memory for the request */
-	transmit_request_data_p = MSG_Alloc(sizeof(mw_connect_request_data_t) + data_len);
-
-	/* Fill the message */
-	transmit_request_data_p->dest_address = dest_address;
-	transmit_request_data_p->data_len = data_len;
-	FLib_MemCpy(transmit_request_data_p->data, data, data_len);
-
-	/* Signal the mac wrapper task */
-	OSA_EventSet(mac_event, mw_event_transmit_request_c);
-	return mwErrorNoError;
-}
-
-/************************************************************************************
- *************************************************************************************
- * Private functions
- *************************************************************************************
- ************************************************************************************/
-/*FUNCTION**********************************************************************
- *
- * Function Name : mac_task
- * Description   : Wrapper over ieee802.15.4 data link layer.
- *
- *END**************************************************************************/
-static void mac_task(void* argument)
-{
-	osaEventFlags_t ev;
-	/* Pointer for storing the messages from MLME */
-	void *pMsgIn;
-	mac_event_data_t event_data;
-	/* Stores the status code returned by some functions. */
-	uint8_t rc;
-
-	while(1) {
-		/* Wait for events */
-		OSA_EventWait(mac_event, osaEventFlagsAll_c, FALSE, osaWaitForever_c, &ev);
-		pMsgIn = NULL;
-
-		/* Dequeue the MLME message */
-		if (ev & gAppEvtMessageFromMLME_c)
-		{
-			/* Get the message from MLME */
-			pMsgIn = MSG_DeQueue(&mMlmeNwkInputQueue);
-
-			/* Any time a beacon might arrive. Always handle the beacon frame first */
-			if (pMsgIn)
-			{
-				rc = WaitMsg(pMsgIn, gMlmeBeaconNotifyInd_c);
-				if(rc == mwErrorNoError)
-				{
-					/* ALWAYS free the beacon frame contained in the beacon notify indication.*/
-					/* ALSO the application can use the beacon payload.*/
-					MSG_Free(((nwkMessage_t *)pMsgIn)->msgData.beaconNotifyInd.pBufferRoot);
-				}
-			}
-		}
-
-		switch(mac_state)
-		{
-		/* State machine */
-		case macStateInit:
-			if((ev & mw_event_connect_request_c) && (NULL != connect_request_data_p)) {
-				/* Goto Energy Detection state. */
-				mac_state = macStateScanActiveStart;
-				OSA_EventSet(mac_event, gAppEvtDummyEvent_c );
-			}
-			break;
-
-		case macStateScanActiveStart:
-			/* Start the Active scan, and goto wait for confirm state. */
-
-			rc = StartScan( gScanModeActive_c, connect_request_data_p->channel );
-			if( rc == mwErrorNoError )
-			{
-				mac_state = macStateScanActiveWaitConfirm;
-			}
-			break;
-
-		case macStateScanActiveWaitConfirm:
-			/* Stay in this state until the Scan confirm message arrives, and then goto
-			 the associate state or do a rescan in case of invalid short address.     */
-			if( ev & gAppEvtMessageFromMLME_c )
-			{
-				if( pMsgIn )
-				{
-					/* Handle the Scan Confirm message. */
-					rc = WaitMsg( pMsgIn, gMlmeScanCnf_c );
-					if( rc == mwErrorNoError )
-					{
-						rc = HandleScanActiveConfirm( pMsgIn, connect_request_data_p->pan_id );
-						if( rc == mwErrorNoError )
-						{
-							mac_state = macStateAssociate;
-							OSA_EventSet(mac_event, gAppEvtDummyEvent_c );
-						}
-						else
-						{
-							/* Restart scanning */
-							TMR_StartSingleShotTimer( mac_timer, 7000, WaitIntervalTimeoutHandler, NULL );
-							mac_state = macStateWaitInterval;
-						}
-					}
-				}
-			}
-			break;
-
-		case macStateWaitInterval:
-			if( ev & gAppEvtStartWait_c )
-			{
-				/* Since the network does not exist on this channel then we can start it */
-				mac_state = macStateScanEdStart;
-				OSA_EventSet(mac_event, gAppEvtDummyEvent_c );
-			}
-			break;
-
-		case macStateAssociate:
-			/* Associate to the PAN coordinator */
-			rc = SendAssociateRequest();
-			if( rc == mwErrorNoError )
-			{
-				mac_state = macStateAssociateWaitConfirm;
-			}
-			break;
-
-		case macStateAssociateWaitConfirm:
-			/* Stay in this state until the Associate confirm message
-			 arrives, and then goto the Listen state. */
-			if( ev & gAppEvtMessageFromMLME_c )
-			{
-				if( pMsgIn )
-				{
-					rc = WaitMsg( pMsgIn, gMlmeAssociateCnf_c );
-					if( rc == mwErrorNoError )
-					{
-						/* Check for coordinator at full capacity error */
-						if( HandleAssociateConfirm(pMsgIn) == mwErrorNoError )
-						{
-							/*Call the upper layer callback */
-							mwevt_hdlr = connect_request_data_p->evt_hdlr;
-							if(mwevt_hdlr != NULL) {
-								event_data.mac_event_type = mac_management_event_c;
-								event_data.evt_data.management_event_data = (nwkMessage_t*)pMsgIn;
-								mwevt_hdlr((void*)&event_data);
-							}
-							/* Release the connection request memory */
-							MSG_Free(connect_request_data_p);
-							connect_request_data_p = NULL;
-							mac_connected = TRUE;
-							/* Go to listen state */
-							mac_state = macStateListen;
-							OSA_EventSet(mac_event, gAppEvtDummyEvent_c);
-						}
-						else
-						{
-							/* Restart scanning */
-							TMR_StartSingleShotTimer( mac_timer, 7000, WaitIntervalTimeoutHandler, NULL );
-							mac_state = macStateWaitInterval;
-						}
-					}
-				}
-			}
-			break;
-
-		case macStateScanEdStart:
-			/* Start the Energy Detection scan, and goto wait for confirm state. */
-			rc = StartScan(gScanModeED_c, connect_request_data_p->channel);
-			if(rc == mwErrorNoError)
-			{
-				mac_state = macStateScanEdWaitConfirm;
-			}
-			break;
-
-		case macStateScanEdWaitConfirm:
-			/* Stay in this state until the MLME Scan confirm message arrives,
-			 and has been processed. Then goto Start Coordinator state. */
-			if (ev & gAppEvtMessageFromMLME_c)
-			{
-				if (pMsgIn)
-				{
-					rc = WaitMsg(pMsgIn, gMlmeScanCnf_c);
-					if(rc == mwErrorNoError)
-					{
-						/* Process the ED scan confirm. The logical
-						 channel is selected by this function. */
-						HandleScanEdConfirm(pMsgIn);
-						mac_state =macStateStartCoordinator;
-						OSA_EventSet(mac_event, gAppEvtStartCoordinator_c);
-					}
-				}
-			}
-			break;
-
-		case macStateStartCoordinator:
-			/* Start up as a PAN Coordinator on the selected channel. */
-			if (ev & gAppEvtStartCoordinator_c)
-			{
-				rc = StartCoordinator();
-				if(rc == mwErrorNoError)
-				{
-					/* If the Start request was sent successfully to
-					 the MLME, then goto Wait for confirm state. */
-					mac_state = macStateStartCoordinatorWaitConfirm;
-				}
-			}
-			break;
-
-		case macStateStartCoordinatorWaitConfirm:
-			/* Stay in this state until the Start confirm message
-			 arrives, and then goto the Listen state. */
-			if (ev & gAppEvtMessageFromMLME_c)
-			{
-				if (pMsgIn)
-				{
-					rc = WaitMsg(pMsgIn, gMlmeStartCnf_c);
-					if(rc == mwErrorNoError)
-					{
-						mPanId = connect_request_data_p->pan_id;
-						/*Call the upper layer callback */
-						mwevt_hdlr = connect_request_data_p->evt_hdlr;
-						if(mwevt_hdlr != NULL) {
-							event_data.mac_event_type = mac_management_event_c;
-							event_data.evt_data.management_event_data = (nwkMessage_t*)pMsgIn;
-							mwevt_hdlr((void*)&event_data);
-						}
-						/* Release the connection request memory */
-						MSG_Free(connect_request_data_p);
-						connect_request_data_p = NULL;
-						mac_state = macStateListen;
-						mac_connected = TRUE;
-						OSA_EventSet(mac_event, gAppEvtDummyEvent_c);
-					}
-				}
-			}
-			break;
-		case macStateListen:
-			/* Stay in this state forever.
-			 Transmit to end device data from serial terminal interface */
-			if (ev & gAppEvtMessageFromMLME_c)
-			{
-				/* Get the message from MLME */
-				if (pMsgIn)
-				{
-					/* Process it */
-					HandleMlmeInput(pMsgIn);
-					/*Call the upper layer callback */
-					if(mwevt_hdlr != NULL) {
-						event_data.mac_event_type = mac_management_event_c;
-						event_data.evt_data.management_event_data = (nwkMessage_t*)pMsgIn;
-						mwevt_hdlr((void*)&event_data);
-					}
-					/* Messages from the MLME must always be freed. */
-				}
-			}
-
-			if (ev & mw_event_transmit_request_c)
-			{
-				TransmitData(transmit_request_data_p->dest_address,
-						transmit_request_data_p->data,
-						transmit_request_data_p->data_len);
-			}
-
-			break;
-		} /* end switch*/
-
-		/* Free Mlme messages*/
-		if (pMsgIn)
-		{
-			/* Messages must always be freed. */
-			MSG_Free(pMsgIn);
-			pMsgIn = NULL;
-		}
-
-		/* Handle MCPS confirms and transmit data from serial terminal interface */
-		if (ev & gAppEvtMessageFromMCPS_c)
-		{
-			/* Get the message from MCPS */
-			pMsgIn = MSG_DeQueue(&mMcpsNwkInputQueue);
-			if (pMsgIn)
-			{
-				/* Process it */
-				HandleMcpsInput(pMsgIn);
-				/*Call the upper layer callback */
-				if(mwevt_hdlr != NULL) {
-					event_data.mac_event_type = mac_data_event_c;
-					event_data.evt_data.data_event_data = (mcpsToNwkMessage_t*)pMsgIn;
-					mwevt_hdlr((void*)&event_data);
-				}
-				/* Messages from the MCPS must always be freed. */
-				MSG_Free(pMsgIn);
-				pMsgIn = NULL;
-			}
-		}
-
-		/* Check for pending messages in the Queue */
-		if(MSG_Pending(&mMcpsNwkInputQueue))
-			OSA_EventSet(mac_event, gAppEvtMessageFromMCPS_c);
-		if(MSG_Pending(&mMlmeNwkInputQueue))
-			OSA_EventSet(mac_event, gAppEvtMessageFromMLME_c);
-
-
-
-
-	}
-}
-
-/******************************************************************************
- * The WaitMsg(nwkMessage_t *pMsg, uint8_t msgType) function does not, as
- * the name implies, wait for a message, thus blocking the execution of the
- * state machine. Instead the function analyzes the supplied message to determine
- * whether or not the message is of the expected type.
- * The function may return either of the following values:
- *   mwErrorNoError: The message was of the expected type.
- *   mwErrorNoMessage: The message pointer is NULL.
- *   mwErrorWrongConfirm: The message is not of the expected type.
- *
- ******************************************************************************/
-static uint8_t WaitMsg(nwkMessage_t *pMsg, uint8_t msgType)
-{
-	/* Do we have a message? If not, the exit with error code */
-	if(pMsg == NULL)
-	{
-		return mwErrorNoMessage;
-	}
-	/* Is it the expected message type? If not then exit with error code */
-	if(pMsg->msgType != msgType)
-	{
-		return mwErrorWrongConfirm;
-	}
-
-	/* Found the expected message. Return with success code */
-	return mwErrorNoError;
-}
-
-/******************************************************************************
- * The StartScan(scanType) function will start the scan process of the
- * specified type in the MAC. This is accomplished by allocating a MAC message,
- * which is then assigned the desired scan parameters and sent to the MLME
- * service access point.
- * The function may return either of the following values:
- *   mwErrorNoError:          The Scan message was sent successfully.
- *   mwErrorInvalidParameter: The MLME service access point rejected the
- *                          message due to an invalid parameter.
- *   mwErrorAllocFailed:      A message buffer could not be allocated.
- *
- ******************************************************************************/
-static uint8_t StartScan(macScanType_t scanType, uint8_t channel)
-{
-	mlmeMessage_t *pMsg;
-	mlmeScanReq_t *pScanReq;
-
-	//Serial_Print(mInterfaceId,"Sending the MLME-Scan Request message to the MAC... ", gAllowToBlock_d);
-
-	/* Allocate a message for the MLME (We should check for NULL). */
-	pMsg = MSG_AllocType(mlmeMessage_t);
-	if(pMsg != NULL)
-	{
-		/* This is a MLME-SCAN.req command */
-		pMsg->msgType = gMlmeScanReq_c;
-		/* Create the Scan request message data. */
-		pScanReq = &pMsg->msgData.scanReq;
-		/* gScanModeED_c, gScanModeActive_c, gScanModePassive_c, or gScanModeOrphan_c */
-		pScanReq->scanType = scanType;
-		/* ChannelsToScan */
-		pScanReq->scanChannels = 0x01<<channel;
-		/* Duration per channel 0-14 (dc). T[sec] = (16*960*((2^dc)+1))/1000000.
-    A scan duration of 5 on 16 channels approximately takes 8 secs. */
-		pScanReq->scanDuration = 5;
-		pScanReq->securityLevel = gMacSecurityNone_c;
-
-		/* Send the Scan request to the MLME. */
-		if(NWK_MLME_SapHandler( pMsg, mMacInstance ) == gSuccess_c)
-		{
-			//Serial_Print(mInterfaceId,"Done.\n\r", gAllowToBlock_d);
-			return mwErrorNoError;
-		}
-		else
-		{
-			//Serial_Print(mInterfaceId,"Invalid parameter.\n\r", gAllowToBlock_d);
-			return mwErrorInvalidParameter;
-		}
-	}
-	else
-	{
-		/* Allocation of a message buffer failed. */
-		//Serial_Print(mInterfaceId,"Message allocation failed.\n\r", gAllowToBlock_d);
-		return mwErrorAllocFailed;
-	}
-}
-
-/******************************************************************************
- * The HandleScanActiveConfirm(nwkMessage_t *pMsg) function will handle the
- * Active Scan confirm message received from the MLME when the Active scan has
- * completed. The message contains a list of PAN descriptors. the requested
- * coordinator is chosen. The corresponding pan descriptor is stored in the
- * global variable mCoordInfo.
- *
- * The function may return either of the following values:
- *   mwErrorNoError:       A suitable pan descriptor was found.
- *   mwErrorNoScanResults: No scan results were present in the confirm message.
- *
- ******************************************************************************/
-static uint8_t HandleScanActiveConfirm( nwkMessage_t *pMsg, uint16_t pan_id )
-{
-	void    *pBlock;
-	uint8_t panDescListSize = pMsg->msgData.scanCnf.resultListSize;
-	uint8_t rc = mwErrorNoScanResults;
-	uint8_t j;
-	panDescriptorBlock_t *pDescBlock = pMsg->msgData.scanCnf.resList.pPanDescriptorBlockList;
-	panDescriptor_t      *pPanDesc;
-
-	/* Check if the scan resulted in any coordinator responses. */
-	if( panDescListSize > 0 )
-	{
-		/* Check all PAN descriptors. */
-		while( NULL != pDescBlock )
-		{
-			for( j = 0; j < pDescBlock->panDescriptorCount; j++ )
-			{
-				pPanDesc = &pDescBlock->panDescriptorList[j];
-
-				/* Only attempt to associate if the coordinator
-                accepts associations and is non-beacon. */
-				if( ( pPanDesc->superframeSpec.associationPermit ) &&
-						( pPanDesc->superframeSpec.beaconOrder == 0x0F) )
-				{
-					/* Find the requested coordinator. */
-					if( pPanDesc->coordPanId == pan_id )
-					{
-						/* Save the information of the coordinator  */
-						FLib_MemCpy( &mCoordInfo, pPanDesc, sizeof(panDescriptor_t) );
-						rc = mwErrorNoError;
-					}
-				}
-			}
-
-			/* Free current block */
-			pBlock = pDescBlock;
-			pDescBlock = pDescBlock->pNext;
-			MSG_Free( pBlock );
-		}
-	}
-
-	if( pDescBlock )
-		MSG_Free( pDescBlock );
-
-	return rc;
-}
-
-/******************************************************************************
- * The IntervalTimeoutHandler(uint8_t timerID) function will send an event
- * to the application task after the programmed interval of time expires
- *
- ******************************************************************************/
-static void WaitIntervalTimeoutHandler(void *pData)
-{
-	(void)pData;
-	OSA_EventSet(mac_event, gAppEvtStartWait_c);
-}
-
-/******************************************************************************
- * The SendAssociateRequest(void) will create an Associate Request message
- * and send it to the coordinator it wishes to associate to. The function uses
- * information gained about the coordinator during the scan procedure.
- *
- * The function may return either of the following values:
- *   mwErrorNoError:          The Associate Request message was sent successfully.
- *   mwErrorInvalidParameter: The MLME service access point rejected the
- *                          message due to an invalid parameter.
- *   mwErrorAllocFailed:      A message buffer could not be allocated.
- *
- ******************************************************************************/
-static uint8_t SendAssociateRequest( void )
-{
-	mlmeMessage_t *pMsg;
-	mlmeAssociateReq_t *pAssocReq;
-	uint8_t boolFlag;
-
-	/* Allocate a message for the MLME message. */
-	pMsg = MSG_AllocType( mlmeMessage_t );
-	if( pMsg != NULL )
-	{
-		/* Set the gMPibRxOnWhenIdle_c flag to true, this will allow direct data messages */
-		pMsg->msgType = gMlmeSetReq_c;
-		pMsg->msgData.setReq.pibAttribute = gMPibRxOnWhenIdle_c;
-		boolFlag = TRUE;
-		pMsg->msgData.setReq.pibAttributeValue = &boolFlag;
-		NWK_MLME_SapHandler( pMsg, mMacInstance );
-
-		/* We must set the Association Permit flag to TRUE
-        in order to allow devices to associate to us. */
-		/* We can re-use the pMsg data because gMlmeSetReq_c is a synchronous request */
-		/* This is a MLME-ASSOCIATE.req command. */
-		pMsg->msgType = gMlmeAssociateReq_c;
-		/* Create the Associate request message data. */
-		pAssocReq = &pMsg->msgData.associateReq;
-
-		/* Use the coordinator info we got from the Active Scan. */
-		FLib_MemCpy(&pAssocReq->coordAddress, &mCoordInfo.coordAddress, 8);
-		FLib_MemCpy(&pAssocReq->coordPanId,   &mCoordInfo.coordPanId, 2);
-		pAssocReq->coordAddrMode  = mCoordInfo.coordAddrMode;
-		pAssocReq->logicalChannel = mCoordInfo.logicalChannel;
-		pAssocReq->securityLevel  = gMacSecurityNone_c;
-		pAssocReq->channelPage = gDefaultChannelPageId_c;
-
-		/* We want the coordinator to assign a short address to us. */
-		pAssocReq->capabilityInfo     = gCapInfoAllocAddr_c;
-
-		/* Send the Associate Request to the MLME. */
-		if( NWK_MLME_SapHandler( pMsg, mMacInstance ) == gSuccess_c )
-		{
-			return mwErrorNoError;
-		}
-		else
-		{
-			/* One or more parameters in the message were invalid. */
-			return mwErrorInvalidParameter;
-		}
-	}
-	else
-	{
-		/* Allocation of a message buffer failed. */
-		return mwErrorAllocFailed;
-	}
-}
-
-
-/******************************************************************************
- * The HandleAssociateConfirm(nwkMessage_t *pMsg) function will handle the
- * Associate confirm message received from the MLME when the Association
- * procedure has completed. The message contains the short address that the
- * coordinator has assigned to us. The address and address mode are saved in
- * global variables. They will be used in the next demo application when sending
- * data .
- *
- * The function may return either of the following values:
- *   gSuccess_c:          Correct short address
- *   gPanAccessDenied_c:  Invalid short address
- *
- ******************************************************************************/
-static uint8_t HandleAssociateConfirm( nwkMessage_t *pMsg )
-{
-	if( pMsg->msgData.associateCnf.status == gSuccess_c )
-	{
-		FLib_MemCpy( &mShortAddress, &pMsg->msgData.associateCnf.assocShortAddress, 2 );
-		mPanId = connect_request_data_p->pan_id;
-		return mwErrorNoError;
-	}
-	else
-	{
-		/* No valid short address. */
-		return mwErrorPanAccessDenied;
-	}
-}
-
-/******************************************************************************
- * The HandleScanEdConfirm(nwkMessage_t *pMsg) function will handle the
- * ED scan confirm message received from the MLME when the ED scan has completed.
- * The message contains the ED scan result list. This function will search the
- * list in order to select the logical channel with the least energy. The
- * selected channel is stored in the global variable called 'mLogicalChannel'.
- *
- ******************************************************************************/
-static void HandleScanEdConfirm(nwkMessage_t *pMsg)
-{
-	uint8_t *pEdList;
-
-	/* Get a pointer to the energy detect results */
-	pEdList = pMsg->msgData.scanCnf.resList.pEnergyDetectList;
-
-	/* The list of detected energies must be freed. */
-	MSG_Free(pEdList);
-}
-
-/******************************************************************************
- * The App_StartScan(scanType) function will start the scan process of the
- * specified type in the MAC. This is accomplished by allocating a MAC message,
- * which is then assigned the desired scan parameters and sent to the MLME
- * service access point. The MAC PIB attributes "macShortAddress", and
- * "macAssociatePermit" are modified.
- *
- * The function may return either of the following values:
- *   mwErrorNoError:          The Scan message was sent successfully.
- *   mwErrorInvalidParameter: The MLME service access point rejected the
- *                          message due to an invalid parameter.
- *   mwErrorAllocFailed:      A message buffer could not be allocated.
- *
- ******************************************************************************/
-static uint8_t StartCoordinator(void)
-{
-	/* Message for the MLME will be allocated and attached to this pointer */
-	mlmeMessage_t *pMsg;
-
-	/* Allocate a message for the MLME (We should check for NULL). */
-	pMsg = MSG_AllocType(mlmeMessage_t);
-	if(pMsg != NULL)
-	{
-		/* Pointer which is used for easy access inside the allocated message */
-		mlmeStartReq_t *pStartReq;
-		/* Return value from MSG_send - used for avoiding compiler warnings */
-		uint8_t ret = 0;
-		/* Boolean value that will be written to the MAC PIB */
-		uint8_t boolFlag;
-
-		(void) ret;     // remove compiler warning
-		/* Set-up MAC PIB attributes. Please note that Set, Get, and Reset
-       messages are not freed by the MLME. We must always set the short
-       address to something else than 0xFFFF before starting a PAN.
-		 */
-		mShortAddress = 0x0000;
-		pMsg->msgType = gMlmeSetReq_c;
-		pMsg->msgData.setReq.pibAttribute = gMPibShortAddress_c;
-		pMsg->msgData.setReq.pibAttributeValue = (uint8_t *)&mShortAddress;
-		ret = NWK_MLME_SapHandler( pMsg, mMacInstance );
-
-		/* We must set the Association Permit flag to TRUE
-    in order to allow devices to associate to us. */
-		pMsg->msgType = gMlmeSetReq_c;
-		pMsg->msgData.setReq.pibAttribute = gMPibAssociationPermit_c;
-		boolFlag = TRUE;
-		pMsg->msgData.setReq.pibAttributeValue = &boolFlag;
-		ret = NWK_MLME_SapHandler( pMsg, mMacInstance );
-
-		/* This is a MLME-START.req command */
-		pMsg->msgType = gMlmeStartReq_c;
-		/* Create the Start request message data. */
-		pStartReq = &pMsg->msgData.startReq;
-		/* PAN ID - LSB, MSB. The demo shows a PAN ID of 0xAAAA. */
-		FLib_MemCpy(&pStartReq->panId, (void*)&connect_request_data_p->pan_id, 2);
-		/* Logical Channel - the default of 11 will be overridden */
-		pStartReq->logicalChannel = connect_request_data_p->channel;
-
-		/* Beacon Order - 0xF = turn off beacons */
-		pStartReq->beaconOrder = 0x0F;
-		/* Superframe Order - 0xF = turn off beacons */
-		pStartReq->superframeOrder = 0x0F;
-		/* Be a PAN coordinator */
-		pStartReq->panCoordinator = TRUE;
-		/* Dont use battery life extension */
-		pStartReq->batteryLifeExtension = FALSE;
-		/* This is not a Realignment command */
-		pStartReq->coordRealignment = FALSE;
-		/* Dont use security */
-		pStartReq->coordRealignSecurityLevel = gMacSecurityNone_c;
-		pStartReq->beaconSecurityLevel = gMacSecurityNone_c;
-
-		/* Send the Start request to the MLME. */
-		if(NWK_MLME_SapHandler( pMsg, mMacInstance ) == gSuccess_c)
-		{
-			return mwErrorNoError;
-		}
-		else
-		{
-			/* One or more parameters in the Start Request message were invalid. */
-			return mwErrorInvalidParameter;
-		}
-	}
-	else
-	{
-		/* Allocation of a message buffer failed. */
-		return mwErrorAllocFailed;
-	}
-}
-
-/******************************************************************************
- * The TransmitData() function will perform data transmissions of data.
- *
- * The function uses the address map, that was updated when a device associates,
- * to build MCPS-Data Request messages, one for every associated device. The
- * messages are sent to the MCPS service access point in the MAC.
- ******************************************************************************/
-static uint8_t TransmitData(uint16_t dest_address, uint8_t * pData, uint8_t length)
-{
-	uint8_t ret = 0;
-
-	(void) ret;       // remove compiler warning
-
-	/* For every device associated, if there is still room in the queue
-  allocate and send a packet */
-	if((length != 0) && (pData != NULL))
-	{
-		/* Transmit packet to the device */
-		if (NULL == mpPacket)
-		{
-			mpPacket = MSG_Alloc(sizeof(nwkToMcpsMessage_t) + gMaxPHYPacketSize_c);
-
-			if (mpPacket != NULL)
-			{
-				/* Create an MCPS-Data Request message containing the data. */
-				mpPacket->msgType = gMcpsDataReq_c;
-				/* Copy data to be sent to packet */
-				mpPacket->msgData.dataReq.pMsdu = (uint8_t*)(&(mpPacket->msgData.dataReq.pMsdu)) + sizeof(uint8_t*);
-				FLib_MemCpy(mpPacket->msgData.dataReq.pMsdu, (void *)pData, length);
-				/* Create the header using device information stored when creating
-          the association response. In this simple example the use of short
-          addresses is hardcoded. In a real world application we must be
-          flexible, and use the address mode required by the given situation. */
-				mpPacket->msgData.dataReq.dstAddr = dest_address;
-
-				FLib_MemCpy(&mpPacket->msgData.dataReq.srcAddr,  (void*)&mShortAddress, 2);
-				FLib_MemCpy(&mpPacket->msgData.dataReq.dstPanId, (void*)&mPanId, 2);
-				FLib_MemCpy(&mpPacket->msgData.dataReq.srcPanId, (void*)&mPanId, 2);
-				mpPacket->msgData.dataReq.dstAddrMode = gAddrModeShortAddress_c;
-				mpPacket->msgData.dataReq.srcAddrMode = gAddrModeShortAddress_c;
-				mpPacket->msgData.dataReq.msduLength = length;
-				/* Request MAC level acknowledgement, and
-          indirect transmission of the data packet */
-				mpPacket->msgData.dataReq.txOptions = gMacTxOptionsAck_c;
-				/* Give the data packet a handle. The handle is
-          returned in the MCPS-Data Confirm message. */
-				mpPacket->msgData.dataReq.msduHandle = mMsduHandle++;
-				mpPacket->msgData.dataReq.securityLevel = gMacSecurityNone_c;
-
-				/* Send the Data Request to the MCPS */
-				(void)NWK_MCPS_SapHandler(mpPacket, mMacInstance);
-
-			}
-			else
-			{
-				return mwErrorAllocFailed;
-			}
-		}
-		else
-		{
-			return mwErrorTransmissionInprogress;
-		}
-	}
-	else {
-		return mwErrorInvalidParameter;
-	}
-	return mwErrorNoError;
-}
-
-/******************************************************************************
- * The HandleMlmeInput(nwkMessage_t *pMsg) function will handle various
- * messages from the MLME, e.g. (Dis)Associate Indication.
- *
- * The function may return either of the following values:
- *   errorNoError:   The message was processed.
- *   errorNoMessage: The message pointer is NULL.
- ******************************************************************************/
-static uint8_t HandleMlmeInput(nwkMessage_t *pMsg)
-{
-	if(pMsg == NULL)
-	{
-		return mwErrorNoMessage;
-	}
-
-	/* Handle the incoming message. The type determines the sort of processing.*/
-	switch(pMsg->msgType)
-	{
-	case gMlmeAssociateInd_c:
-		/* A device sent us an Associate Request. We must send back a response.  */
-		return SendAssociateResponse(pMsg);
-		break;
-
-	case gMlmeCommStatusInd_c:
-		/* Sent by the MLME after the Association Response has been transmitted. */
-		switch(pMsg->msgData.commStatusInd.status)
-		{
-		case gSuccess_c:
-			/*Device successfully associated. Storing reserved address.*/
-			mAddressesMap |= mReservedAddress;
-			mReservedAddress = 0x00;
-			break;
-
-		case gTransactionExpired_c:
-			/*Association response expired. Device not associated. Dropping reserved address.*/
-			mReservedAddress = 0x00;
-			break;
-
-		case  gNoAck_c:
-			/*ACK not received for Association Response. Device not associated. Dropping reserved address.*/
-			mReservedAddress = 0x00;
-			break;
-
-		default:
-			mReservedAddress = 0x00;
-		}
-		break;
-		default:
-			break;
-	}
-	return mwErrorNoError;
-}
-
-/******************************************************************************
- * The SendAssociateResponse(nwkMessage_t *pMsgIn) will create the response
- * message to an Associate Indication (device sends an Associate Request to its
- * MAC. The request is transmitted to the coordinator where it is converted into
- * an Associate Indication). This function will extract the devices long address,
- * and various other flags from the incoming indication message for building the
- * response message.
- *
- * The function may return either of the following values:
- *   errorNoError:          The Associate Response message was sent successfully.
- *   errorInvalidParameter: The MLME service access point rejected the
- *                          message due to an invalid parameter.
- *   errorAllocFailed:      A message buffer could not be allocated.
- *
- ******************************************************************************/
-static uint8_t SendAssociateResponse(nwkMessage_t *pMsgIn)
-{
-	mlmeMessage_t *pMsg;
-	mlmeAssociateRes_t *pAssocRes;
-	uint8_t selectedAddress = 0x01;
-	resultType_t requestResolution = gSuccess_c;
-
-	if(mReservedAddress)
-	{
-		return mwErrorNoError;
-	}
-
-	/* Allocate a message for the MLME */
-	pMsg = MSG_AllocType(mlmeMessage_t);
-	if(pMsg != NULL)
-	{
-		/* This is a MLME-ASSOCIATE.res command */
-		pMsg->msgType = gMlmeAssociateRes_c;
-
-		/* Create the Associate response message data. */
-		pAssocRes = &pMsg->msgData.associateRes;
-
-		/* See if we still have space. */
-		if(0x0F > mAddressesMap)
-		{
-			/* We can assign 1, 2, 4 and 8 as a short address. Check the map and determine
-      the first free address. */
-			while((selectedAddress & mAddressesMap) != 0)
-			{
-				selectedAddress = selectedAddress << 1;
-			}
-
-			pAssocRes->assocShortAddress = selectedAddress;
-
-			/* Association granted.*/
-			requestResolution = gSuccess_c;
-		}
-		else
-		{
-			/* Signal that we do not have a valid short address. */
-			pAssocRes->assocShortAddress = 0xFFFE;
-			requestResolution = gPanAtCapacity_c;
-		}
-
-		/* Association  resolution. */
-		pAssocRes->status = requestResolution;
-
-		/* Do not use security */
-		pAssocRes->securityLevel = gMacSecurityNone_c;
-
-		/* Get the 64 bit address of the device requesting association. */
-		FLib_MemCpy(&pAssocRes->deviceAddress, &pMsgIn->msgData.associateInd.deviceAddress, 8);
-
-		/* Send the Associate Response to the MLME. */
-		if(NWK_MLME_SapHandler( pMsg, mMacInstance ) == gSuccess_c)
-		{
-			if(gSuccess_c == requestResolution)
-			{
-				mReservedAddress |= selectedAddress;
-			}
-			return mwErrorNoError;
-		}
-		else
-		{
-			/* One or more parameters in the message were invalid. */
-			return mwErrorInvalidParameter;
-		}
-	}
-	else
-	{
-		/* Allocation of a message buffer failed. */
-		return mwErrorAllocFailed;
-	}
-}
-
-/******************************************************************************
- * The HandleMcpsInput(mcpsToNwkMessage_t *pMsgIn) function will handle
- * messages from the MCPS, e.g. Data Confirm, and Data Indication.
- *
- ******************************************************************************/
-static void HandleMcpsInput(mcpsToNwkMessage_t *pMsgIn)
-{
-	uint8_t ret = 0;
-
-	(void) ret;       // remove compiler warning
-	switch(pMsgIn->msgType)
-	{
-	/* The MCPS-Data confirm is sent by the MAC to the network
-    or application layer when data has been sent. */
-	case gMcpsDataCnf_c:
-		if(mpPacket){
-			MSG_Free(mpPacket);
-			mpPacket = NULL;
-		}
-
-		if(transmit_request_data_p){
-			MSG_Free(transmit_request_data_p);
-			transmit_request_data_p = NULL;
-		}
-
-		break;
-
-	case gMcpsDataInd_c:
-		break;
-
-	case gMcpsPurgeCnf_c:
-		break;
-
-	default:
-		break;
-	}
-}
-
-
-/******************************************************************************
- * The following functions are called by the MAC to put messages into the
- * Application's queue. They need to be defined even if they are not used
- * in order to avoid linker errors.
- ******************************************************************************/
-
-static resultType_t MLME_NWK_SapHandler (nwkMessage_t* pMsg, instanceId_t instanceId)
-{
-	/* Put the incoming MLME message in the applications input queue. */
-	MSG_Queue(&mMlmeNwkInputQueue, pMsg);
-	OSA_EventSet(mac_event, gAppEvtMessageFromMLME_c);
-	return gSuccess_c;
-}
-
-static resultType_t MCPS_NWK_SapHandler (mcpsToNwkMessage_t* pMsg, instanceId_t instanceId)
-{
-	/* Put the incoming MCPS message in the applications input queue. */
-	MSG_Queue(&mMcpsNwkInputQueue, pMsg);
-	OSA_EventSet(mac_event, gAppEvtMessageFromMCPS_c);
-	return gSuccess_c;
-}
-
-
-
-
+/*
+ * ieee802p15p4_wrapper.c
+ *
+ *  Created on: Sep 4, 2019
+ *      Author: Nico
+ */
+
+/*! *********************************************************************************
+ *************************************************************************************
+ * Include
+ *************************************************************************************
+ ********************************************************************************** */
+/* 802.15.4 */
+#include "EmbeddedTypes.h"
+#include "RNG_Interface.h"
+#include "TimersManager.h"
+#include "FunctionLib.h"
+
+#include "ieee802p15p4_wrapper.h"
+#include "ieee802p15p4_wrapper_cfg.h"
+#include "DeviceTable.h"
+#if mwFastReconnect_d
+#include "NwkParams.h"
+#endif
+#if mwFragmentation_d
+#include "Fragment.h"
+#include "MemManager.h"
+#endif
+#if mwLinkTable_d
+#include "LinkTable.h"
+#include "Phy.h"
+#endif
+#if mwDupFilter_d
+#include "DupFilter.h"
+#endif
+#if mwLatencyStats_d
+#include "LatencyStats.h"
+#endif
+
+#include "PhyInterface.h"
+#include "MpmInterface.h"
+#include "fsl_os_abstraction.h"
+
+/************************************************************************************
+ *************************************************************************************
+ * Private macros
+ *************************************************************************************
+ ************************************************************************************/
+/* The various states of the mac state machine. */
+enum
+{
+	macStateInit,
+	macStateScanActiveStart,
+	macStateScanActiveWaitConfirm,
+	macStateAssociate,
+	macStateAssociateWaitConfirm,
+	macStateWaitInterval,
+	macStateScanEdStart,
+	macStateScanEdWaitConfirm,
+	macStateStartCoordinator,
+	macStateStartCoordinatorWaitConfirm,
+	macStateListen
+};
+
+/* Events */
+#define gAppEvtDummyEvent_c            (1 << 0)
+#define gAppEvtStartCoordinator_c      (1 << 1)
+#define gAppEvtMessageFromMLME_c       (1 << 2)
+#define gAppEvtMessageFromMCPS_c       (1 << 3)
+#define mw_event_connect_request_c     (1 << 4)
+#define mw_event_transmit_request_c    (1 << 5)
+#define gAppEvtStartWait_c             (1 << 6)
+#define mw_event_fragment_c            (1 << 7)
+#define mw_event_flush_c               (1 << 8)
+
+/* Bytes before the payload in the MSDU of a data frame */
+#if mwFragmentation_d || mwCoalescing_d
+#define mwDispatchLen_c                1
+#else
+#define mwDispatchLen_c                0
+#endif
+/* Values of the dispatch byte, next to the ones of Fragment.h */
+#define mwDispatchData_c               0x00    /* A plain frame, the payload follows */
+#define mwDispatchPacked_c             0xF3    /* Payloads each preceded by its length */
+
+#if mwCoalescing_d && ((mwCoalesceMtu_c < 3) || (mwCoalesceMtu_c > mwMaxPayload_c))
+#error "mwCoalesceMtu_c shall be within 3..mwMaxPayload_c"
+#endif
+/* Payload area of a request built by AllocTxBuffer() */
+#define mwTxPayload(pPacket)           ((pPacket)->msgData.dataReq.pMsdu + mwDispatchLen_c)
+
+/* Period [ms] of the fragmentation timer, while a transfer is in progress */
+#define mwFragTickInterval_c           (mwFragAckTimeout_c / 4)
+
+#if mwFragmentation_d && ((mwFragMaxQueuedTx_c == 0) || (mwFragMaxQueuedTx_c > mwMaxPendingTx_c - mwTxHighReservedSlots_c))
+#error "mwFragMaxQueuedTx_c shall be within 1..mwMaxPendingTx_c - mwTxHighReservedSlots_c"
+#endif
+
+/* Value returned by ReserveTxSlot() when all the slots are in use */
+#define mwInvalidTxSlot_c              0xFF
+
+/* The MSDU handle of a request is a multiple of mwMaxPendingTx_c plus the
+ * index of its slot, so a confirm finds its slot without searching */
+#if (mwMaxPendingTx_c == 0) || (mwMaxPendingTx_c > 128) || (mwMaxPendingTx_c & (mwMaxPendingTx_c - 1))
+#error "mwMaxPendingTx_c shall be a power of two, up to 128"
+#endif
+#define mwTxSlotFromHandle(handle)     ((handle) & (mwMaxPendingTx_c - 1))
+
+#if mwTxHighReservedSlots_c >= mwMaxPendingTx_c
+#error "mwTxHighReservedSlots_c shall leave slots to the normal priority requests"
+#endif
+
+#if (mwMaxInFlightNormalTx_c == 0) || (mwMaxInFlightNormalTx_c > mwMaxInFlightTx_c)
+#error "mwMaxInFlightNormalTx_c shall be within 1..mwMaxInFlightTx_c"
+#endif
+
+/* Each instance has its own MAC instance, and the PANs share the transceiver */
+#if (mwMaxInstances_c == 0) || (mwMaxInstances_c > gMacInstancesCnt_c)
+#error "mwMaxInstances_c shall be within 1..gMacInstancesCnt_c"
+#endif
+#if (mwMaxInstances_c > 1) && !gMpmIncluded_d
+#error "mwMaxInstances_c above 1 needs the MPM, set gMpmMaxPANs_c to 2"
+#endif
+#if (mwMaxInstances_c > 1) && (mwDualPanDwellTime_c > 3200)
+#error "mwDualPanDwellTime_c shall be up to 3200 ms"
+#endif
+
+/* States of a transmission slot */
+enum
+{
+	mwTxSlotFree_c,
+	mwTxSlotReserved_c,     /* Buffer handed to the caller, not committed yet */
+	mwTxSlotQueued_c,       /* Committed, waiting in txRing[] for the MAC */
+	mwTxSlotInFlight_c      /* Handed to the MAC, waiting for the confirm */
+};
+
+#if mwLatencyStats_d
+/* Stamps of a request (mwLatencyStats_d): the stage n of mac_get_latency()
+ * goes from the stamp n to the stamp n + 1 */
+enum
+{
+	mwTxStampQueued_c,
+	mwTxStampHandedOver_c,
+	mwTxStampPhyStart_c,    /* Start of the last attempt, from the PHY */
+	mwTxStampPhyDone_c,
+	mwTxStampConfirmed_c,   /* MCPS-DATA.confirm received */
+	mwTxStampDelivered_c,
+	mwTxStamps_c
+};
+
+/* The MAC instances beyond the PHY instances are the other PANs of the first
+ * transceiver (MPM) */
+#define mwPhyInstance(pMw)             (((pMw)->macInstance < gPhyInstancesCnt_c) ? (pMw)->macInstance : 0)
+#endif
+
+/************************************************************************************
+ *************************************************************************************
+ * Private data types
+ *************************************************************************************
+ ************************************************************************************/
+typedef struct _mw_connect_reqest_data{
+	uint8_t channel;        /* Channel of the PAN to start, once selected */
+	uint8_t scan_duration;
+	uint16_t pan_id;
+	uint32_t channel_mask;  /* Channels scanned */
+	void (*evt_hdlr)(void*);
+}mw_connect_request_data_t;
+
+/* One outstanding MCPS-DATA.request. The slot is taken by mac_transmit(),
+ * mac_transmit_async() or mac_tx_buffer_get() and released when the matching
+ * MCPS-DATA.confirm arrives. */
+typedef struct _mw_tx_slot{
+	nwkToMcpsMessage_t* pPacket;
+	mac_tx_callback_t callback;     /* NULL: the confirm goes to evt_hdlr */
+	void* context;
+	uint8_t msduHandle;
+	uint8_t state;
+	uint8_t priority;               /* mac_tx_priority_t */
+#if mwStatistics_d
+	uint32_t committed;             /* TMR_GetTimestamp() when it was queued [us] */
+	uint32_t queueDelay;            /* From committed until handed to the MAC [us] */
+#endif
+#if mwLinkTable_d
+	uint32_t handedOver;            /* TMR_GetTimestamp() when handed to the MAC [us] */
+	uint16_t dest_address;
+#endif
+#if mwLatencyStats_d
+	uint32_t stamps[mwTxStamps_c];  /* LatencyStats_Now() [us] */
+	uint8_t stamped;                /* Stamps set, bit n for the stamp n */
+#endif
+}mw_tx_slot_t;
+
+#if mwCoalescing_d
+/* A frame being packed by mac_transmit_coalesced(). The payloads are written
+ * straight into the request, which holds a transmission slot until sent. */
+typedef struct _mw_pack{
+	nwkToMcpsMessage_t* pPacket;    /* NULL: the entry is free */
+	uint32_t deadline;              /* OSA_TimeGetMsec() to send it at [ms] */
+	uint16_t dest_address;
+	uint8_t length;                 /* Bytes packed, after the dispatch byte */
+}mw_pack_t;
+#endif
+
+#if mwFragmentation_d
+/* A mac_transmit_large() request, until the mac task starts it */
+typedef struct _mw_large_tx{
+	const uint8_t* pData;
+	mac_tx_callback_t callback;
+	void* context;
+	uint16_t dest_address;
+	uint16_t length;
+	bool_t pending;                 /* Not given to Frag_Send() yet */
+	bool_t busy;                    /* Until the callback is called */
+}mw_large_tx_t;
+#endif
+
+/* The state of one PAN: the wrapper serves one per MAC instance, each with
+ * its own mac task, input queues, transmit queue and connection. */
+typedef struct _mw_instance{
+	instanceId_t macInstance;
+	uint8_t connected;
+	uint8_t state;                  /* State of the mac state machine */
+	osaEventId_t event;
+	mw_connect_request_data_t* connect_request_data_p;
+	void (*evt_hdlr)(void*);
+	tmrTimerID_t timer;
+	/* Number of PAN descriptors the last active scan found on each channel */
+	uint8_t scanPanCount[gLogicalChannel26_c - gLogicalChannel11_c + 1];
+	/* Application input queues */
+	anchor_t mlmeNwkInputQueue;
+	anchor_t mcpsNwkInputQueue;
+	/* Information about the PAN we are part of */
+	uint16_t shortAddress;
+	uint16_t panId;
+	panDescriptor_t coordInfo;
+#if mwFastReconnect_d
+	/* Connecting with the saved network parameters, without a scan */
+	bool_t rejoin;
+#endif
+	/* Data requests that are queued or waiting for their confirm */
+	mw_tx_slot_t txSlots[mwMaxPendingTx_c];
+	/* The MSDU handle is a unique data packet identifier, see mwTxSlotFromHandle() */
+	uint8_t msduHandle;
+	/* MCPS-DATA.requests waiting to be handed to the MAC: one ring of slot
+	   indexes per priority class, oldest first. Together they never hold more
+	   than the mwMaxPendingTx_c slots. */
+	uint8_t txRing[mac_tx_priority_max_c][mwMaxPendingTx_c];
+	uint8_t txRingHead[mac_tx_priority_max_c];
+	uint8_t txRingCount[mac_tx_priority_max_c];
+	/* Requests handed to the MAC and not confirmed yet, and the normal priority
+	   ones among them */
+	uint8_t txInFlight;
+	uint8_t txInFlightNormal;
+	/* Slots not free, and their free count for the blocking senders */
+	uint8_t txSlotsUsed;
+	osaSemaphoreId_t txFreeSlots;
+	/* Slots normal priority requests can still take, see mwTxHighReservedSlots_c */
+	osaSemaphoreId_t txNormalSlots;
+	/* Transmit queue watermarks, see mac_tx_set_watermarks() */
+	uint8_t txHighWatermark;
+	uint8_t txLowWatermark;
+	bool_t txAboveHigh;
+	mac_tx_watermark_callback_t txOnHigh;
+	mac_tx_watermark_callback_t txOnLow;
+	/* Devices whose association response waits for its MLME-COMM-STATUS.indication,
+	   NULL for a free slot. The end devices associated to the coordinator are kept
+	   in DeviceTable.c. */
+	deviceTableEntry_t* pendingAssoc[mwMaxPendingAssoc_c];
+	uint8_t pendingAssocCount;
+#if mwStatistics_d
+	mac_wrapper_stats_t stats;
+#endif
+#if mwCoalescing_d
+	mw_pack_t packs[mwCoalesceMaxDest_c];
+	tmrTimerID_t flushTimer;
+#endif
+#if mwFragmentation_d
+	fragInstance_t frag;
+	mw_large_tx_t largeTx;
+	tmrTimerID_t fragTimer;
+	uint8_t fragTxQueued;           /* Fragments not confirmed yet */
+#endif
+}mw_instance_t;
+
+/************************************************************************************
+ *************************************************************************************
+ * Private prototypes
+ *************************************************************************************
+ ************************************************************************************/
+static void mac_task(void* argument);
+static uint8_t WaitMsg(nwkMessage_t *pMsg, uint8_t msgType);
+static uint8_t StartScan(mw_instance_t* pMw, macScanType_t scanType);
+static uint8_t HandleScanActiveConfirm( mw_instance_t* pMw, nwkMessage_t *pMsg, uint16_t pan_id );
+static void WaitIntervalTimeoutHandler(void *pData);
+static uint8_t SendAssociateRequest( mw_instance_t* pMw );
+static uint8_t HandleAssociateConfirm( mw_instance_t* pMw, nwkMessage_t *pMsg );
+static void HandleScanEdConfirm(mw_instance_t* pMw, nwkMessage_t *pMsg);
+static uint8_t StartCoordinator(mw_instance_t* pMw);
+#if mwFastReconnect_d
+static bool_t StartRejoin(mw_instance_t* pMw);
+static void SaveNwkParams(mw_instance_t* pMw, uint8_t role);
+#endif
+static uint8_t ReserveTxSlot(mw_instance_t* pMw, uint8_t priority, uint32_t timeout);
+static void ReleaseTxSlot(mw_instance_t* pMw, uint8_t msduHandle);
+static bool_t CompleteTxSlot(mw_instance_t* pMw, uint8_t msduHandle, resultType_t status);
+static nwkToMcpsMessage_t* BuildDataRequest(mw_instance_t* pMw, uint16_t dest_address, uint8_t length, uint8_t msduHandle);
+static uint8_t AllocTxBuffer(mw_instance_t* pMw, uint16_t dest_address, uint8_t length, uint8_t priority, uint32_t timeout,
+                             nwkToMcpsMessage_t** ppPacket);
+static uint8_t CommitTxBuffer(mw_instance_t* pMw, nwkToMcpsMessage_t* pPacket, uint8_t length);
+static void TransmitData(mw_instance_t* pMw);
+static void RejectTxRequest(mw_instance_t* pMw, uint8_t msduHandle, resultType_t status);
+#if mwStatistics_d
+static void UpdateTxDelayStats(mw_instance_t* pMw, mw_tx_slot_t *pSlot);
+#endif
+#if mwRxZeroCopy_d
+static void HoldRxMsg(mcpsToNwkMessage_t* pMsg);
+#endif
+#if mwLatencyStats_d
+static void StampTxConfirm(mw_instance_t* pMw, mcpsDataCnf_t *pCnf);
+static void RecordTxLatency(mw_tx_slot_t *pSlot);
+#endif
+#if mwLinkTable_d
+static void UpdateLinkTx(mw_instance_t* pMw, mcpsDataCnf_t *pCnf);
+static void CopyLink(uint16_t short_address, const linkTableEntry_t *pLink, mac_link_info_t *pInfo);
+#endif
+static uint8_t HandleMlmeInput(mw_instance_t* pMw, nwkMessage_t *pMsg);
+static uint8_t SendAssociateResponse(mw_instance_t* pMw, nwkMessage_t *pMsgIn);
+static uint8_t FindPendingAssoc(mw_instance_t* pMw, uint64_t deviceAddress);
+static void ResolvePendingAssoc(mw_instance_t* pMw, nwkMessage_t *pMsg);
+static bool_t HandleMcpsInput(mw_instance_t* pMw, mcpsToNwkMessage_t *pMsgIn);
+#if mwCoalescing_d
+static void FlushPacks(mw_instance_t* pMw);
+static void FlushTimerCallback(void *pData);
+static void PackTxConfirm(resultType_t status, void* context);
+static void UnpackRx(mw_instance_t* pMw, mcpsToNwkMessage_t *pMsgIn);
+#endif
+#if mwFragmentation_d
+static void ProcessFragments(mw_instance_t* pMw);
+static void FragTimerCallback(void *pData);
+static bool_t FragSend(fragInstance_t* pInst, uint16_t dest, uint8_t* pFrame, uint8_t length);
+static void FragTxConfirm(resultType_t status, void* context);
+static void FragDeliver(fragInstance_t* pInst, uint16_t src, uint8_t* pData, uint16_t length);
+static void FragTxDone(resultType_t status, void* context);
+static mw_instance_t* FragOwner(fragInstance_t* pInst);
+#endif
+static resultType_t MLME_NWK_SapHandler (nwkMessage_t* pMsg, instanceId_t instanceId);
+static resultType_t MCPS_NWK_SapHandler (mcpsToNwkMessage_t* pMsg, instanceId_t instanceId);
+extern void Mac_SetExtendedAddress(uint8_t *pAddr, instanceId_t instanceId);
+static uint8_t HandleAssociateConfirm( mw_instance_t* pMw, nwkMessage_t *pMsg );
+
+/************************************************************************************
+ *************************************************************************************
+ * Private memory declarations
+ *************************************************************************************
+ ************************************************************************************/
+static uint8_t mac_initialized = FALSE;
+/* One context per PAN, mac_init() binds each one to its MAC instance */
+static mw_instance_t mInstances[mwMaxInstances_c];
+#if mwRxZeroCopy_d
+/* Data indications currently kept by the upper layer, on every instance.
+ * mac_rx_release() only frees one of these. */
+static mcpsToNwkMessage_t* mRxHeld[mwRxMaxHeldMsgs_c];
+static uint8_t mRxHeldMsgs = 0;
+#endif
+
+/* One mac task per instance */
+OSA_TASK_DEFINE(mac_task, gMainThreadPriority_c-1, mwMaxInstances_c, gMainThreadStackSize_c, 0);
+
+/************************************************************************************
+ *************************************************************************************
+ * Public memory declarations
+ *************************************************************************************
+ ************************************************************************************/
+
+/************************************************************************************
+ *************************************************************************************
+ * Public functions
+ *************************************************************************************
+ ************************************************************************************/
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_init
+ * Description   : Initializes the ieee802.15.4 data link layer custom wrapper.
+ *                 This is a blocking function.
+ *
+ * Params: mac_addr - Pointer to a 8 bytes array that contains the board's MAC
+ *                    address.
+ *
+ * Return: int: 0 - success.
+ *
+ *END**************************************************************************/
+int mac_init(uint8_t* pAddr)
+{
+	mw_instance_t *pMw;
+	uint8_t i;
+
+	/*****************************************/
+	/* Initialize the ieee802.15.4 MAC stack */
+	/*****************************************/
+	if(mac_initialized) {
+		return mwErrorAlreadyInitialized;
+	}
+
+#if gTraceEnabled_d
+	/* Before the PHY, its interrupts are traced */
+	Trace_Init();
+#endif
+	Phy_Init();
+	RNG_Init(); /* RNG must be initialized after the PHY is Initialized */
+	MAC_Init();
+
+	DeviceTable_Init();
+#if mwLinkTable_d
+	LinkTable_Init();
+#endif
+#if mwDupFilter_d
+	DupFilter_Init();
+#endif
+#if mwLatencyStats_d
+	LatencyStats_Init();
+#endif
+
+	for(i = 0; i < mwMaxInstances_c; i++) {
+		pMw = &mInstances[i];
+		FLib_MemSet(pMw, 0, sizeof(mw_instance_t));
+
+		/* Bind to MAC layer. The SAP handlers get the instance index back. */
+		pMw->macInstance = BindToMAC( (instanceId_t)i );
+		if(pMw->macInstance == gInvalidInstanceId_c) {
+			return mwErrorNotSuccessful;
+		}
+
+		Mac_RegisterSapHandlers( MCPS_NWK_SapHandler, MLME_NWK_SapHandler, pMw->macInstance );
+
+		/* Prepare input queues.*/
+		MSG_InitQueue(&pMw->mlmeNwkInputQueue);
+		MSG_InitQueue(&pMw->mcpsNwkInputQueue);
+		pMw->txFreeSlots = OSA_SemaphoreCreate(mwMaxPendingTx_c);
+		pMw->txNormalSlots = OSA_SemaphoreCreate(mwMaxPendingTx_c - mwTxHighReservedSlots_c);
+		pMw->txHighWatermark = mwMaxPendingTx_c;
+		pMw->shortAddress = 0xFFFF;
+		pMw->panId = 0xFFFF;
+		/* Initialize the MAC 802.15.4 extended address */
+		Mac_SetExtendedAddress( pAddr, pMw->macInstance );
+
+		/******************************/
+		/* Initialize the mac wrapper */
+		/******************************/
+		pMw->event = OSA_EventCreate(TRUE);
+		pMw->state = macStateInit;
+		pMw->timer = TMR_AllocateTimer();
+#if mwCoalescing_d
+		pMw->flushTimer = TMR_AllocateTimer();
+#endif
+#if mwFragmentation_d
+		Frag_Init(&pMw->frag, mwFragWindow_c, FragSend, FragDeliver);
+		pMw->fragTimer = TMR_AllocateTimer();
+#endif
+		/* Create the mac task of the instance */
+		OSA_TaskCreate(OSA_TASK(mac_task), pMw);
+	}
+
+#if (mwMaxInstances_c > 1) && mwDualPanDwellTime_c
+	(void)mac_set_dual_pan_dwell(mwDualPanDwellTime_c);
+#endif
+
+	/****************************/
+	/* Initialization completed */
+	/****************************/
+	mac_initialized = TRUE;
+	return 0;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_connect
+ * Description   : Commands the node to connect to a ieee802.15.4 network, if
+ *                 the network does not exists then the node starts it.
+ *                 mac_init() has to be called first.
+ *                 This is a non-blocking function. The result of the connection
+ *                 request will be recibed in a call to the event handler
+ *                 callback (evt_hdlr).
+ *
+ * Params: channel  - Channel to start the network (11-26).
+ *         pan_id   - Id of the network
+ *         evt_hdlr - Pointer to a callback function that will be called by the
+ *                    mac wrapper to signal events on the MAC layer to the
+ *                    calling layer. The events received by this callback are:
+ *                    * Data reception.
+ *                    * Data Transmission confirm.
+ *                    * Network Connection.
+ *                    * Network Disconnections
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - The channel is not in 11-26.
+ *
+ *END**************************************************************************/
+int mac_connect(uint8_t channel, uint16_t pan_id, void (*evt_hdlr)(void*))
+{
+	return mac_connect_on(0, channel, pan_id, evt_hdlr);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_connect_on
+ * Description   : Same as mac_connect(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_connect().
+ *
+ * Return: see mac_connect().
+ *
+ *END**************************************************************************/
+int mac_connect_on(uint8_t instance, uint8_t channel, uint16_t pan_id, void (*evt_hdlr)(void*))
+{
+	uint32_t channel_mask = 0;
+
+	if((channel >= gLogicalChannel11_c) && (channel <= gLogicalChannel26_c)) {
+		channel_mask = (uint32_t)1 << channel;
+	}
+
+	return mac_connect_scan_on(instance, channel_mask, mwScanDuration_c, pan_id, evt_hdlr);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_connect_scan
+ * Description   : Same as mac_connect(), but the network is looked for on
+ *                 every channel of channel_mask, scan_duration per channel.
+ *                 If it is not found, the node starts it on the quietest of
+ *                 them: the one with the lowest energy measured by an ED
+ *                 scan, counting the other PANs heard on the channels as
+ *                 energy too (mwScanPanPenalty_c).
+ *                 mac_init() has to be called first.
+ *                 This is a non-blocking function. The result of the
+ *                 connection request will be recibed in a call to the event
+ *                 handler callback (evt_hdlr).
+ *
+ * Params: channel_mask  - Channels to scan, see mwChannelMask() and
+ *                         mwChannelMaskAll_c.
+ *         scan_duration - Scan duration per channel (0-14). A channel takes
+ *                         15.36 ms * (2^scan_duration + 1) per scan.
+ *         pan_id        - Id of the network
+ *         evt_hdlr      - Event callback, see mac_connect().
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - No channel in 11-26 or a channel
+ *                                        outside of it, or a duration above 14.
+ *
+ *END**************************************************************************/
+int mac_connect_scan(uint32_t channel_mask, uint8_t scan_duration, uint16_t pan_id, void (*evt_hdlr)(void*))
+{
+	return mac_connect_scan_on(0, channel_mask, scan_duration, pan_id, evt_hdlr);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_connect_scan_on
+ * Description   : Same as mac_connect_scan(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_connect_scan().
+ *
+ * Return: see mac_connect_scan().
+ *
+ *END**************************************************************************/
+int mac_connect_scan_on(uint8_t instance, uint32_t channel_mask, uint8_t scan_duration, uint16_t pan_id, void (*evt_hdlr)(void*))
+{
+	mw_instance_t *pMw;
+	uint8_t channel = gLogicalChannel11_c;
+
+	if(instance >= mwMaxInstances_c) {
+		return mwErrorInvalidParameter;
+	}
+	pMw = &mInstances[instance];
+
+	/* The MAC shall not be connected yet and there should not be a connection
+	 * in progress */
+	if(pMw->connected || (pMw->connect_request_data_p != NULL)) {
+		return mwErrorAlreadyConnected;
+	}
+
+	if(((channel_mask & mwChannelMaskAll_c) == 0) || (channel_mask & ~mwChannelMaskAll_c) ||
+	   (scan_duration > 14)) {
+		return mwErrorInvalidParameter;
+	}
+
+	/* Allocate memory for the request */
+	pMw->connect_request_data_p = MSG_Alloc(sizeof(mw_connect_request_data_t));
+	if(pMw->connect_request_data_p == NULL) {
+		return mwErrorAllocFailed;
+	}
+
+	/* Until the ED scan selects one, the PAN would start on the lowest channel */
+	while(!(channel_mask & ((uint32_t)1 << channel))) {
+		channel++;
+	}
+
+	/* Fill the message */
+	pMw->connect_request_data_p->channel = channel;
+	pMw->connect_request_data_p->channel_mask = channel_mask;
+	pMw->connect_request_data_p->scan_duration = scan_duration;
+	pMw->connect_request_data_p->pan_id = pan_id;
+	pMw->connect_request_data_p->evt_hdlr = evt_hdlr;
+
+	/* Signal the mac wrapper task */
+	OSA_EventSet(pMw->event, mw_event_connect_request_c);
+
+	return mwErrorNoError;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit
+ * Description   : Commands the node to send data to another node over a
+ *                 ieee802.15.4 network.
+ *                 mac_connect() has to be called before hand.
+ *                 This is a non-blocking function. The result of the
+ *                 transmission request will be recibed in a call to the event
+ *                 handler callback (evt_hdlr).
+ *
+ *
+ * Params: dest_address  - Address of the data's destination node.
+ *         data   - Pointer to the data array to transmit
+ *         data_len - Size in bytes of the data array.
+ *
+ * Return: int: 0 - success.
+ *
+ *END**************************************************************************/
+int mac_transmit(uint16_t dest_address, uint8_t* data, uint8_t data_len)
+{
+	return mac_transmit_on(0, dest_address, data, data_len);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_on
+ * Description   : Same as mac_transmit(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit().
+ *
+ * Return: see mac_transmit().
+ *
+ *END**************************************************************************/
+int mac_transmit_on(uint8_t instance, uint16_t dest_address, uint8_t* data, uint8_t data_len)
+{
+	mw_instance_t *pMw;
+	nwkToMcpsMessage_t *pPacket;
+	uint8_t rc;
+
+	if(instance >= mwMaxInstances_c) {
+		return mwErrorInvalidParameter;
+	}
+	pMw = &mInstances[instance];
+
+	if(data == NULL) {
+		return mwErrorInvalidParameter;
+	}
+
+	/* Build the MCPS-DATA.request directly with the caller's payload */
+	rc = AllocTxBuffer(pMw, dest_address, data_len, mac_tx_priority_normal_c, 0, &pPacket);
+	if(rc != mwErrorNoError) {
+		return rc;
+	}
+	FLib_MemCpy(mwTxPayload(pPacket), data, data_len);
+
+	return CommitTxBuffer(pMw, pPacket, data_len);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_wait
+ * Description   : Same as mac_transmit(), but when mwMaxPendingTx_c requests
+ *                 are outstanding the calling task blocks until one of them
+ *                 is confirmed, or until the timeout expires. The result of
+ *                 the transmission is received in a call to the event
+ *                 handler callback (evt_hdlr).
+ *                 Only for tasks: the mac task frees the slots, it shall not
+ *                 call this function and neither shall the event handler.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         data         - Pointer to the data array to transmit.
+ *         data_len     - Size in bytes of the data array.
+ *         timeout_ms   - Maximum time to wait for room in the queue,
+ *                        osaWaitForever_c to wait as long as needed.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorTxQueueFull - Still full after timeout_ms.
+ *
+ *END**************************************************************************/
+int mac_transmit_wait(uint16_t dest_address, uint8_t* data, uint8_t data_len, uint32_t timeout_ms)
+{
+	return mac_transmit_wait_on(0, dest_address, data, data_len, timeout_ms);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_wait_on
+ * Description   : Same as mac_transmit_wait(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit_wait().
+ *
+ * Return: see mac_transmit_wait().
+ *
+ *END**************************************************************************/
+int mac_transmit_wait_on(uint8_t instance, uint16_t dest_address, uint8_t* data, uint8_t data_len,
+                         uint32_t timeout_ms)
+{
+	mw_instance_t *pMw;
+	nwkToMcpsMessage_t *pPacket;
+	uint8_t rc;
+
+	if(instance >= mwMaxInstances_c) {
+		return mwErrorInvalidParameter;
+	}
+	pMw = &mInstances[instance];
+
+	if(data == NULL) {
+		return mwErrorInvalidParameter;
+	}
+
+	rc = AllocTxBuffer(pMw, dest_address, data_len, mac_tx_priority_normal_c, timeout_ms, &pPacket);
+	if(rc != mwErrorNoError) {
+		return rc;
+	}
+	FLib_MemCpy(mwTxPayload(pPacket), data, data_len);
+
+	return CommitTxBuffer(pMw, pPacket, data_len);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_priority
+ * Description   : Same as mac_transmit(), in the given priority class.
+ *                 A high priority request is handed to the MAC before any
+ *                 queued normal priority one, and waits for at most one
+ *                 normal priority request already in the MAC. High priority
+ *                 requests can also use the mwTxHighReservedSlots_c slots
+ *                 that normal priority traffic never takes.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         data         - Pointer to the data array to transmit.
+ *         data_len     - Size in bytes of the data array.
+ *         priority     - mac_tx_priority_normal_c or mac_tx_priority_high_c.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorTxQueueFull - No slot left for the priority class.
+ *
+ *END**************************************************************************/
+int mac_transmit_priority(uint16_t dest_address, uint8_t* data, uint8_t data_len, mac_tx_priority_t priority)
+{
+	return mac_transmit_priority_on(0, dest_address, data, data_len, priority);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_priority_on
+ * Description   : Same as mac_transmit_priority(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit_priority().
+ *
+ * Return: see mac_transmit_priority().
+ *
+ *END**************************************************************************/
+int mac_transmit_priority_on(uint8_t instance, uint16_t dest_address, uint8_t* data, uint8_t data_len, mac_tx_priority_t priority)
+{
+	mw_instance_t *pMw;
+	nwkToMcpsMessage_t *pPacket;
+	uint8_t rc;
+
+	if(instance >= mwMaxInstances_c) {
+		return mwErrorInvalidParameter;
+	}
+	pMw = &mInstances[instance];
+
+	if((data == NULL) || (priority >= mac_tx_priority_max_c)) {
+		return mwErrorInvalidParameter;
+	}
+
+	rc = AllocTxBuffer(pMw, dest_address, data_len, priority, 0, &pPacket);
+	if(rc != mwErrorNoError) {
+		return rc;
+	}
+	FLib_MemCpy(mwTxPayload(pPacket), data, data_len);
+
+	return CommitTxBuffer(pMw, pPacket, data_len);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_async
+ * Description   : Same as mac_transmit(), but the result of the transmission
+ *                 is given to tx_cb, with tx_ctx, instead of the event
+ *                 handler callback. Each request has its own callback and
+ *                 context.
+ *                 tx_cb is called from the mac task once the MAC confirms
+ *                 the request, or rejects it. It may transmit again.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         data         - Pointer to the data array to transmit, copied
+ *                        before the function returns.
+ *         data_len     - Size in bytes of the data array.
+ *         tx_cb        - Completion callback, called exactly once.
+ *         tx_ctx       - Passed to tx_cb as is.
+ *
+ * Return: int: 0 - success, tx_cb will be called.
+ *              mwErrorTxQueueFull - mwMaxPendingTx_c requests are waiting
+ *                                   for confirm, try again later.
+ *              Any other error: tx_cb will not be called.
+ *
+ *END**************************************************************************/
+int mac_transmit_async(uint16_t dest_address, uint8_t* data, uint8_t data_len,
+                       mac_tx_callback_t tx_cb, void* tx_ctx)
+{
+	return mac_transmit_async_on(0, dest_address, data, data_len, tx_cb, tx_ctx);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_async_on
+ * Description   : Same as mac_transmit_async(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit_async().
+ *
+ * Return: see mac_transmit_async().
+ *
+ *END**************************************************************************/
+int mac_transmit_async_on(uint8_t instance, uint16_t dest_address, uint8_t* data, uint8_t data_len,
+                          mac_tx_callback_t tx_cb, void* tx_ctx)
+{
+	mw_instance_t *pMw;
+	nwkToMcpsMessage_t *pPacket;
+	uint8_t rc;
+
+	if(instance >= mwMaxInstances_c) {
+		return mwErrorInvalidParameter;
+	}
+	pMw = &mInstances[instance];
+
+	if((data == NULL) || (tx_cb == NULL)) {
+		return mwErrorInvalidParameter;
+	}
+
+	rc = AllocTxBuffer(pMw, dest_address, data_len, mac_tx_priority_normal_c, 0, &pPacket);
+	if(rc != mwErrorNoError) {
+		return rc;
+	}
+	FLib_MemCpy(mwTxPayload(pPacket), data, data_len);
+
+	/* The slot is still reserved, the mac task does not look at it yet */
+	pMw->txSlots[mwTxSlotFromHandle(pPacket->msgData.dataReq.msduHandle)].callback = tx_cb;
+	pMw->txSlots[mwTxSlotFromHandle(pPacket->msgData.dataReq.msduHandle)].context = tx_ctx;
+
+	return CommitTxBuffer(pMw, pPacket, data_len);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_buffer_get
+ * Description   : Reserves a transmission slot and returns the MSDU area of
+ *                 an already built MCPS-DATA.request, so the caller can write
+ *                 its payload in place. The buffer has to be handed back with
+ *                 mac_tx_buffer_commit().
+ *                 mac_connect() has to be called before hand.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         max_len      - Maximum number of bytes that will be written.
+ *
+ * Return: uint8_t*: Pointer to max_len bytes of payload area.
+ *                   NULL if not connected, max_len is invalid, all the
+ *                   transmission slots are in use or no buffer is available.
+ *
+ *END**************************************************************************/
+uint8_t* mac_tx_buffer_get(uint16_t dest_address, uint8_t max_len)
+{
+	return mac_tx_buffer_get_on(0, dest_address, max_len);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_buffer_get_on
+ * Description   : Same as mac_tx_buffer_get(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_tx_buffer_get().
+ *
+ * Return: see mac_tx_buffer_get().
+ *
+ *END**************************************************************************/
+uint8_t* mac_tx_buffer_get_on(uint8_t instance, uint16_t dest_address, uint8_t max_len)
+{
+	mw_instance_t *pMw;
+	nwkToMcpsMessage_t *pPacket;
+
+	if(instance >= mwMaxInstances_c) {
+		return NULL;
+	}
+	pMw = &mInstances[instance];
+
+	if(AllocTxBuffer(pMw, dest_address, max_len, mac_tx_priority_normal_c, 0, &pPacket) != mwErrorNoError) {
+		return NULL;
+	}
+
+	return mwTxPayload(pPacket);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_buffer_commit
+ * Description   : Queues for transmission a buffer obtained with
+ *                 mac_tx_buffer_get(). The result of the transmission is
+ *                 received in a call to the event handler callback
+ *                 (evt_hdlr), the same as for mac_transmit().
+ *                 The buffer shall not be used after this call.
+ *
+ * Params: buffer   - Pointer returned by mac_tx_buffer_get().
+ *         data_len - Number of bytes written, up to the max_len requested.
+ *                    A length of 0 drops the buffer without transmitting it.
+ *
+ * Return: int: 0 - success.
+ *
+ *END**************************************************************************/
+int mac_tx_buffer_commit(uint8_t* buffer, uint8_t data_len)
+{
+	return mac_tx_buffer_commit_on(0, buffer, data_len);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_buffer_commit_on
+ * Description   : Same as mac_tx_buffer_commit(), for a buffer obtained with
+ *                 mac_tx_buffer_get_on() on the same wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_tx_buffer_commit().
+ *
+ * Return: see mac_tx_buffer_commit().
+ *              mwErrorInvalidParameter - The buffer is not one of the
+ *                                        instance.
+ *
+ *END**************************************************************************/
+int mac_tx_buffer_commit_on(uint8_t instance, uint8_t* buffer, uint8_t data_len)
+{
+	mw_instance_t *pMw;
+
+	if(instance >= mwMaxInstances_c) {
+		return mwErrorInvalidParameter;
+	}
+	pMw = &mInstances[instance];
+
+	if(buffer == NULL) {
+		return mwErrorInvalidParameter;
+	}
+
+	/* The payload lives right after the MCPS message, see BuildDataRequest() */
+	return CommitTxBuffer(pMw, (nwkToMcpsMessage_t*)(buffer - mwDispatchLen_c - sizeof(nwkToMcpsMessage_t)), data_len);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_set_watermarks
+ * Description   : Sets the transmit queue watermarks. on_high is called when
+ *                 the number of outstanding requests reaches high, from the
+ *                 task whose request filled the queue that far. on_low is
+ *                 called from the mac task when it drops back to low. Each
+ *                 one is called once per crossing, alternately.
+ *
+ * Params: high    - Outstanding requests that call on_high, 1 to
+ *                   mwMaxPendingTx_c.
+ *         low     - Outstanding requests that call on_low, below high.
+ *         on_high - Callback, may be NULL.
+ *         on_low  - Callback, may be NULL.
+ *
+ * Return: int: 0 - success.
+ *
+ *END**************************************************************************/
+int mac_tx_set_watermarks(uint8_t high, uint8_t low,
+                          mac_tx_watermark_callback_t on_high, mac_tx_watermark_callback_t on_low)
+{
+	return mac_tx_set_watermarks_on(0, high, low, on_high, on_low);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_set_watermarks_on
+ * Description   : Same as mac_tx_set_watermarks(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_tx_set_watermarks().
+ *
+ * Return: see mac_tx_set_watermarks().
+ *
+ *END**************************************************************************/
+int mac_tx_set_watermarks_on(uint8_t instance, uint8_t high, uint8_t low,
+                             mac_tx_watermark_callback_t on_high, mac_tx_watermark_callback_t on_low)
+{
+	mw_instance_t *pMw;
+
+	if(instance >= mwMaxInstances_c) {
+		return mwErrorInvalidParameter;
+	}
+	pMw = &mInstances[instance];
+
+	if((high == 0) || (high > mwMaxPendingTx_c) || (low >= high)) {
+		return mwErrorInvalidParameter;
+	}
+
+	OSA_InterruptDisable();
+	pMw->txHighWatermark = high;
+	pMw->txLowWatermark = low;
+	pMw->txOnHigh = on_high;
+	pMw->txOnLow = on_low;
+	pMw->txAboveHigh = (pMw->txSlotsUsed >= high);
+	OSA_InterruptEnable();
+
+	return mwErrorNoError;
+}
+
+#if mwCoalescing_d
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_coalesced
+ * Description   : Same as mac_transmit(), but the payload is packed with the
+ *                 next ones for the same destination, see FlushPacks(). A
+ *                 packed frame is a dispatch byte, then each payload preceded
+ *                 by its length.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         data         - Pointer to the data array to transmit.
+ *         data_len     - Size in bytes of the data array, up to
+ *                        mwCoalesceMtu_c - 2.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorTxQueueFull - No slot for a new frame.
+ *
+ *END**************************************************************************/
+int mac_transmit_coalesced(uint16_t dest_address, uint8_t* data, uint8_t data_len)
+{
+	return mac_transmit_coalesced_on(0, dest_address, data, data_len);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_coalesced_on
+ * Description   : Same as mac_transmit_coalesced(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit_coalesced().
+ *
+ * Return: see mac_transmit_coalesced().
+ *
+ *END**************************************************************************/
+int mac_transmit_coalesced_on(uint8_t instance, uint16_t dest_address, uint8_t* data, uint8_t data_len)
+{
+	mw_instance_t *pMw;
+	nwkToMcpsMessage_t *pFull = NULL;
+	nwkToMcpsMessage_t *pPacket;
+	mw_pack_t *pPack = NULL;
+	uint8_t fullLength = 0;
+	uint8_t *pEntry;
+	uint8_t rc;
+	uint8_t i;
+
+	if(instance >= mwMaxInstances_c) {
+		return mwErrorInvalidParameter;
+	}
+	pMw = &mInstances[instance];
+
+	if((data == NULL) || (data_len == 0) || (data_len > mwCoalesceMtu_c - 2)) {
+		return mwErrorInvalidParameter;
+	}
+
+	/* Append to the frame being packed for the destination, if it fits */
+	OSA_InterruptDisable();
+	for(i = 0; i < mwCoalesceMaxDest_c; i++)
+	{
+		if((pMw->packs[i].pPacket != NULL) && (pMw->packs[i].dest_address == dest_address))
+		{
+			pPack = &pMw->packs[i];
+			break;
+		}
+	}
+	if(pPack != NULL)
+	{
+		if(mwDispatchLen_c + pPack->length + 1 + data_len <= mwCoalesceMtu_c)
+		{
+			pEntry = mwTxPayload(pPack->pPacket) + pPack->length;
+			pEntry[0] = data_len;
+			FLib_MemCpy(&pEntry[1], data, data_len);
+			pPack->length += 1 + data_len;
+#if mwStatistics_d
+			pMw->stats.packed_msgs++;
+#endif
+			if(mwDispatchLen_c + pPack->length + 2 <= mwCoalesceMtu_c)
+			{
+				OSA_InterruptEnable();
+				return mwErrorNoError;
+			}
+			/* Not even one more byte fits: send it now */
+			data_len = 0;
+		}
+		/* Full: send it */
+		pFull = pPack->pPacket;
+		fullLength = pPack->length;
+		pPack->pPacket = NULL;
+	}
+	OSA_InterruptEnable();
+
+	if(pFull != NULL)
+	{
+		(void)CommitTxBuffer(pMw, pFull, fullLength);
+	}
+
+	if(data_len == 0)
+	{
+		return mwErrorNoError;
+	}
+
+	rc = AllocTxBuffer(pMw, dest_address, mwCoalesceMtu_c - mwDispatchLen_c, mac_tx_priority_normal_c, 0, &pPacket);
+	if(rc != mwErrorNoError) {
+		return rc;
+	}
+	pPacket->msgData.dataReq.pMsdu[0] = mwDispatchPacked_c;
+	pEntry = mwTxPayload(pPacket);
+	pEntry[0] = data_len;
+	FLib_MemCpy(&pEntry[1], data, data_len);
+
+	/* The confirm does not go to the upper layer */
+	pMw->txSlots[mwTxSlotFromHandle(pPacket->msgData.dataReq.msduHandle)].callback = PackTxConfirm;
+	pMw->txSlots[mwTxSlotFromHandle(pPacket->msgData.dataReq.msduHandle)].context = pMw;
+
+	OSA_InterruptDisable();
+#if mwStatistics_d
+	pMw->stats.packed_msgs++;
+#endif
+	for(i = 0; i < mwCoalesceMaxDest_c; i++)
+	{
+		if(pMw->packs[i].pPacket == NULL)
+		{
+			pMw->packs[i].pPacket = pPacket;
+			pMw->packs[i].dest_address = dest_address;
+			pMw->packs[i].length = 1 + data_len;
+			pMw->packs[i].deadline = OSA_TimeGetMsec() + mwCoalesceFlushTime_c;
+			pPacket = NULL;
+			break;
+		}
+	}
+	OSA_InterruptEnable();
+
+	if(pPacket != NULL)
+	{
+		/* Every entry is in use: no packing for this one */
+		return CommitTxBuffer(pMw, pPacket, 1 + data_len);
+	}
+
+	if(!TMR_IsTimerActive(pMw->flushTimer))
+	{
+		TMR_StartSingleShotTimer(pMw->flushTimer, mwCoalesceFlushTime_c, FlushTimerCallback, pMw);
+	}
+	return mwErrorNoError;
+}
+#endif
+
+#if mwFragmentation_d
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_large
+ * Description   : Sends up to mwFragMaxLength_c bytes as a train of
+ *                 fragments, see Fragment.c. The mac task starts the
+ *                 transfer, and calls tx_cb once it is over.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         data         - Payload, not copied: it shall stay untouched until
+ *                        tx_cb is called.
+ *         data_len     - Size in bytes of the payload.
+ *         tx_cb        - Completion callback.
+ *         tx_ctx       - Passed to tx_cb as is.
+ *
+ * Return: int: 0 - success, tx_cb will be called.
+ *              mwErrorTransmissionInprogress - A transfer is in progress.
+ *
+ *END**************************************************************************/
+int mac_transmit_large(uint16_t dest_address, const uint8_t* data, uint16_t data_len,
+                       mac_tx_callback_t tx_cb, void* tx_ctx)
+{
+	return mac_transmit_large_on(0, dest_address, data, data_len, tx_cb, tx_ctx);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_large_on
+ * Description   : Same as mac_transmit_large(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit_large().
+ *
+ * Return: see mac_transmit_large().
+ *
+ *END**************************************************************************/
+int mac_transmit_large_on(uint8_t instance, uint16_t dest_address, const uint8_t* data, uint16_t data_len,
+                          mac_tx_callback_t tx_cb, void* tx_ctx)
+{
+	mw_instance_t *pMw;
+	uint8_t rc = mwErrorNoError;
+
+	if(instance >= mwMaxInstances_c) {
+		return mwErrorInvalidParameter;
+	}
+	pMw = &mInstances[instance];
+
+	if((data == NULL) || (tx_cb == NULL) || (data_len == 0) || (data_len > mwFragMaxLength_c)) {
+		return mwErrorInvalidParameter;
+	}
+
+	/* The MAC shall be connected yet */
+	if(!pMw->connected) {
+		return mwErrorAlreadyConnected;
+	}
+
+	OSA_InterruptDisable();
+	if(pMw->largeTx.busy)
+	{
+		rc = mwErrorTransmissionInprogress;
+	}
+	else
+	{
+		pMw->largeTx.pData = data;
+		pMw->largeTx.callback = tx_cb;
+		pMw->largeTx.context = tx_ctx;
+		pMw->largeTx.dest_address = dest_address;
+		pMw->largeTx.length = data_len;
+		pMw->largeTx.pending = TRUE;
+		pMw->largeTx.busy = TRUE;
+	}
+	OSA_InterruptEnable();
+
+	if(rc == mwErrorNoError)
+	{
+		OSA_EventSet(pMw->event, mw_event_fragment_c);
+	}
+	return rc;
+}
+#endif
+
+#if mwRxZeroCopy_d
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_rx_release
+ * Description   : Releases a data indication kept by the event handler
+ *                 callback (see can_retain/retained in mac_event_data_t).
+ *
+ * Params: pMsg - Message received in evt_data.data_event_data.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - pMsg is not a data indication kept
+ *                                        by the upper layer, it is not freed.
+ *
+ *END**************************************************************************/
+int mac_rx_release(mcpsToNwkMessage_t* pMsg)
+{
+	uint8_t i;
+
+	if(pMsg == NULL) {
+		return mwErrorInvalidParameter;
+	}
+
+	OSA_InterruptDisable();
+	for(i = 0; i < mwRxMaxHeldMsgs_c; i++)
+	{
+		if(mRxHeld[i] == pMsg)
+		{
+			mRxHeld[i] = NULL;
+			mRxHeldMsgs--;
+			break;
+		}
+	}
+	OSA_InterruptEnable();
+
+	/* Released already, or never kept */
+	if(i == mwRxMaxHeldMsgs_c) {
+		return mwErrorInvalidParameter;
+	}
+
+	MSG_Free(pMsg);
+	return mwErrorNoError;
+}
+#endif
+
+#if mwStatistics_d
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_stats
+ * Description   : Copies the wrapper statistics.
+ *
+ * Params: pStats - Where to copy the statistics.
+ *         reset  - TRUE to clear the counters after reading them.
+ *
+ * Return: int: 0 - success.
+ *
+ *END**************************************************************************/
+int mac_get_stats(mac_wrapper_stats_t* pStats, bool_t reset)
+{
+	return mac_get_stats_on(0, pStats, reset);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_stats_on
+ * Description   : Same as mac_get_stats(), on the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_get_stats().
+ *
+ * Return: see mac_get_stats().
+ *
+ *END**************************************************************************/
+int mac_get_stats_on(uint8_t instance, mac_wrapper_stats_t* pStats, bool_t reset)
+{
+	mw_instance_t *pMw;
+	if(pStats == NULL) {
+		return mwErrorInvalidParameter;
+	}
+
+	if(instance >= mwMaxInstances_c) {
+		return mwErrorInvalidParameter;
+	}
+	pMw = &mInstances[instance];
+
+	OSA_InterruptDisable();
+	FLib_MemCpy(pStats, &pMw->stats, sizeof(mac_wrapper_stats_t));
+	if(reset) {
+		FLib_MemSet(&pMw->stats, 0, sizeof(mac_wrapper_stats_t));
+	}
+	OSA_InterruptEnable();
+
+	return mwErrorNoError;
+}
+#endif
+
+#if mwLinkTable_d
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_link
+ * Description   : Copies what the wrapper knows of the link to a neighbor.
+ *                 The record is found from the short address in constant
+ *                 time.
+ *
+ * Params: short_address - Short address of the neighbor.
+ *         pInfo         - Where to copy it.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - Nothing was received from or sent
+ *                                        to the neighbor yet.
+ *
+ *END**************************************************************************/
+int mac_get_link(uint16_t short_address, mac_link_info_t* pInfo)
+{
+	return mac_get_link_on(0, short_address, pInfo);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_link_on
+ * Description   : Same as mac_get_link(), for a neighbor in the PAN of the
+ *                 given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_get_link().
+ *
+ * Return: see mac_get_link().
+ *
+ *END**************************************************************************/
+int mac_get_link_on(uint8_t instance, uint16_t short_address, mac_link_info_t* pInfo)
+{
+	const linkTableEntry_t *pLink;
+	uint8_t rc = mwErrorInvalidParameter;
+
+	if((instance >= mwMaxInstances_c) || (pInfo == NULL)) {
+		return mwErrorInvalidParameter;
+	}
+
+	OSA_InterruptDisable();
+	pLink = LinkTable_Find(instance, short_address);
+	if(pLink != NULL) {
+		CopyLink(short_address, pLink, pInfo);
+		rc = mwErrorNoError;
+	}
+	OSA_InterruptEnable();
+
+	return rc;
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_links
+ * Description   : Copies the links to every known neighbor, by increasing
+ *                 short address. The interrupts are only disabled while
+ *                 one record is copied.
+ *
+ * Params: pInfo     - Array of max_links records.
+ *         max_links - Size of the array.
+ *
+ * Return: uint16_t: Number of records copied.
+ *
+ *END**************************************************************************/
+uint16_t mac_get_links(mac_link_info_t* pInfo, uint16_t max_links)
+{
+	return mac_get_links_on(0, pInfo, max_links);
+}
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_links_on
+ * Description   : Same as mac_get_links(), for the neighbors in the PAN of
+ *                 the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_get_links().
+ *
+ * Return: see mac_get_links().
+ *
+ *END**************************************************************************/
+uint16_t mac_get_links_on(uint8_t instance, mac_link_info_t* pInfo, uint16_t max_links)
+{
+	const linkTableEntry_t *pLink;
+	uint16_t count = 0;
+	uint16_t address;
+
+	if((instance >= mwMaxInstances_c) || (pInfo == NULL)) {
+		return 0;
+	}
+
+	for(address = 0; (address < mwLinkTableSize_c) && (count < max_links); address++)
+	{
+		OSA_InterruptDisable();
+		pLink = LinkTable_Find(instance, address);
+		if(pLink != NULL) {
+			CopyLink(address, pLink, &pInfo[count++]);
+		}
+		OSA_InterruptEnable();
+	}
+
+	return count;
+}
+#endif
+
+#if mwLatencyStats_d
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_latency
+ * Description   : Copies the latency of a stage of the data requests of every
+ *                 instance.
+ *
+ * Params: stage  - Stage, below mac_latency_stages_c.
+ *         pStats - Where to copy it.
+ *         reset  - TRUE to clear the stage after reading it.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - Unknown stage.
+ *
+ *END**************************************************************************/
+int mac_get_latency(mac_latency_stage_t stage, mac_latency_stats_t* pStats, bool_t reset)
+{
+	latencyStats_t stats;
+
+	if((pStats == NULL) || (stage >= mac_latency_stages_c)) {
+		return mwErrorInvalidParameter;
+	}
+
+	/* The stages of the wrapper are the ones of LatencyStats.c */
+	OSA_InterruptDisable();
+	LatencyStats_Get((latencyStage_t)stage, &stats, reset);
+	OSA_InterruptEnable();
+
+	pStats->count = stats.count;
+	pStats->min_us = stats.count ? stats.min : 0;
+	pStats->max_us = stats.max;
+	pStats->avg_us = stats.count ? (uint32_t)(stats.total / stats.count) : 0;
+	FLib_MemCpy(pStats->buckets, stats.buckets, sizeof(pStats->buckets));
+
+	return mwErrorNoError;
+}
+#endif
+
+#if mwMaxInstances_c > 1
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_set_dual_pan_dwell
+ * Description   : Sets the time the receiver stays on one PAN before
+ *                 switching to the other, when the PANs of the two instances
+ *                 are on different channels.
+ *
+ * Params: dwell_ms - Dwell time [ms], 1 to 3200.
+ *
+ * Return: int: 0 - success.
+ *
+ *END**************************************************************************/
+int mac_set_dual_pan_dwell(uint16_t dwell_ms)
+{
+	/* Step [us] of the MPM dwell timer for each prescaler value */
+	static const uint32_t timebase[] = {500, 2500, 10000, 50000};
+	mpmConfig_t cfg;
+	uint32_t steps;
+	uint8_t prescaler = 0;
+
+	if((dwell_ms == 0) || (dwell_ms > 3200)) {
+		return mwErrorInvalidParameter;
+	}
+
+	/* The timer counts up to 64 steps: the finest prescaler that reaches it */
+	while((uint32_t)dwell_ms * 1000 > 64 * timebase[prescaler]) {
+		prescaler++;
+	}
+	steps = ((uint32_t)dwell_ms * 1000 + timebase[prescaler] / 2) / timebase[prescaler];
+
+	MPM_GetConfig(&cfg);
+	cfg.dwellTime = mDualPanDwellTimerSetting(steps - 1, prescaler);
+	MPM_SetConfig(&cfg);
+
+	return mwErrorNoError;
+}
+#endif
+
+/************************************************************************************
+ *************************************************************************************
+ * Private functions
+ *************************************************************************************
+ ************************************************************************************/
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_task
+ * Description   : Wrapper over ieee802.15.4 data link layer.
+ *                 On one wakeup the task runs up to mwMaxMsgsPerWakeup_c
+ *                 passes, each one taking a message from each input queue,
+ *                 before it waits for events again. The messages of these
+ *                 passes reach evt_hdlr one after the other, in the same
+ *                 wakeup, but still with one call per message: each call
+ *                 has its own can_retain/retained, confirms can go to the
+ *                 callback of their own request instead, and an MLME
+ *                 message may change the state the next MCPS message is
+ *                 handled in.
+ *
+ *END**************************************************************************/
+static void mac_task(void* argument)
+{
+	/* Context of the instance served by this task, given by mac_init() */
+	mw_instance_t *pMw = argument;
+	osaEventFlags_t ev;
+	/* Pointer for storing the messages from MLME */
+	void *pMsgIn;
+	mac_event_data_t event_data;
+	/* Stores the status code returned by some functions. */
+	uint8_t rc;
+	/* Input queues still holding messages at the end of a pass */
+	osaEventFlags_t pending = 0;
+	/* Passes left before going back to wait for events */
+	uint8_t budget = 0;
+
+	while(1) {
+		if(pending && budget)
+		{
+			/* Keep draining the input queues without an event round-trip */
+			ev = pending;
+		}
+		else
+		{
+			/* Wait for events */
+			OSA_EventWait(pMw->event, osaEventFlagsAll_c, FALSE, osaWaitForever_c, &ev);
+			budget = mwMaxMsgsPerWakeup_c;
+#if mwStatistics_d
+			pMw->stats.wakeups++;
+#endif
+			TRACE(gTraceMwTaskWakeup_c, ev, pMw - mInstances);
+		}
+		budget--;
+		pMsgIn = NULL;
+		/* Only data indications can be kept by the upper layer */
+		event_data.instance = (uint8_t)(pMw - mInstances);
+		event_data.can_retain = FALSE;
+		event_data.retained = FALSE;
+
+		/* Dequeue the MLME message */
+		if (ev & gAppEvtMessageFromMLME_c)
+		{
+			/* Get the message from MLME */
+			pMsgIn = MSG_DeQueue(&pMw->mlmeNwkInputQueue);
+
+			/* Any time a beacon might arrive. Always handle the beacon frame first */
+			if (pMsgIn)
+			{
+#if mwStatistics_d
+				pMw->stats.mlme_msgs++;
+#endif
+				rc = WaitMsg(pMsgIn, gMlmeBeaconNotifyInd_c);
+				if(rc == mwErrorNoError)
+				{
+					/* ALWAYS free the beacon frame contained in the beacon notify indication.*/
+					/* ALSO the application can use the beacon payload.*/
+					MSG_Free(((nwkMessage_t *)pMsgIn)->msgData.beaconNotifyInd.pBufferRoot);
+				}
+			}
+		}
+
+		switch(pMw->state)
+		{
+		/* State machine */
+		case macStateInit:
+			if((ev & mw_event_connect_request_c) && (NULL != pMw->connect_request_data_p)) {
+#if mwFastReconnect_d
+				/* Rejoin the saved network directly if there is one */
+				if(StartRejoin(pMw)) {
+					break;
+				}
+#endif
+				/* Goto Energy Detection state. */
+				pMw->state = macStateScanActiveStart;
+				OSA_EventSet(pMw->event, gAppEvtDummyEvent_c );
+			}
+			break;
+
+		case macStateScanActiveStart:
+			/* Start the Active scan, and goto wait for confirm state. */
+
+			rc = StartScan( pMw, gScanModeActive_c );
+			if( rc == mwErrorNoError )
+			{
+				pMw->state = macStateScanActiveWaitConfirm;
+			}
+			break;
+
+		case macStateScanActiveWaitConfirm:
+			/* Stay in this state until the Scan confirm message arrives, and then goto
+			 the associate state or do a rescan in case of invalid short address.     */
+			if( ev & gAppEvtMessageFromMLME_c )
+			{
+				if( pMsgIn )
+				{
+					/* Handle the Scan Confirm message. */
+					rc = WaitMsg( pMsgIn, gMlmeScanCnf_c );
+					if( rc == mwErrorNoError )
+					{
+						rc = HandleScanActiveConfirm( pMw, pMsgIn, pMw->connect_request_data_p->pan_id );
+						if( rc == mwErrorNoError )
+						{
+							pMw->state = macStateAssociate;
+							OSA_EventSet(pMw->event, gAppEvtDummyEvent_c );
+						}
+						else
+						{
+							/* Restart scanning */
+							TMR_StartSingleShotTimer( pMw->timer, 7000, WaitIntervalTimeoutHandler, pMw );
+							pMw->state = macStateWaitInterval;
+						}
+					}
+				}
+			}
+			break;
+
+		case macStateWaitInterval:
+			if( ev & gAppEvtStartWait_c )
+			{
+				/* Since the network does not exist on this channel then we can start it */
+				pMw->state = macStateScanEdStart;
+				OSA_EventSet(pMw->event, gAppEvtDummyEvent_c );
+			}
+			break;
+
+		case macStateAssociate:
+			/* Associate to the PAN coordinator */
+			rc = SendAssociateRequest( pMw );
+			if( rc == mwErrorNoError )
+			{
+				pMw->state = macStateAssociateWaitConfirm;
+			}
+			break;
+
+		case macStateAssociateWaitConfirm:
+			/* Stay in this state until the Associate confirm message
+			 arrives, and then goto the Listen state. */
+			if( ev & gAppEvtMessageFromMLME_c )
+			{
+				if( pMsgIn )
+				{
+					rc = WaitMsg( pMsgIn, gMlmeAssociateCnf_c );
+					if( rc == mwErrorNoError )
+					{
+						/* Check for coordinator at full capacity error */
+						if( HandleAssociateConfirm( pMw, pMsgIn ) == mwErrorNoError )
+						{
+#if mwFastReconnect_d
+							pMw->rejoin = FALSE;
+							SaveNwkParams(pMw, mNwkParamsDevice_c);
+#endif
+							/*Call the upper layer callback */
+							pMw->evt_hdlr = pMw->connect_request_data_p->evt_hdlr;
+							if(pMw->evt_hdlr != NULL) {
+								event_data.mac_event_type = mac_management_event_c;
+								event_data.evt_data.management_event_data = (nwkMessage_t*)pMsgIn;
+								pMw->evt_hdlr((void*)&event_data);
+							}
+							/* Release the connection request memory */
+							MSG_Free(pMw->connect_request_data_p);
+							pMw->connect_request_data_p = NULL;
+							pMw->connected = TRUE;
+							/* Go to listen state */
+							pMw->state = macStateListen;
+							OSA_EventSet(pMw->event, gAppEvtDummyEvent_c);
+						}
+#if mwFastReconnect_d
+						else if( pMw->rejoin )
+						{
+							/* The saved coordinator did not answer: look for the network */
+							pMw->rejoin = FALSE;
+							pMw->state = macStateScanActiveStart;
+							OSA_EventSet(pMw->event, gAppEvtDummyEvent_c);
+						}
+#endif
+						else
+						{
+							/* Restart scanning */
+							TMR_StartSingleShotTimer( pMw->timer, 7000, WaitIntervalTimeoutHandler, pMw );
+							pMw->state = macStateWaitInterval;
+						}
+					}
+				}
+			}
+			break;
+
+		case macStateScanEdStart:
+			/* Start the Energy Detection scan, and goto wait for confirm state. */
+			rc = StartScan(pMw, gScanModeED_c);
+			if(rc == mwErrorNoError)
+			{
+				pMw->state = macStateScanEdWaitConfirm;
+			}
+			break;
+
+		case macStateScanEdWaitConfirm:
+			/* Stay in this state until the MLME Scan confirm message arrives,
+			 and has been processed. Then goto Start Coordinator state. */
+			if (ev & gAppEvtMessageFromMLME_c)
+			{
+				if (pMsgIn)
+				{
+					rc = WaitMsg(pMsgIn, gMlmeScanCnf_c);
+					if(rc == mwErrorNoError)
+					{
+						/* Process the ED scan confirm. The logical
+						 channel is selected by this function. */
+						HandleScanEdConfirm(pMw, pMsgIn);
+						pMw->state =macStateStartCoordinator;
+						OSA_EventSet(pMw->event, gAppEvtStartCoordinator_c);
+					}
+				}
+			}
+			break;
+
+		case macStateStartCoordinator:
+			/* Start up as a PAN Coordinator on the selected channel. */
+			if (ev & gAppEvtStartCoordinator_c)
+			{
+				rc = StartCoordinator(pMw);
+				if(rc == mwErrorNoError)
+				{
+					/* If the Start request was sent successfully to
+					 the MLME, then goto Wait for confirm state. */
+					pMw->state = macStateStartCoordinatorWaitConfirm;
+				}
+			}
+			break;
+
+		case macStateStartCoordinatorWaitConfirm:
+			/* Stay in this state until the Start confirm message
+			 arrives, and then goto the Listen state. */
+			if (ev & gAppEvtMessageFromMLME_c)
+			{
+				if (pMsgIn)
+				{
+					rc = WaitMsg(pMsgIn, gMlmeStartCnf_c);
+#if mwFastReconnect_d
+					if((rc == mwErrorNoError) && pMw->rejoin &&
+					   (((nwkMessage_t*)pMsgIn)->msgData.startCnf.status != gSuccess_c))
+					{
+						/* The saved PAN could not be started again: scan first */
+						pMw->rejoin = FALSE;
+						pMw->state = macStateScanActiveStart;
+						OSA_EventSet(pMw->event, gAppEvtDummyEvent_c);
+						rc = mwErrorNotSuccessful;
+					}
+#endif
+					if(rc == mwErrorNoError)
+					{
+						pMw->panId = pMw->connect_request_data_p->pan_id;
+#if mwFastReconnect_d
+						pMw->rejoin = FALSE;
+						SaveNwkParams(pMw, mNwkParamsCoordinator_c);
+#endif
+						/*Call the upper layer callback */
+						pMw->evt_hdlr = pMw->connect_request_data_p->evt_hdlr;
+						if(pMw->evt_hdlr != NULL) {
+							event_data.mac_event_type = mac_management_event_c;
+							event_data.evt_data.management_event_data = (nwkMessage_t*)pMsgIn;
+							pMw->evt_hdlr((void*)&event_data);
+						}
+						/* Release the connection request memory */
+						MSG_Free(pMw->connect_request_data_p);
+						pMw->connect_request_data_p = NULL;
+						pMw->state = macStateListen;
+						pMw->connected = TRUE;
+						OSA_EventSet(pMw->event, gAppEvtDummyEvent_c);
+					}
+				}
+			}
+			break;
+		case macStateListen:
+			/* Stay in this state forever.
+			 Transmit to end device data from serial terminal interface */
+			if (ev & gAppEvtMessageFromMLME_c)
+			{
+				/* Get the message from MLME */
+				if (pMsgIn)
+				{
+					/* Process it */
+					HandleMlmeInput(pMw, pMsgIn);
+					/*Call the upper layer callback */
+					if(pMw->evt_hdlr != NULL) {
+						event_data.mac_event_type = mac_management_event_c;
+						event_data.evt_data.management_event_data = (nwkMessage_t*)pMsgIn;
+						pMw->evt_hdlr((void*)&event_data);
+					}
+					/* Messages from the MLME must always be freed. */
+				}
+			}
+
+			if (ev & mw_event_transmit_request_c)
+			{
+				TransmitData(pMw);
+			}
+
+			break;
+		} /* end switch*/
+
+		/* Free Mlme messages*/
+		if (pMsgIn)
+		{
+			/* Messages must always be freed. */
+			MSG_Free(pMsgIn);
+			pMsgIn = NULL;
+		}
+
+		/* Handle MCPS confirms and transmit data from serial terminal interface */
+		if (ev & gAppEvtMessageFromMCPS_c)
+		{
+			/* Get the message from MCPS */
+			pMsgIn = MSG_DeQueue(&pMw->mcpsNwkInputQueue);
+			if (pMsgIn)
+			{
+#if mwStatistics_d
+				pMw->stats.mcps_msgs++;
+#endif
+				/* Process it, and call the upper layer callback unless the
+				 message went to the callback of its own request */
+				if(HandleMcpsInput(pMw, pMsgIn) && (pMw->evt_hdlr != NULL)) {
+					event_data.mac_event_type = mac_data_event_c;
+					event_data.evt_data.data_event_data = (mcpsToNwkMessage_t*)pMsgIn;
+#if mwRxZeroCopy_d
+					event_data.can_retain = (((mcpsToNwkMessage_t*)pMsgIn)->msgType == gMcpsDataInd_c) &&
+							(mRxHeldMsgs < mwRxMaxHeldMsgs_c);
+#endif
+					pMw->evt_hdlr((void*)&event_data);
+				}
+#if mwRxZeroCopy_d
+				if(event_data.can_retain && event_data.retained)
+				{
+					/* The upper layer owns it now, see mac_rx_release() */
+					HoldRxMsg((mcpsToNwkMessage_t*)pMsgIn);
+				}
+				else
+#endif
+				{
+					/* Messages from the MCPS must always be freed. */
+					MSG_Free(pMsgIn);
+				}
+				pMsgIn = NULL;
+			}
+		}
+
+#if mwCoalescing_d
+		if(ev & mw_event_flush_c)
+		{
+			FlushPacks(pMw);
+		}
+#endif
+
+#if mwFragmentation_d
+		/* A confirm makes room for the next fragments, and an acknowledgement
+		 may ask for some of them again */
+		if(pMw->connected && (ev & (gAppEvtMessageFromMCPS_c | mw_event_fragment_c)))
+		{
+			ProcessFragments(pMw);
+		}
+#endif
+
+		/* A confirm makes room in the MAC for the next queued request */
+		if((pMw->txRingCount[mac_tx_priority_high_c] || pMw->txRingCount[mac_tx_priority_normal_c]) &&
+		   (pMw->txInFlight < mwMaxInFlightTx_c))
+		{
+			TransmitData(pMw);
+		}
+
+		/* Check for pending messages in the Queue */
+		pending = 0;
+		if(MSG_Pending(&pMw->mcpsNwkInputQueue))
+			pending |= gAppEvtMessageFromMCPS_c;
+		if(MSG_Pending(&pMw->mlmeNwkInputQueue))
+			pending |= gAppEvtMessageFromMLME_c;
+
+		/* Out of budget, let the other tasks run and come back for the rest */
+		if(pending && (budget == 0))
+			OSA_EventSet(pMw->event, pending);
+	}
+}
+
+/******************************************************************************
+ * The WaitMsg(nwkMessage_t *pMsg, uint8_t msgType) function does not, as
+ * the name implies, wait for a message, thus blocking the execution of the
+ * state machine. Instead the function analyzes the supplied message to determine
+ * whether or not the message is of the expected type.
+ * The function may return either of the following values:
+ *   mwErrorNoError: The message was of the expected type.
+ *   mwErrorNoMessage: The message pointer is NULL.
+ *   mwErrorWrongConfirm: The message is not of the expected type.
+ *
+ ******************************************************************************/
+static uint8_t WaitMsg(nwkMessage_t *pMsg, uint8_t msgType)
+{
+	/* Do we have a message? If not, the exit with error code */
+	if(pMsg == NULL)
+	{
+		return mwErrorNoMessage;
+	}
+	/* Is it the expected message type? If not then exit with error code */
+	if(pMsg->msgType != msgType)
+	{
+		return mwErrorWrongConfirm;
+	}
+
+	/* Found the expected message. Return with success code */
+	return mwErrorNoError;
+}
+
+/******************************************************************************
+ * The StartScan(scanType) function will start the scan process of the
+ * specified type in the MAC. This is accomplished by allocating a MAC message,
+ * which is then assigned the desired scan parameters and sent to the MLME
+ * service access point. The channels and the duration are the ones of the
+ * connection request.
+ * The function may return either of the following values:
+ *   mwErrorNoError:          The Scan message was sent successfully.
+ *   mwErrorInvalidParameter: The MLME service access point rejected the
+ *                          message due to an invalid parameter.
+ *   mwErrorAllocFailed:      A message buffer could not be allocated.
+ *
+ ******************************************************************************/
+static uint8_t StartScan(mw_instance_t* pMw, macScanType_t scanType)
+{
+	mlmeMessage_t *pMsg;
+	mlmeScanReq_t *pScanReq;
+
+	//Serial_Print(mInterfaceId,"Sending the MLME-Scan Request message to the MAC... ", gAllowToBlock_d);
+
+	/* Allocate a message for the MLME (We should check for NULL). */
+	pMsg = MSG_AllocType(mlmeMessage_t);
+	if(pMsg != NULL)
+	{
+		/* This is a MLME-SCAN.req command */
+		pMsg->msgType = gMlmeScanReq_c;
+		/* Create the Scan request message data. */
+		pScanReq = &pMsg->msgData.scanReq;
+		/* gScanModeED_c, gScanModeActive_c, gScanModePassive_c, or gScanModeOrphan_c */
+		pScanReq->scanType = scanType;
+		/* ChannelsToScan */
+		pScanReq->scanChannels = pMw->connect_request_data_p->channel_mask;
+		/* Duration per channel 0-14 (dc). T[sec] = (16*960*((2^dc)+1))/1000000.
+    A scan duration of 5 on 16 channels approximately takes 8 secs. */
+		pScanReq->scanDuration = pMw->connect_request_data_p->scan_duration;
+		pScanReq->securityLevel = gMacSecurityNone_c;
+
+		/* Send the Scan request to the MLME. */
+		if(NWK_MLME_SapHandler( pMsg, pMw->macInstance ) == gSuccess_c)
+		{
+			//Serial_Print(mInterfaceId,"Done.\n\r", gAllowToBlock_d);
+			return mwErrorNoError;
+		}
+		else
+		{
+			//Serial_Print(mInterfaceId,"Invalid parameter.\n\r", gAllowToBlock_d);
+			return mwErrorInvalidParameter;
+		}
+	}
+	else
+	{
+		/* Allocation of a message buffer failed. */
+		//Serial_Print(mInterfaceId,"Message allocation failed.\n\r", gAllowToBlock_d);
+		return mwErrorAllocFailed;
+	}
+}
+
+/******************************************************************************
+ * The HandleScanActiveConfirm(nwkMessage_t *pMsg) function will handle the
+ * Active Scan confirm message received from the MLME when the Active scan has
+ * completed. The message contains a list of PAN descriptors. the requested
+ * coordinator is chosen, the one with the best link quality if it was heard on
+ * several channels. The corresponding pan descriptor is stored in the
+ * coordInfo of the instance. The PAN descriptors of every channel are counted
+ * in its scanPanCount for the channel selection (HandleScanEdConfirm()).
+ *
+ * The function may return either of the following values:
+ *   mwErrorNoError:       A suitable pan descriptor was found.
+ *   mwErrorNoScanResults: No scan results were present in the confirm message.
+ *
+ ******************************************************************************/
+static uint8_t HandleScanActiveConfirm( mw_instance_t* pMw, nwkMessage_t *pMsg, uint16_t pan_id )
+{
+	void    *pBlock;
+	uint8_t panDescListSize = pMsg->msgData.scanCnf.resultListSize;
+	uint8_t rc = mwErrorNoScanResults;
+	uint8_t j;
+	panDescriptorBlock_t *pDescBlock = pMsg->msgData.scanCnf.resList.pPanDescriptorBlockList;
+	panDescriptor_t      *pPanDesc;
+
+	FLib_MemSet(pMw->scanPanCount, 0, sizeof(pMw->scanPanCount));
+
+	/* Check if the scan resulted in any coordinator responses. */
+	if( panDescListSize > 0 )
+	{
+		/* Check all PAN descriptors. */
+		while( NULL != pDescBlock )
+		{
+			for( j = 0; j < pDescBlock->panDescriptorCount; j++ )
+			{
+				pPanDesc = &pDescBlock->panDescriptorList[j];
+
+				if( (pPanDesc->logicalChannel >= gLogicalChannel11_c) &&
+						(pPanDesc->logicalChannel <= gLogicalChannel26_c) &&
+						(pMw->scanPanCount[pPanDesc->logicalChannel - gLogicalChannel11_c] < 0xFF) )
+				{
+					pMw->scanPanCount[pPanDesc->logicalChannel - gLogicalChannel11_c]++;
+				}
+
+				/* Only attempt to associate if the coordinator
+                accepts associations and is non-beacon. */
+				if( ( pPanDesc->superframeSpec.associationPermit ) &&
+						( pPanDesc->superframeSpec.beaconOrder == 0x0F) )
+				{
+					/* Find the requested coordinator. */
+					if( (pPanDesc->coordPanId == pan_id) &&
+							((rc != mwErrorNoError) || (pPanDesc->linkQuality > pMw->coordInfo.linkQuality)) )
+					{
+						/* Save the information of the coordinator  */
+						FLib_MemCpy( &pMw->coordInfo, pPanDesc, sizeof(panDescriptor_t) );
+						rc = mwErrorNoError;
+					}
+				}
+			}
+
+			/* Free current block */
+			pBlock = pDescBlock;
+			pDescBlock = pDescBlock->pNext;
+			MSG_Free( pBlock );
+		}
+	}
+
+	if( pDescBlock )
+		MSG_Free( pDescBlock );
+
+	return rc;
+}
+
+/******************************************************************************
+ * The IntervalTimeoutHandler(uint8_t timerID) function will send an event
+ * to the application task after the programmed interval of time expires
+ *
+ ******************************************************************************/
+static void WaitIntervalTimeoutHandler(void *pData)
+{
+	mw_instance_t *pMw = pData;
+
+	OSA_EventSet(pMw->event, gAppEvtStartWait_c);
+}
+
+/******************************************************************************
+ * The SendAssociateRequest(void) will create an Associate Request message
+ * and send it to the coordinator it wishes to associate to. The function uses
+ * information gained about the coordinator during the scan procedure.
+ *
+ * The function may return either of the following values:
+ *   mwErrorNoError:          The Associate Request message was sent successfully.
+ *   mwErrorInvalidParameter: The MLME service access point rejected the
+ *                          message due to an invalid parameter.
+ *   mwErrorAllocFailed:      A message buffer could not be allocated.
+ *
+ ******************************************************************************/
+static uint8_t SendAssociateRequest( mw_instance_t* pMw )
+{
+	mlmeMessage_t *pMsg;
+	mlmeAssociateReq_t *pAssocReq;
+	uint8_t boolFlag;
+
+	/* Allocate a message for the MLME message. */
+	pMsg = MSG_AllocType( mlmeMessage_t );
+	if( pMsg != NULL )
+	{
+		/* Set the gMPibRxOnWhenIdle_c flag to true, this will allow direct data messages */
+		pMsg->msgType = gMlmeSetReq_c;
+		pMsg->msgData.setReq.pibAttribute = gMPibRxOnWhenIdle_c;
+		boolFlag = TRUE;
+		pMsg->msgData.setReq.pibAttributeValue = &boolFlag;
+		NWK_MLME_SapHandler( pMsg, pMw->macInstance );
+
+		/* We must set the Association Permit flag to TRUE
+        in order to allow devices to associate to us. */
+		/* We can re-use the pMsg data because gMlmeSetReq_c is a synchronous request */
+		/* This is a MLME-ASSOCIATE.req command. */
+		pMsg->msgType = gMlmeAssociateReq_c;
+		/* Create the Associate request message data. */
+		pAssocReq = &pMsg->msgData.associateReq;
+
+		/* Use the coordinator info we got from the Active Scan. */
+		FLib_MemCpy(&pAssocReq->coordAddress, &pMw->coordInfo.coordAddress, 8);
+		FLib_MemCpy(&pAssocReq->coordPanId,   &pMw->coordInfo.coordPanId, 2);
+		pAssocReq->coordAddrMode  = pMw->coordInfo.coordAddrMode;
+		pAssocReq->logicalChannel = pMw->coordInfo.logicalChannel;
+		pAssocReq->securityLevel  = gMacSecurityNone_c;
+		pAssocReq->channelPage = gDefaultChannelPageId_c;
+
+		/* We want the coordinator to assign a short address to us. */
+		pAssocReq->capabilityInfo     = gCapInfoAllocAddr_c;
+
+		/* Send the Associate Request to the MLME. */
+		if( NWK_MLME_SapHandler( pMsg, pMw->macInstance ) == gSuccess_c )
+		{
+			return mwErrorNoError;
+		}
+		else
+		{
+			/* One or more parameters in the message were invalid. */
+			return mwErrorInvalidParameter;
+		}
+	}
+	else
+	{
+		/* Allocation of a message buffer failed. */
+		return mwErrorAllocFailed;
+	}
+}
+
+
+/******************************************************************************
+ * The HandleAssociateConfirm(nwkMessage_t *pMsg) function will handle the
+ * Associate confirm message received from the MLME when the Association
+ * procedure has completed. The message contains the short address that the
+ * coordinator has assigned to us. The address and address mode are saved in
+ * global variables. They will be used in the next demo application when sending
+ * data .
+ *
+ * The function may return either of the following values:
+ *   gSuccess_c:          Correct short address
+ *   gPanAccessDenied_c:  Invalid short address
+ *
+ ******************************************************************************/
+static uint8_t HandleAssociateConfirm( mw_instance_t* pMw, nwkMessage_t *pMsg )
+{
+	if( pMsg->msgData.associateCnf.status == gSuccess_c )
+	{
+		FLib_MemCpy( &pMw->shortAddress, &pMsg->msgData.associateCnf.assocShortAddress, 2 );
+		pMw->panId = pMw->connect_request_data_p->pan_id;
+		return mwErrorNoError;
+	}
+	else
+	{
+		/* No valid short address. */
+		return mwErrorPanAccessDenied;
+	}
+}
+
+/******************************************************************************
+ * The HandleScanEdConfirm(nwkMessage_t *pMsg) function will handle the
+ * ED scan confirm message received from the MLME when the ED scan has completed.
+ * The message contains the ED scan result list, one energy per scanned channel
+ * in increasing channel order. This function will search the list in order to
+ * select the logical channel with the least energy, where every PAN the active
+ * scan found on a channel adds mwScanPanPenalty_c. The selected channel is
+ * stored in the connection request. If the scan failed the channel is kept.
+ *
+ ******************************************************************************/
+static void HandleScanEdConfirm(mw_instance_t* pMw, nwkMessage_t *pMsg)
+{
+	uint8_t *pEdList;
+	uint8_t count = pMsg->msgData.scanCnf.resultListSize;
+	uint8_t i = 0;
+	uint8_t channel;
+	uint16_t energy;
+	uint16_t lowest = 0xFFFF;
+
+	/* Get a pointer to the energy detect results */
+	pEdList = pMsg->msgData.scanCnf.resList.pEnergyDetectList;
+	if(pEdList == NULL)
+	{
+		return;
+	}
+
+	if(pMsg->msgData.scanCnf.status == gSuccess_c)
+	{
+		for(channel = gLogicalChannel11_c; (channel <= gLogicalChannel26_c) && (i < count); channel++)
+		{
+			if(!(pMw->connect_request_data_p->channel_mask & ((uint32_t)1 << channel)))
+			{
+				continue;
+			}
+
+			energy = pEdList[i++] + (uint16_t)pMw->scanPanCount[channel - gLogicalChannel11_c] * mwScanPanPenalty_c;
+			if(energy < lowest)
+			{
+				lowest = energy;
+				pMw->connect_request_data_p->channel = channel;
+			}
+		}
+	}
+
+	/* The list of detected energies must be freed. */
+	MSG_Free(pEdList);
+}
+
+/******************************************************************************
+ * The App_StartScan(scanType) function will start the scan process of the
+ * specified type in the MAC. This is accomplished by allocating a MAC message,
+ * which is then assigned the desired scan parameters and sent to the MLME
+ * service access point. The MAC PIB attributes "macShortAddress", and
+ * "macAssociatePermit" are modified.
+ *
+ * The function may return either of the following values:
+ *   mwErrorNoError:          The Scan message was sent successfully.
+ *   mwErrorInvalidParameter: The MLME service access point rejected the
+ *                          message due to an invalid parameter.
+ *   mwErrorAllocFailed:      A message buffer could not be allocated.
+ *
+ ******************************************************************************/
+static uint8_t StartCoordinator(mw_instance_t* pMw)
+{
+	/* Message for the MLME will be allocated and attached to this pointer */
+	mlmeMessage_t *pMsg;
+
+	/* Allocate a message for the MLME (We should check for NULL). */
+	pMsg = MSG_AllocType(mlmeMessage_t);
+	if(pMsg != NULL)
+	{
+		/* Pointer which is used for easy access inside the allocated message */
+		mlmeStartReq_t *pStartReq;
+		/* Return value from MSG_send - used for avoiding compiler warnings */
+		uint8_t ret = 0;
+		/* Boolean value that will be written to the MAC PIB */
+		uint8_t boolFlag;
+
+		(void) ret;     // remove compiler warning
+		/* Set-up MAC PIB attributes. Please note that Set, Get, and Reset
+       messages are not freed by the MLME. We must always set the short
+       address to something else than 0xFFFF before starting a PAN.
+		 */
+		pMw->shortAddress = 0x0000;
+		pMsg->msgType = gMlmeSetReq_c;
+		pMsg->msgData.setReq.pibAttribute = gMPibShortAddress_c;
+		pMsg->msgData.setReq.pibAttributeValue = (uint8_t *)&pMw->shortAddress;
+		ret = NWK_MLME_SapHandler( pMsg, pMw->macInstance );
+
+		/* We must set the Association Permit flag to TRUE
+    in order to allow devices to associate to us. */
+		pMsg->msgType = gMlmeSetReq_c;
+		pMsg->msgData.setReq.pibAttribute = gMPibAssociationPermit_c;
+		boolFlag = TRUE;
+		pMsg->msgData.setReq.pibAttributeValue = &boolFlag;
+		ret = NWK_MLME_SapHandler( pMsg, pMw->macInstance );
+
+#if mwMaxInstances_c > 1
+		/* The MPM only switches between the PANs that keep the receiver on */
+		pMsg->msgType = gMlmeSetReq_c;
+		pMsg->msgData.setReq.pibAttribute = gMPibRxOnWhenIdle_c;
+		boolFlag = TRUE;
+		pMsg->msgData.setReq.pibAttributeValue = &boolFlag;
+		ret = NWK_MLME_SapHandler( pMsg, pMw->macInstance );
+#endif
+
+		/* This is a MLME-START.req command */
+		pMsg->msgType = gMlmeStartReq_c;
+		/* Create the Start request message data. */
+		pStartReq = &pMsg->msgData.startReq;
+		/* PAN ID - LSB, MSB. The demo shows a PAN ID of 0xAAAA. */
+		FLib_MemCpy(&pStartReq->panId, (void*)&pMw->connect_request_data_p->pan_id, 2);
+		/* Logical Channel - the default of 11 will be overridden */
+		pStartReq->logicalChannel = pMw->connect_request_data_p->channel;
+
+		/* Beacon Order - 0xF = turn off beacons */
+		pStartReq->beaconOrder = 0x0F;
+		/* Superframe Order - 0xF = turn off beacons */
+		pStartReq->superframeOrder = 0x0F;
+		/* Be a PAN coordinator */
+		pStartReq->panCoordinator = TRUE;
+		/* Dont use battery life extension */
+		pStartReq->batteryLifeExtension = FALSE;
+		/* This is not a Realignment command */
+		pStartReq->coordRealignment = FALSE;
+		/* Dont use security */
+		pStartReq->coordRealignSecurityLevel = gMacSecurityNone_c;
+		pStartReq->beaconSecurityLevel = gMacSecurityNone_c;
+
+		/* Send the Start request to the MLME. */
+		if(NWK_MLME_SapHandler( pMsg, pMw->macInstance ) == gSuccess_c)
+		{
+			return mwErrorNoError;
+		}
+		else
+		{
+			/* One or more parameters in the Start Request message were invalid. */
+			return mwErrorInvalidParameter;
+		}
+	}
+	else
+	{
+		/* Allocation of a message buffer failed. */
+		return mwErrorAllocFailed;
+	}
+}
+
+#if mwFastReconnect_d
+/******************************************************************************
+ * The StartRejoin() function looks for saved network parameters matching the
+ * requested PAN and, if there are some, goes straight to starting the
+ * coordinator on the saved channel or to associating to the saved
+ * coordinator. A device associating again keeps its short address (see
+ * DeviceTable_Add()). The flash keeps one connection: only the first
+ * instance uses it.
+ *
+ * The function returns TRUE if a rejoin was started.
+ ******************************************************************************/
+static bool_t StartRejoin(mw_instance_t* pMw)
+{
+	nwkParams_t params;
+
+	if((pMw != &mInstances[0]) || !NwkParams_Load(&params) || (params.panId != pMw->connect_request_data_p->pan_id))
+	{
+		return FALSE;
+	}
+
+	pMw->rejoin = TRUE;
+	if(params.role == mNwkParamsCoordinator_c)
+	{
+		pMw->connect_request_data_p->channel = params.channel;
+		pMw->state = macStateStartCoordinator;
+		OSA_EventSet(pMw->event, gAppEvtStartCoordinator_c);
+	}
+	else
+	{
+		FLib_MemCpy(&pMw->coordInfo, &params.coordInfo, sizeof(panDescriptor_t));
+		pMw->state = macStateAssociate;
+		OSA_EventSet(pMw->event, gAppEvtDummyEvent_c);
+	}
+
+	return TRUE;
+}
+
+/******************************************************************************
+ * The SaveNwkParams() function saves the parameters of the connection that
+ * just succeeded, for the next mac_connect() after a reset. Nothing is
+ * written to flash when they did not change.
+ ******************************************************************************/
+static void SaveNwkParams(mw_instance_t* pMw, uint8_t role)
+{
+	nwkParams_t params;
+
+	if(pMw != &mInstances[0])
+	{
+		return;
+	}
+
+	FLib_MemSet(&params, 0, sizeof(params));
+	params.role = role;
+	params.panId = pMw->panId;
+	params.shortAddress = pMw->shortAddress;
+	if(role == mNwkParamsDevice_c)
+	{
+		FLib_MemCpy(&params.coordInfo, &pMw->coordInfo, sizeof(panDescriptor_t));
+		params.channel = pMw->coordInfo.logicalChannel;
+	}
+	else
+	{
+		params.channel = pMw->connect_request_data_p->channel;
+	}
+
+	(void)NwkParams_Save(&params);
+}
+#endif
+
+/******************************************************************************
+ * The ReserveTxSlot() function takes a free transmission slot and gives it the
+ * next MSDU handle that maps to it (see mwTxSlotFromHandle()). It is called
+ * from the caller's task, so the slot table is protected against the mac task
+ * releasing slots on confirm. The txFreeSlots semaphore counts the free
+ * slots: with a timeout the caller blocks until one is released. A normal
+ * priority request first takes one of the txNormalSlots, so the last
+ * mwTxHighReservedSlots_c free slots are left to high priority requests.
+ *
+ * The function returns the index of the slot or mwInvalidTxSlot_c if there
+ * is still no slot for the priority class after the timeout.
+ ******************************************************************************/
+static uint8_t ReserveTxSlot(mw_instance_t* pMw, uint8_t priority, uint32_t timeout)
+{
+	uint8_t i;
+	uint8_t slot = mwInvalidTxSlot_c;
+	uint8_t used = 0;
+	bool_t high = FALSE;
+	uint32_t start;
+	uint32_t elapsed;
+
+	if(priority == mac_tx_priority_normal_c)
+	{
+		start = OSA_TimeGetMsec();
+		if(OSA_SemaphoreWait(pMw->txNormalSlots, timeout) != osaStatus_Success)
+		{
+			return mwInvalidTxSlot_c;
+		}
+
+		/* The whole wait is bounded by the timeout */
+		if((timeout != 0) && (timeout != osaWaitForever_c))
+		{
+			elapsed = OSA_TimeGetMsec() - start;
+			timeout = (elapsed < timeout) ? (timeout - elapsed) : 0;
+		}
+	}
+
+	if(OSA_SemaphoreWait(pMw->txFreeSlots, timeout) != osaStatus_Success)
+	{
+		if(priority == mac_tx_priority_normal_c)
+		{
+			(void)OSA_SemaphorePost(pMw->txNormalSlots);
+		}
+		return mwInvalidTxSlot_c;
+	}
+
+	OSA_InterruptDisable();
+	for(i = 0; i < mwMaxPendingTx_c; i++)
+	{
+		if(pMw->txSlots[i].state == mwTxSlotFree_c)
+		{
+			pMw->txSlots[i].state = mwTxSlotReserved_c;
+			pMw->txSlots[i].pPacket = NULL;
+			pMw->txSlots[i].callback = NULL;
+			pMw->txSlots[i].context = NULL;
+			pMw->txSlots[i].msduHandle = (uint8_t)(pMw->msduHandle + i);
+			pMw->txSlots[i].priority = priority;
+			pMw->msduHandle += mwMaxPendingTx_c;
+			slot = i;
+			break;
+		}
+	}
+	if(slot != mwInvalidTxSlot_c)
+	{
+		used = ++pMw->txSlotsUsed;
+		if(!pMw->txAboveHigh && (used >= pMw->txHighWatermark))
+		{
+			pMw->txAboveHigh = TRUE;
+			high = TRUE;
+		}
+	}
+	OSA_InterruptEnable();
+
+	if(high && (pMw->txOnHigh != NULL))
+	{
+		pMw->txOnHigh(used);
+	}
+
+	return slot;
+}
+
+/******************************************************************************
+ * The ReleaseTxSlot() function frees the MCPS-DATA.request identified by
+ * msduHandle and makes its slot available again. Unknown handles are ignored.
+ ******************************************************************************/
+static void ReleaseTxSlot(mw_instance_t* pMw, uint8_t msduHandle)
+{
+	(void)CompleteTxSlot(pMw, msduHandle, gSuccess_c);
+}
+
+/******************************************************************************
+ * The CompleteTxSlot() function releases the slot of msduHandle, like
+ * ReleaseTxSlot(), and then calls the completion callback of a request from
+ * mac_transmit_async() with the status. The slot is found from the handle in
+ * constant time.
+ *
+ * The function returns TRUE if the request had a callback, which was called.
+ ******************************************************************************/
+static bool_t CompleteTxSlot(mw_instance_t* pMw, uint8_t msduHandle, resultType_t status)
+{
+	mw_tx_slot_t *pSlot = &pMw->txSlots[mwTxSlotFromHandle(msduHandle)];
+	nwkToMcpsMessage_t *pPacket = NULL;
+	mac_tx_callback_t callback = NULL;
+	void *context = NULL;
+	bool_t released = FALSE;
+	bool_t low = FALSE;
+	uint8_t used = 0;
+	uint8_t priority = mac_tx_priority_normal_c;
+
+	TRACE(gTraceMwTxComplete_c, msduHandle, status);
+	OSA_InterruptDisable();
+	if((pSlot->state != mwTxSlotFree_c) && (pSlot->msduHandle == msduHandle))
+	{
+		if(pSlot->state == mwTxSlotInFlight_c)
+		{
+			pMw->txInFlight--;
+			if(pSlot->priority == mac_tx_priority_normal_c)
+			{
+				pMw->txInFlightNormal--;
+			}
+#if mwStatistics_d
+			UpdateTxDelayStats(pMw, pSlot);
+#endif
+#if mwLatencyStats_d
+			RecordTxLatency(pSlot);
+#endif
+		}
+		pPacket = pSlot->pPacket;
+		callback = pSlot->callback;
+		context = pSlot->context;
+		priority = pSlot->priority;
+		pSlot->pPacket = NULL;
+		pSlot->callback = NULL;
+		pSlot->state = mwTxSlotFree_c;
+		released = TRUE;
+
+		used = --pMw->txSlotsUsed;
+		if(pMw->txAboveHigh && (used <= pMw->txLowWatermark))
+		{
+			pMw->txAboveHigh = FALSE;
+			low = TRUE;
+		}
+	}
+	OSA_InterruptEnable();
+
+	if(!released)
+	{
+		return FALSE;
+	}
+
+	/* Wakes up a sender blocked in mac_transmit_wait() */
+	(void)OSA_SemaphorePost(pMw->txFreeSlots);
+	if(priority == mac_tx_priority_normal_c)
+	{
+		(void)OSA_SemaphorePost(pMw->txNormalSlots);
+	}
+
+	if(pPacket != NULL)
+	{
+		MSG_Free(pPacket);
+	}
+
+	if(low && (pMw->txOnLow != NULL))
+	{
+		pMw->txOnLow(used);
+	}
+
+	/* Called once the slot is free, so it can be used for a new request */
+	if(callback != NULL)
+	{
+		callback(status, context);
+		return TRUE;
+	}
+
+	return FALSE;
+}
+
+/******************************************************************************
+ * The BuildDataRequest() function allocates an MCPS-Data Request message with
+ * room for a payload of 'length' bytes right after the message and fills in
+ * the header. The payload itself is written by the caller through
+ * mwTxPayload(), after the dispatch byte when fragmentation is enabled.
+ *
+ * The function returns NULL if a message buffer could not be allocated.
+ ******************************************************************************/
+static nwkToMcpsMessage_t* BuildDataRequest(mw_instance_t* pMw, uint16_t dest_address, uint8_t length, uint8_t msduHandle)
+{
+	nwkToMcpsMessage_t *pPacket;
+
+	pPacket = MSG_Alloc(sizeof(nwkToMcpsMessage_t) + mwDispatchLen_c + length);
+	if(pPacket != NULL)
+	{
+		/* Create an MCPS-Data Request message containing the data. */
+		pPacket->msgType = gMcpsDataReq_c;
+		/* The payload is stored right after the message */
+		pPacket->msgData.dataReq.pMsdu = (uint8_t*)pPacket + sizeof(nwkToMcpsMessage_t);
+		/* Create the header using device information stored when creating
+		 the association response. In this simple example the use of short
+		 addresses is hardcoded. In a real world application we must be
+		 flexible, and use the address mode required by the given situation. */
+		pPacket->msgData.dataReq.dstAddr = dest_address;
+
+		FLib_MemCpy(&pPacket->msgData.dataReq.srcAddr,  (void*)&pMw->shortAddress, 2);
+		FLib_MemCpy(&pPacket->msgData.dataReq.dstPanId, (void*)&pMw->panId, 2);
+		FLib_MemCpy(&pPacket->msgData.dataReq.srcPanId, (void*)&pMw->panId, 2);
+		pPacket->msgData.dataReq.dstAddrMode = gAddrModeShortAddress_c;
+		pPacket->msgData.dataReq.srcAddrMode = gAddrModeShortAddress_c;
+		pPacket->msgData.dataReq.msduLength = mwDispatchLen_c + length;
+#if mwDispatchLen_c
+		pPacket->msgData.dataReq.pMsdu[0] = mwDispatchData_c;
+#endif
+		/* Request MAC level acknowledgement of the data packet */
+		pPacket->msgData.dataReq.txOptions = gMacTxOptionsAck_c;
+		/* Give the data packet a handle. The handle is
+		 returned in the MCPS-Data Confirm message. */
+		pPacket->msgData.dataReq.msduHandle = msduHandle;
+		pPacket->msgData.dataReq.securityLevel = gMacSecurityNone_c;
+	}
+
+	return pPacket;
+}
+
+/******************************************************************************
+ * The AllocTxBuffer() function reserves a transmission slot and builds the
+ * MCPS-Data Request for it, leaving 'length' bytes of payload to be written
+ * by the caller. The request is not sent until CommitTxBuffer() is called.
+ * When all the slots of its priority class are taken it waits up to
+ * 'timeout' ms for one.
+ *
+ * The function may return either of the following values:
+ *   mwErrorNoError:          The request was built, *ppPacket points to it.
+ *   mwErrorAlreadyConnected: The MAC is not connected yet.
+ *   mwErrorInvalidParameter: The length is 0 or the payload does not fit
+ *                            in mwMaxPayload_c bytes.
+ *   mwErrorTxQueueFull:      No slot is left for the priority class.
+ *   mwErrorAllocFailed:      A message buffer could not be allocated.
+ ******************************************************************************/
+static uint8_t AllocTxBuffer(mw_instance_t* pMw, uint16_t dest_address, uint8_t length, uint8_t priority, uint32_t timeout,
+                             nwkToMcpsMessage_t** ppPacket)
+{
+	nwkToMcpsMessage_t *pPacket;
+	uint8_t slot;
+
+	/* The MAC shall be connected yet */
+	if(!pMw->connected) {
+		return mwErrorAlreadyConnected;
+	}
+
+	if((length == 0) || (length > mwMaxPayload_c - mwDispatchLen_c)) {
+		return mwErrorInvalidParameter;
+	}
+
+	/* There should be room for one more outstanding request */
+	slot = ReserveTxSlot(pMw, priority, timeout);
+	if(slot == mwInvalidTxSlot_c) {
+		return mwErrorTxQueueFull;
+	}
+
+	pPacket = BuildDataRequest(pMw, dest_address, length, pMw->txSlots[slot].msduHandle);
+	if(pPacket == NULL) {
+		ReleaseTxSlot(pMw, pMw->txSlots[slot].msduHandle);
+		return mwErrorAllocFailed;
+	}
+	pMw->txSlots[slot].pPacket = pPacket;
+
+	*ppPacket = pPacket;
+	return mwErrorNoError;
+}
+
+/******************************************************************************
+ * The CommitTxBuffer() function sets the final payload length of a request
+ * built by AllocTxBuffer() and adds it to the transmit ring of its priority
+ * class for the mac task.
+ * A length of 0 releases the request without sending it.
+ *
+ * The function may return either of the following values:
+ *   mwErrorNoError:          The request was queued (or dropped on length 0).
+ *   mwErrorInvalidParameter: The request is unknown, was already committed
+ *                            or the length is larger than the reserved one.
+ ******************************************************************************/
+static uint8_t CommitTxBuffer(mw_instance_t* pMw, nwkToMcpsMessage_t* pPacket, uint8_t length)
+{
+	mw_tx_slot_t *pSlot = &pMw->txSlots[mwTxSlotFromHandle(pPacket->msgData.dataReq.msduHandle)];
+	uint8_t rc = mwErrorInvalidParameter;
+	uint8_t priority;
+
+	OSA_InterruptDisable();
+	if((pSlot->state == mwTxSlotReserved_c) && (pSlot->pPacket == pPacket) &&
+	   (length + mwDispatchLen_c <= pPacket->msgData.dataReq.msduLength))
+	{
+		rc = mwErrorNoError;
+		if(length != 0)
+		{
+			pPacket->msgData.dataReq.msduLength = mwDispatchLen_c + length;
+			pSlot->state = mwTxSlotQueued_c;
+#if mwStatistics_d
+			pSlot->committed = (uint32_t)TMR_GetTimestamp();
+#endif
+#if mwLatencyStats_d
+			pSlot->stamps[mwTxStampQueued_c] = LatencyStats_Now();
+#endif
+			TRACE(gTraceMwTxQueued_c, pPacket->msgData.dataReq.msduHandle, length);
+			/* Every slot has room in each ring, they cannot overflow */
+			priority = pSlot->priority;
+			pMw->txRing[priority][(pMw->txRingHead[priority] + pMw->txRingCount[priority]) & (mwMaxPendingTx_c - 1)] =
+					(uint8_t)(pSlot - pMw->txSlots);
+			pMw->txRingCount[priority]++;
+		}
+	}
+	OSA_InterruptEnable();
+
+	if(rc != mwErrorNoError)
+	{
+		return rc;
+	}
+
+	if(length == 0)
+	{
+		ReleaseTxSlot(pMw, pPacket->msgData.dataReq.msduHandle);
+		return mwErrorNoError;
+	}
+
+	/* Signal the mac wrapper task */
+	OSA_EventSet(pMw->event, mw_event_transmit_request_c);
+	return mwErrorNoError;
+}
+
+/******************************************************************************
+ * The TransmitData() function hands the queued MCPS-Data Requests to the
+ * MCPS service access point in the MAC, as long as fewer than
+ * mwMaxInFlightTx_c are waiting for their confirm. The others stay in their
+ * ring, so the MAC queue never holds more than that. The high priority ring
+ * is emptied first, oldest first, and a normal priority request is only
+ * handed over while fewer than mwMaxInFlightNormalTx_c are in the MAC: a
+ * high priority request never finds more of them ahead of it.
+ * The requests stay in their slot until the MCPS-Data Confirm with the same
+ * MSDU handle is received. A request rejected by the MCPS will never be
+ * confirmed by the MAC, so it gets a confirm with the status of the MCPS from
+ * RejectTxRequest().
+ ******************************************************************************/
+static void TransmitData(mw_instance_t* pMw)
+{
+	nwkToMcpsMessage_t *pPacket;
+	resultType_t status;
+	uint8_t priority;
+	uint8_t slot;
+
+	while(pMw->txInFlight < mwMaxInFlightTx_c)
+	{
+		OSA_InterruptDisable();
+		if(pMw->txRingCount[mac_tx_priority_high_c])
+		{
+			priority = mac_tx_priority_high_c;
+		}
+		else if(pMw->txRingCount[mac_tx_priority_normal_c] &&
+		        (pMw->txInFlightNormal < mwMaxInFlightNormalTx_c))
+		{
+			priority = mac_tx_priority_normal_c;
+			pMw->txInFlightNormal++;
+		}
+		else
+		{
+			OSA_InterruptEnable();
+			break;
+		}
+		slot = pMw->txRing[priority][pMw->txRingHead[priority]];
+		pMw->txRingHead[priority] = (pMw->txRingHead[priority] + 1) & (mwMaxPendingTx_c - 1);
+		pMw->txRingCount[priority]--;
+		pMw->txSlots[slot].state = mwTxSlotInFlight_c;
+		pMw->txInFlight++;
+#if mwStatistics_d
+		pMw->txSlots[slot].queueDelay = (uint32_t)TMR_GetTimestamp() - pMw->txSlots[slot].committed;
+#endif
+		pPacket = pMw->txSlots[slot].pPacket;
+#if mwLinkTable_d
+		pMw->txSlots[slot].handedOver = (uint32_t)TMR_GetTimestamp();
+		pMw->txSlots[slot].dest_address = (uint16_t)pPacket->msgData.dataReq.dstAddr;
+#endif
+#if mwLatencyStats_d
+		pMw->txSlots[slot].stamps[mwTxStampHandedOver_c] = LatencyStats_Now();
+		pMw->txSlots[slot].stamped = (1 << mwTxStampQueued_c) | (1 << mwTxStampHandedOver_c);
+#endif
+		OSA_InterruptEnable();
+		TRACE(gTraceMwTxHandOver_c, pPacket->msgData.dataReq.msduHandle, pMw->txInFlight);
+
+		/* Send the Data Request to the MCPS */
+		status = NWK_MCPS_SapHandler(pPacket, pMw->macInstance);
+		if(status != gSuccess_c)
+		{
+			RejectTxRequest(pMw, pPacket->msgData.dataReq.msduHandle, status);
+		}
+	}
+}
+
+/******************************************************************************
+ * The RejectTxRequest() function confirms a request that the MCPS refused
+ * with its status. The confirm is queued as if it came from the MAC, so that
+ * the request is released and reported, to its completion callback or to
+ * evt_hdlr, in the same order as the others. If there is no memory left for
+ * the confirm, the request is only released.
+ ******************************************************************************/
+static void RejectTxRequest(mw_instance_t* pMw, uint8_t msduHandle, resultType_t status)
+{
+	mcpsToNwkMessage_t *pCnf = MSG_AllocType(mcpsToNwkMessage_t);
+
+	if(pCnf == NULL)
+	{
+		(void)CompleteTxSlot(pMw, msduHandle, status);
+		return;
+	}
+
+	pCnf->msgType = gMcpsDataCnf_c;
+	pCnf->msgData.dataCnf.msduHandle = msduHandle;
+	pCnf->msgData.dataCnf.status = status;
+	pCnf->msgData.dataCnf.timestamp = 0;
+	(void)MCPS_NWK_SapHandler(pCnf, (instanceId_t)(pMw - mInstances));
+}
+
+#if mwStatistics_d
+/******************************************************************************
+ * The UpdateTxDelayStats() function adds the queueing delay of a request that
+ * leaves the MAC to the statistics of its priority class. It is called with
+ * the interrupts disabled.
+ ******************************************************************************/
+static void UpdateTxDelayStats(mw_instance_t* pMw, mw_tx_slot_t *pSlot)
+{
+	mac_tx_delay_stats_t *pStats = &pMw->stats.tx_delay[pSlot->priority];
+	uint32_t delay = (uint32_t)TMR_GetTimestamp() - pSlot->committed;
+
+	pStats->count++;
+	pStats->queue_total_us += pSlot->queueDelay;
+	if(pSlot->queueDelay > pStats->queue_max_us)
+	{
+		pStats->queue_max_us = pSlot->queueDelay;
+	}
+	pStats->cnf_total_us += delay;
+	if(delay > pStats->cnf_max_us)
+	{
+		pStats->cnf_max_us = delay;
+	}
+}
+#endif
+
+#if mwRxZeroCopy_d
+/******************************************************************************
+ * The HoldRxMsg() function records a data indication the upper layer kept,
+ * in a free entry: can_retain is only offered while there is one.
+ ******************************************************************************/
+static void HoldRxMsg(mcpsToNwkMessage_t* pMsg)
+{
+	uint8_t i;
+
+	OSA_InterruptDisable();
+	for(i = 0; i < mwRxMaxHeldMsgs_c; i++)
+	{
+		if(mRxHeld[i] == NULL)
+		{
+			mRxHeld[i] = pMsg;
+			mRxHeldMsgs++;
+			break;
+		}
+	}
+	OSA_InterruptEnable();
+}
+#endif
+
+#if mwLatencyStats_d
+/******************************************************************************
+ * The StampTxConfirm() function stamps the request of an MCPS-DATA.confirm
+ * when it reaches the wrapper, with the start and end of the last attempt
+ * if the PHY records them (gPhyTxTimestamps_d). They are only taken when
+ * they fall between the hand-off and the confirm: an attempt that failed
+ * leaves the end of an earlier one, and another request may have started
+ * since on the same transceiver.
+ ******************************************************************************/
+static void StampTxConfirm(mw_instance_t* pMw, mcpsDataCnf_t *pCnf)
+{
+	mw_tx_slot_t *pSlot = &pMw->txSlots[mwTxSlotFromHandle(pCnf->msduHandle)];
+	uint32_t now = LatencyStats_Now();
+#if gPhyTxTimestamps_d
+	uint64_t txStart;
+	uint64_t txDone;
+	uint32_t start;
+	uint32_t done;
+#endif
+
+	if((pSlot->state != mwTxSlotInFlight_c) || (pSlot->msduHandle != pCnf->msduHandle))
+	{
+		return;
+	}
+
+	pSlot->stamps[mwTxStampConfirmed_c] = now;
+	pSlot->stamped |= (1 << mwTxStampConfirmed_c);
+#if gPhyTxTimestamps_d
+	PhyGetTxTimestamps(mwPhyInstance(pMw), &txStart, &txDone);
+	start = (uint32_t)txStart;
+	done = (uint32_t)txDone;
+	/* The stamps wrap: compare their differences */
+	if((pCnf->status == gSuccess_c) &&
+	   ((int32_t)(start - pSlot->stamps[mwTxStampHandedOver_c]) >= 0) &&
+	   ((int32_t)(done - start) >= 0) && ((int32_t)(now - done) >= 0))
+	{
+		pSlot->stamps[mwTxStampPhyStart_c] = start;
+		pSlot->stamps[mwTxStampPhyDone_c] = done;
+		pSlot->stamped |= (1 << mwTxStampPhyStart_c) | (1 << mwTxStampPhyDone_c);
+	}
+#endif
+}
+
+/******************************************************************************
+ * The RecordTxLatency() function stamps a request handed to the MAC when it
+ * is given back, and adds to the latency statistics every stage it has both
+ * stamps of. It is called with the interrupts disabled.
+ ******************************************************************************/
+static void RecordTxLatency(mw_tx_slot_t *pSlot)
+{
+	uint32_t stamp;
+
+	pSlot->stamps[mwTxStampDelivered_c] = LatencyStats_Now();
+	pSlot->stamped |= (1 << mwTxStampDelivered_c);
+
+	for(stamp = mwTxStampQueued_c; stamp < mwTxStampDelivered_c; stamp++)
+	{
+		if((pSlot->stamped & (3 << stamp)) == (3 << stamp))
+		{
+			LatencyStats_Record((latencyStage_t)stamp, pSlot->stamps[stamp + 1] - pSlot->stamps[stamp]);
+		}
+	}
+	LatencyStats_Record(gLatencyTotal_c, pSlot->stamps[mwTxStampDelivered_c] - pSlot->stamps[mwTxStampQueued_c]);
+}
+#endif
+
+#if mwLinkTable_d
+/******************************************************************************
+ * The UpdateLinkTx() function records the result of a request handed to the
+ * MAC in the link table, with the time it took to be confirmed. It is called
+ * before the slot of the request is released.
+ ******************************************************************************/
+static void UpdateLinkTx(mw_instance_t* pMw, mcpsDataCnf_t *pCnf)
+{
+	mw_tx_slot_t *pSlot = &pMw->txSlots[mwTxSlotFromHandle(pCnf->msduHandle)];
+
+	if((pSlot->state == mwTxSlotInFlight_c) && (pSlot->msduHandle == pCnf->msduHandle))
+	{
+		LinkTable_TxConfirm((uint8_t)(pMw - mInstances), pSlot->dest_address, pCnf->status,
+		                    (uint32_t)TMR_GetTimestamp() - pSlot->handedOver, OSA_TimeGetMsec());
+	}
+}
+
+/******************************************************************************
+ * The CopyLink() function converts a record of the link table to the format
+ * of mac_get_link().
+ ******************************************************************************/
+static void CopyLink(uint16_t short_address, const linkTableEntry_t *pLink, mac_link_info_t *pInfo)
+{
+	uint8_t lqi = (uint8_t)((pLink->lqi + (1 << (mLinkAvgShift_c - 1))) >> mLinkAvgShift_c);
+
+	pInfo->short_address = short_address;
+	pInfo->lqi = lqi;
+	pInfo->rssi = PhyConvertLQIToRSSI(lqi);
+	pInfo->last_lqi = pLink->lastLqi;
+	pInfo->last_heard_ms = 0xFFFFFFFF;
+	if((pLink->flags & mLinkHeard_c) || (pLink->txAttempts > pLink->txNoAck + pLink->txFailures)) {
+		pInfo->last_heard_ms = OSA_TimeGetMsec() - pLink->lastHeard;
+	}
+	pInfo->rx_frames = pLink->rxFrames;
+	pInfo->tx_attempts = pLink->txAttempts;
+	pInfo->tx_no_ack = pLink->txNoAck;
+	pInfo->tx_failures = pLink->txFailures;
+	pInfo->cnf_latency_us = pLink->cnfLatency;
+}
+#endif
+
+/******************************************************************************
+ * The HandleMlmeInput(nwkMessage_t *pMsg) function will handle various
+ * messages from the MLME, e.g. (Dis)Associate Indication.
+ *
+ * The function may return either of the following values:
+ *   errorNoError:   The message was processed.
+ *   errorNoMessage: The message pointer is NULL.
+ ******************************************************************************/
+static uint8_t HandleMlmeInput(mw_instance_t* pMw, nwkMessage_t *pMsg)
+{
+	if(pMsg == NULL)
+	{
+		return mwErrorNoMessage;
+	}
+
+	/* Handle the incoming message. The type determines the sort of processing.*/
+	switch(pMsg->msgType)
+	{
+	case gMlmeAssociateInd_c:
+		/* A device sent us an Associate Request. We must send back a response.  */
+		return SendAssociateResponse(pMw, pMsg);
+		break;
+
+	case gMlmeCommStatusInd_c:
+		/* Sent by the MLME after an Association Response has been transmitted. */
+		ResolvePendingAssoc(pMw, pMsg);
+		break;
+		default:
+			break;
+	}
+	return mwErrorNoError;
+}
+
+/******************************************************************************
+ * The SendAssociateResponse(nwkMessage_t *pMsgIn) will create the response
+ * message to an Associate Indication (device sends an Associate Request to its
+ * MAC. The request is transmitted to the coordinator where it is converted into
+ * an Associate Indication). This function will extract the devices long address,
+ * and various other flags from the incoming indication message for building the
+ * response message.
+ *
+ * The function may return either of the following values:
+ *   errorNoError:          The Associate Response message was sent successfully.
+ *   errorInvalidParameter: The MLME service access point rejected the
+ *                          message due to an invalid parameter.
+ *   errorAllocFailed:      A message buffer could not be allocated.
+ *
+ ******************************************************************************/
+static uint8_t SendAssociateResponse(mw_instance_t* pMw, nwkMessage_t *pMsgIn)
+{
+	mlmeMessage_t *pMsg;
+	mlmeAssociateRes_t *pAssocRes;
+	deviceTableEntry_t *pDevice;
+	uint64_t deviceAddress;
+	resultType_t requestResolution = gSuccess_c;
+	uint8_t slot;
+
+	FLib_MemCpy(&deviceAddress, &pMsgIn->msgData.associateInd.deviceAddress, 8);
+
+	/* A device that repeats its request while its response is still queued in
+	   the MAC gets that response on its next poll. When all the slots are taken
+	   the request is dropped; the device will try again. */
+	if((pMw->pendingAssocCount >= mwMaxPendingAssoc_c) ||
+	   (FindPendingAssoc(pMw, deviceAddress) != mwMaxPendingAssoc_c))
+	{
+#if mwStatistics_d
+		if(pMw->pendingAssocCount >= mwMaxPendingAssoc_c) {
+			pMw->stats.assoc_dropped++;
+		}
+#endif
+		return mwErrorNoError;
+	}
+
+	/* Allocate a message for the MLME */
+	pMsg = MSG_AllocType(mlmeMessage_t);
+	if(pMsg != NULL)
+	{
+		/* This is a MLME-ASSOCIATE.res command */
+		pMsg->msgType = gMlmeAssociateRes_c;
+
+		/* Create the Associate response message data. */
+		pAssocRes = &pMsg->msgData.associateRes;
+
+		/* Find the device, or give it a free entry if there is still space. A
+		   device that associates again gets its previous short address back. */
+		pDevice = DeviceTable_Add(deviceAddress);
+		if(pDevice != NULL)
+		{
+			pAssocRes->assocShortAddress = pDevice->shortAddress;
+
+			/* Association granted.*/
+			requestResolution = gSuccess_c;
+		}
+		else
+		{
+			/* Signal that we do not have a valid short address. */
+			pAssocRes->assocShortAddress = 0xFFFE;
+			requestResolution = gPanAtCapacity_c;
+		}
+
+		/* Association  resolution. */
+		pAssocRes->status = requestResolution;
+
+		/* Do not use security */
+		pAssocRes->securityLevel = gMacSecurityNone_c;
+
+		/* Get the 64 bit address of the device requesting association. */
+		FLib_MemCpy(&pAssocRes->deviceAddress, &pMsgIn->msgData.associateInd.deviceAddress, 8);
+
+		/* Send the Associate Response to the MLME. */
+		if(NWK_MLME_SapHandler( pMsg, pMw->macInstance ) == gSuccess_c)
+		{
+#if mwStatistics_d
+			pMw->stats.assoc_responses++;
+#endif
+			if(gSuccess_c == requestResolution)
+			{
+				for(slot = 0; pMw->pendingAssoc[slot] != NULL; slot++)
+				{
+				}
+				pMw->pendingAssoc[slot] = pDevice;
+				pMw->pendingAssocCount++;
+			}
+			return mwErrorNoError;
+		}
+		else
+		{
+			if((pDevice != NULL) && (pDevice->state == mDeviceReserved_c))
+			{
+#if mwLinkTable_d
+				LinkTable_Clear((uint8_t)(pMw - mInstances), pDevice->shortAddress);
+#endif
+				DeviceTable_Remove(pDevice);
+			}
+			/* One or more parameters in the message were invalid. */
+			return mwErrorInvalidParameter;
+		}
+	}
+	else
+	{
+		/* Allocation of a message buffer failed. */
+		return mwErrorAllocFailed;
+	}
+}
+
+/******************************************************************************
+ * The FindPendingAssoc() function returns the slot of the association response
+ * sent to deviceAddress, or mwMaxPendingAssoc_c if there is none.
+ ******************************************************************************/
+static uint8_t FindPendingAssoc(mw_instance_t* pMw, uint64_t deviceAddress)
+{
+	uint8_t slot;
+
+	for(slot = 0; slot < mwMaxPendingAssoc_c; slot++)
+	{
+		if((pMw->pendingAssoc[slot] != NULL) && (pMw->pendingAssoc[slot]->extAddress == deviceAddress))
+		{
+			break;
+		}
+	}
+
+	return slot;
+}
+
+/******************************************************************************
+ * The ResolvePendingAssoc(nwkMessage_t *pMsg) function completes the
+ * association of the device a Comm Status Indication is about. Each response
+ * is matched by the extended address of its destination, so the indications
+ * may come in any order. Indications for other frames are ignored.
+ ******************************************************************************/
+static void ResolvePendingAssoc(mw_instance_t* pMw, nwkMessage_t *pMsg)
+{
+	mlmeCommStatusInd_t *pInd = &pMsg->msgData.commStatusInd;
+	deviceTableEntry_t *pDevice;
+	uint64_t deviceAddress;
+	uint8_t slot;
+
+	if(pInd->destAddrMode != gAddrModeExtendedAddress_c)
+	{
+		return;
+	}
+
+	FLib_MemCpy(&deviceAddress, &pInd->destAddress, 8);
+	slot = FindPendingAssoc(pMw, deviceAddress);
+	if(slot == mwMaxPendingAssoc_c)
+	{
+		return;
+	}
+
+	pDevice = pMw->pendingAssoc[slot];
+	pMw->pendingAssoc[slot] = NULL;
+	pMw->pendingAssocCount--;
+
+	switch(pInd->status)
+	{
+	case gSuccess_c:
+		/*Device successfully associated. Keeping its entry.*/
+		pDevice->state = mDeviceAssociated_c;
+		break;
+
+	case gTransactionExpired_c:
+	case gNoAck_c:
+	default:
+		/*Association response expired or not acknowledged. Device not associated.
+		  Dropping its entry, unless it was already associated before.*/
+		if(pDevice->state == mDeviceReserved_c)
+		{
+#if mwLinkTable_d
+			LinkTable_Clear((uint8_t)(pMw - mInstances), pDevice->shortAddress);
+#endif
+			DeviceTable_Remove(pDevice);
+		}
+		break;
+	}
+}
+
+/******************************************************************************
+ * The HandleMcpsInput(mcpsToNwkMessage_t *pMsgIn) function will handle
+ * messages from the MCPS, e.g. Data Confirm, and Data Indication.
+ *
+ * The function returns FALSE if the message was delivered already (the
+ * confirm of a request with its own completion callback, or a frame of the
+ * fragmentation layer) or is a duplicate to drop, TRUE if it still has to be
+ * given to the upper layer callback.
+ ******************************************************************************/
+static bool_t HandleMcpsInput(mw_instance_t* pMw, mcpsToNwkMessage_t *pMsgIn)
+{
+#if mwDupFilter_d
+	uint64_t src;
+#endif
+	uint8_t ret = 0;
+
+	(void) ret;       // remove compiler warning
+	switch(pMsgIn->msgType)
+	{
+	/* The MCPS-Data confirm is sent by the MAC to the network
+    or application layer when data has been sent. */
+	case gMcpsDataCnf_c:
+#if mwLinkTable_d
+		UpdateLinkTx(pMw, &pMsgIn->msgData.dataCnf);
+#endif
+		/* The request is done, free it and make room for the next one */
+		if(CompleteTxSlot(pMw, pMsgIn->msgData.dataCnf.msduHandle, pMsgIn->msgData.dataCnf.status))
+		{
+			return FALSE;
+		}
+		break;
+
+	case gMcpsDataInd_c:
+		/* Keep track of the link to the devices associated to us */
+		if(pMsgIn->msgData.dataInd.srcAddrMode == gAddrModeShortAddress_c)
+		{
+			deviceTableEntry_t *pDevice = DeviceTable_FindByShortAddr((uint16_t)pMsgIn->msgData.dataInd.srcAddr);
+
+			if(pDevice != NULL)
+			{
+				pDevice->lastSeen = OSA_TimeGetMsec();
+				pDevice->linkQuality = pMsgIn->msgData.dataInd.mpduLinkQuality;
+			}
+#if mwLinkTable_d
+			LinkTable_Heard((uint8_t)(pMw - mInstances), (uint16_t)pMsgIn->msgData.dataInd.srcAddr,
+			                pMsgIn->msgData.dataInd.mpduLinkQuality, OSA_TimeGetMsec());
+#endif
+		}
+#if mwDupFilter_d
+		/* A copy of the previous frame, sent again after a lost acknowledgement.
+		 * A short address is only unique in its PAN. */
+		src = pMsgIn->msgData.dataInd.srcAddr;
+		if(pMsgIn->msgData.dataInd.srcAddrMode == gAddrModeShortAddress_c) {
+			src = (uint16_t)src | ((uint64_t)pMsgIn->msgData.dataInd.srcPanId << 16);
+		}
+		if(DupFilter_IsDuplicate(src, pMsgIn->msgData.dataInd.srcAddrMode,
+		                         pMsgIn->msgData.dataInd.dsn, OSA_TimeGetMsec()))
+		{
+#if mwStatistics_d
+			pMw->stats.rx_duplicates++;
+#endif
+			TRACE(gTraceMwRxDuplicate_c, pMsgIn->msgData.dataInd.srcAddr, pMsgIn->msgData.dataInd.dsn);
+			return FALSE;
+		}
+#endif
+#if mwDispatchLen_c
+		if(pMsgIn->msgData.dataInd.msduLength == 0)
+		{
+			return FALSE;
+		}
+
+		switch(pMsgIn->msgData.dataInd.pMsdu[0])
+		{
+		case mwDispatchData_c:
+			/* The upper layer gets the payload only */
+			pMsgIn->msgData.dataInd.pMsdu += mwDispatchLen_c;
+			pMsgIn->msgData.dataInd.msduLength -= mwDispatchLen_c;
+			break;
+
+#if mwCoalescing_d
+		case mwDispatchPacked_c:
+			UnpackRx(pMw, pMsgIn);
+			return FALSE;
+#endif
+
+		default:
+#if mwFragmentation_d
+			/* Fragments and acknowledgements stay in the wrapper */
+			Frag_Receive(&pMw->frag, (uint16_t)pMsgIn->msgData.dataInd.srcAddr,
+			             pMsgIn->msgData.dataInd.pMsdu, pMsgIn->msgData.dataInd.msduLength);
+#endif
+			return FALSE;
+		}
+#endif
+		TRACE(gTraceMwRxDeliver_c, pMsgIn->msgData.dataInd.srcAddr, pMsgIn->msgData.dataInd.msduLength);
+		break;
+
+	case gMcpsPurgeCnf_c:
+		break;
+
+	default:
+		break;
+	}
+
+	return TRUE;
+}
+
+#if mwCoalescing_d
+/******************************************************************************
+ * The FlushPacks() function sends the packed frames whose deadline is
+ * reached, and restarts the flush timer for the next deadline.
+ ******************************************************************************/
+static void FlushPacks(mw_instance_t* pMw)
+{
+	nwkToMcpsMessage_t *pPacket;
+	uint32_t now = OSA_TimeGetMsec();
+	uint32_t next = mwCoalesceFlushTime_c;
+	uint8_t length;
+	uint8_t i;
+
+	for(i = 0; i < mwCoalesceMaxDest_c; i++)
+	{
+		pPacket = NULL;
+		length = 0;
+
+		OSA_InterruptDisable();
+		if(pMw->packs[i].pPacket != NULL)
+		{
+			if((int32_t)(now - pMw->packs[i].deadline) >= 0)
+			{
+				pPacket = pMw->packs[i].pPacket;
+				length = pMw->packs[i].length;
+				pMw->packs[i].pPacket = NULL;
+			}
+			else if(pMw->packs[i].deadline - now < next)
+			{
+				next = pMw->packs[i].deadline - now;
+			}
+		}
+		OSA_InterruptEnable();
+
+		if(pPacket != NULL)
+		{
+			(void)CommitTxBuffer(pMw, pPacket, length);
+		}
+	}
+
+	for(i = 0; i < mwCoalesceMaxDest_c; i++)
+	{
+		if(pMw->packs[i].pPacket != NULL)
+		{
+			TMR_StartSingleShotTimer(pMw->flushTimer, next, FlushTimerCallback, pMw);
+			break;
+		}
+	}
+}
+
+/******************************************************************************
+ * The FlushTimerCallback() function is the flush timer callback.
+ ******************************************************************************/
+static void FlushTimerCallback(void *pData)
+{
+	mw_instance_t *pMw = pData;
+
+	OSA_EventSet(pMw->event, mw_event_flush_c);
+}
+
+/******************************************************************************
+ * The PackTxConfirm() function is the completion callback of the packed
+ * frames. The payloads have no confirm of their own.
+ ******************************************************************************/
+static void PackTxConfirm(resultType_t status, void* context)
+{
+#if mwStatistics_d
+	mw_instance_t *pMw = context;
+
+	if(status == gSuccess_c) {
+		pMw->stats.packed_frames++;
+	}
+#else
+	(void)status;
+	(void)context;
+#endif
+}
+
+/******************************************************************************
+ * The UnpackRx() function gives each payload of a packed frame to the upper
+ * layer callback as a data indication of its own. They all point into the
+ * same message, so none of them can be retained.
+ ******************************************************************************/
+static void UnpackRx(mw_instance_t* pMw, mcpsToNwkMessage_t *pMsgIn)
+{
+	mac_event_data_t event_data;
+	uint8_t *pEntry = pMsgIn->msgData.dataInd.pMsdu + mwDispatchLen_c;
+	uint8_t *pEnd = pMsgIn->msgData.dataInd.pMsdu + pMsgIn->msgData.dataInd.msduLength;
+
+	event_data.mac_event_type = mac_data_event_c;
+	event_data.evt_data.data_event_data = pMsgIn;
+	event_data.instance = (uint8_t)(pMw - mInstances);
+	event_data.can_retain = FALSE;
+	event_data.retained = FALSE;
+
+	/* Stop at the first length that does not fit */
+	while((pEntry < pEnd) && (pEntry[0] != 0) && (pEntry[0] < pEnd - pEntry))
+	{
+		pMsgIn->msgData.dataInd.pMsdu = &pEntry[1];
+		pMsgIn->msgData.dataInd.msduLength = pEntry[0];
+		if(pMw->evt_hdlr != NULL) {
+			pMw->evt_hdlr((void*)&event_data);
+		}
+		pEntry += 1 + pEntry[0];
+	}
+}
+#endif
+
+#if mwFragmentation_d
+/******************************************************************************
+ * The ProcessFragments() function starts the mac_transmit_large() request,
+ * if any, and lets the fragmentation layer send what it can. The
+ * fragmentation timer keeps calling it while a transfer or a reassembly is
+ * in progress.
+ ******************************************************************************/
+static void ProcessFragments(mw_instance_t* pMw)
+{
+	if(pMw->largeTx.pending)
+	{
+		pMw->largeTx.pending = FALSE;
+		(void)Frag_Send(&pMw->frag, pMw->largeTx.dest_address, pMw->largeTx.pData, pMw->largeTx.length, FragTxDone, pMw);
+	}
+
+	if(Frag_Process(&pMw->frag))
+	{
+		if(!TMR_IsTimerActive(pMw->fragTimer))
+		{
+			TMR_StartIntervalTimer(pMw->fragTimer, mwFragTickInterval_c, FragTimerCallback, pMw);
+		}
+	}
+	else
+	{
+		TMR_StopTimer(pMw->fragTimer);
+	}
+}
+
+/******************************************************************************
+ * The FragTimerCallback() function is the fragmentation timer callback.
+ ******************************************************************************/
+static void FragTimerCallback(void *pData)
+{
+	mw_instance_t *pMw = pData;
+
+	OSA_EventSet(pMw->event, mw_event_fragment_c);
+}
+
+/******************************************************************************
+ * The FragSend() function queues a frame of the fragmentation layer. The
+ * frame starts with its own dispatch byte, which takes the place of the data
+ * one. At most mwFragMaxQueuedTx_c fragments are queued or in the MAC: they
+ * keep the MAC busy whatever the other requests queued, and these do not wait
+ * behind a whole window.
+ *
+ * The function returns FALSE if the frame cannot be queued now.
+ ******************************************************************************/
+static bool_t FragSend(fragInstance_t* pInst, uint16_t dest, uint8_t* pFrame, uint8_t length)
+{
+	mw_instance_t *pMw = FragOwner(pInst);
+	nwkToMcpsMessage_t *pPacket;
+	mw_tx_slot_t *pSlot;
+
+	if(pMw->fragTxQueued >= mwFragMaxQueuedTx_c) {
+		return FALSE;
+	}
+
+	if(AllocTxBuffer(pMw, dest, length - mwDispatchLen_c, mac_tx_priority_normal_c, 0, &pPacket) != mwErrorNoError) {
+		return FALSE;
+	}
+	FLib_MemCpy(pPacket->msgData.dataReq.pMsdu, pFrame, length);
+
+	/* The confirm does not go to the upper layer */
+	pSlot = &pMw->txSlots[mwTxSlotFromHandle(pPacket->msgData.dataReq.msduHandle)];
+	pSlot->callback = FragTxConfirm;
+	pSlot->context = pMw;
+
+	if(CommitTxBuffer(pMw, pPacket, length - mwDispatchLen_c) != mwErrorNoError) {
+		return FALSE;
+	}
+	pMw->fragTxQueued++;
+	return TRUE;
+}
+
+/******************************************************************************
+ * The FragTxConfirm() function is the completion callback of the frames of
+ * the fragmentation layer. The receiver acknowledges the fragments itself, and
+ * the next ones are sent once the MCPS input is processed (see mac_task).
+ ******************************************************************************/
+static void FragTxConfirm(resultType_t status, void* context)
+{
+	mw_instance_t *pMw = context;
+
+	(void)status;
+
+	pMw->fragTxQueued--;
+}
+
+/******************************************************************************
+ * The FragDeliver() function gives a reassembled payload to the upper layer
+ * callback, and frees it unless the callback keeps it.
+ ******************************************************************************/
+static void FragDeliver(fragInstance_t* pInst, uint16_t src, uint8_t* pData, uint16_t length)
+{
+	mw_instance_t *pMw = FragOwner(pInst);
+	mac_event_data_t event_data;
+	mac_large_data_t large_data;
+
+	large_data.src_address = src;
+	large_data.length = length;
+	large_data.pData = pData;
+
+	event_data.mac_event_type = mac_large_data_event_c;
+	event_data.evt_data.large_data_event_data = &large_data;
+	event_data.instance = (uint8_t)(pMw - mInstances);
+	event_data.can_retain = TRUE;
+	event_data.retained = FALSE;
+	if(pMw->evt_hdlr != NULL) {
+		pMw->evt_hdlr((void*)&event_data);
+	}
+
+	if(!event_data.retained) {
+		(void)MEM_BufferFree(pData);
+	}
+}
+
+/******************************************************************************
+ * The FragOwner() function returns the wrapper instance of a fragmentation
+ * layer instance.
+ ******************************************************************************/
+static mw_instance_t* FragOwner(fragInstance_t* pInst)
+{
+	/* pInst is the frag member of one of mInstances[] */
+	uint32_t i = (uint32_t)((uint8_t*)pInst - (uint8_t*)&mInstances[0].frag) / sizeof(mw_instance_t);
+
+	return &mInstances[i];
+}
+
+/******************************************************************************
+ * The FragTxDone() function ends a mac_transmit_large() request.
+ ******************************************************************************/
+static void FragTxDone(resultType_t status, void* context)
+{
+	mw_instance_t *pMw = context;
+	mac_tx_callback_t callback = pMw->largeTx.callback;
+	void *tx_ctx = pMw->largeTx.context;
+
+	/* The callback may start the next transfer */
+	OSA_InterruptDisable();
+	pMw->largeTx.busy = FALSE;
+	OSA_InterruptEnable();
+
+	callback(status, tx_ctx);
+}
+#endif
+
+/******************************************************************************
+ * The following functions are called by the MAC to put messages into the
+ * Application's queue. They need to be defined even if they are not used
+ * in order to avoid linker errors.
+ ******************************************************************************/
+
+static resultType_t MLME_NWK_SapHandler (nwkMessage_t* pMsg, instanceId_t instanceId)
+{
+	/* mac_init() binds the instance i to the MAC with the id i */
+	mw_instance_t *pMw = &mInstances[instanceId];
+
+	TRACE(gTraceMacMlmeSap_c, pMsg->msgType, instanceId);
+	/* Put the incoming MLME message in the applications input queue. */
+	MSG_Queue(&pMw->mlmeNwkInputQueue, pMsg);
+	OSA_EventSet(pMw->event, gAppEvtMessageFromMLME_c);
+	return gSuccess_c;
+}
+
+static resultType_t MCPS_NWK_SapHandler (mcpsToNwkMessage_t* pMsg, instanceId_t instanceId)
+{
+	/* mac_init() binds the instance i to the MAC with the id i */
+	mw_instance_t *pMw = &mInstances[instanceId];
+
+	TRACE(gTraceMacMcpsSap_c, pMsg->msgType, (pMsg->msgType == gMcpsDataCnf_c) ?
+	      (pMsg->msgData.dataCnf.msduHandle | (pMsg->msgData.dataCnf.status << 8)) : pMsg->msgData.dataInd.msduLength);
+#if mwLatencyStats_d
+	if(pMsg->msgType == gMcpsDataCnf_c)
+	{
+		StampTxConfirm(pMw, &pMsg->msgData.dataCnf);
+	}
+#endif
+
+	/* Put the incoming MCPS message in the applications input queue. */
+	MSG_Queue(&pMw->mcpsNwkInputQueue, pMsg);
+	OSA_EventSet(pMw->event, gAppEvtMessageFromMCPS_c);
+	return gSuccess_c;
+}
@@ -1,129 +1,782 @@
-/*
- * ieee802p15p4_wrapper.h
- *
- *  Created on: Sep 4, 2019
- *      Author: Nico
- */
-
-#ifndef IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_H_
-#define IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_H_
-
-#include "MacInterface.h"
-/************************************************************************************
-*************************************************************************************
-* Public macros
-*************************************************************************************
-************************************************************************************/
-
-/************************************************************************************
-*************************************************************************************
-* Public type definitions
-*************************************************************************************
-************************************************************************************/
-
-/* Error codes */
-enum
-{
-  mwErrorNoError,
-  mwErrorWrongConfirm,
-  mwErrorNotSuccessful,
-  mwErrorNoMessage,
-  mwErrorAllocFailed,
-  mwErrorInvalidParameter,
-  mwErrorNoScanResults,
-  mwErrorAlreadyInitialized,
-  mwErrorAlreadyConnected,
-  mwErrorPanAccessDenied,
-  mwErrorTransmissionInprogress,
-};
-
-typedef enum {
-	mac_data_event_c,
-	mac_management_event_c,
-	mac_max_event_c
-}mac_wrapper_event_id_t;
-
-typedef struct _mac_event_data{
-	mac_wrapper_event_id_t mac_event_type;
-	union{
-		/*Check MacInterface.h and MacMessages.h to see the contents of these
-		 * MAC structures */
-		mcpsToNwkMessage_t* 	data_event_data;
-		nwkMessage_t*		management_event_data;
-	}evt_data;
-}mac_event_data_t;
-
-/******************************************************************************
-*******************************************************************************
-* Public Prototypes
-*******************************************************************************
-******************************************************************************/
-#ifdef __cplusplus
-extern "C" {
-#endif
-/*FUNCTION**********************************************************************
- *
- * Function Name : mac_init
- * Description   : Initializes the ieee802.15.4 data link layer custom wrapper.
- *                 This is a blocking function.
- *
- * Params: mac_addr - Pointer to a 8 bytes array that contains the board's MAC
- *                    address.
- *
- * Return: int: 0 - success.
- *
- *END**************************************************************************/
-extern int mac_init(uint8_t* mac_addr);
-
-/*FUNCTION**********************************************************************
- *
- * Function Name : mac_connect
- * Description   : Commands the node to connect to a ieee802.15.4 network, if
- *                 the network does not exists then the node starts it.
- *                 mac_init() has to be called first.
- *                 This is a non-blocking function. The result of the connection
- *                 request will be recibed in a call to the event handler
- *                 callback (evt_hdlr).
- *
- * Params: channel  - Channel to start the network (11-26).
- *         pan_id   - Id of the network
- *         evt_hdlr - Pointer to a callback function that will be called by the
- *                    mac wrapper to signal events on the MAC layer to the
- *                    calling layer. The events received by this callback are:
- *                    * Data reception.
- *                    * Data Transmission confirm.
- *                    * Network Connection.
- *                    * Network Disconnections
- *
- * Return: int: 0 - success.
- *
- *END**************************************************************************/
-extern int mac_connect(uint8_t channel, uint16_t pan_id, void (*evt_hdlr)(void*));
-
-/*FUNCTION**********************************************************************
- *
- * Function Name : mac_transmit
- * Description   : Commands the node to send data to another node over a
- *                 ieee802.15.4 network.
- *                 mac_connect() has to be called before hand.
- *                 This is a non-blocking function. The result of the
- *                 transmission request will be recibed in a call to the event
- *                 handler callback (evt_hdlr).
- *
- *
- * Params: dest_address  - Address of the data's destination node.
- *         data   - Pointer to the data array to transmit
- *         data_len - Size in bytes of the data array.
- *
- * Return: int: 0 - success.
- *
- *END**************************************************************************/
-extern int mac_transmit(uint16_t dest_address, uint8_t* data, uint8_t data_len);
-
-#ifdef __cplusplus
-}
-#endif
-
-/**********************************************************************************/
-
-#endif /* IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_H_ */
+/*
+ * ieee802p15p4_wrapper.h
+ *
+ *  Created on: Sep 4, 2019
+ *      Author: Nico
+ */
+
+#ifndef IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_H_
+#define IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_H_
+
+#include "MacInterface.h"
+#include "Trace.h"
+#include "ieee802p15p4_wrapper_cfg.h"
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+/* Channel masks for mac_connect_scan(), bit n for channel n */
+#define mwChannelMask(ch)     ((uint32_t)1 << (ch))
+#define mwChannelMaskAll_c    0x07FFF800UL    /* Channels 11-26 */
+
+/* Longest MSDU of a data frame: aMaxPHYPacketSize less the 11 bytes of MAC
+ * header and FCS with short addresses, the PAN id compressed and no security */
+#define mwMaxPayload_c        116
+
+/* Events of the wrapper in the trace (gTraceEnabled_d), with their arguments.
+ * The MAC group holds the messages of the MAC, as they reach the SAP handlers. */
+#define gTraceMacMlmeSap_c        gTraceId_c(gTraceGroupMac_c, 0x01)      /* msgType, instance */
+#define gTraceMacMcpsSap_c        gTraceId_c(gTraceGroupMac_c, 0x02)      /* msgType, handle | status << 8 or length */
+#define gTraceMwTaskWakeup_c      gTraceId_c(gTraceGroupWrapper_c, 0x01)  /* events, instance */
+#define gTraceMwTxQueued_c        gTraceId_c(gTraceGroupWrapper_c, 0x02)  /* msduHandle, length */
+#define gTraceMwTxHandOver_c      gTraceId_c(gTraceGroupWrapper_c, 0x03)  /* msduHandle, requests in the MAC */
+#define gTraceMwTxComplete_c      gTraceId_c(gTraceGroupWrapper_c, 0x04)  /* msduHandle, status */
+#define gTraceMwRxDeliver_c       gTraceId_c(gTraceGroupWrapper_c, 0x05)  /* source address, length */
+#define gTraceMwRxDuplicate_c     gTraceId_c(gTraceGroupWrapper_c, 0x06)  /* source address, DSN */
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+
+/* Error codes */
+enum
+{
+  mwErrorNoError,
+  mwErrorWrongConfirm,
+  mwErrorNotSuccessful,
+  mwErrorNoMessage,
+  mwErrorAllocFailed,
+  mwErrorInvalidParameter,
+  mwErrorNoScanResults,
+  mwErrorAlreadyInitialized,
+  mwErrorAlreadyConnected,
+  mwErrorPanAccessDenied,
+  mwErrorTransmissionInprogress,
+  mwErrorTxQueueFull,
+};
+
+typedef enum {
+	mac_data_event_c,
+	mac_management_event_c,
+	mac_large_data_event_c,     /* A payload of mac_transmit_large() */
+	mac_max_event_c
+}mac_wrapper_event_id_t;
+
+/* A payload received from mac_transmit_large() (mwFragmentation_d). pData is
+ * a MemManager buffer: the callback can keep it by setting retained, and then
+ * it has to free it with MEM_BufferFree() (see can_retain in mac_event_data_t). */
+typedef struct _mac_large_data{
+	uint16_t src_address;
+	uint16_t length;
+	uint8_t* pData;
+}mac_large_data_t;
+
+typedef struct _mac_event_data{
+	mac_wrapper_event_id_t mac_event_type;
+	union{
+		/*Check MacInterface.h and MacMessages.h to see the contents of these
+		 * MAC structures */
+		mcpsToNwkMessage_t* 	data_event_data;
+		nwkMessage_t*		management_event_data;
+		mac_large_data_t*	large_data_event_data;
+	}evt_data;
+	/* Wrapper instance (PAN) of the event, 0 unless mwMaxInstances_c is above 1 */
+	uint8_t instance;
+	/* Receive ownership transfer. The wrapper sets can_retain on a data
+	 * indication that the callback is allowed to keep (mwRxZeroCopy_d), and
+	 * on every large data event. The callback sets retained to keep it, and
+	 * then it has to release it: a data indication with mac_rx_release(), the
+	 * pData buffer of a large data event with MEM_BufferFree(), never with
+	 * mac_rx_release(). Otherwise it is freed when the callback returns. */
+	bool_t can_retain;
+	bool_t retained;
+}mac_event_data_t;
+
+/* Completion callback of mac_transmit_async(). status is the one of the
+ * MCPS-DATA.confirm (gSuccess_c, gNoAck_c, gChannelAccessFailure_c...), or
+ * the reason the MAC rejected the request. */
+typedef void (*mac_tx_callback_t)(resultType_t status, void* context);
+
+/* Transmit queue watermark callback (mac_tx_set_watermarks()). queued is the
+ * number of outstanding requests when the watermark was crossed. */
+typedef void (*mac_tx_watermark_callback_t)(uint8_t queued);
+
+/* Transmit priority classes (mac_transmit_priority()) */
+typedef enum {
+	mac_tx_priority_normal_c,
+	mac_tx_priority_high_c,
+	mac_tx_priority_max_c
+}mac_tx_priority_t;
+
+/* Queueing delay of the requests of a priority class that left the MAC,
+ * confirmed or rejected, from the moment they were queued in the wrapper
+ * (mwStatistics_d). The averages are the totals divided by count. */
+typedef struct _mac_tx_delay_stats{
+	uint32_t count;
+	uint32_t queue_max_us;    /* Until handed to the MAC */
+	uint32_t queue_total_us;
+	uint32_t cnf_max_us;      /* Until the MCPS-DATA.confirm */
+	uint32_t cnf_total_us;
+}mac_tx_delay_stats_t;
+
+/* Wrapper statistics (mwStatistics_d) */
+typedef struct _mac_wrapper_stats{
+	uint32_t wakeups;     /* Times the mac task returned from waiting for events */
+	uint32_t mlme_msgs;   /* MLME messages processed */
+	uint32_t mcps_msgs;   /* MCPS messages processed */
+	uint32_t packed_msgs;   /* Payloads given to mac_transmit_coalesced() */
+	uint32_t packed_frames; /* Frames they were sent in */
+	uint32_t rx_duplicates; /* Frames dropped by the duplicate filter */
+	uint32_t assoc_responses; /* Association responses sent (coordinator) */
+	uint32_t assoc_dropped;   /* Associate indications dropped, mwMaxPendingAssoc_c
+	                           * responses waiting for their comm status */
+	mac_tx_delay_stats_t tx_delay[mac_tx_priority_max_c];
+}mac_wrapper_stats_t;
+
+/* Link to a neighbor (mwLinkTable_d), see mac_get_link() */
+typedef struct _mac_link_info{
+	uint16_t short_address;
+	uint8_t  lqi;             /* Average LQI of the frames received */
+	int8_t   rssi;            /* Average RSSI of the frames received [dBm] */
+	uint8_t  last_lqi;        /* LQI of the last frame received */
+	uint32_t last_heard_ms;   /* Time since the last frame or acknowledgement
+	                           * received, 0xFFFFFFFF if none yet */
+	uint32_t rx_frames;
+	uint32_t tx_attempts;     /* Data requests confirmed */
+	uint32_t tx_no_ack;
+	uint32_t tx_failures;     /* Other unsuccessful confirms */
+	uint32_t cnf_latency_us;  /* Average time from the hand-off to the MAC to
+	                           * the confirm, retries included */
+}mac_link_info_t;
+
+/* Stages of a data request (mwLatencyStats_d), see mac_get_latency() */
+typedef enum {
+	mac_latency_queue_c,      /* From mac_transmit() until handed to the MAC */
+	mac_latency_mac_c,        /* Until the PHY starts the last attempt: the
+	                           * backoffs and the attempts that failed */
+	mac_latency_phy_c,        /* The last attempt: CCA, frame and ACK */
+	mac_latency_confirm_c,    /* Until the MCPS-DATA.confirm reaches the wrapper */
+	mac_latency_delivery_c,   /* Until the mac task gives it to the completion
+	                           * callback or evt_hdlr */
+	mac_latency_total_c,      /* From mac_transmit() until given back */
+	mac_latency_stages_c
+}mac_latency_stage_t;
+
+/* Latency of one stage of the data requests (mwLatencyStats_d) */
+typedef struct _mac_latency_stats{
+	uint32_t count;
+	uint32_t min_us;          /* 0 without samples */
+	uint32_t max_us;
+	uint32_t avg_us;
+	uint32_t buckets[mwLatencyBuckets_c];   /* Bucket 0: below 2 us, bucket n:
+	                                         * from 2^n us, below 2^(n+1) us,
+	                                         * the last one: every longer time */
+}mac_latency_stats_t;
+
+/******************************************************************************
+*******************************************************************************
+* Public Prototypes
+*******************************************************************************
+******************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_init
+ * Description   : Initializes the ieee802.15.4 data link layer custom wrapper.
+ *                 This is a blocking function.
+ *
+ * Params: mac_addr - Pointer to a 8 bytes array that contains the board's MAC
+ *                    address.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorAlreadyInitialized - mac_init() was already called.
+ *              mwErrorNotSuccessful - The MAC has no instance left for one
+ *              of the mwMaxInstances_c wrapper instances.
+ *
+ *END**************************************************************************/
+extern int mac_init(uint8_t* mac_addr);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_connect
+ * Description   : Commands the node to connect to a ieee802.15.4 network, if
+ *                 the network does not exists then the node starts it.
+ *                 mac_init() has to be called first.
+ *                 This is a non-blocking function. The result of the connection
+ *                 request will be recibed in a call to the event handler
+ *                 callback (evt_hdlr).
+ *
+ * Params: channel  - Channel to start the network (11-26).
+ *         pan_id   - Id of the network
+ *         evt_hdlr - Pointer to a callback function that will be called by the
+ *                    mac wrapper to signal events on the MAC layer to the
+ *                    calling layer. The events received by this callback are:
+ *                    * Data reception.
+ *                    * Data Transmission confirm.
+ *                    * Network Connection.
+ *                    * Network Disconnections
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - The channel is not in 11-26.
+ *
+ *END**************************************************************************/
+extern int mac_connect(uint8_t channel, uint16_t pan_id, void (*evt_hdlr)(void*));
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_connect_on
+ * Description   : Same as mac_connect(), on the given wrapper instance. Each
+ *                 instance connects to its own PAN, with its own event
+ *                 handler callback, and the functions without the _on
+ *                 suffix work on instance 0.
+ *                 With mwMaxInstances_c 2, the two PANs share the
+ *                 transceiver: on different channels the receiver only
+ *                 listens to one of them at a time, see
+ *                 mac_set_dual_pan_dwell().
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_connect().
+ *
+ * Return: see mac_connect().
+ *
+ *END**************************************************************************/
+extern int mac_connect_on(uint8_t instance, uint8_t channel, uint16_t pan_id, void (*evt_hdlr)(void*));
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_connect_scan
+ * Description   : Same as mac_connect(), but the network is looked for on
+ *                 every channel of channel_mask, scan_duration per channel.
+ *                 If it is not found, the node starts it on the quietest of
+ *                 them: the one with the lowest energy measured by an ED
+ *                 scan, counting the other PANs heard on the channels as
+ *                 energy too (mwScanPanPenalty_c).
+ *                 mac_init() has to be called first.
+ *                 This is a non-blocking function. The result of the
+ *                 connection request will be recibed in a call to the event
+ *                 handler callback (evt_hdlr).
+ *
+ * Params: channel_mask  - Channels to scan, see mwChannelMask() and
+ *                         mwChannelMaskAll_c.
+ *         scan_duration - Scan duration per channel (0-14). A channel takes
+ *                         15.36 ms * (2^scan_duration + 1) per scan.
+ *         pan_id        - Id of the network
+ *         evt_hdlr      - Event callback, see mac_connect().
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - No channel in 11-26 or a channel
+ *                                        outside of it, or a duration above 14.
+ *
+ *END**************************************************************************/
+extern int mac_connect_scan(uint32_t channel_mask, uint8_t scan_duration, uint16_t pan_id, void (*evt_hdlr)(void*));
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_connect_scan_on
+ * Description   : Same as mac_connect_scan(), on the given wrapper instance: the PAN
+ *                 connected with mac_connect_on() on that instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_connect_scan().
+ *
+ * Return: see mac_connect_scan().
+ *
+ *END**************************************************************************/
+extern int mac_connect_scan_on(uint8_t instance, uint32_t channel_mask, uint8_t scan_duration, uint16_t pan_id,
+                              void (*evt_hdlr)(void*));
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit
+ * Description   : Commands the node to send data to another node over a
+ *                 ieee802.15.4 network.
+ *                 mac_connect() has to be called before hand.
+ *                 This is a non-blocking function. The result of the
+ *                 transmission request will be recibed in a call to the event
+ *                 handler callback (evt_hdlr).
+ *                 Up to mwMaxPendingTx_c requests can be outstanding at the
+ *                 same time, each one is confirmed with its own
+ *                 gMcpsDataCnf_c event.
+ *
+ *
+ * Params: dest_address  - Address of the data's destination node.
+ *         data   - Pointer to the data array to transmit
+ *         data_len - Size in bytes of the data array.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorTxQueueFull - mwMaxPendingTx_c requests are waiting
+ *                                   for confirm, try again later.
+ *
+ *END**************************************************************************/
+extern int mac_transmit(uint16_t dest_address, uint8_t* data, uint8_t data_len);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_on
+ * Description   : Same as mac_transmit(), on the given wrapper instance: the PAN
+ *                 connected with mac_connect_on() on that instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit().
+ *
+ * Return: see mac_transmit().
+ *
+ *END**************************************************************************/
+extern int mac_transmit_on(uint8_t instance, uint16_t dest_address, uint8_t* data, uint8_t data_len);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_wait
+ * Description   : Same as mac_transmit(), but when mwMaxPendingTx_c requests
+ *                 are outstanding the calling task blocks until one of them
+ *                 is confirmed, or until the timeout expires.
+ *                 Only for tasks: neither the mac task nor the event handler
+ *                 shall call this function.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         data         - Pointer to the data array to transmit.
+ *         data_len     - Size in bytes of the data array.
+ *         timeout_ms   - Maximum time to wait for room in the queue,
+ *                        osaWaitForever_c to wait as long as needed.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorTxQueueFull - Still full after timeout_ms.
+ *
+ *END**************************************************************************/
+extern int mac_transmit_wait(uint16_t dest_address, uint8_t* data, uint8_t data_len, uint32_t timeout_ms);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_wait_on
+ * Description   : Same as mac_transmit_wait(), on the given wrapper
+ *                 instance: the PAN connected with mac_connect_on() on
+ *                 that instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit_wait().
+ *
+ * Return: see mac_transmit_wait().
+ *
+ *END**************************************************************************/
+extern int mac_transmit_wait_on(uint8_t instance, uint16_t dest_address, uint8_t* data, uint8_t data_len,
+                                uint32_t timeout_ms);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_priority
+ * Description   : Same as mac_transmit(), in the given priority class.
+ *                 A high priority request (alarms) is handed to the MAC
+ *                 before any queued normal priority one (bulk data), and
+ *                 waits for at most mwMaxInFlightNormalTx_c normal priority
+ *                 requests already in the MAC. mwTxHighReservedSlots_c slots
+ *                 of the queue are kept for high priority requests.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         data         - Pointer to the data array to transmit.
+ *         data_len     - Size in bytes of the data array.
+ *         priority     - mac_tx_priority_normal_c or mac_tx_priority_high_c.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorTxQueueFull - No slot left for the priority class.
+ *
+ *END**************************************************************************/
+extern int mac_transmit_priority(uint16_t dest_address, uint8_t* data, uint8_t data_len, mac_tx_priority_t priority);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_priority_on
+ * Description   : Same as mac_transmit_priority(), on the given wrapper instance: the PAN
+ *                 connected with mac_connect_on() on that instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit_priority().
+ *
+ * Return: see mac_transmit_priority().
+ *
+ *END**************************************************************************/
+extern int mac_transmit_priority_on(uint8_t instance, uint16_t dest_address, uint8_t* data, uint8_t data_len,
+                                    mac_tx_priority_t priority);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_async
+ * Description   : Same as mac_transmit(), but the result of the transmission
+ *                 is given to tx_cb, with tx_ctx, instead of the event
+ *                 handler callback. Each request has its own callback and
+ *                 context.
+ *                 tx_cb is called from the mac task once the MAC confirms
+ *                 the request, or rejects it. It may transmit again.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         data         - Pointer to the data array to transmit, copied
+ *                        before the function returns.
+ *         data_len     - Size in bytes of the data array.
+ *         tx_cb        - Completion callback, called exactly once.
+ *         tx_ctx       - Passed to tx_cb as is.
+ *
+ * Return: int: 0 - success, tx_cb will be called.
+ *              mwErrorTxQueueFull - mwMaxPendingTx_c requests are waiting
+ *                                   for confirm, try again later.
+ *              Any other error: tx_cb will not be called.
+ *
+ *END**************************************************************************/
+extern int mac_transmit_async(uint16_t dest_address, uint8_t* data, uint8_t data_len,
+                              mac_tx_callback_t tx_cb, void* tx_ctx);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_async_on
+ * Description   : Same as mac_transmit_async(), on the given wrapper instance: the PAN
+ *                 connected with mac_connect_on() on that instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit_async().
+ *
+ * Return: see mac_transmit_async().
+ *
+ *END**************************************************************************/
+extern int mac_transmit_async_on(uint8_t instance, uint16_t dest_address, uint8_t* data, uint8_t data_len,
+                                 mac_tx_callback_t tx_cb, void* tx_ctx);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_buffer_get
+ * Description   : Zero-copy alternative to mac_transmit(). Reserves a
+ *                 transmission slot and returns the payload area of an
+ *                 already built MCPS-DATA.request so the data can be written
+ *                 in place. The buffer has to be handed back with
+ *                 mac_tx_buffer_commit().
+ *                 mac_connect() has to be called before hand.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         max_len      - Maximum number of bytes that will be written.
+ *
+ * Return: uint8_t*: Pointer to max_len bytes of payload area, NULL if no
+ *                   transmission slot or buffer is available.
+ *
+ *END**************************************************************************/
+extern uint8_t* mac_tx_buffer_get(uint16_t dest_address, uint8_t max_len);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_buffer_get_on
+ * Description   : Same as mac_tx_buffer_get(), on the given wrapper
+ *                 instance: the PAN connected with mac_connect_on() on
+ *                 that instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_tx_buffer_get().
+ *
+ * Return: see mac_tx_buffer_get().
+ *
+ *END**************************************************************************/
+extern uint8_t* mac_tx_buffer_get_on(uint8_t instance, uint16_t dest_address, uint8_t max_len);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_buffer_commit
+ * Description   : Queues for transmission a buffer obtained with
+ *                 mac_tx_buffer_get(). The result of the transmission is
+ *                 received in a call to the event handler callback
+ *                 (evt_hdlr). The buffer shall not be used after this call.
+ *
+ * Params: buffer   - Pointer returned by mac_tx_buffer_get().
+ *         data_len - Number of bytes written, up to the max_len requested.
+ *                    A length of 0 drops the buffer without transmitting it.
+ *
+ * Return: int: 0 - success.
+ *
+ *END**************************************************************************/
+extern int mac_tx_buffer_commit(uint8_t* buffer, uint8_t data_len);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_buffer_commit_on
+ * Description   : Same as mac_tx_buffer_commit(), for a buffer obtained with
+ *                 mac_tx_buffer_get_on() on the same wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_tx_buffer_commit().
+ *
+ * Return: see mac_tx_buffer_commit().
+ *              mwErrorInvalidParameter - The buffer is not one of the
+ *                                        instance.
+ *
+ *END**************************************************************************/
+extern int mac_tx_buffer_commit_on(uint8_t instance, uint8_t* buffer, uint8_t data_len);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_set_watermarks
+ * Description   : Sets the transmit queue watermarks, so a producer can
+ *                 throttle itself instead of polling mac_transmit(). on_high
+ *                 is called when the number of outstanding requests reaches
+ *                 high, on_low when it drops back to low. Each one is called
+ *                 once per crossing, alternately.
+ *
+ * Params: high    - Outstanding requests that call on_high, 1 to
+ *                   mwMaxPendingTx_c.
+ *         low     - Outstanding requests that call on_low, below high.
+ *         on_high - Callback, may be NULL.
+ *         on_low  - Callback, may be NULL.
+ *
+ * Return: int: 0 - success.
+ *
+ *END**************************************************************************/
+extern int mac_tx_set_watermarks(uint8_t high, uint8_t low,
+                                 mac_tx_watermark_callback_t on_high, mac_tx_watermark_callback_t on_low);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_tx_set_watermarks_on
+ * Description   : Same as mac_tx_set_watermarks(), for the transmit queue of
+ *                 the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_tx_set_watermarks().
+ *
+ * Return: see mac_tx_set_watermarks().
+ *
+ *END**************************************************************************/
+extern int mac_tx_set_watermarks_on(uint8_t instance, uint8_t high, uint8_t low,
+                                    mac_tx_watermark_callback_t on_high, mac_tx_watermark_callback_t on_low);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_coalesced
+ * Description   : Same as mac_transmit(), but the payload is packed with the
+ *                 next ones for the same destination into one frame, sent
+ *                 when it is full or mwCoalesceFlushTime_c ms after its first
+ *                 payload. The receiver gets one data indication per payload.
+ *                 The frames are not confirmed to the event handler callback.
+ *                 Only available when mwCoalescing_d is enabled.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         data         - Pointer to the data array to transmit, copied
+ *                        before the function returns.
+ *         data_len     - Size in bytes of the data array, up to
+ *                        mwCoalesceMtu_c - 2.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorTxQueueFull - No slot for a new frame.
+ *
+ *END**************************************************************************/
+extern int mac_transmit_coalesced(uint16_t dest_address, uint8_t* data, uint8_t data_len);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_coalesced_on
+ * Description   : Same as mac_transmit_coalesced(), on the given wrapper
+ *                 instance: the PAN connected with mac_connect_on() on
+ *                 that instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit_coalesced().
+ *
+ * Return: see mac_transmit_coalesced().
+ *
+ *END**************************************************************************/
+extern int mac_transmit_coalesced_on(uint8_t instance, uint16_t dest_address, uint8_t* data, uint8_t data_len);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_large
+ * Description   : Sends up to mwFragMaxLength_c bytes as a train of
+ *                 fragments, which the receiver acknowledges selectively.
+ *                 The receiver gets the whole payload in one
+ *                 mac_large_data_event_c. One transfer at a time.
+ *                 Only available when mwFragmentation_d is enabled.
+ *
+ * Params: dest_address - Address of the data's destination node.
+ *         data         - Payload, not copied: it shall stay untouched until
+ *                        tx_cb is called.
+ *         data_len     - Size in bytes of the payload.
+ *         tx_cb        - Completion callback, called from the mac task:
+ *                        gSuccess_c once the receiver holds every fragment,
+ *                        gNoAck_c if it stopped answering.
+ *         tx_ctx       - Passed to tx_cb as is.
+ *
+ * Return: int: 0 - success, tx_cb will be called.
+ *              mwErrorTransmissionInprogress - A transfer is in progress.
+ *
+ *END**************************************************************************/
+extern int mac_transmit_large(uint16_t dest_address, const uint8_t* data, uint16_t data_len,
+                              mac_tx_callback_t tx_cb, void* tx_ctx);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_transmit_large_on
+ * Description   : Same as mac_transmit_large(), on the given wrapper
+ *                 instance: the PAN connected with mac_connect_on() on
+ *                 that instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_transmit_large().
+ *
+ * Return: see mac_transmit_large().
+ *
+ *END**************************************************************************/
+extern int mac_transmit_large_on(uint8_t instance, uint16_t dest_address, const uint8_t* data, uint16_t data_len,
+                                 mac_tx_callback_t tx_cb, void* tx_ctx);
+
+#if mwRxZeroCopy_d
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_rx_release
+ * Description   : Releases a data indication kept by the event handler
+ *                 callback (see can_retain/retained in mac_event_data_t).
+ *                 Not for the buffers of large data events.
+ *
+ * Params: pMsg - Message received in evt_data.data_event_data.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - pMsg is not a data indication kept
+ *                                        by the callback, or was released
+ *                                        already. It is not freed.
+ *
+ *END**************************************************************************/
+extern int mac_rx_release(mcpsToNwkMessage_t* pMsg);
+#endif
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_stats
+ * Description   : Copies the wrapper statistics. Only available when
+ *                 mwStatistics_d is enabled.
+ *
+ * Params: pStats - Where to copy the statistics.
+ *         reset  - TRUE to clear the counters after reading them.
+ *
+ * Return: int: 0 - success.
+ *
+ *END**************************************************************************/
+extern int mac_get_stats(mac_wrapper_stats_t* pStats, bool_t reset);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_stats_on
+ * Description   : Same as mac_get_stats(), on the given wrapper instance: the PAN
+ *                 connected with mac_connect_on() on that instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_get_stats().
+ *
+ * Return: see mac_get_stats().
+ *
+ *END**************************************************************************/
+extern int mac_get_stats_on(uint8_t instance, mac_wrapper_stats_t* pStats, bool_t reset);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_link
+ * Description   : Copies what the wrapper knows of the link to a neighbor.
+ *                 Only available when mwLinkTable_d is enabled.
+ *
+ * Params: short_address - Short address of the neighbor.
+ *         pInfo         - Where to copy it.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - Nothing was received from or sent
+ *                                        to the neighbor yet.
+ *
+ *END**************************************************************************/
+extern int mac_get_link(uint16_t short_address, mac_link_info_t* pInfo);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_link_on
+ * Description   : Same as mac_get_link(), for a neighbor in the PAN of the
+ *                 given wrapper instance: a short address is only unique in
+ *                 its PAN.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_get_link().
+ *
+ * Return: see mac_get_link().
+ *
+ *END**************************************************************************/
+extern int mac_get_link_on(uint8_t instance, uint16_t short_address, mac_link_info_t* pInfo);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_links
+ * Description   : Copies the links to every known neighbor, by increasing
+ *                 short address. Each record is copied as a whole, the
+ *                 wrapper keeps updating the others meanwhile.
+ *                 Only available when mwLinkTable_d is enabled.
+ *
+ * Params: pInfo     - Array of max_links records.
+ *         max_links - Size of the array.
+ *
+ * Return: uint16_t: Number of records copied.
+ *
+ *END**************************************************************************/
+extern uint16_t mac_get_links(mac_link_info_t* pInfo, uint16_t max_links);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_links_on
+ * Description   : Same as mac_get_links(), for the neighbors in the PAN of
+ *                 the given wrapper instance.
+ *
+ * Params: instance - Wrapper instance, below mwMaxInstances_c. The other
+ *                    parameters are the ones of mac_get_links().
+ *
+ * Return: see mac_get_links(). 0 if instance is out of range.
+ *
+ *END**************************************************************************/
+extern uint16_t mac_get_links_on(uint8_t instance, mac_link_info_t* pInfo, uint16_t max_links);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_get_latency
+ * Description   : Copies the latency of a stage of the data requests of every
+ *                 instance. A request is counted in each stage when its
+ *                 confirm is given back, rejected ones included. The MAC and
+ *                 PHY stages need a PHY built with gPhyTxTimestamps_d, and
+ *                 only count the requests whose last attempt succeeded.
+ *                 Only available when mwLatencyStats_d is enabled.
+ *
+ * Params: stage  - Stage, below mac_latency_stages_c.
+ *         pStats - Where to copy it.
+ *         reset  - TRUE to clear the stage after reading it.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - Unknown stage.
+ *
+ *END**************************************************************************/
+extern int mac_get_latency(mac_latency_stage_t stage, mac_latency_stats_t* pStats, bool_t reset);
+
+/*FUNCTION**********************************************************************
+ *
+ * Function Name : mac_set_dual_pan_dwell
+ * Description   : Sets the time the receiver stays on one PAN before
+ *                 switching to the other, when the two instances run PANs on
+ *                 different channels. A frame sent to the PAN not listened
+ *                 to is lost for this attempt, and the MAC retries it: short
+ *                 dwell times lose fewer frames per attempt but waste more
+ *                 of the receiver time in the switches.
+ *                 Only available when mwMaxInstances_c is above 1.
+ *
+ * Params: dwell_ms - Dwell time [ms], 1 to 3200. The MPM timer counts in
+ *                    steps of 0.5, 2.5, 10 or 50 ms, the closest value of
+ *                    the finest step that reaches dwell_ms is used.
+ *
+ * Return: int: 0 - success.
+ *              mwErrorInvalidParameter - dwell_ms out of range.
+ *
+ *END**************************************************************************/
+extern int mac_set_dual_pan_dwell(uint16_t dwell_ms);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**********************************************************************************/
+
+#endif /* IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_H_ */
@@ -1,22 +1,277 @@
-/*
- * ieee802p15p4_wrapper_cfg.h
- *
- *  Created on: Sep 4, 2019
- *      Author: Nico
- */
-
-#ifndef IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_CFG_H_
-#define IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_CFG_H_
-
-/************************************************************************************
-*************************************************************************************
-* Configuration macros
-*************************************************************************************
-************************************************************************************/
-
-
-/**********************************************************************************/
-
-
-
-#endif /* IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_CFG_H_ */
+/*
+ * ieee802p15p4_wrapper_cfg.h
+ *
+ *  Created on: Sep 4, 2019
+ *      Author: Nico
+ */
+
+#ifndef IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_CFG_H_
+#define IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_CFG_H_
+
+/************************************************************************************
+*************************************************************************************
+* Configuration macros
+*************************************************************************************
+************************************************************************************/
+/* Maximum number of MCPS-DATA.requests the wrapper keeps outstanding at the same
+ * time (queued in the wrapper or handed to the MAC and waiting for confirm).
+ * A power of two, up to 128: the MSDU handles encode the slot of the request.
+ * It is the size of the transmit queue: mac_transmit() fails and
+ * mac_transmit_wait() blocks once it is full. */
+#ifndef mwMaxPendingTx_c
+#define mwMaxPendingTx_c               16
+#endif
+
+/* Number of the outstanding MCPS-DATA.requests that are handed to the MAC at
+ * the same time, the others wait in the wrapper's transmit queue. At most
+ * mwMaxPendingTx_c. */
+#ifndef mwMaxInFlightTx_c
+#define mwMaxInFlightTx_c              3
+#endif
+
+/* Number of the requests in the MAC that can be normal priority ones, from 1
+ * to mwMaxInFlightTx_c. A high priority request waits for at most that many
+ * bulk frames in the MAC, so 1 gives alarms the shortest delay. With 2 the
+ * MAC already holds the next bulk frame when one is confirmed, and does not
+ * stay idle while the mac task wakes up to hand it over. Below
+ * mwMaxInFlightTx_c, a high priority request never waits for room in the MAC.
+ * host/PriorityTest.c measures both. */
+#ifndef mwMaxInFlightNormalTx_c
+#define mwMaxInFlightNormalTx_c        2
+#endif
+
+/* Slots of the transmit queue that normal priority requests never take, so
+ * bulk traffic cannot keep a high priority request out of the queue. Below
+ * mwMaxPendingTx_c. */
+#ifndef mwTxHighReservedSlots_c
+#define mwTxHighReservedSlots_c        2
+#endif
+
+/* Receive ownership transfer. When enabled, the event handler may keep the
+ * mcpsToNwkMessage_t of a data indication instead of copying its payload and
+ * release it later with mac_rx_release(). */
+#ifndef mwRxZeroCopy_d
+#define mwRxZeroCopy_d                 0
+#endif
+
+/* Maximum number of data indications the upper layer may keep at the same
+ * time. Once reached, further indications are freed after the callback so
+ * slow consumers cannot drain the MemManager pools used by the MAC. */
+#ifndef mwRxMaxHeldMsgs_c
+#define mwRxMaxHeldMsgs_c              2
+#endif
+
+/* Number of messages the mac task takes from each of the MLME and MCPS input
+ * queues on one wakeup before it goes back to wait for events. A value of 1
+ * gives one OS event round-trip per message. host/WakeupBench.c compares the
+ * wakeups per message of both. */
+#ifndef mwMaxMsgsPerWakeup_c
+#define mwMaxMsgsPerWakeup_c           8
+#endif
+
+/* Number of end devices a coordinator accepts (DeviceTable.c). They get the
+ * short addresses 0x0001 to mwMaxDevices_c. At most 1024. */
+#ifndef mwMaxDevices_c
+#define mwMaxDevices_c                 256
+#endif
+
+/* Slots of the extended address hash index of the device table. Power of
+ * two, at least twice mwMaxDevices_c. */
+#ifndef mwDeviceHashSize_c
+#define mwDeviceHashSize_c             512
+#endif
+
+/* Number of association responses a coordinator keeps waiting for their
+ * MLME-COMM-STATUS.indication at the same time. Each one holds an entry of the
+ * MAC indirect queue (12 entries, shared with the data for sleeping devices)
+ * until the device polls it. Associate indications received while the table is
+ * full are dropped and the devices try again. */
+#ifndef mwMaxPendingAssoc_c
+#define mwMaxPendingAssoc_c            8
+#endif
+
+/* Fast reconnect. The parameters of the last successful connection are saved
+ * in flash (NwkParams.c, needs gUseNwkParamsLink_d in the linker file) and
+ * mac_connect() for the same PAN first restarts the coordinator or associates
+ * to the saved coordinator directly, without scanning. If that fails it falls
+ * back to the scan. */
+#ifndef mwFastReconnect_d
+#define mwFastReconnect_d              1
+#endif
+
+/* Scan duration per channel (0-14) of mac_connect(). A channel takes
+ * 15.36 ms * (2^duration + 1) per scan, mac_connect_scan() takes its own. */
+#ifndef mwScanDuration_c
+#define mwScanDuration_c               5
+#endif
+
+/* Energy (ED scan units, 0-255) added to a channel for every other PAN heard
+ * on it during the active scan, when mac_connect_scan() selects the channel
+ * of a new PAN. A PAN is quiet now and then but will keep the channel busy. */
+#ifndef mwScanPanPenalty_c
+#define mwScanPanPenalty_c             32
+#endif
+
+/* Fragmentation (Fragment.c). mac_transmit_large() sends up to
+ * mwFragMaxLength_c bytes as a train of fragments, and the receiver gives them
+ * back reassembled in one MemManager buffer: PoolsDetails_c needs blocks of
+ * that size. Every data frame of the wrapper then starts with a dispatch
+ * byte, so both ends need the same setting. */
+#ifndef mwFragmentation_d
+#define mwFragmentation_d              0
+#endif
+
+/* Largest payload of mac_transmit_large(), at most 255 fragments */
+#ifndef mwFragMaxLength_c
+#define mwFragMaxLength_c              4096
+#endif
+
+/* Payload bytes per fragment, the same on both ends. The fragment header
+ * takes 6 more bytes of the MSDU, which is 116 bytes at most with short
+ * addresses and no security. */
+#ifndef mwFragPayloadLen_c
+#define mwFragPayloadLen_c             104
+#endif
+
+/* Fragments sent ahead of the first one not acknowledged, 1 to 32. The
+ * receiver is asked for an acknowledgement every half window, so the train
+ * keeps going while the acknowledgement comes back. */
+#ifndef mwFragWindow_c
+#define mwFragWindow_c                 16
+#endif
+
+/* Fragments of the transfer queued or in the MAC at a time, whatever the
+ * other normal priority requests queued. One more than the normal requests
+ * the MAC takes: the next fragment is already queued when the MAC confirms
+ * one, and the train does not fill the queue of the application. */
+#ifndef mwFragMaxQueuedTx_c
+#define mwFragMaxQueuedTx_c            (mwMaxInFlightNormalTx_c + 1)
+#endif
+
+/* Time [ms] to wait for an acknowledgement, and times it is asked again
+ * before the transfer fails. An answer normally comes back within a few
+ * frames, the timeout only matters when the request or the answer is lost. */
+#ifndef mwFragAckTimeout_c
+#define mwFragAckTimeout_c             50
+#endif
+
+#ifndef mwFragMaxRetries_c
+#define mwFragMaxRetries_c             10
+#endif
+
+/* Transfers reassembled at the same time, and time [ms] after the last
+ * fragment heard before an incomplete one is dropped */
+#ifndef mwFragMaxReassembly_c
+#define mwFragMaxReassembly_c          2
+#endif
+
+#ifndef mwFragReassemblyTimeout_c
+#define mwFragReassemblyTimeout_c      2000
+#endif
+
+/* Coalescing of small writes. mac_transmit_coalesced() packs the payloads
+ * for the same destination into one frame, sent when the next one does not
+ * fit in mwCoalesceMtu_c bytes or mwCoalesceFlushTime_c ms after the first
+ * one. The receiver gives them back one indication each. Every data frame of
+ * the wrapper then starts with a dispatch byte, so both ends need the same
+ * setting. */
+#ifndef mwCoalescing_d
+#define mwCoalescing_d                 0
+#endif
+
+/* Longest packed MSDU: 116 bytes with short addresses and no security */
+#ifndef mwCoalesceMtu_c
+#define mwCoalesceMtu_c                116
+#endif
+
+#ifndef mwCoalesceFlushTime_c
+#define mwCoalesceFlushTime_c          20
+#endif
+
+/* Destinations with a frame being packed at the same time. Each one holds a
+ * transmission slot until it is sent. */
+#ifndef mwCoalesceMaxDest_c
+#define mwCoalesceMaxDest_c            2
+#endif
+
+/* Neighbor link table (LinkTable.c), read with mac_get_link() and
+ * mac_get_links(): average LQI, transmit results and confirm latency of
+ * every neighbor, and when it was last heard. */
+#ifndef mwLinkTable_d
+#define mwLinkTable_d                  1
+#endif
+
+/* Neighbors recorded: the short addresses 0x0000 (the coordinator) to
+ * mwLinkTableSize_c - 1. The default covers every device of a coordinator,
+ * an end device only talks to its coordinator and can use 1. */
+#ifndef mwLinkTableSize_c
+#define mwLinkTableSize_c              (mwMaxDevices_c + 1)
+#endif
+
+/* Weight of a new sample in the link averages: 1/2^mwLinkEwmaShift_c */
+#ifndef mwLinkEwmaShift_c
+#define mwLinkEwmaShift_c              3
+#endif
+
+/* Receive duplicate filter (DupFilter.c). The copies of a frame the MAC
+ * indicates again after a lost acknowledgement are dropped before the event
+ * handler callback. */
+#ifndef mwDupFilter_d
+#define mwDupFilter_d                  1
+#endif
+
+/* Sources the filter remembers, 16 bytes each. Power of two, at least twice
+ * the number of nodes heard at the same time. */
+#ifndef mwDupFilterSize_c
+#define mwDupFilterSize_c              512
+#endif
+
+/* Time [ms] after which a frame with the DSN of the previous one of its
+ * source is no longer taken for a copy */
+#ifndef mwDupFilterAgeOut_c
+#define mwDupFilterAgeOut_c            1000
+#endif
+
+/* PANs served at the same time, each one by its own MAC instance and mac
+ * task. 2 runs a dual-PAN coordinator on one transceiver: the MPM switches the
+ * receiver between the two PANs (gMpmMaxPANs_c 2), and the MAC needs
+ * gMacInstancesCnt_c 2. The device and link tables are shared, so the
+ * devices of both PANs get distinct short addresses. Fast reconnect only
+ * saves the connection of the first instance. */
+#ifndef mwMaxInstances_c
+#define mwMaxInstances_c               1
+#endif
+
+/* Time [ms] the receiver stays on one PAN before switching to the other,
+ * when the two PANs are on different channels, set by mac_init() and changed
+ * with mac_set_dual_pan_dwell(). 0 keeps the MPM default (3.5 ms). The MAC
+ * retries a frame within a few ms, so a long dwell time loses frames on the
+ * PAN not listened to: 4 to 8 ms did best in the host dual-PAN test. */
+#ifndef mwDualPanDwellTime_c
+#define mwDualPanDwellTime_c           0
+#endif
+
+/* Transmit latency statistics (LatencyStats.c), read with mac_get_latency():
+ * every data request is stamped when it is queued, handed to the MAC and
+ * given back, and the time of each stage goes to a histogram. Build the PHY
+ * with gPhyTxTimestamps_d to split the time in the MAC from the time on air. */
+#ifndef mwLatencyStats_d
+#define mwLatencyStats_d               0
+#endif
+
+/* Histogram buckets of each stage, one per power of two microseconds: the
+ * last one of the default counts every time from 2^19 us (0.5 s) on */
+#ifndef mwLatencyBuckets_c
+#define mwLatencyBuckets_c             20
+#endif
+
+/* Wrapper statistics, read with mac_get_stats() */
+#ifndef mwStatistics_d
+#define mwStatistics_d                 0
+#endif
+
+/**********************************************************************************/
+
+
+
+#endif /* IEEE802P15P4_WRAPPER_IEEE802P15P4_WRAPPER_CFG_H_ */
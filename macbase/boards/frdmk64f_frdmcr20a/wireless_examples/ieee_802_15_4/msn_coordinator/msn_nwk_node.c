@@ -1,435 +1,645 @@
-/*!
-
- */
-
-/*! *********************************************************************************
- *************************************************************************************
- * Include
- *************************************************************************************
- ********************************************************************************** */
-#include "ieee802p15p4_wrapper.h"
-
-/* Drv */
-#include "LED.h"
-#include "Keyboard.h"
-
-/* Fwk */
-#include "SerialManager.h"
-#include "TimersManager.h"
-#include "FunctionLib.h"
-#include "MemManager.h"
-#include "SecLib.h"
-
-/* KSDK */
-#include "board.h"
-#include "fsl_os_abstraction.h"
-//#include "aes.h"
-#include "safesecure.h"
-
-/************************************************************************************
- *************************************************************************************
- * Private macros
- *************************************************************************************
- ************************************************************************************/
-enum
-{
-	stateInit,
-	waitConnectionResponse,
-	stateConnected
-};
-
-#define mDefaultValueOfDataLen_c               20
-#define gMessageMarkCR_c   0x0D
-
-/* Events */
-#define gAppEvtDummyEvent_c             (1 << 0)
-#define gAppEvtRxFromComm_c             (1 << 1)
-#define gAppEvtMacManagement_c			(1 << 2)
-#define gAppEvtMacData_c				(1 << 3)
-#define gAppEvtButton_c					(1 << 4)
-
-enum
-{
-  errorNoError,
-  errorWrongConfirm,
-  errorNotSuccessful,
-  errorNoMessage,
-  errorAllocFailed,
-  errorInvalidParameter,
-  errorNoScanResults
-};
-/************************************************************************************
- *************************************************************************************
- * Private prototypes
- *************************************************************************************
- ************************************************************************************/
-static void    App_CommRxCallBack(void*);
-static void    App_HandleKeys(key_event_t events);
-
-void App_init( void );
-void AppThread (uint32_t argument);
-
-/************************************************************************************
- *************************************************************************************
- * Private memory declarations
- *************************************************************************************
- ************************************************************************************/
-
-static uint16_t mShortAddress = 0xFFFF;
-static uint16_t mPanId = 0xFFFF;
-static uint16_t mDestinationAddress = 0xFFFF;
-static uint8_t  mChannel = 0xFF;
-static osaEventId_t mAppEvent;
-static bool_t node_connected = FALSE;
-static bool_t node_is_coordinator = FALSE;
-static uint8_t mInterfaceId;
-
-/* The current state of the applications state machine */
-static uint8_t gState;
-
-static int mlme_event = 0;
-static int mcps_event = 0;
-
-static char received_data[128] = {0};
-static uint16_t received_data_src = 0xFFFF;
-static uint8_t received_data_len = 0;
-static uint8_t button_event = 0;
-
-uint8_t mac_address[8] = {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01};
-
-static uint8_t maCommDataBuffer[64] = {0};
-
-/************************************************************************************
- *************************************************************************************
- * Public functions
- *************************************************************************************
- ************************************************************************************/
-
-/*! *********************************************************************************
- * \brief  This is the first task created by the OS. This task will initialize
- *         the system
- *
- * \param[in]  argument
- *
- * \return  None.
- *
- * \pre
- *
- * \post
- *
- * \remarks
- *
- ********************************************************************************** */
-void main_task(uint32_t param)
-{
-	static uint8_t initialized = FALSE;
-
-	if( !initialized )
-	{
-		initialized = TRUE;
-		hardware_init();
-
-		MEM_Init();
-		TMR_Init();
-		LED_Init();
-		SecLib_Init();
-		SerialManager_Init();
-		SafeSecure_Init(mac_transmit, (ptrFnc_Receive)0, 118); // TODO: Modificar tamao mximo
-		App_init();
-	}
-
-	/* Call application task */
-	AppThread( param );
-}
-
-/*****************************************************************************
- * Initialization function for the App Task. This is called during
- * initialization and should contain any application specific initialization
- * (ie. hardware initialization/setup, table initialization, power up
- * notification.
- *
- * Interface assumptions: None
- *
- * Return value: None
- *
- *****************************************************************************/
-void App_init(void)
-{
-
-	mAppEvent = OSA_EventCreate(TRUE);
-	/* The initial application state */
-	gState = stateInit;
-
-	/* Register keyboard callback function */
-	KBD_Init(App_HandleKeys);
-
-	/* Initialize the serial terminal interface so that we can print out status messages */
-	Serial_InitInterface(&mInterfaceId, APP_SERIAL_INTERFACE_TYPE, APP_SERIAL_INTERFACE_INSTANCE);
-	Serial_SetBaudRate(mInterfaceId, gUARTBaudRate57600_c);
-	Serial_SetRxCallBack(mInterfaceId, App_CommRxCallBack, NULL);
-
-	/*signal app ready*/
-	LED_StartSerialFlash(LED1);
-
-	Serial_Print(mInterfaceId,"\n\rPress SW2 on the CR20 board to change the MAC address, SW1 to start the node initialization and connection\n\r", gAllowToBlock_d);
-}
-
-/*****************************************************************************
- * Handler for events from the MAC wrapper -- THIS IS A CALLBACK FUNCTION --
- *****************************************************************************/
-void mac_events_handler(void* evt_par)
-{
-	mac_event_data_t* mac_evt_data = (mac_event_data_t* ) evt_par;
-
-	switch(mac_evt_data->mac_event_type) {
-	case mac_management_event_c:
-		switch(mac_evt_data->evt_data.management_event_data->msgType){
-		case gMlmeAssociateCnf_c:
-			/* Network found, started as End Device */
-			mShortAddress = mac_evt_data->evt_data.management_event_data->msgData.associateCnf.assocShortAddress;
-			node_connected = TRUE;
-			break;
-		case gMlmeStartCnf_c:
-			/* No network found started a new network as Coordinator */
-			mShortAddress = 0;
-			node_connected = TRUE;
-			node_is_coordinator = TRUE;
-			break;
-		default:
-			mlme_event = mac_evt_data->evt_data.management_event_data->msgType;
-			break;
-		}
-		OSA_EventSet(mAppEvent, gAppEvtMacManagement_c);
-		break;
-	case mac_data_event_c:
-		switch(mac_evt_data->evt_data.data_event_data->msgType){
-		case gMcpsDataInd_c:
-			FLib_MemSet(received_data, 0, sizeof(received_data));
-			FLib_MemCpy( received_data, mac_evt_data->evt_data.data_event_data->msgData.dataInd.pMsdu, mac_evt_data->evt_data.data_event_data->msgData.dataInd.msduLength);
-			received_data_len =  mac_evt_data->evt_data.data_event_data->msgData.dataInd.msduLength;
-			FLib_MemCpy(&received_data_src, &(mac_evt_data->evt_data.data_event_data->msgData.dataInd.srcAddr), 2);
-			break;
-		default:
-			received_data_len = 0;
-			received_data_src = 0xFFFF;
-			mcps_event = mac_evt_data->evt_data.data_event_data->msgType;
-			break;
-		}
-		OSA_EventSet(mAppEvent, gAppEvtMacData_c);
-		break;
-
-	default:
-		break;
-	}
-}
-
-/*****************************************************************************
- * The AppTask(event_t events) function is the applicantion main loop and
- * will process any incoming event. Events include timers, messages and any
- * other user defined events.
- *
- * Interface assumptions:
- *     None
- *
- * Return value:
- *     None
- *****************************************************************************/
-void AppThread(uint32_t argument)
-{ 
-	osaEventFlags_t ev;
-	/* Stores the error/success code returned by some functions. */
-    static uint8_t mCounter = 0;
-
-	while(1)
-	{
-		OSA_EventWait(mAppEvent, osaEventFlagsAll_c, FALSE, osaWaitForever_c, &ev);
-
-		switch(gState)
-		{
-		case stateInit:
-			if(ev & gAppEvtButton_c){
-				if(button_event == gKBD_EventSW3_c) {
-					Serial_Print(mInterfaceId,"MAC address: ", gAllowToBlock_d);
-					for(int i = 0; i<8; i++) {
-						mac_address[i]++;
-						Serial_PrintHex(mInterfaceId,(uint8_t*)&mac_address[i], 1, 0);
-					}
-					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
-				}
-				if(button_event == gKBD_EventSW4_c) {
-					/*Initialize the MAC Wrapper*/
-					LED_StopFlashingAllLeds();
-					Serial_Print(mInterfaceId,"Initializing MAC.\n\r", gAllowToBlock_d);
-					mac_init(mac_address);
-					Serial_Print(mInterfaceId,"Node is initialized and ready.\n\r", gAllowToBlock_d);
-					/* Goto Energy Detection state. */
-					mPanId = 0xC0C0;
-					mChannel = gLogicalChannel11_c;
-					Serial_Print(mInterfaceId,"Starting connection, this can take several seconds.\n\r", gAllowToBlock_d);
-					mac_connect(mChannel, mPanId, mac_events_handler);
-					gState = waitConnectionResponse;
-				}
-			}
-
-
-			break;
-
-		case waitConnectionResponse:
-			/* Handle connection response */
-			if(node_connected){
-				Serial_Print(mInterfaceId," Node Connected as ", gAllowToBlock_d);
-				if(node_is_coordinator){
-					Serial_Print(mInterfaceId,"Coordinator with short address: ", gAllowToBlock_d);
-				}
-				else {
-					Serial_Print(mInterfaceId,"End device with short address: ", gAllowToBlock_d);
-				}
-				Serial_PrintHex(mInterfaceId,(uint8_t*)&mShortAddress, 2, 0);
-				Serial_Print(mInterfaceId," Pan Id: ", gAllowToBlock_d);
-				Serial_PrintHex(mInterfaceId,(uint8_t*)&mPanId, 2, 0);
-				Serial_Print(mInterfaceId," Channel: ", gAllowToBlock_d);
-				Serial_PrintHex(mInterfaceId,(uint8_t*)&mChannel, 1, 0);
-				Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
-
-				gState = stateConnected;
-				OSA_EventSet(mAppEvent, gAppEvtDummyEvent_c);
-			}
-
-			break;
-
-		case stateConnected:
-
-			/* Handle events from the UART */
-			if (ev & gAppEvtRxFromComm_c)
-			{
-				uint16_t count;
-				unsigned char received_byte = 0;
-				(void)Serial_GetByteFromRxBuffer(mInterfaceId, &received_byte, &count);
-				if((received_byte >= ' ') && (received_byte <= '~')) {
-					maCommDataBuffer[mCounter++] = received_byte;
-				}
-				if(mCounter == 16)
-				{
-					/* Information ready to transmit, initializes encryption */
-					SafeSecure_Transmit(mDestinationAddress, maCommDataBuffer, mCounter);
-					//Serial_PrintHex(mInterfaceId,maCommDataBuffer,mCounter , 0);
-					mCounter = 0;
-				}
-			}
-#if 0
-				if((mCounter >= 64) || (received_byte == '\r')){
-					mac_transmit(mDestinationAddress, maCommDataBuffer, mCounter);
-					FLib_MemSet(maCommDataBuffer, 0, 64);
-					mCounter = 0;
-				}
-			}
-#endif
-			/* Handle MAC management events */
-			if(ev & gAppEvtMacManagement_c){
-				Serial_Print(mInterfaceId,"Network management event: ", gAllowToBlock_d);
-				Serial_PrintHex(mInterfaceId,(uint8_t*)&mlme_event, 4, 0);
-				Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
-			}
-
-
-			/* Handle MAC data events */
-			if(ev & gAppEvtMacData_c){
-				if(received_data_len){
-					Serial_Print(mInterfaceId,"Message from ", gAllowToBlock_d);
-					Serial_PrintHex(mInterfaceId,(uint8_t*)&received_data_src, 2, 0);
-					Serial_Print(mInterfaceId," : ", gAllowToBlock_d);
-					SafeSecure_Decrypt(received_data, received_data_len);
-					Serial_Print(mInterfaceId, received_data, gAllowToBlock_d);
-					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
-				}
-				else {
-					Serial_Print(mInterfaceId,"Network data event: ", gAllowToBlock_d);
-					Serial_PrintHex(mInterfaceId,(uint8_t*)&mcps_event, 4, 0);
-					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
-				}
-
-			}
-
-			/* Handle button events */
-			if(ev & gAppEvtButton_c){
-				if(button_event == gKBD_EventSW3_c) {
-					Serial_Print(mInterfaceId,"Destination address: ", gAllowToBlock_d);
-					mDestinationAddress++;
-					Serial_PrintHex(mInterfaceId,(uint8_t*)&mDestinationAddress, 2, 0);
-					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
-				}
-				if(button_event == gKBD_EventSW4_c) {
-					Serial_Print(mInterfaceId,"Destination address: ", gAllowToBlock_d);
-					mDestinationAddress--;
-					Serial_PrintHex(mInterfaceId,(uint8_t*)&mDestinationAddress, 2, 0);
-					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
-				}
-			}
-			break;
-		} /* end switch*/
-
-	}
-}
-
-/************************************************************************************
- *************************************************************************************
- * Private functions
- *************************************************************************************
- ************************************************************************************/
-
-/*****************************************************************************
- * App_CommRxCallBack
- *
- * This callback is triggered when a new byte is received over the serial terminal interface
- *
- *****************************************************************************/
-static void App_CommRxCallBack(void *pData) 
-{
-	uint8_t pressedKey;
-	uint16_t count;
-
-	(void)pData;
-	if(stateConnected == gState)
-	{
-		OSA_EventSet(mAppEvent, gAppEvtRxFromComm_c);
-	}
-	else
-	{
-		do{
-			(void)Serial_GetByteFromRxBuffer(mInterfaceId, &pressedKey, &count);
-		}while(count);
-	}
-}
-
-
-/*****************************************************************************
- * The App_HandleKeys(key_event_t events) function can handle different
- * key events. It waits for user to push a button in order to start
- * the application.
- *
- * Interface assumptions:
- *     None
- *
- * Return value:
- *     None
- *****************************************************************************/
-static void App_HandleKeys( key_event_t events )
-{
-	button_event = events;
-	OSA_EventSet(mAppEvent, gAppEvtButton_c);
-	switch ( button_event )
-	{
-	case gKBD_EventSW1_c:
-	case gKBD_EventSW2_c:
-	case gKBD_EventSW3_c:
-	case gKBD_EventSW4_c:
-	case gKBD_EventLongSW1_c:
-	case gKBD_EventLongSW2_c:
-	case gKBD_EventLongSW3_c:
-	case gKBD_EventLongSW4_c:
-	default:
-		break;
-	}
-}
-
-
+/*!
+
+ */
+
+/*! *********************************************************************************
+ *************************************************************************************
+ * Include
+ *************************************************************************************
+ ********************************************************************************** */
+#include "ieee802p15p4_wrapper.h"
+
+/* Drv */
+#include "LED.h"
+#include "Keyboard.h"
+
+/* Fwk */
+#include "SerialManager.h"
+#include "TimersManager.h"
+#include "FunctionLib.h"
+#include "MemManager.h"
+#include "SecLib.h"
+#include "RNG_Interface.h"
+
+/* KSDK */
+#include "board.h"
+#include "fsl_os_abstraction.h"
+//#include "aes.h"
+#include "safesecure.h"
+
+/************************************************************************************
+ *************************************************************************************
+ * Private macros
+ *************************************************************************************
+ ************************************************************************************/
+enum
+{
+	stateInit,
+	waitConnectionResponse,
+	stateConnected
+};
+
+#define mDefaultValueOfDataLen_c               20
+#define gMessageMarkCR_c   0x0D
+
+/* Characters typed per line sent */
+#define mAppLineLen_c                          16
+
+/* Lines sent with the authenticated mode of SafeSecure (AES-CCM over the
+ * whole line and a MIC) instead of the first block encrypted and a CRC. The
+ * frames are not the same over the air: both ends need the same setting, so
+ * it is off unless every node of the network is built with it. */
+#ifndef mAppSafeSecureCcm_d
+#define mAppSafeSecureCcm_d 0
+#endif
+
+/* Frame of a line: the line and the overhead of SafeSecure, frame counter and
+ * MIC or CRC (a line is one AES block, not padded) */
+#if mAppSafeSecureCcm_d
+#define mAppSecureFrameLen_c   (mAppLineLen_c + SAFESECURE_CCM_OVERHEAD)
+#else
+#define mAppSecureFrameLen_c   (mAppLineLen_c + SAFESECURE_CRC_LEN)
+#endif
+
+/* A frame goes out whole: in one packed write, or in one MSDU after the
+ * dispatch byte the wrapper may add */
+#if mwCoalescing_d && (mAppSecureFrameLen_c > mwCoalesceMtu_c - 2)
+#error "mAppSecureFrameLen_c does not fit in a coalesced write"
+#elif mAppSecureFrameLen_c > mwMaxPayload_c - 1
+#error "mAppSecureFrameLen_c does not fit in a frame"
+#endif
+
+/* Events */
+#define gAppEvtDummyEvent_c             (1 << 0)
+#define gAppEvtRxFromComm_c             (1 << 1)
+#define gAppEvtMacManagement_c			(1 << 2)
+#define gAppEvtMacData_c				(1 << 3)
+#define gAppEvtButton_c					(1 << 4)
+
+enum
+{
+  errorNoError,
+  errorWrongConfirm,
+  errorNotSuccessful,
+  errorNoMessage,
+  errorAllocFailed,
+  errorInvalidParameter,
+  errorNoScanResults
+};
+/************************************************************************************
+ *************************************************************************************
+ * Private prototypes
+ *************************************************************************************
+ ************************************************************************************/
+static void    App_CommRxCallBack(void*);
+static void    App_HandleKeys(key_event_t events);
+#if mwLatencyStats_d
+static void    App_DumpLatency(void);
+#endif
+#if gTraceEnabled_d
+static void    App_DumpTrace(void);
+static void    App_TraceWrite(const uint8_t* pData, uint32_t length);
+#endif
+
+void App_init( void );
+void AppThread (uint32_t argument);
+
+/************************************************************************************
+ *************************************************************************************
+ * Private memory declarations
+ *************************************************************************************
+ ************************************************************************************/
+
+static uint16_t mShortAddress = 0xFFFF;
+static uint16_t mPanId = 0xFFFF;
+static uint16_t mDestinationAddress = 0xFFFF;
+static uint8_t  mChannel = 0xFF;
+static osaEventId_t mAppEvent;
+static bool_t node_connected = FALSE;
+static bool_t node_is_coordinator = FALSE;
+static uint8_t mInterfaceId;
+
+/* The current state of the applications state machine */
+static uint8_t gState;
+
+static int mlme_event = 0;
+static int mcps_event = 0;
+
+static char received_data[128] = {0};
+static uint16_t received_data_src = 0xFFFF;
+static uint8_t received_data_len = 0;
+#if mwRxZeroCopy_d
+/* Data indication kept from the MAC wrapper, released once it is printed.
+ * Handed over between the two tasks without a lock: the mac task only sets it
+ * while it is NULL, and AppThread only clears it after mac_rx_release(). An
+ * indication that finds it set is copied to received_data instead. */
+static mcpsToNwkMessage_t* volatile received_msg = NULL;
+#endif
+static uint8_t button_event = 0;
+
+uint8_t mac_address[8] = {0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x01};
+
+static uint8_t maCommDataBuffer[64] = {0};
+
+/* Frame SafeSecure builds a line into, sent from there */
+static uint8_t maSecureFrameBuffer[mAppSecureFrameLen_c];
+
+/************************************************************************************
+ *************************************************************************************
+ * Public functions
+ *************************************************************************************
+ ************************************************************************************/
+
+/*! *********************************************************************************
+ * \brief  This is the first task created by the OS. This task will initialize
+ *         the system
+ *
+ * \param[in]  argument
+ *
+ * \return  None.
+ *
+ * \pre
+ *
+ * \post
+ *
+ * \remarks
+ *
+ ********************************************************************************** */
+void main_task(uint32_t param)
+{
+	static uint8_t initialized = FALSE;
+
+	if( !initialized )
+	{
+		initialized = TRUE;
+		hardware_init();
+
+		MEM_Init();
+		TMR_Init();
+		LED_Init();
+		SecLib_Init();
+		SerialManager_Init();
+#if mwCoalescing_d
+		/* The 16 character lines go out several to a frame */
+		SafeSecure_Init(mac_transmit_coalesced, (ptrFnc_Receive)0, sizeof(maSecureFrameBuffer), maSecureFrameBuffer);
+#else
+		SafeSecure_Init(mac_transmit, (ptrFnc_Receive)0, sizeof(maSecureFrameBuffer), maSecureFrameBuffer);
+#endif
+		App_init();
+	}
+
+	/* Call application task */
+	AppThread( param );
+}
+
+/*****************************************************************************
+ * Initialization function for the App Task. This is called during
+ * initialization and should contain any application specific initialization
+ * (ie. hardware initialization/setup, table initialization, power up
+ * notification.
+ *
+ * Interface assumptions: None
+ *
+ * Return value: None
+ *
+ *****************************************************************************/
+void App_init(void)
+{
+
+	mAppEvent = OSA_EventCreate(TRUE);
+	/* The initial application state */
+	gState = stateInit;
+
+	/* Register keyboard callback function */
+	KBD_Init(App_HandleKeys);
+
+	/* Initialize the serial terminal interface so that we can print out status messages */
+	Serial_InitInterface(&mInterfaceId, APP_SERIAL_INTERFACE_TYPE, APP_SERIAL_INTERFACE_INSTANCE);
+	Serial_SetBaudRate(mInterfaceId, gUARTBaudRate57600_c);
+	Serial_SetRxCallBack(mInterfaceId, App_CommRxCallBack, NULL);
+
+	/*signal app ready*/
+	LED_StartSerialFlash(LED1);
+
+	Serial_Print(mInterfaceId,"\n\rPress SW2 on the CR20 board to change the MAC address, SW1 to start the node initialization and connection\n\r", gAllowToBlock_d);
+}
+
+/*****************************************************************************
+ * Handler for events from the MAC wrapper -- THIS IS A CALLBACK FUNCTION --
+ *****************************************************************************/
+void mac_events_handler(void* evt_par)
+{
+	mac_event_data_t* mac_evt_data = (mac_event_data_t* ) evt_par;
+
+	switch(mac_evt_data->mac_event_type) {
+	case mac_management_event_c:
+		switch(mac_evt_data->evt_data.management_event_data->msgType){
+		case gMlmeAssociateCnf_c:
+			/* Network found, started as End Device */
+			mShortAddress = mac_evt_data->evt_data.management_event_data->msgData.associateCnf.assocShortAddress;
+			node_connected = TRUE;
+			break;
+		case gMlmeStartCnf_c:
+			/* No network found started a new network as Coordinator */
+			mShortAddress = 0;
+			node_connected = TRUE;
+			node_is_coordinator = TRUE;
+			break;
+		default:
+			mlme_event = mac_evt_data->evt_data.management_event_data->msgType;
+			break;
+		}
+		OSA_EventSet(mAppEvent, gAppEvtMacManagement_c);
+		break;
+	case mac_data_event_c:
+		switch(mac_evt_data->evt_data.data_event_data->msgType){
+		case gMcpsDataInd_c:
+#if mwRxZeroCopy_d
+			if(mac_evt_data->can_retain && (received_msg == NULL)) {
+				/* Keep the indication and use the payload in place */
+				received_msg = mac_evt_data->evt_data.data_event_data;
+				mac_evt_data->retained = TRUE;
+				break;
+			}
+#endif
+			FLib_MemSet(received_data, 0, sizeof(received_data));
+			FLib_MemCpy( received_data, mac_evt_data->evt_data.data_event_data->msgData.dataInd.pMsdu, mac_evt_data->evt_data.data_event_data->msgData.dataInd.msduLength);
+			received_data_len =  mac_evt_data->evt_data.data_event_data->msgData.dataInd.msduLength;
+			FLib_MemCpy(&received_data_src, &(mac_evt_data->evt_data.data_event_data->msgData.dataInd.srcAddr), 2);
+			break;
+		default:
+			received_data_len = 0;
+			received_data_src = 0xFFFF;
+			mcps_event = mac_evt_data->evt_data.data_event_data->msgType;
+			break;
+		}
+		OSA_EventSet(mAppEvent, gAppEvtMacData_c);
+		break;
+
+	default:
+		break;
+	}
+}
+
+/*****************************************************************************
+ * The AppTask(event_t events) function is the applicantion main loop and
+ * will process any incoming event. Events include timers, messages and any
+ * other user defined events.
+ *
+ * Interface assumptions:
+ *     None
+ *
+ * Return value:
+ *     None
+ *****************************************************************************/
+void AppThread(uint32_t argument)
+{ 
+	osaEventFlags_t ev;
+	/* Stores the error/success code returned by some functions. */
+    static uint8_t mCounter = 0;
+
+	while(1)
+	{
+		OSA_EventWait(mAppEvent, osaEventFlagsAll_c, FALSE, osaWaitForever_c, &ev);
+
+		switch(gState)
+		{
+		case stateInit:
+			if(ev & gAppEvtButton_c){
+				if(button_event == gKBD_EventSW3_c) {
+					Serial_Print(mInterfaceId,"MAC address: ", gAllowToBlock_d);
+					for(int i = 0; i<8; i++) {
+						mac_address[i]++;
+						Serial_PrintHex(mInterfaceId,(uint8_t*)&mac_address[i], 1, 0);
+					}
+					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
+				}
+				if(button_event == gKBD_EventSW4_c) {
+					/*Initialize the MAC Wrapper*/
+					LED_StopFlashingAllLeds();
+					Serial_Print(mInterfaceId,"Initializing MAC.\n\r", gAllowToBlock_d);
+					mac_init(mac_address);
+					Serial_Print(mInterfaceId,"Node is initialized and ready.\n\r", gAllowToBlock_d);
+					/* Goto Energy Detection state. */
+					mPanId = 0xC0C0;
+					mChannel = gLogicalChannel11_c;
+					Serial_Print(mInterfaceId,"Starting connection, this can take several seconds.\n\r", gAllowToBlock_d);
+					mac_connect(mChannel, mPanId, mac_events_handler);
+					gState = waitConnectionResponse;
+				}
+			}
+
+
+			break;
+
+		case waitConnectionResponse:
+			/* Handle connection response */
+			if(node_connected){
+				Serial_Print(mInterfaceId," Node Connected as ", gAllowToBlock_d);
+				if(node_is_coordinator){
+					Serial_Print(mInterfaceId,"Coordinator with short address: ", gAllowToBlock_d);
+				}
+				else {
+					Serial_Print(mInterfaceId,"End device with short address: ", gAllowToBlock_d);
+				}
+				Serial_PrintHex(mInterfaceId,(uint8_t*)&mShortAddress, 2, 0);
+				Serial_Print(mInterfaceId," Pan Id: ", gAllowToBlock_d);
+				Serial_PrintHex(mInterfaceId,(uint8_t*)&mPanId, 2, 0);
+				Serial_Print(mInterfaceId," Channel: ", gAllowToBlock_d);
+				Serial_PrintHex(mInterfaceId,(uint8_t*)&mChannel, 1, 0);
+				Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
+#if mAppSafeSecureCcm_d
+				{
+					/* The frame counter starts at random, so the nonces of
+					 * the frames sent before a reset are not used again */
+					uint32_t frameCounter;
+
+					RNG_GetRandomNo(&frameCounter);
+					SafeSecure_SetSource(mShortAddress, frameCounter);
+				}
+#endif
+
+				gState = stateConnected;
+				OSA_EventSet(mAppEvent, gAppEvtDummyEvent_c);
+			}
+
+			break;
+
+		case stateConnected:
+
+			/* Handle events from the UART */
+			if (ev & gAppEvtRxFromComm_c)
+			{
+				uint16_t count;
+				unsigned char received_byte = 0;
+				(void)Serial_GetByteFromRxBuffer(mInterfaceId, &received_byte, &count);
+				if((received_byte >= ' ') && (received_byte <= '~')) {
+					maCommDataBuffer[mCounter++] = received_byte;
+				}
+				if(mCounter == mAppLineLen_c)
+				{
+					/* Information ready to transmit, initializes encryption */
+#if mAppSafeSecureCcm_d
+					SafeSecure_TransmitCcm(mDestinationAddress, maCommDataBuffer, mCounter);
+#else
+					SafeSecure_Transmit(mDestinationAddress, maCommDataBuffer, mCounter);
+#endif
+					//Serial_PrintHex(mInterfaceId,maCommDataBuffer,mCounter , 0);
+					mCounter = 0;
+				}
+			}
+#if 0
+				if((mCounter >= 64) || (received_byte == '\r')){
+					mac_transmit(mDestinationAddress, maCommDataBuffer, mCounter);
+					FLib_MemSet(maCommDataBuffer, 0, 64);
+					mCounter = 0;
+				}
+			}
+#endif
+			/* Handle MAC management events */
+			if(ev & gAppEvtMacManagement_c){
+				Serial_Print(mInterfaceId,"Network management event: ", gAllowToBlock_d);
+				Serial_PrintHex(mInterfaceId,(uint8_t*)&mlme_event, 4, 0);
+				Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
+			}
+
+
+			/* Handle MAC data events */
+			if(ev & gAppEvtMacData_c){
+#if mwRxZeroCopy_d
+				if(received_msg != NULL){
+					mcpsDataInd_t* pDataInd = &received_msg->msgData.dataInd;
+
+					Serial_Print(mInterfaceId,"Message from ", gAllowToBlock_d);
+					Serial_PrintHex(mInterfaceId,(uint8_t*)&pDataInd->srcAddr, 2, 0);
+					Serial_Print(mInterfaceId," : ", gAllowToBlock_d);
+#if mAppSafeSecureCcm_d
+					if(SafeSecureReceiveMsg_Success == SafeSecure_DecryptCcm((uint16_t)pDataInd->srcAddr, pDataInd->pMsdu, pDataInd->msduLength)){
+						Serial_SyncWrite(mInterfaceId, &pDataInd->pMsdu[SAFESECURE_CCM_HEADER_LEN], pDataInd->msduLength - SAFESECURE_CCM_OVERHEAD);
+					}
+					else {
+						Serial_Print(mInterfaceId,"(not authenticated)", gAllowToBlock_d);
+					}
+#else
+					if(SafeSecureReceiveMsg_Success == SafeSecure_Decrypt(pDataInd->pMsdu, pDataInd->msduLength)){
+						Serial_SyncWrite(mInterfaceId, pDataInd->pMsdu, pDataInd->msduLength - SAFESECURE_CRC_LEN);
+					}
+					else {
+						Serial_Print(mInterfaceId,"(corrupt data)", gAllowToBlock_d);
+					}
+#endif
+					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
+					mac_rx_release(received_msg);
+					received_msg = NULL;
+				}
+				else
+#endif
+				if(received_data_len){
+					Serial_Print(mInterfaceId,"Message from ", gAllowToBlock_d);
+					Serial_PrintHex(mInterfaceId,(uint8_t*)&received_data_src, 2, 0);
+					Serial_Print(mInterfaceId," : ", gAllowToBlock_d);
+#if mAppSafeSecureCcm_d
+					if(SafeSecureReceiveMsg_Success == SafeSecure_DecryptCcm(received_data_src, (uint8_t*)received_data, received_data_len)){
+						Serial_SyncWrite(mInterfaceId, (uint8_t*)&received_data[SAFESECURE_CCM_HEADER_LEN], received_data_len - SAFESECURE_CCM_OVERHEAD);
+					}
+					else {
+						Serial_Print(mInterfaceId,"(not authenticated)", gAllowToBlock_d);
+					}
+#else
+					if(SafeSecureReceiveMsg_Success == SafeSecure_Decrypt((uint8_t*)received_data, received_data_len)){
+						Serial_SyncWrite(mInterfaceId, (uint8_t*)received_data, received_data_len - SAFESECURE_CRC_LEN);
+					}
+					else {
+						Serial_Print(mInterfaceId,"(corrupt data)", gAllowToBlock_d);
+					}
+#endif
+					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
+				}
+				else {
+					Serial_Print(mInterfaceId,"Network data event: ", gAllowToBlock_d);
+					Serial_PrintHex(mInterfaceId,(uint8_t*)&mcps_event, 4, 0);
+					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
+				}
+
+			}
+
+			/* Handle button events */
+			if(ev & gAppEvtButton_c){
+				if(button_event == gKBD_EventSW3_c) {
+					Serial_Print(mInterfaceId,"Destination address: ", gAllowToBlock_d);
+					mDestinationAddress++;
+					Serial_PrintHex(mInterfaceId,(uint8_t*)&mDestinationAddress, 2, 0);
+					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
+				}
+				if(button_event == gKBD_EventSW4_c) {
+					Serial_Print(mInterfaceId,"Destination address: ", gAllowToBlock_d);
+					mDestinationAddress--;
+					Serial_PrintHex(mInterfaceId,(uint8_t*)&mDestinationAddress, 2, 0);
+					Serial_Print(mInterfaceId,"\r\n", gAllowToBlock_d);
+				}
+#if mwLatencyStats_d
+				/* Once connected, SW1 prints the transmit latency */
+				if(button_event == gKBD_EventSW1_c) {
+					App_DumpLatency();
+				}
+#endif
+#if gTraceEnabled_d
+				/* Once connected, a long press on SW1 dumps the event trace */
+				if(button_event == gKBD_EventLongSW1_c) {
+					App_DumpTrace();
+				}
+#endif
+			}
+			break;
+		} /* end switch*/
+
+	}
+}
+
+/************************************************************************************
+ *************************************************************************************
+ * Private functions
+ *************************************************************************************
+ ************************************************************************************/
+
+/*****************************************************************************
+ * App_CommRxCallBack
+ *
+ * This callback is triggered when a new byte is received over the serial terminal interface
+ *
+ *****************************************************************************/
+static void App_CommRxCallBack(void *pData) 
+{
+	uint8_t pressedKey;
+	uint16_t count;
+
+	(void)pData;
+	if(stateConnected == gState)
+	{
+		OSA_EventSet(mAppEvent, gAppEvtRxFromComm_c);
+	}
+	else
+	{
+		do{
+			(void)Serial_GetByteFromRxBuffer(mInterfaceId, &pressedKey, &count);
+		}while(count);
+	}
+}
+
+
+#if mwLatencyStats_d
+/*****************************************************************************
+ * App_DumpLatency
+ *
+ * Prints the latency of each stage of the data requests sent since the last
+ * dump [us]: count, min/avg/max and the histogram buckets that are not empty,
+ * each one starting at 2^n us. The stages are cleared.
+ *
+ *****************************************************************************/
+static void App_DumpLatency(void)
+{
+	static char * const stageNames[mac_latency_stages_c] =
+	{
+		"queue   ", "mac     ", "phy     ", "confirm ", "delivery", "total   "
+	};
+	mac_latency_stats_t stats;
+	uint8_t stage;
+	uint8_t bucket;
+
+	Serial_Print(mInterfaceId, "\n\rTX latency [us]: count min/avg/max, histogram from:count\n\r", gAllowToBlock_d);
+	for(stage = 0; stage < mac_latency_stages_c; stage++)
+	{
+		if(mac_get_latency((mac_latency_stage_t)stage, &stats, TRUE) != mwErrorNoError)
+		{
+			continue;
+		}
+		Serial_Print(mInterfaceId, stageNames[stage], gAllowToBlock_d);
+		Serial_Print(mInterfaceId, " ", gAllowToBlock_d);
+		Serial_PrintDec(mInterfaceId, stats.count);
+		Serial_Print(mInterfaceId, " ", gAllowToBlock_d);
+		Serial_PrintDec(mInterfaceId, stats.min_us);
+		Serial_Print(mInterfaceId, "/", gAllowToBlock_d);
+		Serial_PrintDec(mInterfaceId, stats.avg_us);
+		Serial_Print(mInterfaceId, "/", gAllowToBlock_d);
+		Serial_PrintDec(mInterfaceId, stats.max_us);
+		for(bucket = 0; bucket < mwLatencyBuckets_c; bucket++)
+		{
+			if(stats.buckets[bucket])
+			{
+				Serial_Print(mInterfaceId, " ", gAllowToBlock_d);
+				Serial_PrintDec(mInterfaceId, bucket ? (1UL << bucket) : 0);
+				Serial_Print(mInterfaceId, ":", gAllowToBlock_d);
+				Serial_PrintDec(mInterfaceId, stats.buckets[bucket]);
+			}
+		}
+		Serial_Print(mInterfaceId, "\n\r", gAllowToBlock_d);
+	}
+}
+#endif
+
+#if gTraceEnabled_d
+/*****************************************************************************
+ * App_DumpTrace
+ *
+ * Prints the event trace in hexadecimal, 16 bytes (one record) per line,
+ * between two marker lines. TraceDecode turns the log into a timeline.
+ *
+ *****************************************************************************/
+static void App_DumpTrace(void)
+{
+	Serial_Print(mInterfaceId, "\n\rTRACE BEGIN\n\r", gAllowToBlock_d);
+	(void)Trace_Dump(App_TraceWrite);
+	Serial_Print(mInterfaceId, "TRACE END\n\r", gAllowToBlock_d);
+}
+
+/*****************************************************************************
+ * App_TraceWrite
+ *
+ * Output of Trace_Dump(): the bytes in memory order, one line per 16 bytes.
+ *
+ *****************************************************************************/
+static void App_TraceWrite(const uint8_t* pData, uint32_t length)
+{
+	uint8_t chunk;
+
+	while(length)
+	{
+		chunk = (length > 16) ? 16 : (uint8_t)length;
+		Serial_PrintHex(mInterfaceId, (uint8_t*)pData, chunk, gPrtHexBigEndian_c | gPrtHexNewLine_c);
+		pData += chunk;
+		length -= chunk;
+	}
+}
+#endif
+
+/*****************************************************************************
+ * The App_HandleKeys(key_event_t events) function can handle different
+ * key events. It waits for user to push a button in order to start
+ * the application.
+ *
+ * Interface assumptions:
+ *     None
+ *
+ * Return value:
+ *     None
+ *****************************************************************************/
+static void App_HandleKeys( key_event_t events )
+{
+	button_event = events;
+	OSA_EventSet(mAppEvent, gAppEvtButton_c);
+	switch ( button_event )
+	{
+	case gKBD_EventSW1_c:
+	case gKBD_EventSW2_c:
+	case gKBD_EventSW3_c:
+	case gKBD_EventSW4_c:
+	case gKBD_EventLongSW1_c:
+	case gKBD_EventLongSW2_c:
+	case gKBD_EventLongSW3_c:
+	case gKBD_EventLongSW4_c:
+	default:
+		break;
+	}
+}
+
+
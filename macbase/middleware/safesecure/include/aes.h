@@ -22,6 +22,17 @@
   #define CTR 1
 #endif
 
+// AES_TTABLES selects how the rounds are computed:
+//   0: on bytes, the smallest (the S-boxes only, 512 bytes of tables)
+//   1: on 32-bit columns, with one 1 KB T-table per direction, rotated for the
+//      other rows
+//   4: on 32-bit columns, with four 1 KB T-tables per direction
+// The T-tables need a little endian core. Their context holds a second key
+// schedule for the decryption, expanded with the first one.
+#ifndef AES_TTABLES
+  #define AES_TTABLES 0
+#endif
+
 
 #define AES128 1
 //#define AES192 1
@@ -46,6 +57,9 @@ struct AES_ctx
 #if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
   uint8_t Iv[AES_BLOCKLEN];
 #endif
+#if (AES_TTABLES != 0) && ((defined(CBC) && (CBC == 1)) || (defined(ECB) && (ECB == 1)))
+  uint32_t InvRoundKey[AES_keyExpSize / 4];
+#endif
 };
 
 void AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key);
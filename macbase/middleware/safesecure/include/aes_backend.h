@@ -0,0 +1,96 @@
+#ifndef _AES_BACKEND_H_
+#define _AES_BACKEND_H_
+
+#include <stdint.h>
+#include "aes.h"
+
+// AES-128 behind one interface, whatever computes it. A backend gives the key
+// schedule and the block cipher, and its own CTR or CCM when it has them;
+// otherwise they are built here on its block cipher.
+//
+// The C backend (aes.c, its rounds as set by AES_TTABLES) is always built and
+// runs anywhere. #define the macros below to 1 to build the others, the same in
+// every translation unit (in the project settings):
+//   AES_BACKEND_SECLIB: SecLib of the connectivity framework (AES_128_Encrypt,
+//                       AES_128_CTR). It takes the key on every call and expands
+//                       it again each block.
+//   AES_BACKEND_MMCAU:  the crypto coprocessor of the Kinetis K cores, through
+//                       fsl_mmcau.c. The key schedule is expanded once.
+#ifndef AES_BACKEND_SECLIB
+  #define AES_BACKEND_SECLIB 0
+#endif
+
+#ifndef AES_BACKEND_MMCAU
+  #define AES_BACKEND_MMCAU 0
+#endif
+
+// The backend of the build: the C one, even when others are built in. Building
+// a hardware backend only adds it to AES_backends[]. #define this to one of the
+// AES_backend_* once AesBackendBench.c has checked it on the target and found
+// it the fastest in CCM there.
+#ifndef AES_BACKEND_DEFAULT
+  #define AES_BACKEND_DEFAULT (&AES_backend_c)
+#endif
+
+// CCM with a 13 byte nonce, which leaves 2 bytes (L) to the length of the data
+#define AES_CCM_NONCE_LEN 13
+
+struct AES_backend;
+
+// Key schedule, in the form its backend takes it
+struct AES_key
+{
+  const struct AES_backend* backend;
+  union
+  {
+    struct AES_ctx ctx;                  // C
+    uint32_t words[AES_keyExpSize / 4];  // MMCAU: 44 words
+    uint32_t raw[AES_KEYLEN / 4];        // SecLib: the key itself
+  } ks;
+};
+
+struct AES_backend
+{
+  const char* name;
+  void (*set_key)(struct AES_key* key, const uint8_t* raw);
+  // One block, in place
+  void (*encrypt)(const struct AES_key* key, uint8_t* buf);
+  void (*decrypt)(const struct AES_key* key, uint8_t* buf);
+  // 0 when the backend has none: AES_key_ctr() and AES_key_ccm() use encrypt
+  void (*ctr)(const struct AES_key* key, uint8_t* counter, uint8_t* buf, uint32_t length);
+  int (*ccm)(const struct AES_key* key, const uint8_t* nonce, const uint8_t* aad, uint16_t aadLen,
+             uint8_t* buf, uint16_t length, uint8_t* mic, uint8_t micLen, int encrypt);
+};
+
+extern const struct AES_backend AES_backend_c;
+#if AES_BACKEND_SECLIB == 1
+extern const struct AES_backend AES_backend_seclib;
+#endif
+#if AES_BACKEND_MMCAU == 1
+extern const struct AES_backend AES_backend_mmcau;
+#endif
+
+// The backends built in, AES_backend_count of them
+extern const struct AES_backend* const AES_backends[];
+extern const uint8_t AES_backend_count;
+
+// Expands raw (AES_KEYLEN bytes) for backend
+void AES_key_init(struct AES_key* key, const struct AES_backend* backend, const uint8_t* raw);
+
+// buffer size is exactly AES_BLOCKLEN bytes
+void AES_key_encrypt(const struct AES_key* key, uint8_t* buf);
+void AES_key_decrypt(const struct AES_key* key, uint8_t* buf);
+
+// Same function for encrypting as for decrypting. counter (AES_BLOCKLEN bytes,
+// big endian) is incremented for every block, the last one too when it is not
+// whole.
+void AES_key_ctr(const struct AES_key* key, uint8_t* counter, uint8_t* buf, uint32_t length);
+
+// CCM (RFC 3610) of length bytes in place with an AES_CCM_NONCE_LEN byte nonce,
+// aadLen (< 0xff00) bytes of aad authenticated along. Encrypting writes micLen
+// (4, 6, ... 16) bytes to mic, decrypting checks them and returns 0 when they do
+// not match.
+int AES_key_ccm(const struct AES_key* key, const uint8_t* nonce, const uint8_t* aad, uint16_t aadLen,
+                uint8_t* buf, uint16_t length, uint8_t* mic, uint8_t micLen, int encrypt);
+
+#endif //_AES_BACKEND_H_
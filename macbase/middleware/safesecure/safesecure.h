@@ -1,7 +1,26 @@
 #include "board.h"
-#include "aes.h"
+#include "aes_backend.h"
 #include "checksum.h"
 
+/*****************************
+/*  Macros
+/*****************************/
+
+/* Length of the MIC of the authenticated mode (SafeSecure_TransmitCcm):
+ * 4, 6, 8, 10, 12, 14 or 16 bytes */
+#ifndef SAFESECURE_MIC_LEN
+#define SAFESECURE_MIC_LEN 4
+#endif
+
+/* Frame of the authenticated mode: the frame counter of the sender (4 bytes,
+ * little endian), the encrypted payload and the MIC */
+#define SAFESECURE_CCM_HEADER_LEN 4
+#define SAFESECURE_CCM_OVERHEAD (SAFESECURE_CCM_HEADER_LEN + SAFESECURE_MIC_LEN)
+
+/* Frame of SafeSecure_Transmit(): the payload, padded to one AES block at
+ * least, and its CRC16 */
+#define SAFESECURE_CRC_LEN 2
+
 /*****************************
 /*  Type definition
 /*****************************/
@@ -37,6 +56,26 @@ typedef SafeSecureReceiveMsg_t (* ptrFnc_Receive)(uint8_t* data, uint8_t datalen
 /*  Functions
 /*****************************/
 
-extern void SafeSecure_Init(ptrFnc_Transmit p_Callback, ptrFnc_Receive p_RecCallback, uint8_t maxSizePkg);
+/* The key schedule is expanded here once. pScratch holds the frames being
+ * transmitted: maxSizePkg bytes that stay valid until the transmit callback
+ * returns. No memory is allocated per packet. */
+extern void SafeSecure_Init(ptrFnc_Transmit p_Callback, ptrFnc_Receive p_RecCallback, uint8_t maxSizePkg, uint8_t* pScratch);
+/* Sends data_len bytes, at least one AES block (shorter data is padded with
+ * zeros), followed by the CRC16 of the frame */
 extern SafeSecureTransmitMsg_t SafeSecure_Transmit(uint16_t dest_address, uint8_t* data, uint8_t data_len);
+/* Checks the CRC of a received frame and decrypts it in place, the receive
+ * callback gets it without the CRC */
 extern SafeSecureReceiveMsg_t  SafeSecure_Decrypt(uint8_t* data, uint8_t dataLen);
+
+/* Authenticated mode, AES-CCM (RFC 3610) over the whole payload in one pass.
+ * The nonce is made of the address of the sender and its frame counter, so
+ * every node needs its own address, and a counter that does not start over
+ * with the same key: SafeSecure_SetSource() sets both, before the first
+ * frame and again when the address changes. */
+extern void SafeSecure_SetSource(uint16_t src_address, uint32_t frameCounter);
+/* Sends the frame counter, data_len bytes encrypted and the MIC */
+extern SafeSecureTransmitMsg_t SafeSecure_TransmitCcm(uint16_t dest_address, uint8_t* data, uint8_t data_len);
+/* Decrypts a frame of src_address in place and checks its MIC, the payload
+ * starts SAFESECURE_CCM_HEADER_LEN bytes into data. A frame that fails the
+ * check is cleared. */
+extern SafeSecureReceiveMsg_t  SafeSecure_DecryptCcm(uint16_t src_address, uint8_t* data, uint8_t dataLen);
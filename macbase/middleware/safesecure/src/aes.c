@@ -77,42 +77,49 @@ typedef uint8_t state_t[4][4];
 // The lookup-tables are marked const so they can be placed in read-only storage instead of RAM
 // The numbers below can be computed dynamically trading ROM for RAM - 
 // This can be useful in (embedded) bootloader applications, where ROM is often limited.
-static const uint8_t sbox[256] = {
-  //0     1    2      3     4    5     6     7      8    9     A      B    C     D     E     F
-  0x63, 0x7c, 0x77, 0x7b, 0xf2, 0x6b, 0x6f, 0xc5, 0x30, 0x01, 0x67, 0x2b, 0xfe, 0xd7, 0xab, 0x76,
-  0xca, 0x82, 0xc9, 0x7d, 0xfa, 0x59, 0x47, 0xf0, 0xad, 0xd4, 0xa2, 0xaf, 0x9c, 0xa4, 0x72, 0xc0,
-  0xb7, 0xfd, 0x93, 0x26, 0x36, 0x3f, 0xf7, 0xcc, 0x34, 0xa5, 0xe5, 0xf1, 0x71, 0xd8, 0x31, 0x15,
-  0x04, 0xc7, 0x23, 0xc3, 0x18, 0x96, 0x05, 0x9a, 0x07, 0x12, 0x80, 0xe2, 0xeb, 0x27, 0xb2, 0x75,
-  0x09, 0x83, 0x2c, 0x1a, 0x1b, 0x6e, 0x5a, 0xa0, 0x52, 0x3b, 0xd6, 0xb3, 0x29, 0xe3, 0x2f, 0x84,
-  0x53, 0xd1, 0x00, 0xed, 0x20, 0xfc, 0xb1, 0x5b, 0x6a, 0xcb, 0xbe, 0x39, 0x4a, 0x4c, 0x58, 0xcf,
-  0xd0, 0xef, 0xaa, 0xfb, 0x43, 0x4d, 0x33, 0x85, 0x45, 0xf9, 0x02, 0x7f, 0x50, 0x3c, 0x9f, 0xa8,
-  0x51, 0xa3, 0x40, 0x8f, 0x92, 0x9d, 0x38, 0xf5, 0xbc, 0xb6, 0xda, 0x21, 0x10, 0xff, 0xf3, 0xd2,
-  0xcd, 0x0c, 0x13, 0xec, 0x5f, 0x97, 0x44, 0x17, 0xc4, 0xa7, 0x7e, 0x3d, 0x64, 0x5d, 0x19, 0x73,
-  0x60, 0x81, 0x4f, 0xdc, 0x22, 0x2a, 0x90, 0x88, 0x46, 0xee, 0xb8, 0x14, 0xde, 0x5e, 0x0b, 0xdb,
-  0xe0, 0x32, 0x3a, 0x0a, 0x49, 0x06, 0x24, 0x5c, 0xc2, 0xd3, 0xac, 0x62, 0x91, 0x95, 0xe4, 0x79,
-  0xe7, 0xc8, 0x37, 0x6d, 0x8d, 0xd5, 0x4e, 0xa9, 0x6c, 0x56, 0xf4, 0xea, 0x65, 0x7a, 0xae, 0x08,
-  0xba, 0x78, 0x25, 0x2e, 0x1c, 0xa6, 0xb4, 0xc6, 0xe8, 0xdd, 0x74, 0x1f, 0x4b, 0xbd, 0x8b, 0x8a,
-  0x70, 0x3e, 0xb5, 0x66, 0x48, 0x03, 0xf6, 0x0e, 0x61, 0x35, 0x57, 0xb9, 0x86, 0xc1, 0x1d, 0x9e,
-  0xe1, 0xf8, 0x98, 0x11, 0x69, 0xd9, 0x8e, 0x94, 0x9b, 0x1e, 0x87, 0xe9, 0xce, 0x55, 0x28, 0xdf,
-  0x8c, 0xa1, 0x89, 0x0d, 0xbf, 0xe6, 0x42, 0x68, 0x41, 0x99, 0x2d, 0x0f, 0xb0, 0x54, 0xbb, 0x16 };
-
-static const uint8_t rsbox[256] = {
-  0x52, 0x09, 0x6a, 0xd5, 0x30, 0x36, 0xa5, 0x38, 0xbf, 0x40, 0xa3, 0x9e, 0x81, 0xf3, 0xd7, 0xfb,
-  0x7c, 0xe3, 0x39, 0x82, 0x9b, 0x2f, 0xff, 0x87, 0x34, 0x8e, 0x43, 0x44, 0xc4, 0xde, 0xe9, 0xcb,
-  0x54, 0x7b, 0x94, 0x32, 0xa6, 0xc2, 0x23, 0x3d, 0xee, 0x4c, 0x95, 0x0b, 0x42, 0xfa, 0xc3, 0x4e,
-  0x08, 0x2e, 0xa1, 0x66, 0x28, 0xd9, 0x24, 0xb2, 0x76, 0x5b, 0xa2, 0x49, 0x6d, 0x8b, 0xd1, 0x25,
-  0x72, 0xf8, 0xf6, 0x64, 0x86, 0x68, 0x98, 0x16, 0xd4, 0xa4, 0x5c, 0xcc, 0x5d, 0x65, 0xb6, 0x92,
-  0x6c, 0x70, 0x48, 0x50, 0xfd, 0xed, 0xb9, 0xda, 0x5e, 0x15, 0x46, 0x57, 0xa7, 0x8d, 0x9d, 0x84,
-  0x90, 0xd8, 0xab, 0x00, 0x8c, 0xbc, 0xd3, 0x0a, 0xf7, 0xe4, 0x58, 0x05, 0xb8, 0xb3, 0x45, 0x06,
-  0xd0, 0x2c, 0x1e, 0x8f, 0xca, 0x3f, 0x0f, 0x02, 0xc1, 0xaf, 0xbd, 0x03, 0x01, 0x13, 0x8a, 0x6b,
-  0x3a, 0x91, 0x11, 0x41, 0x4f, 0x67, 0xdc, 0xea, 0x97, 0xf2, 0xcf, 0xce, 0xf0, 0xb4, 0xe6, 0x73,
-  0x96, 0xac, 0x74, 0x22, 0xe7, 0xad, 0x35, 0x85, 0xe2, 0xf9, 0x37, 0xe8, 0x1c, 0x75, 0xdf, 0x6e,
-  0x47, 0xf1, 0x1a, 0x71, 0x1d, 0x29, 0xc5, 0x89, 0x6f, 0xb7, 0x62, 0x0e, 0xaa, 0x18, 0xbe, 0x1b,
-  0xfc, 0x56, 0x3e, 0x4b, 0xc6, 0xd2, 0x79, 0x20, 0x9a, 0xdb, 0xc0, 0xfe, 0x78, 0xcd, 0x5a, 0xf4,
-  0x1f, 0xdd, 0xa8, 0x33, 0x88, 0x07, 0xc7, 0x31, 0xb1, 0x12, 0x10, 0x59, 0x27, 0x80, 0xec, 0x5f,
-  0x60, 0x51, 0x7f, 0xa9, 0x19, 0xb5, 0x4a, 0x0d, 0x2d, 0xe5, 0x7a, 0x9f, 0x93, 0xc9, 0x9c, 0xef,
-  0xa0, 0xe0, 0x3b, 0x4d, 0xae, 0x2a, 0xf5, 0xb0, 0xc8, 0xeb, 0xbb, 0x3c, 0x83, 0x53, 0x99, 0x61,
-  0x17, 0x2b, 0x04, 0x7e, 0xba, 0x77, 0xd6, 0x26, 0xe1, 0x69, 0x14, 0x63, 0x55, 0x21, 0x0c, 0x7d };
+// The S-boxes are given as lists, from which the byte tables below and the
+// T-tables (AES_TTABLES) are built at compile time.
+#define SBOX_BYTE(s) s,
+
+#define SBOX(f) \
+  f(0x63) f(0x7c) f(0x77) f(0x7b) f(0xf2) f(0x6b) f(0x6f) f(0xc5) f(0x30) f(0x01) f(0x67) f(0x2b) f(0xfe) f(0xd7) f(0xab) f(0x76) \
+  f(0xca) f(0x82) f(0xc9) f(0x7d) f(0xfa) f(0x59) f(0x47) f(0xf0) f(0xad) f(0xd4) f(0xa2) f(0xaf) f(0x9c) f(0xa4) f(0x72) f(0xc0) \
+  f(0xb7) f(0xfd) f(0x93) f(0x26) f(0x36) f(0x3f) f(0xf7) f(0xcc) f(0x34) f(0xa5) f(0xe5) f(0xf1) f(0x71) f(0xd8) f(0x31) f(0x15) \
+  f(0x04) f(0xc7) f(0x23) f(0xc3) f(0x18) f(0x96) f(0x05) f(0x9a) f(0x07) f(0x12) f(0x80) f(0xe2) f(0xeb) f(0x27) f(0xb2) f(0x75) \
+  f(0x09) f(0x83) f(0x2c) f(0x1a) f(0x1b) f(0x6e) f(0x5a) f(0xa0) f(0x52) f(0x3b) f(0xd6) f(0xb3) f(0x29) f(0xe3) f(0x2f) f(0x84) \
+  f(0x53) f(0xd1) f(0x00) f(0xed) f(0x20) f(0xfc) f(0xb1) f(0x5b) f(0x6a) f(0xcb) f(0xbe) f(0x39) f(0x4a) f(0x4c) f(0x58) f(0xcf) \
+  f(0xd0) f(0xef) f(0xaa) f(0xfb) f(0x43) f(0x4d) f(0x33) f(0x85) f(0x45) f(0xf9) f(0x02) f(0x7f) f(0x50) f(0x3c) f(0x9f) f(0xa8) \
+  f(0x51) f(0xa3) f(0x40) f(0x8f) f(0x92) f(0x9d) f(0x38) f(0xf5) f(0xbc) f(0xb6) f(0xda) f(0x21) f(0x10) f(0xff) f(0xf3) f(0xd2) \
+  f(0xcd) f(0x0c) f(0x13) f(0xec) f(0x5f) f(0x97) f(0x44) f(0x17) f(0xc4) f(0xa7) f(0x7e) f(0x3d) f(0x64) f(0x5d) f(0x19) f(0x73) \
+  f(0x60) f(0x81) f(0x4f) f(0xdc) f(0x22) f(0x2a) f(0x90) f(0x88) f(0x46) f(0xee) f(0xb8) f(0x14) f(0xde) f(0x5e) f(0x0b) f(0xdb) \
+  f(0xe0) f(0x32) f(0x3a) f(0x0a) f(0x49) f(0x06) f(0x24) f(0x5c) f(0xc2) f(0xd3) f(0xac) f(0x62) f(0x91) f(0x95) f(0xe4) f(0x79) \
+  f(0xe7) f(0xc8) f(0x37) f(0x6d) f(0x8d) f(0xd5) f(0x4e) f(0xa9) f(0x6c) f(0x56) f(0xf4) f(0xea) f(0x65) f(0x7a) f(0xae) f(0x08) \
+  f(0xba) f(0x78) f(0x25) f(0x2e) f(0x1c) f(0xa6) f(0xb4) f(0xc6) f(0xe8) f(0xdd) f(0x74) f(0x1f) f(0x4b) f(0xbd) f(0x8b) f(0x8a) \
+  f(0x70) f(0x3e) f(0xb5) f(0x66) f(0x48) f(0x03) f(0xf6) f(0x0e) f(0x61) f(0x35) f(0x57) f(0xb9) f(0x86) f(0xc1) f(0x1d) f(0x9e) \
+  f(0xe1) f(0xf8) f(0x98) f(0x11) f(0x69) f(0xd9) f(0x8e) f(0x94) f(0x9b) f(0x1e) f(0x87) f(0xe9) f(0xce) f(0x55) f(0x28) f(0xdf) \
+  f(0x8c) f(0xa1) f(0x89) f(0x0d) f(0xbf) f(0xe6) f(0x42) f(0x68) f(0x41) f(0x99) f(0x2d) f(0x0f) f(0xb0) f(0x54) f(0xbb) f(0x16)
+
+static const uint8_t sbox[256] = { SBOX(SBOX_BYTE) };
+
+#define RSBOX(f) \
+  f(0x52) f(0x09) f(0x6a) f(0xd5) f(0x30) f(0x36) f(0xa5) f(0x38) f(0xbf) f(0x40) f(0xa3) f(0x9e) f(0x81) f(0xf3) f(0xd7) f(0xfb) \
+  f(0x7c) f(0xe3) f(0x39) f(0x82) f(0x9b) f(0x2f) f(0xff) f(0x87) f(0x34) f(0x8e) f(0x43) f(0x44) f(0xc4) f(0xde) f(0xe9) f(0xcb) \
+  f(0x54) f(0x7b) f(0x94) f(0x32) f(0xa6) f(0xc2) f(0x23) f(0x3d) f(0xee) f(0x4c) f(0x95) f(0x0b) f(0x42) f(0xfa) f(0xc3) f(0x4e) \
+  f(0x08) f(0x2e) f(0xa1) f(0x66) f(0x28) f(0xd9) f(0x24) f(0xb2) f(0x76) f(0x5b) f(0xa2) f(0x49) f(0x6d) f(0x8b) f(0xd1) f(0x25) \
+  f(0x72) f(0xf8) f(0xf6) f(0x64) f(0x86) f(0x68) f(0x98) f(0x16) f(0xd4) f(0xa4) f(0x5c) f(0xcc) f(0x5d) f(0x65) f(0xb6) f(0x92) \
+  f(0x6c) f(0x70) f(0x48) f(0x50) f(0xfd) f(0xed) f(0xb9) f(0xda) f(0x5e) f(0x15) f(0x46) f(0x57) f(0xa7) f(0x8d) f(0x9d) f(0x84) \
+  f(0x90) f(0xd8) f(0xab) f(0x00) f(0x8c) f(0xbc) f(0xd3) f(0x0a) f(0xf7) f(0xe4) f(0x58) f(0x05) f(0xb8) f(0xb3) f(0x45) f(0x06) \
+  f(0xd0) f(0x2c) f(0x1e) f(0x8f) f(0xca) f(0x3f) f(0x0f) f(0x02) f(0xc1) f(0xaf) f(0xbd) f(0x03) f(0x01) f(0x13) f(0x8a) f(0x6b) \
+  f(0x3a) f(0x91) f(0x11) f(0x41) f(0x4f) f(0x67) f(0xdc) f(0xea) f(0x97) f(0xf2) f(0xcf) f(0xce) f(0xf0) f(0xb4) f(0xe6) f(0x73) \
+  f(0x96) f(0xac) f(0x74) f(0x22) f(0xe7) f(0xad) f(0x35) f(0x85) f(0xe2) f(0xf9) f(0x37) f(0xe8) f(0x1c) f(0x75) f(0xdf) f(0x6e) \
+  f(0x47) f(0xf1) f(0x1a) f(0x71) f(0x1d) f(0x29) f(0xc5) f(0x89) f(0x6f) f(0xb7) f(0x62) f(0x0e) f(0xaa) f(0x18) f(0xbe) f(0x1b) \
+  f(0xfc) f(0x56) f(0x3e) f(0x4b) f(0xc6) f(0xd2) f(0x79) f(0x20) f(0x9a) f(0xdb) f(0xc0) f(0xfe) f(0x78) f(0xcd) f(0x5a) f(0xf4) \
+  f(0x1f) f(0xdd) f(0xa8) f(0x33) f(0x88) f(0x07) f(0xc7) f(0x31) f(0xb1) f(0x12) f(0x10) f(0x59) f(0x27) f(0x80) f(0xec) f(0x5f) \
+  f(0x60) f(0x51) f(0x7f) f(0xa9) f(0x19) f(0xb5) f(0x4a) f(0x0d) f(0x2d) f(0xe5) f(0x7a) f(0x9f) f(0x93) f(0xc9) f(0x9c) f(0xef) \
+  f(0xa0) f(0xe0) f(0x3b) f(0x4d) f(0xae) f(0x2a) f(0xf5) f(0xb0) f(0xc8) f(0xeb) f(0xbb) f(0x3c) f(0x83) f(0x53) f(0x99) f(0x61) \
+  f(0x17) f(0x2b) f(0x04) f(0x7e) f(0xba) f(0x77) f(0xd6) f(0x26) f(0xe1) f(0x69) f(0x14) f(0x63) f(0x55) f(0x21) f(0x0c) f(0x7d)
+
+static const uint8_t rsbox[256] = { RSBOX(SBOX_BYTE) };
 
 // The round constant word array, Rcon[i], contains the values given by 
 // x to the power (i-1) being powers of x (x is denoted as {02}) in the field GF(2^8)
@@ -222,14 +229,24 @@ static void KeyExpansion(uint8_t* RoundKey, const uint8_t* Key)
   }
 }
 
+#if (AES_TTABLES != 0) && ((defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1))
+static void InvKeyExpansion(uint32_t* InvRoundKey, const uint8_t* RoundKey);
+#endif
+
 void AES_init_ctx(struct AES_ctx* ctx, const uint8_t* key)
 {
   KeyExpansion(ctx->RoundKey, key);
+#if (AES_TTABLES != 0) && ((defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1))
+  InvKeyExpansion(ctx->InvRoundKey, ctx->RoundKey);
+#endif
 }
 #if (defined(CBC) && (CBC == 1)) || (defined(CTR) && (CTR == 1))
 void AES_init_ctx_iv(struct AES_ctx* ctx, const uint8_t* key, const uint8_t* iv)
 {
   KeyExpansion(ctx->RoundKey, key);
+#if (AES_TTABLES != 0) && ((defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1))
+  InvKeyExpansion(ctx->InvRoundKey, ctx->RoundKey);
+#endif
   memcpy (ctx->Iv, iv, AES_BLOCKLEN);
 }
 void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv)
@@ -238,6 +255,8 @@ void AES_ctx_set_iv(struct AES_ctx* ctx, const uint8_t* iv)
 }
 #endif
 
+#if AES_TTABLES == 0
+
 // This function adds the round key to state.
 // The round key is added to the state by an XOR function.
 static void AddRoundKey(uint8_t round, state_t* state, const uint8_t* RoundKey)
@@ -460,6 +479,181 @@ static void InvCipher(state_t* state, const uint8_t* RoundKey)
 }
 #endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
 
+// The round keys of the decryption are the ones of the encryption
+#define INV_ROUNDKEY(ctx) ((ctx)->RoundKey)
+
+#else // AES_TTABLES
+
+// A round on 32-bit columns: SubBytes, ShiftRows and MixColumns of a byte are
+// one lookup in the T-table of its row, and a column of the next state is the
+// XOR of four lookups and of its round key. The columns are little endian
+// words, row 0 in bits 0-7, as loaded from the state by a little endian core.
+#if (AES_TTABLES != 1) && (AES_TTABLES != 4)
+  #error "AES_TTABLES must be 0, 1 or 4"
+#endif
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+  #error "AES_TTABLES needs a little endian core"
+#endif
+
+// Products in GF(2^8) of an S-box value, as constant expressions
+#define TT_XT(x) ((((x) << 1) ^ ((((x) >> 7) & 1) * 0x1b)) & 0xff)
+#define TT_M2(s) TT_XT(s)
+#define TT_M3(s) (TT_XT(s) ^ (s))
+#define TT_M9(s) (TT_XT(TT_XT(TT_XT(s))) ^ (s))
+#define TT_MB(s) (TT_XT(TT_XT(TT_XT(s))) ^ TT_XT(s) ^ (s))
+#define TT_MD(s) (TT_XT(TT_XT(TT_XT(s))) ^ TT_XT(TT_XT(s)) ^ (s))
+#define TT_ME(s) (TT_XT(TT_XT(TT_XT(s))) ^ TT_XT(TT_XT(s)) ^ TT_XT(s))
+
+#define TT_WORD(b0, b1, b2, b3) \
+  ((uint32_t)(b0) | ((uint32_t)(b1) << 8) | ((uint32_t)(b2) << 16) | ((uint32_t)(b3) << 24))
+#define TT_ROTL(w, n) (((w) << (n)) | ((w) >> (32 - (n))))
+
+// Column of MixColumns (02 01 01 03) and of InvMixColumns (0e 09 0d 0b) for a
+// byte of row 0; the rows 1 to 3 are the same column rotated
+#define TE0(s) TT_WORD(TT_M2(s), s, s, TT_M3(s)),
+#define TE1(s) TT_WORD(TT_M3(s), TT_M2(s), s, s),
+#define TE2(s) TT_WORD(s, TT_M3(s), TT_M2(s), s),
+#define TE3(s) TT_WORD(s, s, TT_M3(s), TT_M2(s)),
+#define TD0(s) TT_WORD(TT_ME(s), TT_M9(s), TT_MD(s), TT_MB(s)),
+#define TD1(s) TT_WORD(TT_MB(s), TT_ME(s), TT_M9(s), TT_MD(s)),
+#define TD2(s) TT_WORD(TT_MD(s), TT_MB(s), TT_ME(s), TT_M9(s)),
+#define TD3(s) TT_WORD(TT_M9(s), TT_MD(s), TT_MB(s), TT_ME(s)),
+
+static const uint32_t Te0[256] = { SBOX(TE0) };
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+static const uint32_t Td0[256] = { RSBOX(TD0) };
+#endif
+
+#if AES_TTABLES == 4
+static const uint32_t Te1[256] = { SBOX(TE1) };
+static const uint32_t Te2[256] = { SBOX(TE2) };
+static const uint32_t Te3[256] = { SBOX(TE3) };
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+static const uint32_t Td1[256] = { RSBOX(TD1) };
+static const uint32_t Td2[256] = { RSBOX(TD2) };
+static const uint32_t Td3[256] = { RSBOX(TD3) };
+#endif
+  #define TE(r, x) (Te##r[(x)])
+  #define TD(r, x) (Td##r[(x)])
+#else
+  // One table: a rotation per lookup, free on the barrel shifter of a Cortex-M
+  #define TT_ROT0(w) (w)
+  #define TT_ROT1(w) TT_ROTL(w, 8)
+  #define TT_ROT2(w) TT_ROTL(w, 16)
+  #define TT_ROT3(w) TT_ROTL(w, 24)
+  #define TE(r, x) TT_ROT##r(Te0[(x)])
+  #define TD(r, x) TT_ROT##r(Td0[(x)])
+#endif
+
+// Bytes of a column
+#define B0(w) ((w) & 0xff)
+#define B1(w) (((w) >> 8) & 0xff)
+#define B2(w) (((w) >> 16) & 0xff)
+#define B3(w) ((w) >> 24)
+
+static uint32_t GetWord(const uint8_t* p)
+{
+  uint32_t w;
+  memcpy(&w, p, 4);
+  return w;
+}
+
+static void PutWord(uint8_t* p, uint32_t w)
+{
+  memcpy(p, &w, 4);
+}
+
+// Cipher is the main function that encrypts the PlainText.
+// Row r of a new column c comes from the column c + r (ShiftRows).
+static void Cipher(state_t* state, const uint8_t* RoundKey)
+{
+  uint8_t* buf = (uint8_t*)state;
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  uint8_t round;
+
+  // Add the First round key to the state before starting the rounds.
+  s0 = GetWord(buf)      ^ GetWord(RoundKey);
+  s1 = GetWord(buf + 4)  ^ GetWord(RoundKey + 4);
+  s2 = GetWord(buf + 8)  ^ GetWord(RoundKey + 8);
+  s3 = GetWord(buf + 12) ^ GetWord(RoundKey + 12);
+
+  for (round = 1; round < Nr; ++round)
+  {
+    RoundKey += AES_BLOCKLEN;
+    t0 = TE(0, B0(s0)) ^ TE(1, B1(s1)) ^ TE(2, B2(s2)) ^ TE(3, B3(s3)) ^ GetWord(RoundKey);
+    t1 = TE(0, B0(s1)) ^ TE(1, B1(s2)) ^ TE(2, B2(s3)) ^ TE(3, B3(s0)) ^ GetWord(RoundKey + 4);
+    t2 = TE(0, B0(s2)) ^ TE(1, B1(s3)) ^ TE(2, B2(s0)) ^ TE(3, B3(s1)) ^ GetWord(RoundKey + 8);
+    t3 = TE(0, B0(s3)) ^ TE(1, B1(s0)) ^ TE(2, B2(s1)) ^ TE(3, B3(s2)) ^ GetWord(RoundKey + 12);
+    s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+  }
+
+  // The last round has no MixColumns: the S-box and ShiftRows only.
+  RoundKey += AES_BLOCKLEN;
+  PutWord(buf,      TT_WORD(sbox[B0(s0)], sbox[B1(s1)], sbox[B2(s2)], sbox[B3(s3)]) ^ GetWord(RoundKey));
+  PutWord(buf + 4,  TT_WORD(sbox[B0(s1)], sbox[B1(s2)], sbox[B2(s3)], sbox[B3(s0)]) ^ GetWord(RoundKey + 4));
+  PutWord(buf + 8,  TT_WORD(sbox[B0(s2)], sbox[B1(s3)], sbox[B2(s0)], sbox[B3(s1)]) ^ GetWord(RoundKey + 8));
+  PutWord(buf + 12, TT_WORD(sbox[B0(s3)], sbox[B1(s0)], sbox[B2(s1)], sbox[B3(s2)]) ^ GetWord(RoundKey + 12));
+}
+
+#if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+// The equivalent inverse cipher: the T-tables merge InvSubBytes and
+// InvMixColumns, so the round keys it adds after them are put through
+// InvMixColumns as well, and taken in the reverse order. InvMixColumns of a
+// word is Td of the S-box values of its bytes.
+static void InvKeyExpansion(uint32_t* InvRoundKey, const uint8_t* RoundKey)
+{
+  uint32_t w;
+  unsigned round, i;
+
+  for (round = 0; round <= Nr; ++round)
+  {
+    for (i = 0; i < Nb; ++i)
+    {
+      w = GetWord(&RoundKey[((Nr - round) * Nb + i) * 4]);
+      if ((round != 0) && (round != Nr))
+      {
+        w = TD(0, sbox[B0(w)]) ^ TD(1, sbox[B1(w)]) ^ TD(2, sbox[B2(w)]) ^ TD(3, sbox[B3(w)]);
+      }
+      InvRoundKey[round * Nb + i] = w;
+    }
+  }
+}
+
+// Row r of a new column c comes from the column c - r (InvShiftRows).
+static void InvCipher(state_t* state, const uint32_t* RoundKey)
+{
+  uint8_t* buf = (uint8_t*)state;
+  uint32_t s0, s1, s2, s3, t0, t1, t2, t3;
+  uint8_t round;
+
+  s0 = GetWord(buf)      ^ RoundKey[0];
+  s1 = GetWord(buf + 4)  ^ RoundKey[1];
+  s2 = GetWord(buf + 8)  ^ RoundKey[2];
+  s3 = GetWord(buf + 12) ^ RoundKey[3];
+
+  for (round = 1; round < Nr; ++round)
+  {
+    RoundKey += Nb;
+    t0 = TD(0, B0(s0)) ^ TD(1, B1(s3)) ^ TD(2, B2(s2)) ^ TD(3, B3(s1)) ^ RoundKey[0];
+    t1 = TD(0, B0(s1)) ^ TD(1, B1(s0)) ^ TD(2, B2(s3)) ^ TD(3, B3(s2)) ^ RoundKey[1];
+    t2 = TD(0, B0(s2)) ^ TD(1, B1(s1)) ^ TD(2, B2(s0)) ^ TD(3, B3(s3)) ^ RoundKey[2];
+    t3 = TD(0, B0(s3)) ^ TD(1, B1(s2)) ^ TD(2, B2(s1)) ^ TD(3, B3(s0)) ^ RoundKey[3];
+    s0 = t0; s1 = t1; s2 = t2; s3 = t3;
+  }
+
+  // The last round has no InvMixColumns.
+  RoundKey += Nb;
+  PutWord(buf,      TT_WORD(rsbox[B0(s0)], rsbox[B1(s3)], rsbox[B2(s2)], rsbox[B3(s1)]) ^ RoundKey[0]);
+  PutWord(buf + 4,  TT_WORD(rsbox[B0(s1)], rsbox[B1(s0)], rsbox[B2(s3)], rsbox[B3(s2)]) ^ RoundKey[1]);
+  PutWord(buf + 8,  TT_WORD(rsbox[B0(s2)], rsbox[B1(s1)], rsbox[B2(s0)], rsbox[B3(s3)]) ^ RoundKey[2]);
+  PutWord(buf + 12, TT_WORD(rsbox[B0(s3)], rsbox[B1(s2)], rsbox[B2(s1)], rsbox[B3(s0)]) ^ RoundKey[3]);
+}
+
+#define INV_ROUNDKEY(ctx) ((ctx)->InvRoundKey)
+#endif // #if (defined(CBC) && CBC == 1) || (defined(ECB) && ECB == 1)
+
+#endif // AES_TTABLES
+
 /*****************************************************************************/
 /* Public functions:                                                         */
 /*****************************************************************************/
@@ -475,7 +669,7 @@ void AES_ECB_encrypt(const struct AES_ctx* ctx, uint8_t* buf)
 void AES_ECB_decrypt(const struct AES_ctx* ctx, uint8_t* buf)
 {
   // The next function call decrypts the PlainText with the Key using AES algorithm.
-  InvCipher((state_t*)buf, ctx->RoundKey);
+  InvCipher((state_t*)buf, INV_ROUNDKEY(ctx));
 }
 
 
@@ -520,7 +714,7 @@ void AES_CBC_decrypt_buffer(struct AES_ctx* ctx, uint8_t* buf,  uint32_t length)
   for (i = 0; i < length; i += AES_BLOCKLEN)
   {
     memcpy(storeNextIv, buf, AES_BLOCKLEN);
-    InvCipher((state_t*)buf, ctx->RoundKey);
+    InvCipher((state_t*)buf, INV_ROUNDKEY(ctx));
     XorWithIv(buf, ctx->Iv);
     memcpy(ctx->Iv, storeNextIv, AES_BLOCKLEN);
     buf += AES_BLOCKLEN;
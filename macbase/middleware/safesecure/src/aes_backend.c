@@ -0,0 +1,216 @@
+/*
+
+This is the backend layer of the AES of the SafeSecure library: the C backend
+on aes.c, the list of the backends built in, and CTR and CCM on the block cipher
+of a backend that has none of its own.
+
+The hardware backends are in aes_backend_seclib.c and aes_backend_mmcau.c.
+
+*/
+
+
+/*****************************************************************************/
+/* Includes:                                                                 */
+/*****************************************************************************/
+#include <string.h>
+#include "aes_backend.h"
+
+/*****************************************************************************/
+/* Defines:                                                                  */
+/*****************************************************************************/
+#if !defined(ECB) || (ECB != 1)
+  #error "the C backend needs the ECB mode of aes.c"
+#endif
+
+// Flags of the first CBC-MAC block and of the counter blocks
+#define CCM_L 2
+#define CCM_FLAG_AAD 0x40
+
+
+/*****************************************************************************/
+/* C backend:                                                                */
+/*****************************************************************************/
+static void C_set_key(struct AES_key* key, const uint8_t* raw)
+{
+  AES_init_ctx(&key->ks.ctx, raw);
+}
+
+static void C_encrypt(const struct AES_key* key, uint8_t* buf)
+{
+  AES_ECB_encrypt(&key->ks.ctx, buf);
+}
+
+static void C_decrypt(const struct AES_key* key, uint8_t* buf)
+{
+  AES_ECB_decrypt(&key->ks.ctx, buf);
+}
+
+const struct AES_backend AES_backend_c =
+{
+#if AES_TTABLES == 0
+  "c",
+#elif AES_TTABLES == 1
+  "c ttables 1",
+#else
+  "c ttables 4",
+#endif
+  C_set_key,
+  C_encrypt,
+  C_decrypt,
+  0,
+  0
+};
+
+const struct AES_backend* const AES_backends[] =
+{
+  &AES_backend_c,
+#if AES_BACKEND_SECLIB == 1
+  &AES_backend_seclib,
+#endif
+#if AES_BACKEND_MMCAU == 1
+  &AES_backend_mmcau,
+#endif
+};
+
+const uint8_t AES_backend_count = sizeof(AES_backends) / sizeof(AES_backends[0]);
+
+
+/*****************************************************************************/
+/* Public functions:                                                         */
+/*****************************************************************************/
+void AES_key_init(struct AES_key* key, const struct AES_backend* backend, const uint8_t* raw)
+{
+  key->backend = backend;
+  backend->set_key(key, raw);
+}
+
+void AES_key_encrypt(const struct AES_key* key, uint8_t* buf)
+{
+  key->backend->encrypt(key, buf);
+}
+
+void AES_key_decrypt(const struct AES_key* key, uint8_t* buf)
+{
+  key->backend->decrypt(key, buf);
+}
+
+void AES_key_ctr(const struct AES_key* key, uint8_t* counter, uint8_t* buf, uint32_t length)
+{
+  uint8_t stream[AES_BLOCKLEN];
+  uint32_t i, j, n;
+  int bi;
+
+  if (0 != key->backend->ctr)
+  {
+    if (length)
+    {
+      key->backend->ctr(key, counter, buf, length);
+    }
+    return;
+  }
+
+  for (i = 0; i < length; i += n)
+  {
+    memcpy(stream, counter, AES_BLOCKLEN);
+    key->backend->encrypt(key, stream);
+
+    // Increment the counter, the 16 bytes as one big endian number
+    for (bi = AES_BLOCKLEN - 1; (bi >= 0) && (0 == ++counter[bi]); bi--)
+    {
+    }
+
+    n = (length - i < AES_BLOCKLEN) ? (length - i) : AES_BLOCKLEN;
+    for (j = 0; j < n; j++)
+    {
+      buf[i + j] ^= stream[j];
+    }
+  }
+}
+
+int AES_key_ccm(const struct AES_key* key, const uint8_t* nonce, const uint8_t* aad, uint16_t aadLen,
+                uint8_t* buf, uint16_t length, uint8_t* mic, uint8_t micLen, int encrypt)
+{
+  uint8_t mac[AES_BLOCKLEN];
+  uint8_t counter[AES_BLOCKLEN];
+  uint8_t s0[AES_BLOCKLEN];
+  uint8_t diff = 0;
+  uint32_t i, j, n;
+
+  if (0 != key->backend->ccm)
+  {
+    return key->backend->ccm(key, nonce, aad, aadLen, buf, length, mic, micLen, encrypt);
+  }
+
+  // CBC-MAC, first block: flags, nonce, length of the data
+  mac[0] = (aadLen ? CCM_FLAG_AAD : 0) | (((micLen - 2) / 2) << 3) | (CCM_L - 1);
+  memcpy(&mac[1], nonce, AES_CCM_NONCE_LEN);
+  mac[14] = (uint8_t)(length >> 8);
+  mac[15] = (uint8_t)length;
+  key->backend->encrypt(key, mac);
+
+  // Then the associated data, after its length (2 bytes)
+  if (aadLen)
+  {
+    mac[0] ^= (uint8_t)(aadLen >> 8);
+    mac[1] ^= (uint8_t)aadLen;
+    for (i = 0, n = 2; i < aadLen; i++)
+    {
+      mac[n++] ^= aad[i];
+      if (AES_BLOCKLEN == n)
+      {
+        key->backend->encrypt(key, mac);
+        n = 0;
+      }
+    }
+    if (n)
+    {
+      key->backend->encrypt(key, mac);
+    }
+  }
+
+  // Counter blocks: flags, nonce, block number. Block 0 encrypts the MIC and
+  // leaves the counter on block 1, the first one of the data.
+  counter[0] = CCM_L - 1;
+  memcpy(&counter[1], nonce, AES_CCM_NONCE_LEN);
+  counter[14] = 0;
+  counter[15] = 0;
+  memset(s0, 0, AES_BLOCKLEN);
+  AES_key_ctr(key, counter, s0, AES_BLOCKLEN);
+
+  // One pass over the data, a block at a time. The CBC-MAC takes the plaintext:
+  // before the block is encrypted, after it is decrypted.
+  for (i = 0; i < length; i += n)
+  {
+    n = (length - i < AES_BLOCKLEN) ? (length - i) : AES_BLOCKLEN;
+
+    if (!encrypt)
+    {
+      AES_key_ctr(key, counter, &buf[i], n);
+    }
+    for (j = 0; j < n; j++)
+    {
+      mac[j] ^= buf[i + j];
+    }
+    key->backend->encrypt(key, mac);
+    if (encrypt)
+    {
+      AES_key_ctr(key, counter, &buf[i], n);
+    }
+  }
+
+  if (encrypt)
+  {
+    for (i = 0; i < micLen; i++)
+    {
+      mic[i] = mac[i] ^ s0[i];
+    }
+    return 1;
+  }
+
+  // Compared in full, the time does not tell where the MIC differs
+  for (i = 0; i < micLen; i++)
+  {
+    diff |= mic[i] ^ mac[i] ^ s0[i];
+  }
+  return (0 == diff);
+}
@@ -0,0 +1,68 @@
+/*
+
+This is the MMCAU backend of the AES of the SafeSecure library
+(AES_BACKEND_MMCAU): the crypto coprocessor of the Kinetis K cores, through
+fsl_mmcau.c. Target only.
+
+The key schedule is expanded once, by AES_key_init(). CTR and CCM are the ones
+of aes_backend.c on its blocks.
+
+The registers of the coprocessor are not saved on a context switch: every call
+runs with the interrupts off, a block at a time. SecLib drives the coprocessor
+too but only takes a mutex of its own, so a task must not be using its AES or
+SHA while another one runs this backend.
+
+*/
+
+
+/*****************************************************************************/
+/* Includes:                                                                 */
+/*****************************************************************************/
+#include "aes_backend.h"
+
+#if AES_BACKEND_MMCAU == 1
+
+#include "fsl_mmcau.h"
+#include "fsl_os_abstraction.h"
+
+/*****************************************************************************/
+/* Defines:                                                                  */
+/*****************************************************************************/
+#define MMCAU_ROUNDS 10
+
+
+/*****************************************************************************/
+/* MMCAU backend:                                                            */
+/*****************************************************************************/
+static void Mmcau_set_key(struct AES_key* key, const uint8_t* raw)
+{
+  OSA_InterruptDisable();
+  (void)MMCAU_AES_SetKey(raw, AES_KEYLEN, (uint8_t*)key->ks.words);
+  OSA_InterruptEnable();
+}
+
+static void Mmcau_encrypt(const struct AES_key* key, uint8_t* buf)
+{
+  OSA_InterruptDisable();
+  (void)MMCAU_AES_EncryptEcb(buf, (const uint8_t*)key->ks.words, MMCAU_ROUNDS, buf);
+  OSA_InterruptEnable();
+}
+
+static void Mmcau_decrypt(const struct AES_key* key, uint8_t* buf)
+{
+  OSA_InterruptDisable();
+  (void)MMCAU_AES_DecryptEcb(buf, (const uint8_t*)key->ks.words, MMCAU_ROUNDS, buf);
+  OSA_InterruptEnable();
+}
+
+const struct AES_backend AES_backend_mmcau =
+{
+  "mmcau",
+  Mmcau_set_key,
+  Mmcau_encrypt,
+  Mmcau_decrypt,
+  0,
+  0
+};
+
+#endif // #if AES_BACKEND_MMCAU == 1
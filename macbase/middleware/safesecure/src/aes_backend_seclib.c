@@ -0,0 +1,65 @@
+/*
+
+This is the SecLib backend of the AES of the SafeSecure library
+(AES_BACKEND_SECLIB): the AES of the connectivity framework, on the crypto
+hardware of the part when it has one. Target only.
+
+SecLib takes the key on every call, so the key schedule here is the key itself.
+CTR is its own (AES_128_CTR). CCM is the one of aes_backend.c on its blocks:
+AES_128_CCM is not documented to work in place.
+
+*/
+
+
+/*****************************************************************************/
+/* Includes:                                                                 */
+/*****************************************************************************/
+#include <string.h>
+#include "aes_backend.h"
+
+#if AES_BACKEND_SECLIB == 1
+
+#include "SecLib.h"
+
+
+/*****************************************************************************/
+/* SecLib backend:                                                           */
+/*****************************************************************************/
+static void SecLib_set_key(struct AES_key* key, const uint8_t* raw)
+{
+  memcpy(key->ks.raw, raw, AES_KEYLEN);
+}
+
+static void SecLib_encrypt(const struct AES_key* key, uint8_t* buf)
+{
+  // Aligned to 4 bytes, as SecLib asks
+  uint32_t out[AES_BLOCKLEN / 4];
+
+  AES_128_Encrypt(buf, (const uint8_t*)key->ks.raw, (uint8_t*)out);
+  memcpy(buf, out, AES_BLOCKLEN);
+}
+
+static void SecLib_decrypt(const struct AES_key* key, uint8_t* buf)
+{
+  uint32_t out[AES_BLOCKLEN / 4];
+
+  AES_128_Decrypt(buf, (const uint8_t*)key->ks.raw, (uint8_t*)out);
+  memcpy(buf, out, AES_BLOCKLEN);
+}
+
+static void SecLib_ctr(const struct AES_key* key, uint8_t* counter, uint8_t* buf, uint32_t length)
+{
+  AES_128_CTR(buf, length, counter, (uint8_t*)key->ks.raw, buf);
+}
+
+const struct AES_backend AES_backend_seclib =
+{
+  "seclib",
+  SecLib_set_key,
+  SecLib_encrypt,
+  SecLib_decrypt,
+  SecLib_ctr,
+  0
+};
+
+#endif // #if AES_BACKEND_SECLIB == 1
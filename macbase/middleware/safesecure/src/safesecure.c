@@ -1,77 +1,170 @@
+#include <string.h>
 #include "safesecure.h"
 
-#define CRCSIZE 2
+#define CRCSIZE SAFESECURE_CRC_LEN
+
+#if (SAFESECURE_MIC_LEN < 4) || (SAFESECURE_MIC_LEN > 16) || (SAFESECURE_MIC_LEN & 1)
+#error "SAFESECURE_MIC_LEN must be 4, 6, 8, 10, 12, 14 or 16"
+#endif
 
 uint8_t key[] = { 0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
-struct AES_ctx ctx;
+// Key schedule, expanded once by SafeSecure_Init() for the backend of the build
+struct AES_key aesKey;
 ptrFnc_Transmit pTransmit;
 ptrFnc_Receive pReceive;
 uint8_t u8MaxSizePkg;
+// Frame being transmitted, maxSizePkg bytes given by the caller
+uint8_t * pu8Scratch;
+// Nonce of the authenticated mode: address of this node, next frame counter
+uint16_t u16Source;
+uint32_t u32FrameCounter;
 
-void SafeSecure_Init(ptrFnc_Transmit p_Callback, ptrFnc_Receive p_RecCallback, uint8_t maxSizePkg)
+void SafeSecure_Init(ptrFnc_Transmit p_Callback, ptrFnc_Receive p_RecCallback, uint8_t maxSizePkg, uint8_t* pScratch)
 {
 	pTransmit = p_Callback;
 	pReceive = p_RecCallback;
 	u8MaxSizePkg = maxSizePkg;
+	pu8Scratch = pScratch;
+
+	// The key schedule and the CRC table are built here, not per packet
+	AES_key_init(&aesKey, AES_BACKEND_DEFAULT, key);
+	(void)crc_16((unsigned char *)0, 0);
 }
 
 SafeSecureTransmitMsg_t SafeSecure_Transmit(uint16_t dest_address, uint8_t* data, uint8_t data_len)
 {
-	if (data_len + CRCSIZE <= u8MaxSizePkg)
+	// The cipher takes a whole block, shorter payloads are padded with zeros
+	uint8_t frameLen = (data_len < AES_BLOCKLEN) ? AES_BLOCKLEN : data_len;
+	uint16_t crc;
+
+	if ((0 == pu8Scratch) || (frameLen + CRCSIZE > u8MaxSizePkg))
 	{
-		// Create buffer
-		uint8_t * buffer = (uint8_t *)malloc(data_len + CRCSIZE);
-		memcpy(buffer, data, data_len);
-		memset(buffer, 0, data_len);
+		return SafeSecureTransmitMsg_MaxSizeExceeded;
+	}
 
-		// Encrypt AES
-		AES_init_ctx(&ctx, key);
-		AES_ECB_encrypt(&ctx, buffer);
+	memcpy(pu8Scratch, data, data_len);
+	memset(&pu8Scratch[data_len], 0, frameLen - data_len);
 
-		// CRC header at the end (2 bytes)
-		*((uint16_t*)&(buffer[data_len])) = crc_16((unsigned char *)data, data_len);
+	// Encrypt AES
+	AES_key_encrypt(&aesKey, pu8Scratch);
 
-		// Transmit
-		if (0 != pTransmit)
-		{
-			pTransmit(dest_address, data, data_len);
-		}
+	// CRC of the frame at the end (2 bytes, little endian)
+	crc = crc_16((unsigned char *)pu8Scratch, frameLen);
+	pu8Scratch[frameLen] = (uint8_t)crc;
+	pu8Scratch[frameLen + 1] = (uint8_t)(crc >> 8);
 
-		free(buffer);
+	// Transmit
+	if (0 != pTransmit)
+	{
+		pTransmit(dest_address, pu8Scratch, frameLen + CRCSIZE);
 	}
-	else return SafeSecureTransmitMsg_MaxSizeExceeded;
 
 	return SafeSecureTransmitMsg_Success;
 }
 
 SafeSecureReceiveMsg_t SafeSecure_Decrypt(uint8_t* data, uint8_t dataLen)
 {
-	if (dataLen >= CRCSIZE)
-	{
-		uint16_t currentCrc = crc_16((unsigned char *)data, dataLen);
+	uint16_t crc;
 
-		// Extract CRC from data
-		uint16_t crc = *((uint16_t *)&(data[dataLen - CRCSIZE]));
+	if (dataLen < AES_BLOCKLEN + CRCSIZE)
+	{
+		return SafeSecureReceiveMsg_CurruptData;
+	}
 
-		if (crc == currentCrc)
-		{
-			uint8_t * buffer = (uint8_t *)malloc(dataLen - CRCSIZE);
-			memcpy(buffer, data, dataLen - CRCSIZE);
+	// Extract CRC from data
+	dataLen -= CRCSIZE;
+	crc = data[dataLen] | (data[dataLen + 1] << 8);
 
-			AES_init_ctx(&ctx, key);
-			AES_ECB_decrypt(&ctx, buffer);
+	if (crc != crc_16((unsigned char *)data, dataLen))
+	{
+		return SafeSecureReceiveMsg_CurruptData;
+	}
 
-			if (0 != pReceive)
-			{
-				pReceive(buffer, dataLen);
-			}
+	// Decrypt AES in place
+	AES_key_decrypt(&aesKey, data);
 
-			free(buffer);
-		}
-		else return SafeSecureReceiveMsg_CurruptData;
+	if (0 != pReceive)
+	{
+		pReceive(data, dataLen);
 	}
-	else return SafeSecureReceiveMsg_CurruptData;
 
 	return SafeSecureReceiveMsg_Success;
 }
 
+void SafeSecure_SetSource(uint16_t src_address, uint32_t frameCounter)
+{
+	u16Source = src_address;
+	u32FrameCounter = frameCounter;
+}
+
+// Nonce of a frame: address of the sender, frame counter (as in the frame), zeros
+static void SafeSecure_Nonce(uint8_t* pNonce, uint16_t src_address, const uint8_t* pCounter)
+{
+	memset(pNonce, 0, AES_CCM_NONCE_LEN);
+	pNonce[0] = (uint8_t)src_address;
+	pNonce[1] = (uint8_t)(src_address >> 8);
+	memcpy(&pNonce[2], pCounter, SAFESECURE_CCM_HEADER_LEN);
+}
+
+SafeSecureTransmitMsg_t SafeSecure_TransmitCcm(uint16_t dest_address, uint8_t* data, uint8_t data_len)
+{
+	uint8_t nonce[AES_CCM_NONCE_LEN];
+	uint8_t* pPayload;
+
+	if ((0 == pu8Scratch) || (data_len + SAFESECURE_CCM_OVERHEAD > u8MaxSizePkg))
+	{
+		return SafeSecureTransmitMsg_MaxSizeExceeded;
+	}
+
+	pPayload = &pu8Scratch[SAFESECURE_CCM_HEADER_LEN];
+
+	// Frame counter, never used twice with the key
+	pu8Scratch[0] = (uint8_t)u32FrameCounter;
+	pu8Scratch[1] = (uint8_t)(u32FrameCounter >> 8);
+	pu8Scratch[2] = (uint8_t)(u32FrameCounter >> 16);
+	pu8Scratch[3] = (uint8_t)(u32FrameCounter >> 24);
+	u32FrameCounter++;
+
+	memcpy(pPayload, data, data_len);
+
+	// Encrypt AES-CCM, the MIC after the payload
+	SafeSecure_Nonce(nonce, u16Source, pu8Scratch);
+	AES_key_ccm(&aesKey, nonce, 0, 0, pPayload, data_len, &pPayload[data_len], SAFESECURE_MIC_LEN, 1);
+
+	// Transmit
+	if (0 != pTransmit)
+	{
+		pTransmit(dest_address, pu8Scratch, data_len + SAFESECURE_CCM_OVERHEAD);
+	}
+
+	return SafeSecureTransmitMsg_Success;
+}
+
+SafeSecureReceiveMsg_t SafeSecure_DecryptCcm(uint16_t src_address, uint8_t* data, uint8_t dataLen)
+{
+	uint8_t nonce[AES_CCM_NONCE_LEN];
+	uint8_t* pPayload = &data[SAFESECURE_CCM_HEADER_LEN];
+
+	if (dataLen < SAFESECURE_CCM_OVERHEAD)
+	{
+		return SafeSecureReceiveMsg_CurruptData;
+	}
+
+	// Decrypt AES-CCM in place and check the MIC
+	dataLen -= SAFESECURE_CCM_OVERHEAD;
+	SafeSecure_Nonce(nonce, src_address, data);
+
+	if (!AES_key_ccm(&aesKey, nonce, 0, 0, pPayload, dataLen, &pPayload[dataLen], SAFESECURE_MIC_LEN, 0))
+	{
+		// Nothing of a forged frame is handed on
+		memset(pPayload, 0, dataLen);
+		return SafeSecureReceiveMsg_CurruptData;
+	}
+
+	if (0 != pReceive)
+	{
+		pReceive(pPayload, dataLen);
+	}
+
+	return SafeSecureReceiveMsg_Success;
+}
@@ -0,0 +1,146 @@
+/************************************************************************************
+* This module contains the public interface of the event trace.
+*
+* The trace is a fixed ring of binary records: a timestamp, an event id and two
+* 32-bit arguments. Any context writes to it, the tasks as well as the ISRs, and
+* nothing ever waits: a record is reserved with one atomic increment of the head
+* and then filled in place, so a write costs a few dozen cycles and the trace can
+* stay on in production builds. Once the ring is full the oldest records are
+* overwritten.
+*
+* The ring is read after the fact: Trace_Dump() sends it through a callback (the
+* serial interface of the application), or it is read from the RAM of a halted
+* target, found by its symbol (gTraceRing) or by its magic word in a raw dump.
+* The host tool TraceDecode turns it into a timeline.
+*
+* Event ids carry their group in the high byte. The groups below are given out
+* here, each layer defines its own events in its interface (PhyInterface.h for
+* the PHY).
+*
+************************************************************************************/
+#ifndef __TRACE_H__
+#define __TRACE_H__
+
+#include "EmbeddedTypes.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+
+/*! Event trace. When disabled the TRACE() calls compile to nothing. */
+#ifndef gTraceEnabled_d
+#define gTraceEnabled_d                 (0)
+#endif
+
+/*! Records kept, 16 bytes each. A power of two, at most 32768. */
+#ifndef gTraceSize_c
+#define gTraceSize_c                    (256)
+#endif
+
+/*! First word of the ring, "TRCE" in a little endian dump */
+#define gTraceMagic_c                   (0x45435254)
+
+/*! Event ids: group in the high byte, event of the group in the low byte.
+ *  Id 0 is never written, it marks a record being filled. */
+#define gTraceId_c(group, event)        ((uint16_t)(((group) << 8) | (event)))
+#define gTraceGroup_c(id)               ((uint8_t)((id) >> 8))
+
+#define gTraceGroupPhy_c                (0x01)
+#define gTraceGroupMac_c                (0x02)
+#define gTraceGroupWrapper_c            (0x03)
+#define gTraceGroupApp_c                (0x04)
+
+/*! Sequence number and id of a record, in its tag */
+#define gTraceTagSeq_c(tag)             ((uint16_t)((tag) >> 16))
+#define gTraceTagId_c(tag)              ((uint16_t)(tag))
+
+#if gTraceEnabled_d
+#define TRACE(id, arg0, arg1)           Trace_Write((id), (uint32_t)(arg0), (uint32_t)(arg1))
+#else
+#define TRACE(id, arg0, arg1)
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+
+/*! One event. The tag holds the low 16 bits of the index of the record in its
+ *  high half and the event id in its low half, and is written last: a record
+ *  whose sequence number does not match its slot was not completed. */
+typedef struct traceRecord_tag
+{
+    uint32_t timestamp;         /* ticks of clockHz */
+    uint32_t tag;
+    uint32_t arg0;
+    uint32_t arg1;
+} traceRecord_t;
+
+/*! The ring, laid out for a raw dump: the header words, then the records.
+ *  The record of the index n is records[n % size], head is the next index. */
+typedef struct traceRing_tag
+{
+    uint32_t magic;             /* gTraceMagic_c */
+    uint32_t size;              /* gTraceSize_c */
+    uint32_t clockHz;           /* rate of the timestamps */
+    volatile uint32_t head;
+    traceRecord_t records[gTraceSize_c];
+} traceRing_t;
+
+/*! Output of Trace_Dump() */
+typedef void (*traceDumpWrite_t)(const uint8_t* pData, uint32_t length);
+
+/************************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+************************************************************************************/
+extern traceRing_t gTraceRing;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! *********************************************************************************
+* \brief  Clears the ring and starts the clock of the timestamps: the cycle
+*         counter on a Cortex-M3/M4, TMR_GetTimestamp() [us] otherwise.
+********************************************************************************** */
+void Trace_Init( void );
+
+/*! *********************************************************************************
+* \brief  Adds a record to the ring. Callable from any context, with the
+*         interrupts enabled or not. Use the TRACE() macro.
+*
+* \param[in]  id   event id, gTraceId_c()
+* \param[in]  arg0 first argument of the event
+* \param[in]  arg1 second argument of the event
+********************************************************************************** */
+void Trace_Write( uint16_t id, uint32_t arg0, uint32_t arg1 );
+
+/*! *********************************************************************************
+* \brief  Stops or restarts the recording, for example to keep the events that
+*         led to a fault until the ring is read.
+********************************************************************************** */
+void Trace_Enable( bool_t enable );
+
+/*! *********************************************************************************
+* \brief  Sends the ring, header included, through pfWrite. The recording is
+*         stopped while it runs and restored after.
+*
+* \return  the number of bytes sent
+********************************************************************************** */
+uint32_t Trace_Dump( traceDumpWrite_t pfWrite );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __TRACE_H__ */
@@ -0,0 +1,154 @@
+/************************************************************************************
+* This module contains the implementation of the event trace.
+*
+* A write reserves the next index with an atomic increment of the head (LDREX/
+* STREX on a Cortex-M3/M4, a few cycles with PRIMASK set on a Cortex-M0+), so
+* the writers never block each other and an ISR may interrupt a task in the
+* middle of its record. The record is then filled in place: the tag is cleared
+* first and written back last with the sequence number of the index, so a
+* reader can tell a record being filled, or overwritten, from a complete one.
+* The records are in the order of their index: an ISR taken between the
+* reservation and the timestamp of a record stamps its own one earlier.
+*
+* The timestamps come from the cycle counter of the DWT where there is one,
+* which is read in one cycle and wraps every 2^32 cycles (35 s at 120 MHz),
+* and from TMR_GetTimestamp() [us] otherwise. gTraceTimestamp() and
+* gTraceClockHz_c replace them.
+*
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "Trace.h"
+
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__) || defined(__ARM_ARCH_6M__)
+#include "fsl_device_registers.h"
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#if (gTraceSize_c < 2) || (gTraceSize_c > 32768) || (gTraceSize_c & (gTraceSize_c - 1))
+#error "gTraceSize_c must be a power of two within 2..32768"
+#endif
+
+#ifndef gTraceTimestamp
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define mTraceCycleCounter_d            (1)
+#define gTraceTimestamp()               (DWT->CYCCNT)
+#else
+#include "TimersManager.h"
+#define gTraceTimestamp()               ((uint32_t)TMR_GetTimestamp())
+#define gTraceClockHz_c                 (1000000)
+#endif
+#endif
+
+#ifndef mTraceCycleCounter_d
+#define mTraceCycleCounter_d            (0)
+#endif
+
+/* Keeps the compiler from moving the stores of a record across the tag */
+#define mTraceBarrier()                 __asm volatile ("" : : : "memory")
+
+/************************************************************************************
+*************************************************************************************
+* Public memory declarations
+*************************************************************************************
+************************************************************************************/
+traceRing_t gTraceRing;
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+/* Cleared until Trace_Init(), and while the ring is dumped */
+static volatile bool_t mTraceEnabled = FALSE;
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/*! *********************************************************************************
+* \brief  Clears the ring and starts the clock of the timestamps.
+********************************************************************************** */
+void Trace_Init( void )
+{
+    mTraceEnabled = FALSE;
+    FLib_MemSet( &gTraceRing, 0, sizeof(gTraceRing) );
+    gTraceRing.size = gTraceSize_c;
+
+#if mTraceCycleCounter_d
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+    gTraceRing.clockHz = SystemCoreClock;
+#else
+    gTraceRing.clockHz = gTraceClockHz_c;
+#endif
+
+    /* Last, a dump with the magic word is a ring ready to be decoded */
+    gTraceRing.magic = gTraceMagic_c;
+    mTraceEnabled = TRUE;
+}
+
+/*! *********************************************************************************
+* \brief  Adds a record to the ring.
+********************************************************************************** */
+void Trace_Write( uint16_t id, uint32_t arg0, uint32_t arg1 )
+{
+    traceRecord_t *pRecord;
+    uint32_t index;
+#if defined(__ARM_ARCH_6M__)
+    uint32_t primask;
+#endif
+
+    if( !mTraceEnabled )
+    {
+        return;
+    }
+
+#if defined(__ARM_ARCH_6M__)
+    /* No exclusive accesses on a Cortex-M0+ */
+    primask = __get_PRIMASK();
+    __disable_irq();
+    index = gTraceRing.head++;
+    __set_PRIMASK( primask );
+#else
+    index = __atomic_fetch_add( &gTraceRing.head, 1, __ATOMIC_RELAXED );
+#endif
+
+    pRecord = &gTraceRing.records[index & (gTraceSize_c - 1)];
+    pRecord->tag = 0;
+    mTraceBarrier();
+    pRecord->timestamp = gTraceTimestamp();
+    pRecord->arg0 = arg0;
+    pRecord->arg1 = arg1;
+    mTraceBarrier();
+    pRecord->tag = (index << 16) | id;
+}
+
+/*! *********************************************************************************
+* \brief  Stops or restarts the recording.
+********************************************************************************** */
+void Trace_Enable( bool_t enable )
+{
+    mTraceEnabled = (gTraceMagic_c == gTraceRing.magic) && enable;
+}
+
+/*! *********************************************************************************
+* \brief  Sends the ring through pfWrite, with the recording stopped.
+********************************************************************************** */
+uint32_t Trace_Dump( traceDumpWrite_t pfWrite )
+{
+    bool_t enabled = mTraceEnabled;
+
+    mTraceEnabled = FALSE;
+    pfWrite( (const uint8_t*)&gTraceRing, sizeof(gTraceRing) );
+    mTraceEnabled = enabled;
+
+    return sizeof(gTraceRing);
+}
@@ -0,0 +1,2086 @@
+/************************************************************************************
+* This module contains the host implementation of the MAC SAPs.
+*
+* It replaces the 802.15.4 MAC library when the upper layers are built for a
+* workstation. Each MAC instance returned by BindToMAC() is a virtual node with its
+* own PIB subset (extended/short address, PAN Id, channel, RxOnWhenIdle,
+* AssociationPermit). Requests are evaluated against the other nodes when they are
+* issued, the resulting confirms and indications are put in a time ordered event
+* list and handed to the upper layer SAP handlers by MacHost_Process().
+*
+* Modelled primitives:
+*   MLME-SET/GET (subset), MLME-RESET, MLME-SCAN (ED and active), MLME-START,
+*   MLME-ASSOCIATE request/response, MLME-COMM-STATUS, MCPS-DATA, MCPS-PURGE.
+*
+* With the radio model enabled, MCPS-DATA requests are queued per node and sent
+* with unslotted CSMA-CA. Each transmission occupies the channel for its air time,
+* the receivers decide on the frame (and the sender on the ACK) when it ends,
+* using the SINR over every frame that overlapped it on the same channel.
+* Management frames (association, beacons) only see the path loss.
+*
+* Built with gMpmMaxPANs_c 2, MAC instances 0 and 1 are the two PANs of one dual
+* PAN transceiver, as the MPM (MPM.c) makes them on the target: they share a
+* position, one frame exchange at a time and the receiver. Two PANs on the same
+* channel are both heard, as the transceiver filters the frames for both register
+* sets. Otherwise, while both PANs receive when idle, the receiver switches PAN
+* every dwell time (MPM_SetConfig()): a frame is only caught when its preamble
+* and SFD fall in a window of its PAN, after the switch settled. Frame exchanges
+* of one PAN keep the receiver away from the other.
+*
+* Built with gPhyTxTimestamps_d, MacHost.c provides PhyGetTxTimestamps() for the
+* data frames of each node, in virtual microseconds: a PD-DATA.request starts
+* with every CCA and a sequence ends with the frame or its ACK.
+*
+* Memory ownership follows the MAC library: asynchronous MLME requests are freed
+* here, MCPS data requests stay owned by the upper layer, every confirm and
+* indication is allocated from the MemManager pools and freed by the upper layer.
+*
+************************************************************************************/
+#include <math.h>
+
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "MemManager.h"
+#include "Messaging.h"
+#include "MacInterface.h"
+#include "MpmInterface.h"
+#include "PhyInterface.h"
+#include "MacHost.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mMacHostMaxPhyPacketSize_c  (127)
+#define mMacHostFcsLength_c         (2)
+
+/* aBaseSuperframeDuration [symbols] and the 2.4 GHz symbol duration [us] */
+#define mMacHostBaseSfDuration_c    (960)
+#define mMacHostSymbolTime_c        (16)
+
+#define mMacHostBroadcast_c         (0xFFFF)
+#define mMacHostNoShortAddress_c    (0xFFFE)
+
+#define mMacHostMsToUs(ms)          ((uint64_t)(ms) * 1000)
+
+/* Radio model timing [us]: 2 symbols per octet, preamble+SFD+PHR are 6 octets */
+#define mMacHostAirTime(psduLen)    ((uint32_t)((psduLen) + 6) * 2 * mMacHostSymbolTime_c)
+#define mMacHostUnitBackoff_c       (20 * mMacHostSymbolTime_c)
+#define mMacHostCcaTime_c           (8 * mMacHostSymbolTime_c)
+#define mMacHostTurnaround_c        (12 * mMacHostSymbolTime_c)
+#define mMacHostAckWait_c           (54 * mMacHostSymbolTime_c)
+/* Preamble and SFD, which the receiver must hear whole to catch a frame */
+#define mMacHostShrTime_c           (5 * 2 * mMacHostSymbolTime_c)
+#define mMacHostMaxFrameTime_c      mMacHostAirTime(mMacHostMaxPhyPacketSize_c)
+#define mMacHostAckLength_c         (5)
+#define mMacHostBeaconLength_c      (26)
+#define mMacHostAssocLength_c       (21)
+
+/* CSMA-CA defaults: macMinBE, macMaxBE, macMaxCSMABackoffs */
+#define mMacHostMinBe_c             (3)
+#define mMacHostMaxBe_c             (5)
+#define mMacHostMaxCsmaBackoffs_c   (4)
+
+#define mMacHostNoAirFrame_c        (0xFF)
+#define mMacHostNoNode_c            (0xFF)
+
+/************************************************************************************
+*************************************************************************************
+* Private data types
+*************************************************************************************
+************************************************************************************/
+typedef enum
+{
+    mMacHostEvtMcps_c,      /* deliver pMsg to the MCPS SAP of the node */
+    mMacHostEvtMlme_c,      /* deliver pMsg to the MLME SAP of the node */
+    mMacHostEvtAssocWait_c, /* association response wait time expired */
+    mMacHostEvtCca_c,       /* radio: backoff and CCA of the node are over */
+    mMacHostEvtTxEnd_c,     /* radio: last symbol of the data frame of the node */
+    mMacHostEvtAckEnd_c,    /* radio: last symbol of the ACK sent by the node */
+    mMacHostEvtAckWait_c    /* radio: macAckWaitDuration of the node expired */
+}macHostEvtType_t;
+
+typedef struct macHostEvent_tag
+{
+    uint64_t    time;
+    uint32_t    seq;        /* insertion order, breaks ties between equal times */
+    uint32_t    param;      /* radio events: transmission number, ACK destination */
+    uint8_t     node;
+    uint8_t     type;
+    void       *pMsg;
+}macHostEvent_t;
+
+/* A frame on air, kept until it can no longer overlap a frame being received */
+typedef struct macHostAirFrame_tag
+{
+    uint64_t    start;
+    uint64_t    end;
+    uint8_t     node;
+    uint8_t     channel;
+}macHostAirFrame_t;
+
+typedef struct macHostNode_tag
+{
+    bool_t                  bound;
+    instanceId_t            nwkId;
+    MCPS_NWK_SapHandler_t   pMcpsSap;
+    MLME_NWK_SapHandler_t   pMlmeSap;
+    uint64_t                extAddr;
+    uint16_t                shortAddr;
+    uint16_t                panId;
+    uint16_t                coordShortAddr;
+    logicalChannelId_t      channel;
+    bool_t                  rxOnWhenIdle;
+    bool_t                  assocPermit;
+    bool_t                  started;
+    bool_t                  assocPending;
+    uint64_t                assocPollTime;  /* time [us] the device polls its association response */
+    uint8_t                 dsn;
+    /* Radio model */
+    float                   x;
+    float                   y;
+    mcpsDataReq_t          *pTxQueue[gMacHostMaxPendingTx_c];
+    uint8_t                 txHead;
+    uint8_t                 txCount;
+    uint8_t                 nb;
+    uint8_t                 be;
+    uint8_t                 retries;
+    uint8_t                 txAir;
+    uint32_t                txSeq;
+    /* Dual PAN: the transceiver is taken by the frame exchange of the node */
+    uint64_t                radioBusyStart;
+    uint64_t                radioBusyEnd;
+#if gPhyTxTimestamps_d
+    /* PhyGetTxTimestamps(): last PD-DATA.request and last successful sequence [us] */
+    uint64_t                phyTxStart;
+    uint64_t                phyTxDone;
+#endif
+    macHostNodeStats_t      stats;
+}macHostNode_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static void ResetNode( macHostNode_t *pNode );
+static bool_t ScheduleEvent( uint64_t delay, uint8_t node, uint8_t type, void *pMsg );
+static bool_t ScheduleRadioEvent( uint64_t delay, uint8_t node, uint8_t type, uint32_t param );
+static bool_t InsertEvent( uint64_t delay, uint8_t node, uint8_t type, void *pMsg, uint32_t param );
+static bool_t EventBefore( const macHostEvent_t *pA, const macHostEvent_t *pB );
+static void PopEvent( macHostEvent_t *pEvt );
+static uint32_t FreeEventSlots( void );
+static uint32_t Random( void );
+static bool_t FrameDelivered( uint8_t from, uint8_t to, uint8_t psduLength, bool_t ackRequested, uint8_t *pAttempts );
+static uint32_t ScanChannelTime( uint8_t scanDuration );
+static uint8_t FindNodeByExtAddr( uint64_t extAddr );
+static uint8_t FindCoordinator( uint16_t panId, logicalChannelId_t channel, uint64_t address, addrModeType_t addrMode );
+static resultType_t HandleSetReq( macHostNode_t *pNode, mlmeSetReq_t *pReq );
+static resultType_t HandleGetReq( macHostNode_t *pNode, mlmeGetReq_t *pReq );
+static void HandleScanReq( uint8_t node, mlmeScanReq_t *pReq );
+static void HandleStartReq( uint8_t node, mlmeStartReq_t *pReq );
+static void HandleAssociateReq( uint8_t node, mlmeAssociateReq_t *pReq );
+static void HandleAssociateRes( uint8_t node, mlmeAssociateRes_t *pRes );
+static resultType_t HandleDataReq( uint8_t node, mcpsDataReq_t *pReq );
+static mcpsToNwkMessage_t *BuildDataInd( macHostNode_t *pNode, mcpsDataReq_t *pReq, uint8_t lqi, uint64_t rxTime );
+static bool_t IsDestination( macHostNode_t *pDst, mcpsDataReq_t *pReq, bool_t broadcast );
+static void DeliverEvent( macHostEvent_t *pEvt );
+static float RxPower( uint8_t from, uint8_t to );
+static float FramePer( float sinr, uint8_t psduLength );
+static uint8_t RxPowerToLqi( float power );
+static float ChannelEnergy( uint8_t node, uint8_t channel );
+static uint8_t AddAirFrame( uint8_t node, uint8_t channel, uint64_t start, uint32_t duration );
+static bool_t FrameReceived( uint8_t frame, uint8_t to, uint8_t psduLength, float *pRxPower );
+static resultType_t QueueDataReq( uint8_t node, mcpsDataReq_t *pReq );
+static void StartCsma( uint8_t node );
+static void ConfirmData( uint8_t node, resultType_t status );
+static void HandleCca( uint8_t node );
+static void HandleTxEnd( uint8_t node );
+static void HandleAckEnd( uint8_t node, uint8_t dst );
+static void HandleAckWait( uint8_t node );
+static uint8_t DualPanTwin( uint8_t node );
+static bool_t DualPanListens( uint8_t node, uint8_t frame );
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static macHostNode_t    mNodes[gMacHostMaxNodes_c];
+/* Binary min-heap ordered by (time, seq) */
+static macHostEvent_t   mEvents[gMacHostMaxEvents_c];
+static uint32_t         mEventCount;
+static uint32_t         mEventSeq;
+static uint64_t         mTime;
+static uint32_t         mRandState = 1;
+static bool_t           mRadioEnabled;
+static macHostRadioCfg_t mRadioCfg;
+static macHostAirFrame_t mAirFrames[gMacHostMaxAirFrames_c];
+static uint8_t          mChannelEnergy[gLogicalChannel26_c + 1];
+/* Time [us] from the end of a sequence to its MCPS-DATA.confirm (radio model) */
+static uint32_t         mConfirmDelay;
+#if gMpmIncluded_d
+static mpmConfig_t      mMpmCfg =
+{
+    .autoMode  = TRUE,
+    .dwellTime = mDualPanDwellTimerSetting( mDefaultDualPanDwellTime_c, mDefaultDualPanDwellPrescaler_c ),
+    .activeMAC = 0
+};
+/* Time [us] the dwell timer was started, with the activeMAC PAN */
+static uint64_t         mMpmEpoch;
+/* Dwell timebase [us] of each prescaler value */
+static const uint32_t   mDwellTimebase[] = { 500, 2500, 10000, 50000 };
+#endif
+static macHostLinkCfg_t mLinkCfg =
+{
+    .latency         = gMacHostDefaultLatency_c,
+    .lossPercent     = 0,
+    .maxFrameRetries = 3,
+    .linkQuality     = 0xC8
+};
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/*! *********************************************************************************
+* \brief  Initializes the host MAC: all nodes are unbound and no event is pending.
+********************************************************************************** */
+void MAC_Init( void )
+{
+    uint32_t i;
+
+    for( i = 0; i < gMacHostMaxNodes_c; i++ )
+    {
+        ResetNode( &mNodes[i] );
+        mNodes[i].bound = FALSE;
+    }
+
+    /* Confirms/indications which were never delivered are dropped */
+    while( mEventCount )
+    {
+        mEventCount--;
+        if( mEvents[mEventCount].pMsg )
+        {
+            MSG_Free( mEvents[mEventCount].pMsg );
+        }
+    }
+
+    FLib_MemSet( mAirFrames, 0, sizeof(mAirFrames) );
+}
+
+/*! *********************************************************************************
+* \brief  Creates a new virtual node. The extended address defaults to the node
+*         index + 1 until Mac_SetExtendedAddress() is called.
+********************************************************************************** */
+instanceId_t BindToMAC( instanceId_t nwkId )
+{
+    uint32_t i;
+
+    for( i = 0; i < gMacHostMaxNodes_c; i++ )
+    {
+        if( !mNodes[i].bound )
+        {
+            ResetNode( &mNodes[i] );
+            mNodes[i].bound   = TRUE;
+            mNodes[i].nwkId   = nwkId;
+            mNodes[i].extAddr = i + 1;
+            mNodes[i].x       = 0;
+            mNodes[i].y       = 0;
+            FLib_MemSet( &mNodes[i].stats, 0, sizeof(macHostNodeStats_t) );
+            return (instanceId_t)i;
+        }
+    }
+
+    return gInvalidInstanceId_c;
+}
+
+/*! *********************************************************************************
+* \brief  Removes a virtual node. Pending deliveries to it are dropped.
+********************************************************************************** */
+void UnBindFromMAC( instanceId_t macInstanceId )
+{
+    uint32_t i;
+
+    if( macInstanceId >= gMacHostMaxNodes_c )
+    {
+        return;
+    }
+
+    for( i = 0; i < mEventCount; i++ )
+    {
+        if( (mEvents[i].node == macInstanceId) && mEvents[i].pMsg )
+        {
+            MSG_Free( mEvents[i].pMsg );
+            mEvents[i].pMsg = NULL;
+        }
+    }
+
+    ResetNode( &mNodes[macInstanceId] );
+    mNodes[macInstanceId].bound = FALSE;
+}
+
+/*! *********************************************************************************
+* \brief  Returns the state of the host MAC.
+********************************************************************************** */
+macState_t Mac_GetState( void )
+{
+    return mEventCount ? gMacStateBusy_c : gMacStateIdle_c;
+}
+
+/*! *********************************************************************************
+* \brief  Registers the upper layer SAP handlers of a node.
+********************************************************************************** */
+void Mac_RegisterSapHandlers( MCPS_NWK_SapHandler_t pMCPS_NWK_SapHandler,
+                              MLME_NWK_SapHandler_t pMLME_NWK_SapHandler,
+                              instanceId_t macInstanceId )
+{
+    if( macInstanceId < gMacHostMaxNodes_c )
+    {
+        mNodes[macInstanceId].pMcpsSap = pMCPS_NWK_SapHandler;
+        mNodes[macInstanceId].pMlmeSap = pMLME_NWK_SapHandler;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Sets the extended address of a node.
+********************************************************************************** */
+void Mac_SetExtendedAddress( uint8_t *pAddr, instanceId_t macInstanceId )
+{
+    if( macInstanceId < gMacHostMaxNodes_c )
+    {
+        FLib_MemCpy( &mNodes[macInstanceId].extAddr, pAddr, sizeof(uint64_t) );
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Returns the largest MSDU for the addressing used by the request.
+********************************************************************************** */
+uint16_t Mac_GetMaxMsduLength( mcpsDataReq_t* pParams )
+{
+    uint16_t header = 3 + mMacHostFcsLength_c;
+
+    if( pParams->dstAddrMode != gAddrModeNoAddress_c )
+    {
+        header += 2 + ((pParams->dstAddrMode == gAddrModeShortAddress_c) ? 2 : 8);
+    }
+
+    if( pParams->srcAddrMode != gAddrModeNoAddress_c )
+    {
+        header += (pParams->srcAddrMode == gAddrModeShortAddress_c) ? 2 : 8;
+
+        if( (pParams->dstAddrMode == gAddrModeNoAddress_c) || (pParams->srcPanId != pParams->dstPanId) )
+        {
+            header += 2;
+        }
+    }
+
+    return mMacHostMaxPhyPacketSize_c - header;
+}
+
+/*! *********************************************************************************
+* \brief  MLME SAP entry point. SET, GET and RESET are synchronous, the other
+*         requests are answered through the event list and freed here.
+********************************************************************************** */
+resultType_t NWK_MLME_SapHandler( mlmeMessage_t* pMsg, instanceId_t macInstanceId )
+{
+    macHostNode_t *pNode;
+    resultType_t status = gSuccess_c;
+
+    if( (macInstanceId >= gMacHostMaxNodes_c) || !mNodes[macInstanceId].bound )
+    {
+        return gInvalidParameter_c;
+    }
+
+    pNode = &mNodes[macInstanceId];
+
+    switch( pMsg->msgType )
+    {
+    case gMlmeSetReq_c:
+        return HandleSetReq( pNode, &pMsg->msgData.setReq );
+
+    case gMlmeGetReq_c:
+        return HandleGetReq( pNode, &pMsg->msgData.getReq );
+
+    case gMlmeResetReq_c:
+        ResetNode( pNode );
+        return gSuccess_c;
+
+    case gMlmeScanReq_c:
+        HandleScanReq( (uint8_t)macInstanceId, &pMsg->msgData.scanReq );
+        break;
+
+    case gMlmeStartReq_c:
+        HandleStartReq( (uint8_t)macInstanceId, &pMsg->msgData.startReq );
+        break;
+
+    case gMlmeAssociateReq_c:
+        HandleAssociateReq( (uint8_t)macInstanceId, &pMsg->msgData.associateReq );
+        break;
+
+    case gMlmeAssociateRes_c:
+        HandleAssociateRes( (uint8_t)macInstanceId, &pMsg->msgData.associateRes );
+        break;
+
+    default:
+        status = gInvalidParameter_c;
+        break;
+    }
+
+    MSG_Free( pMsg );
+    return status;
+}
+
+/*! *********************************************************************************
+* \brief  MCPS SAP entry point. Data requests remain owned by the caller.
+********************************************************************************** */
+resultType_t NWK_MCPS_SapHandler( nwkToMcpsMessage_t* pMsg, instanceId_t macInstanceId )
+{
+    mcpsToNwkMessage_t *pCnf;
+
+    if( (macInstanceId >= gMacHostMaxNodes_c) || !mNodes[macInstanceId].bound )
+    {
+        return gInvalidParameter_c;
+    }
+
+    switch( pMsg->msgType )
+    {
+    case gMcpsDataReq_c:
+        return HandleDataReq( (uint8_t)macInstanceId, &pMsg->msgData.dataReq );
+
+    case gMcpsPurgeReq_c:
+        pCnf = MSG_Alloc( sizeof(mcpsToNwkMessage_t) );
+        if( NULL == pCnf )
+        {
+            return gTransactionOverflow_c;
+        }
+
+        pCnf->msgType = gMcpsPurgeCnf_c;
+        pCnf->msgData.purgeCnf.msduHandle = pMsg->msgData.purgeReq.msduHandle;
+        pCnf->msgData.purgeCnf.status = gInvalidHandle_c;
+
+        /* Only requests still waiting behind the one being sent can be purged
+           (radio model). Otherwise frames are sent directly. */
+        {
+            macHostNode_t *pNode = &mNodes[macInstanceId];
+            uint8_t i;
+
+            for( i = 1; i < pNode->txCount; i++ )
+            {
+                uint8_t pos = (pNode->txHead + i) % gMacHostMaxPendingTx_c;
+
+                if( pNode->pTxQueue[pos]->msduHandle == pMsg->msgData.purgeReq.msduHandle )
+                {
+                    for( ; i < pNode->txCount - 1; i++ )
+                    {
+                        pNode->pTxQueue[(pNode->txHead + i) % gMacHostMaxPendingTx_c] =
+                            pNode->pTxQueue[(pNode->txHead + i + 1) % gMacHostMaxPendingTx_c];
+                    }
+                    pNode->txCount--;
+                    pCnf->msgData.purgeCnf.status = gSuccess_c;
+                    break;
+                }
+            }
+        }
+        if( !ScheduleEvent( 0, (uint8_t)macInstanceId, mMacHostEvtMcps_c, pCnf ) )
+        {
+            MSG_Free( pCnf );
+            return gTransactionOverflow_c;
+        }
+        return gSuccess_c;
+
+    default:
+        return gInvalidParameter_c;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Changes the parameters of the virtual medium.
+********************************************************************************** */
+void MacHost_SetLinkConfig( const macHostLinkCfg_t *pCfg )
+{
+    mLinkCfg = *pCfg;
+
+    if( mLinkCfg.lossPercent > 100 )
+    {
+        mLinkCfg.lossPercent = 100;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Reads the parameters of the virtual medium.
+********************************************************************************** */
+void MacHost_GetLinkConfig( macHostLinkCfg_t *pCfg )
+{
+    *pCfg = mLinkCfg;
+}
+
+/*! *********************************************************************************
+* \brief  Seeds the frame loss generator.
+********************************************************************************** */
+void MacHost_SetSeed( uint32_t seed )
+{
+    mRandState = seed ? seed : 1;
+}
+
+/*! *********************************************************************************
+* \brief  Sets the energy reported by ED scans on a channel.
+********************************************************************************** */
+void MacHost_SetChannelEnergy( logicalChannelId_t channel, uint8_t energy )
+{
+    if( (channel >= gLogicalChannel11_c) && (channel <= gLogicalChannel26_c) )
+    {
+        mChannelEnergy[channel] = energy;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Enables or disables the radio model. Frames already on air keep the
+*         model they were sent with.
+********************************************************************************** */
+void MacHost_SetRadioConfig( const macHostRadioCfg_t *pCfg )
+{
+    if( NULL == pCfg )
+    {
+        mRadioEnabled = FALSE;
+        return;
+    }
+
+    mRadioCfg = *pCfg;
+    mRadioEnabled = TRUE;
+}
+
+/*! *********************************************************************************
+* \brief  Delays the MCPS-DATA.confirms of the radio model.
+********************************************************************************** */
+void MacHost_SetConfirmDelay( uint32_t delayUs )
+{
+    mConfirmDelay = delayUs;
+}
+
+/*! *********************************************************************************
+* \brief  Places a node. The two PANs of a dual PAN transceiver move together.
+********************************************************************************** */
+void MacHost_SetPosition( instanceId_t macInstanceId, float x, float y )
+{
+    uint8_t twin;
+
+    if( macInstanceId < gMacHostMaxNodes_c )
+    {
+        mNodes[macInstanceId].x = x;
+        mNodes[macInstanceId].y = y;
+
+        twin = DualPanTwin( (uint8_t)macInstanceId );
+        if( mMacHostNoNode_c != twin )
+        {
+            mNodes[twin].x = x;
+            mNodes[twin].y = y;
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Returns the PER of a link without interference.
+********************************************************************************** */
+float MacHost_GetLinkPer( instanceId_t from, instanceId_t to, uint8_t psduLength )
+{
+    float snr;
+
+    if( (from >= gMacHostMaxNodes_c) || (to >= gMacHostMaxNodes_c) )
+    {
+        return 1.0f;
+    }
+
+    if( !mRadioEnabled )
+    {
+        return mLinkCfg.lossPercent / 100.0f;
+    }
+
+    snr = powf( 10.0f, (RxPower( (uint8_t)from, (uint8_t)to ) - mRadioCfg.noiseFloor) / 10.0f );
+    return FramePer( snr, psduLength );
+}
+
+/*! *********************************************************************************
+* \brief  Reads the radio counters of a node.
+********************************************************************************** */
+void MacHost_GetNodeStats( instanceId_t macInstanceId, macHostNodeStats_t *pStats, bool_t reset )
+{
+    if( macInstanceId < gMacHostMaxNodes_c )
+    {
+        *pStats = mNodes[macInstanceId].stats;
+        if( reset )
+        {
+            FLib_MemSet( &mNodes[macInstanceId].stats, 0, sizeof(macHostNodeStats_t) );
+        }
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Advances the virtual clock and delivers the due events in time order.
+*         Requests issued by the upper layers from inside their SAP handlers are
+*         scheduled normally and delivered in the same call if they become due.
+********************************************************************************** */
+uint32_t MacHost_Process( uint32_t elapsedMs )
+{
+    return MacHost_RunUntil( mTime + mMacHostMsToUs( elapsedMs ) );
+}
+
+/*! *********************************************************************************
+* \brief  Delivers the events due up to an absolute time and sets the clock to it.
+********************************************************************************** */
+uint32_t MacHost_RunUntil( uint64_t timeUs )
+{
+    macHostEvent_t evt;
+    uint32_t delivered = 0;
+
+    while( mEventCount && (mEvents[0].time <= timeUs) )
+    {
+        PopEvent( &evt );
+        /* The clock reads the due time while the event is handled */
+        if( evt.time > mTime )
+        {
+            mTime = evt.time;
+        }
+
+        if( (NULL != evt.pMsg) || (evt.type >= mMacHostEvtAssocWait_c) )
+        {
+            DeliverEvent( &evt );
+            delivered++;
+        }
+    }
+
+    if( timeUs > mTime )
+    {
+        mTime = timeUs;
+    }
+
+    return delivered;
+}
+
+/*! *********************************************************************************
+* \brief  Returns the virtual time [ms].
+********************************************************************************** */
+uint32_t MacHost_GetTime( void )
+{
+    return (uint32_t)(mTime / 1000);
+}
+
+/*! *********************************************************************************
+* \brief  Returns the virtual time [us].
+********************************************************************************** */
+uint64_t MacHost_GetTimeUs( void )
+{
+    return mTime;
+}
+
+/*! *********************************************************************************
+* \brief  Returns the due time [ms] of the next event, rounded up.
+********************************************************************************** */
+bool_t MacHost_GetNextEventTime( uint32_t *pTime )
+{
+    if( 0 == mEventCount )
+    {
+        return FALSE;
+    }
+
+    *pTime = (uint32_t)((mEvents[0].time + 999) / 1000);
+    return TRUE;
+}
+
+/*! *********************************************************************************
+* \brief  Returns the due time [us] of the next event.
+********************************************************************************** */
+bool_t MacHost_GetNextEventTimeUs( uint64_t *pTime )
+{
+    if( 0 == mEventCount )
+    {
+        return FALSE;
+    }
+
+    *pTime = mEvents[0].time;
+    return TRUE;
+}
+
+#if gMpmIncluded_d
+/*! *********************************************************************************
+* \brief  Host version of the MPM configuration: sets the dwell time of the dual
+*         PAN transceiver, which restarts on the activeMAC PAN. As on the target,
+*         the receiver switches PAN whenever both of them receive when idle, even
+*         with autoMode FALSE.
+********************************************************************************** */
+void MPM_SetConfig( mpmConfig_t *pCfg )
+{
+    mMpmCfg = *pCfg;
+    mMpmEpoch = mTime;
+}
+
+/*! *********************************************************************************
+* \brief  Host version of the MPM configuration: reads it.
+********************************************************************************** */
+void MPM_GetConfig( mpmConfig_t *pCfg )
+{
+    *pCfg = mMpmCfg;
+}
+#endif
+
+#if gPhyTxTimestamps_d
+/*! *********************************************************************************
+* \brief  Host version of the PHY TX timestamps: the PHY instance is the node.
+********************************************************************************** */
+void PhyGetTxTimestamps( instanceId_t phyInstance, uint64_t *pTxStart, uint64_t *pTxDone )
+{
+    *pTxStart = mNodes[phyInstance].phyTxStart;
+    *pTxDone = mNodes[phyInstance].phyTxDone;
+}
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The ResetNode() function restores the PIB of a node to the values a MAC has
+ * after MLME-RESET. Binding and SAP handlers are not touched.
+ ******************************************************************************/
+static void ResetNode( macHostNode_t *pNode )
+{
+    pNode->shortAddr      = mMacHostBroadcast_c;
+    pNode->panId          = mMacHostBroadcast_c;
+    pNode->coordShortAddr = mMacHostBroadcast_c;
+    pNode->channel        = gLogicalChannel11_c;
+    pNode->rxOnWhenIdle   = FALSE;
+    pNode->assocPermit    = FALSE;
+    pNode->started        = FALSE;
+    pNode->assocPending   = FALSE;
+    /* Queued data requests are dropped and radio events in flight ignored */
+    pNode->txHead         = 0;
+    pNode->txCount        = 0;
+    pNode->txAir          = mMacHostNoAirFrame_c;
+    pNode->txSeq++;
+}
+
+/******************************************************************************
+ * The ScheduleEvent() function schedules the delivery of a message [us from
+ * now]. Events with the same due time are delivered in the order they were
+ * added.
+ ******************************************************************************/
+static bool_t ScheduleEvent( uint64_t delay, uint8_t node, uint8_t type, void *pMsg )
+{
+    return InsertEvent( delay, node, type, pMsg, 0 );
+}
+
+/******************************************************************************
+ * The ScheduleRadioEvent() function schedules an event of the radio model,
+ * which carries a parameter instead of a message.
+ ******************************************************************************/
+static bool_t ScheduleRadioEvent( uint64_t delay, uint8_t node, uint8_t type, uint32_t param )
+{
+    return InsertEvent( delay, node, type, NULL, param );
+}
+
+/******************************************************************************
+ * The InsertEvent() function adds an event to the heap.
+ ******************************************************************************/
+static bool_t InsertEvent( uint64_t delay, uint8_t node, uint8_t type, void *pMsg, uint32_t param )
+{
+    macHostEvent_t evt;
+    uint32_t pos = mEventCount;
+
+    if( mEventCount >= gMacHostMaxEvents_c )
+    {
+        return FALSE;
+    }
+
+    evt.time  = mTime + delay;
+    evt.seq   = mEventSeq++;
+    evt.param = param;
+    evt.node  = node;
+    evt.type  = type;
+    evt.pMsg  = pMsg;
+
+    /* Sift up */
+    while( pos && EventBefore( &evt, &mEvents[(pos - 1) / 2] ) )
+    {
+        mEvents[pos] = mEvents[(pos - 1) / 2];
+        pos = (pos - 1) / 2;
+    }
+
+    mEvents[pos] = evt;
+    mEventCount++;
+
+    return TRUE;
+}
+
+/******************************************************************************
+ * The EventBefore() function orders the heap by due time, then insertion.
+ ******************************************************************************/
+static bool_t EventBefore( const macHostEvent_t *pA, const macHostEvent_t *pB )
+{
+    if( pA->time != pB->time )
+    {
+        return pA->time < pB->time;
+    }
+
+    return (int32_t)(pA->seq - pB->seq) < 0;
+}
+
+/******************************************************************************
+ * The PopEvent() function removes the earliest event from the heap.
+ ******************************************************************************/
+static void PopEvent( macHostEvent_t *pEvt )
+{
+    macHostEvent_t last;
+    uint32_t pos = 0;
+    uint32_t child;
+
+    *pEvt = mEvents[0];
+    mEventCount--;
+    last = mEvents[mEventCount];
+
+    /* Sift down */
+    for( ;; )
+    {
+        child = 2 * pos + 1;
+        if( child >= mEventCount )
+        {
+            break;
+        }
+        if( (child + 1 < mEventCount) && EventBefore( &mEvents[child + 1], &mEvents[child] ) )
+        {
+            child++;
+        }
+        if( !EventBefore( &mEvents[child], &last ) )
+        {
+            break;
+        }
+        mEvents[pos] = mEvents[child];
+        pos = child;
+    }
+
+    mEvents[pos] = last;
+}
+
+/******************************************************************************
+ * The FreeEventSlots() function returns the room left in the event list.
+ ******************************************************************************/
+static uint32_t FreeEventSlots( void )
+{
+    return gMacHostMaxEvents_c - mEventCount;
+}
+
+/******************************************************************************
+ * The Random() function returns the next value [0, 0xFFFF] of the generator.
+ ******************************************************************************/
+static uint32_t Random( void )
+{
+    mRandState = mRandState * 1103515245u + 12345u;
+
+    return (mRandState >> 16) & 0xFFFF;
+}
+
+/******************************************************************************
+ * The FrameDelivered() function draws the outcome of a transmission. For
+ * acknowledged frames up to maxFrameRetries retransmissions are attempted.
+ * The number of attempts made is returned through pAttempts. The loss is the
+ * configured one, or the PER of the link when the radio model is enabled.
+ ******************************************************************************/
+static bool_t FrameDelivered( uint8_t from, uint8_t to, uint8_t psduLength, bool_t ackRequested, uint8_t *pAttempts )
+{
+    uint8_t maxAttempts = ackRequested ? (mLinkCfg.maxFrameRetries + 1) : 1;
+    uint32_t loss = mLinkCfg.lossPercent * 655;
+
+    if( mRadioEnabled )
+    {
+        loss = (uint32_t)(MacHost_GetLinkPer( from, to, psduLength ) * 65535.0f);
+    }
+
+    for( *pAttempts = 1; ; (*pAttempts)++ )
+    {
+        if( Random() >= loss )
+        {
+            return TRUE;
+        }
+
+        if( *pAttempts >= maxAttempts )
+        {
+            return FALSE;
+        }
+    }
+}
+
+/******************************************************************************
+ * The ScanChannelTime() function returns the time [ms] spent on one channel:
+ * aBaseSuperframeDuration * (2^scanDuration + 1) symbols.
+ ******************************************************************************/
+static uint32_t ScanChannelTime( uint8_t scanDuration )
+{
+    uint32_t symbols = mMacHostBaseSfDuration_c * ((1UL << (scanDuration & 0x0F)) + 1);
+
+    return (symbols * mMacHostSymbolTime_c) / 1000;
+}
+
+/******************************************************************************
+ * The FindNodeByExtAddr() function returns the index of the bound node with
+ * the given extended address, or gMacHostMaxNodes_c.
+ ******************************************************************************/
+static uint8_t FindNodeByExtAddr( uint64_t extAddr )
+{
+    uint8_t i;
+
+    for( i = 0; i < gMacHostMaxNodes_c; i++ )
+    {
+        if( mNodes[i].bound && (mNodes[i].extAddr == extAddr) )
+        {
+            break;
+        }
+    }
+
+    return i;
+}
+
+/******************************************************************************
+ * The FindCoordinator() function returns the index of the started node which
+ * runs the given PAN on the given channel and owns the given address, or
+ * gMacHostMaxNodes_c.
+ ******************************************************************************/
+static uint8_t FindCoordinator( uint16_t panId, logicalChannelId_t channel, uint64_t address, addrModeType_t addrMode )
+{
+    uint8_t i;
+
+    for( i = 0; i < gMacHostMaxNodes_c; i++ )
+    {
+        if( mNodes[i].bound && mNodes[i].started &&
+            (mNodes[i].panId == panId) && (mNodes[i].channel == channel) )
+        {
+            if( (addrMode == gAddrModeShortAddress_c) ? (mNodes[i].shortAddr == (uint16_t)address) :
+                                                        (mNodes[i].extAddr == address) )
+            {
+                break;
+            }
+        }
+    }
+
+    return i;
+}
+
+/******************************************************************************
+ * The HandleSetReq() function writes the PIB attributes the model knows about.
+ ******************************************************************************/
+static resultType_t HandleSetReq( macHostNode_t *pNode, mlmeSetReq_t *pReq )
+{
+    void *pValue = pReq->pibAttributeValue;
+
+    switch( pReq->pibAttribute )
+    {
+    case gMPibShortAddress_c:
+        FLib_MemCpy( &pNode->shortAddr, pValue, sizeof(uint16_t) );
+        break;
+    case gMPibPanId_c:
+        FLib_MemCpy( &pNode->panId, pValue, sizeof(uint16_t) );
+        break;
+    case gMPibCoordShortAddress_c:
+        FLib_MemCpy( &pNode->coordShortAddr, pValue, sizeof(uint16_t) );
+        break;
+    case gMPibExtendedAddress_c:
+        FLib_MemCpy( &pNode->extAddr, pValue, sizeof(uint64_t) );
+        break;
+    case gMPibLogicalChannel_c:
+        pNode->channel = *(uint8_t*)pValue;
+        break;
+    case gMPibRxOnWhenIdle_c:
+        pNode->rxOnWhenIdle = *(bool_t*)pValue;
+        break;
+    case gMPibAssociationPermit_c:
+        pNode->assocPermit = *(bool_t*)pValue;
+        break;
+    default:
+        return gUnsupportedAttribute_c;
+    }
+
+    return gSuccess_c;
+}
+
+/******************************************************************************
+ * The HandleGetReq() function reads the PIB attributes the model knows about.
+ ******************************************************************************/
+static resultType_t HandleGetReq( macHostNode_t *pNode, mlmeGetReq_t *pReq )
+{
+    void *pValue = pReq->pibAttributeValue;
+
+    switch( pReq->pibAttribute )
+    {
+    case gMPibShortAddress_c:
+        FLib_MemCpy( pValue, &pNode->shortAddr, sizeof(uint16_t) );
+        break;
+    case gMPibPanId_c:
+        FLib_MemCpy( pValue, &pNode->panId, sizeof(uint16_t) );
+        break;
+    case gMPibCoordShortAddress_c:
+        FLib_MemCpy( pValue, &pNode->coordShortAddr, sizeof(uint16_t) );
+        break;
+    case gMPibExtendedAddress_c:
+        FLib_MemCpy( pValue, &pNode->extAddr, sizeof(uint64_t) );
+        break;
+    case gMPibLogicalChannel_c:
+        *(uint8_t*)pValue = pNode->channel;
+        break;
+    case gMPibRxOnWhenIdle_c:
+        *(bool_t*)pValue = pNode->rxOnWhenIdle;
+        break;
+    case gMPibAssociationPermit_c:
+        *(bool_t*)pValue = pNode->assocPermit;
+        break;
+    case gMPibMaxFrameRetries_c:
+        *(uint8_t*)pValue = mLinkCfg.maxFrameRetries;
+        break;
+    default:
+        return gUnsupportedAttribute_c;
+    }
+
+    return gSuccess_c;
+}
+
+/******************************************************************************
+ * The HandleScanReq() function builds the scan confirm. An active scan
+ * returns one PAN descriptor for every started coordinator found on the
+ * scanned channels, an ED scan returns the configured channel energies. The
+ * confirm is delivered after the total scan time.
+ ******************************************************************************/
+static void HandleScanReq( uint8_t node, mlmeScanReq_t *pReq )
+{
+    nwkMessage_t *pCnf;
+    panDescriptorBlock_t *pBlock = NULL;
+    panDescriptorBlock_t *pLast = NULL;
+    panDescriptor_t *pDesc;
+    uint32_t mask = *(uint32_t*)&pReq->scanChannels;
+    uint8_t channels = 0;
+    uint8_t count = 0;
+    uint8_t attempts;
+    uint8_t ch;
+    uint8_t i;
+
+    pCnf = MSG_Alloc( sizeof(nwkMessage_t) );
+    if( NULL == pCnf )
+    {
+        return;
+    }
+
+    FLib_MemSet( pCnf, 0, sizeof(nwkMessage_t) );
+    pCnf->msgType = gMlmeScanCnf_c;
+    pCnf->msgData.scanCnf.scanType = pReq->scanType;
+    pCnf->msgData.scanCnf.channelPage = pReq->channelPage;
+    pCnf->msgData.scanCnf.status = gSuccess_c;
+
+    for( ch = gLogicalChannel11_c; ch <= gLogicalChannel26_c; ch++ )
+    {
+        if( mask & (1UL << ch) )
+        {
+            channels++;
+        }
+    }
+
+    if( pReq->scanType == gScanModeED_c )
+    {
+        uint8_t *pList = MSG_Alloc( channels ? channels : 1 );
+
+        if( NULL != pList )
+        {
+            for( ch = gLogicalChannel11_c; ch <= gLogicalChannel26_c; ch++ )
+            {
+                if( mask & (1UL << ch) )
+                {
+                    pList[count++] = mChannelEnergy[ch];
+                }
+            }
+        }
+        else
+        {
+            pCnf->msgData.scanCnf.status = gInvalidParameter_c;
+        }
+
+        pCnf->msgData.scanCnf.resList.pEnergyDetectList = pList;
+    }
+    else if( pReq->scanType == gScanModeActive_c )
+    {
+        for( i = 0; i < gMacHostMaxNodes_c; i++ )
+        {
+            macHostNode_t *pCoord = &mNodes[i];
+
+            if( (i == node) || !pCoord->bound || !pCoord->started ||
+                !(mask & (1UL << pCoord->channel)) )
+            {
+                continue;
+            }
+
+            /* The beacon answering the beacon request may be lost */
+            if( mRadioEnabled && !FrameDelivered( i, node, mMacHostBeaconLength_c, FALSE, &attempts ) )
+            {
+                continue;
+            }
+
+            if( (NULL == pLast) || (pLast->panDescriptorCount == gScanResultsPerBlock_c) )
+            {
+                panDescriptorBlock_t *pNew = MSG_Alloc( sizeof(panDescriptorBlock_t) );
+
+                if( NULL == pNew )
+                {
+                    pCnf->msgData.scanCnf.status = gLimitReached_c;
+                    break;
+                }
+
+                FLib_MemSet( pNew, 0, sizeof(panDescriptorBlock_t) );
+                if( pLast )
+                {
+                    pLast->pNext = pNew;
+                }
+                else
+                {
+                    pBlock = pNew;
+                }
+                pLast = pNew;
+            }
+
+            pDesc = &pLast->panDescriptorList[pLast->panDescriptorCount++];
+            pDesc->coordPanId = pCoord->panId;
+            pDesc->logicalChannel = pCoord->channel;
+            if( pCoord->shortAddr < mMacHostNoShortAddress_c )
+            {
+                pDesc->coordAddress = pCoord->shortAddr;
+                pDesc->coordAddrMode = gAddrModeShortAddress_c;
+            }
+            else
+            {
+                pDesc->coordAddress = pCoord->extAddr;
+                pDesc->coordAddrMode = gAddrModeExtendedAddress_c;
+            }
+            pDesc->superframeSpec.beaconOrder = 0x0F;
+            pDesc->superframeSpec.superframeOrder = 0x0F;
+            pDesc->superframeSpec.finalCapSlot = 0x0F;
+            pDesc->superframeSpec.panCoordinator = 1;
+            pDesc->superframeSpec.associationPermit = pCoord->assocPermit;
+            pDesc->linkQuality = mRadioEnabled ? RxPowerToLqi( RxPower( i, node ) ) : mLinkCfg.linkQuality;
+            count++;
+        }
+
+        if( (0 == count) && (gSuccess_c == pCnf->msgData.scanCnf.status) )
+        {
+            pCnf->msgData.scanCnf.status = gNoBeacon_c;
+        }
+
+        pCnf->msgData.scanCnf.resList.pPanDescriptorBlockList = pBlock;
+    }
+    else
+    {
+        pCnf->msgData.scanCnf.status = gInvalidParameter_c;
+    }
+
+    pCnf->msgData.scanCnf.resultListSize = count;
+
+    if( !ScheduleEvent( mMacHostMsToUs( channels * ScanChannelTime( pReq->scanDuration ) ), node, mMacHostEvtMlme_c, pCnf ) )
+    {
+        while( pBlock )
+        {
+            pLast = pBlock->pNext;
+            MSG_Free( pBlock );
+            pBlock = pLast;
+        }
+        if( (pReq->scanType == gScanModeED_c) && pCnf->msgData.scanCnf.resList.pEnergyDetectList )
+        {
+            MSG_Free( pCnf->msgData.scanCnf.resList.pEnergyDetectList );
+        }
+        MSG_Free( pCnf );
+    }
+}
+
+/******************************************************************************
+ * The HandleStartReq() function makes the node a non-beacon PAN coordinator.
+ ******************************************************************************/
+static void HandleStartReq( uint8_t node, mlmeStartReq_t *pReq )
+{
+    macHostNode_t *pNode = &mNodes[node];
+    nwkMessage_t *pCnf = MSG_Alloc( sizeof(nwkMessage_t) );
+
+    if( NULL == pCnf )
+    {
+        return;
+    }
+
+    pCnf->msgType = gMlmeStartCnf_c;
+
+    if( pNode->shortAddr == mMacHostBroadcast_c )
+    {
+        pCnf->msgData.startCnf.status = gNoShortAddress_c;
+    }
+    else if( (pReq->logicalChannel < gLogicalChannel11_c) || (pReq->logicalChannel > gLogicalChannel26_c) )
+    {
+        pCnf->msgData.startCnf.status = gInvalidParameter_c;
+    }
+    else
+    {
+        pNode->panId = pReq->panId;
+        pNode->channel = pReq->logicalChannel;
+        pNode->started = TRUE;
+        pCnf->msgData.startCnf.status = gSuccess_c;
+    }
+
+    if( !ScheduleEvent( 0, node, mMacHostEvtMlme_c, pCnf ) )
+    {
+        MSG_Free( pCnf );
+    }
+}
+
+/******************************************************************************
+ * The HandleAssociateReq() function sends the association request to the
+ * coordinator. The coordinator gets an MLME-ASSOCIATE.indication, the device
+ * polls the response gMacHostAssocWaitTime_c later. A request that is not
+ * acknowledged is confirmed with gNoAck_c.
+ ******************************************************************************/
+static void HandleAssociateReq( uint8_t node, mlmeAssociateReq_t *pReq )
+{
+    macHostNode_t *pNode = &mNodes[node];
+    nwkMessage_t *pMsg;
+    uint8_t coord;
+    uint8_t attempts;
+
+    pNode->channel = pReq->logicalChannel;
+    pNode->panId = pReq->coordPanId;
+    pNode->assocPending = TRUE;
+
+    coord = FindCoordinator( pReq->coordPanId, pReq->logicalChannel, pReq->coordAddress, pReq->coordAddrMode );
+
+    if( (coord < gMacHostMaxNodes_c) && (FreeEventSlots() >= 2) &&
+        FrameDelivered( node, coord, mMacHostAssocLength_c, TRUE, &attempts ) )
+    {
+        pMsg = MSG_Alloc( sizeof(nwkMessage_t) );
+        if( NULL != pMsg )
+        {
+            FLib_MemSet( pMsg, 0, sizeof(nwkMessage_t) );
+            pMsg->msgType = gMlmeAssociateInd_c;
+            pMsg->msgData.associateInd.deviceAddress = pNode->extAddr;
+            pMsg->msgData.associateInd.capabilityInfo = pReq->capabilityInfo;
+            (void)ScheduleEvent( mMacHostMsToUs( attempts * mLinkCfg.latency ), coord, mMacHostEvtMlme_c, pMsg );
+        }
+
+        pNode->assocPollTime = mTime + mMacHostMsToUs( attempts * mLinkCfg.latency + gMacHostAssocWaitTime_c );
+        (void)ScheduleEvent( pNode->assocPollTime - mTime, node, mMacHostEvtAssocWait_c, NULL );
+        return;
+    }
+
+    /* No coordinator answered: confirm the failure once all retries are spent */
+    pNode->assocPending = FALSE;
+    pMsg = MSG_Alloc( sizeof(nwkMessage_t) );
+    if( NULL != pMsg )
+    {
+        FLib_MemSet( pMsg, 0, sizeof(nwkMessage_t) );
+        pMsg->msgType = gMlmeAssociateCnf_c;
+        pMsg->msgData.associateCnf.assocShortAddress = mMacHostBroadcast_c;
+        pMsg->msgData.associateCnf.status = gNoAck_c;
+        if( !ScheduleEvent( mMacHostMsToUs( (mLinkCfg.maxFrameRetries + 1) * mLinkCfg.latency ), node, mMacHostEvtMlme_c, pMsg ) )
+        {
+            MSG_Free( pMsg );
+        }
+    }
+}
+
+/******************************************************************************
+ * The HandleAssociateRes() function delivers the association response to the
+ * device and reports the outcome to the coordinator through an
+ * MLME-COMM-STATUS.indication. On success the device adopts the allocated
+ * short address, the PAN Id and the coordinator short address. The response is
+ * an indirect transaction: both primitives come when the device polls it, not
+ * before its poll time.
+ ******************************************************************************/
+static void HandleAssociateRes( uint8_t node, mlmeAssociateRes_t *pRes )
+{
+    macHostNode_t *pCoord = &mNodes[node];
+    macHostNode_t *pDev;
+    nwkMessage_t *pCnf;
+    nwkMessage_t *pInd;
+    uint8_t dev = FindNodeByExtAddr( pRes->deviceAddress );
+    uint8_t attempts = mLinkCfg.maxFrameRetries + 1;
+    resultType_t status = gTransactionExpired_c;
+    uint64_t delay = 0;
+
+    if( FreeEventSlots() < 2 )
+    {
+        return;
+    }
+
+    pInd = MSG_Alloc( sizeof(nwkMessage_t) );
+    if( NULL == pInd )
+    {
+        return;
+    }
+
+    if( (dev < gMacHostMaxNodes_c) && mNodes[dev].assocPending )
+    {
+        pDev = &mNodes[dev];
+        status = gNoAck_c;
+        delay = (pDev->assocPollTime > mTime) ? (pDev->assocPollTime - mTime) : 0;
+
+        if( FrameDelivered( node, dev, mMacHostAssocLength_c + 6, TRUE, &attempts ) )
+        {
+            pCnf = MSG_Alloc( sizeof(nwkMessage_t) );
+            if( NULL != pCnf )
+            {
+                FLib_MemSet( pCnf, 0, sizeof(nwkMessage_t) );
+                pCnf->msgType = gMlmeAssociateCnf_c;
+                pCnf->msgData.associateCnf.assocShortAddress = pRes->assocShortAddress;
+                pCnf->msgData.associateCnf.status = pRes->status;
+                (void)ScheduleEvent( delay + mMacHostMsToUs( attempts * mLinkCfg.latency ), dev, mMacHostEvtMlme_c, pCnf );
+
+                pDev->assocPending = FALSE;
+                if( gSuccess_c == pRes->status )
+                {
+                    pDev->shortAddr = pRes->assocShortAddress;
+                    pDev->panId = pCoord->panId;
+                    pDev->coordShortAddr = pCoord->shortAddr;
+                }
+                status = gSuccess_c;
+            }
+        }
+    }
+
+    FLib_MemSet( pInd, 0, sizeof(nwkMessage_t) );
+    pInd->msgType = gMlmeCommStatusInd_c;
+    pInd->msgData.commStatusInd.srcAddress = pCoord->extAddr;
+    pInd->msgData.commStatusInd.srcAddrMode = gAddrModeExtendedAddress_c;
+    pInd->msgData.commStatusInd.destAddress = pRes->deviceAddress;
+    pInd->msgData.commStatusInd.destAddrMode = gAddrModeExtendedAddress_c;
+    pInd->msgData.commStatusInd.panId = pCoord->panId;
+    pInd->msgData.commStatusInd.status = status;
+    (void)ScheduleEvent( delay + mMacHostMsToUs( attempts * mLinkCfg.latency ), node, mMacHostEvtMlme_c, pInd );
+}
+
+/******************************************************************************
+ * The HandleDataReq() function transmits an MSDU. Every node on the same
+ * channel and PAN which owns the destination address (or every node for a
+ * broadcast) and has its receiver on gets an MCPS-DATA.indication. The sender
+ * gets an MCPS-DATA.confirm once the frame was acknowledged or all retries
+ * were spent. The request itself is not freed.
+ * With the radio model the request is queued and sent by StartCsma().
+ ******************************************************************************/
+static resultType_t HandleDataReq( uint8_t node, mcpsDataReq_t *pReq )
+{
+    macHostNode_t *pNode = &mNodes[node];
+    mcpsToNwkMessage_t *pCnf;
+    mcpsToNwkMessage_t *pInd;
+    bool_t broadcast = (pReq->dstAddrMode == gAddrModeShortAddress_c) && ((uint16_t)pReq->dstAddr == mMacHostBroadcast_c);
+    bool_t ackRequested = !broadcast && (pReq->txOptions & gMacTxOptionsAck_c);
+    bool_t acked = FALSE;
+    uint8_t attempts = 1;
+    uint8_t i;
+
+    if( pReq->msduLength > Mac_GetMaxMsduLength( pReq ) )
+    {
+        return gFrameTooLong_c;
+    }
+
+    if( mRadioEnabled )
+    {
+        return QueueDataReq( node, pReq );
+    }
+
+    /* Room for the confirm and at least one indication */
+    if( FreeEventSlots() < 2 )
+    {
+        return gTransactionOverflow_c;
+    }
+
+    pCnf = MSG_Alloc( sizeof(mcpsToNwkMessage_t) );
+    if( NULL == pCnf )
+    {
+        return gTransactionOverflow_c;
+    }
+
+    for( i = 0; i < gMacHostMaxNodes_c; i++ )
+    {
+        uint8_t tries;
+
+        if( (i == node) || !IsDestination( &mNodes[i], pReq, broadcast ) || (mNodes[i].channel != pNode->channel) )
+        {
+            continue;
+        }
+
+        if( !FrameDelivered( node, i, 0, ackRequested, &tries ) || (FreeEventSlots() < 2) )
+        {
+            attempts = tries;
+            continue;
+        }
+
+        pInd = BuildDataInd( pNode, pReq, mLinkCfg.linkQuality, mTime + mMacHostMsToUs( tries * mLinkCfg.latency ) );
+        if( NULL == pInd )
+        {
+            continue;
+        }
+
+        (void)ScheduleEvent( mMacHostMsToUs( tries * mLinkCfg.latency ), i, mMacHostEvtMcps_c, pInd );
+
+        attempts = tries;
+        acked = TRUE;
+    }
+
+    if( ackRequested && !acked )
+    {
+        attempts = mLinkCfg.maxFrameRetries + 1;
+    }
+
+    pNode->dsn++;
+#if gPhyTxTimestamps_d
+    /* The whole exchange is the latency, the last attempt is the sequence */
+    pNode->phyTxStart = mTime + mMacHostMsToUs( (attempts - 1) * mLinkCfg.latency );
+    if( !ackRequested || acked )
+    {
+        pNode->phyTxDone = mTime + mMacHostMsToUs( attempts * mLinkCfg.latency );
+    }
+#endif
+
+    pCnf->msgType = gMcpsDataCnf_c;
+    pCnf->msgData.dataCnf.msduHandle = pReq->msduHandle;
+    pCnf->msgData.dataCnf.status = (ackRequested && !acked) ? gNoAck_c : gSuccess_c;
+    pCnf->msgData.dataCnf.timestamp = (uint32_t)(mTime / mMacHostSymbolTime_c) & 0x00FFFFFF;
+    (void)ScheduleEvent( mMacHostMsToUs( attempts * mLinkCfg.latency ), node, mMacHostEvtMcps_c, pCnf );
+
+    return gSuccess_c;
+}
+
+/******************************************************************************
+ * The BuildDataInd() function allocates the MCPS-DATA.indication of a data
+ * request sent by pNode, received at rxTime [us].
+ ******************************************************************************/
+static mcpsToNwkMessage_t *BuildDataInd( macHostNode_t *pNode, mcpsDataReq_t *pReq, uint8_t lqi, uint64_t rxTime )
+{
+    mcpsToNwkMessage_t *pInd = MSG_Alloc( sizeof(mcpsToNwkMessage_t) + pReq->msduLength );
+
+    if( NULL == pInd )
+    {
+        return NULL;
+    }
+
+    FLib_MemSet( pInd, 0, sizeof(mcpsToNwkMessage_t) );
+    pInd->msgType = gMcpsDataInd_c;
+    pInd->msgData.dataInd.dstAddr = pReq->dstAddr;
+    pInd->msgData.dataInd.dstPanId = pReq->dstPanId;
+    pInd->msgData.dataInd.dstAddrMode = pReq->dstAddrMode;
+    pInd->msgData.dataInd.srcAddrMode = pReq->srcAddrMode;
+    pInd->msgData.dataInd.srcAddr = (pReq->srcAddrMode == gAddrModeShortAddress_c) ? pNode->shortAddr : pNode->extAddr;
+    pInd->msgData.dataInd.srcPanId = pNode->panId;
+    pInd->msgData.dataInd.msduLength = pReq->msduLength;
+    pInd->msgData.dataInd.mpduLinkQuality = lqi;
+    pInd->msgData.dataInd.dsn = pNode->dsn;
+    pInd->msgData.dataInd.timestamp = (uint32_t)(rxTime / mMacHostSymbolTime_c) & 0x00FFFFFF;
+    pInd->msgData.dataInd.pMsdu = (uint8_t*)pInd + sizeof(mcpsToNwkMessage_t);
+    FLib_MemCpy( pInd->msgData.dataInd.pMsdu, pReq->pMsdu, pReq->msduLength );
+
+    return pInd;
+}
+
+/******************************************************************************
+ * The IsDestination() function tells if a node accepts a data frame: bound,
+ * receiver on, same PAN and owner of the destination address (any address
+ * for a broadcast). The channel is checked by the callers.
+ ******************************************************************************/
+static bool_t IsDestination( macHostNode_t *pDst, mcpsDataReq_t *pReq, bool_t broadcast )
+{
+    if( !pDst->bound || (pDst->panId != pReq->dstPanId) || !(pDst->rxOnWhenIdle || pDst->started) )
+    {
+        return FALSE;
+    }
+
+    if( broadcast )
+    {
+        return TRUE;
+    }
+
+    return (pReq->dstAddrMode == gAddrModeShortAddress_c) ? (pDst->shortAddr == (uint16_t)pReq->dstAddr) :
+                                                            (pDst->extAddr == pReq->dstAddr);
+}
+
+/******************************************************************************
+ * The DeliverEvent() function hands an event to the upper layer of its node,
+ * or runs the radio model step it stands for.
+ ******************************************************************************/
+static void DeliverEvent( macHostEvent_t *pEvt )
+{
+    macHostNode_t *pNode = &mNodes[pEvt->node];
+    nwkMessage_t *pCnf;
+
+    switch( pEvt->type )
+    {
+    case mMacHostEvtMcps_c:
+        if( pNode->pMcpsSap )
+        {
+            (void)pNode->pMcpsSap( (mcpsToNwkMessage_t*)pEvt->pMsg, pNode->nwkId );
+        }
+        else
+        {
+            MSG_Free( pEvt->pMsg );
+        }
+        break;
+
+    case mMacHostEvtMlme_c:
+        if( pNode->pMlmeSap )
+        {
+            (void)pNode->pMlmeSap( (nwkMessage_t*)pEvt->pMsg, pNode->nwkId );
+        }
+        else
+        {
+            MSG_Free( pEvt->pMsg );
+        }
+        break;
+
+    case mMacHostEvtAssocWait_c:
+        if( !pNode->assocPending || !pNode->bound || (NULL == pNode->pMlmeSap) )
+        {
+            break;
+        }
+
+        pNode->assocPending = FALSE;
+        pCnf = MSG_Alloc( sizeof(nwkMessage_t) );
+        if( NULL != pCnf )
+        {
+            FLib_MemSet( pCnf, 0, sizeof(nwkMessage_t) );
+            pCnf->msgType = gMlmeAssociateCnf_c;
+            pCnf->msgData.associateCnf.assocShortAddress = mMacHostBroadcast_c;
+            pCnf->msgData.associateCnf.status = gNoData_c;
+            (void)pNode->pMlmeSap( pCnf, pNode->nwkId );
+        }
+        break;
+
+    case mMacHostEvtAckEnd_c:
+        /* The ACK is on air whatever happened to its sender since */
+        HandleAckEnd( pEvt->node, (uint8_t)pEvt->param );
+        break;
+
+    case mMacHostEvtCca_c:
+    case mMacHostEvtTxEnd_c:
+    case mMacHostEvtAckWait_c:
+        /* Stale events of a reset node or of a finished transmission */
+        if( !pNode->bound || (pEvt->param != pNode->txSeq) )
+        {
+            break;
+        }
+
+        if( pEvt->type == mMacHostEvtCca_c )
+        {
+            HandleCca( pEvt->node );
+        }
+        else if( pEvt->type == mMacHostEvtTxEnd_c )
+        {
+            HandleTxEnd( pEvt->node );
+        }
+        else
+        {
+            HandleAckWait( pEvt->node );
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+/******************************************************************************
+ * The RxPower() function returns the power [dBm] a node receives from another
+ * one, using the log-distance path loss model.
+ ******************************************************************************/
+static float RxPower( uint8_t from, uint8_t to )
+{
+    float dx = mNodes[from].x - mNodes[to].x;
+    float dy = mNodes[from].y - mNodes[to].y;
+    float d = sqrtf( dx * dx + dy * dy );
+
+    if( d < 1.0f )
+    {
+        d = 1.0f;
+    }
+
+    return mRadioCfg.txPower - mRadioCfg.refPathLoss - 10.0f * mRadioCfg.pathLossExp * log10f( d );
+}
+
+/******************************************************************************
+ * The FramePer() function returns the packet error rate of a PPDU carrying
+ * psduLength octets at the given (linear) SINR, from the 2.4 GHz O-QPSK BER
+ * of IEEE 802.15.4 annex E:
+ *   BER = 8/15 * 1/16 * sum(k=2..16) (-1)^k * C(16,k) * exp(20 * SINR * (1/k - 1))
+ ******************************************************************************/
+static float FramePer( float sinr, uint8_t psduLength )
+{
+    double ber = 0;
+    double binom = 16;  /* C(16,1) */
+    uint8_t k;
+
+    for( k = 2; k <= 16; k++ )
+    {
+        binom = binom * (16 - k + 1) / k;
+        ber += ((k & 1) ? -1.0 : 1.0) * binom * exp( 20.0 * sinr * (1.0 / k - 1.0) );
+    }
+    ber *= (8.0 / 15.0) / 16.0;
+
+    if( ber <= 0 )
+    {
+        return 0;
+    }
+    if( ber >= 0.5 )
+    {
+        return 1.0f;
+    }
+
+    return (float)(1.0 - pow( 1.0 - ber, 8.0 * (psduLength + 6) ));
+}
+
+/******************************************************************************
+ * The RxPowerToLqi() function maps -100..-20 dBm to the 0..255 LQI range.
+ ******************************************************************************/
+static uint8_t RxPowerToLqi( float power )
+{
+    float lqi = (power + 100.0f) * 255.0f / 80.0f;
+
+    if( lqi <= 0 )
+    {
+        return 0;
+    }
+
+    return (lqi >= 255.0f) ? 255 : (uint8_t)lqi;
+}
+
+/******************************************************************************
+ * The ChannelEnergy() function returns the power [dBm] a node senses on a
+ * channel now: the sum of every frame of the other nodes being on air.
+ ******************************************************************************/
+static float ChannelEnergy( uint8_t node, uint8_t channel )
+{
+    float mw = 0;
+    uint8_t i;
+
+    for( i = 0; i < gMacHostMaxAirFrames_c; i++ )
+    {
+        macHostAirFrame_t *pAir = &mAirFrames[i];
+
+        if( (pAir->end > mTime) && (pAir->start <= mTime) &&
+            (pAir->channel == channel) && (pAir->node != node) )
+        {
+            mw += powf( 10.0f, RxPower( pAir->node, node ) / 10.0f );
+        }
+    }
+
+    return (mw > 0) ? 10.0f * log10f( mw ) : -200.0f;
+}
+
+/******************************************************************************
+ * The AddAirFrame() function records a frame on air. The slot of a frame
+ * that ended long enough ago to not overlap anything any more is reused.
+ ******************************************************************************/
+static uint8_t AddAirFrame( uint8_t node, uint8_t channel, uint64_t start, uint32_t duration )
+{
+    uint8_t i;
+    uint8_t oldest = 0;
+
+    for( i = 0; i < gMacHostMaxAirFrames_c; i++ )
+    {
+        if( mAirFrames[i].end < mAirFrames[oldest].end )
+        {
+            oldest = i;
+        }
+    }
+
+    /* Out of slots only when the table is too small for the load: the frame
+       ending first is forgotten, which can only hide interference */
+    mAirFrames[oldest].start   = start;
+    mAirFrames[oldest].end     = start + duration;
+    mAirFrames[oldest].node    = node;
+    mAirFrames[oldest].channel = channel;
+
+    return oldest;
+}
+
+/******************************************************************************
+ * The FrameReceived() function decides if a frame that just ended was
+ * received by a node: the node must not have transmitted during the frame,
+ * and the frame is drawn against the PER at its SINR, counting every other
+ * frame that overlapped it on the same channel as interference.
+ ******************************************************************************/
+static bool_t FrameReceived( uint8_t frame, uint8_t to, uint8_t psduLength, float *pRxPower )
+{
+    macHostAirFrame_t *pFrame = &mAirFrames[frame];
+    float signal = RxPower( pFrame->node, to );
+    float interference = 0;
+    float per;
+    uint8_t i;
+
+    *pRxPower = signal;
+
+    for( i = 0; i < gMacHostMaxAirFrames_c; i++ )
+    {
+        macHostAirFrame_t *pAir = &mAirFrames[i];
+
+        if( (i == frame) || (pAir->channel != pFrame->channel) ||
+            (pAir->start >= pFrame->end) || (pAir->end <= pFrame->start) )
+        {
+            continue;
+        }
+
+        if( (pAir->node == to) || (pAir->node == DualPanTwin( to )) )
+        {
+            /* Half duplex, for both PANs of a dual PAN transceiver */
+            return FALSE;
+        }
+
+        interference += powf( 10.0f, RxPower( pAir->node, to ) / 10.0f );
+    }
+
+    per = FramePer( powf( 10.0f, signal / 10.0f ) /
+                    (powf( 10.0f, mRadioCfg.noiseFloor / 10.0f ) + interference), psduLength );
+
+    if( (Random() / 65535.0f) >= per )
+    {
+        return TRUE;
+    }
+
+    if( interference > 0 )
+    {
+        mNodes[to].stats.rxCollisions++;
+    }
+    else
+    {
+        mNodes[to].stats.rxErrors++;
+    }
+
+    return FALSE;
+}
+
+/******************************************************************************
+ * The QueueDataReq() function queues a data request of a node for the radio
+ * model and starts the channel access if the node was idle.
+ ******************************************************************************/
+static resultType_t QueueDataReq( uint8_t node, mcpsDataReq_t *pReq )
+{
+    macHostNode_t *pNode = &mNodes[node];
+
+    if( pNode->txCount >= gMacHostMaxPendingTx_c )
+    {
+        return gTransactionOverflow_c;
+    }
+
+    pNode->pTxQueue[(pNode->txHead + pNode->txCount) % gMacHostMaxPendingTx_c] = pReq;
+    pNode->txCount++;
+
+    if( 1 == pNode->txCount )
+    {
+        pNode->retries = 0;
+        StartCsma( node );
+    }
+
+    return gSuccess_c;
+}
+
+/******************************************************************************
+ * The StartCsma() function starts unslotted CSMA-CA for the request at the
+ * head of the queue of a node: random backoff, then CCA (HandleCca()).
+ ******************************************************************************/
+static void StartCsma( uint8_t node )
+{
+    macHostNode_t *pNode = &mNodes[node];
+
+    pNode->nb = 0;
+    pNode->be = mMacHostMinBe_c;
+    pNode->txSeq++;
+
+    if( !ScheduleRadioEvent( (Random() % (1U << pNode->be)) * mMacHostUnitBackoff_c + mMacHostCcaTime_c,
+                             node, mMacHostEvtCca_c, pNode->txSeq ) )
+    {
+        ConfirmData( node, gTransactionOverflow_c );
+    }
+}
+
+/******************************************************************************
+ * The ConfirmData() function confirms the request at the head of the queue
+ * of a node and starts the next one.
+ ******************************************************************************/
+static void ConfirmData( uint8_t node, resultType_t status )
+{
+    macHostNode_t *pNode = &mNodes[node];
+    mcpsDataReq_t *pReq = pNode->pTxQueue[pNode->txHead];
+    mcpsToNwkMessage_t *pCnf = MSG_Alloc( sizeof(mcpsToNwkMessage_t) );
+
+    pNode->txHead = (pNode->txHead + 1) % gMacHostMaxPendingTx_c;
+    pNode->txCount--;
+    pNode->txAir = mMacHostNoAirFrame_c;
+    pNode->txSeq++;
+    pNode->dsn++;
+    if( pNode->radioBusyEnd > mTime )
+    {
+        pNode->radioBusyEnd = mTime;
+    }
+#if gPhyTxTimestamps_d
+    if( gSuccess_c == status )
+    {
+        pNode->phyTxDone = mTime;
+    }
+#endif
+
+    if( NULL != pCnf )
+    {
+        pCnf->msgType = gMcpsDataCnf_c;
+        pCnf->msgData.dataCnf.msduHandle = pReq->msduHandle;
+        pCnf->msgData.dataCnf.status = status;
+        pCnf->msgData.dataCnf.timestamp = (uint32_t)(mTime / mMacHostSymbolTime_c) & 0x00FFFFFF;
+        if( !ScheduleEvent( mConfirmDelay, node, mMacHostEvtMcps_c, pCnf ) )
+        {
+            MSG_Free( pCnf );
+        }
+    }
+
+    if( pNode->txCount )
+    {
+        pNode->retries = 0;
+        StartCsma( node );
+    }
+}
+
+/******************************************************************************
+ * The HandleCca() function runs at the end of the CCA of a node. On an idle
+ * channel the frame goes on air after the RX-to-TX turnaround, otherwise the
+ * node backs off again until macMaxCSMABackoffs is exceeded.
+ ******************************************************************************/
+static void HandleCca( uint8_t node )
+{
+    macHostNode_t *pNode = &mNodes[node];
+    mcpsDataReq_t *pReq = pNode->pTxQueue[pNode->txHead];
+    uint8_t twin = DualPanTwin( node );
+    uint32_t airTime;
+
+#if gPhyTxTimestamps_d
+    /* The MAC hands the frame to the PHY after the backoff, CCA included */
+    pNode->phyTxStart = mTime - mMacHostCcaTime_c;
+#endif
+
+    /* A dual PAN transceiver busy with the other PAN fails like a busy channel */
+    if( (ChannelEnergy( node, pNode->channel ) >= mRadioCfg.ccaThreshold) ||
+        ((mMacHostNoNode_c != twin) && (mNodes[twin].radioBusyEnd > mTime)) )
+    {
+        pNode->stats.ccaBusy++;
+        pNode->nb++;
+        if( pNode->nb > mMacHostMaxCsmaBackoffs_c )
+        {
+            ConfirmData( node, gChannelAccessFailure_c );
+            return;
+        }
+
+        if( pNode->be < mMacHostMaxBe_c )
+        {
+            pNode->be++;
+        }
+
+        if( !ScheduleRadioEvent( (Random() % (1U << pNode->be)) * mMacHostUnitBackoff_c + mMacHostCcaTime_c,
+                                 node, mMacHostEvtCca_c, pNode->txSeq ) )
+        {
+            ConfirmData( node, gTransactionOverflow_c );
+        }
+        return;
+    }
+
+    /* MHR + FCS: Mac_GetMaxMsduLength() gives the room left by the header */
+    airTime = mMacHostAirTime( mMacHostMaxPhyPacketSize_c - Mac_GetMaxMsduLength( pReq ) + pReq->msduLength );
+    pNode->txAir = AddAirFrame( node, pNode->channel, mTime + mMacHostTurnaround_c, airTime );
+    pNode->stats.txFrames++;
+    pNode->radioBusyStart = mTime;
+    pNode->radioBusyEnd = mTime + mMacHostTurnaround_c + airTime +
+                          ((pReq->txOptions & gMacTxOptionsAck_c) ? mMacHostAckWait_c : 0);
+
+    if( !ScheduleRadioEvent( mMacHostTurnaround_c + airTime, node, mMacHostEvtTxEnd_c, pNode->txSeq ) )
+    {
+        ConfirmData( node, gTransactionOverflow_c );
+    }
+}
+
+/******************************************************************************
+ * The HandleTxEnd() function runs when the last symbol of a data frame was
+ * sent. Every destination that receives it gets the indication and, for
+ * acknowledged frames, sends back the ACK after the turnaround time. The
+ * sender then waits macAckWaitDuration for it.
+ ******************************************************************************/
+static void HandleTxEnd( uint8_t node )
+{
+    macHostNode_t *pNode = &mNodes[node];
+    mcpsDataReq_t *pReq = pNode->pTxQueue[pNode->txHead];
+    bool_t broadcast = (pReq->dstAddrMode == gAddrModeShortAddress_c) && ((uint16_t)pReq->dstAddr == mMacHostBroadcast_c);
+    bool_t ackRequested = !broadcast && (pReq->txOptions & gMacTxOptionsAck_c);
+    uint8_t psduLength = mMacHostMaxPhyPacketSize_c - Mac_GetMaxMsduLength( pReq ) + pReq->msduLength;
+    mcpsToNwkMessage_t *pInd;
+    float power;
+    uint8_t i;
+
+    for( i = 0; i < gMacHostMaxNodes_c; i++ )
+    {
+        if( (i == node) || !IsDestination( &mNodes[i], pReq, broadcast ) || (mNodes[i].channel != pNode->channel) )
+        {
+            continue;
+        }
+
+        if( !DualPanListens( i, pNode->txAir ) )
+        {
+            mNodes[i].stats.rxOtherPan++;
+            continue;
+        }
+
+        if( !FrameReceived( pNode->txAir, i, psduLength, &power ) )
+        {
+            continue;
+        }
+
+        mNodes[i].stats.rxFrames++;
+
+        pInd = BuildDataInd( pNode, pReq, RxPowerToLqi( power ), mTime );
+        if( (NULL != pInd) && !ScheduleEvent( 0, i, mMacHostEvtMcps_c, pInd ) )
+        {
+            MSG_Free( pInd );
+        }
+
+        if( ackRequested )
+        {
+            /* The ACK goes on air after the turnaround, no CCA */
+            (void)ScheduleRadioEvent( mMacHostTurnaround_c + mMacHostAirTime( mMacHostAckLength_c ),
+                                      i, mMacHostEvtAckEnd_c, node );
+            (void)AddAirFrame( i, pNode->channel, mTime + mMacHostTurnaround_c, mMacHostAirTime( mMacHostAckLength_c ) );
+        }
+    }
+
+    if( !ackRequested )
+    {
+        ConfirmData( node, gSuccess_c );
+    }
+    else if( !ScheduleRadioEvent( mMacHostAckWait_c, node, mMacHostEvtAckWait_c, pNode->txSeq ) )
+    {
+        ConfirmData( node, gTransactionOverflow_c );
+    }
+}
+
+/******************************************************************************
+ * The HandleAckEnd() function runs when a node finished sending an ACK to
+ * dst. A received ACK completes the pending transmission of dst.
+ ******************************************************************************/
+static void HandleAckEnd( uint8_t node, uint8_t dst )
+{
+    macHostNode_t *pDst = &mNodes[dst];
+    float power;
+    uint8_t i;
+
+    /* Only the ACK of the frame dst is waiting for, not a late or second one */
+    if( !pDst->bound || !pDst->txCount || (mMacHostNoAirFrame_c == pDst->txAir) ||
+        (mAirFrames[pDst->txAir].end + mMacHostTurnaround_c + mMacHostAirTime( mMacHostAckLength_c ) != mTime) )
+    {
+        return;
+    }
+
+    /* Find the ACK: the frame of this node which just ended */
+    for( i = 0; i < gMacHostMaxAirFrames_c; i++ )
+    {
+        if( (mAirFrames[i].node == node) && (mAirFrames[i].end == mTime) )
+        {
+            break;
+        }
+    }
+
+    if( (i < gMacHostMaxAirFrames_c) && FrameReceived( i, dst, mMacHostAckLength_c, &power ) )
+    {
+        pDst->stats.txAcked++;
+        ConfirmData( dst, gSuccess_c );
+    }
+}
+
+/******************************************************************************
+ * The HandleAckWait() function runs when no ACK was received in
+ * macAckWaitDuration. The frame is sent again, through CSMA-CA, up to
+ * macMaxFrameRetries times.
+ ******************************************************************************/
+static void HandleAckWait( uint8_t node )
+{
+    macHostNode_t *pNode = &mNodes[node];
+
+    if( pNode->retries >= mLinkCfg.maxFrameRetries )
+    {
+        ConfirmData( node, gNoAck_c );
+        return;
+    }
+
+    pNode->retries++;
+    StartCsma( node );
+}
+
+/******************************************************************************
+ * The DualPanTwin() function returns the other PAN of the dual PAN
+ * transceiver of a node, or mMacHostNoNode_c for a node with a transceiver of
+ * its own.
+ ******************************************************************************/
+static uint8_t DualPanTwin( uint8_t node )
+{
+#if gMpmIncluded_d
+    if( (node < gMpmPhyPanRegSets_c) && mNodes[node].bound && mNodes[node ^ 1].bound )
+    {
+        return node ^ 1;
+    }
+#else
+    (void)node;
+#endif
+
+    return mMacHostNoNode_c;
+}
+
+/******************************************************************************
+ * The DualPanListens() function tells if the receiver of a node was on its
+ * PAN for the preamble and SFD of a frame. The other PAN may hold the
+ * transceiver for a frame exchange, or the receiver switches PAN every dwell
+ * time and needs mMacHostTurnaround_c to settle on the channel after each
+ * switch. A frame whose SFD was heard is received whole.
+ ******************************************************************************/
+static bool_t DualPanListens( uint8_t node, uint8_t frame )
+{
+#if gMpmIncluded_d
+    macHostNode_t *pTwin;
+    uint64_t start = mAirFrames[frame].start;
+    uint64_t dwell;
+    uint64_t phase;
+    uint8_t twin = DualPanTwin( node );
+    uint8_t pan;
+
+    if( mMacHostNoNode_c == twin )
+    {
+        return TRUE;
+    }
+
+    pTwin = &mNodes[twin];
+    if( (pTwin->radioBusyStart < mAirFrames[frame].end) && (pTwin->radioBusyEnd > start) )
+    {
+        return FALSE;
+    }
+
+    /* Same channel, or the other PAN does not receive: no switching */
+    if( (pTwin->channel == mNodes[node].channel) || !(pTwin->rxOnWhenIdle || pTwin->started) )
+    {
+        return TRUE;
+    }
+
+    /* Timebase of the prescaler, times the timer value + 1 */
+    dwell = (uint64_t)(((mMpmCfg.dwellTime & mDualPanDwellTimeMask_c) >> mDualPanDwellTimeShift_c) + 1) *
+            mDwellTimebase[(mMpmCfg.dwellTime & mDualPanDwellPrescalerMask_c) >> mDualPanDwellPrescalerShift_c];
+    if( start < mMpmEpoch )
+    {
+        return (node == mMpmCfg.activeMAC);
+    }
+
+    pan = (uint8_t)((((start - mMpmEpoch) / dwell) + mMpmCfg.activeMAC) & 1);
+    phase = (start - mMpmEpoch) % dwell;
+
+    return (pan == node) && (phase >= mMacHostTurnaround_c) && (phase + mMacHostShrTime_c <= dwell);
+#else
+    (void)node;
+    (void)frame;
+    return TRUE;
+#endif
+}
@@ -0,0 +1,168 @@
+/************************************************************************************
+* This module contains the public interface of the host MAC stand-in.
+*
+* The MAC core is only delivered as a Cortex-M4 archive, so code sitting on top of
+* the MCPS/MLME SAPs cannot be run on a workstation. MacHost.c implements the SAP
+* entry points declared in MacInterface.h (MAC_Init, BindToMAC,
+* Mac_RegisterSapHandlers, NWK_MLME_SapHandler, NWK_MCPS_SapHandler, ...) on top of
+* a small in-process model: every BindToMAC() call creates a virtual node, all
+* nodes share one medium and confirms/indications are delivered after a
+* configurable latency, with a configurable frame loss.
+*
+* Optionally (MacHost_SetRadioConfig()) data frames go through a radio model
+* instead: every node has a position, frames are sent with unslotted CSMA-CA and
+* take their real air time, overlapping frames on a channel interfere and each
+* frame is received with the PER given by the SINR at the receiver (log-distance
+* path loss, 2.4 GHz O-QPSK BER). Lost frames are retried as the MAC would. Data
+* requests are then queued, so they must stay valid until their confirm.
+*
+* Built with gMpmMaxPANs_c 2, MAC instances 0 and 1 share one dual PAN transceiver
+* and MacHost.c provides MPM_SetConfig()/MPM_GetConfig() for its dwell time.
+*
+* Time is virtual. Nothing is delivered until the host calls MacHost_Process(),
+* which advances the clock and calls the registered upper layer SAP handlers from
+* the caller's context, in time order.
+*
+************************************************************************************/
+#ifndef _MAC_HOST_H_
+#define _MAC_HOST_H_
+
+#include "EmbeddedTypes.h"
+#include "MacInterface.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+
+/*! Number of virtual nodes (MAC instances) that can be bound at the same time */
+#ifndef gMacHostMaxNodes_c
+#define gMacHostMaxNodes_c          (32)
+#endif
+
+/*! Number of confirms/indications that can wait for delivery at the same time */
+#ifndef gMacHostMaxEvents_c
+#define gMacHostMaxEvents_c         (256)
+#endif
+
+/*! Time [ms] an associating device waits before it polls the association response */
+#ifndef gMacHostAssocWaitTime_c
+#define gMacHostAssocWaitTime_c     (500)
+#endif
+
+/*! Default one way latency [ms] of a frame exchange */
+#ifndef gMacHostDefaultLatency_c
+#define gMacHostDefaultLatency_c    (2)
+#endif
+
+/*! Data requests a node holds at the same time with the radio model */
+#ifndef gMacHostMaxPendingTx_c
+#define gMacHostMaxPendingTx_c      (8)
+#endif
+
+/*! Frames the radio model remembers for interference computation */
+#ifndef gMacHostMaxAirFrames_c
+#define gMacHostMaxAirFrames_c      (64)
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+
+/*! Parameters of the virtual medium, shared by all nodes */
+typedef struct macHostLinkCfg_tag
+{
+    uint32_t    latency;         /*!< One way latency [ms] of a single transmission attempt */
+    uint8_t     lossPercent;     /*!< Probability [0-100] that a single attempt is lost */
+    uint8_t     maxFrameRetries; /*!< Retransmissions before an acknowledged frame reports gNoAck_c */
+    uint8_t     linkQuality;     /*!< LQI reported in data indications and PAN descriptors */
+} macHostLinkCfg_t;
+
+/*! Parameters of the radio model, shared by all nodes */
+typedef struct macHostRadioCfg_tag
+{
+    float       txPower;         /*!< Transmit power [dBm] */
+    float       refPathLoss;     /*!< Path loss [dB] at 1 m */
+    float       pathLossExp;     /*!< Path loss exponent */
+    float       noiseFloor;      /*!< Receiver noise floor [dBm] */
+    float       ccaThreshold;    /*!< Energy [dBm] above which CCA reports a busy channel */
+} macHostRadioCfg_t;
+
+/*! Per node counters of the radio model */
+typedef struct macHostNodeStats_tag
+{
+    uint32_t    txFrames;        /*!< Data frames put on air, retransmissions included */
+    uint32_t    txAcked;         /*!< Data frames for which an ACK was received */
+    uint32_t    ccaBusy;         /*!< CCA attempts that found the channel busy */
+    uint32_t    rxFrames;        /*!< Frames addressed to this node and received */
+    uint32_t    rxCollisions;    /*!< Frames addressed to this node lost while other frames were on air */
+    uint32_t    rxErrors;        /*!< Frames addressed to this node lost to path loss alone */
+    uint32_t    rxOtherPan;      /*!< Frames addressed to this node missed while its dual PAN
+                                      transceiver was busy with the other PAN (gMpmMaxPANs_c 2) */
+} macHostNodeStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Changes the medium parameters. Frames already scheduled are not affected. */
+void MacHost_SetLinkConfig( const macHostLinkCfg_t *pCfg );
+
+/*! Reads the medium parameters. */
+void MacHost_GetLinkConfig( macHostLinkCfg_t *pCfg );
+
+/*! Seeds the pseudo random generator used for frame loss, for repeatable runs. */
+void MacHost_SetSeed( uint32_t seed );
+
+/*! Sets the energy level [0-255] reported by ED scans for a logical channel. */
+void MacHost_SetChannelEnergy( logicalChannelId_t channel, uint8_t energy );
+
+/*! Enables the radio model with the given parameters, or goes back to the
+    latency/loss model when pCfg is NULL. */
+void MacHost_SetRadioConfig( const macHostRadioCfg_t *pCfg );
+
+/*! Delays the MCPS-DATA.confirms of the radio model by delayUs [us] after the end of
+    their sequence, as the MAC task of the target takes time to report it. 0 by default. */
+void MacHost_SetConfirmDelay( uint32_t delayUs );
+
+/*! Places a node [m]. Only used by the radio model. */
+void MacHost_SetPosition( instanceId_t macInstanceId, float x, float y );
+
+/*! Returns the packet error rate of a frame sent between two nodes on a quiet channel. */
+float MacHost_GetLinkPer( instanceId_t from, instanceId_t to, uint8_t psduLength );
+
+/*! Copies and optionally clears the radio model counters of a node. */
+void MacHost_GetNodeStats( instanceId_t macInstanceId, macHostNodeStats_t *pStats, bool_t reset );
+
+/*! Advances the virtual clock by elapsedMs and delivers every confirm/indication
+    that became due. Returns the number of messages delivered to upper layers. */
+uint32_t MacHost_Process( uint32_t elapsedMs );
+
+/*! Same as MacHost_Process(), up to an absolute time [us]. */
+uint32_t MacHost_RunUntil( uint64_t timeUs );
+
+/*! Returns the virtual time [ms]. */
+uint32_t MacHost_GetTime( void );
+
+/*! Returns the virtual time [us]. */
+uint64_t MacHost_GetTimeUs( void );
+
+/*! Returns TRUE and the due time [ms] of the next scheduled event, FALSE if idle. */
+bool_t MacHost_GetNextEventTime( uint32_t *pTime );
+
+/*! Returns TRUE and the due time [us] of the next scheduled event, FALSE if idle. */
+bool_t MacHost_GetNextEventTimeUs( uint64_t *pTime );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _MAC_HOST_H_ */
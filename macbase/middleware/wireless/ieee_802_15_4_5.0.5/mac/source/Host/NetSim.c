@@ -0,0 +1,1411 @@
+/************************************************************************************
+* This module contains the host network simulator.
+*
+* The simulator is a discrete event loop over two sources: the MacHost event list
+* (confirms, indications and radio model steps) and the TMR timers of the node
+* applications. The virtual clock is the MacHost one; NetSim_Run() repeatedly
+* advances it to the earliest of the two, so a node never sees time move while it
+* runs. Nothing here depends on wall clock time, a run only depends on its seed.
+*
+* Every node application runs with its node "current": allocations made from its
+* timer callbacks and SAP handlers (and by the MAC while serving its requests) are
+* charged to it. Messages the MAC allocates on its own are charged to a separate
+* MAC bucket and move to the node they are delivered to.
+*
+* Data frames carry the index of their sender and the time their request was
+* issued, which gives the delivery latency at the receiver without any shared
+* state between nodes.
+*
+************************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "MemManager.h"
+#include "Messaging.h"
+#include "TimersManager.h"
+#include "fsl_os_abstraction.h"
+#include "MacInterface.h"
+#include "MacHost.h"
+#include "NetSim.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+
+/* Memory charged to the MAC itself */
+#define mNetSimMacBucket_c          (gNetSimMaxNodes_c)
+
+/* Sender index and request time [us] at the start of every MSDU */
+#define mNetSimPayloadHeader_c      (1 + sizeof(uint64_t))
+
+/* Log-linear histograms: 16 linear sub-buckets per power of two, up to 2^32 us */
+#define mNetSimHistSubBits_c        (4)
+#define mNetSimHistSub_c            (1 << mNetSimHistSubBits_c)
+#define mNetSimHistBins_c           (mNetSimHistSub_c * (32 - mNetSimHistSubBits_c + 1))
+
+/* Active scan of the end devices: ~138 ms per channel */
+#define mNetSimScanDuration_c       (3)
+
+#define mNetSimAllChannels_c        (0x07FFF800)
+
+/************************************************************************************
+*************************************************************************************
+* Private type definitions
+*************************************************************************************
+************************************************************************************/
+typedef enum
+{
+    mNetSimIdle_c,
+    mNetSimStarting_c,
+    mNetSimScanning_c,
+    mNetSimAssociating_c,
+    mNetSimRunning_c
+}netSimState_t;
+
+typedef struct netSimHist_tag
+{
+    uint32_t    count;
+    uint32_t    max;
+    uint32_t    bins[mNetSimHistBins_c];
+}netSimHist_t;
+
+typedef struct netSimTx_tag
+{
+    nwkToMcpsMessage_t *pMsg;
+    uint64_t            time;
+}netSimTx_t;
+
+typedef struct netSimNode_tag
+{
+    netSimNodeCfg_t     cfg;
+    instanceId_t        macId;
+    netSimState_t       state;
+    tmrTimerID_t        timer;
+    uint16_t            shortAddr;
+    uint16_t            nextShortAddr;  /* coordinator: next address to give away */
+    uint64_t            pendingAssoc[gNetSimMaxPendingAssoc_c]; /* coordinator: devices waiting for their response, 0 if free */
+    uint8_t             pendingAssocCount;
+    uint8_t             msduHandle;
+    netSimTx_t          tx[gNetSimMaxOutstanding_c];
+    uint8_t             txCount;
+    netSimNodeStats_t   stats;
+    netSimHist_t        service;
+    netSimHist_t        delivery;
+}netSimNode_t;
+
+typedef struct netSimMem_tag
+{
+    uint32_t    current;
+    uint32_t    peak;
+    uint16_t    buffers;
+    uint16_t    buffersPeak;
+    uint16_t    limit;              /* Buffers at most, 0 for no limit */
+    uint32_t    refused;
+}netSimMem_t;
+
+/* Precedes every MEM_* buffer. The list header must be last: Messaging finds it
+   right before the buffer. */
+typedef struct netSimBuffer_tag
+{
+    uint32_t        size;
+    uint8_t         owner;
+    listHeader_t    header;
+}netSimBuffer_t;
+
+typedef struct netSimTimer_tag
+{
+    bool_t          allocated;
+    bool_t          active;
+    uint8_t         type;
+    uint8_t         owner;
+    uint32_t        interval;
+    uint64_t        expire;
+    pfTmrCallBack_t pfCallback;
+    void           *param;
+}netSimTimer_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static uint8_t EnterNode( uint8_t node );
+static void Charge( void *pBuffer, uint8_t owner );
+static bool_t NextTimerExpiry( uint64_t *pTime );
+static void RunTimers( void );
+static uint32_t Random( void );
+
+static void HistAdd( netSimHist_t *pHist, uint64_t value );
+static uint32_t HistPercentile( netSimHist_t *pHist, uint8_t percent );
+static void HistRead( netSimHist_t *pHist, netSimLatency_t *pLatency );
+
+static resultType_t McpsSapHandler( mcpsToNwkMessage_t *pMsg, instanceId_t instanceId );
+static resultType_t MlmeSapHandler( nwkMessage_t *pMsg, instanceId_t instanceId );
+
+static void NodeStart( void *param );
+static void StartCoordinator( uint8_t node );
+static void StartScan( uint8_t node );
+static void HandleScanCnf( uint8_t node, mlmeScanCnf_t *pCnf );
+static void HandleAssociateInd( uint8_t node, mlmeAssociateInd_t *pInd );
+static void HandleAssociateCnf( uint8_t node, mlmeAssociateCnf_t *pCnf );
+static void HandleCommStatusInd( uint8_t node, mlmeCommStatusInd_t *pInd );
+static void FirstReport( void *param );
+static void SendReport( void *param );
+static bool_t SendFrame( netSimNode_t *pNode, uint16_t dstAddr, const uint8_t *pData, uint8_t length );
+static void HandleDataCnf( uint8_t node, mcpsDataCnf_t *pCnf );
+static void HandleDataInd( uint8_t node, mcpsDataInd_t *pInd );
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static netSimNode_t     mNodes[gNetSimMaxNodes_c];
+static uint8_t          mNodeCount;
+static netSimMem_t      mMem[gNetSimMaxNodes_c + 1];
+static netSimTimer_t    mTimers[gNetSimMaxTimers_c];
+static uint8_t          mCurrentNode = mNetSimMacBucket_c;
+static uint64_t         mStartTime;
+static uint32_t         mRandState = 1;
+static pfNetSimIdleHook_t mIdleHook;
+static pfNetSimDataHook_t mDataHook;
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/*! *********************************************************************************
+* \brief  Resets the MAC, the timers and every node, and enables the radio model.
+********************************************************************************** */
+void NetSim_Init( uint32_t seed, const macHostRadioCfg_t *pRadioCfg )
+{
+    macHostRadioCfg_t radioCfg = { 0.0f, 40.0f, 3.0f, -100.0f, -75.0f };
+    uint8_t i;
+
+    mCurrentNode = mNetSimMacBucket_c;
+
+    /* Drops the messages still owned by the MAC before the counters are cleared */
+    MAC_Init();
+    TMR_Init();
+
+    for( i = 0; i < mNodeCount; i++ )
+    {
+        while( mNodes[i].txCount )
+        {
+            MSG_Free( mNodes[i].tx[--mNodes[i].txCount].pMsg );
+        }
+    }
+
+    FLib_MemSet( mNodes, 0, sizeof(mNodes) );
+    FLib_MemSet( mMem, 0, sizeof(mMem) );
+    mNodeCount = 0;
+
+    mRandState = seed ? seed : 1;
+    MacHost_SetSeed( seed ^ 0x5A5A5A5A );
+    MacHost_SetRadioConfig( pRadioCfg ? pRadioCfg : &radioCfg );
+    mStartTime = MacHost_GetTimeUs();
+}
+
+/*! *********************************************************************************
+* \brief  Adds a node and arms its start timer.
+********************************************************************************** */
+uint8_t NetSim_AddNode( const netSimNodeCfg_t *pCfg )
+{
+    netSimNode_t *pNode;
+    uint8_t node = mNodeCount;
+    uint8_t prev;
+
+    if( node >= gNetSimMaxNodes_c )
+    {
+        return gNetSimInvalidNode_c;
+    }
+
+    pNode = &mNodes[node];
+    FLib_MemSet( pNode, 0, sizeof(netSimNode_t) );
+    FLib_MemCpy( &pNode->cfg, (void*)pCfg, sizeof(netSimNodeCfg_t) );
+    if( pNode->cfg.payloadLength < mNetSimPayloadHeader_c )
+    {
+        pNode->cfg.payloadLength = mNetSimPayloadHeader_c;
+    }
+    if( (0 == pNode->cfg.maxPendingAssoc) || (pNode->cfg.maxPendingAssoc > gNetSimMaxPendingAssoc_c) )
+    {
+        pNode->cfg.maxPendingAssoc = gNetSimMaxPendingAssoc_c;
+    }
+    pNode->stats.associated = 0xFFFFFFFF;
+
+    /* The node index is the nwkId, so the SAP handlers know who they serve */
+    pNode->macId = BindToMAC( node );
+    if( gInvalidInstanceId_c == pNode->macId )
+    {
+        return gNetSimInvalidNode_c;
+    }
+
+    prev = EnterNode( node );
+    pNode->timer = TMR_AllocateTimer();
+    if( gTmrInvalidTimerID_c == pNode->timer )
+    {
+        (void)EnterNode( prev );
+        return gNetSimInvalidNode_c;
+    }
+
+    Mac_RegisterSapHandlers( McpsSapHandler, MlmeSapHandler, pNode->macId );
+    MacHost_SetPosition( pNode->macId, pCfg->x, pCfg->y );
+    (void)TMR_StartSingleShotTimer( pNode->timer, pCfg->startDelay, NodeStart, pNode );
+    (void)EnterNode( prev );
+
+    mNodeCount++;
+    return node;
+}
+
+/*! *********************************************************************************
+* \brief  Runs the event loop for durationMs of virtual time.
+********************************************************************************** */
+void NetSim_Run( uint32_t durationMs )
+{
+    uint64_t end = MacHost_GetTimeUs() + (uint64_t)durationMs * 1000;
+    uint64_t next;
+    uint64_t time;
+
+    do
+    {
+        if( NULL != mIdleHook )
+        {
+            mCurrentNode = mNetSimMacBucket_c;
+            mIdleHook();
+        }
+
+        next = end;
+
+        if( MacHost_GetNextEventTimeUs( &time ) && (time < next) )
+        {
+            next = time;
+        }
+
+        if( NextTimerExpiry( &time ) && (time < next) )
+        {
+            next = time;
+        }
+
+        mCurrentNode = mNetSimMacBucket_c;
+        (void)MacHost_RunUntil( next );
+        RunTimers();
+    }
+    while( next < end );
+
+    if( NULL != mIdleHook )
+    {
+        mCurrentNode = mNetSimMacBucket_c;
+        mIdleHook();
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Sets the function called before the clock advances.
+********************************************************************************** */
+void NetSim_SetIdleHook( pfNetSimIdleHook_t pfHook )
+{
+    mIdleHook = pfHook;
+}
+
+/*! *********************************************************************************
+* \brief  Sets the function called with every data frame received.
+********************************************************************************** */
+void NetSim_SetDataHook( pfNetSimDataHook_t pfHook )
+{
+    mDataHook = pfHook;
+}
+
+/*! *********************************************************************************
+* \brief  Sends one acknowledged data frame from a node.
+********************************************************************************** */
+bool_t NetSim_SendData( uint8_t node, uint16_t dstAddr, const uint8_t *pData, uint8_t length )
+{
+    uint8_t prev;
+    bool_t sent;
+
+    if( (node >= mNodeCount) || (NULL == pData) || (0 == length) )
+    {
+        return FALSE;
+    }
+
+    prev = EnterNode( node );
+    sent = SendFrame( &mNodes[node], dstAddr, pData, length );
+    (void)EnterNode( prev );
+    return sent;
+}
+
+/*! *********************************************************************************
+* \brief  Limits the buffers charged to a node at the same time.
+********************************************************************************** */
+void NetSim_SetMemLimit( uint8_t node, uint16_t maxBuffers )
+{
+    if( node <= gNetSimMaxNodes_c )
+    {
+        mMem[node].limit = maxBuffers;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Returns the virtual time [us].
+********************************************************************************** */
+uint64_t NetSim_GetTimeUs( void )
+{
+    return MacHost_GetTimeUs();
+}
+
+/*! *********************************************************************************
+* \brief  Computes the results of a node.
+********************************************************************************** */
+void NetSim_GetNodeStats( uint8_t node, netSimNodeStats_t *pStats )
+{
+    netSimNode_t *pNode;
+    uint64_t elapsed = MacHost_GetTimeUs() - mStartTime;
+
+    if( node > gNetSimMaxNodes_c )
+    {
+        return;
+    }
+
+    if( node < gNetSimMaxNodes_c )
+    {
+        pNode = &mNodes[node];
+        FLib_MemCpy( pStats, &pNode->stats, sizeof(netSimNodeStats_t) );
+        pStats->rxThroughput = elapsed ? (uint32_t)((uint64_t)pNode->stats.rxBytes * 8 * 1000000 / elapsed) : 0;
+        HistRead( &pNode->service, &pStats->serviceLatency );
+        HistRead( &pNode->delivery, &pStats->deliveryLatency );
+        if( node < mNodeCount )
+        {
+            MacHost_GetNodeStats( pNode->macId, &pStats->radio, FALSE );
+        }
+    }
+    else
+    {
+        FLib_MemSet( pStats, 0, sizeof(netSimNodeStats_t) );
+    }
+
+    pStats->memCurrent     = mMem[node].current;
+    pStats->memPeak        = mMem[node].peak;
+    pStats->buffersCurrent = mMem[node].buffers;
+    pStats->buffersPeak    = mMem[node].buffersPeak;
+    pStats->buffersRefused = mMem[node].refused;
+}
+
+/*! *********************************************************************************
+* \brief  Prints the results of every node and the totals.
+********************************************************************************** */
+void NetSim_PrintReport( void )
+{
+    netSimNodeStats_t stats;
+    uint64_t elapsed = MacHost_GetTimeUs() - mStartTime;
+    uint32_t requests = 0;
+    uint32_t delivered = 0;
+    uint64_t rxBytes = 0;
+    uint32_t devices = 0;
+    uint32_t associated = 0;
+    uint32_t lastAssoc = 0;
+    uint8_t i;
+
+    printf( "time %.3f s, %u nodes\n", elapsed / 1e6, mNodeCount );
+    printf( "node role  pan  ch  assoc_ms   tx_req    ok noack cafail  rej   rx_frm  rx_bps"
+            "   svc_p50/p90/p99/max [ms]      dlv_p50/p90/p99/max [ms]      mem_peak bufs cca_busy coll err\n" );
+
+    for( i = 0; i < mNodeCount; i++ )
+    {
+        NetSim_GetNodeStats( i, &stats );
+
+        requests  += stats.txRequests;
+        delivered += stats.deliveryLatency.count;
+        rxBytes   += stats.rxBytes;
+
+        if( gNetSimEndDevice_c == mNodes[i].cfg.role )
+        {
+            devices++;
+            if( stats.associated != 0xFFFFFFFF )
+            {
+                associated++;
+                if( stats.associated > lastAssoc )
+                {
+                    lastAssoc = stats.associated;
+                }
+            }
+        }
+
+        printf( "%4u %-4s %04X %2u %9.1f %8u %5u %5u %6u %4u %8u %7u"
+                " %6.2f/%6.2f/%6.2f/%7.2f %6.2f/%6.2f/%6.2f/%7.2f %9u %4u %8u %4u %3u\n",
+                i, (mNodes[i].cfg.role == gNetSimCoordinator_c) ? "crd" : "dev",
+                mNodes[i].cfg.panId, mNodes[i].cfg.channel,
+                (stats.associated == 0xFFFFFFFF) ? -1.0 : stats.associated / 1.0,
+                stats.txRequests, stats.txSuccess, stats.txNoAck, stats.txChannelAccessFailure, stats.txRejected,
+                stats.rxFrames, stats.rxThroughput,
+                stats.serviceLatency.p50 / 1e3, stats.serviceLatency.p90 / 1e3,
+                stats.serviceLatency.p99 / 1e3, stats.serviceLatency.max / 1e3,
+                stats.deliveryLatency.p50 / 1e3, stats.deliveryLatency.p90 / 1e3,
+                stats.deliveryLatency.p99 / 1e3, stats.deliveryLatency.max / 1e3,
+                stats.memPeak, stats.buffersPeak,
+                stats.radio.ccaBusy, stats.radio.rxCollisions, stats.radio.rxErrors );
+    }
+
+    NetSim_GetNodeStats( mNetSimMacBucket_c, &stats );
+    printf( "MAC memory peak %u bytes, %u buffers\n", stats.memPeak, stats.buffersPeak );
+    printf( "total: %u requests, %u delivered (%.1f %%), %.0f bps received\n",
+            requests, delivered, requests ? 100.0 * delivered / requests : 0.0,
+            elapsed ? rxBytes * 8e6 / elapsed : 0.0 );
+    printf( "associated: %u/%u end devices, last at %u ms\n", associated, devices, lastAssoc );
+}
+
+/************************************************************************************
+*************************************************************************************
+* Host framework services
+*************************************************************************************
+************************************************************************************/
+
+/*! *********************************************************************************
+* \brief  Frees every timer.
+********************************************************************************** */
+void TMR_Init( void )
+{
+    FLib_MemSet( mTimers, 0, sizeof(mTimers) );
+}
+
+/*! *********************************************************************************
+* \brief  Reserves a timer.
+********************************************************************************** */
+tmrTimerID_t TMR_AllocateTimer( void )
+{
+    uint32_t i;
+
+    for( i = 0; i < gNetSimMaxTimers_c; i++ )
+    {
+        if( !mTimers[i].allocated )
+        {
+            FLib_MemSet( &mTimers[i], 0, sizeof(netSimTimer_t) );
+            mTimers[i].allocated = TRUE;
+            mTimers[i].owner = mCurrentNode;
+            return (tmrTimerID_t)i;
+        }
+    }
+
+    return gTmrInvalidTimerID_c;
+}
+
+/*! *********************************************************************************
+* \brief  Stops and releases a timer.
+********************************************************************************** */
+tmrErrCode_t TMR_FreeTimer( tmrTimerID_t timerID )
+{
+    if( (timerID >= gNetSimMaxTimers_c) || !mTimers[timerID].allocated )
+    {
+        return gTmrInvalidId_c;
+    }
+
+    mTimers[timerID].allocated = FALSE;
+    mTimers[timerID].active = FALSE;
+    return gTmrSuccess_c;
+}
+
+/*! *********************************************************************************
+* \brief  Starts a timer on the virtual clock. The callback runs with the node that
+*         started the timer current.
+********************************************************************************** */
+tmrErrCode_t TMR_StartTimer( tmrTimerID_t timerID, tmrTimerType_t timerType, tmrTimeInMilliseconds_t timeInMilliseconds,
+                             pfTmrCallBack_t callback, void *param )
+{
+    netSimTimer_t *pTimer;
+
+    if( (timerID >= gNetSimMaxTimers_c) || !mTimers[timerID].allocated )
+    {
+        return gTmrInvalidId_c;
+    }
+
+    pTimer = &mTimers[timerID];
+    pTimer->type       = timerType;
+    pTimer->owner      = mCurrentNode;
+    pTimer->interval   = timeInMilliseconds;
+    pTimer->expire     = MacHost_GetTimeUs() + (uint64_t)timeInMilliseconds * 1000;
+    pTimer->pfCallback = callback;
+    pTimer->param      = param;
+    pTimer->active     = TRUE;
+
+    return gTmrSuccess_c;
+}
+
+/*! *********************************************************************************
+* \brief  Low power timers behave as regular timers on the host.
+********************************************************************************** */
+tmrErrCode_t TMR_StartLowPowerTimer( tmrTimerID_t timerId, tmrTimerType_t timerType, uint32_t time,
+                                     pfTmrCallBack_t callback, void *param )
+{
+    return TMR_StartTimer( timerId, timerType | gTmrLowPowerTimer_c, time, callback, param );
+}
+
+/*! *********************************************************************************
+* \brief  Starts a single shot timer.
+********************************************************************************** */
+tmrErrCode_t TMR_StartSingleShotTimer( tmrTimerID_t timerID, tmrTimeInMilliseconds_t timeInMilliseconds,
+                                       pfTmrCallBack_t callback, void *param )
+{
+    return TMR_StartTimer( timerID, gTmrSingleShotTimer_c, timeInMilliseconds, callback, param );
+}
+
+/*! *********************************************************************************
+* \brief  Starts an interval timer.
+********************************************************************************** */
+tmrErrCode_t TMR_StartIntervalTimer( tmrTimerID_t timerID, tmrTimeInMilliseconds_t timeInMilliseconds,
+                                     pfTmrCallBack_t callback, void *param )
+{
+    return TMR_StartTimer( timerID, gTmrIntervalTimer_c, timeInMilliseconds, callback, param );
+}
+
+/*! *********************************************************************************
+* \brief  Stops a timer.
+********************************************************************************** */
+tmrErrCode_t TMR_StopTimer( tmrTimerID_t timerID )
+{
+    if( (timerID >= gNetSimMaxTimers_c) || !mTimers[timerID].allocated )
+    {
+        return gTmrInvalidId_c;
+    }
+
+    mTimers[timerID].active = FALSE;
+    return gTmrSuccess_c;
+}
+
+/*! *********************************************************************************
+* \brief  Tells if a timer is running.
+********************************************************************************** */
+bool_t TMR_IsTimerActive( tmrTimerID_t timerID )
+{
+    return (timerID < gNetSimMaxTimers_c) && mTimers[timerID].active;
+}
+
+/*! *********************************************************************************
+* \brief  Callbacks run as soon as their timer expires, so no timer is ever ready.
+********************************************************************************** */
+bool_t TMR_IsTimerReady( tmrTimerID_t timerID )
+{
+    (void)timerID;
+    return FALSE;
+}
+
+/*! *********************************************************************************
+* \brief  Returns the time [ms] left before a timer expires.
+********************************************************************************** */
+uint32_t TMR_GetRemainingTime( tmrTimerID_t tmrID )
+{
+    uint64_t now = MacHost_GetTimeUs();
+
+    if( !TMR_IsTimerActive( tmrID ) || (mTimers[tmrID].expire <= now) )
+    {
+        return 0;
+    }
+
+    return (uint32_t)((mTimers[tmrID].expire - now + 999) / 1000);
+}
+
+/*! *********************************************************************************
+* \brief  Tells if no timer is running.
+********************************************************************************** */
+bool_t TMR_AreAllTimersOff( void )
+{
+    uint64_t time;
+
+    return !NextTimerExpiry( &time );
+}
+
+/*! *********************************************************************************
+* \brief  Returns the virtual time [us].
+********************************************************************************** */
+uint64_t TMR_GetTimestamp( void )
+{
+    return MacHost_GetTimeUs();
+}
+
+/*! *********************************************************************************
+* \brief  Returns the virtual time [ms].
+********************************************************************************** */
+uint32_t OSA_TimeGetMsec( void )
+{
+    return (uint32_t)(MacHost_GetTimeUs() / 1000);
+}
+
+/*! *********************************************************************************
+* \brief  Nothing to do: buffers come from the host heap.
+********************************************************************************** */
+memStatus_t MEM_Init( void )
+{
+    return MEM_SUCCESS_c;
+}
+
+/*! *********************************************************************************
+* \brief  Allocates a buffer from the host heap and charges it to the current node,
+*         within the limit of the node.
+********************************************************************************** */
+void* MEM_BufferAllocWithId( uint32_t numBytes, uint8_t poolId, void *pCaller )
+{
+    netSimBuffer_t *pBuf;
+
+    (void)poolId;
+    (void)pCaller;
+
+    if( mMem[mCurrentNode].limit && (mMem[mCurrentNode].buffers >= mMem[mCurrentNode].limit) )
+    {
+        mMem[mCurrentNode].refused++;
+        return NULL;
+    }
+
+    pBuf = malloc( sizeof(netSimBuffer_t) + numBytes );
+    if( NULL == pBuf )
+    {
+        return NULL;
+    }
+
+    FLib_MemSet( pBuf, 0, sizeof(netSimBuffer_t) );
+    pBuf->size  = numBytes;
+    pBuf->owner = mCurrentNode;
+
+    mMem[pBuf->owner].current += numBytes;
+    mMem[pBuf->owner].buffers++;
+    if( mMem[pBuf->owner].current > mMem[pBuf->owner].peak )
+    {
+        mMem[pBuf->owner].peak = mMem[pBuf->owner].current;
+    }
+    if( mMem[pBuf->owner].buffers > mMem[pBuf->owner].buffersPeak )
+    {
+        mMem[pBuf->owner].buffersPeak = mMem[pBuf->owner].buffers;
+    }
+
+    return pBuf + 1;
+}
+
+/*! *********************************************************************************
+* \brief  Returns a buffer to the host heap.
+********************************************************************************** */
+memStatus_t MEM_BufferFree( void* buffer )
+{
+    netSimBuffer_t *pBuf = (netSimBuffer_t*)buffer - 1;
+
+    if( NULL == buffer )
+    {
+        return MEM_FREE_ERROR_c;
+    }
+
+    mMem[pBuf->owner].current -= pBuf->size;
+    mMem[pBuf->owner].buffers--;
+    free( pBuf );
+
+    return MEM_SUCCESS_c;
+}
+
+/*! *********************************************************************************
+* \brief  Returns the size requested for a buffer.
+********************************************************************************** */
+uint16_t MEM_BufferGetSize( void* buffer )
+{
+    return buffer ? (uint16_t)((netSimBuffer_t*)buffer - 1)->size : 0;
+}
+
+/*! *********************************************************************************
+* \brief  The host heap is not split in pools.
+********************************************************************************** */
+uint32_t MEM_GetAvailableBlocks( uint32_t size )
+{
+    (void)size;
+    return 0xFFFF;
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The EnterNode() function makes a node (or the MAC bucket) current and
+ * returns the previous one.
+ ******************************************************************************/
+static uint8_t EnterNode( uint8_t node )
+{
+    uint8_t prev = mCurrentNode;
+
+    mCurrentNode = node;
+    return prev;
+}
+
+/******************************************************************************
+ * The Charge() function moves a buffer to another owner.
+ ******************************************************************************/
+static void Charge( void *pBuffer, uint8_t owner )
+{
+    netSimBuffer_t *pBuf = (netSimBuffer_t*)pBuffer - 1;
+
+    if( (NULL == pBuffer) || (pBuf->owner == owner) )
+    {
+        return;
+    }
+
+    mMem[pBuf->owner].current -= pBuf->size;
+    mMem[pBuf->owner].buffers--;
+    mMem[owner].current += pBuf->size;
+    mMem[owner].buffers++;
+    if( mMem[owner].current > mMem[owner].peak )
+    {
+        mMem[owner].peak = mMem[owner].current;
+    }
+    if( mMem[owner].buffers > mMem[owner].buffersPeak )
+    {
+        mMem[owner].buffersPeak = mMem[owner].buffers;
+    }
+    pBuf->owner = owner;
+}
+
+/******************************************************************************
+ * The NextTimerExpiry() function returns the earliest expiry of the running
+ * timers.
+ ******************************************************************************/
+static bool_t NextTimerExpiry( uint64_t *pTime )
+{
+    bool_t found = FALSE;
+    uint32_t i;
+
+    for( i = 0; i < gNetSimMaxTimers_c; i++ )
+    {
+        if( mTimers[i].active && (!found || (mTimers[i].expire < *pTime)) )
+        {
+            *pTime = mTimers[i].expire;
+            found = TRUE;
+        }
+    }
+
+    return found;
+}
+
+/******************************************************************************
+ * The RunTimers() function calls back every timer that expired, earliest
+ * first. Interval timers are rearmed before their callback runs.
+ ******************************************************************************/
+static void RunTimers( void )
+{
+    uint64_t now = MacHost_GetTimeUs();
+    netSimTimer_t *pTimer;
+    uint32_t i;
+    uint8_t prev;
+
+    for( ;; )
+    {
+        pTimer = NULL;
+        for( i = 0; i < gNetSimMaxTimers_c; i++ )
+        {
+            if( mTimers[i].active && (mTimers[i].expire <= now) &&
+                ((NULL == pTimer) || (mTimers[i].expire < pTimer->expire)) )
+            {
+                pTimer = &mTimers[i];
+            }
+        }
+
+        if( NULL == pTimer )
+        {
+            break;
+        }
+
+        if( (pTimer->type & gTmrIntervalTimer_c) && pTimer->interval )
+        {
+            pTimer->expire += (uint64_t)pTimer->interval * 1000;
+        }
+        else
+        {
+            pTimer->active = FALSE;
+        }
+
+        prev = EnterNode( pTimer->owner );
+        pTimer->pfCallback( pTimer->param );
+        (void)EnterNode( prev );
+    }
+}
+
+/******************************************************************************
+ * The Random() function returns 31 pseudo random bits (Park-Miller).
+ ******************************************************************************/
+static uint32_t Random( void )
+{
+    mRandState = (uint32_t)(((uint64_t)mRandState * 48271) % 0x7FFFFFFF);
+    return mRandState;
+}
+
+/******************************************************************************
+ * The HistAdd() function records a latency [us]. Values below 16 have their
+ * own bin, above that every power of two is split in 16 equal bins (6 %
+ * resolution).
+ ******************************************************************************/
+static void HistAdd( netSimHist_t *pHist, uint64_t value )
+{
+    uint32_t v = (value > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32_t)value;
+    uint32_t bin = v;
+    uint8_t msb;
+
+    if( v >= mNetSimHistSub_c )
+    {
+        msb = 31 - __builtin_clz( v );
+        bin = mNetSimHistSub_c * (msb - mNetSimHistSubBits_c + 1) +
+              ((v >> (msb - mNetSimHistSubBits_c)) & (mNetSimHistSub_c - 1));
+    }
+
+    pHist->bins[bin]++;
+    pHist->count++;
+    if( v > pHist->max )
+    {
+        pHist->max = v;
+    }
+}
+
+/******************************************************************************
+ * The HistPercentile() function returns the upper bound of the bin holding
+ * the given percentile, capped to the largest value seen.
+ ******************************************************************************/
+static uint32_t HistPercentile( netSimHist_t *pHist, uint8_t percent )
+{
+    uint32_t rank = (uint32_t)(((uint64_t)pHist->count * percent + 99) / 100);
+    uint32_t sum = 0;
+    uint32_t bin;
+    uint32_t octave;
+    uint64_t upper;
+
+    for( bin = 0; bin < mNetSimHistBins_c; bin++ )
+    {
+        sum += pHist->bins[bin];
+        if( sum >= rank )
+        {
+            break;
+        }
+    }
+
+    if( bin < mNetSimHistSub_c )
+    {
+        upper = bin;
+    }
+    else
+    {
+        octave = bin / mNetSimHistSub_c - 1;
+        upper = ((uint64_t)(mNetSimHistSub_c + bin % mNetSimHistSub_c + 1) << octave) - 1;
+    }
+
+    return (upper < pHist->max) ? (uint32_t)upper : pHist->max;
+}
+
+/******************************************************************************
+ * The HistRead() function summarizes a histogram.
+ ******************************************************************************/
+static void HistRead( netSimHist_t *pHist, netSimLatency_t *pLatency )
+{
+    FLib_MemSet( pLatency, 0, sizeof(netSimLatency_t) );
+    pLatency->count = pHist->count;
+    if( pHist->count )
+    {
+        pLatency->p50 = HistPercentile( pHist, 50 );
+        pLatency->p90 = HistPercentile( pHist, 90 );
+        pLatency->p99 = HistPercentile( pHist, 99 );
+        pLatency->max = pHist->max;
+    }
+}
+
+/******************************************************************************
+ * The McpsSapHandler() function receives the MCPS messages of every node.
+ ******************************************************************************/
+static resultType_t McpsSapHandler( mcpsToNwkMessage_t *pMsg, instanceId_t instanceId )
+{
+    uint8_t node = (uint8_t)instanceId;
+    uint8_t prev = EnterNode( node );
+
+    Charge( pMsg, node );
+
+    switch( pMsg->msgType )
+    {
+    case gMcpsDataCnf_c:
+        HandleDataCnf( node, &pMsg->msgData.dataCnf );
+        break;
+
+    case gMcpsDataInd_c:
+        HandleDataInd( node, &pMsg->msgData.dataInd );
+        break;
+
+    default:
+        break;
+    }
+
+    MSG_Free( pMsg );
+    (void)EnterNode( prev );
+    return gSuccess_c;
+}
+
+/******************************************************************************
+ * The MlmeSapHandler() function receives the MLME messages of every node.
+ ******************************************************************************/
+static resultType_t MlmeSapHandler( nwkMessage_t *pMsg, instanceId_t instanceId )
+{
+    uint8_t node = (uint8_t)instanceId;
+    uint8_t prev = EnterNode( node );
+
+    Charge( pMsg, node );
+
+    switch( pMsg->msgType )
+    {
+    case gMlmeStartCnf_c:
+        if( gSuccess_c == pMsg->msgData.startCnf.status )
+        {
+            mNodes[node].state = mNetSimRunning_c;
+            mNodes[node].stats.associated = (uint32_t)((MacHost_GetTimeUs() - mStartTime) / 1000);
+        }
+        break;
+
+    case gMlmeScanCnf_c:
+        HandleScanCnf( node, &pMsg->msgData.scanCnf );
+        break;
+
+    case gMlmeAssociateInd_c:
+        HandleAssociateInd( node, &pMsg->msgData.associateInd );
+        break;
+
+    case gMlmeAssociateCnf_c:
+        HandleAssociateCnf( node, &pMsg->msgData.associateCnf );
+        break;
+
+    case gMlmeCommStatusInd_c:
+        HandleCommStatusInd( node, &pMsg->msgData.commStatusInd );
+        break;
+
+    default:
+        break;
+    }
+
+    MSG_Free( pMsg );
+    (void)EnterNode( prev );
+    return gSuccess_c;
+}
+
+/******************************************************************************
+ * The NodeStart() function is the start timer callback of a node.
+ ******************************************************************************/
+static void NodeStart( void *param )
+{
+    netSimNode_t *pNode = param;
+    uint8_t node = (uint8_t)(pNode - mNodes);
+
+    if( gNetSimCoordinator_c == pNode->cfg.role )
+    {
+        StartCoordinator( node );
+    }
+    else
+    {
+        StartScan( node );
+    }
+}
+
+/******************************************************************************
+ * The StartCoordinator() function starts the PAN of a coordinator, as the
+ * wrapper does: short address 0x0000, association permit, non-beacon PAN.
+ ******************************************************************************/
+static void StartCoordinator( uint8_t node )
+{
+    netSimNode_t *pNode = &mNodes[node];
+    mlmeMessage_t setReq;
+    mlmeMessage_t *pMsg;
+    bool_t boolFlag = TRUE;
+
+    pNode->shortAddr = 0x0000;
+    pNode->nextShortAddr = 0x0001;
+
+    /* Set requests are synchronous and not freed by the MLME */
+    setReq.msgType = gMlmeSetReq_c;
+    setReq.msgData.setReq.pibAttribute = gMPibShortAddress_c;
+    setReq.msgData.setReq.pibAttributeValue = (uint8_t*)&pNode->shortAddr;
+    (void)NWK_MLME_SapHandler( &setReq, pNode->macId );
+
+    setReq.msgData.setReq.pibAttribute = gMPibAssociationPermit_c;
+    setReq.msgData.setReq.pibAttributeValue = &boolFlag;
+    (void)NWK_MLME_SapHandler( &setReq, pNode->macId );
+
+    pMsg = MSG_AllocType( mlmeMessage_t );
+    if( NULL == pMsg )
+    {
+        return;
+    }
+
+    FLib_MemSet( pMsg, 0, sizeof(mlmeMessage_t) );
+    pMsg->msgType = gMlmeStartReq_c;
+    pMsg->msgData.startReq.panId = pNode->cfg.panId;
+    pMsg->msgData.startReq.logicalChannel = pNode->cfg.channel;
+    pMsg->msgData.startReq.beaconOrder = 0x0F;
+    pMsg->msgData.startReq.superframeOrder = 0x0F;
+    pMsg->msgData.startReq.panCoordinator = TRUE;
+    pMsg->msgData.startReq.coordRealignSecurityLevel = gMacSecurityNone_c;
+    pMsg->msgData.startReq.beaconSecurityLevel = gMacSecurityNone_c;
+
+    pNode->state = mNetSimStarting_c;
+    if( gSuccess_c != NWK_MLME_SapHandler( pMsg, pNode->macId ) )
+    {
+        pNode->state = mNetSimIdle_c;
+    }
+}
+
+/******************************************************************************
+ * The StartScan() function starts the active scan of an end device, on the
+ * channel of its configuration or on all channels.
+ ******************************************************************************/
+static void StartScan( uint8_t node )
+{
+    netSimNode_t *pNode = &mNodes[node];
+    mlmeMessage_t setReq;
+    mlmeMessage_t *pMsg;
+    bool_t boolFlag = TRUE;
+    uint32_t channels = pNode->cfg.channel ? (1UL << pNode->cfg.channel) : mNetSimAllChannels_c;
+
+    setReq.msgType = gMlmeSetReq_c;
+    setReq.msgData.setReq.pibAttribute = gMPibRxOnWhenIdle_c;
+    setReq.msgData.setReq.pibAttributeValue = &boolFlag;
+    (void)NWK_MLME_SapHandler( &setReq, pNode->macId );
+
+    pNode->stats.assocAttempts++;
+
+    pMsg = MSG_AllocType( mlmeMessage_t );
+    if( NULL != pMsg )
+    {
+        FLib_MemSet( pMsg, 0, sizeof(mlmeMessage_t) );
+        pMsg->msgType = gMlmeScanReq_c;
+        pMsg->msgData.scanReq.scanType = gScanModeActive_c;
+        FLib_MemCpy( &pMsg->msgData.scanReq.scanChannels, &channels, sizeof(channels) );
+        pMsg->msgData.scanReq.scanDuration = mNetSimScanDuration_c;
+        pMsg->msgData.scanReq.securityLevel = gMacSecurityNone_c;
+
+        pNode->state = mNetSimScanning_c;
+        if( gSuccess_c == NWK_MLME_SapHandler( pMsg, pNode->macId ) )
+        {
+            return;
+        }
+    }
+
+    pNode->state = mNetSimIdle_c;
+    (void)TMR_StartSingleShotTimer( pNode->timer, gNetSimAssocRetryTime_c, NodeStart, pNode );
+}
+
+/******************************************************************************
+ * The HandleScanCnf() function picks the coordinator of the PAN of the node
+ * with the best link quality and associates to it.
+ ******************************************************************************/
+static void HandleScanCnf( uint8_t node, mlmeScanCnf_t *pCnf )
+{
+    netSimNode_t *pNode = &mNodes[node];
+    panDescriptorBlock_t *pBlock = pCnf->resList.pPanDescriptorBlockList;
+    panDescriptorBlock_t *pNext;
+    panDescriptor_t best;
+    mlmeMessage_t *pMsg;
+    bool_t found = FALSE;
+    uint8_t i;
+
+    while( pBlock )
+    {
+        Charge( pBlock, node );
+        for( i = 0; i < pBlock->panDescriptorCount; i++ )
+        {
+            panDescriptor_t *pDesc = &pBlock->panDescriptorList[i];
+
+            if( (pDesc->coordPanId == pNode->cfg.panId) && pDesc->superframeSpec.associationPermit &&
+                (!found || (pDesc->linkQuality > best.linkQuality)) )
+            {
+                best = *pDesc;
+                found = TRUE;
+            }
+        }
+
+        pNext = pBlock->pNext;
+        MSG_Free( pBlock );
+        pBlock = pNext;
+    }
+
+    pNode->state = mNetSimIdle_c;
+
+    if( found && (NULL != (pMsg = MSG_AllocType( mlmeMessage_t ))) )
+    {
+        FLib_MemSet( pMsg, 0, sizeof(mlmeMessage_t) );
+        pMsg->msgType = gMlmeAssociateReq_c;
+        pMsg->msgData.associateReq.coordAddress = best.coordAddress;
+        pMsg->msgData.associateReq.coordPanId = best.coordPanId;
+        pMsg->msgData.associateReq.coordAddrMode = best.coordAddrMode;
+        pMsg->msgData.associateReq.logicalChannel = best.logicalChannel;
+        pMsg->msgData.associateReq.securityLevel = gMacSecurityNone_c;
+        pMsg->msgData.associateReq.channelPage = gDefaultChannelPageId_c;
+        pMsg->msgData.associateReq.capabilityInfo = gCapInfoAllocAddr_c;
+
+        if( gSuccess_c == NWK_MLME_SapHandler( pMsg, pNode->macId ) )
+        {
+            pNode->state = mNetSimAssociating_c;
+            return;
+        }
+    }
+
+    (void)TMR_StartSingleShotTimer( pNode->timer, gNetSimAssocRetryTime_c, NodeStart, pNode );
+}
+
+/******************************************************************************
+ * The HandleAssociateInd() function gives the next short address to a device,
+ * unless maxPendingAssoc responses already wait for their comm status or the
+ * device already has one waiting.
+ ******************************************************************************/
+static void HandleAssociateInd( uint8_t node, mlmeAssociateInd_t *pInd )
+{
+    netSimNode_t *pNode = &mNodes[node];
+    mlmeMessage_t *pMsg;
+    uint8_t i;
+    uint8_t slot = gNetSimMaxPendingAssoc_c;
+
+    if( pNode->pendingAssocCount >= pNode->cfg.maxPendingAssoc )
+    {
+        return;
+    }
+
+    for( i = 0; i < gNetSimMaxPendingAssoc_c; i++ )
+    {
+        if( pNode->pendingAssoc[i] == pInd->deviceAddress )
+        {
+            return;
+        }
+        if( (0 == pNode->pendingAssoc[i]) && (gNetSimMaxPendingAssoc_c == slot) )
+        {
+            slot = i;
+        }
+    }
+
+    pMsg = MSG_AllocType( mlmeMessage_t );
+    if( NULL == pMsg )
+    {
+        return;
+    }
+
+    FLib_MemSet( pMsg, 0, sizeof(mlmeMessage_t) );
+    pMsg->msgType = gMlmeAssociateRes_c;
+    pMsg->msgData.associateRes.deviceAddress = pInd->deviceAddress;
+    pMsg->msgData.associateRes.securityLevel = gMacSecurityNone_c;
+    if( pNode->nextShortAddr < 0xFFFE )
+    {
+        pMsg->msgData.associateRes.assocShortAddress = pNode->nextShortAddr++;
+        pMsg->msgData.associateRes.status = gSuccess_c;
+    }
+    else
+    {
+        pMsg->msgData.associateRes.assocShortAddress = 0xFFFE;
+        pMsg->msgData.associateRes.status = gPanAtCapacity_c;
+    }
+
+    if( gSuccess_c == NWK_MLME_SapHandler( pMsg, pNode->macId ) )
+    {
+        pNode->pendingAssoc[slot] = pInd->deviceAddress;
+        pNode->pendingAssocCount++;
+    }
+}
+
+/******************************************************************************
+ * The HandleCommStatusInd() function frees the slot of the device an
+ * association response was sent to.
+ ******************************************************************************/
+static void HandleCommStatusInd( uint8_t node, mlmeCommStatusInd_t *pInd )
+{
+    netSimNode_t *pNode = &mNodes[node];
+    uint8_t i;
+
+    if( gAddrModeExtendedAddress_c != pInd->destAddrMode )
+    {
+        return;
+    }
+
+    for( i = 0; i < gNetSimMaxPendingAssoc_c; i++ )
+    {
+        if( pNode->pendingAssoc[i] == pInd->destAddress )
+        {
+            pNode->pendingAssoc[i] = 0;
+            pNode->pendingAssocCount--;
+            break;
+        }
+    }
+}
+
+/******************************************************************************
+ * The HandleAssociateCnf() function starts the reports of an end device, with
+ * a random phase so the devices do not all send at the same time.
+ ******************************************************************************/
+static void HandleAssociateCnf( uint8_t node, mlmeAssociateCnf_t *pCnf )
+{
+    netSimNode_t *pNode = &mNodes[node];
+
+    if( gSuccess_c != pCnf->status )
+    {
+        pNode->state = mNetSimIdle_c;
+        (void)TMR_StartSingleShotTimer( pNode->timer, gNetSimAssocRetryTime_c, NodeStart, pNode );
+        return;
+    }
+
+    pNode->shortAddr = pCnf->assocShortAddress;
+    pNode->state = mNetSimRunning_c;
+    pNode->stats.associated = (uint32_t)((MacHost_GetTimeUs() - mStartTime) / 1000);
+
+    if( pNode->cfg.reportInterval )
+    {
+        (void)TMR_StartSingleShotTimer( pNode->timer, Random() % pNode->cfg.reportInterval + 1, FirstReport, pNode );
+    }
+}
+
+/******************************************************************************
+ * The FirstReport() function sends the first report of an end device and
+ * makes the timer periodic.
+ ******************************************************************************/
+static void FirstReport( void *param )
+{
+    netSimNode_t *pNode = param;
+
+    (void)TMR_StartIntervalTimer( pNode->timer, pNode->cfg.reportInterval, SendReport, pNode );
+    SendReport( param );
+}
+
+/******************************************************************************
+ * The SendReport() function sends one report to the coordinator: the index of
+ * the node and the time it was sent, padded to the payload length.
+ ******************************************************************************/
+static void SendReport( void *param )
+{
+    netSimNode_t *pNode = param;
+    uint8_t payload[0xFF] = { 0 };      /* Up to the largest payloadLength */
+    uint64_t now = MacHost_GetTimeUs();
+
+    payload[0] = (uint8_t)(pNode - mNodes);
+    FLib_MemCpy( &payload[1], &now, sizeof(now) );
+    (void)SendFrame( pNode, 0x0000, payload, pNode->cfg.payloadLength );
+}
+
+/******************************************************************************
+ * The SendFrame() function sends one acknowledged data frame, as
+ * BuildDataRequest() in the wrapper does. Frames are refused while
+ * gNetSimMaxOutstanding_c frames wait for their confirm.
+ ******************************************************************************/
+static bool_t SendFrame( netSimNode_t *pNode, uint16_t dstAddr, const uint8_t *pData, uint8_t length )
+{
+    nwkToMcpsMessage_t *pMsg;
+
+    if( pNode->txCount >= gNetSimMaxOutstanding_c )
+    {
+        pNode->stats.txRejected++;
+        return FALSE;
+    }
+
+    pMsg = MSG_Alloc( sizeof(nwkToMcpsMessage_t) + length );
+    if( NULL == pMsg )
+    {
+        pNode->stats.txRejected++;
+        return FALSE;
+    }
+
+    FLib_MemSet( pMsg, 0, sizeof(nwkToMcpsMessage_t) );
+    pMsg->msgType = gMcpsDataReq_c;
+    pMsg->msgData.dataReq.pMsdu = (uint8_t*)pMsg + sizeof(nwkToMcpsMessage_t);
+    FLib_MemCpy( pMsg->msgData.dataReq.pMsdu, (void*)pData, length );
+    pMsg->msgData.dataReq.dstAddr = dstAddr;
+    pMsg->msgData.dataReq.srcAddr = pNode->shortAddr;
+    pMsg->msgData.dataReq.dstPanId = pNode->cfg.panId;
+    pMsg->msgData.dataReq.srcPanId = pNode->cfg.panId;
+    pMsg->msgData.dataReq.dstAddrMode = gAddrModeShortAddress_c;
+    pMsg->msgData.dataReq.srcAddrMode = gAddrModeShortAddress_c;
+    pMsg->msgData.dataReq.msduLength = length;
+    pMsg->msgData.dataReq.txOptions = gMacTxOptionsAck_c;
+    pMsg->msgData.dataReq.msduHandle = pNode->msduHandle++;
+    pMsg->msgData.dataReq.securityLevel = gMacSecurityNone_c;
+
+    if( gSuccess_c != NWK_MCPS_SapHandler( pMsg, pNode->macId ) )
+    {
+        pNode->stats.txRejected++;
+        MSG_Free( pMsg );
+        return FALSE;
+    }
+
+    /* The request stays owned by the node until its confirm */
+    pNode->tx[pNode->txCount].pMsg = pMsg;
+    pNode->tx[pNode->txCount].time = MacHost_GetTimeUs();
+    pNode->txCount++;
+    pNode->stats.txRequests++;
+    return TRUE;
+}
+
+/******************************************************************************
+ * The HandleDataCnf() function completes an outstanding data request.
+ ******************************************************************************/
+static void HandleDataCnf( uint8_t node, mcpsDataCnf_t *pCnf )
+{
+    netSimNode_t *pNode = &mNodes[node];
+    uint8_t i;
+
+    for( i = 0; i < pNode->txCount; i++ )
+    {
+        if( pNode->tx[i].pMsg->msgData.dataReq.msduHandle == pCnf->msduHandle )
+        {
+            break;
+        }
+    }
+
+    if( i == pNode->txCount )
+    {
+        return;
+    }
+
+    HistAdd( &pNode->service, MacHost_GetTimeUs() - pNode->tx[i].time );
+
+    switch( pCnf->status )
+    {
+    case gSuccess_c:
+        pNode->stats.txSuccess++;
+        break;
+    case gNoAck_c:
+        pNode->stats.txNoAck++;
+        break;
+    case gChannelAccessFailure_c:
+        pNode->stats.txChannelAccessFailure++;
+        break;
+    default:
+        pNode->stats.txOtherFailure++;
+        break;
+    }
+
+    MSG_Free( pNode->tx[i].pMsg );
+    pNode->tx[i] = pNode->tx[--pNode->txCount];
+}
+
+/******************************************************************************
+ * The HandleDataInd() function counts a received frame and records its
+ * delivery latency against its sender.
+ ******************************************************************************/
+static void HandleDataInd( uint8_t node, mcpsDataInd_t *pInd )
+{
+    netSimNode_t *pNode = &mNodes[node];
+    uint64_t sent;
+    uint8_t src;
+
+    pNode->stats.rxFrames++;
+    pNode->stats.rxBytes += pInd->msduLength;
+
+    if( NULL != mDataHook )
+    {
+        mDataHook( node, pInd );
+    }
+
+    if( pInd->msduLength < mNetSimPayloadHeader_c )
+    {
+        return;
+    }
+
+    src = pInd->pMsdu[0];
+    FLib_MemCpy( &sent, &pInd->pMsdu[1], sizeof(sent) );
+    if( src < mNodeCount )
+    {
+        HistAdd( &mNodes[src].delivery, MacHost_GetTimeUs() - sent );
+    }
+}
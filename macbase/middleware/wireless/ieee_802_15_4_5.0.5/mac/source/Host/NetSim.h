@@ -0,0 +1,213 @@
+/************************************************************************************
+* This module contains the public interface of the host network simulator.
+*
+* NetSim.c runs many coordinators and end devices in one process, in virtual time,
+* on top of the host MAC (MacHost.c) with its radio model enabled. Every node is a
+* MAC instance driven by a small application which follows the msn_coordinator
+* flows through the MCPS/MLME SAPs:
+*   - coordinator: short address 0x0000, association permit, MLME-START, answers
+*     association requests with the next free short address while fewer than
+*     maxPendingAssoc responses wait for their MLME-COMM-STATUS.indication (the
+*     others are dropped, as mwMaxPendingAssoc_c does), sinks data frames;
+*   - end device: active scan, association to the coordinator of its PAN (retried
+*     until it succeeds), then one acknowledged data frame every report interval,
+*     with at most gNetSimMaxOutstanding_c frames waiting for their confirm.
+*
+* NetSim.c also provides the host versions of the framework services the
+* applications and the MAC rely on, all bound to the simulation clock:
+* TMR_* (timers belong to the node that started them and call back with that node
+* current), OSA_TimeGetMsec() and MEM_* (every buffer is charged to a node, which
+* gives per node memory high-water marks, and per node limits that stand for the
+* MemManager pools).
+*
+* Build (workstation): MacHost.c NetSim.c NetSimMain.c FunctionLib.c, -lm, with
+* gMacHostMaxNodes_c/gMacHostMaxEvents_c raised for large networks.
+*
+************************************************************************************/
+#ifndef _NET_SIM_H_
+#define _NET_SIM_H_
+
+#include "EmbeddedTypes.h"
+#include "MacHost.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+
+/*! Number of simulated nodes, at most 254. A node is a MAC instance, so MacHost must
+    hold as many */
+#ifndef gNetSimMaxNodes_c
+#define gNetSimMaxNodes_c           (gMacHostMaxNodes_c)
+#endif
+
+/*! Number of TMR timers shared by all nodes */
+#ifndef gNetSimMaxTimers_c
+#define gNetSimMaxTimers_c          (2 * gNetSimMaxNodes_c + 8)
+#endif
+
+/*! Data frames an end device keeps waiting for their confirm */
+#ifndef gNetSimMaxOutstanding_c
+#define gNetSimMaxOutstanding_c     (4)
+#endif
+
+/*! Association responses a coordinator can keep waiting for their comm status */
+#ifndef gNetSimMaxPendingAssoc_c
+#define gNetSimMaxPendingAssoc_c    (16)
+#endif
+
+/*! Time [ms] an end device waits before scanning again after a failed association */
+#ifndef gNetSimAssocRetryTime_c
+#define gNetSimAssocRetryTime_c     (7000)
+#endif
+
+/*! Returned by NetSim_AddNode() when the node cannot be created */
+#define gNetSimInvalidNode_c        (0xFF)
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+
+typedef enum
+{
+    gNetSimCoordinator_c,
+    gNetSimEndDevice_c
+}netSimRole_t;
+
+/*! Node description */
+typedef struct netSimNodeCfg_tag
+{
+    netSimRole_t        role;
+    float               x;                  /*!< Position [m] */
+    float               y;
+    uint16_t            panId;              /*!< PAN started (coordinator) or joined (end device) */
+    logicalChannelId_t  channel;            /*!< Coordinator only: channel of the PAN */
+    uint8_t             maxPendingAssoc;    /*!< Coordinator only: concurrent associations, 1 to gNetSimMaxPendingAssoc_c */
+    uint32_t            reportInterval;     /*!< End device only: time [ms] between data frames */
+    uint8_t             payloadLength;      /*!< End device only: MSDU length, at least 9 */
+    uint32_t            startDelay;         /*!< Time [ms] after NetSim_Init() before the node starts */
+}netSimNodeCfg_t;
+
+/*! Called by NetSim_Run() before the clock advances */
+typedef void ( *pfNetSimIdleHook_t )( void );
+
+/*! Called with every data frame a node receives, before it is freed */
+typedef void ( *pfNetSimDataHook_t )( uint8_t node, mcpsDataInd_t *pInd );
+
+/*! Latency distribution [us] */
+typedef struct netSimLatency_tag
+{
+    uint32_t    count;
+    uint32_t    p50;
+    uint32_t    p90;
+    uint32_t    p99;
+    uint32_t    max;
+}netSimLatency_t;
+
+/*! Per node results */
+typedef struct netSimNodeStats_tag
+{
+    uint32_t            txRequests;         /*!< MCPS-DATA requests accepted by the MAC */
+    uint32_t            txRejected;         /*!< MCPS-DATA requests refused by the MAC */
+    uint32_t            txSuccess;
+    uint32_t            txNoAck;
+    uint32_t            txChannelAccessFailure;
+    uint32_t            txOtherFailure;
+    uint32_t            rxFrames;           /*!< Data frames received (duplicates included) */
+    uint32_t            rxBytes;
+    uint32_t            rxThroughput;       /*!< Received MSDU bits per second over the run */
+    uint32_t            associated;         /*!< Time [ms] the node associated/started, 0xFFFFFFFF if never */
+    uint32_t            assocAttempts;
+    netSimLatency_t     serviceLatency;     /*!< Data request to its confirm, at the sender */
+    netSimLatency_t     deliveryLatency;    /*!< Data request to the indication at the destination */
+    uint32_t            memCurrent;         /*!< Bytes allocated from MEM_* charged to the node */
+    uint32_t            memPeak;
+    uint16_t            buffersCurrent;
+    uint16_t            buffersPeak;
+    uint32_t            buffersRefused;     /*!< Allocations refused by NetSim_SetMemLimit() */
+    macHostNodeStats_t  radio;
+}netSimNodeStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! *********************************************************************************
+* \brief  Resets the MAC, the clock, the timers and every node, and enables the
+*         radio model with the given parameters. NULL selects 0 dBm, 40 dB at
+*         1 m, exponent 3, -100 dBm noise floor and a -75 dBm CCA threshold.
+********************************************************************************** */
+void NetSim_Init( uint32_t seed, const macHostRadioCfg_t *pRadioCfg );
+
+/*! *********************************************************************************
+* \brief  Adds a node. Its application starts cfg->startDelay ms after NetSim_Init().
+*
+* \return  the node index, or gNetSimInvalidNode_c
+********************************************************************************** */
+uint8_t NetSim_AddNode( const netSimNodeCfg_t *pCfg );
+
+/*! *********************************************************************************
+* \brief  Runs the network for durationMs of virtual time.
+********************************************************************************** */
+void NetSim_Run( uint32_t durationMs );
+
+/*! *********************************************************************************
+* \brief  Sets the function NetSim_Run() calls every time it is about to advance the
+*         clock, and once more before it returns. Code running outside the NetSim
+*         applications (tasks of a host build) uses it to process what the nodes
+*         gave it at the current time. NULL removes it.
+********************************************************************************** */
+void NetSim_SetIdleHook( pfNetSimIdleHook_t pfHook );
+
+/*! *********************************************************************************
+* \brief  Sets the function called with every data frame received by a node, so a
+*         host build can run a protocol on top of the NetSim nodes. It is called from
+*         the MAC of the node, with the node current. NULL removes it.
+********************************************************************************** */
+void NetSim_SetDataHook( pfNetSimDataHook_t pfHook );
+
+/*! *********************************************************************************
+* \brief  Sends one acknowledged data frame from a node, like its periodic reports.
+*
+* \return  FALSE if gNetSimMaxOutstanding_c frames of the node wait for their
+*          confirm, or the MAC refused the request
+********************************************************************************** */
+bool_t NetSim_SendData( uint8_t node, uint16_t dstAddr, const uint8_t *pData, uint8_t length );
+
+/*! *********************************************************************************
+* \brief  Limits the MEM_* buffers charged to a node (gNetSimMaxNodes_c: the MAC)
+*         at the same time, as the pools of the MemManager do on the target: past
+*         the limit an allocation fails. 0 removes the limit, NetSim_Init() too.
+********************************************************************************** */
+void NetSim_SetMemLimit( uint8_t node, uint16_t maxBuffers );
+
+/*! *********************************************************************************
+* \brief  Returns the virtual time [us].
+********************************************************************************** */
+uint64_t NetSim_GetTimeUs( void );
+
+/*! *********************************************************************************
+* \brief  Computes the results of a node. gNetSimMaxNodes_c reads the memory charged
+*         to the MAC itself (frames on air, messages waiting for delivery).
+********************************************************************************** */
+void NetSim_GetNodeStats( uint8_t node, netSimNodeStats_t *pStats );
+
+/*! *********************************************************************************
+* \brief  Prints one line of results per node and the network totals on stdout,
+*         with the time the last end device associated.
+********************************************************************************** */
+void NetSim_PrintReport( void );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* _NET_SIM_H_ */
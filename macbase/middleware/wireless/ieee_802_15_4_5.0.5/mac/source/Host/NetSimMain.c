@@ -0,0 +1,157 @@
+/************************************************************************************
+* This module contains the command line front end of the host network simulator.
+*
+* It places the coordinators on a circle of radius/2 around the origin, each with
+* its own PAN (0x1000 + k) on its own channel (11 + k), spreads the end devices
+* uniformly over a disc of the given radius, assigns every device to the closest
+* coordinator, runs the network and prints the NetSim report.
+*
+*   netsim [-n devices] [-c coordinators] [-i interval_ms] [-l payload]
+*          [-r radius_m] [-t seconds] [-s seed] [-p pathloss_exponent]
+*          [-a pending_associations] [-j start_spread_ms]
+*
+* The devices start within the first start_spread_ms (1000) ms. A mass rejoin, all
+* the devices of a PAN coming back at once after a coordinator reset, is -j 0; the
+* last line of the report gives the time until all of them are associated. -a 1
+* gives the coordinator behavior of one association at a time, the default is
+* mwMaxPendingAssoc_c (8).
+*
+************************************************************************************/
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include "EmbeddedTypes.h"
+#include "NetSim.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mPi_c           (3.14159265f)
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The Uniform() function returns a pseudo random number in [0, 1).
+ ******************************************************************************/
+static float Uniform( void )
+{
+    return (float)rand() / ((float)RAND_MAX + 1.0f);
+}
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+int main( int argc, char *argv[] )
+{
+    macHostRadioCfg_t radioCfg = { 0.0f, 40.0f, 3.0f, -100.0f, -75.0f };
+    netSimNodeCfg_t cfg;
+    float coordX[16];
+    float coordY[16];
+    uint32_t devices = 8;
+    uint32_t coordinators = 1;
+    uint32_t interval = 1000;
+    uint32_t payload = 20;
+    uint32_t seconds = 60;
+    uint32_t seed = 1;
+    uint32_t pending = 8;
+    uint32_t spread = 1000;
+    float radius = 30.0f;
+    uint32_t i;
+    uint32_t k;
+    int opt;
+
+    while( (opt = getopt( argc, argv, "n:c:i:l:r:t:s:p:a:j:" )) != -1 )
+    {
+        switch( opt )
+        {
+        case 'n': devices      = strtoul( optarg, NULL, 0 ); break;
+        case 'c': coordinators = strtoul( optarg, NULL, 0 ); break;
+        case 'i': interval     = strtoul( optarg, NULL, 0 ); break;
+        case 'l': payload      = strtoul( optarg, NULL, 0 ); break;
+        case 'r': radius       = strtof( optarg, NULL ); break;
+        case 't': seconds      = strtoul( optarg, NULL, 0 ); break;
+        case 's': seed         = strtoul( optarg, NULL, 0 ); break;
+        case 'p': radioCfg.pathLossExp = strtof( optarg, NULL ); break;
+        case 'a': pending      = strtoul( optarg, NULL, 0 ); break;
+        case 'j': spread       = strtoul( optarg, NULL, 0 ); break;
+        default:
+            fprintf( stderr, "usage: %s [-n devices] [-c coordinators] [-i interval_ms] [-l payload]\n"
+                             "       [-r radius_m] [-t seconds] [-s seed] [-p pathloss_exponent]\n"
+                             "       [-a pending_associations] [-j start_spread_ms]\n", argv[0] );
+            return 1;
+        }
+    }
+
+    if( (coordinators < 1) || (coordinators > 16) || (devices + coordinators > gNetSimMaxNodes_c) )
+    {
+        fprintf( stderr, "1 to 16 coordinators and at most %u nodes (gNetSimMaxNodes_c)\n", gNetSimMaxNodes_c );
+        return 1;
+    }
+
+    srand( seed );
+    NetSim_Init( seed, &radioCfg );
+
+    for( k = 0; k < coordinators; k++ )
+    {
+        float angle = 2 * mPi_c * k / coordinators;
+
+        coordX[k] = (coordinators > 1) ? radius / 2 * cosf( angle ) : 0.0f;
+        coordY[k] = (coordinators > 1) ? radius / 2 * sinf( angle ) : 0.0f;
+
+        cfg.role = gNetSimCoordinator_c;
+        cfg.x = coordX[k];
+        cfg.y = coordY[k];
+        cfg.panId = (uint16_t)(0x1000 + k);
+        cfg.channel = (logicalChannelId_t)(11 + k);
+        cfg.maxPendingAssoc = (uint8_t)pending;
+        cfg.reportInterval = 0;
+        cfg.payloadLength = 0;
+        cfg.startDelay = 0;
+        (void)NetSim_AddNode( &cfg );
+    }
+
+    for( i = 0; i < devices; i++ )
+    {
+        /* Uniform over the disc */
+        float r = radius * sqrtf( Uniform() );
+        float angle = 2 * mPi_c * Uniform();
+        float best = 0;
+
+        cfg.role = gNetSimEndDevice_c;
+        cfg.x = r * cosf( angle );
+        cfg.y = r * sinf( angle );
+        cfg.reportInterval = interval;
+        cfg.payloadLength = (uint8_t)payload;
+        /* Give the coordinators time to start, and do not all scan at once */
+        cfg.startDelay = 10 + (uint32_t)(Uniform() * spread);
+
+        for( k = 0; k < coordinators; k++ )
+        {
+            float d = hypotf( cfg.x - coordX[k], cfg.y - coordY[k] );
+
+            if( (0 == k) || (d < best) )
+            {
+                best = d;
+                cfg.panId = (uint16_t)(0x1000 + k);
+                cfg.channel = (logicalChannelId_t)(11 + k);
+            }
+        }
+
+        (void)NetSim_AddNode( &cfg );
+    }
+
+    NetSim_Run( seconds * 1000 );
+    NetSim_PrintReport();
+
+    return 0;
+}
@@ -52,6 +52,7 @@
 #include "PhyTypes.h"
 #include "PhyMessages.h"
 #include "Messaging.h"
+#include "Trace.h"
 
 
 /************************************************************************************
@@ -81,6 +82,23 @@
 #define gAfcEnabled_d		0
 #endif
 
+/*! The following define is used to record when the last data request of each PHY instance started
+    and when it completed, read with PhyGetTxTimestamps() */
+#ifndef gPhyTxTimestamps_d
+#define gPhyTxTimestamps_d              0
+#endif
+
+/*! Events of the PHY in the trace (gTraceEnabled_d), with their arguments */
+#define gTracePhyIsr_c                  gTraceId_c(gTraceGroupPhy_c, 0x01)  /* IRQSTS1-3, PHY_CTRL1 */
+#define gTracePhyDataReq_c              gTraceId_c(gTraceGroupPhy_c, 0x02)  /* instance, PSDU length */
+#define gTracePhyDataCnf_c              gTraceId_c(gTraceGroupPhy_c, 0x03)  /* instance, frame pending */
+#define gTracePhyDataInd_c              gTraceId_c(gTraceGroupPhy_c, 0x04)  /* instance, PSDU length */
+#define gTracePhyCcaCnf_c               gTraceId_c(gTraceGroupPhy_c, 0x05)  /* instance, channel status */
+#define gTracePhyRxTimeout_c            gTraceId_c(gTraceGroupPhy_c, 0x06)  /* instance, flags */
+#define gTracePhySyncLoss_c             gTraceId_c(gTraceGroupPhy_c, 0x07)  /* instance */
+#define gTracePhyFilterFail_c           gTraceId_c(gTraceGroupPhy_c, 0x08)  /* instance, flags */
+#define gTracePhyXcvrReset_c            gTraceId_c(gTraceGroupPhy_c, 0x09)  /* instance */
+
 /*! Configure the maximum number of PHY timers/events */
 #ifndef gMaxPhyTimers_c
 #define gMaxPhyTimers_c                 (5)
@@ -547,6 +565,21 @@ phyTime_t PhyTime_GetSymbolsToUs(phyTime_t tsSymbols);
 phyTime_t PhyTime_GetUsToSymbols(phyTime_t tsUs);
 #endif
 
+#if gPhyTxTimestamps_d
+/*! *********************************************************************************
+ * \brief Returns when the last PD-DATA.request of the PHY instance started (CCA
+ *        included) and when its TX sequence completed successfully, the ACK
+ *        included, in TMR_GetTimestamp() microseconds. A request that failed
+ *        leaves the completion time of an earlier one.
+ *
+ * \param[in]  phyInstance  Instance of the PHY layer
+ * \param[out] pTxStart     Start of the last request
+ * \param[out] pTxDone      End of the last successful sequence
+ *
+ ********************************************************************************** */
+void PhyGetTxTimestamps( instanceId_t phyInstance, uint64_t *pTxStart, uint64_t *pTxDone );
+#endif
+
 /*! *********************************************************************************
  * \brief Set the low-power state of the PHY
  *
@@ -0,0 +1,1928 @@
+/************************************************************************************
+* This module contains a software model of the MCR20A transceiver.
+*
+* It replaces MCR20Drv.c when the PHY is built for a workstation: the MCR20Drv_*
+* functions below access the register file of a virtual transceiver instead of the
+* SPI bus, so the PHY sources run unmodified on top of it. See MCR20Sim.h for the
+* list of modelled features.
+*
+* Model notes:
+*   - one event timer tick is one symbol (16 us), whatever TMR_PRESCALE holds;
+*   - a sequence starts when PHY_CTRL1[XCVSEQ] goes from Idle to a sequence, either
+*     right away or on the T2/T2' match when TMRTRIGEN is set. Writing Idle while
+*     the sequencer runs aborts the sequence and sets SEQIRQ;
+*   - warm up takes gPhyWarmUpTime_c, CCA/ED 8 symbols and the RX to TX
+*     turnaround gPhyTurnaroundTime_c symbols. A frame is on air for
+*     gPhySHRDuration_c + (length + 1) * gPhySymbolsPerOctet_c symbols;
+*   - a frame is lost for every receiver when it overlaps another frame on the
+*     same channel (no capture effect), and for a single receiver with the loss
+*     probability of the link;
+*   - the received energy of a frame is derived from the LQI of the link, CCA
+*     reports busy when it, or the background energy, is above CCA1_THRESH;
+*   - when DUAL_PAN_AUTO is set both PANs are accepted by the filter and the
+*     channel of the PAN selected by CURRENT_NETWORK is used (no dwell switching).
+*
+************************************************************************************/
+#include "EmbeddedTypes.h"
+#include "FunctionLib.h"
+#include "MCR20Drv.h"
+#include "MCR20Reg.h"
+#include "Phy.h"
+#include "MCR20Sim.h"
+
+/************************************************************************************
+*************************************************************************************
+* Private macros
+*************************************************************************************
+************************************************************************************/
+#define mSimSymbolTime_c            (16000)     /* ns */
+#define mSimCcaTime_c               (8)         /* symbols */
+#define mSimPorTime_c               (25000)     /* ns from RST_B deassert to the wake IRQ */
+#define mSimIrqPollTime_c           (100)       /* ns spent reading the IRQ_B pin */
+#define mSimTimerMask_c             (0x00FFFFFF)
+#define mSimTimer2PrimeMask_c       (0x0000FFFF)
+#define mSimNever_c                 ((uint64_t)-1)
+#define mSimMaxIsrLoops_c           (16)        /* ISR calls in a row for a stuck IRQ_B */
+#define mSimSamSize_c               (16)
+#define mSimAckLength_c             (5)         /* FCS included */
+#define mSimFcsLength_c             (2)
+#define mSimDefaultEnergy_c         (100)       /* -100 dBm */
+#define mSimFirstChannel_c          (11)
+#define mSimChannels_c              (16)
+
+/* Fields of the frame control */
+#define mSimFcfType_c(fcf)          ((fcf) & 0x07)
+#define mSimFcfFramePending_c       (1 << 4)
+#define mSimFcfAckRequest_c         (1 << 5)
+#define mSimFcfPanIdComp_c          (1 << 6)
+#define mSimFcfDstMode_c(fcf)       (((fcf) >> 10) & 0x03)
+#define mSimFcfVersion_c(fcf)       (((fcf) >> 12) & 0x03)
+#define mSimFcfSrcMode_c(fcf)       (((fcf) >> 14) & 0x03)
+
+#define mSimFrameBeacon_c           (0)
+#define mSimFrameAck_c              (2)
+#define mSimFrameCmd_c              (3)
+#define mSimCmdDataRequest_c        (0x04)
+#define mSimAddrShort_c             (2)
+#define mSimAddrExt_c               (3)
+#define mSimBroadcast_c             (0xFFFF)
+
+#define mSimTimerIdx_c              (4)         /* event index of the sequencer */
+
+/************************************************************************************
+*************************************************************************************
+* Private data types
+*************************************************************************************
+************************************************************************************/
+typedef enum
+{
+    mSimPhaseIdle_c = 0,
+    mSimPhaseTrigger_c,         /* sequence programmed, waiting for the T2 match */
+    mSimPhaseWarmUp_c,
+    mSimPhaseCca_c,
+    mSimPhaseCcca_c,
+    mSimPhaseTxTurnaround_c,
+    mSimPhaseTx_c,
+    mSimPhaseListen_c,          /* RX sequence, waiting for a frame */
+    mSimPhaseAckWait_c,         /* TR sequence, waiting for the ACK */
+    mSimPhaseRxFrame_c,         /* receiving a frame */
+    mSimPhaseAckTurnaround_c,
+    mSimPhaseAckTx_c,
+    mSimPhaseReset_c            /* RST_B asserted or POR in progress */
+}simPhase_t;
+
+typedef struct simFrame_tag
+{
+    uint64_t    start;
+    uint64_t    end;
+    uint8_t     node;
+    uint8_t     channel;
+    uint8_t     length;                     /* FCS included */
+    uint8_t     psdu[gMaxPHYPacketSize_c];
+}simFrame_t;
+
+typedef struct simNode_tag
+{
+    uint8_t                 dreg[TransceiverSPI_DirectRegisterAddressMask + 1];
+    uint8_t                 ireg[256];
+    uint8_t                 pb[gMaxPHYPacketSize_c];
+    uint8_t                 txLength;       /* frame length loaded with the PB, FCS included */
+    uint16_t                sam[mSimSamSize_c];
+    uint16_t                samValid;
+    simPhase_t              phase;
+    simPhase_t              listenPhase;    /* phase to resume after a rejected frame */
+    uint64_t                phaseStart;
+    uint64_t                phaseEnd;
+    uint8_t                 rxFrame;        /* medium slot being received */
+    uint8_t                 ackDsn;
+    bool_t                  ackFp;
+    uint64_t                tmrBase;        /* time at which the event timer held tmrBaseValue */
+    uint32_t                tmrBaseValue;
+    uint64_t                tmrMatch[4];
+    uint32_t                irqDisableCnt;
+    bool_t                  irqForced;
+    bool_t                  inIsr;
+    mcr20SimIrqHandler_t    pfIrqHandler;
+    mcr20SimStats_t         stats;
+}simNode_t;
+
+/************************************************************************************
+*************************************************************************************
+* Private prototypes
+*************************************************************************************
+************************************************************************************/
+static void SimResetNode( simNode_t *pNode );
+static uint32_t SimRand( void );
+static void SimSpiTransfer( uint32_t bytes, uint32_t byteTime );
+static void SimProcessUntil( uint64_t time );
+static bool_t SimNextEvent( uint64_t *pTime, uint8_t *pNode, uint8_t *pIdx );
+static void SimDispatchIrqs( void );
+static bool_t SimIrqLine( simNode_t *pNode );
+static uint8_t SimReadDirect( simNode_t *pNode, uint8_t addr );
+static void SimWriteDirect( simNode_t *pNode, uint8_t addr, uint8_t value );
+static uint8_t SimReadIndirect( simNode_t *pNode, uint8_t addr );
+static void SimWriteIndirect( simNode_t *pNode, uint8_t addr, uint8_t value );
+static uint32_t SimTimerValue( simNode_t *pNode, uint64_t time );
+static void SimUpdateTimers( simNode_t *pNode );
+static void SimTimerMatch( simNode_t *pNode, uint8_t idx );
+static void SimSetPhase( simNode_t *pNode, simPhase_t phase, uint64_t duration );
+static void SimSequenceDone( simNode_t *pNode );
+static void SimPhaseEnd( simNode_t *pNode );
+static void SimTransmit( simNode_t *pNode, const uint8_t *pPsdu, uint8_t length, simPhase_t phase );
+static void SimFrameReceived( simNode_t *pNode );
+static bool_t SimFilter( simNode_t *pNode, const simFrame_t *pFrame, bool_t *pPoll, uint16_t *pSum );
+static bool_t SimPanSelected( simNode_t *pNode, uint8_t pan );
+static uint8_t SimActivePan( simNode_t *pNode );
+static uint8_t SimChannel( simNode_t *pNode );
+static uint8_t SimEnergy( simNode_t *pNode, uint64_t from, uint64_t to );
+
+/************************************************************************************
+*************************************************************************************
+* Private memory declarations
+*************************************************************************************
+************************************************************************************/
+static simNode_t    mSimNode[gMCR20SimMaxNodes_c];
+static simFrame_t   mSimMedium[gMCR20SimMaxFrames_c];
+static uint8_t      mSimMediumNext;
+static uint8_t      mSimActive;
+static uint64_t     mSimTime;
+static uint32_t     mSimRandState = 1;
+static uint8_t      mSimLinkLoss[gMCR20SimMaxNodes_c][gMCR20SimMaxNodes_c];
+static uint8_t      mSimLinkLqi[gMCR20SimMaxNodes_c][gMCR20SimMaxNodes_c];
+static uint8_t      mSimChannelEnergy[mSimChannels_c];
+static bool_t       mSimInitialized;
+
+/************************************************************************************
+*************************************************************************************
+* Public functions
+*************************************************************************************
+************************************************************************************/
+
+/*! *********************************************************************************
+* \brief  Resets the medium, the clock and all transceivers (as after power up).
+********************************************************************************** */
+void MCR20Sim_Init( void )
+{
+    uint8_t i, j;
+
+    mSimTime = 0;
+    mSimActive = 0;
+    mSimMediumNext = 0;
+    FLib_MemSet(mSimMedium, 0, sizeof(mSimMedium));
+
+    for( i = 0; i < gMCR20SimMaxNodes_c; i++ )
+    {
+        FLib_MemSet(&mSimNode[i], 0, sizeof(simNode_t));
+        SimResetNode(&mSimNode[i]);
+        /* Powered up: the POR wake IRQ is pending, like on a real board */
+        mSimNode[i].dreg[IRQSTS2] |= cIRQSTS2_WAKE_IRQ | cIRQSTS2_TMRSTATUS;
+        mSimNode[i].dreg[PWR_MODES] |= cPWR_MODES_XTAL_READY;
+        mSimNode[i].irqDisableCnt = 1;
+
+        for( j = 0; j < gMCR20SimMaxNodes_c; j++ )
+        {
+            mSimLinkLoss[i][j] = 0;
+            mSimLinkLqi[i][j] = gMCR20SimDefaultLqi_c;
+        }
+    }
+
+    mSimNode[0].pfIrqHandler = PHY_InterruptHandler;
+    FLib_MemSet(mSimChannelEnergy, mSimDefaultEnergy_c, sizeof(mSimChannelEnergy));
+    mSimInitialized = TRUE;
+}
+
+/*! *********************************************************************************
+* \brief  Selects the transceiver the MCR20Drv_* calls act on.
+********************************************************************************** */
+uint8_t MCR20Sim_SetActiveNode( uint8_t node )
+{
+    uint8_t prev = mSimActive;
+
+    if( node < gMCR20SimMaxNodes_c )
+    {
+        mSimActive = node;
+    }
+
+    return prev;
+}
+
+/*! *********************************************************************************
+* \brief  Installs the ISR of a node.
+********************************************************************************** */
+void MCR20Sim_SetIrqHandler( uint8_t node, mcr20SimIrqHandler_t pfHandler )
+{
+    if( node < gMCR20SimMaxNodes_c )
+    {
+        mSimNode[node].pfIrqHandler = pfHandler;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Sets the loss and the raw LQI of the link from one node to another.
+********************************************************************************** */
+void MCR20Sim_SetLink( uint8_t from, uint8_t to, uint8_t lossPercent, uint8_t lqi )
+{
+    if( (from < gMCR20SimMaxNodes_c) && (to < gMCR20SimMaxNodes_c) )
+    {
+        mSimLinkLoss[from][to] = (lossPercent > 100) ? 100 : lossPercent;
+        mSimLinkLqi[from][to] = lqi;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Sets the background energy of a channel, in -dBm.
+********************************************************************************** */
+void MCR20Sim_SetChannelEnergy( uint8_t channel, uint8_t energy )
+{
+    if( (channel >= mSimFirstChannel_c) && (channel < mSimFirstChannel_c + mSimChannels_c) )
+    {
+        mSimChannelEnergy[channel - mSimFirstChannel_c] = energy;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Seeds the generator used for link loss and the RNG register.
+********************************************************************************** */
+void MCR20Sim_SetSeed( uint32_t seed )
+{
+    mSimRandState = seed ? seed : 1;
+}
+
+/*! *********************************************************************************
+* \brief  Advances the virtual time, running the transceivers and their ISRs.
+********************************************************************************** */
+void MCR20Sim_Advance( uint64_t ns )
+{
+    uint64_t target = mSimTime + ns;
+    uint64_t next;
+    uint8_t node, idx;
+
+    SimDispatchIrqs();
+
+    while( SimNextEvent(&next, &node, &idx) && (next <= target) )
+    {
+        SimProcessUntil(next);
+        SimDispatchIrqs();
+    }
+
+    if( mSimTime < target )
+    {
+        mSimTime = target;
+    }
+}
+
+/*! *********************************************************************************
+* \brief  Returns the virtual time [ns].
+********************************************************************************** */
+uint64_t MCR20Sim_GetTime( void )
+{
+    return mSimTime;
+}
+
+/*! *********************************************************************************
+* \brief  Returns TRUE and the time [ns] of the next transceiver event, if any.
+********************************************************************************** */
+bool_t MCR20Sim_GetNextEventTime( uint64_t *pTime )
+{
+    uint8_t node, idx;
+
+    return SimNextEvent(pTime, &node, &idx);
+}
+
+/*! *********************************************************************************
+* \brief  Copies and optionally clears the counters of a node.
+********************************************************************************** */
+void MCR20Sim_GetStats( uint8_t node, mcr20SimStats_t *pStats, bool_t reset )
+{
+    if( node >= gMCR20SimMaxNodes_c )
+    {
+        return;
+    }
+
+    if( pStats )
+    {
+        *pStats = mSimNode[node].stats;
+    }
+
+    if( reset )
+    {
+        FLib_MemSet(&mSimNode[node].stats, 0, sizeof(mcr20SimStats_t));
+    }
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_Init
+* Description: there is no SPI to configure, the model is set up on first use.
+*---------------------------------------------------------------------------*/
+void MCR20Drv_Init
+(
+void
+)
+{
+    if( !mSimInitialized )
+    {
+        MCR20Sim_Init();
+    }
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_DirectAccessSPIWrite
+*---------------------------------------------------------------------------*/
+void MCR20Drv_DirectAccessSPIWrite
+(
+uint8_t address,
+uint8_t value
+)
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+
+    SimWriteDirect(pNode, address & TransceiverSPI_DirectRegisterAddressMask, value);
+    SimUpdateTimers(pNode);
+    SimSpiTransfer(2, gMCR20SimSpiWriteByteTime_c);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_DirectAccessSPIMultiByteWrite
+*---------------------------------------------------------------------------*/
+void MCR20Drv_DirectAccessSPIMultiByteWrite
+(
+uint8_t startAddress,
+uint8_t * byteArray,
+uint8_t numOfBytes
+)
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+    uint8_t i;
+
+    if( (numOfBytes == 0) || (byteArray == NULL) )
+    {
+        return;
+    }
+
+    for( i = 0; i < numOfBytes; i++ )
+    {
+        SimWriteDirect(pNode, (startAddress + i) & TransceiverSPI_DirectRegisterAddressMask, byteArray[i]);
+    }
+
+    SimUpdateTimers(pNode);
+    SimSpiTransfer(1 + numOfBytes, gMCR20SimSpiWriteByteTime_c);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_PB_SPIByteWrite
+*---------------------------------------------------------------------------*/
+void MCR20Drv_PB_SPIByteWrite
+(
+uint8_t address,
+uint8_t * byteArray,
+uint8_t numOfBytes
+)
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+    uint8_t i;
+
+    for( i = 0; (i < numOfBytes) && (address + i < gMaxPHYPacketSize_c); i++ )
+    {
+        pNode->pb[address + i] = byteArray[i];
+    }
+
+    SimSpiTransfer(2 + numOfBytes, gMCR20SimSpiWriteByteTime_c);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_PB_SPIBurstWrite
+* Description: the first byte is the frame length (FCS included), the PSDU
+*              follows and is stored from PB index 0.
+*---------------------------------------------------------------------------*/
+void MCR20Drv_PB_SPIBurstWrite
+(
+uint8_t * byteArray,
+uint8_t numOfBytes
+)
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+    uint8_t i;
+
+    if( (numOfBytes == 0) || (byteArray == NULL) )
+    {
+        return;
+    }
+
+    pNode->txLength = byteArray[0] & cRX_FRAME_LENGTH;
+
+    for( i = 1; (i < numOfBytes) && (i <= gMaxPHYPacketSize_c); i++ )
+    {
+        pNode->pb[i - 1] = byteArray[i];
+    }
+
+    SimSpiTransfer(1 + numOfBytes, gMCR20SimSpiWriteByteTime_c);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_DirectAccessSPIRead
+*---------------------------------------------------------------------------*/
+uint8_t MCR20Drv_DirectAccessSPIRead
+(
+uint8_t address
+)
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+    uint8_t value = SimReadDirect(pNode, address & TransceiverSPI_DirectRegisterAddressMask);
+
+    SimSpiTransfer(2, gMCR20SimSpiReadByteTime_c);
+    return value;
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_DirectAccessSPIMultiByteRead
+* Return: IRQSTS1, clocked out while the address is sent
+*---------------------------------------------------------------------------*/
+uint8_t MCR20Drv_DirectAccessSPIMultiByteRead
+(
+uint8_t startAddress,
+uint8_t * byteArray,
+uint8_t numOfBytes
+)
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+    uint8_t irqSts1;
+    uint8_t i;
+
+    if( (numOfBytes == 0) || (byteArray == NULL) )
+    {
+        return 0;
+    }
+
+    irqSts1 = pNode->dreg[IRQSTS1];
+
+    for( i = 0; i < numOfBytes; i++ )
+    {
+        byteArray[i] = SimReadDirect(pNode, (startAddress + i) & TransceiverSPI_DirectRegisterAddressMask);
+    }
+
+    SimSpiTransfer(1 + numOfBytes, gMCR20SimSpiReadByteTime_c);
+    return irqSts1;
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_PB_SPIBurstRead
+* Return: IRQSTS1, clocked out while the command is sent
+*---------------------------------------------------------------------------*/
+uint8_t MCR20Drv_PB_SPIBurstRead
+(
+uint8_t * byteArray,
+uint8_t numOfBytes
+)
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+    uint8_t irqSts1;
+
+    if( (numOfBytes == 0) || (byteArray == NULL) )
+    {
+        return 0;
+    }
+
+    irqSts1 = pNode->dreg[IRQSTS1];
+
+    if( numOfBytes > gMaxPHYPacketSize_c )
+    {
+        numOfBytes = gMaxPHYPacketSize_c;
+    }
+
+    FLib_MemCpy(byteArray, pNode->pb, numOfBytes);
+    SimSpiTransfer(1 + numOfBytes, gMCR20SimSpiReadByteTime_c);
+    return irqSts1;
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_PB_SPIByteRead
+*---------------------------------------------------------------------------*/
+void MCR20Drv_PB_SPIByteRead
+(
+uint8_t address,
+uint8_t * byteArray,
+uint8_t numOfBytes
+)
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+    uint8_t i;
+
+    for( i = 0; i < numOfBytes; i++ )
+    {
+        byteArray[i] = (address + i < gMaxPHYPacketSize_c) ? pNode->pb[address + i] : 0;
+    }
+
+    SimSpiTransfer(2 + numOfBytes, gMCR20SimSpiReadByteTime_c);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_IndirectAccessSPIWrite
+*---------------------------------------------------------------------------*/
+void MCR20Drv_IndirectAccessSPIWrite
+(
+uint8_t address,
+uint8_t value
+)
+{
+    SimWriteIndirect(&mSimNode[mSimActive], address, value);
+    SimSpiTransfer(3, gMCR20SimSpiWriteByteTime_c);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_IndirectAccessSPIMultiByteWrite
+*---------------------------------------------------------------------------*/
+void MCR20Drv_IndirectAccessSPIMultiByteWrite
+(
+uint8_t startAddress,
+uint8_t * byteArray,
+uint8_t numOfBytes
+)
+{
+    uint8_t i;
+
+    if( (numOfBytes == 0) || (byteArray == NULL) )
+    {
+        return;
+    }
+
+    for( i = 0; i < numOfBytes; i++ )
+    {
+        SimWriteIndirect(&mSimNode[mSimActive], startAddress + i, byteArray[i]);
+    }
+
+    SimSpiTransfer(2 + numOfBytes, gMCR20SimSpiWriteByteTime_c);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_IndirectAccessSPIRead
+*---------------------------------------------------------------------------*/
+uint8_t MCR20Drv_IndirectAccessSPIRead
+(
+uint8_t address
+)
+{
+    uint8_t value = SimReadIndirect(&mSimNode[mSimActive], address);
+
+    SimSpiTransfer(3, gMCR20SimSpiReadByteTime_c);
+    return value;
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_IndirectAccessSPIMultiByteRead
+*---------------------------------------------------------------------------*/
+void MCR20Drv_IndirectAccessSPIMultiByteRead
+(
+uint8_t startAddress,
+uint8_t * byteArray,
+uint8_t numOfBytes
+)
+{
+    uint8_t i;
+
+    if( (numOfBytes == 0) || (byteArray == NULL) )
+    {
+        return;
+    }
+
+    for( i = 0; i < numOfBytes; i++ )
+    {
+        byteArray[i] = SimReadIndirect(&mSimNode[mSimActive], startAddress + i);
+    }
+
+    SimSpiTransfer(2 + numOfBytes, gMCR20SimSpiReadByteTime_c);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_IRQ_PortConfig
+*---------------------------------------------------------------------------*/
+void MCR20Drv_IRQ_PortConfig
+(
+void
+)
+{
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_IsIrqPending
+* Description: reads the IRQ_B line. Polling the pin takes some time, so that
+*              loops waiting for the transceiver terminate.
+*---------------------------------------------------------------------------*/
+uint32_t  MCR20Drv_IsIrqPending
+(
+void
+)
+{
+    SimProcessUntil(mSimTime + mSimIrqPollTime_c);
+    return SimIrqLine(&mSimNode[mSimActive]);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_ForceIrqPending
+*---------------------------------------------------------------------------*/
+void  MCR20Drv_ForceIrqPending
+(
+void
+)
+{
+    mSimNode[mSimActive].irqForced = TRUE;
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_IRQ_Disable
+*---------------------------------------------------------------------------*/
+void MCR20Drv_IRQ_Disable
+(
+void
+)
+{
+    mSimNode[mSimActive].irqDisableCnt++;
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_IRQ_Enable
+*---------------------------------------------------------------------------*/
+void MCR20Drv_IRQ_Enable
+(
+void
+)
+{
+    if( mSimNode[mSimActive].irqDisableCnt )
+    {
+        mSimNode[mSimActive].irqDisableCnt--;
+    }
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_IRQ_IsEnabled
+*---------------------------------------------------------------------------*/
+uint32_t MCR20Drv_IRQ_IsEnabled
+(
+void
+)
+{
+    return (mSimNode[mSimActive].irqDisableCnt == 0);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_IRQ_Clear
+* Description: clears the pending flag of the pin. The level of IRQ_B only
+*              changes when the transceiver flags are cleared.
+*---------------------------------------------------------------------------*/
+void MCR20Drv_IRQ_Clear
+(
+void
+)
+{
+    mSimNode[mSimActive].irqForced = FALSE;
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_RST_B_PortConfig
+*---------------------------------------------------------------------------*/
+void MCR20Drv_RST_B_PortConfig
+(
+void
+)
+{
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_RST_B_Assert
+*---------------------------------------------------------------------------*/
+void MCR20Drv_RST_B_Assert
+(
+void
+)
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+
+    SimResetNode(pNode);
+    SimSetPhase(pNode, mSimPhaseReset_c, mSimNever_c);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_RST_B_Deassert
+* Description: the POR completes mSimPorTime_c later with the wake IRQ.
+*---------------------------------------------------------------------------*/
+void MCR20Drv_RST_B_Deassert
+(
+void
+)
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+
+    if( pNode->phase == mSimPhaseReset_c )
+    {
+        pNode->phaseEnd = mSimTime + mSimPorTime_c;
+    }
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_SoftRST_Assert
+*---------------------------------------------------------------------------*/
+void MCR20Drv_SoftRST_Assert
+(
+void
+)
+{
+    MCR20Drv_IndirectAccessSPIWrite(SOFT_RESET, (0x80));
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_SoftRST_Deassert
+*---------------------------------------------------------------------------*/
+void MCR20Drv_SoftRST_Deassert
+(
+void
+)
+{
+    MCR20Drv_IndirectAccessSPIWrite(SOFT_RESET, (0x00));
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_Soft_RESET
+*---------------------------------------------------------------------------*/
+void MCR20Drv_Soft_RESET
+(
+void
+)
+{
+    MCR20Drv_IndirectAccessSPIWrite(SOFT_RESET, (0x80));
+    MCR20Drv_IndirectAccessSPIWrite(SOFT_RESET, (0x00));
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_RESET
+*---------------------------------------------------------------------------*/
+void MCR20Drv_RESET
+(
+void
+)
+{
+    MCR20Drv_RST_B_Assert();
+    MCR20Drv_RST_B_Deassert();
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_Set_CLK_OUT_Freq
+*---------------------------------------------------------------------------*/
+void MCR20Drv_Set_CLK_OUT_Freq
+(
+uint8_t freqDiv
+)
+{
+    uint8_t clkOutCtrlReg = (freqDiv & cCLK_OUT_DIV_Mask) | cCLK_OUT_EN | cCLK_OUT_EXTEND;
+
+    if(freqDiv == gCLK_OUT_FREQ_DISABLE)
+    {
+        clkOutCtrlReg = (cCLK_OUT_EXTEND | gCLK_OUT_FREQ_4_MHz);
+    }
+
+    MCR20Drv_DirectAccessSPIWrite((uint8_t) CLK_OUT_CTRL, clkOutCtrlReg);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_SetGpioPinAsOutput
+*---------------------------------------------------------------------------*/
+void MCR20Drv_SetGpioPinAsOutput(uint8_t GpioMask)
+{
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_DIR, MCR20Drv_IndirectAccessSPIRead(GPIO_DIR) | GpioMask);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_SetGpioPinAsInput
+*---------------------------------------------------------------------------*/
+void MCR20Drv_SetGpioPinAsInput(uint8_t GpioMask)
+{
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_DIR, MCR20Drv_IndirectAccessSPIRead(GPIO_DIR) & ~GpioMask);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_SetGpioPin
+*---------------------------------------------------------------------------*/
+void MCR20Drv_SetGpioPin(uint8_t GpioMask)
+{
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_DATA, MCR20Drv_IndirectAccessSPIRead(GPIO_DATA) | GpioMask);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_ClearGpioPin
+*---------------------------------------------------------------------------*/
+void MCR20Drv_ClearGpioPin(uint8_t GpioMask)
+{
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_DATA, MCR20Drv_IndirectAccessSPIRead(GPIO_DATA) & ~GpioMask);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_GetGpioPinValue
+*---------------------------------------------------------------------------*/
+uint8_t MCR20Drv_GetGpioPinValue(uint8_t GpioMask)
+{
+    return (MCR20Drv_IndirectAccessSPIRead(GPIO_DATA) & GpioMask);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_EnableGpioPullUp
+*---------------------------------------------------------------------------*/
+void MCR20Drv_EnableGpioPullUp(uint8_t GpioMask)
+{
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_PUL_EN, MCR20Drv_IndirectAccessSPIRead(GPIO_PUL_EN) | GpioMask);
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_PUL_SEL, MCR20Drv_IndirectAccessSPIRead(GPIO_PUL_SEL) | GpioMask);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_EnableGpioPullDown
+*---------------------------------------------------------------------------*/
+void MCR20Drv_EnableGpioPullDown(uint8_t GpioMask)
+{
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_PUL_EN, MCR20Drv_IndirectAccessSPIRead(GPIO_PUL_EN) | GpioMask);
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_PUL_SEL, MCR20Drv_IndirectAccessSPIRead(GPIO_PUL_SEL) & ~GpioMask);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_DisableGpioPullUpDown
+*---------------------------------------------------------------------------*/
+void MCR20Drv_DisableGpioPullUpDown(uint8_t GpioMask)
+{
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_PUL_EN, MCR20Drv_IndirectAccessSPIRead(GPIO_PUL_EN) & ~GpioMask);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_EnableGpioHiDriveStrength
+*---------------------------------------------------------------------------*/
+void MCR20Drv_EnableGpioHiDriveStrength(uint8_t GpioMask)
+{
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_DS, MCR20Drv_IndirectAccessSPIRead(GPIO_DS) | GpioMask);
+}
+
+/*---------------------------------------------------------------------------
+* Name: MCR20Drv_DisableGpioHiDriveStrength
+*---------------------------------------------------------------------------*/
+void MCR20Drv_DisableGpioHiDriveStrength(uint8_t GpioMask)
+{
+    MCR20Drv_IndirectAccessSPIWrite(GPIO_DS, MCR20Drv_IndirectAccessSPIRead(GPIO_DS) & ~GpioMask);
+}
+
+/************************************************************************************
+*************************************************************************************
+* Private functions
+*************************************************************************************
+************************************************************************************/
+
+/******************************************************************************
+ * The SimResetNode() function loads the reset values of the registers and
+ * stops the sequencer and the comparators. IRQ handler, IRQ mask count and
+ * counters are kept.
+ ******************************************************************************/
+static void SimResetNode( simNode_t *pNode )
+{
+    uint8_t *r = pNode->dreg;
+    uint8_t *ir = pNode->ireg;
+    uint8_t i;
+
+    FLib_MemSet(pNode->dreg, 0, sizeof(pNode->dreg));
+    FLib_MemSet(pNode->ireg, 0, sizeof(pNode->ireg));
+    FLib_MemSet(pNode->pb, 0, sizeof(pNode->pb));
+
+    r[IRQSTS2]       = cIRQSTS2_TMRSTATUS;
+    r[IRQSTS3]       = cIRQSTS3_TMR4MSK | cIRQSTS3_TMR3MSK | cIRQSTS3_TMR2MSK | cIRQSTS3_TMR1MSK;
+    r[PHY_CTRL2]     = 0xFF;
+    r[PHY_CTRL4]     = gCcaCCA_MODE1_c << cPHY_CTRL4_CCATYPE_Shift_c;
+    r[PLL_INT0]      = 0x0B;
+    r[PLL_FRAC0_MSB] = 0x28;
+    r[CLK_OUT_CTRL]  = cCLK_OUT_EXTEND | cCLK_OUT_EN | gCLK_OUT_FREQ_4_MHz;
+    r[PWR_MODES]     = cPWR_MODES_XTALEN | cPWR_MODES_PMC_MODE;
+
+    for( i = 0; i < 2; i++ )
+    {
+        ir[MACPANID0_LSB + i] = 0xFF;
+        ir[MACSHORTADDRS0_LSB + i] = 0xFF;
+        ir[MACPANID1_LSB + i] = 0xFF;
+        ir[MACSHORTADDRS1_LSB + i] = 0xFF;
+    }
+
+    ir[RX_FRAME_FILTER] = cRX_FRAME_FLT_FRM_VER | cRX_FRAME_FLT_CMD_FT |
+                          cRX_FRAME_FLT_DATA_FT | cRX_FRAME_FLT_BEACON_FT;
+    ir[PLL_INT1]       = 0x0B;
+    ir[PLL_FRAC1_MSB]  = 0x28;
+    ir[CCA1_THRESH]    = 0x4B;
+    ir[TMR_PRESCALE]   = 0x05;
+    ir[RX_WTR_MARK]    = 0xFF;
+
+    pNode->txLength = 0;
+    pNode->samValid = 0;
+    pNode->irqForced = FALSE;
+    pNode->phase = mSimPhaseIdle_c;
+    pNode->phaseEnd = mSimNever_c;
+    pNode->tmrBase = mSimTime;
+    pNode->tmrBaseValue = 0;
+
+    for( i = 0; i < 4; i++ )
+    {
+        pNode->tmrMatch[i] = mSimNever_c;
+    }
+}
+
+/******************************************************************************
+ * The SimRand() function returns the next value of a LCG, for link loss and
+ * the RNG register.
+ ******************************************************************************/
+static uint32_t SimRand( void )
+{
+    mSimRandState = mSimRandState * 1103515245u + 12345u;
+    return mSimRandState >> 16;
+}
+
+/******************************************************************************
+ * The SimSpiTransfer() function accounts an SPI transfer of the active node
+ * and lets the transceivers run for the duration of the transfer.
+ ******************************************************************************/
+static void SimSpiTransfer( uint32_t bytes, uint32_t byteTime )
+{
+    simNode_t *pNode = &mSimNode[mSimActive];
+
+    pNode->stats.spiTransfers++;
+    pNode->stats.spiBytes += bytes;
+
+    if( pNode->inIsr )
+    {
+        pNode->stats.isrSpiTransfers++;
+    }
+
+    SimProcessUntil(mSimTime + (uint64_t)bytes * byteTime);
+}
+
+/******************************************************************************
+ * The SimProcessUntil() function handles, in time order, every sequencer and
+ * comparator event due until the given time, then moves the clock there.
+ * No ISR is called from here.
+ ******************************************************************************/
+static void SimProcessUntil( uint64_t time )
+{
+    uint64_t next;
+    uint8_t node, idx;
+
+    while( SimNextEvent(&next, &node, &idx) && (next <= time) )
+    {
+        if( next > mSimTime )
+        {
+            mSimTime = next;
+        }
+
+        if( idx == mSimTimerIdx_c )
+        {
+            SimPhaseEnd(&mSimNode[node]);
+        }
+        else
+        {
+            SimTimerMatch(&mSimNode[node], idx);
+        }
+    }
+
+    if( time > mSimTime )
+    {
+        mSimTime = time;
+    }
+}
+
+/******************************************************************************
+ * The SimNextEvent() function returns the earliest pending event: the end of
+ * a sequencer phase (idx mSimTimerIdx_c) or a comparator match (idx 0-3).
+ ******************************************************************************/
+static bool_t SimNextEvent( uint64_t *pTime, uint8_t *pNode, uint8_t *pIdx )
+{
+    uint64_t best = mSimNever_c;
+    uint8_t n, i;
+
+    for( n = 0; n < gMCR20SimMaxNodes_c; n++ )
+    {
+        if( mSimNode[n].phaseEnd < best )
+        {
+            best = mSimNode[n].phaseEnd;
+            *pNode = n;
+            *pIdx = mSimTimerIdx_c;
+        }
+
+        for( i = 0; i < 4; i++ )
+        {
+            if( mSimNode[n].tmrMatch[i] < best )
+            {
+                best = mSimNode[n].tmrMatch[i];
+                *pNode = n;
+                *pIdx = i;
+            }
+        }
+    }
+
+    *pTime = best;
+    return (best != mSimNever_c);
+}
+
+/******************************************************************************
+ * The SimDispatchIrqs() function calls the ISR of every node whose IRQ_B line
+ * is asserted (or whose pin was forced pending) while its IRQ is enabled. The
+ * line is level sensitive: the ISR is called again as long as it stays low.
+ ******************************************************************************/
+static void SimDispatchIrqs( void )
+{
+    simNode_t *pNode;
+    uint64_t start, duration;
+    uint32_t spiTransfers;
+    uint8_t prevActive;
+    uint8_t n, loops;
+
+    for( n = 0; n < gMCR20SimMaxNodes_c; n++ )
+    {
+        pNode = &mSimNode[n];
+
+        for( loops = 0; loops < mSimMaxIsrLoops_c; loops++ )
+        {
+            if( !pNode->pfIrqHandler || pNode->inIsr || pNode->irqDisableCnt ||
+                !(pNode->irqForced || SimIrqLine(pNode)) )
+            {
+                break;
+            }
+
+            prevActive = mSimActive;
+            mSimActive = n;
+            pNode->inIsr = TRUE;
+            start = mSimTime;
+            spiTransfers = pNode->stats.isrSpiTransfers;
+
+            pNode->pfIrqHandler();
+
+            duration = mSimTime - start;
+            spiTransfers = pNode->stats.isrSpiTransfers - spiTransfers;
+            pNode->inIsr = FALSE;
+            mSimActive = prevActive;
+
+            pNode->stats.isrCount++;
+            pNode->stats.isrTime += duration;
+
+            if( duration > pNode->stats.isrMaxTime )
+            {
+                pNode->stats.isrMaxTime = (uint32_t)duration;
+            }
+
+            if( spiTransfers > pNode->stats.isrMaxSpiTransfers )
+            {
+                pNode->stats.isrMaxSpiTransfers = spiTransfers;
+            }
+        }
+    }
+}
+
+/******************************************************************************
+ * The SimIrqLine() function returns TRUE when IRQ_B is asserted: an unmasked
+ * flag is set in IRQSTS1, IRQSTS2 or IRQSTS3 and TRCV_MSK is clear.
+ ******************************************************************************/
+static bool_t SimIrqLine( simNode_t *pNode )
+{
+    uint8_t *r = pNode->dreg;
+
+    if( (pNode->phase == mSimPhaseReset_c) || (r[PHY_CTRL4] & cPHY_CTRL4_TRCV_MSK) )
+    {
+        return FALSE;
+    }
+
+    /* IRQSTS1 flags and PHY_CTRL2 masks share the bit positions */
+    if( r[IRQSTS1] & ~r[PHY_CTRL2] & 0x7F )
+    {
+        return TRUE;
+    }
+
+    /* WAKE, PB_ERR and ASM flags and masks share the bit positions too */
+    if( r[IRQSTS2] & ~r[PHY_CTRL3] & (cIRQSTS2_ASM_IRQ | cIRQSTS2_PB_ERR_IRQ | cIRQSTS2_WAKE_IRQ) )
+    {
+        return TRUE;
+    }
+
+    /* TMRxIRQ in the low nibble, TMRxMSK in the high one */
+    if( r[IRQSTS3] & ~(r[IRQSTS3] >> 4) & 0x0F )
+    {
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/******************************************************************************
+ * The SimReadDirect() function returns a direct register. The event timer and
+ * SEQ_STATE are computed, everything else comes from the register file.
+ ******************************************************************************/
+static uint8_t SimReadDirect( simNode_t *pNode, uint8_t addr )
+{
+    switch( addr )
+    {
+    case EVENT_TMR_LSB:
+    case EVENT_TMR_MSB:
+    case EVENT_TMR_USB:
+        return (uint8_t)(SimTimerValue(pNode, mSimTime) >> (8 * (addr - EVENT_TMR_LSB)));
+
+    case SEQ_STATE:
+        return (pNode->phase == mSimPhaseReset_c) ? 0 : (uint8_t)pNode->phase;
+
+    case IAR_DATA:
+        return SimReadIndirect(pNode, pNode->dreg[IAR_INDEX]);
+
+    default:
+        return pNode->dreg[addr];
+    }
+}
+
+/******************************************************************************
+ * The SimWriteDirect() function writes a direct register: interrupt flags are
+ * write 1 to clear, PHY_CTRL1 starts and aborts sequences, SRC_CTRL updates
+ * the source address table and TMRLOAD loads the event timer from T1CMP.
+ ******************************************************************************/
+static void SimWriteDirect( simNode_t *pNode, uint8_t addr, uint8_t value )
+{
+    uint8_t *r = pNode->dreg;
+    uint8_t old = r[addr];
+    uint8_t index;
+
+    switch( addr )
+    {
+    case IRQSTS1:
+        r[IRQSTS1] &= ~(value & 0x7F);
+        break;
+
+    case IRQSTS2:
+        r[IRQSTS2] &= ~(value & (cIRQSTS2_ASM_IRQ | cIRQSTS2_PB_ERR_IRQ | cIRQSTS2_WAKE_IRQ));
+        break;
+
+    case IRQSTS3:
+        r[IRQSTS3] = (value & 0xF0) | (old & 0x0F & ~value);
+        break;
+
+    case PHY_CTRL1:
+        r[PHY_CTRL1] = value;
+
+        if( (value & cPHY_CTRL1_XCVSEQ) == gIdle_c )
+        {
+            /* Abort a running sequence */
+            if( (pNode->phase != mSimPhaseIdle_c) && (pNode->phase != mSimPhaseReset_c) )
+            {
+                SimSequenceDone(pNode);
+            }
+        }
+        else if( ((old & cPHY_CTRL1_XCVSEQ) == gIdle_c) && (pNode->phase == mSimPhaseIdle_c) )
+        {
+            if( value & cPHY_CTRL1_TMRTRIGEN )
+            {
+                SimSetPhase(pNode, mSimPhaseTrigger_c, mSimNever_c);
+            }
+            else
+            {
+                SimSetPhase(pNode, mSimPhaseWarmUp_c, gPhyWarmUpTime_c * mSimSymbolTime_c);
+            }
+        }
+        break;
+
+    case RX_FRM_LEN:
+    case SEQ_STATE:
+    case LQI_VALUE:
+    case CCA1_ED_FNL:
+    case TIMESTAMP_LSB:
+    case TIMESTAMP_MSB:
+    case TIMESTAMP_USB:
+    case EVENT_TMR_LSB:
+    case EVENT_TMR_MSB:
+    case EVENT_TMR_USB:
+        /* read only */
+        break;
+
+    case PHY_CTRL4:
+        r[PHY_CTRL4] = value & ~cPHY_CTRL4_TMRLOAD;
+
+        if( value & cPHY_CTRL4_TMRLOAD )
+        {
+            pNode->tmrBase = mSimTime;
+            pNode->tmrBaseValue = r[T1CMP_LSB] | (r[T1CMP_MSB] << 8) | ((uint32_t)r[T1CMP_USB] << 16);
+        }
+        break;
+
+    case SRC_CTRL:
+        r[SRC_CTRL] = value & ~(cSRC_CTRL_INDEX_EN | cSRC_CTRL_INDEX_DISABLE);
+        index = (value >> cSRC_CTRL_INDEX_Shift_c) & cSRC_CTRL_INDEX;
+
+        if( value & cSRC_CTRL_INDEX_EN )
+        {
+            pNode->sam[index] = r[SRC_ADDRS_SUM_LSB] | (r[SRC_ADDRS_SUM_MSB] << 8);
+            pNode->samValid |= (1 << index);
+        }
+
+        if( value & cSRC_CTRL_INDEX_DISABLE )
+        {
+            pNode->samValid &= ~(1 << index);
+        }
+        break;
+
+    case PWR_MODES:
+        r[PWR_MODES] = (value & ~cPWR_MODES_XTAL_READY) | (old & cPWR_MODES_XTAL_READY);
+
+        if( (value & cPWR_MODES_XTALEN) && !(old & cPWR_MODES_XTALEN) )
+        {
+            /* Wake up from hibernate */
+            r[PWR_MODES] |= cPWR_MODES_XTAL_READY;
+            r[IRQSTS2] |= cIRQSTS2_WAKE_IRQ | cIRQSTS2_TMRSTATUS;
+        }
+        else if( !(value & cPWR_MODES_XTALEN) )
+        {
+            r[PWR_MODES] &= ~cPWR_MODES_XTAL_READY;
+            r[IRQSTS2] &= ~cIRQSTS2_TMRSTATUS;
+        }
+        break;
+
+    case IAR_DATA:
+        SimWriteIndirect(pNode, r[IAR_INDEX], value);
+        break;
+
+    default:
+        r[addr] = value;
+        break;
+    }
+}
+
+/******************************************************************************
+ * The SimReadIndirect() function returns an indirect register.
+ ******************************************************************************/
+static uint8_t SimReadIndirect( simNode_t *pNode, uint8_t addr )
+{
+    if( addr == _RNG )
+    {
+        return (uint8_t)SimRand();
+    }
+
+    return pNode->ireg[addr];
+}
+
+/******************************************************************************
+ * The SimWriteIndirect() function writes an indirect register. SOG_RST
+ * reloads the reset values of all registers.
+ ******************************************************************************/
+static void SimWriteIndirect( simNode_t *pNode, uint8_t addr, uint8_t value )
+{
+    switch( addr )
+    {
+    case _RNG:
+    case DUAL_PAN_STS:
+        /* read only */
+        break;
+
+    case SOFT_RESET:
+        if( value & cSOFT_RESET_SOG_RST )
+        {
+            SimResetNode(pNode);
+            pNode->dreg[PWR_MODES] |= cPWR_MODES_XTAL_READY;
+        }
+        break;
+
+    default:
+        pNode->ireg[addr] = value;
+        break;
+    }
+}
+
+/******************************************************************************
+ * The SimTimerValue() function returns the event timer [symbols] at a time.
+ ******************************************************************************/
+static uint32_t SimTimerValue( simNode_t *pNode, uint64_t time )
+{
+    return (uint32_t)(pNode->tmrBaseValue + (time - pNode->tmrBase) / mSimSymbolTime_c) & mSimTimerMask_c;
+}
+
+/******************************************************************************
+ * The SimUpdateTimers() function computes when each enabled comparator will
+ * next match the event timer. A compare value equal to the current count
+ * matches after a full wrap, since the hardware compares on timer updates.
+ ******************************************************************************/
+static void SimUpdateTimers( simNode_t *pNode )
+{
+    static const uint8_t cmpReg[4] = { T1CMP_LSB, T2CMP_LSB, T3CMP_LSB, T4CMP_LSB };
+    uint8_t *r = pNode->dreg;
+    uint64_t ticks = (mSimTime - pNode->tmrBase) / mSimSymbolTime_c;
+    uint32_t cur = (uint32_t)(pNode->tmrBaseValue + ticks);
+    uint32_t cmp, mask, delta;
+    uint8_t i;
+
+    for( i = 0; i < 4; i++ )
+    {
+        if( !(r[PHY_CTRL3] & (cPHY_CTRL3_TMR1CMP_EN << i)) )
+        {
+            pNode->tmrMatch[i] = mSimNever_c;
+            continue;
+        }
+
+        if( (i == 1) && (r[PHY_CTRL4] & cPHY_CTRL4_TC2PRIME_EN) )
+        {
+            cmp = r[T2PRIMECMP_LSB] | (r[T2PRIMECMP_MSB] << 8);
+            mask = mSimTimer2PrimeMask_c;
+        }
+        else
+        {
+            cmp = r[cmpReg[i]] | (r[cmpReg[i] + 1] << 8) | ((uint32_t)r[cmpReg[i] + 2] << 16);
+            mask = mSimTimerMask_c;
+        }
+
+        delta = (cmp - cur) & mask;
+
+        if( delta == 0 )
+        {
+            delta = mask + 1;
+        }
+
+        pNode->tmrMatch[i] = pNode->tmrBase + (ticks + delta) * mSimSymbolTime_c;
+    }
+}
+
+/******************************************************************************
+ * The SimTimerMatch() function handles a comparator match: the TMRxIRQ flag
+ * is set, T2 starts a sequence waiting for its trigger and T3 aborts RX and
+ * TR sequences when TC3TMOUT is set.
+ ******************************************************************************/
+static void SimTimerMatch( simNode_t *pNode, uint8_t idx )
+{
+    uint8_t seq = pNode->dreg[PHY_CTRL1] & cPHY_CTRL1_XCVSEQ;
+
+    pNode->dreg[IRQSTS3] |= (cIRQSTS3_TMR1IRQ << idx);
+    pNode->tmrMatch[idx] = mSimNever_c;
+    SimUpdateTimers(pNode);
+
+    if( (idx == 1) && (pNode->phase == mSimPhaseTrigger_c) )
+    {
+        SimSetPhase(pNode, mSimPhaseWarmUp_c, gPhyWarmUpTime_c * mSimSymbolTime_c);
+    }
+    else if( (idx == 2) && (pNode->dreg[PHY_CTRL4] & cPHY_CTRL4_TC3TMOUT) &&
+             ((seq == gRX_c) || (seq == gTR_c)) )
+    {
+        switch( pNode->phase )
+        {
+        case mSimPhaseTrigger_c:
+        case mSimPhaseWarmUp_c:
+        case mSimPhaseListen_c:
+        case mSimPhaseAckWait_c:
+        case mSimPhaseRxFrame_c:
+            SimSequenceDone(pNode);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+/******************************************************************************
+ * The SimSetPhase() function moves the sequencer of a node to a new phase,
+ * which ends after the given duration [ns] (mSimNever_c for no end).
+ ******************************************************************************/
+static void SimSetPhase( simNode_t *pNode, simPhase_t phase, uint64_t duration )
+{
+    pNode->phase = phase;
+    pNode->phaseStart = mSimTime;
+    pNode->phaseEnd = (duration == mSimNever_c) ? mSimNever_c : mSimTime + duration;
+}
+
+/******************************************************************************
+ * The SimSequenceDone() function ends the current sequence with SEQIRQ.
+ ******************************************************************************/
+static void SimSequenceDone( simNode_t *pNode )
+{
+    SimSetPhase(pNode, mSimPhaseIdle_c, mSimNever_c);
+    pNode->dreg[IRQSTS1] |= cIRQSTS1_SEQIRQ;
+}
+
+/******************************************************************************
+ * The SimPhaseEnd() function moves the sequencer on when a phase expires.
+ ******************************************************************************/
+static void SimPhaseEnd( simNode_t *pNode )
+{
+    uint8_t *r = pNode->dreg;
+    uint8_t seq = r[PHY_CTRL1] & cPHY_CTRL1_XCVSEQ;
+    uint8_t ack[mSimAckLength_c];
+    uint8_t energy;
+    bool_t busy;
+
+    switch( pNode->phase )
+    {
+    case mSimPhaseReset_c:
+        /* POR completed */
+        r[IRQSTS2] |= cIRQSTS2_WAKE_IRQ | cIRQSTS2_TMRSTATUS;
+        r[PWR_MODES] |= cPWR_MODES_XTAL_READY;
+        SimSetPhase(pNode, mSimPhaseIdle_c, mSimNever_c);
+        break;
+
+    case mSimPhaseWarmUp_c:
+        if( seq == gRX_c )
+        {
+            SimSetPhase(pNode, mSimPhaseListen_c, mSimNever_c);
+        }
+        else if( seq == gCCCA_c )
+        {
+            SimSetPhase(pNode, mSimPhaseCcca_c, mSimSymbolTime_c);
+        }
+        else if( (seq == gCCA_c) || (r[PHY_CTRL1] & cPHY_CTRL1_CCABFRTX) )
+        {
+            SimSetPhase(pNode, mSimPhaseCca_c, mSimCcaTime_c * mSimSymbolTime_c);
+        }
+        else if( (seq == gTX_c) || (seq == gTR_c) )
+        {
+            SimTransmit(pNode, pNode->pb, pNode->txLength, mSimPhaseTx_c);
+        }
+        else
+        {
+            SimSetPhase(pNode, mSimPhaseIdle_c, mSimNever_c);
+        }
+        break;
+
+    case mSimPhaseCca_c:
+        energy = SimEnergy(pNode, pNode->phaseStart, mSimTime);
+        busy = (energy < pNode->ireg[CCA1_THRESH]);
+        r[CCA1_ED_FNL] = energy;
+
+        if( ((r[PHY_CTRL4] >> cPHY_CTRL4_CCATYPE_Shift_c) & cPHY_CTRL4_CCATYPE) == gCcaED_c )
+        {
+            busy = FALSE;
+            r[IRQSTS2] &= ~cIRQSTS2_CCA;
+        }
+        else
+        {
+            r[IRQSTS2] = busy ? (r[IRQSTS2] | cIRQSTS2_CCA) : (r[IRQSTS2] & ~cIRQSTS2_CCA);
+            r[IRQSTS1] |= cIRQSTS1_CCAIRQ;
+        }
+
+        if( (seq == gCCA_c) || busy )
+        {
+            SimSequenceDone(pNode);
+        }
+        else
+        {
+            SimSetPhase(pNode, mSimPhaseTxTurnaround_c, gPhyTurnaroundTime_c * mSimSymbolTime_c);
+        }
+        break;
+
+    case mSimPhaseCcca_c:
+        if( SimEnergy(pNode, mSimTime - mSimSymbolTime_c, mSimTime) < pNode->ireg[CCA1_THRESH] )
+        {
+            pNode->phaseEnd += mSimSymbolTime_c;
+        }
+        else
+        {
+            r[IRQSTS2] &= ~cIRQSTS2_CCA;
+            r[IRQSTS1] |= cIRQSTS1_CCAIRQ;
+            SimSequenceDone(pNode);
+        }
+        break;
+
+    case mSimPhaseTxTurnaround_c:
+        SimTransmit(pNode, pNode->pb, pNode->txLength, mSimPhaseTx_c);
+        break;
+
+    case mSimPhaseTx_c:
+        r[IRQSTS1] |= cIRQSTS1_TXIRQ;
+
+        if( (seq == gTR_c) && (r[PHY_CTRL1] & cPHY_CTRL1_RXACKRQD) &&
+            (pNode->pb[0] & mSimFcfAckRequest_c) )
+        {
+            pNode->ackDsn = pNode->pb[2];
+            SimSetPhase(pNode, mSimPhaseAckWait_c, mSimNever_c);
+        }
+        else
+        {
+            SimSequenceDone(pNode);
+        }
+        break;
+
+    case mSimPhaseRxFrame_c:
+        SimFrameReceived(pNode);
+        break;
+
+    case mSimPhaseAckTurnaround_c:
+        ack[0] = mSimFrameAck_c | (pNode->ackFp ? mSimFcfFramePending_c : 0);
+        ack[1] = 0;
+        ack[2] = pNode->ackDsn;
+        ack[3] = 0;
+        ack[4] = 0;
+        SimTransmit(pNode, ack, mSimAckLength_c, mSimPhaseAckTx_c);
+        break;
+
+    case mSimPhaseAckTx_c:
+        r[IRQSTS1] |= cIRQSTS1_TXIRQ;
+        SimSequenceDone(pNode);
+        break;
+
+    default:
+        pNode->phaseEnd = mSimNever_c;
+        break;
+    }
+}
+
+/******************************************************************************
+ * The SimTransmit() function puts a frame on air and locks every node
+ * listening on the same channel on it.
+ ******************************************************************************/
+static void SimTransmit( simNode_t *pNode, const uint8_t *pPsdu, uint8_t length, simPhase_t phase )
+{
+    simFrame_t *pFrame = &mSimMedium[mSimMediumNext];
+    uint8_t slot = mSimMediumNext;
+    uint8_t self = (uint8_t)(pNode - mSimNode);
+    simNode_t *pRx;
+    uint8_t n;
+
+    if( (length < mSimFcsLength_c + 1) || (length > gMaxPHYPacketSize_c) )
+    {
+        /* Nothing valid in the PB, the sequence completes without a frame */
+        SimSetPhase(pNode, phase, gPhySHRDuration_c * mSimSymbolTime_c);
+        return;
+    }
+
+    mSimMediumNext = (mSimMediumNext + 1) % gMCR20SimMaxFrames_c;
+    pFrame->start = mSimTime;
+    pFrame->end = mSimTime + (uint64_t)(gPhySHRDuration_c + (length + 1) * gPhySymbolsPerOctet_c) * mSimSymbolTime_c;
+    pFrame->node = self;
+    pFrame->channel = SimChannel(pNode);
+    pFrame->length = length;
+    FLib_MemCpy(pFrame->psdu, (void *)pPsdu, length - mSimFcsLength_c);
+    pFrame->psdu[length - 2] = 0;
+    pFrame->psdu[length - 1] = 0;
+
+    SimSetPhase(pNode, phase, pFrame->end - mSimTime);
+    pNode->stats.txFrames++;
+
+    for( n = 0; n < gMCR20SimMaxNodes_c; n++ )
+    {
+        pRx = &mSimNode[n];
+
+        if( (n != self) &&
+            ((pRx->phase == mSimPhaseListen_c) || (pRx->phase == mSimPhaseAckWait_c)) &&
+            (SimChannel(pRx) == pFrame->channel) )
+        {
+            pRx->listenPhase = pRx->phase;
+            pRx->rxFrame = slot;
+            pRx->phase = mSimPhaseRxFrame_c;
+            pRx->phaseEnd = pFrame->end;
+        }
+    }
+}
+
+/******************************************************************************
+ * The SimFrameReceived() function runs at the end of a frame a node locked
+ * on. Collided and lost frames are dropped, ACKs complete TR sequences and
+ * other frames go through the address filter and may be acknowledged.
+ ******************************************************************************/
+static void SimFrameReceived( simNode_t *pNode )
+{
+    const simFrame_t *pFrame = &mSimMedium[pNode->rxFrame];
+    uint8_t self = (uint8_t)(pNode - mSimNode);
+    uint8_t *r = pNode->dreg;
+    uint16_t fcf = pFrame->psdu[0] | (pFrame->psdu[1] << 8);
+    uint16_t sum = 0;
+    uint32_t timestamp;
+    bool_t poll = FALSE;
+    bool_t lost = FALSE;
+    uint8_t i, lqi;
+
+    for( i = 0; i < gMCR20SimMaxFrames_c; i++ )
+    {
+        if( (i != pNode->rxFrame) && mSimMedium[i].length &&
+            (mSimMedium[i].channel == pFrame->channel) &&
+            (mSimMedium[i].start < pFrame->end) && (mSimMedium[i].end > pFrame->start) )
+        {
+            lost = TRUE;
+        }
+    }
+
+    if( !lost && mSimLinkLoss[pFrame->node][self] )
+    {
+        lost = ((SimRand() % 100) < mSimLinkLoss[pFrame->node][self]);
+    }
+
+    if( lost )
+    {
+        pNode->stats.rxDropped++;
+        SimSetPhase(pNode, pNode->listenPhase, mSimNever_c);
+        return;
+    }
+
+    if( pNode->listenPhase == mSimPhaseAckWait_c )
+    {
+        if( (mSimFcfType_c(fcf) != mSimFrameAck_c) || (pFrame->length != mSimAckLength_c) ||
+            (pFrame->psdu[2] != pNode->ackDsn) )
+        {
+            SimSetPhase(pNode, mSimPhaseAckWait_c, mSimNever_c);
+            return;
+        }
+    }
+    else if( !SimFilter(pNode, pFrame, &poll, &sum) )
+    {
+        r[IRQSTS1] |= cIRQSTS1_FILTERFAIL_IRQ;
+        pNode->stats.filterFail++;
+        SimSetPhase(pNode, mSimPhaseListen_c, mSimNever_c);
+        return;
+    }
+
+    /* Frame accepted */
+    pNode->stats.rxFrames++;
+    lqi = mSimLinkLqi[pFrame->node][self];
+    FLib_MemCpy(pNode->pb, (void *)pFrame->psdu, pFrame->length);
+    timestamp = SimTimerValue(pNode, pFrame->start + gPhySHRDuration_c * mSimSymbolTime_c);
+
+    r[RX_FRM_LEN] = pFrame->length;
+    r[LQI_VALUE] = lqi;
+    r[TIMESTAMP_LSB] = (uint8_t)timestamp;
+    r[TIMESTAMP_MSB] = (uint8_t)(timestamp >> 8);
+    r[TIMESTAMP_USB] = (uint8_t)(timestamp >> 16);
+    r[IRQSTS1] |= cIRQSTS1_RXIRQ;
+    r[IRQSTS2] |= cIRQSTS2_CRCVALID;
+    r[IRQSTS2] &= ~(cIRQSTS2_PI | cIRQSTS2_SRCADDR);
+
+    if( pNode->listenPhase == mSimPhaseAckWait_c )
+    {
+        r[IRQSTS1] = (fcf & mSimFcfFramePending_c) ? (r[IRQSTS1] | cIRQSTS1_RX_FRM_PEND) :
+                                                     (r[IRQSTS1] & ~cIRQSTS1_RX_FRM_PEND);
+        SimSequenceDone(pNode);
+        return;
+    }
+
+    /* Frame pending bit of the ACK: from the source address table for polls */
+    pNode->ackFp = ((r[SRC_CTRL] & cSRC_CTRL_ACK_FRM_PND) != 0);
+
+    if( poll )
+    {
+        r[IRQSTS2] |= cIRQSTS2_PI;
+
+        if( r[SRC_CTRL] & cSRC_CTRL_SRCADDR_EN )
+        {
+            pNode->ackFp = FALSE;
+
+            for( i = 0; i < mSimSamSize_c; i++ )
+            {
+                if( (pNode->samValid & (1 << i)) && (pNode->sam[i] == sum) )
+                {
+                    r[IRQSTS2] |= cIRQSTS2_SRCADDR;
+                    pNode->ackFp = TRUE;
+                    break;
+                }
+            }
+        }
+    }
+
+    if( (r[PHY_CTRL1] & cPHY_CTRL1_AUTOACK) && (fcf & mSimFcfAckRequest_c) &&
+        (mSimFcfType_c(fcf) != mSimFrameAck_c) )
+    {
+        pNode->ackDsn = pFrame->psdu[2];
+        SimSetPhase(pNode, mSimPhaseAckTurnaround_c, gPhyTurnaroundTime_c * mSimSymbolTime_c);
+    }
+    else
+    {
+        SimSequenceDone(pNode);
+    }
+}
+
+/******************************************************************************
+ * The SimFilter() function applies the RX frame filter: frame version and
+ * type, destination PAN and address of the enabled PANs, promiscuous mode.
+ * It also reports data request commands and the checksum of their source.
+ ******************************************************************************/
+static bool_t SimFilter( simNode_t *pNode, const simFrame_t *pFrame, bool_t *pPoll, uint16_t *pSum )
+{
+    const uint8_t *p = pFrame->psdu;
+    uint8_t *ir = pNode->ireg;
+    uint8_t filter = ir[RX_FRAME_FILTER];
+    uint8_t macLength = pFrame->length - mSimFcsLength_c;
+    uint16_t fcf = p[0] | (p[1] << 8);
+    uint8_t type = mSimFcfType_c(fcf);
+    uint8_t version = mSimFcfVersion_c(fcf);
+    uint8_t dstMode = mSimFcfDstMode_c(fcf);
+    uint8_t srcMode = mSimFcfSrcMode_c(fcf);
+    uint16_t dstPan = mSimBroadcast_c, srcPan = mSimBroadcast_c, dstShort = 0, panId, shortAddr;
+    const uint8_t *pDstExt = NULL;
+    const uint8_t *pSrc = NULL;
+    uint8_t idx = 3, pan, base, i;
+    bool_t coordinator;
+
+    if( pNode->dreg[PHY_CTRL4] & cPHY_CTRL4_PROMISCUOUS )
+    {
+        return TRUE;
+    }
+
+    if( (macLength < 3) || (version > 1) || !(filter & (1 << (cRX_FRAME_FLT_FRM_VER_Shift_c + version))) )
+    {
+        return FALSE;
+    }
+
+    if( !(filter & ((type <= mSimFrameCmd_c) ? (1 << type) : cRX_FRAME_FLT_NS_FT)) )
+    {
+        return FALSE;
+    }
+
+    if( dstMode )
+    {
+        dstPan = p[idx] | (p[idx + 1] << 8);
+        idx += 2;
+
+        if( dstMode == mSimAddrShort_c )
+        {
+            dstShort = p[idx] | (p[idx + 1] << 8);
+            idx += 2;
+        }
+        else
+        {
+            pDstExt = &p[idx];
+            idx += 8;
+        }
+    }
+
+    if( srcMode )
+    {
+        if( (fcf & mSimFcfPanIdComp_c) && dstMode )
+        {
+            srcPan = dstPan;
+        }
+        else
+        {
+            srcPan = p[idx] | (p[idx + 1] << 8);
+            idx += 2;
+        }
+
+        pSrc = &p[idx];
+        idx += (srcMode == mSimAddrShort_c) ? 2 : 8;
+    }
+
+    if( idx > macLength )
+    {
+        return FALSE;
+    }
+
+    *pPoll = (type == mSimFrameCmd_c) && (idx < macLength) && (p[idx] == mSimCmdDataRequest_c);
+
+    if( *pPoll && pSrc )
+    {
+        *pSum = srcPan;
+
+        for( i = 0; i < ((srcMode == mSimAddrShort_c) ? 2 : 8); i += 2 )
+        {
+            *pSum += pSrc[i] | (pSrc[i + 1] << 8);
+        }
+    }
+
+    for( pan = 0; pan < 2; pan++ )
+    {
+        if( !SimPanSelected(pNode, pan) )
+        {
+            continue;
+        }
+
+        base = pan ? MACPANID1_LSB : MACPANID0_LSB;
+        panId = ir[base] | (ir[base + 1] << 8);
+        shortAddr = ir[base + 2] | (ir[base + 3] << 8);
+        coordinator = pan ? ((ir[DUAL_PAN_CTRL] & cDUAL_PAN_CTRL_PANCORDNTR1) != 0) :
+                            ((pNode->dreg[PHY_CTRL4] & cPHY_CTRL4_PANCORDNTR0) != 0);
+
+        if( dstMode )
+        {
+            if( (dstPan != mSimBroadcast_c) && (dstPan != panId) )
+            {
+                continue;
+            }
+
+            if( pDstExt ? !FLib_MemCmp((void *)pDstExt, &ir[base + 4], 8) :
+                          ((dstShort != mSimBroadcast_c) && (dstShort != shortAddr)) )
+            {
+                continue;
+            }
+        }
+        else if( type == mSimFrameBeacon_c )
+        {
+            if( (panId != mSimBroadcast_c) && (srcPan != panId) )
+            {
+                continue;
+            }
+        }
+        else if( !coordinator || (srcPan != panId) )
+        {
+            continue;
+        }
+
+        ir[DUAL_PAN_STS] = (ir[DUAL_PAN_STS] & cDUAL_PAN_STS_DUAL_PAN_REMAIN) |
+                           (pan ? cDUAL_PAN_STS_RECD_ON_PAN1 : cDUAL_PAN_STS_RECD_ON_PAN0);
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+/******************************************************************************
+ * The SimPanSelected() function returns TRUE if the filter accepts frames
+ * for PAN 0 or 1: both in dual PAN auto mode, otherwise the active one.
+ ******************************************************************************/
+static bool_t SimPanSelected( simNode_t *pNode, uint8_t pan )
+{
+    if( pNode->ireg[DUAL_PAN_CTRL] & cDUAL_PAN_CTRL_DUAL_PAN_AUTO )
+    {
+        return TRUE;
+    }
+
+    return (SimActivePan(pNode) == pan);
+}
+
+/******************************************************************************
+ * The SimActivePan() function returns the PAN whose channel the radio uses.
+ ******************************************************************************/
+static uint8_t SimActivePan( simNode_t *pNode )
+{
+    uint8_t ctrl = pNode->ireg[DUAL_PAN_CTRL];
+
+    if( ctrl & cDUAL_PAN_CTRL_DUAL_PAN_AUTO )
+    {
+        return (ctrl & cDUAL_PAN_CTRL_CURRENT_NETWORK) ? 1 : 0;
+    }
+
+    return (ctrl & cDUAL_PAN_CTRL_ACTIVE_NETWORK) ? 1 : 0;
+}
+
+/******************************************************************************
+ * The SimChannel() function converts the PLL settings of the active PAN back
+ * to a channel number (see pll_int[] and pll_frac[] in PhyPlmeData.c).
+ ******************************************************************************/
+static uint8_t SimChannel( simNode_t *pNode )
+{
+    uint32_t pllInt, pllFrac;
+
+    if( SimActivePan(pNode) )
+    {
+        pllInt = pNode->ireg[PLL_INT1];
+        pllFrac = pNode->ireg[PLL_FRAC1_LSB] | (pNode->ireg[PLL_FRAC1_MSB] << 8);
+    }
+    else
+    {
+        pllInt = pNode->dreg[PLL_INT0];
+        pllFrac = pNode->dreg[PLL_FRAC0_LSB] | (pNode->dreg[PLL_FRAC0_MSB] << 8);
+    }
+
+    pllInt &= 0x1F;
+
+    if( pllInt < 0x0B )
+    {
+        return 0;
+    }
+
+    return (uint8_t)(mSimFirstChannel_c + ((pllInt - 0x0B) * 0x10000 + pllFrac) / 0x2800 - 1);
+}
+
+/******************************************************************************
+ * The SimEnergy() function returns the strongest energy [-dBm] seen by a node
+ * on its channel in an interval: background energy or frames of other nodes.
+ * The RSSI of a frame is derived from the link LQI as PhyConvertLQIToRSSI()
+ * does.
+ ******************************************************************************/
+static uint8_t SimEnergy( simNode_t *pNode, uint64_t from, uint64_t to )
+{
+    uint8_t self = (uint8_t)(pNode - mSimNode);
+    uint8_t channel = SimChannel(pNode);
+    uint8_t energy = mSimDefaultEnergy_c;
+    int32_t rssi;
+    uint8_t i;
+
+    if( (channel >= mSimFirstChannel_c) && (channel < mSimFirstChannel_c + mSimChannels_c) )
+    {
+        energy = mSimChannelEnergy[channel - mSimFirstChannel_c];
+    }
+
+    for( i = 0; i < gMCR20SimMaxFrames_c; i++ )
+    {
+        if( mSimMedium[i].length && (mSimMedium[i].node != self) &&
+            (mSimMedium[i].channel == channel) &&
+            (mSimMedium[i].start < to) && (mSimMedium[i].end > from) )
+        {
+            rssi = (50 * mSimLinkLqi[mSimMedium[i].node][self] - 16820) / 163;
+            rssi = (rssi > 0) ? 0 : -rssi;
+
+            if( rssi < energy )
+            {
+                energy = (uint8_t)rssi;
+            }
+        }
+    }
+
+    return energy;
+}
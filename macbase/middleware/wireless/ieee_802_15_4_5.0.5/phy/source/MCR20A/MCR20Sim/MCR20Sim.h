@@ -0,0 +1,158 @@
+/************************************************************************************
+* This module contains the public interface of the virtual MCR20A transceiver.
+*
+* MCR20Sim.c is a drop-in replacement for MCR20Drv.c on a workstation: it implements
+* every MCR20Drv_* entry point declared in MCR20Drv.h on top of a software model of
+* the MCR20A instead of SPI and GPIO accesses, so PhyISR.c, PhyPlmeData.c,
+* PhyStateMachine.c, PhyTime.c and PhyPacketProcessor.c build and run unmodified.
+*
+* Modelled: direct and indirect register files, IRQSTS1-3 (w1c) and PHY_CTRL1-4,
+* the packet buffer, the TX, RX, TR, CCA/ED and CCCA sequences with auto ACK and
+* address filtering, the event timer with the T1-T4 comparators (T2 trigger, T3
+* sequence timeout), POR/soft reset and the IRQ_B line.
+*
+* Several transceivers share one virtual medium: frames are only received by
+* nodes listening on the same channel, overlapping frames on a channel collide
+* and every link has its own loss rate and LQI. The MCR20Drv_* calls act on the
+* "active" node (node 0 by default, which is the one driven by the PHY).
+*
+* Time is virtual and counted in ns. Every SPI transfer costs the time it would
+* take on the bus, so PHY polling loops terminate and ISR path length can be
+* measured. Interrupts are raised by calling the IRQ handler of a node
+* (PHY_InterruptHandler() for node 0) from MCR20Sim_Advance(), i.e. never from
+* inside a MCR20Drv_* call, which mirrors an MCU that masks interrupts while the
+* PHY runs in thread context.
+*
+* The host test PhyIsrTest.c of msn_coordinator/host builds the PHY on this model
+* (make build/phy_isr_test) and reports its ISR profile.
+*
+************************************************************************************/
+#ifndef __MCR20_SIM_H__
+#define __MCR20_SIM_H__
+
+#include "EmbeddedTypes.h"
+#include "MCR20Drv.h"
+
+/************************************************************************************
+*************************************************************************************
+* Public macros
+*************************************************************************************
+************************************************************************************/
+
+/*! Number of transceivers sharing the virtual medium */
+#ifndef gMCR20SimMaxNodes_c
+#define gMCR20SimMaxNodes_c             (4)
+#endif
+
+/*! Number of frames remembered by the medium for collision detection */
+#ifndef gMCR20SimMaxFrames_c
+#define gMCR20SimMaxFrames_c            (32)
+#endif
+
+/*! Time [ns] to clock one byte over SPI (16 MHz writes, 8 MHz reads) */
+#ifndef gMCR20SimSpiWriteByteTime_c
+#define gMCR20SimSpiWriteByteTime_c     (500)
+#endif
+
+#ifndef gMCR20SimSpiReadByteTime_c
+#define gMCR20SimSpiReadByteTime_c      (1000)
+#endif
+
+/*! Raw LQI_VALUE reported by default on every link */
+#ifndef gMCR20SimDefaultLqi_c
+#define gMCR20SimDefaultLqi_c           (200)
+#endif
+
+/************************************************************************************
+*************************************************************************************
+* Public type definitions
+*************************************************************************************
+************************************************************************************/
+
+/*! Interrupt service routine of a node, called when its IRQ_B line is asserted */
+typedef void (*mcr20SimIrqHandler_t)(void);
+
+/*! Per node counters, used to profile the PHY */
+typedef struct mcr20SimStats_tag
+{
+    uint32_t    spiTransfers;     /*!< SPI transfers (CS assertions) */
+    uint32_t    spiBytes;         /*!< Bytes clocked over SPI, command bytes included */
+    uint32_t    isrCount;         /*!< IRQ handler invocations */
+    uint32_t    isrSpiTransfers;  /*!< SPI transfers made from the IRQ handler */
+    uint32_t    isrMaxSpiTransfers; /*!< Largest number of SPI transfers in one ISR */
+    uint64_t    isrTime;          /*!< Time [ns] spent in the IRQ handler */
+    uint32_t    isrMaxTime;       /*!< Longest ISR [ns] */
+    uint32_t    txFrames;         /*!< Frames put on air, ACKs included */
+    uint32_t    rxFrames;         /*!< Frames accepted, ACKs included */
+    uint32_t    rxDropped;        /*!< Frames lost to collisions or link loss */
+    uint32_t    filterFail;       /*!< Frames rejected by the address filter */
+} mcr20SimStats_t;
+
+/************************************************************************************
+*************************************************************************************
+* Public prototypes
+*************************************************************************************
+************************************************************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! *********************************************************************************
+* \brief  Resets the medium, the clock and all transceivers (as after power up).
+********************************************************************************** */
+void MCR20Sim_Init( void );
+
+/*! *********************************************************************************
+* \brief  Selects the transceiver the MCR20Drv_* calls act on.
+*
+* \return  the previously active node
+********************************************************************************** */
+uint8_t MCR20Sim_SetActiveNode( uint8_t node );
+
+/*! *********************************************************************************
+* \brief  Installs the ISR of a node. Node 0 defaults to PHY_InterruptHandler().
+********************************************************************************** */
+void MCR20Sim_SetIrqHandler( uint8_t node, mcr20SimIrqHandler_t pfHandler );
+
+/*! *********************************************************************************
+* \brief  Sets the loss [0-100 %] and the raw LQI of the link from one node to another.
+********************************************************************************** */
+void MCR20Sim_SetLink( uint8_t from, uint8_t to, uint8_t lossPercent, uint8_t lqi );
+
+/*! *********************************************************************************
+* \brief  Sets the background energy of a channel, in -dBm (90 = -90 dBm).
+********************************************************************************** */
+void MCR20Sim_SetChannelEnergy( uint8_t channel, uint8_t energy );
+
+/*! *********************************************************************************
+* \brief  Seeds the generator used for link loss and the RNG register.
+********************************************************************************** */
+void MCR20Sim_SetSeed( uint32_t seed );
+
+/*! *********************************************************************************
+* \brief  Advances the virtual time by the given amount [ns], running the sequencers
+*         and timers and calling the ISR of every node whose IRQ_B line is asserted
+*         and enabled.
+********************************************************************************** */
+void MCR20Sim_Advance( uint64_t ns );
+
+/*! *********************************************************************************
+* \brief  Returns the virtual time [ns].
+********************************************************************************** */
+uint64_t MCR20Sim_GetTime( void );
+
+/*! *********************************************************************************
+* \brief  Returns TRUE and the time [ns] of the next transceiver event, if any.
+********************************************************************************** */
+bool_t MCR20Sim_GetNextEventTime( uint64_t *pTime );
+
+/*! *********************************************************************************
+* \brief  Copies and optionally clears the counters of a node.
+********************************************************************************** */
+void MCR20Sim_GetStats( uint8_t node, mcr20SimStats_t *pStats, bool_t reset );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __MCR20_SIM_H__ */
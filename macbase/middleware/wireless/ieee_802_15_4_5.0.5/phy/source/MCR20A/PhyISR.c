@@ -371,6 +371,8 @@ void PHY_InterruptHandler(void)
     irqStatus = MCR20Drv_DirectAccessSPIMultiByteRead(IRQSTS2, &mStatusAndControlRegs[1], 7);
     mStatusAndControlRegs[IRQSTS1] = irqStatus & 0xF0;
     xcvseqCopy = mStatusAndControlRegs[PHY_CTRL1] & cPHY_CTRL1_XCVSEQ;
+    TRACE(gTracePhyIsr_c, mStatusAndControlRegs[IRQSTS1] | (mStatusAndControlRegs[IRQSTS2] << 8) |
+          (mStatusAndControlRegs[IRQSTS3] << 16), mStatusAndControlRegs[PHY_CTRL1]);
 
     /* Wake IRQ */
     if( !(mStatusAndControlRegs[PHY_CTRL3] & cPHY_CTRL3_WAKE_MSK) &&
@@ -799,6 +801,8 @@ void PHY_InterruptHandler(void)
     mStatusAndControlRegs[IRQSTS1] =
         MCR20Drv_DirectAccessSPIMultiByteRead(IRQSTS2, &mStatusAndControlRegs[1], 7);
     xcvseqCopy = mStatusAndControlRegs[PHY_CTRL1] & cPHY_CTRL1_XCVSEQ;
+    TRACE(gTracePhyIsr_c, mStatusAndControlRegs[IRQSTS1] | (mStatusAndControlRegs[IRQSTS2] << 8) |
+          (mStatusAndControlRegs[IRQSTS3] << 16), mStatusAndControlRegs[PHY_CTRL1]);
     /* clear transceiver interrupts */
     MCR20Drv_DirectAccessSPIMultiByteWrite(IRQSTS1, mStatusAndControlRegs, 3);
 
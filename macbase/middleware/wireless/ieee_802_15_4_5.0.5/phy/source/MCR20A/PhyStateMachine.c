@@ -52,6 +52,10 @@
 #include "AspInterface.h"
 #include "MpmInterface.h"
 
+#if gPhyTxTimestamps_d
+#include "TimersManager.h"
+#endif
+
 #ifndef gMWS_UseCoexistence_d
 #define gMWS_UseCoexistence_d 0
 #endif
@@ -109,6 +113,11 @@ const uint8_t gPhyPoolId = gPhyPoolId_d;
 #if gMWS_UseCoexistence_d
 uint8_t mCoexAbortPending = 0;
 #endif
+#if gPhyTxTimestamps_d
+/* TMR_GetTimestamp() of the last PD-DATA.request and of its confirm [us] */
+static volatile uint64_t mPhyTxStart[gPhyInstancesCnt_c];
+static volatile uint64_t mPhyTxDone[gPhyInstancesCnt_c];
+#endif
 
 
 /*! *********************************************************************************
@@ -482,6 +491,10 @@ static phyStatus_t Phy_HandlePdDataReq( Phy_PhyLocalStruct_t *pPhyData, macToPdD
         PhyTimeSetEventTrigger( pMsg->msgData.dataReq.startTime );
     }
 
+#if gPhyTxTimestamps_d
+    mPhyTxStart[pPhyData - phyLocal] = TMR_GetTimestamp();
+#endif
+    TRACE(gTracePhyDataReq_c, pPhyData - phyLocal, pMsg->msgData.dataReq.psduLength);
     status = PhyPdDataRequest(&pMsg->msgData.dataReq , &pPhyData->rxParams, &pPhyData->txParams);
 
     time = PhyTime_GetTimestamp();
@@ -515,6 +528,25 @@ static phyStatus_t Phy_HandlePdDataReq( Phy_PhyLocalStruct_t *pPhyData, macToPdD
     return status;
 }
 
+#if gPhyTxTimestamps_d
+/*! *********************************************************************************
+* \brief  This function returns when the last PD-DATA.request of a PHY instance
+*         started and when the last successful TX sequence completed [us]
+*
+* \param[in]  phyInstance The instance of the PHY
+* \param[out] pTxStart Start of the last request
+* \param[out] pTxDone End of the last successful sequence
+*
+********************************************************************************** */
+void PhyGetTxTimestamps( instanceId_t phyInstance, uint64_t *pTxStart, uint64_t *pTxDone )
+{
+    OSA_InterruptDisable();
+    *pTxStart = mPhyTxStart[phyInstance];
+    *pTxDone = mPhyTxDone[phyInstance];
+    OSA_InterruptEnable();
+}
+#endif
+
 /*! *********************************************************************************
 * \brief  This function sets the start time and the timeout value for a sequence.
 *
@@ -678,6 +710,11 @@ bool_t PhyIsIdleRx( instanceId_t instanceId )
 ********************************************************************************** */
 void Radio_Phy_PdDataConfirm(instanceId_t instanceId, bool_t framePending)
 {
+#if gPhyTxTimestamps_d
+    mPhyTxDone[instanceId] = TMR_GetTimestamp();
+#endif
+    TRACE(gTracePhyDataCnf_c, instanceId, framePending);
+
     if( framePending )
     {
         phyLocal[instanceId].flags |= gPhyFlagRxFP_c;
@@ -709,6 +746,7 @@ void Radio_Phy_PdDataConfirm(instanceId_t instanceId, bool_t framePending)
 ********************************************************************************** */
 void Radio_Phy_PdDataIndication(instanceId_t instanceId)
 {
+    TRACE(gTracePhyDataInd_c, instanceId, phyLocal[instanceId].rxParams.psduLength);
     PD_SendMessage(&phyLocal[instanceId], gPdDataInd_c);
 }
 
@@ -734,6 +772,7 @@ void Radio_Phy_TimeWaitTimeoutIndication(instanceId_t instanceId)
 ********************************************************************************** */
 void Radio_Phy_PlmeCcaConfirm(phyStatus_t phyChannelStatus, instanceId_t instanceId)
 {
+    TRACE(gTracePhyCcaCnf_c, instanceId, phyChannelStatus);
     phyLocal[instanceId].channelParams.channelStatus = phyChannelStatus;
 
     PLME_SendMessage(&phyLocal[instanceId], gPlmeCcaCnf_c);
@@ -763,6 +802,7 @@ void Radio_Phy_PlmeEdConfirm(uint8_t energyLeveldB, instanceId_t instanceId)
 ********************************************************************************** */
 void Radio_Phy_TimeRxTimeoutIndication(instanceId_t instanceId)
 {
+    TRACE(gTracePhyRxTimeout_c, instanceId, phyLocal[instanceId].flags);
     if( !(phyLocal[instanceId].flags & gPhyFlagIdleRx_c) )
     {
         PLME_SendMessage(&phyLocal[instanceId], gPlmeTimeoutInd_c);
@@ -871,6 +911,7 @@ void Radio_Phy_PlmeRxSfdDetect(instanceId_t instanceId, uint32_t frameLen)
 ********************************************************************************** */
 void Radio_Phy_PlmeSyncLossIndication(instanceId_t instanceId)
 {
+    TRACE(gTracePhySyncLoss_c, instanceId, 0);
     PhyPlmeForceTrxOffRequest();
 #ifdef MAC_PHY_DEBUG
     PLME_SendMessage(&phyLocal[instanceId], gPlme_SyncLossInd_c);
@@ -886,6 +927,7 @@ void Radio_Phy_PlmeSyncLossIndication(instanceId_t instanceId)
 ********************************************************************************** */
 void Radio_Phy_PlmeFilterFailRx(instanceId_t instanceId)
 {
+    TRACE(gTracePhyFilterFail_c, instanceId, phyLocal[instanceId].flags);
     if( phyLocal[instanceId].flags & gPhyFlaqReqPostponed_c )
     {
         /* The Rx packet is not intended for the current device.
@@ -910,6 +952,7 @@ void Radio_Phy_PlmeFilterFailRx(instanceId_t instanceId)
 ********************************************************************************** */
 void Radio_Phy_UnexpectedTransceiverReset(instanceId_t instanceId)
 {
+    TRACE(gTracePhyXcvrReset_c, instanceId, 0);
     PhyPlmeForceTrxOffRequest();
 #ifdef MAC_PHY_DEBUG
     PLME_SendMessage(&phyLocal[instanceId], gPlme_UnexpectedRadioResetInd_c);